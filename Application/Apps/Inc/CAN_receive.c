@@ -9,6 +9,10 @@
   *  Version    Date            Author          Modification
   *  V1.0.0     Dec-26-2018     RM              1. done
   *  V1.0.1     Mar-27-2023     Arthurlehao     2.本地自有化
+  *  V1.0.2     Oct-19-2026     ICBK            3.按总线区分反馈ID 两条总线可使用相同的电调ID
+  *  V1.0.3     Oct-19-2026     ICBK            4.底盘电机反馈按组发布到chassis_motor话题
+  *  V1.0.4     Oct-19-2026     ICBK            5.安全状态下控制电流强制为0; 发送缓冲区改为局部变量 多个任务可同时发送
+  *  V1.0.5     Oct-19-2026     ICBK            6.云台总线增加摩擦轮电机(0x201,0x202)
   * 
   @verbatim
   ==============================================================================
@@ -19,6 +23,8 @@
   */
 #include "CAN_receive.h"
 #include "main.h"
+#include "bsp_lock.h"
+#include "profile.h"
 
 extern CAN_HandleTypeDef hcan1;
 extern CAN_HandleTypeDef hcan2;
@@ -41,12 +47,42 @@ extern CAN_HandleTypeDef hcan2;
 注意下:这里的电机数据解析 都是通过DJI官方的系列电调通讯协议进行解析,如果更换电调，是需要将这里的解析给重写的。
 */
 static motor_measure_t motor_chassis[7];
+//摩擦轮电机 云台总线 0:0x201 1:0x202
+static motor_measure_t motor_friction[2];
 
-static CAN_TxHeaderTypeDef  gimbal_tx_message;
-static uint8_t              gimbal_can_send_data[8];
-		
-static CAN_TxHeaderTypeDef  chassis_tx_message;
-static uint8_t              chassis_can_send_data[8];
+//看门狗任务与控制任务都会发送 发送邮箱的选择与写入需要互斥
+static volatile uint8_t can_tx_lock;
+//安全状态 控制电流强制为0
+static volatile bool_t can_cmd_safe = 0;
+
+//CAN接收中断执行时间
+PROFILE_SCOPE_DEFINE(can_rx_isr);
+
+//底盘电机反馈话题 中断发布 底盘任务读取
+MSG_BUS_TOPIC_DEFINE(chassis_motor, chassis_motor_msg_t, 1, 1);
+
+static chassis_motor_msg_t chassis_motor_msg;   //正在收集的一组反馈
+static uint8_t chassis_motor_mask;              //本组已收到的电机
+
+//收集一组底盘电机反馈 四个电机都收到后发布
+static void chassis_motor_collect(uint8_t i)
+{
+    //本组内同一电机再次回传 说明有电机掉线 先发布当前这组 话题不会停更
+    if (chassis_motor_mask & (1u << i))
+    {
+        msg_bus_publish(MSG_BUS_TOPIC(chassis_motor), &chassis_motor_msg);
+        chassis_motor_mask = 0;
+    }
+
+    chassis_motor_msg.motor[i] = motor_chassis[i];
+    chassis_motor_mask |= (uint8_t)(1u << i);
+
+    if (chassis_motor_mask == 0x0F)
+    {
+        msg_bus_publish(MSG_BUS_TOPIC(chassis_motor), &chassis_motor_msg);
+        chassis_motor_mask = 0;
+    }
+}
 
 /**
   * @brief          hal库CAN回调函数,接收电机数据
@@ -58,30 +94,88 @@ void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
     CAN_RxHeaderTypeDef rx_header;
     uint8_t rx_data[8];
 
-    HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &rx_header, rx_data);
+    PROFILE_BEGIN(can_rx_isr);
 
-    switch (rx_header.StdId)
+    if (HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &rx_header, rx_data) != HAL_OK)
     {
-        case CAN_3508_M1_ID:
-        case CAN_3508_M2_ID:
-        case CAN_3508_M3_ID:
-        case CAN_3508_M4_ID:
-        case CAN_YAW_MOTOR_ID:
-        case CAN_PIT_MOTOR_ID:
-        case CAN_TRIGGER_MOTOR_ID:
+        PROFILE_END(can_rx_isr);
+        return;
+    }
+
+    //反馈ID只在对应的总线上有效 两条总线的电调ID互不影响
+    if (hcan == &CHASSIS_CAN)
+    {
+        switch (rx_header.StdId)
         {
-            static uint8_t i = 0;
-            //get motor id
-            i = rx_header.StdId - CAN_3508_M1_ID;
-            get_motor_measure(&motor_chassis[i], rx_data);
-            break;
-        }
+            case CAN_3508_M1_ID:
+            case CAN_3508_M2_ID:
+            case CAN_3508_M3_ID:
+            case CAN_3508_M4_ID:
+            {
+                get_motor_measure(&motor_chassis[rx_header.StdId - CAN_3508_M1_ID], rx_data);
+                chassis_motor_collect((uint8_t)(rx_header.StdId - CAN_3508_M1_ID));
+                break;
+            }
 
-        default:
+            default:
+            {
+                break;
+            }
+        }
+    }
+    else if (hcan == &GIMBAL_CAN)
+    {
+        switch (rx_header.StdId)
         {
-            break;
+            case CAN_YAW_MOTOR_ID:
+            case CAN_PIT_MOTOR_ID:
+            case CAN_TRIGGER_MOTOR_ID:
+            {
+                get_motor_measure(&motor_chassis[rx_header.StdId - CAN_3508_M1_ID], rx_data);
+                break;
+            }
+
+            case CAN_FRIC_M1_ID:
+            case CAN_FRIC_M2_ID:
+            {
+                get_motor_measure(&motor_friction[rx_header.StdId - CAN_FRIC_M1_ID], rx_data);
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
         }
     }
+
+    PROFILE_END(can_rx_isr);
+}
+
+//发送4个16位值 高字节在前
+static void CAN_cmd_send(CAN_HandleTypeDef *hcan, uint32_t std_id, int16_t v1, int16_t v2, int16_t v3, int16_t v4)
+{
+    CAN_TxHeaderTypeDef tx_message;
+    uint8_t send_data[8];
+    uint32_t send_mail_box;
+    uint32_t key;
+
+    tx_message.StdId = std_id;
+    tx_message.IDE = CAN_ID_STD;
+    tx_message.RTR = CAN_RTR_DATA;
+    tx_message.DLC = 0x08;
+    send_data[0] = (uint8_t)(v1 >> 8);
+    send_data[1] = (uint8_t)v1;
+    send_data[2] = (uint8_t)(v2 >> 8);
+    send_data[3] = (uint8_t)v2;
+    send_data[4] = (uint8_t)(v3 >> 8);
+    send_data[5] = (uint8_t)v3;
+    send_data[6] = (uint8_t)(v4 >> 8);
+    send_data[7] = (uint8_t)v4;
+
+    key = bsp_lock(&can_tx_lock);
+    HAL_CAN_AddTxMessage(hcan, &tx_message, send_data, &send_mail_box);
+    bsp_unlock(&can_tx_lock, key);
 }
 
 /**
@@ -91,21 +185,33 @@ void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
   */
 void CAN_cmd_chassis_reset_ID(void)
 {
-    uint32_t send_mail_box;
-    chassis_tx_message.StdId = 0x700;
-    chassis_tx_message.IDE = CAN_ID_STD;
-    chassis_tx_message.RTR = CAN_RTR_DATA;
-    chassis_tx_message.DLC = 0x08;
-    chassis_can_send_data[0] = 0;
-    chassis_can_send_data[1] = 0;
-    chassis_can_send_data[2] = 0;
-    chassis_can_send_data[3] = 0;
-    chassis_can_send_data[4] = 0;
-    chassis_can_send_data[5] = 0;
-    chassis_can_send_data[6] = 0;
-    chassis_can_send_data[7] = 0;
-
-    HAL_CAN_AddTxMessage(&CHASSIS_CAN, &chassis_tx_message, chassis_can_send_data, &send_mail_box);
+    CAN_cmd_send(&CHASSIS_CAN, 0x700, 0, 0, 0, 0);
+}
+
+//看门狗任务设置 见watchdog_task.c
+void CAN_cmd_safe_set(bool_t safe)
+{
+    can_cmd_safe = safe;
+}
+
+bool_t CAN_cmd_safe_get(void)
+{
+    return can_cmd_safe;
+}
+
+//擦除flash期间电调保持最后收到的电流 擦除前停止全部电机
+void CAN_cmd_stop_all(void)
+{
+    uint32_t key = bsp_lock(&can_tx_lock);
+
+    //邮箱中未发出的帧可能是非零电流 正在发送的帧不能取消 在零电流帧之前发出
+    HAL_CAN_AbortTxRequest(&CHASSIS_CAN, CAN_TX_MAILBOX0 | CAN_TX_MAILBOX1 | CAN_TX_MAILBOX2);
+    HAL_CAN_AbortTxRequest(&GIMBAL_CAN, CAN_TX_MAILBOX0 | CAN_TX_MAILBOX1 | CAN_TX_MAILBOX2);
+    bsp_unlock(&can_tx_lock, key);
+
+    CAN_cmd_send(&CHASSIS_CAN, CAN_CHASSIS_ALL_ID, 0, 0, 0, 0);
+    CAN_cmd_send(&GIMBAL_CAN, CAN_GIMBAL_ALL_ID, 0, 0, 0, 0);
+    CAN_cmd_send(&GIMBAL_CAN, CAN_FRIC_ALL_ID, 0, 0, 0, 0);
 }
 
 /**
@@ -118,20 +224,26 @@ void CAN_cmd_chassis_reset_ID(void)
   */
 void CAN_cmd_gimbal(int16_t yaw, int16_t pitch, int16_t shoot, int16_t rev)
 {
-    uint32_t send_mail_box;
-    gimbal_tx_message.StdId = CAN_GIMBAL_ALL_ID;
-    gimbal_tx_message.IDE = CAN_ID_STD;
-    gimbal_tx_message.RTR = CAN_RTR_DATA;
-    gimbal_tx_message.DLC = 0x08;
-    gimbal_can_send_data[0] = (yaw >> 8);
-    gimbal_can_send_data[1] = yaw;
-    gimbal_can_send_data[2] = (pitch >> 8);
-    gimbal_can_send_data[3] = pitch;
-    gimbal_can_send_data[4] = (shoot >> 8);
-    gimbal_can_send_data[5] = shoot;
-    gimbal_can_send_data[6] = (rev >> 8);
-    gimbal_can_send_data[7] = rev;
-    HAL_CAN_AddTxMessage(&GIMBAL_CAN, &gimbal_tx_message, gimbal_can_send_data, &send_mail_box);
+    if (can_cmd_safe)
+    {
+        yaw = pitch = shoot = rev = 0;
+    }
+    CAN_cmd_send(&GIMBAL_CAN, CAN_GIMBAL_ALL_ID, yaw, pitch, shoot, rev);
+}
+
+/**
+  * @brief          发送摩擦轮电机控制电流(云台总线0x201,0x202)
+  * @param[in]      fric1: (0x201) 3508电机控制电流, 范围 [-16384,16384]
+  * @param[in]      fric2: (0x202) 3508电机控制电流, 范围 [-16384,16384]
+  * @retval         none
+  */
+void CAN_cmd_friction(int16_t fric1, int16_t fric2)
+{
+    if (can_cmd_safe)
+    {
+        fric1 = fric2 = 0;
+    }
+    CAN_cmd_send(&GIMBAL_CAN, CAN_FRIC_ALL_ID, fric1, fric2, 0, 0);
 }
 
 /**
@@ -144,21 +256,11 @@ void CAN_cmd_gimbal(int16_t yaw, int16_t pitch, int16_t shoot, int16_t rev)
   */
 void CAN_cmd_chassis(int16_t motor1, int16_t motor2, int16_t motor3, int16_t motor4)
 {
-    uint32_t send_mail_box;
-    chassis_tx_message.StdId = CAN_CHASSIS_ALL_ID;
-    chassis_tx_message.IDE = CAN_ID_STD;
-    chassis_tx_message.RTR = CAN_RTR_DATA;
-    chassis_tx_message.DLC = 0x08;
-    chassis_can_send_data[0] = motor1 >> 8;
-    chassis_can_send_data[1] = motor1;
-    chassis_can_send_data[2] = motor2 >> 8;
-    chassis_can_send_data[3] = motor2;
-    chassis_can_send_data[4] = motor3 >> 8;
-    chassis_can_send_data[5] = motor3;
-    chassis_can_send_data[6] = motor4 >> 8;
-    chassis_can_send_data[7] = motor4;
-
-    HAL_CAN_AddTxMessage(&CHASSIS_CAN, &chassis_tx_message, chassis_can_send_data, &send_mail_box);
+    if (can_cmd_safe)
+    {
+        motor1 = motor2 = motor3 = motor4 = 0;
+    }
+    CAN_cmd_send(&CHASSIS_CAN, CAN_CHASSIS_ALL_ID, motor1, motor2, motor3, motor4);
 }
 
 /**
@@ -222,3 +324,19 @@ const motor_measure_t *get_chassis_motor_measure_point(uint8_t i)
 {
     return &motor_chassis[(i & 0x03)];
 }
+
+
+/**
+  * @brief          return the friction 3508 motor data point
+  * @param[in]      i: motor number,range [0,1]
+  * @retval         motor data point
+  */
+/**
+  * @brief          返回摩擦轮 3508电机数据指针
+  * @param[in]      i: 电机编号,范围[0,1]
+  * @retval         电机数据指针
+  */
+const motor_measure_t *get_friction_motor_measure_point(uint8_t i)
+{
+    return &motor_friction[(i & 0x01)];
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       blackbox.c/h
+  * @brief      黑匣子，RAM环形缓冲区记录控制任务的带时间戳二进制记录，
+  *             在硬件错误、遥控器掉线或手动触发时冻结，热复位后数据保留。
+  * @note       通道写入不加锁: 每个通道只有一个写者, 读者只有暂停后的调试器,
+  *             seq先清0后填写, 暂停在写入中间时该条记录按未写完丢弃。
+  *             系统通道与冻结在关中断下进行, 冻结时被抢占的写者可以写完手上的一条。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    写入一条记录(通道lane, 累计写入数head):
+      1. record = lane[head % BLACKBOX_LANE_RECORD_NUM], record.seq = 0, __DMB
+      2. 写time_ms type len data, __DMB
+      3. record.seq = (head + 1) 的低16位, lane_head = head + 1
+    冻结: 关中断 -> 系统通道写BLACKBOX_TYPE_FREEZE -> 写冻结时间 -> freeze_reason, 只有第一次生效
+    复位: 头部无效(上电)清空; 有效且未冻结时清空并保留boot_count; 已冻结时保持
+    上位机测试: Tools/sim/blackbox_sim.c
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <string.h>
+#include "blackbox.h"
+#include "main.h"
+
+#define BLACKBOX_LAYOUT ((BLACKBOX_LANE_NUM << 16) | BLACKBOX_LANE_RECORD_NUM)
+
+typedef struct
+{
+  blackbox_header_t header;
+  blackbox_record_t lane[BLACKBOX_LANE_NUM][BLACKBOX_LANE_RECORD_NUM];
+} blackbox_t;
+
+//编译期检查 数据不能超出UNINIT区域
+typedef char blackbox_region_size_check[(sizeof(blackbox_t) <= BLACKBOX_REGION_SIZE) ? 1 : -1];
+
+//.noinit段 复位时不清零
+#if defined(__CC_ARM)
+static blackbox_t blackbox __attribute__((section(".noinit"), zero_init));
+#else
+static blackbox_t blackbox __attribute__((section(".noinit")));
+#endif
+
+static void blackbox_reset(void)
+{
+  memset(&blackbox, 0, sizeof(blackbox));
+  blackbox.header.magic = BLACKBOX_MAGIC;
+  blackbox.header.version = BLACKBOX_VERSION;
+  blackbox.header.layout = BLACKBOX_LAYOUT;
+  blackbox.header.check = ~(BLACKBOX_MAGIC ^ BLACKBOX_VERSION ^ BLACKBOX_LAYOUT);
+}
+
+void blackbox_init(void)
+{
+  blackbox_header_t *header = &blackbox.header;
+
+  //上电时RAM内容随机 头部校验不通过则清空
+  if(header->magic != BLACKBOX_MAGIC || header->version != BLACKBOX_VERSION ||
+     header->layout != BLACKBOX_LAYOUT || header->check != ~(BLACKBOX_MAGIC ^ BLACKBOX_VERSION ^ BLACKBOX_LAYOUT))
+  {
+    blackbox_reset();
+    return;
+  }
+
+  header->boot_count++;
+  //未冻结的数据没有保留价值 重新记录; 已冻结的保持冻结等待导出
+  if(header->freeze_reason == BLACKBOX_RUNNING)
+  {
+    uint32_t boot_count = header->boot_count;
+    blackbox_reset();
+    blackbox.header.boot_count = boot_count;
+  }
+}
+
+void blackbox_write(blackbox_lane_e lane, uint8_t type, const void *data, uint8_t len)
+{
+  blackbox_record_t *record;
+  uint32_t head;
+
+  if(lane >= BLACKBOX_LANE_NUM || blackbox.header.freeze_reason != BLACKBOX_RUNNING)
+  {
+    return;
+  }
+  if(len > BLACKBOX_DATA_LEN)
+  {
+    len = BLACKBOX_DATA_LEN;
+  }
+
+  head = blackbox.header.lane_head[lane];
+  record = &blackbox.lane[lane][head & (BLACKBOX_LANE_RECORD_NUM - 1)];
+
+  //先清seq标记正在写 写完内容后再填seq
+  record->seq = 0;
+  __DMB();
+  record->time_ms = HAL_GetTick();
+  record->type = type;
+  record->len = len;
+  memcpy(record->data, data, len);
+  __DMB();
+  record->seq = (uint16_t)(head + 1);
+  blackbox.header.lane_head[lane] = head + 1;
+}
+
+//系统通道可能在任意上下文写入 关中断保证只有一个写者
+static void blackbox_system_write(uint8_t type, uint32_t value0, uint32_t value1)
+{
+  uint32_t data[2];
+  uint32_t primask = __get_PRIMASK();
+
+  data[0] = value0;
+  data[1] = value1;
+  __disable_irq();
+  blackbox_write(BLACKBOX_LANE_SYSTEM, type, data, sizeof(data));
+  __set_PRIMASK(primask);
+}
+
+void blackbox_freeze(blackbox_freeze_e reason, uint32_t info)
+{
+  uint32_t primask;
+
+  if(reason == BLACKBOX_RUNNING)
+  {
+    return;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if(blackbox.header.freeze_reason == BLACKBOX_RUNNING)
+  {
+    //最后一条记录写冻结原因 之后冻结
+    blackbox_system_write(BLACKBOX_TYPE_FREEZE, (uint32_t)reason, info);
+    blackbox.header.freeze_time_ms = HAL_GetTick();
+    blackbox.header.freeze_boot = blackbox.header.boot_count;
+    blackbox.header.freeze_reason = reason;
+  }
+  __set_PRIMASK(primask);
+}
+
+void blackbox_freeze_fault(uint32_t exc_return)
+{
+  //EXC_RETURN bit2为1表示异常前使用PSP(任务中出错) 栈帧: r0 r1 r2 r3 r12 lr pc xpsr
+  uint32_t pc = 0;
+  uint32_t lr = 0;
+
+  if(exc_return & 0x4u)
+  {
+    const uint32_t *frame = (const uint32_t *)__get_PSP();
+    lr = frame[5];
+    pc = frame[6];
+  }
+
+  blackbox_system_write(BLACKBOX_TYPE_FAULT_REG, SCB->CFSR, SCB->HFSR);
+  blackbox_system_write(BLACKBOX_TYPE_FAULT_PC, pc, lr);
+  blackbox_freeze(BLACKBOX_FREEZE_HARDFAULT, pc);
+}
+
+void blackbox_clear(void)
+{
+  uint32_t primask = __get_PRIMASK();
+  uint32_t boot_count = blackbox.header.boot_count;
+
+  __disable_irq();
+  blackbox_reset();
+  blackbox.header.boot_count = boot_count;
+  __set_PRIMASK(primask);
+}
+
+uint32_t blackbox_is_frozen(void)
+{
+  return blackbox.header.freeze_reason;
+}
@@ -0,0 +1,316 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       param.c/h
+  * @brief      参数注册表，参数(名称、类型、默认值、范围)在启动时从flash载入RAM，
+  *             控制任务按编号O(1)读取，修改后保存到flash，不需要重新编译下载。
+  * @note       
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <stddef.h>
+#include <string.h>
+#include "param.h"
+#include "crc.h"
+#include "bsp_flash.h"
+#include "CAN_receive.h"
+#include "cmsis_os.h"
+
+#define PARAM_DEF_FP32(name, def, min, max)   {name, PARAM_FP32,   {.f = (def)}, {.f = (min)}, {.f = (max)}}
+#define PARAM_DEF_INT32(name, def, min, max)  {name, PARAM_INT32,  {.i = (def)}, {.i = (min)}, {.i = (max)}}
+#define PARAM_DEF_UINT32(name, def, min, max) {name, PARAM_UINT32, {.u = (def)}, {.u = (min)}, {.u = (max)}}
+
+//参数定义表
+static const param_def_t param_def[PARAM_NUM] =
+{
+  [PARAM_CHASSIS_SPEED_KP]       = PARAM_DEF_FP32("chassis.spd_kp",       CONFIG_CHASSIS_MOTOR_SPEED_PID_KP,       0.0f, 1000.0f),
+  [PARAM_CHASSIS_SPEED_KI]       = PARAM_DEF_FP32("chassis.spd_ki",       CONFIG_CHASSIS_MOTOR_SPEED_PID_KI,       0.0f, 100.0f),
+  [PARAM_CHASSIS_SPEED_KD]       = PARAM_DEF_FP32("chassis.spd_kd",       CONFIG_CHASSIS_MOTOR_SPEED_PID_KD,       0.0f, 10000.0f),
+  [PARAM_CHASSIS_SPEED_MAX_OUT]  = PARAM_DEF_FP32("chassis.spd_max_out",  CONFIG_CHASSIS_MOTOR_SPEED_PID_MAX_OUT,  0.0f, CONFIG_MOTOR_M3508_CAN_MAX_CURRENT),
+  [PARAM_CHASSIS_SPEED_MAX_IOUT] = PARAM_DEF_FP32("chassis.spd_max_iout", CONFIG_CHASSIS_MOTOR_SPEED_PID_MAX_IOUT, 0.0f, CONFIG_MOTOR_M3508_CAN_MAX_CURRENT),
+  [PARAM_CHASSIS_RC_TO_SPEED]    = PARAM_DEF_FP32("chassis.rc_to_speed",  CONFIG_RC_TO_SPEED_RATIO,                0.0f, 0.05f),
+  [PARAM_CHASSIS_RC_DEADZONE]    = PARAM_DEF_INT32("chassis.rc_deadzone", CONFIG_CHASSIS_RC_DEADZONE,              0,    100),
+  [PARAM_GIMBAL_YAW_ANGLE_KP]    = PARAM_DEF_FP32("gimbal.yaw_ang_kp",    CONFIG_GIMBAL_YAW_ANGLE_PID_KP,          0.0f, 200.0f),
+  [PARAM_GIMBAL_YAW_ANGLE_KI]    = PARAM_DEF_FP32("gimbal.yaw_ang_ki",    CONFIG_GIMBAL_YAW_ANGLE_PID_KI,          0.0f, 10.0f),
+  [PARAM_GIMBAL_YAW_ANGLE_KD]    = PARAM_DEF_FP32("gimbal.yaw_ang_kd",    CONFIG_GIMBAL_YAW_ANGLE_PID_KD,          0.0f, 1000.0f),
+  [PARAM_GIMBAL_YAW_SPEED_KP]    = PARAM_DEF_FP32("gimbal.yaw_spd_kp",    CONFIG_GIMBAL_YAW_SPEED_PID_KP,          0.0f, 30000.0f),
+  [PARAM_GIMBAL_YAW_SPEED_KI]    = PARAM_DEF_FP32("gimbal.yaw_spd_ki",    CONFIG_GIMBAL_YAW_SPEED_PID_KI,          0.0f, 3000.0f),
+  [PARAM_GIMBAL_PITCH_ANGLE_KP]  = PARAM_DEF_FP32("gimbal.pit_ang_kp",    CONFIG_GIMBAL_PITCH_ANGLE_PID_KP,        0.0f, 200.0f),
+  [PARAM_GIMBAL_PITCH_ANGLE_KI]  = PARAM_DEF_FP32("gimbal.pit_ang_ki",    CONFIG_GIMBAL_PITCH_ANGLE_PID_KI,        0.0f, 10.0f),
+  [PARAM_GIMBAL_PITCH_ANGLE_KD]  = PARAM_DEF_FP32("gimbal.pit_ang_kd",    CONFIG_GIMBAL_PITCH_ANGLE_PID_KD,        0.0f, 1000.0f),
+  [PARAM_GIMBAL_PITCH_SPEED_KP]  = PARAM_DEF_FP32("gimbal.pit_spd_kp",    CONFIG_GIMBAL_PITCH_SPEED_PID_KP,        0.0f, 30000.0f),
+  [PARAM_GIMBAL_PITCH_SPEED_KI]  = PARAM_DEF_FP32("gimbal.pit_spd_ki",    CONFIG_GIMBAL_PITCH_SPEED_PID_KI,        0.0f, 3000.0f),
+  [PARAM_GIMBAL_RC_TO_RATE]      = PARAM_DEF_FP32("gimbal.rc_to_rate",    CONFIG_GIMBAL_RC_TO_RATE_RATIO,          0.0f, 0.05f),
+  [PARAM_GIMBAL_RC_DEADZONE]     = PARAM_DEF_INT32("gimbal.rc_deadzone",  CONFIG_GIMBAL_RC_DEADZONE,               0,    100),
+  [PARAM_SHOOT_FIRE_MODE]        = PARAM_DEF_INT32("shoot.fire_mode",     CONFIG_SHOOT_FIRE_MODE,                  0,    2),
+  [PARAM_SHOOT_BURST_NUM]        = PARAM_DEF_INT32("shoot.burst_num",     CONFIG_SHOOT_BURST_NUM,                  1,    10),
+  [PARAM_SHOOT_FIRE_RATE]        = PARAM_DEF_FP32("shoot.fire_rate",      CONFIG_SHOOT_FIRE_RATE_HZ,               0.5f, 30.0f),
+  [PARAM_SHOOT_HEAT_LIMIT]       = PARAM_DEF_INT32("shoot.heat_limit",    CONFIG_SHOOT_HEAT_LIMIT,                 CONFIG_SHOOT_HEAT_PER_SHOT, 1000),
+  [PARAM_SHOOT_COOLING_RATE]     = PARAM_DEF_INT32("shoot.cooling",       CONFIG_SHOOT_COOLING_RATE,               1,    200),
+  [PARAM_SHOOT_FRIC_SPEED]       = PARAM_DEF_FP32("shoot.fric_rpm",       CONFIG_SHOOT_FRIC_SPEED_RPM,             0.0f, 9000.0f),
+};
+
+//RAM中的参数值 按编号读取
+static param_value_t param_value[PARAM_NUM];
+
+//上次保存到flash的值 用于只保存修改过的参数
+static uint32_t param_saved[PARAM_NUM];
+
+//暂存值 param_commit时整体生效
+static param_value_t param_staged[PARAM_NUM];
+static uint32_t param_staged_mask[(PARAM_NUM + 31) / 32];
+
+//参数版本号 每次修改生效加1
+static volatile uint32_t param_version = 0;
+
+//参数在flash中的键 名称的CRC16
+static uint16_t param_key[PARAM_NUM];
+
+static flash_store_t param_store;
+
+static const uint32_t param_flash_sector[2] = {FLASH_SECTOR_10, FLASH_SECTOR_11};
+static const uint32_t param_flash_addr[2] = {PARAM_FLASH_SECTOR0_ADDR, PARAM_FLASH_SECTOR1_ADDR};
+
+//擦除期间CPU停止 电调保持最后收到的电流: 挂起调度器使控制任务不再发送 先发送零电流再擦除
+//调度器启动前(param_init)还没有控制帧 直接擦除
+static bool_t param_flash_erase(uint8_t sector)
+{
+  bool_t ok;
+
+  if(!osKernelRunning())
+  {
+    return bsp_flash_erase_sector(param_flash_sector[sector]);
+  }
+
+  vTaskSuspendAll();
+  CAN_cmd_stop_all();
+  ok = bsp_flash_erase_sector(param_flash_sector[sector]);
+  xTaskResumeAll();
+  return ok;
+}
+
+static bool_t param_flash_program(uint8_t sector, uint32_t offset, uint32_t data)
+{
+  return bsp_flash_program_word(param_flash_addr[sector] + offset, data);
+}
+
+static const volatile uint32_t *param_flash_read(uint8_t sector)
+{
+  return (const volatile uint32_t *)param_flash_addr[sector];
+}
+
+static const flash_store_ops_t param_flash_ops =
+{
+  PARAM_FLASH_SECTOR_SIZE,
+  param_flash_erase,
+  param_flash_program,
+  param_flash_read,
+};
+
+//参数值是否在范围内 fp32为NaN时比较结果为假
+static bool_t param_in_range(const param_def_t *def, param_value_t value)
+{
+  switch(def->type)
+  {
+    case PARAM_FP32:
+      return (value.f >= def->min.f && value.f <= def->max.f) ? 1 : 0;
+    case PARAM_INT32:
+      return (value.i >= def->min.i && value.i <= def->max.i) ? 1 : 0;
+    case PARAM_UINT32:
+      return (value.u >= def->min.u && value.u <= def->max.u) ? 1 : 0;
+    default:
+      return 0;
+  }
+}
+
+void param_init(void)
+{
+  uint16_t i;
+  uint16_t key;
+
+  for(i = 0; i < PARAM_NUM; i++)
+  {
+    param_value[i] = param_def[i].def;
+
+    key = get_CRC16_check_sum((const uint8_t *)param_def[i].name, strlen(param_def[i].name), CRC16_INIT);
+    param_key[i] = (key == FLASH_STORE_KEY_INVALID) ? 0 : key;
+  }
+
+  flash_store_init(&param_store, &param_flash_ops, param_key, &param_value[0].u, PARAM_NUM);
+
+  //flash中的值超出范围(修改了范围或数据损坏) 使用默认值
+  for(i = 0; i < PARAM_NUM; i++)
+  {
+    if(!param_in_range(&param_def[i], param_value[i]))
+    {
+      param_value[i] = param_def[i].def;
+    }
+    param_saved[i] = param_value[i].u;
+  }
+  //版本号从1开始 使用者的版本号初始为0 第一次param_update即拷贝
+  param_version = 1;
+}
+
+const param_value_t *get_param_value_point(void)
+{
+  return param_value;
+}
+
+uint32_t param_get_version(void)
+{
+  return param_version;
+}
+
+bool_t param_update(uint32_t *version, param_value_t *param)
+{
+  if(version == NULL || param == NULL || *version == param_version)
+  {
+    return 0;
+  }
+
+  //提交在临界区内完成 这里同样在临界区内拷贝 得到同一次提交的完整参数表
+  taskENTER_CRITICAL();
+  memcpy(param, param_value, sizeof(param_value));
+  *version = param_version;
+  taskEXIT_CRITICAL();
+  return 1;
+}
+
+const param_def_t *param_get_def(uint16_t id)
+{
+  if(id >= PARAM_NUM)
+  {
+    return NULL;
+  }
+  return &param_def[id];
+}
+
+int16_t param_find(const char *name)
+{
+  uint16_t i;
+
+  if(name == NULL)
+  {
+    return -1;
+  }
+  for(i = 0; i < PARAM_NUM; i++)
+  {
+    if(strcmp(param_def[i].name, name) == 0)
+    {
+      return (int16_t)i;
+    }
+  }
+  return -1;
+}
+
+bool_t param_set(uint16_t id, param_value_t value)
+{
+  if(id >= PARAM_NUM || !param_in_range(&param_def[id], value))
+  {
+    return 0;
+  }
+  taskENTER_CRITICAL();
+  param_value[id] = value;
+  param_version++;
+  taskEXIT_CRITICAL();
+  return 1;
+}
+
+bool_t param_stage(uint16_t id, param_value_t value)
+{
+  if(id >= PARAM_NUM || !param_in_range(&param_def[id], value))
+  {
+    return 0;
+  }
+  param_staged[id] = value;
+  param_staged_mask[id / 32] |= 1ul << (id % 32);
+  return 1;
+}
+
+bool_t param_get_staged(uint16_t id, param_value_t *value)
+{
+  if(id >= PARAM_NUM || value == NULL || !((param_staged_mask[id / 32] >> (id % 32)) & 1ul))
+  {
+    return 0;
+  }
+  *value = param_staged[id];
+  return 1;
+}
+
+uint16_t param_commit(void)
+{
+  uint16_t count = 0;
+  uint16_t i;
+
+  taskENTER_CRITICAL();
+  for(i = 0; i < PARAM_NUM; i++)
+  {
+    if((param_staged_mask[i / 32] >> (i % 32)) & 1ul)
+    {
+      param_value[i] = param_staged[i];
+      count++;
+    }
+  }
+  if(count != 0)
+  {
+    param_version++;
+  }
+  taskEXIT_CRITICAL();
+
+  param_discard();
+  return count;
+}
+
+void param_discard(void)
+{
+  memset(param_staged_mask, 0, sizeof(param_staged_mask));
+}
+
+bool_t param_save(void)
+{
+  bool_t ok = 1;
+  uint16_t i;
+
+  for(i = 0; i < PARAM_NUM; i++)
+  {
+    if(param_value[i].u == param_saved[i])
+    {
+      continue;
+    }
+    if(flash_store_write(&param_store, i))
+    {
+      param_saved[i] = param_value[i].u;
+    }
+    else
+    {
+      ok = 0;
+    }
+  }
+  return ok;
+}
+
+void param_reset_default(void)
+{
+  uint16_t i;
+
+  taskENTER_CRITICAL();
+  for(i = 0; i < PARAM_NUM; i++)
+  {
+    param_value[i] = param_def[i].def;
+  }
+  param_version++;
+  taskEXIT_CRITICAL();
+}
+
+const flash_store_t *get_param_store_point(void)
+{
+  return &param_store;
+}
@@ -0,0 +1,243 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       pc_control.c/h
+  * @brief      键鼠输入层，计算按键按下/松开边沿、按住时间与消抖，
+  *             按键位映射表把按键转换为动作，输出精简的控制指令。
+  * @note       每收到一帧遥控器数据处理一次，处理时间与按键数量无关(固定18个按键)。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <stddef.h>
+#include "pc_control.h"
+
+#define PC_KEY_MASK ((1ul << PC_KEY_NUM) - 1ul)
+
+//默认按键映射表
+static const pc_key_map_t pc_default_key_map[] =
+{
+  {PC_KEY_W,       PC_ACTION_FORWARD,  PC_TRIGGER_HOLD},
+  {PC_KEY_S,       PC_ACTION_BACKWARD, PC_TRIGGER_HOLD},
+  {PC_KEY_A,       PC_ACTION_LEFT,     PC_TRIGGER_HOLD},
+  {PC_KEY_D,       PC_ACTION_RIGHT,    PC_TRIGGER_HOLD},
+  {PC_KEY_SHIFT,   PC_ACTION_BOOST,    PC_TRIGGER_HOLD},
+  {PC_KEY_CTRL,    PC_ACTION_SLOW,     PC_TRIGGER_HOLD},
+  {PC_KEY_F,       PC_ACTION_SPIN,     PC_TRIGGER_TOGGLE},
+  {PC_KEY_MOUSE_L, PC_ACTION_FIRE,     PC_TRIGGER_HOLD},
+  {PC_KEY_MOUSE_R, PC_ACTION_AIM,      PC_TRIGGER_HOLD},
+};
+
+//限幅到[-1,1]
+static fp32 pc_clamp_unit(fp32 value)
+{
+  if(value > 1.0f)
+  {
+    return 1.0f;
+  }
+  else if(value < -1.0f)
+  {
+    return -1.0f;
+  }
+  return value;
+}
+
+//按键消抖 原始按键位保持PC_KEY_DEBOUNCE_MS不变后才改变消抖后的状态
+static void pc_key_debounce(pc_control_t *pc, uint32_t raw, uint32_t now_ms)
+{
+  uint32_t last_state = pc->state;
+  uint32_t raw_change = raw ^ pc->raw;
+  uint32_t unstable;
+  uint8_t i;
+
+  for(i = 0; i < PC_KEY_NUM; i++)
+  {
+    if((raw_change >> i) & 1u)
+    {
+      pc->raw_change_time[i] = now_ms;
+    }
+  }
+  pc->raw = raw;
+
+  unstable = raw ^ pc->state;
+  for(i = 0; i < PC_KEY_NUM; i++)
+  {
+    if(((unstable >> i) & 1u) && (now_ms - pc->raw_change_time[i] >= PC_KEY_DEBOUNCE_MS))
+    {
+      pc->state ^= (1ul << i);
+      if((raw >> i) & 1u)
+      {
+        pc->press_time[i] = now_ms;
+      }
+    }
+  }
+
+  pc->pressed = pc->state & ~last_state;
+  pc->released = ~pc->state & last_state;
+}
+
+//按键映射为动作
+static uint16_t pc_key_to_action(pc_control_t *pc)
+{
+  uint16_t actions = 0;
+  uint8_t i;
+
+  for(i = 0; i < pc->map_len; i++)
+  {
+    const pc_key_map_t *item = &pc->map[i];
+    uint16_t action_bit = (uint16_t)(1u << item->action);
+
+    switch(item->trigger)
+    {
+      case PC_TRIGGER_HOLD:
+        if(pc_key_is_down(pc, item->key))
+        {
+          actions |= action_bit;
+        }
+        break;
+
+      case PC_TRIGGER_TOGGLE:
+        if(pc_key_is_pressed(pc, item->key))
+        {
+          pc->toggles ^= action_bit;
+        }
+        break;
+
+      case PC_TRIGGER_LONG_PRESS:
+        if(pc_key_is_down(pc, item->key) && pc->now - pc->press_time[item->key] >= PC_KEY_LONG_PRESS_MS)
+        {
+          actions |= action_bit;
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  return actions | pc->toggles;
+}
+
+void pc_control_init(pc_control_t *pc, const pc_key_map_t *map, uint8_t map_len)
+{
+  if(pc == NULL)
+  {
+    return;
+  }
+
+  if(map == NULL)
+  {
+    map = pc_default_key_map;
+    map_len = sizeof(pc_default_key_map) / sizeof(pc_default_key_map[0]);
+  }
+  pc->map = map;
+  pc->map_len = map_len;
+  pc->frame_id = 0;
+  pc->now = 0;
+
+  pc_control_reset(pc);
+}
+
+void pc_control_reset(pc_control_t *pc)
+{
+  uint8_t i;
+
+  if(pc == NULL)
+  {
+    return;
+  }
+
+  pc->raw = 0;
+  pc->state = 0;
+  pc->pressed = 0;
+  pc->released = 0;
+  pc->toggles = 0;
+  for(i = 0; i < PC_KEY_NUM; i++)
+  {
+    pc->raw_change_time[i] = pc->now;
+    pc->press_time[i] = pc->now;
+  }
+
+  pc->command.vx = 0.0f;
+  pc->command.vy = 0.0f;
+  pc->command.yaw = 0.0f;
+  pc->command.pitch = 0.0f;
+  pc->command.actions = 0;
+  pc->command.action_edges = 0;
+}
+
+const pc_command_t *pc_control_update(pc_control_t *pc, const RC_ctrl_t *rc, uint32_t frame_id, uint32_t now_ms)
+{
+  uint32_t raw;
+  uint16_t actions;
+  fp32 speed_scale;
+  pc_command_t *cmd;
+
+  if(pc == NULL || rc == NULL)
+  {
+    return NULL;
+  }
+
+  cmd = &pc->command;
+
+  //同一帧只处理一次
+  if(frame_id == pc->frame_id)
+  {
+    return cmd;
+  }
+  pc->frame_id = frame_id;
+  pc->now = now_ms;
+
+  raw = (uint32_t)rc->keyboard.value;
+  if(rc->mouse.press_left)
+  {
+    raw |= 1ul << PC_KEY_MOUSE_L;
+  }
+  if(rc->mouse.press_right)
+  {
+    raw |= 1ul << PC_KEY_MOUSE_R;
+  }
+  pc_key_debounce(pc, raw & PC_KEY_MASK, now_ms);
+
+  actions = pc_key_to_action(pc);
+  cmd->action_edges = actions & (uint16_t)~cmd->actions;
+  cmd->actions = actions;
+
+  //平移 同时按下相反方向时抵消
+  if(pc_action_is_active(cmd, PC_ACTION_BOOST))
+  {
+    speed_scale = PC_BOOST_SPEED_SCALE;
+  }
+  else if(pc_action_is_active(cmd, PC_ACTION_SLOW))
+  {
+    speed_scale = PC_SLOW_SPEED_SCALE;
+  }
+  else
+  {
+    speed_scale = PC_NORMAL_SPEED_SCALE;
+  }
+  cmd->vx = ((fp32)pc_action_is_active(cmd, PC_ACTION_FORWARD) - (fp32)pc_action_is_active(cmd, PC_ACTION_BACKWARD)) * speed_scale;
+  cmd->vy = ((fp32)pc_action_is_active(cmd, PC_ACTION_LEFT) - (fp32)pc_action_is_active(cmd, PC_ACTION_RIGHT)) * speed_scale;
+
+  //鼠标 x向右为正 偏航逆时针为正
+  cmd->yaw = pc_clamp_unit(-rc->mouse.x * PC_MOUSE_X_SENS);
+  cmd->pitch = pc_clamp_unit(rc->mouse.y * PC_MOUSE_Y_SENS);
+
+  return cmd;
+}
+
+uint32_t pc_key_hold_time(const pc_control_t *pc, pc_key_e key)
+{
+  if(pc == NULL || key >= PC_KEY_NUM || !pc_key_is_down(pc, key))
+  {
+    return 0;
+  }
+  return pc->now - pc->press_time[key];
+}
@@ -4,105 +4,186 @@
   * @brief      遥控器处理，遥控器是通过类似SBUS的协议传输。
   *             利用DMA传输方式节约CPU资源，利用串口空闲中断来拉起处理函数。
   *             同时提供一些掉线重启DMA，串口的方式保证热插拔的稳定性。
-  * @note       该任务是通过串口中断启动，不是freeRTOS任务
+  * @note       串口DMA双缓冲接收由bsp_usart完成, 空闲中断回调只通知遥控器任务，
+  *             协议解析与校验在remote_control_task中完成，
+  *             解析结果写入双缓冲后翻转索引发布，读者用remote_control_read获取完整一帧。
   * @history
   *  Version    Date            Author          Modification
   *  V1.0.0     Dec-01-2019     RM              1. 完成
   *  V1.0.1     Mar-27-2023     Arthurlehao     2. 本地自有化
+  *  V1.1.0     Oct-19-2026     ICBK            3. 帧校验、接收状态统计与掉线失控保护
+  *  V1.2.0     Oct-19-2026     ICBK            4. 解析移出中断, 顺序锁发布
+  *  V1.2.1     Oct-19-2026     ICBK            5. 串口接收改用bsp_usart通用驱动
+  *  V1.2.2     Oct-19-2026     ICBK            6. 黑匣子记录遥控器数据, 掉线时冻结
+  *  V1.2.3     Oct-19-2026     ICBK            7. 遥控器任务统计每帧解析时间 与任务表中的预算比较
+  *  V1.2.4     Oct-19-2026     ICBK            8. 顺序锁改为双缓冲 读者不等待写入中的帧, 与任务优先级无关
+  *  V1.2.5     Oct-19-2026     ICBK            9. 统计长度错误的接收
   @verbatim
   ==============================================================================
+    中断(bsp_usart) -> 切换DMA缓冲区 -> RC_rx_callback 记录完成的缓冲区 -> 任务通知
+    remote_control_task -> 解析 -> 校验 -> 写入空闲缓冲区 -> rc_ctrl_seq加1(翻转索引)
+    控制任务 -> remote_control_read 拷贝出完整一帧
 
+    只有一个写者(remote_control_task), 最新一帧在rc_ctrl_buf[rc_ctrl_seq & 1],
+    写者只写另一个缓冲区, 写完后才加1。读者拷贝当前缓冲区, 拷贝期间计数不变即完整;
+    计数变化说明写者在拷贝期间完成了一帧(写者抢占了读者), 重新拷贝。
+    读者不等待写入中的帧: 单调速率下2ms的控制任务优先级高于14ms的遥控器任务,
+    在写者写到一半时抢占读取的是另一个缓冲区, 直接返回上一帧。
   ==============================================================================
   @endverbatim
   ****************************(C) COPYRIGHT 2023 ICBK****************************
   */
 
+#include <string.h>
 #include "remote_control.h"
+#include "bsp_rc.h"
 #include "main.h"
+#include "cmsis_os.h"
+#include "blackbox.h"
+#include "task_registry.h"
 
-extern  UART_HandleTypeDef huart3;
-extern  DMA_HandleTypeDef hdma_usart3_rx;
+/**
+  * @brief          遥控器数据校验
+  * @param[in]      rc: 解析后的遥控器数据
+  * @retval         1:数据错误 0:数据正常
+  */
+static bool_t RC_data_is_error(const RC_ctrl_t *rc);
 
 /**
-  * @brief          遥控器协议解析
+  * @brief          处理一帧遥控器数据: 解析、校验、更新接收状态、发布
   * @param[in]      sbus_buf: 原生数据指针
-  * @param[out]     rc_ctrl: 遥控器数据指针
   * @retval         none
   */
- static void sbus_to_rc(volatile const uint8_t *sbus_buf, RC_ctrl_t *rc_ctrl);
+static void RC_frame_handle(volatile const uint8_t *sbus_buf);
+
+/**
+  * @brief          串口空闲中断回调 记录完成的缓冲区并通知遥控器任务
+  * @param[in]      rx: 串口接收对象
+  * @param[in]      data: 接收完成的缓冲区
+  * @param[in]      len: 本帧长度
+  * @retval         none
+  */
+static void RC_rx_callback(usart_rx_t *rx, const uint8_t *data, uint16_t len);
+
+//遥控器控制变量双缓冲 只由remote_control_task写入
+static RC_ctrl_t rc_ctrl_buf[2];
+
+//已发布的帧数 最新一帧在rc_ctrl_buf[rc_ctrl_seq & 1]
+static volatile uint32_t rc_ctrl_seq = 0;
+
+//遥控器接收状态 上电时未收到遥控器 处于失控保护
+static RC_status_t rc_status = {0, 0, 0, 0, 0, 0, 0, 0, 1};
+
+//定义原始数据缓冲区，接收原始数据，为18个字节的数据，这里给了36个字节的长度，防止DMA传输越界。
+static uint8_t sbus_rx_buf[2][SBUS_RX_BUF_NUM];
+
+//中断中记录的接收完成的缓冲区
+static const uint8_t *volatile sbus_rx_ready_buf = sbus_rx_buf[0];
 
- //遥控器控制变量
-RC_ctrl_t rc_ctrl;
+//遥控器任务句柄 中断通知用
+static osThreadId rc_task_handle = NULL;
 
-//获取遥控器数据指针
+//获取遥控器最新一帧数据指针 注意:指针在下下帧写入时失效, 需要完整一帧时使用remote_control_read
 const RC_ctrl_t *get_remote_control_point(void)
 {
-  return &rc_ctrl;
+  return &rc_ctrl_buf[rc_ctrl_seq & 1u];
 }
 
-//定义原始数据缓冲区，接收原始数据，为18个字节的数据，这里给了36个字节的长度，防止DMA传输越界。
-static uint8_t sbus_rx_buf[2][SBUS_RX_BUF_NUM];
+//获取遥控器接收状态指针
+const RC_status_t *get_remote_control_status_point(void)
+{
+  return &rc_status;
+}
+
+//遥控器失控判定
+bool_t remote_control_is_failsafe(void)
+{
+  if(!rc_status.failsafe && (HAL_GetTick() - rc_status.last_rx_time > RC_LOST_TIME_MS))
+  {
+    taskENTER_CRITICAL();
+    //进入临界区后再判断一次 防止期间遥控器任务刚写入新帧
+    if(!rc_status.failsafe && (HAL_GetTick() - rc_status.last_rx_time > RC_LOST_TIME_MS))
+    {
+      rc_status.failsafe = 1;
+      rc_status.valid_streak = 0;
+      rc_status.lost_count++;
+#if RC_LOST_FREEZE_BLACKBOX
+      //正常->失控只在这里发生一次 冻结黑匣子保留掉线前的记录
+      blackbox_freeze(BLACKBOX_FREEZE_RC_LOST, rc_status.lost_count);
+#endif
+    }
+    taskEXIT_CRITICAL();
+  }
+  return rc_status.failsafe;
+}
+
+//读取完整一帧遥控器数据 失控时摇杆与键鼠数据清零 防止沿用最后一帧
+void remote_control_read(RC_ctrl_t *rc_out)
+{
+  uint32_t seq;
+
+  if(rc_out == NULL)
+  {
+    return;
+  }
+
+  //只在拷贝期间写者完成了一帧时重试 写者被本任务抢占时计数不变 不会一直重试
+  do
+  {
+    seq = rc_ctrl_seq;
+    __DMB();
+    *rc_out = rc_ctrl_buf[seq & 1u];
+    __DMB();
+  } while(seq != rc_ctrl_seq);
+
+  if(remote_control_is_failsafe())
+  {
+    rc_out->rc.remote_channel[0] = rc_out->rc.remote_channel[1] = rc_out->rc.remote_channel[2] = 0;
+    rc_out->rc.remote_channel[3] = rc_out->rc.remote_channel[4] = 0;
+    rc_out->mouse.x = rc_out->mouse.y = rc_out->mouse.z = 0;
+    rc_out->mouse.press_left = rc_out->mouse.press_right = 0;
+    rc_out->keyboard.value = 0;
+  }
+}
 
 //遥控器初始化
 void remote_control_init(void)
 {
-  RC_init(sbus_rx_buf[0],sbus_rx_buf[1],SBUS_RX_BUF_NUM);
+  RC_init(sbus_rx_buf[0],sbus_rx_buf[1],SBUS_RX_BUF_NUM,RC_rx_callback);
 }
 
-//串口中断
-void USART3_IRQHandler(void)
+//遥控器任务 等待串口中断通知后解析
+void remote_control_task(void const *pvParameters)
 {
-  if(huart3.Instance->SR & UART_FLAG_RXNE)// 收到数据
+  rc_task_handle = osThreadGetId();
+
+  while(1)
   {
-    __HAL_UART_CLEAR_PEFLAG(&huart3);    
+    //多次通知只处理最新一帧
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    task_job_begin(TASK_RC);
+    RC_frame_handle(sbus_rx_ready_buf);
+    task_job_end(TASK_RC);
   }
-  else if(USART3->SR & UART_FLAG_IDLE)
+}
+
+//串口空闲中断回调 缓冲区切换由bsp_usart完成 这里只通知任务
+static void RC_rx_callback(usart_rx_t *rx, const uint8_t *data, uint16_t len)
+{
+  //长度不是一帧(线路干扰或接收机异常) 丢弃并计数
+  if(len != RC_FRAME_LENGTH)
   {
-    static uint16_t this_time_rx_len = 0;
-    
-    __HAL_UART_CLEAR_PEFLAG(&huart3); 
+    rc_status.length_error_count++;
+    return;
+  }
+  //通知遥控器任务解析
+  if(rc_task_handle != NULL)
+  {
+    BaseType_t higher_priority_task_woken = pdFALSE;
 
-    //判断是0号缓冲区 还是1号缓冲区
-    if((hdma_usart3_rx.Instance->CR & DMA_SxCR_CT) == RESET)
-    {
-      /*这里使用缓冲区0*/
-      //失效DMA
-      __HAL_DMA_DISABLE(&hdma_usart3_rx);
-      //获取接收数据长度 接收数据长度=设定长度-剩余长度
-      this_time_rx_len =  SBUS_RX_BUF_NUM - hdma_usart3_rx.Instance->NDTR;
-      //重新设定数据长度
-      hdma_usart3_rx.Instance->NDTR = SBUS_RX_BUF_NUM;
-      //设定缓冲区1
-      hdma_usart3_rx.Instance->CR |= DMA_SxCR_CT;
-      //使能DMA
-      __HAL_DMA_ENABLE(&hdma_usart3_rx);
-
-      //处理遥控器数据 如果数据等于一帧数据长度 就进行遥控器数据解析
-      if(this_time_rx_len == RC_FRAME_LENGTH)
-      {
-        sbus_to_rc(sbus_rx_buf[0],&rc_ctrl);
-      }
-    }
-    else
-    {
-      /*这里使用缓冲区1*/
-      //失效DMA
-      __HAL_DMA_DISABLE(&hdma_usart3_rx);
-      //获取接收数据长度 接收数据长度=设定长度-剩余长度
-      this_time_rx_len =  SBUS_RX_BUF_NUM - hdma_usart3_rx.Instance->NDTR;
-      //重新设定数据长度
-      hdma_usart3_rx.Instance->NDTR = SBUS_RX_BUF_NUM;
-      //设定缓冲区0
-      hdma_usart3_rx.Instance->CR &= ~DMA_SxCR_CT;
-      //使能DMA
-      __HAL_DMA_ENABLE(&hdma_usart3_rx);
-      
-      //处理遥控器数据 如果数据等于一帧数据长度 就进行遥控器数据解析
-      if(this_time_rx_len == RC_FRAME_LENGTH)
-      {
-        sbus_to_rc(sbus_rx_buf[1],&rc_ctrl);
-      }
-    }
+    sbus_rx_ready_buf = data;
+    vTaskNotifyGiveFromISR(rc_task_handle, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
   }
 }
 
@@ -112,9 +193,9 @@ void USART3_IRQHandler(void)
   * @param[out]     rc_ctrl: 遥控器数据指针
   * @retval         none
   */
- static void sbus_to_rc(volatile const uint8_t *sbus_buf, RC_ctrl_t *rc_ctrl)
+void sbus_to_rc(volatile const uint8_t *sbus_buf, RC_ctrl_t *rc_ctrl)
 {
-  if(sbus_rx_buf == NULL | rc_ctrl == NULL)
+  if(sbus_buf == NULL || rc_ctrl == NULL)
   {
     return;
   }
@@ -125,20 +206,20 @@ void USART3_IRQHandler(void)
   rc_ctrl->rc.remote_channel[3] =((sbus_buf[4] >> 1) | (sbus_buf[5] << 7)) & 0x07ff;
   //波轮通道
 	rc_ctrl->rc.remote_channel[4] =sbus_buf[16] | (sbus_buf[17] << 8);
-	
+
   //开关通道
-  rc_ctrl->rc.switch_channel[0] = ((sbus_buf[5] >> 4) & 0x0003);   
-  rc_ctrl->rc.switch_channel[1] = ((sbus_buf[5] >> 4) & 0x000C) >> 2; 
+  rc_ctrl->rc.switch_channel[0] = ((sbus_buf[5] >> 4) & 0x0003);
+  rc_ctrl->rc.switch_channel[1] = ((sbus_buf[5] >> 4) & 0x000C) >> 2;
 	//鼠标移动
   rc_ctrl->mouse.x = sbus_buf[6] | (sbus_buf[7] << 8);
-  rc_ctrl->mouse.y = sbus_buf[8] | (sbus_buf[9] << 8); 
-  rc_ctrl->mouse.z = sbus_buf[10] | (sbus_buf[11] << 8); 
+  rc_ctrl->mouse.y = sbus_buf[8] | (sbus_buf[9] << 8);
+  rc_ctrl->mouse.z = sbus_buf[10] | (sbus_buf[11] << 8);
 	//鼠标左右键
   rc_ctrl->mouse.press_left =  sbus_buf[12];
-  rc_ctrl->mouse.press_right = sbus_buf[13]; 
+  rc_ctrl->mouse.press_right = sbus_buf[13];
   //键盘数据
-  rc_ctrl->keyboard.value =sbus_buf[14] | (sbus_buf[15] << 8); 
-  
+  rc_ctrl->keyboard.value =sbus_buf[14] | (sbus_buf[15] << 8);
+
   rc_ctrl->rc.remote_channel[0] -= RC_CH_VALUE_OFFSET;
   rc_ctrl->rc.remote_channel[1] -= RC_CH_VALUE_OFFSET;
   rc_ctrl->rc.remote_channel[2] -= RC_CH_VALUE_OFFSET;
@@ -146,3 +227,99 @@ void USART3_IRQHandler(void)
   rc_ctrl->rc.remote_channel[4] -= RC_CH_VALUE_OFFSET;
 
 }
+
+/**
+  * @brief          遥控器数据校验
+  * @param[in]      rc: 解析后的遥控器数据
+  * @retval         1:数据错误 0:数据正常
+  */
+static bool_t RC_data_is_error(const RC_ctrl_t *rc)
+{
+  uint8_t i;
+
+  //摇杆通道范围 [364,1684]
+  for(i = 0; i < 4; i++)
+  {
+    if(rc->rc.remote_channel[i] > RC_CH_VALUE_RANGE || rc->rc.remote_channel[i] < -RC_CH_VALUE_RANGE)
+    {
+      return 1;
+    }
+  }
+  //开关只能为上中下三个挡位
+  for(i = 0; i < 2; i++)
+  {
+    if(!switch_is_up(rc->rc.switch_channel[i]) && !switch_is_mid(rc->rc.switch_channel[i]) && !switch_is_down(rc->rc.switch_channel[i]))
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+  * @brief          处理一帧遥控器数据: 解析、校验、更新接收状态、发布
+  * @param[in]      sbus_buf: 原生数据指针
+  * @retval         none
+  */
+static void RC_frame_handle(volatile const uint8_t *sbus_buf)
+{
+  RC_ctrl_t rc_temp;
+  uint32_t now = HAL_GetTick();
+  uint32_t interval = now - rc_status.last_rx_time;
+
+  sbus_to_rc(sbus_buf, &rc_temp);
+
+  //通道越界 开关值非法 或 与上一帧间隔过短(线路干扰) 均丢弃该帧
+  if(RC_data_is_error(&rc_temp) || (rc_status.frame_count != 0 && interval < RC_FRAME_MIN_INTERVAL_MS))
+  {
+    rc_status.error_count++;
+    rc_status.valid_streak = 0;
+    return;
+  }
+
+  //部分接收机波轮通道不发送数据 越界时按中值处理
+  if(rc_temp.rc.remote_channel[4] > RC_CH_VALUE_RANGE || rc_temp.rc.remote_channel[4] < -RC_CH_VALUE_RANGE)
+  {
+    rc_temp.rc.remote_channel[4] = 0;
+  }
+
+  //按帧周期推算丢帧数
+  if(rc_status.frame_count != 0 && interval > RC_FRAME_PERIOD_MS + RC_FRAME_PERIOD_MS / 2)
+  {
+    rc_status.missed_count += (interval + RC_FRAME_PERIOD_MS / 2) / RC_FRAME_PERIOD_MS - 1;
+  }
+
+  //写入空闲缓冲区后翻转索引发布
+  rc_ctrl_buf[(rc_ctrl_seq + 1u) & 1u] = rc_temp;
+  __DMB();
+  rc_ctrl_seq++;
+
+  //黑匣子记录 遥控器通道只由本任务写入
+  blackbox_write(BLACKBOX_LANE_RC, BLACKBOX_TYPE_RC_STICK, rc_temp.rc.remote_channel, 4 * sizeof(int16_t));
+  {
+    uint8_t data[BLACKBOX_DATA_LEN];
+
+    data[0] = (uint8_t)rc_temp.rc.switch_channel[0];
+    data[1] = (uint8_t)rc_temp.rc.switch_channel[1];
+    memcpy(&data[2], &rc_temp.rc.remote_channel[4], sizeof(int16_t));
+    memcpy(&data[4], &rc_temp.keyboard.value, sizeof(uint16_t));
+    memcpy(&data[6], &rc_temp.mouse.x, sizeof(int16_t));
+    blackbox_write(BLACKBOX_LANE_RC, BLACKBOX_TYPE_RC_SWITCH, data, sizeof(data));
+  }
+
+  taskENTER_CRITICAL();
+  rc_status.frame_interval = interval;
+  rc_status.last_rx_time = now;
+  rc_status.frame_count++;
+
+  //失控保护解除需要连续有效帧
+  if(rc_status.valid_streak < RC_RECOVER_FRAME_NUM)
+  {
+    rc_status.valid_streak++;
+  }
+  if(rc_status.failsafe && rc_status.valid_streak >= RC_RECOVER_FRAME_NUM)
+  {
+    rc_status.failsafe = 0;
+  }
+  taskEXIT_CRITICAL();
+}
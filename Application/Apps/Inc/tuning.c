@@ -0,0 +1,258 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       tuning.c/h
+  * @brief      调参协议，通过调试串口读取、暂存、提交参数，机器人运行中修改PID等参数。
+  * @note       
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.0.1     Oct-19-2026     ICBK            2. 保存检查读取完整一帧遥控器数据
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <string.h>
+#include "tuning.h"
+#include "param.h"
+#include "cobs.h"
+#include "crc.h"
+#include "remote_control.h"
+#include "bsp_debug_usart.h"
+
+//串口接收缓冲区
+static uint8_t tuning_rx_buf[TUNING_RX_BUF_LEN];
+
+//正在接收的帧(COBS编码) 超长时丢弃到下一个分隔符
+static uint8_t tuning_frame[TUNING_FRAME_MAX_LEN];
+static uint16_t tuning_frame_len = 0;
+static bool_t tuning_frame_overflow = 0;
+
+static tuning_status_t tuning_status;
+
+//写入flash时CPU停止读取flash 只允许在底盘不出力时进行
+static bool_t tuning_save_allowed(void)
+{
+  RC_ctrl_t rc;
+
+  if(remote_control_is_failsafe())
+  {
+    return 1;
+  }
+  //get_remote_control_point指向的缓冲区可能正在被遥控器任务改写 拷贝完整一帧后判断
+  remote_control_read(&rc);
+  return switch_is_down(rc.rc.switch_channel[0]);
+}
+
+//处理一个请求 返回应答负载长度
+static uint16_t tuning_request_handle(const uint8_t *request, uint16_t len, uint8_t *reply)
+{
+  uint8_t cmd = request[0];
+  uint16_t id = 0;
+  uint16_t reply_len = 3;
+  param_value_t value;
+  const param_def_t *def;
+
+  reply[0] = cmd | TUNING_REPLY_FLAG;
+  reply[1] = request[1];
+  reply[2] = TUNING_OK;
+
+  if(len >= 4)
+  {
+    memcpy(&id, &request[2], 2);
+  }
+
+  switch(cmd)
+  {
+    case TUNING_CMD_LIST:
+    case TUNING_CMD_GET:
+      if(len != 4)
+      {
+        reply[2] = TUNING_ERROR_FORMAT;
+        break;
+      }
+      def = param_get_def(id);
+      if(def == NULL)
+      {
+        reply[2] = TUNING_ERROR_ID;
+        break;
+      }
+      value = get_param_value_point()[id];
+      memcpy(&reply[3], &id, 2);
+      if(cmd == TUNING_CMD_LIST)
+      {
+        uint16_t num = PARAM_NUM;
+        uint16_t name_len = (uint16_t)strlen(def->name);
+
+        if(name_len > TUNING_REPLY_MAX_LEN - 20)
+        {
+          name_len = TUNING_REPLY_MAX_LEN - 20;
+        }
+        memcpy(&reply[5], &num, 2);
+        reply[7] = (uint8_t)def->type;
+        memcpy(&reply[8], &value, 4);
+        memcpy(&reply[12], &def->min, 4);
+        memcpy(&reply[16], &def->max, 4);
+        memcpy(&reply[20], def->name, name_len);
+        reply_len = 20 + name_len;
+      }
+      else
+      {
+        param_value_t staged;
+        bool_t has_staged = param_get_staged(id, &staged);
+
+        reply[5] = (uint8_t)def->type;
+        memcpy(&reply[6], &value, 4);
+        reply[10] = has_staged;
+        memcpy(&reply[11], has_staged ? &staged : &value, 4);
+        reply_len = 15;
+      }
+      break;
+
+    case TUNING_CMD_SET:
+      if(len != 8)
+      {
+        reply[2] = TUNING_ERROR_FORMAT;
+        break;
+      }
+      memcpy(&value, &request[4], 4);
+      if(param_get_def(id) == NULL)
+      {
+        reply[2] = TUNING_ERROR_ID;
+      }
+      else if(!param_stage(id, value))
+      {
+        reply[2] = TUNING_ERROR_RANGE;
+      }
+      memcpy(&reply[3], &id, 2);
+      memcpy(&reply[5], &value, 4);
+      reply_len = 9;
+      break;
+
+    case TUNING_CMD_COMMIT:
+    {
+      uint16_t count;
+      uint32_t version;
+
+      if(len != 3)
+      {
+        reply[2] = TUNING_ERROR_FORMAT;
+        break;
+      }
+      //先检查是否允许保存 不允许时不提交 暂存值保留
+      if(request[2] && !tuning_save_allowed())
+      {
+        reply[2] = TUNING_ERROR_DENIED;
+        count = 0;
+      }
+      else
+      {
+        count = param_commit();
+        if(request[2] && !param_save())
+        {
+          reply[2] = TUNING_ERROR_FLASH;
+        }
+      }
+      version = param_get_version();
+      memcpy(&reply[3], &version, 4);
+      memcpy(&reply[7], &count, 2);
+      reply_len = 9;
+      break;
+    }
+
+    case TUNING_CMD_DISCARD:
+      if(len != 2)
+      {
+        reply[2] = TUNING_ERROR_FORMAT;
+        break;
+      }
+      param_discard();
+      break;
+
+    default:
+      reply[2] = TUNING_ERROR_FORMAT;
+      break;
+  }
+
+  return reply_len;
+}
+
+//处理一帧完整的COBS编码数据
+static void tuning_frame_handle(tuning_reply_t reply)
+{
+  uint8_t request[TUNING_FRAME_MAX_LEN];
+  uint8_t response[TUNING_REPLY_MAX_LEN];
+  uint16_t len;
+
+  len = cobs_decode(tuning_frame, tuning_frame_len, request);
+  if(len < 2 + 2)
+  {
+    tuning_status.frame_error++;
+    return;
+  }
+  if(!verify_CRC16_check_sum(request, len))
+  {
+    tuning_status.crc_error++;
+    return;
+  }
+
+  tuning_status.request_count++;
+  len = tuning_request_handle(request, len - 2, response);
+  if(reply != NULL)
+  {
+    reply(response, len);
+  }
+}
+
+void tuning_init(void)
+{
+  memset(&tuning_status, 0, sizeof(tuning_status));
+  debug_usart_rx_init(tuning_rx_buf, TUNING_RX_BUF_LEN);
+}
+
+void tuning_poll(tuning_reply_t reply)
+{
+  usart_rx_t *rx = get_debug_usart_rx_point();
+  const uint8_t *data;
+  uint16_t len;
+  uint16_t i;
+
+  //环形缓冲区回绕时分两段读取
+  while((len = usart_rx_peek(rx, &data)) != 0)
+  {
+    for(i = 0; i < len; i++)
+    {
+      if(data[i] == 0x00)
+      {
+        if(tuning_frame_overflow)
+        {
+          tuning_status.frame_error++;
+        }
+        else if(tuning_frame_len != 0)
+        {
+          tuning_frame_handle(reply);
+        }
+        tuning_frame_len = 0;
+        tuning_frame_overflow = 0;
+      }
+      else if(tuning_frame_len < TUNING_FRAME_MAX_LEN)
+      {
+        tuning_frame[tuning_frame_len++] = data[i];
+      }
+      else
+      {
+        tuning_frame_overflow = 1;
+      }
+    }
+    usart_rx_consume(rx, len);
+  }
+}
+
+const tuning_status_t *get_tuning_status_point(void)
+{
+  return &tuning_status;
+}
@@ -3,6 +3,7 @@
 #define CAN_RECEIVE_H
 
 #include "struct_typedef.h"
+#include "msg_bus.h"
 
 #define CHASSIS_CAN hcan1
 #define GIMBAL_CAN hcan2
@@ -21,6 +22,11 @@ typedef enum
     CAN_TRIGGER_MOTOR_ID = 0x207,
     CAN_GIMBAL_ALL_ID = 0x1FF,
 
+    //云台总线上的摩擦轮3508 与底盘电机ID相同 按总线区分
+    CAN_FRIC_ALL_ID = 0x200,
+    CAN_FRIC_M1_ID = 0x201,
+    CAN_FRIC_M2_ID = 0x202,
+
 } can_msg_id_e;
 
 /*----------电机数据结构----------*/
@@ -33,6 +39,16 @@ typedef struct
     int16_t last_ecd;   //上一时刻转子ECD值
 } motor_measure_t;
 
+/*----------底盘电机反馈话题----------*/
+/*四个电机各收到一帧后发布一次 同一样本内的四个反馈来自同一轮回传;
+  某个电机未回传时, 其他电机再次回传即发布, 该电机沿用上一次的数据*/
+typedef struct
+{
+    motor_measure_t motor[4];
+} chassis_motor_msg_t;
+
+MSG_BUS_TOPIC_DECLARE(chassis_motor);
+
 /*----------底盘快速设置电机ID----------*/
 /**
   * @brief          发送ID为0x700的CAN包,它会设置3508电机进入快速设置ID
@@ -41,6 +57,29 @@ typedef struct
   */
 extern void CAN_cmd_chassis_reset_ID(void);
 
+/*----------安全状态----------*/
+/**
+  * @brief          设置安全状态, 安全状态下CAN_cmd_chassis/CAN_cmd_gimbal/CAN_cmd_friction发送的控制电流均为0, 由看门狗任务设置
+  * @param[in]      safe: 1:进入安全状态 0:恢复
+  * @retval         none
+  */
+extern void CAN_cmd_safe_set(bool_t safe);
+
+/**
+  * @brief          是否处于安全状态
+  * @param[in]      none
+  * @retval         1:是 0:否
+  */
+extern bool_t CAN_cmd_safe_get(void);
+
+/**
+  * @brief          CPU长时间停止(擦除flash)前调用: 取消邮箱中未发出的控制帧, 发送全部电机零电流;
+  *                 调用者需挂起调度器, 保证之后没有任务再发送控制帧
+  * @param[in]      none
+  * @retval         none
+  */
+extern void CAN_cmd_stop_all(void);
+
 /*----------发射电机电流数据指针函数----------*/
 /**
   * @brief          发送电机控制电流(0x205,0x206,0x207,0x208)
@@ -52,6 +91,14 @@ extern void CAN_cmd_chassis_reset_ID(void);
   */
 extern void CAN_cmd_gimbal(int16_t yaw, int16_t pitch, int16_t shoot, int16_t rev);
 
+/**
+  * @brief          发送摩擦轮电机控制电流(云台总线0x201,0x202)
+  * @param[in]      fric1: (0x201) 3508电机控制电流, 范围 [-16384,16384]
+  * @param[in]      fric2: (0x202) 3508电机控制电流, 范围 [-16384,16384]
+  * @retval         none
+  */
+extern void CAN_cmd_friction(int16_t fric1, int16_t fric2);
+
 /**
   * @brief          发送电机控制电流(0x201,0x202,0x203,0x204)
   * @param[in]      motor1: (0x201) 3508电机控制电流, 范围 [-16384,16384]
@@ -84,6 +131,13 @@ extern const motor_measure_t *get_pitch_gimbal_motor_measure_point(void);
   */
 extern const motor_measure_t *get_trigger_motor_measure_point(void);
 
+/**
+  * @brief          返回摩擦轮 3508电机数据指针
+  * @param[in]      i: 电机编号,范围[0,1]
+  * @retval         电机数据指针
+  */
+extern const motor_measure_t *get_friction_motor_measure_point(uint8_t i);
+
 /**
   * @brief          返回底盘电机 3508电机数据指针
   * @param[in]      i: 电机编号,范围[0,3]
@@ -0,0 +1,152 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       blackbox.c/h
+  * @brief      黑匣子，RAM环形缓冲区记录控制任务的带时间戳二进制记录，
+  *             在硬件错误、遥控器掉线或手动触发时冻结，热复位后数据保留。
+  * @note       每个任务使用独立的通道(lane)，每个通道只能有一个写者，写入无锁无等待。
+  *             数据放在.noinit段(CCM的UNINIT区域，见MDK-ARM/ICBK_EC_Freame.sct)，
+  *             复位后头部校验有效且已冻结时保持冻结，调用blackbox_clear后重新记录。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.0.1     Oct-19-2026     ICBK            2. 增加冻结原因 软件看门狗
+  *
+  @verbatim
+  ==============================================================================
+    内存布局(小端, 起始地址 BLACKBOX_BASE_ADDR):
+      blackbox_header_t
+      lane[BLACKBOX_LANE_NUM][BLACKBOX_LANE_RECORD_NUM] blackbox_record_t
+    记录写入顺序: seq清0 -> 写时间、类型、数据 -> seq = (序号+1) 的低16位
+    seq为0或与头部写指针推算不符的记录为未写完的记录
+
+    导出: 调试器暂停后保存 BLACKBOX_BASE_ADDR 起 BLACKBOX_REGION_SIZE 字节
+      Keil:    SAVE blackbox.hex 0x1000C000,0x10010000
+      OpenOCD: dump_image blackbox.bin 0x1000C000 0x4000
+    解析: python Tools/blackbox_decode.py blackbox.bin
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef BLACKBOX_H
+#define BLACKBOX_H
+
+#include "struct_typedef.h"
+
+#define BLACKBOX_MAGIC            0x424B4C42u //"BLKB"
+#define BLACKBOX_VERSION          1u
+#define BLACKBOX_BASE_ADDR        0x1000C000u //与分散加载文件RW_NOINIT一致
+#define BLACKBOX_REGION_SIZE      0x4000u
+#define BLACKBOX_LANE_RECORD_NUM  128u        //每个通道记录数 需为2的幂
+#define BLACKBOX_DATA_LEN         8u          //每条记录数据长度
+
+/*通道 每个通道只能由一个任务写入*/
+typedef enum
+{
+  BLACKBOX_LANE_SYSTEM = 0, //冻结原因等系统事件 关中断写入
+  BLACKBOX_LANE_RC,         //遥控器任务
+  BLACKBOX_LANE_CHASSIS,    //底盘任务
+  BLACKBOX_LANE_USER,       //预留
+  BLACKBOX_LANE_NUM,
+} blackbox_lane_e;
+
+/*冻结原因*/
+typedef enum
+{
+  BLACKBOX_RUNNING = 0,
+  BLACKBOX_FREEZE_HARDFAULT,
+  BLACKBOX_FREEZE_RC_LOST,
+  BLACKBOX_FREEZE_TRIGGER,
+  BLACKBOX_FREEZE_WATCHDOG,     //info: 超时的任务编号 见watchdog_task.c
+} blackbox_freeze_e;
+
+/*记录类型*/
+typedef enum
+{
+  BLACKBOX_TYPE_FREEZE = 1,       //data: reason u32, info u32
+  BLACKBOX_TYPE_FAULT_REG,        //data: CFSR u32, HFSR u32
+  BLACKBOX_TYPE_FAULT_PC,         //data: pc u32, lr u32
+  BLACKBOX_TYPE_RC_STICK = 0x10,  //data: ch0~ch3 int16
+  BLACKBOX_TYPE_RC_SWITCH,        //data: s0 u8, s1 u8, ch4 int16, key u16, mouse_x int16
+  BLACKBOX_TYPE_CHASSIS_SET = 0x20, //data: vx fp32, vy fp32
+  BLACKBOX_TYPE_CHASSIS_CURRENT,  //data: give_current[4] int16
+  BLACKBOX_TYPE_CHASSIS_MODE,     //data: mode u8
+} blackbox_type_e;
+
+/*记录 16字节*/
+typedef struct
+{
+  uint32_t time_ms;
+  uint16_t seq;     //写完后为序号+1的低16位 0表示正在写
+  uint8_t type;
+  uint8_t len;
+  uint8_t data[BLACKBOX_DATA_LEN];
+} blackbox_record_t;
+
+/*头部*/
+typedef struct
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t layout;          //通道数<<16 | 每通道记录数 用于校验布局
+  uint32_t check;           //~(magic ^ version ^ layout)
+  uint32_t boot_count;      //热复位次数
+  uint32_t freeze_reason;   //blackbox_freeze_e
+  uint32_t freeze_time_ms;
+  uint32_t freeze_boot;     //冻结发生时的boot_count
+  volatile uint32_t lane_head[BLACKBOX_LANE_NUM]; //各通道累计写入数
+} blackbox_header_t;
+
+/**
+  * @brief          黑匣子初始化, 在调度器启动前调用;
+  *                 热复位且数据有效时保留数据, 否则清空
+  * @param[in]      none
+  * @retval         none
+  */
+extern void blackbox_init(void);
+
+/**
+  * @brief          写入一条记录 无锁无等待, 冻结后忽略
+  * @param[in]      lane: 通道, 同一通道只能由一个任务写入
+  * @param[in]      type: 记录类型
+  * @param[in]      data: 数据
+  * @param[in]      len: 数据长度, 超过BLACKBOX_DATA_LEN截断
+  * @retval         none
+  */
+extern void blackbox_write(blackbox_lane_e lane, uint8_t type, const void *data, uint8_t len);
+
+/**
+  * @brief          冻结黑匣子, 只有第一次调用生效, 可在中断和错误处理中调用
+  * @param[in]      reason: 冻结原因
+  * @param[in]      info: 附加信息
+  * @retval         none
+  */
+extern void blackbox_freeze(blackbox_freeze_e reason, uint32_t info);
+
+/**
+  * @brief          在HardFault_Handler开头调用, 记录错误寄存器与出错地址后冻结
+  * @param[in]      exc_return: 进入异常时的LR(EXC_RETURN), 用BLACKBOX_EXC_RETURN()获取
+  * @retval         none
+  */
+extern void blackbox_freeze_fault(uint32_t exc_return);
+
+/**
+  * @brief          清空并重新开始记录
+  * @param[in]      none
+  * @retval         none
+  */
+extern void blackbox_clear(void);
+
+/**
+  * @brief          是否已冻结
+  * @param[in]      none
+  * @retval         冻结原因, 0为正在记录
+  */
+extern uint32_t blackbox_is_frozen(void);
+
+#if defined(__CC_ARM)
+#define BLACKBOX_EXC_RETURN() __return_address()
+#else
+#define BLACKBOX_EXC_RETURN() ((uint32_t)__builtin_return_address(0))
+#endif
+
+#endif
@@ -0,0 +1,206 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       param.c/h
+  * @brief      参数注册表，参数(名称、类型、默认值、范围)在启动时从flash载入RAM，
+  *             控制任务按编号O(1)读取，修改后保存到flash，不需要重新编译下载。
+  * @note       存储使用内部flash扇区10、11(0x080C0000~0x080FFFFF)，
+  *             分散加载文件已把程序限制在0x080C0000以下，下载程序不会擦除参数。
+  *             默认值来自config_freame.h，flash中的值超出范围时使用默认值。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.1.0     Oct-19-2026     ICBK            2. 暂存修改, 提交时整体生效
+  *
+  @verbatim
+  ==============================================================================
+    添加参数:
+      1. 在param_id_e中添加编号(加在PARAM_NUM之前, 顺序可以调整)
+      2. 在param.c的param_def表中添加名称、类型、默认值与范围
+    参数在flash中以名称的CRC16为键保存, 调整顺序或增删参数不影响已保存的值,
+    修改名称后该参数恢复默认值
+
+    使用:
+      控制任务保存一份参数拷贝, 每个控制周期开始时:
+        if(param_update(&version, param)) { 用param重新设置PID等 }
+      这样一个控制周期内使用的参数来自同一次提交, PID不会看到只改了一半的参数
+    修改(调参协议见tuning.h):
+      param_stage(id, value) 暂存 -> param_commit() 全部暂存值一次生效, 版本号加1
+      param_save() 把修改过的参数写入flash
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef PARAM_H
+#define PARAM_H
+
+#include "struct_typedef.h"
+#include "config_freame.h"
+#include "flash_store.h"
+
+/*参数存储flash扇区 与分散加载文件一致*/
+#define PARAM_FLASH_SECTOR0_ADDR 0x080C0000u  //扇区10
+#define PARAM_FLASH_SECTOR1_ADDR 0x080E0000u  //扇区11
+#define PARAM_FLASH_SECTOR_SIZE  0x20000u     //128KB
+
+/*参数编号*/
+typedef enum
+{
+  PARAM_CHASSIS_SPEED_KP = 0,   //底盘电机速度环
+  PARAM_CHASSIS_SPEED_KI,
+  PARAM_CHASSIS_SPEED_KD,
+  PARAM_CHASSIS_SPEED_MAX_OUT,
+  PARAM_CHASSIS_SPEED_MAX_IOUT,
+  PARAM_CHASSIS_RC_TO_SPEED,    //RC通道值转化速度比
+  PARAM_CHASSIS_RC_DEADZONE,    //遥控器死区
+  PARAM_GIMBAL_YAW_ANGLE_KP,    //云台偏航角度环
+  PARAM_GIMBAL_YAW_ANGLE_KI,
+  PARAM_GIMBAL_YAW_ANGLE_KD,
+  PARAM_GIMBAL_YAW_SPEED_KP,    //云台偏航速度环
+  PARAM_GIMBAL_YAW_SPEED_KI,
+  PARAM_GIMBAL_PITCH_ANGLE_KP,  //云台俯仰角度环
+  PARAM_GIMBAL_PITCH_ANGLE_KI,
+  PARAM_GIMBAL_PITCH_ANGLE_KD,
+  PARAM_GIMBAL_PITCH_SPEED_KP,  //云台俯仰速度环
+  PARAM_GIMBAL_PITCH_SPEED_KI,
+  PARAM_GIMBAL_RC_TO_RATE,      //RC通道值转化云台角速度比
+  PARAM_GIMBAL_RC_DEADZONE,     //云台遥控器死区
+  PARAM_SHOOT_FIRE_MODE,        //射击模式 单发/点射/连发
+  PARAM_SHOOT_BURST_NUM,        //点射发数
+  PARAM_SHOOT_FIRE_RATE,        //射频上限 Hz
+  PARAM_SHOOT_HEAT_LIMIT,       //热量上限 裁判系统数据不可用时使用
+  PARAM_SHOOT_COOLING_RATE,     //每秒冷却值 裁判系统数据不可用时使用
+  PARAM_SHOOT_FRIC_SPEED,       //摩擦轮转速 rpm
+  PARAM_NUM,
+} param_id_e;
+
+/*参数类型*/
+typedef enum
+{
+  PARAM_FP32 = 0,
+  PARAM_INT32,
+  PARAM_UINT32,
+} param_type_e;
+
+/*参数值*/
+typedef union
+{
+  fp32 f;
+  int32_t i;
+  uint32_t u;
+} param_value_t;
+
+/*参数定义*/
+typedef struct
+{
+  const char *name;
+  param_type_e type;
+  param_value_t def;
+  param_value_t min;
+  param_value_t max;
+} param_def_t;
+
+/**
+  * @brief          参数初始化, 在调度器启动前调用: 载入默认值, 再载入flash中保存的值;
+  *                 flash未格式化时写入默认值(首次上电约需1~2s)
+  * @param[in]      none
+  * @retval         none
+  */
+extern void param_init(void);
+
+/**
+  * @brief          获取参数值表, 按param_id_e编号读取; 多个参数需要一致时使用param_update
+  * @param[in]      none
+  * @retval         参数值表指针
+  */
+extern const param_value_t *get_param_value_point(void);
+
+/**
+  * @brief          参数版本号, 每次提交加1
+  * @param[in]      none
+  * @retval         版本号
+  */
+extern uint32_t param_get_version(void);
+
+/**
+  * @brief          参数有更新时拷贝整张参数表, 在控制周期开始时调用
+  * @param[in,out]  version: 调用者持有的版本号, 拷贝后更新
+  * @param[out]     param: 参数表拷贝, 长度PARAM_NUM
+  * @retval         1:有更新并已拷贝 0:无更新
+  */
+extern bool_t param_update(uint32_t *version, param_value_t *param);
+
+/**
+  * @brief          获取参数定义
+  * @param[in]      id: 参数编号
+  * @retval         参数定义, 编号无效返回NULL
+  */
+extern const param_def_t *param_get_def(uint16_t id);
+
+/**
+  * @brief          按名称查找参数
+  * @param[in]      name: 参数名称
+  * @retval         参数编号, 未找到返回-1
+  */
+extern int16_t param_find(const char *name);
+
+/**
+  * @brief          修改单个参数并立即生效(只修改RAM), 类型按参数定义解释
+  * @param[in]      id: 参数编号
+  * @param[in]      value: 参数值
+  * @retval         1:成功 0:编号无效或超出范围
+  */
+extern bool_t param_set(uint16_t id, param_value_t value);
+
+/**
+  * @brief          暂存参数修改, param_commit后生效
+  * @param[in]      id: 参数编号
+  * @param[in]      value: 参数值
+  * @retval         1:成功 0:编号无效或超出范围
+  */
+extern bool_t param_stage(uint16_t id, param_value_t value);
+
+/**
+  * @brief          读取暂存值
+  * @param[in]      id: 参数编号
+  * @param[out]     value: 暂存值
+  * @retval         1:有暂存值 0:没有
+  */
+extern bool_t param_get_staged(uint16_t id, param_value_t *value);
+
+/**
+  * @brief          全部暂存值一次生效, 版本号加1
+  * @param[in]      none
+  * @retval         生效的参数个数
+  */
+extern uint16_t param_commit(void);
+
+/**
+  * @brief          丢弃全部暂存值
+  * @param[in]      none
+  * @retval         none
+  */
+extern void param_discard(void);
+
+/**
+  * @brief          把修改过的参数写入flash; 扇区写满时需要擦除, CPU停止约1~2s,
+  *                 只在机器人停止控制时调用
+  * @param[in]      none
+  * @retval         1:成功 0:写入失败
+  */
+extern bool_t param_save(void);
+
+/**
+  * @brief          全部参数恢复默认值并立即生效(只修改RAM), 之后调用param_save保存
+  * @param[in]      none
+  * @retval         none
+  */
+extern void param_reset_default(void);
+
+/**
+  * @brief          获取参数存储对象, 用于查看载入与擦写统计
+  * @param[in]      none
+  * @retval         存储对象指针
+  */
+extern const flash_store_t *get_param_store_point(void);
+
+#endif
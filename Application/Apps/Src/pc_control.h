@@ -0,0 +1,170 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       pc_control.c/h
+  * @brief      键鼠输入层，计算按键按下/松开边沿、按住时间与消抖，
+  *             按键位映射表把按键转换为动作，输出精简的控制指令。
+  * @note       每收到一帧遥控器数据处理一次，处理时间与按键数量无关(固定18个按键)。
+  *             不依赖HAL与RTOS，时间戳由调用者传入，可在上位机用录制的
+  *             sbus_rx_buf数据经sbus_to_rc解析后回放测试。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    使用方法:
+      pc_control_init(&pc, NULL, 0);                        //使用默认映射表
+      每个控制周期:
+        if(失控) pc_control_reset(&pc);
+        else     cmd = pc_control_update(&pc, &rc, frame_id, now_ms);
+    frame_id 为遥控器有效帧计数, 相同的帧只处理一次
+    默认映射: W/S前后 A/D左右 SHIFT加速 CTRL减速 F切换小陀螺
+              鼠标左键射击 鼠标右键自瞄 鼠标x偏航 鼠标y俯仰
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef PC_CONTROL_H
+#define PC_CONTROL_H
+
+#include "struct_typedef.h"
+#include "config_freame.h"
+#include "remote_control.h"
+
+/*键鼠参数*/
+#define PC_KEY_DEBOUNCE_MS    CONFIG_PC_KEY_DEBOUNCE_MS    //按键消抖时间
+#define PC_KEY_LONG_PRESS_MS  CONFIG_PC_KEY_LONG_PRESS_MS  //长按判定时间
+#define PC_NORMAL_SPEED_SCALE CONFIG_PC_NORMAL_SPEED_SCALE //普通平移速度(归一化)
+#define PC_BOOST_SPEED_SCALE  CONFIG_PC_BOOST_SPEED_SCALE  //加速平移速度(归一化)
+#define PC_SLOW_SPEED_SCALE   CONFIG_PC_SLOW_SPEED_SCALE   //减速平移速度(归一化)
+#define PC_MOUSE_X_SENS       CONFIG_PC_MOUSE_X_SENS       //鼠标x -> 偏航(归一化)
+#define PC_MOUSE_Y_SENS       CONFIG_PC_MOUSE_Y_SENS       //鼠标y -> 俯仰(归一化)
+
+/*按键编号 0~15与keyboard.value位序一致 16、17为鼠标左右键*/
+typedef enum
+{
+  PC_KEY_W = 0,
+  PC_KEY_S,
+  PC_KEY_A,
+  PC_KEY_D,
+  PC_KEY_SHIFT,
+  PC_KEY_CTRL,
+  PC_KEY_Q,
+  PC_KEY_E,
+  PC_KEY_R,
+  PC_KEY_F,
+  PC_KEY_G,
+  PC_KEY_Z,
+  PC_KEY_X,
+  PC_KEY_C,
+  PC_KEY_V,
+  PC_KEY_B,
+  PC_KEY_MOUSE_L,
+  PC_KEY_MOUSE_R,
+  PC_KEY_NUM,
+} pc_key_e;
+
+/*动作*/
+typedef enum
+{
+  PC_ACTION_FORWARD = 0,
+  PC_ACTION_BACKWARD,
+  PC_ACTION_LEFT,
+  PC_ACTION_RIGHT,
+  PC_ACTION_BOOST,
+  PC_ACTION_SLOW,
+  PC_ACTION_SPIN,
+  PC_ACTION_FIRE,
+  PC_ACTION_AIM,
+  PC_ACTION_NUM,
+} pc_action_e;
+
+/*触发方式*/
+typedef enum
+{
+  PC_TRIGGER_HOLD = 0,    //按住期间有效
+  PC_TRIGGER_TOGGLE,      //每次按下切换
+  PC_TRIGGER_LONG_PRESS,  //按住超过PC_KEY_LONG_PRESS_MS后有效
+} pc_trigger_e;
+
+/*按键映射表项*/
+typedef struct
+{
+  uint8_t key;      //pc_key_e
+  uint8_t action;   //pc_action_e
+  uint8_t trigger;  //pc_trigger_e
+} pc_key_map_t;
+
+/*键鼠控制指令*/
+typedef struct
+{
+  fp32 vx;              //前后 [-1,1] 前为正
+  fp32 vy;              //左右 [-1,1] 左为正
+  fp32 yaw;             //偏航 [-1,1] 鼠标x
+  fp32 pitch;           //俯仰 [-1,1] 鼠标y
+  uint16_t actions;     //有效动作位 1 << pc_action_e
+  uint16_t action_edges;//本帧新生效的动作位
+} pc_command_t;
+
+/*键鼠输入状态*/
+typedef struct
+{
+  const pc_key_map_t *map;
+  uint8_t map_len;
+
+  uint32_t frame_id;                  //上次处理的帧号
+  uint32_t now;                       //上次处理的时间 ms
+  uint32_t raw;                       //本帧原始按键位
+  uint32_t state;                     //消抖后的按键位
+  uint32_t pressed;                   //本帧按下沿
+  uint32_t released;                  //本帧松开沿
+  uint32_t raw_change_time[PC_KEY_NUM]; //原始按键最近变化时间
+  uint32_t press_time[PC_KEY_NUM];      //消抖后按下的时间
+  uint16_t toggles;                   //切换型动作状态
+
+  pc_command_t command;
+} pc_control_t;
+
+/*按键位判定*/
+#define pc_key_is_down(pc, key)     (((pc)->state >> (key)) & 1u)
+#define pc_key_is_pressed(pc, key)  (((pc)->pressed >> (key)) & 1u)
+#define pc_key_is_released(pc, key) (((pc)->released >> (key)) & 1u)
+/*动作判定*/
+#define pc_action_is_active(cmd, action) (((cmd)->actions >> (action)) & 1u)
+#define pc_action_is_edge(cmd, action)   (((cmd)->action_edges >> (action)) & 1u)
+
+/**
+  * @brief          键鼠输入初始化
+  * @param[out]     pc: 键鼠输入状态
+  * @param[in]      map: 按键映射表, NULL使用默认映射表
+  * @param[in]      map_len: 映射表长度
+  * @retval         none
+  */
+extern void pc_control_init(pc_control_t *pc, const pc_key_map_t *map, uint8_t map_len);
+
+/**
+  * @brief          清除按键状态与切换状态, 遥控器失控时调用
+  * @param[out]     pc: 键鼠输入状态
+  * @retval         none
+  */
+extern void pc_control_reset(pc_control_t *pc);
+
+/**
+  * @brief          处理一帧键鼠数据, frame_id与上次相同时直接返回上次的指令
+  * @param[in,out]  pc: 键鼠输入状态
+  * @param[in]      rc: 遥控器数据
+  * @param[in]      frame_id: 遥控器有效帧计数
+  * @param[in]      now_ms: 当前时间 ms
+  * @retval         键鼠控制指令
+  */
+extern const pc_command_t *pc_control_update(pc_control_t *pc, const RC_ctrl_t *rc, uint32_t frame_id, uint32_t now_ms);
+
+/**
+  * @brief          按键按住时间
+  * @param[in]      pc: 键鼠输入状态
+  * @param[in]      key: 按键编号
+  * @retval         按住时间 ms, 未按下为0
+  */
+extern uint32_t pc_key_hold_time(const pc_control_t *pc, pc_key_e key);
+
+#endif
@@ -3,7 +3,7 @@
 #define REMOTE_CONTROL_H
 
 #include "struct_typedef.h"
-#include "bsp_rc.h"
+#include "config_freame.h"
 
 #define SBUS_RX_BUF_NUM 32u //缓冲区数据长度
 #define RC_FRAME_LENGTH 18u //遥控器一帧数据长度
@@ -11,6 +11,14 @@
 #define RC_CH_VALUE_MIN         ((uint16_t)364)
 #define RC_CH_VALUE_OFFSET      ((uint16_t)1024) //遥控器中值
 #define RC_CH_VALUE_MAX         ((uint16_t)1684)
+#define RC_CH_VALUE_RANGE       ((int16_t)660)   //去掉中值后通道值的最大幅度
+
+/* ----------------------- 遥控器帧校验与失控保护----------------------------- */
+#define RC_FRAME_PERIOD_MS      14u  //DBUS帧周期
+#define RC_FRAME_MIN_INTERVAL_MS 4u  //两帧最小间隔 小于该值视为干扰帧
+#define RC_LOST_TIME_MS         100u //超过该时间未收到有效帧判定为掉线
+#define RC_LOST_FREEZE_BLACKBOX CONFIG_BLACKBOX_FREEZE_ON_RC_LOST //掉线时冻结黑匣子
+#define RC_RECOVER_FRAME_NUM    3u   //掉线后连续收到该数量有效帧才解除失控保护
 
 /* ----------------------- 遥控器开关挡位定义----------------------------- */
 //挡位映射
@@ -48,6 +56,20 @@ typedef __packed struct
     
 }RC_ctrl_t;
 
+/* ----------------------- 遥控器接收状态------------------------------------- */
+typedef struct
+{
+    uint32_t last_rx_time;    //最近一次有效帧时间 ms
+    uint32_t frame_interval;  //最近两帧有效帧间隔 ms
+    uint32_t frame_count;     //有效帧计数
+    uint32_t error_count;     //校验失败帧计数
+    uint32_t length_error_count; //长度不是一帧的接收计数(串口中断中统计)
+    uint32_t missed_count;    //按帧周期推算的丢帧数
+    uint32_t lost_count;      //掉线次数
+    uint8_t valid_streak;     //连续有效帧数
+    bool_t failsafe;          //失控保护标志 1:失控
+} RC_status_t;
+
 /**
   * @brief          遥控器初始化
   * @param[in]      none
@@ -67,4 +89,41 @@ extern void remote_control_init(void);
   */
 extern const RC_ctrl_t *get_remote_control_point(void);
 
+/**
+  * @brief          获取遥控器接收状态指针
+  * @param[in]      none
+  * @retval         遥控器接收状态指针
+  */
+extern const RC_status_t *get_remote_control_status_point(void);
+
+/**
+  * @brief          遥控器是否处于失控保护, 超过RC_LOST_TIME_MS未收到有效帧即进入失控保护,
+  *                 控制任务每个控制周期开始时调用
+  * @param[in]      none
+  * @retval         1:失控 0:正常
+  */
+extern bool_t remote_control_is_failsafe(void);
+
+/**
+  * @brief          读取完整一帧遥控器数据(双缓冲, 不等待写入中的帧, 任意优先级可调用), 失控时摇杆与键鼠数据为0
+  * @param[out]     rc_out: 遥控器数据拷贝
+  * @retval         none
+  */
+extern void remote_control_read(RC_ctrl_t *rc_out);
+
+/**
+  * @brief          遥控器协议解析, 不带校验, 也可用于上位机回放录制的sbus_rx_buf数据
+  * @param[in]      sbus_buf: 原生数据指针
+  * @param[out]     rc_ctrl: 遥控器数据指针
+  * @retval         none
+  */
+extern void sbus_to_rc(volatile const uint8_t *sbus_buf, RC_ctrl_t *rc_ctrl);
+
+/**
+  * @brief          遥控器任务, 由串口空闲中断通知后解析一帧数据
+  * @param[in]      pvParameters: 空
+  * @retval         none
+  */
+extern void remote_control_task(void const *pvParameters);
+
 #endif
@@ -0,0 +1,98 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       tuning.c/h
+  * @brief      调参协议，通过调试串口读取、暂存、提交参数，机器人运行中修改PID等参数。
+  * @note       请求由调试串口循环DMA接收，在遥测任务中处理，应答随遥测数据一起发送。
+  *             暂存的修改在COMMIT时一次生效，控制任务在下一个控制周期开始时整体载入，
+  *             PID不会看到只改了一半的参数(见param.h)。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    帧格式与遥测相同: COBS(负载 + CRC16) + 0x00
+    请求负载(小端): cmd u8 | seq u8 | 参数
+    应答负载:       cmd|0x80 u8 | seq u8 | status u8 | 内容
+
+    cmd   请求参数                 应答内容
+    0x10  LIST    index u16        index u16 | num u16 | type u8 | value u32 | min u32 | max u32 | name
+    0x11  GET     id u16           id u16 | type u8 | value u32 | staged u8 | staged_value u32
+    0x12  SET     id u16 | value   id u16 | value u32          (暂存, COMMIT后生效)
+    0x13  COMMIT  save u8          version u32 | count u16     (save=1时同时写入flash)
+    0x14  DISCARD                  无
+
+    写入flash可能需要擦除扇区(CPU停止约1~2s), 只在遥控器关闭或左开关在下档(底盘无力)时允许
+    应答可能因发送缓冲区忙被丢弃, 上位机超时后用相同seq重发; SET与COMMIT重复执行结果相同
+    上位机工具: Tools/param_tool.py
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef TUNING_H
+#define TUNING_H
+
+#include "struct_typedef.h"
+#include "config_freame.h"
+
+#define TUNING_RX_BUF_LEN    CONFIG_TUNING_RX_BUF_LEN //串口接收缓冲区长度 2的幂
+#define TUNING_FRAME_MAX_LEN 32                       //请求帧最大长度(COBS编码后)
+#define TUNING_REPLY_MAX_LEN 64                       //应答负载最大长度
+
+/*请求*/
+#define TUNING_CMD_LIST     0x10
+#define TUNING_CMD_GET      0x11
+#define TUNING_CMD_SET      0x12
+#define TUNING_CMD_COMMIT   0x13
+#define TUNING_CMD_DISCARD  0x14
+#define TUNING_REPLY_FLAG   0x80
+
+/*应答状态*/
+typedef enum
+{
+  TUNING_OK = 0,
+  TUNING_ERROR_ID,        //参数编号无效
+  TUNING_ERROR_RANGE,     //超出范围
+  TUNING_ERROR_FORMAT,    //请求长度或命令错误
+  TUNING_ERROR_DENIED,    //当前状态不允许写入flash
+  TUNING_ERROR_FLASH,     //flash写入失败
+} tuning_status_e;
+
+/*调参统计*/
+typedef struct
+{
+  uint32_t request_count;   //处理的请求数
+  uint32_t crc_error;       //CRC错误帧
+  uint32_t frame_error;     //COBS错误或超长帧
+} tuning_status_t;
+
+/**
+  * @brief          发送应答, 由调用者把负载加上CRC16与COBS编码后发送
+  * @param[in]      payload: 应答负载
+  * @param[in]      len: 负载长度
+  * @retval         1:已加入发送缓冲区 0:缓冲区已满
+  */
+typedef bool_t (*tuning_reply_t)(const uint8_t *payload, uint16_t len);
+
+/**
+  * @brief          调参初始化, 开始接收调试串口数据
+  * @param[in]      none
+  * @retval         none
+  */
+extern void tuning_init(void);
+
+/**
+  * @brief          处理已接收的请求, 在遥测任务中周期调用
+  * @param[in]      reply: 应答发送函数
+  * @retval         none
+  */
+extern void tuning_poll(tuning_reply_t reply);
+
+/**
+  * @brief          获取调参统计
+  * @param[in]      none
+  * @retval         调参统计指针
+  */
+extern const tuning_status_t *get_tuning_status_point(void);
+
+#endif
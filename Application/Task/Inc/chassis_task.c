@@ -6,6 +6,11 @@
   * @history
   *  Version    Date            Author          Modification
   *  V0.0.1     Mar-27-2023     Arthurlehao     Done
+  *  V0.0.2     Oct-19-2026     ICBK            速度环使用电机转速反馈; 跟随云台模式在云台任务完成前按不跟随处理
+  *  V0.0.3     Oct-19-2026     ICBK            修正轮速解算(原解算0/2号与1/3号轮相同, 无法平移); 支持麦轮; 小陀螺模式
+  *  V0.0.4     Oct-19-2026     ICBK            控制量计算单独统计执行时间 供基准测试使用
+  *  V0.0.5     Oct-19-2026     ICBK            电机反馈改为订阅chassis_motor话题 每周期读取同一组四个反馈
+  *  V0.0.6     Oct-19-2026     ICBK            每周期统计执行时间 与任务表中的预算比较
   @verbatim
   ==============================================================================
   底盘电机ID顺序 45度角四轮:
@@ -14,6 +19,9 @@
                              | |    
                           2-------3
                               后
+  车体系x向前 y向左 w逆时针为正, 电机正转时轮子推动车体的方向:
+    全向轮 0:右后 1:右前 2:左前 3:左后(均为45度)   麦轮 0、3:向后 1、2:向前
+  解算公式两者相同, 只差系数CHASSIS_WHEEL_SPEED_SCALE
   代码及结构参考：
     RM官方A型步兵开源代码
     深圳大学Pilot战队2021英雄代码开源
@@ -60,9 +68,15 @@
 */
 
 /*------头文件嵌入------*/
+#include "cmsis_os.h"
+
 #include "remote_control.h"
 #include "CAN_receive.h"
 #include "pid.h"
+#include "profile.h"
+#include "telemetry_task.h"
+#include "blackbox.h"
+#include "task_registry.h"
 
 #include "chassis_task.h"
 /*-------宏定义-------*/
@@ -71,19 +85,32 @@
 
 //底盘初始化
 static void chassis_init(chassis_move_t *chassis_move_init);
+
+static void chassis_param_update(chassis_move_t *chassis_move_param_update);
+//电机反馈更新
+static void chassis_feedback_update(chassis_move_t *chassis_move_feedback_update);
+//键鼠输入更新
+static void chassis_pc_update(chassis_move_t *chassis_move_pc_update);
 //遥控器模式选择
 static void chassis_mode_choose(chassis_move_t *chassis_move_mode_choose);
 //控制模式设定
+static int16_t chassis_rc_deadzone(int16_t value, int32_t deadzone);
+
 static void chassis_mode_set(chassis_move_t *chassis_move_mode_set);
 //控制量计算
 static void chassis_control_cal(chassis_move_t *chassis_move_control_cal);
 //全向轮运动解算
 static void chassis_vector_to_omni_wheel_speed(chassis_move_t *chassis_vector_to_motor_speed);
 
+static void chassis_blackbox_log(chassis_move_t *chassis_move_log);
+
 /*------变量定义------*/
 
 chassis_move_t chassis_move_data;  //底盘运动数据
 
+PROFILE_SCOPE_DEFINE(chassis_loop);  //底盘任务单次循环执行时间(不含延时)
+PROFILE_SCOPE_DEFINE(chassis_control);  //控制量计算(运动解算与PID)执行时间
+
 /*------四轮全向轮底盘控制任务------*/
 
 void chassis_task(void const *pvParameters) //底盘任务
@@ -92,15 +119,31 @@ void chassis_task(void const *pvParameters) //底盘任务
 
   while (1)
   {
+    task_job_begin(TASK_CHASSIS);
+    PROFILE_BEGIN(chassis_loop);
+
+    chassis_param_update(&chassis_move_data); //参数修改在控制周期开始时整体生效
+    chassis_feedback_update(&chassis_move_data); //电机转速反馈
+    remote_control_read(&chassis_move_data.chassis_rc_data); //读取完整一帧遥控器数据
+    chassis_pc_update(&chassis_move_data); //键鼠输入 每帧处理一次
     chassis_mode_choose(&chassis_move_data);  //遥控器选择模式模式
     chassis_mode_set(&chassis_move_data); //控制模式设定
-    chassis_control_cal(&chassis_move_data);//控制量计算
+    {
+      PROFILE_BEGIN(chassis_control);
+      chassis_control_cal(&chassis_move_data);//控制量计算
+      PROFILE_END(chassis_control);
+    }
 
     CAN_cmd_chassis(chassis_move_data.chassis_motor[0].give_current,
                     chassis_move_data.chassis_motor[1].give_current,
                     chassis_move_data.chassis_motor[2].give_current,
                     chassis_move_data.chassis_motor[3].give_current);//计算过后的控制电流发送
+    chassis_blackbox_log(&chassis_move_data); //黑匣子记录
 
+    PROFILE_END(chassis_loop);
+    task_job_end(TASK_CHASSIS);
+
+    osDelay(CHASSIS_CONTROL_TIME_MS); //控制周期
   }
 }
 
@@ -111,28 +154,116 @@ static void chassis_init(chassis_move_t *chassis_move_init)
 {
   int8_t i;
 
-  chassis_move_init->chassis_RC = get_remote_control_point(); //遥控器指针获取
+  chassis_move_init->chassis_RC = &chassis_move_init->chassis_rc_data; //遥控器数据拷贝指针
+
+  /*键鼠输入初始化 使用默认按键映射*/
+  pc_control_init(&chassis_move_init->chassis_pc, NULL, 0);
+  chassis_move_init->chassis_pc_cmd = &chassis_move_init->chassis_pc.command;
 
-  /*PID控制器初始化*/
+  /*PID控制器初始化 参数在第一个控制周期开始时由chassis_param_update设置*/
   const static fp32 motor_speed_pid[3] = {CHASSIS_MOTOR_SPEED_PID_KP, CHASSIS_MOTOR_SPEED_PID_KI, CHASSIS_MOTOR_SPEED_PID_KD};  //底盘速度环pid值
   for (i = 0; i < 4; i++)
   {
     PID_init(&chassis_move_init->motor_speed_pid[i], PID_POSITION, motor_speed_pid, CHASSIS_MOTOR_SPEED_PID_MAX_OUT, CHASSIS_MOTOR_SPEED_PID_MAX_IOUT);
   }
+  chassis_move_init->chassis_param_version = 0;
+
+  /*底盘电机数据初始化 指向每周期读取的反馈拷贝*/
+  msg_bus_subscribe(&chassis_move_init->chassis_motor_sub, MSG_BUS_TOPIC(chassis_motor), NULL, 0, NULL, NULL);
+  for (i = 0; i < 4; i++)
+  {
+    chassis_move_init->chassis_motor[i].chassis_motor_measure = &chassis_move_init->chassis_motor_msg.motor[i];
+  }
+
+  /*遥测变量注册*/
+  {
+    static const char *const speed_set_name[4] = {"spd_set0", "spd_set1", "spd_set2", "spd_set3"};
+    static const char *const speed_fdb_name[4] = {"spd_fdb0", "spd_fdb1", "spd_fdb2", "spd_fdb3"};
+    static const char *const pid_out_name[4] = {"pid_out0", "pid_out1", "pid_out2", "pid_out3"};
+    static const char *const rc_channel_name[5] = {"rc_ch0", "rc_ch1", "rc_ch2", "rc_ch3", "rc_ch4"};
+
+    for (i = 0; i < 4; i++)
+    {
+      telemetry_register(speed_set_name[i], &chassis_move_init->chassis_motor[i].speed_set, TELEMETRY_FP32, 1);
+      telemetry_register(speed_fdb_name[i], &chassis_move_init->chassis_motor[i].current_speed_fedback, TELEMETRY_FP32, 1);
+      telemetry_register(pid_out_name[i], &chassis_move_init->motor_speed_pid[i].out, TELEMETRY_FP32, 1);
+    }
+    //遥控器帧周期14ms 抽取7倍
+    for (i = 0; i < 5; i++)
+    {
+      telemetry_register(rc_channel_name[i], &chassis_move_init->chassis_rc_data.rc.remote_channel[i], TELEMETRY_INT16, 7);
+    }
+  }
+
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=参数更新=-=-=-=-=-=-=-=-=-=-=*/
+static void chassis_param_update(chassis_move_t *chassis_move_param_update)
+{
+  const param_value_t *param = chassis_move_param_update->chassis_param;
+  int8_t i;
+
+  //参数没有新的提交 沿用上一周期的拷贝
+  if(!param_update(&chassis_move_param_update->chassis_param_version, chassis_move_param_update->chassis_param))
+  {
+    return;
+  }
 
-  /*底盘电机数据初始化*/
+  //只修改增益与限幅 保留积分等状态
   for (i = 0; i < 4; i++)
   {
-    chassis_move_init->chassis_motor[i].chassis_motor_measure = get_chassis_motor_measure_point(i);
+    chassis_move_param_update->motor_speed_pid[i].Kp = param[PARAM_CHASSIS_SPEED_KP].f;
+    chassis_move_param_update->motor_speed_pid[i].Ki = param[PARAM_CHASSIS_SPEED_KI].f;
+    chassis_move_param_update->motor_speed_pid[i].Kd = param[PARAM_CHASSIS_SPEED_KD].f;
+    chassis_move_param_update->motor_speed_pid[i].max_out = param[PARAM_CHASSIS_SPEED_MAX_OUT].f;
+    chassis_move_param_update->motor_speed_pid[i].max_iout = param[PARAM_CHASSIS_SPEED_MAX_IOUT].f;
   }
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=电机反馈更新=-=-=-=-=-=-=-=-=-=-=*/
+static void chassis_feedback_update(chassis_move_t *chassis_move_feedback_update)
+{
+  int8_t i;
+
+  //读取最新一组反馈 尚未收到时沿用初始值0
+  msg_bus_read(&chassis_move_feedback_update->chassis_motor_sub, &chassis_move_feedback_update->chassis_motor_msg, NULL);
 
+  //速度环目标与反馈均为转子转速 rpm
+  for (i = 0; i < 4; i++)
+  {
+    chassis_move_feedback_update->chassis_motor[i].current_speed_fedback = chassis_move_feedback_update->chassis_motor[i].chassis_motor_measure->speed_rpm;
+  }
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=键鼠输入更新=-=-=-=-=-=-=-=-=-=-=*/
+static void chassis_pc_update(chassis_move_t *chassis_move_pc_update)
+{
+  if(remote_control_is_failsafe()) //遥控器掉线 清除按键与切换状态
+  {
+    pc_control_reset(&chassis_move_pc_update->chassis_pc);
+  }
+  else
+  {
+    chassis_move_pc_update->chassis_pc_cmd = pc_control_update(&chassis_move_pc_update->chassis_pc, chassis_move_pc_update->chassis_RC,
+                                                               get_remote_control_status_point()->frame_count, osKernelSysTick());
+
+    //CTRL+B 手动冻结黑匣子 保留之前的记录用于复盘
+    if(pc_key_is_down(&chassis_move_pc_update->chassis_pc, PC_KEY_CTRL) && pc_key_is_pressed(&chassis_move_pc_update->chassis_pc, PC_KEY_B))
+    {
+      blackbox_freeze(BLACKBOX_FREEZE_TRIGGER, 0);
+    }
+  }
 }
 
 /*=-=-=-=-=-=-=-=-=-=-=遥控器选择模式=-=-=-=-=-=-=-=-=-=-=*/
 static void chassis_mode_choose(chassis_move_t *chassis_move_mode_choose)
 {
 
-  if(switch_is_down(chassis_move_mode_choose->chassis_RC->rc.switch_channel[0])) //下档模式
+  if(remote_control_is_failsafe()) //遥控器掉线 失控保护
+  {
+    chassis_move_mode_choose->chassis_behaviour_mode = CHASSIS_INABILITY; //底盘无力
+  }
+  else if(switch_is_down(chassis_move_mode_choose->chassis_RC->rc.switch_channel[0])) //下档模式
   {
     chassis_move_mode_choose->chassis_behaviour_mode = CHASSIS_INABILITY; //底盘无力
   }
@@ -147,6 +278,16 @@ static void chassis_mode_choose(chassis_move_t *chassis_move_mode_choose)
   
 }
 
+/*=-=-=-=-=-=-=-=-=-=-=遥控器死区=-=-=-=-=-=-=-=-=-=-=*/
+static int16_t chassis_rc_deadzone(int16_t value, int32_t deadzone)
+{
+  if(value < deadzone && value > -deadzone)
+  {
+    return 0;
+  }
+  return value;
+}
+
 /*=-=-=-=-=-=-=-=-=-=-=控制模式设定=-=-=-=-=-=-=-=-=-=-=*/
 static void chassis_mode_set(chassis_move_t *chassis_move_mode_set)
 {
@@ -158,10 +299,25 @@ static void chassis_mode_set(chassis_move_t *chassis_move_mode_set)
       chassis_move_mode_set->vw_set = 0.0f;
       break;
 
+    case CHASSIS_FOLLOW_GIMBAL: //底盘跟随云台 云台任务完成前按不跟随处理
     case CHASSIS_NO_FOLLOW_GIMBAL:  //底盘不跟随云台
-      chassis_move_mode_set->vx_set = chassis_move_mode_set->chassis_RC->rc.remote_channel[CHASSIS_X_CHANNEL] * RC_TO_SPEED_RATIO;
-      chassis_move_mode_set->vy_set = chassis_move_mode_set->chassis_RC->rc.remote_channel[CHASSIS_Y_CHANNEL] * RC_TO_SPEED_RATIO;
-      chassis_move_mode_set->vw_set = chassis_move_mode_set->chassis_RC->rc.remote_channel[CHASSIS_W_CHANNEL] * RC_TO_SPEED_RATIO;
+    case CHASSIS_SPIN_MODE: //小陀螺 平移与不跟随云台相同 以固定转速旋转
+    {
+      const param_value_t *param = chassis_move_mode_set->chassis_param;
+      int32_t deadzone = param[PARAM_CHASSIS_RC_DEADZONE].i;
+
+      //摇杆(去死区)与键鼠叠加 键鼠指令按摇杆满量程换算
+      chassis_move_mode_set->vx_set = (chassis_rc_deadzone(chassis_move_mode_set->chassis_RC->rc.remote_channel[CHASSIS_X_CHANNEL], deadzone) + chassis_move_mode_set->chassis_pc_cmd->vx * RC_CH_VALUE_RANGE) * param[PARAM_CHASSIS_RC_TO_SPEED].f;
+      chassis_move_mode_set->vy_set = (chassis_rc_deadzone(chassis_move_mode_set->chassis_RC->rc.remote_channel[CHASSIS_Y_CHANNEL], deadzone) + chassis_move_mode_set->chassis_pc_cmd->vy * RC_CH_VALUE_RANGE) * param[PARAM_CHASSIS_RC_TO_SPEED].f;
+      if(chassis_move_mode_set->chassis_behaviour_mode == CHASSIS_SPIN_MODE)
+      {
+        chassis_move_mode_set->vw_set = CHASSIS_SPIN_SPEED;
+      }
+      else
+      {
+        chassis_move_mode_set->vw_set = (chassis_rc_deadzone(chassis_move_mode_set->chassis_RC->rc.remote_channel[CHASSIS_W_CHANNEL], deadzone) + chassis_move_mode_set->chassis_pc_cmd->yaw * RC_CH_VALUE_RANGE) * param[PARAM_CHASSIS_RC_TO_SPEED].f;
+      }
+    }
       
       break;
     
@@ -186,6 +342,18 @@ static void chassis_control_cal(chassis_move_t *chassis_move_control_cal)
 {
   int8_t i;
 
+  //底盘无力 不进行PID计算 直接给零电流
+  if(chassis_move_control_cal->chassis_behaviour_mode == CHASSIS_INABILITY)
+  {
+    for (i = 0; i < 4; i++)
+    {
+      PID_clear(&chassis_move_control_cal->motor_speed_pid[i]);
+      chassis_move_control_cal->chassis_motor[i].speed_set = 0.0f;
+      chassis_move_control_cal->chassis_motor[i].give_current = 0;
+    }
+    return;
+  }
+
   //底盘映射速度值转化为各个电机的速度值
   chassis_vector_to_omni_wheel_speed(chassis_move_control_cal);
     
@@ -211,14 +379,15 @@ static void chassis_vector_to_omni_wheel_speed(chassis_move_t *chassis_vector_to
 {   
     int8_t i;
     int16_t wheel_rpm[4];
-    float wheel_rpm_ratio;
-
-    wheel_rpm_ratio = 60.0f/(WHEEL_PERIMETER*3.14f)*CHASSIS_DECELE_RATIO*1000; //车轮转速比 = 60/(轮子周长*3.14) *底盘减速比 *1000
+    //m/s -> rpm 比例、轮子方向系数与旋转力臂均为编译期常量
+    const fp32 wheel_rpm_ratio = CHASSIS_MPS_TO_MOTOR_RPM * CHASSIS_WHEEL_SPEED_SCALE;
+    const fp32 lever_arm = CHASSIS_LEVER_ARM_M;
+    fp32 vw = chassis_vector_to_motor_speed->vw_set * lever_arm;
 
-    wheel_rpm[0] = (chassis_vector_to_motor_speed->vx_set - chassis_vector_to_motor_speed->vy_set + chassis_vector_to_motor_speed->vw_set * ((CHASSIS_LENGTH/2)+(CHASSIS_WIDTH/2))) * wheel_rpm_ratio;
-    wheel_rpm[1] = (chassis_vector_to_motor_speed->vx_set + chassis_vector_to_motor_speed->vy_set - chassis_vector_to_motor_speed->vw_set * ((CHASSIS_LENGTH/2)+(CHASSIS_WIDTH/2))) * wheel_rpm_ratio;
-    wheel_rpm[2] = (chassis_vector_to_motor_speed->vx_set - chassis_vector_to_motor_speed->vy_set + chassis_vector_to_motor_speed->vw_set * ((CHASSIS_LENGTH/2)+(CHASSIS_WIDTH/2))) * wheel_rpm_ratio;
-    wheel_rpm[3] = (chassis_vector_to_motor_speed->vx_set + chassis_vector_to_motor_speed->vy_set - chassis_vector_to_motor_speed->vw_set * ((CHASSIS_LENGTH/2)+(CHASSIS_WIDTH/2))) * wheel_rpm_ratio;
+    wheel_rpm[0] = (-chassis_vector_to_motor_speed->vx_set - chassis_vector_to_motor_speed->vy_set - vw) * wheel_rpm_ratio;
+    wheel_rpm[1] = ( chassis_vector_to_motor_speed->vx_set - chassis_vector_to_motor_speed->vy_set - vw) * wheel_rpm_ratio;
+    wheel_rpm[2] = ( chassis_vector_to_motor_speed->vx_set + chassis_vector_to_motor_speed->vy_set - vw) * wheel_rpm_ratio;
+    wheel_rpm[3] = (-chassis_vector_to_motor_speed->vx_set + chassis_vector_to_motor_speed->vy_set - vw) * wheel_rpm_ratio;
     
     for ( i = 0; i < 4; i++)
     {
@@ -227,3 +396,36 @@ static void chassis_vector_to_omni_wheel_speed(chassis_move_t *chassis_vector_to
     
 }
 
+/*=-=-=-=-=-=-=-=-=-=-=黑匣子记录=-=-=-=-=-=-=-=-=-=-=*/
+static void chassis_blackbox_log(chassis_move_t *chassis_move_log)
+{
+  fp32 speed_set[2];
+  int16_t give_current[4];
+  uint8_t mode;
+  int8_t i;
+
+  //模式变化立即记录
+  if(chassis_move_log->chassis_behaviour_mode != chassis_move_log->blackbox_mode)
+  {
+    chassis_move_log->blackbox_mode = chassis_move_log->chassis_behaviour_mode;
+    mode = (uint8_t)chassis_move_log->chassis_behaviour_mode;
+    blackbox_write(BLACKBOX_LANE_CHASSIS, BLACKBOX_TYPE_CHASSIS_MODE, &mode, sizeof(mode));
+  }
+
+  //速度设定与电流按抽取倍数记录
+  if(++chassis_move_log->blackbox_count < CHASSIS_BLACKBOX_DECIMATION)
+  {
+    return;
+  }
+  chassis_move_log->blackbox_count = 0;
+
+  speed_set[0] = chassis_move_log->vx_set;
+  speed_set[1] = chassis_move_log->vy_set;
+  blackbox_write(BLACKBOX_LANE_CHASSIS, BLACKBOX_TYPE_CHASSIS_SET, speed_set, sizeof(speed_set));
+
+  for (i = 0; i < 4; i++)
+  {
+    give_current[i] = chassis_move_log->chassis_motor[i].give_current;
+  }
+  blackbox_write(BLACKBOX_LANE_CHASSIS, BLACKBOX_TYPE_CHASSIS_CURRENT, give_current, sizeof(give_current));
+}
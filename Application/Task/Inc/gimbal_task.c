@@ -0,0 +1,409 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       gimbal_task.c/h
+  * @brief      云台控制任务，偏航与俯仰两个GM6020，角度环输出角速度目标，
+  *             速度环输出6020电压值，两个电机的指令在同一帧0x1FF中发送。
+  * @note       freeRTOS任务
+  *             姿态角控制时角度与角速度反馈来自ins话题，车体转动不影响云台指向；
+  *             姿态数据超过GIMBAL_INS_TIMEOUT_MS没有更新时改用编码器相对角度与电机转速。
+  *             两种模式都用编码器相对角度做软限位，目标角度不会使云台转出限位范围。
+  *             C板安装在俯仰轴上，x轴向前 z轴向上: 俯仰角速度取陀螺仪y轴，
+  *             偏航角速度取导航系z轴分量(俯仰时不受陀螺仪z轴倾斜影响)。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.0.1     Oct-19-2026     ICBK            2. 0x1FF帧中一起发送发射任务的拨弹电流
+  *
+  @verbatim
+  ==============================================================================
+    每个控制周期:
+      参数更新 -> 反馈更新(ins话题、6020编码器) -> 模式选择 -> 目标角度(摇杆、鼠标、软限位)
+      -> 角度环 -> 速度环 -> CAN_cmd_gimbal(拨弹电流来自发射任务)
+    角度、角速度与电压的方向均与姿态角一致, 电机安装方向由GIMBAL_*_MOTOR_DIR换算
+    模式切换时目标角度取当前反馈, 清除PID, 云台不会跳动
+    上位机仿真: make -C Tools/sim 后运行 build/gimbal_sim
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+/*------头文件嵌入------*/
+#include "cmsis_os.h"
+
+#include "remote_control.h"
+#include "CAN_receive.h"
+#include "pid.h"
+#include "profile.h"
+#include "telemetry_task.h"
+#include "task_registry.h"
+#include "shoot_task.h"
+
+#include "gimbal_task.h"
+/*-------宏定义-------*/
+
+#define GIMBAL_PI 3.14159265f
+#define GIMBAL_2PI 6.28318531f
+
+/*------函数声明------*/
+
+//云台初始化
+static void gimbal_init(gimbal_control_t *gimbal_control_init);
+
+static void gimbal_param_update(gimbal_control_t *gimbal_param_update);
+//姿态与电机反馈更新
+static void gimbal_feedback_update(gimbal_control_t *gimbal_feedback_update);
+//键鼠输入更新
+static void gimbal_pc_update(gimbal_control_t *gimbal_pc_update);
+//遥控器模式选择
+static void gimbal_mode_choose(gimbal_control_t *gimbal_mode_choose);
+//目标角度设定
+static void gimbal_mode_set(gimbal_control_t *gimbal_mode_set);
+//控制量计算
+static void gimbal_control_cal(gimbal_control_t *gimbal_control_cal);
+
+static int16_t gimbal_rc_deadzone(int16_t value, int32_t deadzone);
+
+static fp32 gimbal_rad_format(fp32 angle);
+
+/*------变量定义------*/
+
+gimbal_control_t gimbal_control_data;  //云台控制数据
+
+PROFILE_SCOPE_DEFINE(gimbal_loop);  //云台任务单次循环执行时间(不含延时)
+
+/*------云台控制任务------*/
+
+void gimbal_task(void const *pvParameters)
+{
+  gimbal_init(&gimbal_control_data);
+
+  while (1)
+  {
+    task_job_begin(TASK_GIMBAL);
+    PROFILE_BEGIN(gimbal_loop);
+
+    gimbal_param_update(&gimbal_control_data); //参数修改在控制周期开始时整体生效
+    gimbal_feedback_update(&gimbal_control_data); //姿态与电机反馈
+    remote_control_read(&gimbal_control_data.gimbal_rc_data); //读取完整一帧遥控器数据
+    gimbal_pc_update(&gimbal_control_data); //键鼠输入
+    gimbal_mode_choose(&gimbal_control_data); //遥控器与姿态数据选择模式
+    gimbal_mode_set(&gimbal_control_data); //目标角度设定
+    gimbal_control_cal(&gimbal_control_data); //串级PID计算
+
+    //拨弹电机与6020共用0x1FF帧 发射任务只计算电流
+    CAN_cmd_gimbal(gimbal_control_data.gimbal_yaw_motor.give_current,
+                   gimbal_control_data.gimbal_pitch_motor.give_current,
+                   get_shoot_trigger_current(), 0);
+
+    PROFILE_END(gimbal_loop);
+    task_job_end(TASK_GIMBAL);
+
+    osDelay(GIMBAL_CONTROL_TIME_MS); //控制周期
+  }
+}
+
+fp32 get_gimbal_yaw_relative_angle(void)
+{
+  return gimbal_control_data.gimbal_yaw_motor.relative_angle;
+}
+
+/*------函数定义------*/
+
+/*=-=-=-=-=-=-=-=-=-=-=云台初始化=-=-=-=-=-=-=-=-=-=-=*/
+static void gimbal_init(gimbal_control_t *gimbal_control_init)
+{
+  const static fp32 yaw_angle_pid[3] = {GIMBAL_YAW_ANGLE_PID_KP, GIMBAL_YAW_ANGLE_PID_KI, GIMBAL_YAW_ANGLE_PID_KD};
+  const static fp32 yaw_speed_pid[3] = {GIMBAL_YAW_SPEED_PID_KP, GIMBAL_YAW_SPEED_PID_KI, 0.0f};
+  const static fp32 pitch_angle_pid[3] = {GIMBAL_PITCH_ANGLE_PID_KP, GIMBAL_PITCH_ANGLE_PID_KI, GIMBAL_PITCH_ANGLE_PID_KD};
+  const static fp32 pitch_speed_pid[3] = {GIMBAL_PITCH_SPEED_PID_KP, GIMBAL_PITCH_SPEED_PID_KI, 0.0f};
+  gimbal_motor_t *yaw = &gimbal_control_init->gimbal_yaw_motor;
+  gimbal_motor_t *pitch = &gimbal_control_init->gimbal_pitch_motor;
+
+  gimbal_control_init->gimbal_RC = &gimbal_control_init->gimbal_rc_data; //遥控器数据拷贝指针
+
+  /*键鼠输入初始化 使用默认按键映射 与底盘任务各自处理同一帧*/
+  pc_control_init(&gimbal_control_init->gimbal_pc, NULL, 0);
+  gimbal_control_init->gimbal_pc_cmd = &gimbal_control_init->gimbal_pc.command;
+
+  /*PID控制器初始化 增益在第一个控制周期开始时由gimbal_param_update设置*/
+  PID_init(&yaw->angle_pid, PID_POSITION, yaw_angle_pid, GIMBAL_ANGLE_PID_MAX_OUT, GIMBAL_ANGLE_PID_MAX_IOUT);
+  PID_init(&yaw->speed_pid, PID_POSITION, yaw_speed_pid, GIMBAL_SPEED_PID_MAX_OUT, GIMBAL_SPEED_PID_MAX_IOUT);
+  PID_init(&pitch->angle_pid, PID_POSITION, pitch_angle_pid, GIMBAL_ANGLE_PID_MAX_OUT, GIMBAL_ANGLE_PID_MAX_IOUT);
+  PID_init(&pitch->speed_pid, PID_POSITION, pitch_speed_pid, GIMBAL_SPEED_PID_MAX_OUT, GIMBAL_SPEED_PID_MAX_IOUT);
+  gimbal_control_init->gimbal_param_version = 0;
+
+  /*电机数据与安装参数*/
+  yaw->gimbal_motor_measure = get_yaw_gimbal_motor_measure_point();
+  yaw->offset_ecd = GIMBAL_YAW_OFFSET_ECD;
+  yaw->motor_dir = GIMBAL_YAW_MOTOR_DIR;
+#if GIMBAL_YAW_LIMIT
+  yaw->min_relative_angle = GIMBAL_YAW_MIN_ANGLE;
+  yaw->max_relative_angle = GIMBAL_YAW_MAX_ANGLE;
+#else
+  yaw->min_relative_angle = -GIMBAL_PI;
+  yaw->max_relative_angle = GIMBAL_PI;
+#endif
+  pitch->gimbal_motor_measure = get_pitch_gimbal_motor_measure_point();
+  pitch->offset_ecd = GIMBAL_PITCH_OFFSET_ECD;
+  pitch->motor_dir = GIMBAL_PITCH_MOTOR_DIR;
+  pitch->min_relative_angle = GIMBAL_PITCH_MIN_ANGLE;
+  pitch->max_relative_angle = GIMBAL_PITCH_MAX_ANGLE;
+
+  /*姿态订阅 只读取最新样本 收到第一个样本前按姿态解算停止处理*/
+  msg_bus_subscribe(&gimbal_control_init->gimbal_ins_sub, MSG_BUS_TOPIC(ins), NULL, 0, NULL, NULL);
+  gimbal_control_init->ins_age_ms = GIMBAL_INS_TIMEOUT_MS;
+  gimbal_control_init->ins_online = 0;
+
+  gimbal_control_init->gimbal_behaviour_mode = GIMBAL_ZERO_FORCE;
+  gimbal_control_init->last_behaviour_mode = GIMBAL_ZERO_FORCE;
+
+  /*遥测变量注册*/
+  telemetry_register("yaw_set", &yaw->angle_set, TELEMETRY_FP32, 1);
+  telemetry_register("yaw_fdb", &yaw->angle_fdb, TELEMETRY_FP32, 1);
+  telemetry_register("yaw_out", &yaw->give_current, TELEMETRY_INT16, 1);
+  telemetry_register("pitch_set", &pitch->angle_set, TELEMETRY_FP32, 1);
+  telemetry_register("pitch_fdb", &pitch->angle_fdb, TELEMETRY_FP32, 1);
+  telemetry_register("pitch_out", &pitch->give_current, TELEMETRY_INT16, 1);
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=参数更新=-=-=-=-=-=-=-=-=-=-=*/
+static void gimbal_param_update(gimbal_control_t *gimbal_param_update)
+{
+  const param_value_t *param = gimbal_param_update->gimbal_param;
+  gimbal_motor_t *yaw = &gimbal_param_update->gimbal_yaw_motor;
+  gimbal_motor_t *pitch = &gimbal_param_update->gimbal_pitch_motor;
+
+  //参数没有新的提交 沿用上一周期的拷贝
+  if(!param_update(&gimbal_param_update->gimbal_param_version, gimbal_param_update->gimbal_param))
+  {
+    return;
+  }
+
+  //只修改增益 保留积分等状态
+  yaw->angle_pid.Kp = param[PARAM_GIMBAL_YAW_ANGLE_KP].f;
+  yaw->angle_pid.Ki = param[PARAM_GIMBAL_YAW_ANGLE_KI].f;
+  yaw->angle_pid.Kd = param[PARAM_GIMBAL_YAW_ANGLE_KD].f;
+  yaw->speed_pid.Kp = param[PARAM_GIMBAL_YAW_SPEED_KP].f;
+  yaw->speed_pid.Ki = param[PARAM_GIMBAL_YAW_SPEED_KI].f;
+  pitch->angle_pid.Kp = param[PARAM_GIMBAL_PITCH_ANGLE_KP].f;
+  pitch->angle_pid.Ki = param[PARAM_GIMBAL_PITCH_ANGLE_KI].f;
+  pitch->angle_pid.Kd = param[PARAM_GIMBAL_PITCH_ANGLE_KD].f;
+  pitch->speed_pid.Kp = param[PARAM_GIMBAL_PITCH_SPEED_KP].f;
+  pitch->speed_pid.Ki = param[PARAM_GIMBAL_PITCH_SPEED_KI].f;
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=反馈更新=-=-=-=-=-=-=-=-=-=-=*/
+//编码值相对中位的角度 rad [-pi,pi)
+static fp32 gimbal_ecd_to_angle(uint16_t ecd, uint16_t offset_ecd)
+{
+  int32_t relative_ecd = (int32_t)ecd - (int32_t)offset_ecd;
+
+  if(relative_ecd >= GIMBAL_ECD_RANGE / 2)
+  {
+    relative_ecd -= GIMBAL_ECD_RANGE;
+  }
+  else if(relative_ecd < -GIMBAL_ECD_RANGE / 2)
+  {
+    relative_ecd += GIMBAL_ECD_RANGE;
+  }
+  return relative_ecd * GIMBAL_ECD_TO_RAD;
+}
+
+static void gimbal_feedback_update(gimbal_control_t *gimbal_feedback_update)
+{
+  gimbal_motor_t *yaw = &gimbal_feedback_update->gimbal_yaw_motor;
+  gimbal_motor_t *pitch = &gimbal_feedback_update->gimbal_pitch_motor;
+  const ins_msg_t *ins = &gimbal_feedback_update->gimbal_ins_msg;
+
+  //姿态数据 没有新样本时计时 超时后不再使用
+  if(msg_bus_updated(&gimbal_feedback_update->gimbal_ins_sub))
+  {
+    msg_bus_read(&gimbal_feedback_update->gimbal_ins_sub, &gimbal_feedback_update->gimbal_ins_msg, NULL);
+    gimbal_feedback_update->ins_age_ms = 0;
+  }
+  else if(gimbal_feedback_update->ins_age_ms < GIMBAL_INS_TIMEOUT_MS)
+  {
+    gimbal_feedback_update->ins_age_ms += GIMBAL_CONTROL_TIME_MS;
+  }
+  gimbal_feedback_update->ins_online = gimbal_feedback_update->ins_age_ms < GIMBAL_INS_TIMEOUT_MS;
+
+  //编码器相对角度与电机转速 换算到姿态角方向
+  yaw->relative_angle = yaw->motor_dir * gimbal_ecd_to_angle(yaw->gimbal_motor_measure->ecd, yaw->offset_ecd);
+  yaw->relative_speed = yaw->motor_dir * yaw->gimbal_motor_measure->speed_rpm * GIMBAL_RPM_TO_RADPS;
+  pitch->relative_angle = pitch->motor_dir * gimbal_ecd_to_angle(pitch->gimbal_motor_measure->ecd, pitch->offset_ecd);
+  pitch->relative_speed = pitch->motor_dir * pitch->gimbal_motor_measure->speed_rpm * GIMBAL_RPM_TO_RADPS;
+
+  //姿态角 偏航角速度为机体角速度在导航系z轴上的分量: 旋转矩阵第三行点乘陀螺仪
+  yaw->absolute_angle = ins->euler[AHRS_YAW];
+  yaw->absolute_speed = 2.0f * (ins->q[1] * ins->q[3] - ins->q[0] * ins->q[2]) * ins->gyro[0]
+                      + 2.0f * (ins->q[2] * ins->q[3] + ins->q[0] * ins->q[1]) * ins->gyro[1]
+                      + (1.0f - 2.0f * (ins->q[1] * ins->q[1] + ins->q[2] * ins->q[2])) * ins->gyro[2];
+  pitch->absolute_angle = ins->euler[AHRS_PITCH];
+  pitch->absolute_speed = ins->gyro[1];
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=键鼠输入更新=-=-=-=-=-=-=-=-=-=-=*/
+static void gimbal_pc_update(gimbal_control_t *gimbal_pc_update)
+{
+  if(remote_control_is_failsafe()) //遥控器掉线 清除按键与切换状态
+  {
+    pc_control_reset(&gimbal_pc_update->gimbal_pc);
+  }
+  else
+  {
+    gimbal_pc_update->gimbal_pc_cmd = pc_control_update(&gimbal_pc_update->gimbal_pc, gimbal_pc_update->gimbal_RC,
+                                                        get_remote_control_status_point()->frame_count, osKernelSysTick());
+  }
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=遥控器选择模式=-=-=-=-=-=-=-=-=-=-=*/
+static void gimbal_mode_choose(gimbal_control_t *gimbal_mode_choose)
+{
+  gimbal_mode_choose->last_behaviour_mode = gimbal_mode_choose->gimbal_behaviour_mode;
+
+  if(remote_control_is_failsafe()) //遥控器掉线 失控保护
+  {
+    gimbal_mode_choose->gimbal_behaviour_mode = GIMBAL_ZERO_FORCE;
+  }
+  else if(switch_is_down(gimbal_mode_choose->gimbal_RC->rc.switch_channel[GIMBAL_MODE_CHANNEL])) //下档 与底盘一起无力
+  {
+    gimbal_mode_choose->gimbal_behaviour_mode = GIMBAL_ZERO_FORCE;
+  }
+  else if(gimbal_mode_choose->ins_online) //姿态数据正常 姿态角控制
+  {
+    gimbal_mode_choose->gimbal_behaviour_mode = GIMBAL_ABSOLUTE;
+  }
+  else //姿态解算未启动或停止 编码器控制
+  {
+    gimbal_mode_choose->gimbal_behaviour_mode = GIMBAL_RELATIVE;
+  }
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=遥控器死区=-=-=-=-=-=-=-=-=-=-=*/
+static int16_t gimbal_rc_deadzone(int16_t value, int32_t deadzone)
+{
+  if(value < deadzone && value > -deadzone)
+  {
+    return 0;
+  }
+  return value;
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=角度限幅到[-pi,pi)=-=-=-=-=-=-=-=-=-=-=*/
+//输入为两个[-pi,pi)角度的和或差 最多差一个周期
+static fp32 gimbal_rad_format(fp32 angle)
+{
+  if(angle >= GIMBAL_PI)
+  {
+    angle -= GIMBAL_2PI;
+  }
+  else if(angle < -GIMBAL_PI)
+  {
+    angle += GIMBAL_2PI;
+  }
+  return angle;
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=目标角度 增量与软限位=-=-=-=-=-=-=-=-=-=-=*/
+static void gimbal_angle_set(gimbal_motor_t *motor, gimbal_mode_e mode, fp32 add, bool_t limit)
+{
+  fp32 relative_set;
+
+  if(mode == GIMBAL_ABSOLUTE)
+  {
+    motor->angle_fdb = motor->absolute_angle;
+    motor->speed_fdb = motor->absolute_speed;
+  }
+  else
+  {
+    motor->angle_fdb = motor->relative_angle;
+    motor->speed_fdb = motor->relative_speed;
+  }
+
+  if(!limit)
+  {
+    motor->angle_set = gimbal_rad_format(motor->angle_set + add);
+    return;
+  }
+
+  //目标角度对应的相对角度 = 当前相对角度 + (目标 - 当前反馈), 限制在软限位内后换算回目标
+  relative_set = motor->relative_angle + gimbal_rad_format(motor->angle_set + add - motor->angle_fdb);
+  if(relative_set > motor->max_relative_angle)
+  {
+    relative_set = motor->max_relative_angle;
+  }
+  else if(relative_set < motor->min_relative_angle)
+  {
+    relative_set = motor->min_relative_angle;
+  }
+  motor->angle_set = gimbal_rad_format(motor->angle_fdb + relative_set - motor->relative_angle);
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=目标角度设定=-=-=-=-=-=-=-=-=-=-=*/
+static void gimbal_mode_set(gimbal_control_t *gimbal_mode_set)
+{
+  gimbal_motor_t *yaw = &gimbal_mode_set->gimbal_yaw_motor;
+  gimbal_motor_t *pitch = &gimbal_mode_set->gimbal_pitch_motor;
+  gimbal_mode_e mode = gimbal_mode_set->gimbal_behaviour_mode;
+  const param_value_t *param = gimbal_mode_set->gimbal_param;
+  int32_t deadzone = param[PARAM_GIMBAL_RC_DEADZONE].i;
+  fp32 yaw_add;
+  fp32 pitch_add;
+
+  if(mode == GIMBAL_ZERO_FORCE)
+  {
+    return;
+  }
+
+  //模式切换 目标取当前反馈
+  if(mode != gimbal_mode_set->last_behaviour_mode)
+  {
+    yaw->angle_set = (mode == GIMBAL_ABSOLUTE) ? yaw->absolute_angle : yaw->relative_angle;
+    pitch->angle_set = (mode == GIMBAL_ABSOLUTE) ? pitch->absolute_angle : pitch->relative_angle;
+    PID_clear(&yaw->angle_pid);
+    PID_clear(&yaw->speed_pid);
+    PID_clear(&pitch->angle_pid);
+    PID_clear(&pitch->speed_pid);
+  }
+
+  //摇杆(去死区)与鼠标叠加 鼠标指令按摇杆满量程换算 角速度乘控制周期为本周期的角度增量
+  yaw_add = (gimbal_rc_deadzone(gimbal_mode_set->gimbal_RC->rc.remote_channel[GIMBAL_YAW_CHANNEL], deadzone) + gimbal_mode_set->gimbal_pc_cmd->yaw * RC_CH_VALUE_RANGE) * param[PARAM_GIMBAL_RC_TO_RATE].f * GIMBAL_CONTROL_DT;
+  pitch_add = (gimbal_rc_deadzone(gimbal_mode_set->gimbal_RC->rc.remote_channel[GIMBAL_PITCH_CHANNEL], deadzone) + gimbal_mode_set->gimbal_pc_cmd->pitch * RC_CH_VALUE_RANGE) * param[PARAM_GIMBAL_RC_TO_RATE].f * GIMBAL_CONTROL_DT;
+
+  gimbal_angle_set(yaw, mode, yaw_add, GIMBAL_YAW_LIMIT);
+  gimbal_angle_set(pitch, mode, pitch_add, 1);
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=控制量计算=-=-=-=-=-=-=-=-=-=-=*/
+static void gimbal_motor_control(gimbal_motor_t *motor)
+{
+  //误差按最短方向 偏航越过±pi时不会反转一圈
+  fp32 angle_error = gimbal_rad_format(motor->angle_set - motor->angle_fdb);
+
+  motor->speed_set = PID_calc(&motor->angle_pid, motor->angle_fdb, motor->angle_fdb + angle_error);
+  PID_calc(&motor->speed_pid, motor->speed_fdb, motor->speed_set);
+  motor->give_current = (int16_t)(motor->motor_dir * motor->speed_pid.out);
+}
+
+static void gimbal_control_cal(gimbal_control_t *gimbal_control_cal)
+{
+  gimbal_motor_t *yaw = &gimbal_control_cal->gimbal_yaw_motor;
+  gimbal_motor_t *pitch = &gimbal_control_cal->gimbal_pitch_motor;
+
+  //云台无力 不进行PID计算 直接给零电压
+  if(gimbal_control_cal->gimbal_behaviour_mode == GIMBAL_ZERO_FORCE)
+  {
+    PID_clear(&yaw->angle_pid);
+    PID_clear(&yaw->speed_pid);
+    PID_clear(&pitch->angle_pid);
+    PID_clear(&pitch->speed_pid);
+    yaw->speed_set = 0.0f;
+    pitch->speed_set = 0.0f;
+    yaw->give_current = 0;
+    pitch->give_current = 0;
+    return;
+  }
+
+  gimbal_motor_control(yaw);
+  gimbal_motor_control(pitch);
+}
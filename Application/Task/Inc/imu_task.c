@@ -0,0 +1,237 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       imu_task.c/h
+  * @brief      IMU任务，BMI088陀螺仪FIFO水位中断唤醒，DMA成批读出陀螺仪与加速度计FIFO，
+  *             每个陀螺仪样本配上最近的加速度计样本，带时间戳发布到imu话题。
+  * @note       freeRTOS任务
+  *             驱动见bmi088.c，SPI与中断见bsp_imu.c。
+  *             每批只有两次短的阻塞读取(FIFO帧数、FIFO长度)，FIFO数据由DMA读取，期间任务阻塞。
+  *             水位中断超时(丢中断)时按轮询读取，时间戳按采样时钟推算。
+  *             DMA超时(按传输长度计算)时中止传输并拉高片选，本批数据丢弃，下一批重新读取。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.0.1     Oct-19-2026     ICBK            2. DMA超时后中止传输, 超时时间按传输长度计算
+  *
+  @verbatim
+  ==============================================================================
+    水位中断(EXTI) -> 记录中断时间 -> 任务通知
+    imu_task -> 读陀螺仪FIFO帧数 -> DMA读取 -> 等待DMA中断 -> 解析
+             -> 读加速度计FIFO长度 -> DMA读取 -> 等待DMA中断 -> 解析
+             -> 每个陀螺仪样本发布一次imu话题
+    订阅(调度器启动前):
+      static uint64_t queue[MSG_BUS_QUEUE_WORDS(sizeof(imu_msg_t), 16)];
+      msg_bus_subscribe(&sub, MSG_BUS_TOPIC(imu), queue, 16, NULL, NULL);
+    温度补偿: imu_temp_comp_set(comp, user), 例如按温度扣除陀螺仪零偏
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+/*------头文件嵌入------*/
+#include <string.h>
+#include "cmsis_os.h"
+
+#include "bsp_imu.h"
+
+#include "imu_task.h"
+#include "task_registry.h"
+
+/*------变量定义------*/
+
+#define IMU_NOTIFY_INT 0x01u  //水位中断
+#define IMU_NOTIFY_DMA 0x02u  //DMA读取完成
+#define IMU_NOTIFY_DMA_ERROR 0x04u
+
+//DMA等待超时: 传输时间向上取整到tick 加1个tick的计时粒度与1ms余量 陀螺仪FIFO满(601字节约0.92ms)时为3ms
+#define IMU_DMA_TIMEOUT_MS(len) ((BSP_IMU_TRANSFER_US(len) + 999u) / 1000u + 2u)
+
+//1个发布者 最多2个读者同时占用
+MSG_BUS_TOPIC_DEFINE(imu, imu_msg_t, 1, 2);
+
+static bmi088_t imu_bmi088;
+static imu_status_t imu_status;
+static bmi088_temp_comp_t imu_temp_comp = NULL;
+static void *imu_temp_comp_user = NULL;
+
+static osThreadId imu_task_handle = NULL;
+static volatile uint32_t imu_int_time_us = 0;
+
+//解析结果 静态分配 避免占用任务栈
+static bmi088_sample_t imu_gyro_sample[BMI088_SAMPLE_MAX];
+static bmi088_sample_t imu_accel_sample[BMI088_SAMPLE_MAX];
+static bmi088_sample_t imu_accel_last;
+
+/*------函数定义------*/
+
+void imu_temp_comp_set(bmi088_temp_comp_t comp, void *user)
+{
+  imu_temp_comp = comp;
+  imu_temp_comp_user = user;
+}
+
+const imu_status_t *get_imu_status_point(void)
+{
+  return &imu_status;
+}
+
+const bmi088_t *get_imu_bmi088_point(void)
+{
+  return &imu_bmi088;
+}
+
+static void imu_notify_from_isr(uint32_t bits)
+{
+  BaseType_t higher_priority_task_woken = pdFALSE;
+
+  if(imu_task_handle != NULL)
+  {
+    xTaskNotifyFromISR(imu_task_handle, bits, eSetBits, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+  }
+}
+
+//水位中断
+static void imu_int_callback(uint32_t time_us)
+{
+  imu_int_time_us = time_us;
+  imu_notify_from_isr(IMU_NOTIFY_INT);
+}
+
+static void imu_dma_callback(bool_t ok)
+{
+  imu_notify_from_isr(ok ? IMU_NOTIFY_DMA : IMU_NOTIFY_DMA_ERROR);
+}
+
+//等待任一指定通知 其余通知保留
+static uint32_t imu_wait(uint32_t bits, uint32_t timeout_ms)
+{
+  uint32_t value = 0;
+  TickType_t start = xTaskGetTickCount();
+  TickType_t elapsed;
+
+  while(1)
+  {
+    elapsed = xTaskGetTickCount() - start;
+    if(elapsed > timeout_ms)
+    {
+      return 0;
+    }
+    if(xTaskNotifyWait(0, bits, &value, timeout_ms - elapsed) == pdTRUE && (value & bits))
+    {
+      return value & bits;
+    }
+  }
+}
+
+//等待DMA读取len字节完成 超时中止传输 下一批重新读取
+static bool_t imu_dma_wait(uint16_t len)
+{
+  uint32_t result = imu_wait(IMU_NOTIFY_DMA | IMU_NOTIFY_DMA_ERROR, IMU_DMA_TIMEOUT_MS(len));
+
+  if(result == IMU_NOTIFY_DMA)
+  {
+    return 1;
+  }
+  imu_status.dma_error_count++;
+  if(result == 0)
+  {
+    bsp_imu_dma_abort();
+    imu_status.dma_abort_count++;
+    //中止前DMA可能刚好完成 清除残留的完成通知 以免下一次读取误判
+    xTaskNotifyWait(0, IMU_NOTIFY_DMA | IMU_NOTIFY_DMA_ERROR, NULL, 0);
+  }
+  return 0;
+}
+
+//每个陀螺仪样本配上采样时间不晚于它的最近一个加速度计样本 发布
+static void imu_publish(uint16_t gyro_num, uint16_t accel_num)
+{
+  imu_msg_t msg;
+  uint16_t i;
+  uint16_t j = 0;
+
+  for(i = 0; i < gyro_num; i++)
+  {
+    while(j < accel_num && (int32_t)(imu_accel_sample[j].time_us - imu_gyro_sample[i].time_us) <= 0)
+    {
+      imu_accel_last = imu_accel_sample[j++];
+    }
+    msg.time_us = imu_gyro_sample[i].time_us;
+    memcpy(msg.gyro, imu_gyro_sample[i].value, sizeof(msg.gyro));
+    memcpy(msg.accel, imu_accel_last.value, sizeof(msg.accel));
+    msg.accel_time_us = imu_accel_last.time_us;
+    msg.temp = imu_bmi088.temp;
+    if(msg_bus_publish(MSG_BUS_TOPIC(imu), &msg))
+    {
+      imu_status.publish_count++;
+    }
+  }
+  //晚于本批最后一个陀螺仪样本的加速度计样本留给下一批
+  if(j < accel_num)
+  {
+    imu_accel_last = imu_accel_sample[accel_num - 1u];
+  }
+}
+
+static void imu_sensor_init(void)
+{
+  do
+  {
+    imu_status.init_count++;
+    imu_status.init_error = bmi088_init(&imu_bmi088, IMU_GYRO_RANGE_DPS, IMU_ACCEL_RANGE_G, IMU_FIFO_BATCH);
+    if(imu_status.init_error != BMI088_NO_ERROR)
+    {
+      osDelay(IMU_INIT_RETRY_MS);
+    }
+  } while(imu_status.init_error != BMI088_NO_ERROR);
+
+  bmi088_temp_comp_set(&imu_bmi088, imu_temp_comp, imu_temp_comp_user);
+  memset(&imu_accel_last, 0, sizeof(imu_accel_last));
+}
+
+/*------IMU任务------*/
+
+void imu_task(void const *pvParameters)
+{
+  uint32_t temp_time = 0;
+  uint16_t gyro_num;
+  uint16_t accel_num;
+  bool_t int_valid;
+
+  imu_task_handle = osThreadGetId();
+  bsp_imu_init(imu_int_callback, imu_dma_callback);
+  imu_sensor_init();
+  bsp_imu_int_enable(1);
+
+  while(1)
+  {
+    //丢失中断时按两个批周期轮询
+    int_valid = imu_wait(IMU_NOTIFY_INT, 2 * IMU_BATCH_PERIOD_MS) ? 1 : 0;
+    task_job_begin(TASK_IMU);
+    if(!int_valid)
+    {
+      imu_status.int_timeout_count++;
+    }
+
+    gyro_num = 0;
+    if(bmi088_gyro_fifo_start(&imu_bmi088) && imu_dma_wait(imu_bmi088.gyro_len))
+    {
+      gyro_num = bmi088_gyro_fifo_parse(&imu_bmi088, imu_int_time_us, int_valid, imu_gyro_sample, BMI088_SAMPLE_MAX);
+    }
+    accel_num = 0;
+    if(bmi088_accel_fifo_start(&imu_bmi088, bsp_imu_time_us()) && imu_dma_wait(imu_bmi088.accel_len))
+    {
+      accel_num = bmi088_accel_fifo_parse(&imu_bmi088, imu_accel_sample, BMI088_SAMPLE_MAX);
+    }
+    if(osKernelSysTick() - temp_time >= IMU_TEMP_PERIOD_MS)
+    {
+      temp_time = osKernelSysTick();
+      bmi088_temp_update(&imu_bmi088);
+    }
+
+    imu_publish(gyro_num, accel_num);
+    imu_status.batch_count++;
+    task_job_end(TASK_IMU);
+  }
+}
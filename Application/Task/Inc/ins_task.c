@@ -0,0 +1,250 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       ins_task.c/h
+  * @brief      姿态解算任务，队列订阅imu话题，陀螺仪样本按INS_UPDATE_HZ取平均后
+  *             以固定周期运行Mahony或四元数卡尔曼滤波(ahrs.c)，发布ins话题。
+  * @note       freeRTOS任务
+  *             与IMU任务同一优先级，IMU任务发布时设置的信号不会抢占IMU任务，
+  *             一批样本全部发布后才开始解算。
+  *             解算周期固定为INS_DT，不按样本时间戳计算，时间戳只用于统计丢帧。
+  *             加速度计(1600Hz)只在有新样本时参与修正，板上没有磁力计。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    imu话题(2kHz) -> 队列 -> 每BMI088_GYRO_ODR_HZ/INS_UPDATE_HZ个样本平均 -> ahrs更新 -> ins话题
+    上电后先静止INS_ALIGN_MS, 用加速度计平均值对准横滚俯仰, 偏航为0
+    读取姿态(调度器启动前订阅):
+      msg_bus_subscribe(&sub, MSG_BUS_TOPIC(ins), NULL, 0, NULL, NULL);
+      msg_bus_read(&sub, &ins, NULL); ins.euler[AHRS_YAW]...
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+/*------头文件嵌入------*/
+#include <string.h>
+#include "cmsis_os.h"
+
+#include "imu_task.h"
+#include "ins_task.h"
+#include "task_registry.h"
+
+/*------变量定义------*/
+
+#define INS_GYRO_DIV (BMI088_GYRO_ODR_HZ / INS_UPDATE_HZ)   //每次解算的陀螺仪样本数
+
+CONFIG_STATIC_ASSERT(BMI088_GYRO_ODR_HZ % INS_UPDATE_HZ == 0, ins_update_hz_not_divisor_of_gyro_odr);
+CONFIG_STATIC_ASSERT(INS_QUEUE_DEPTH >= 2 * IMU_FIFO_BATCH, ins_queue_shorter_than_two_batches);
+
+//1个发布者 最多2个读者同时占用
+MSG_BUS_TOPIC_DEFINE(ins, ins_msg_t, 1, 2);
+
+static ins_status_t ins_status;
+static msg_bus_sub_t ins_imu_sub;
+static uint64_t ins_imu_queue[MSG_BUS_QUEUE_WORDS(sizeof(imu_msg_t), INS_QUEUE_DEPTH)];
+
+#if INS_AHRS == INS_AHRS_MAHONY
+static ahrs_mahony_t ins_mahony;
+#else
+static ahrs_ekf_t ins_ekf;
+static const ahrs_ekf_param_t ins_ekf_param =
+{
+  CONFIG_INS_EKF_GYRO_NOISE,
+  CONFIG_INS_EKF_GYRO_BIAS_WALK,
+  CONFIG_INS_EKF_GYRO_BIAS_INIT,
+  CONFIG_INS_EKF_ACCEL_NOISE,
+  0.0f,                             //没有磁力计
+  CONFIG_INS_ACCEL_GATE,
+};
+#endif
+
+/*------函数定义------*/
+
+const ins_status_t *get_ins_status_point(void)
+{
+  return &ins_status;
+}
+
+static void ins_ahrs_init(void)
+{
+#if INS_AHRS == INS_AHRS_MAHONY
+  ahrs_mahony_init(&ins_mahony, CONFIG_INS_MAHONY_KP, CONFIG_INS_MAHONY_KI, INS_DT, CONFIG_INS_ACCEL_GATE);
+#else
+  ahrs_ekf_init(&ins_ekf, &ins_ekf_param, INS_DT);
+#endif
+}
+
+static fp32 *ins_ahrs_quat(void)
+{
+#if INS_AHRS == INS_AHRS_MAHONY
+  return ins_mahony.q;
+#else
+  return ins_ekf.x;
+#endif
+}
+
+//扣除零偏估计后的角速度
+static void ins_ahrs_gyro(const fp32 gyro[3], fp32 out[3])
+{
+  uint8_t i;
+
+  for(i = 0; i < 3; i++)
+  {
+#if INS_AHRS == INS_AHRS_MAHONY
+    out[i] = gyro[i] + ins_mahony.integral[i];
+#else
+    out[i] = gyro[i] - ins_ekf.x[4 + i];
+#endif
+  }
+}
+
+//取出一个imu样本 统计队列溢出与采样间隔
+static bool_t ins_imu_pop(imu_msg_t *msg)
+{
+  static uint32_t last_version = 0;
+  static uint32_t last_time_us = 0;
+  uint32_t version;
+
+  if(!msg_bus_queue_pop(&ins_imu_sub, msg, &version))
+  {
+    return 0;
+  }
+  if(last_version != 0)
+  {
+    ins_status.lost_count += version - last_version - 1u;
+    if(msg->time_us - last_time_us > 3u * 1000000u / (2u * BMI088_GYRO_ODR_HZ))
+    {
+      ins_status.gap_count++;
+    }
+  }
+  last_version = version;
+  last_time_us = msg->time_us;
+  return 1;
+}
+
+//静止对准 加速度计取平均
+static void ins_align(void)
+{
+  imu_msg_t msg;
+  fp32 accel[3] = {0.0f, 0.0f, 0.0f};
+  uint32_t accel_time_us = 0;
+  uint32_t start_us = 0;
+  uint32_t count = 0;
+  uint8_t i;
+
+  while(1)
+  {
+    osSignalWait(MSG_BUS_NOTIFY_SIGNAL, 2 * IMU_BATCH_PERIOD_MS);
+    while(ins_imu_pop(&msg))
+    {
+      //加速度计样本重复或尚未采样时跳过
+      if(msg.accel_time_us == accel_time_us)
+      {
+        continue;
+      }
+      accel_time_us = msg.accel_time_us;
+      if(count == 0)
+      {
+        start_us = msg.time_us;
+      }
+      for(i = 0; i < 3; i++)
+      {
+        accel[i] += msg.accel[i];
+      }
+      count++;
+    }
+    if(count != 0 && msg.time_us - start_us >= INS_ALIGN_MS * 1000u)
+    {
+      break;
+    }
+  }
+
+  for(i = 0; i < 3; i++)
+  {
+    accel[i] /= (fp32)count;
+  }
+  ahrs_align(ins_ahrs_quat(), accel, NULL);
+  ins_status.aligned = 1;
+}
+
+//一次解算并发布
+static void ins_update(const fp32 gyro[3], const fp32 *accel, uint32_t time_us)
+{
+  ins_msg_t msg;
+
+#if INS_AHRS == INS_AHRS_MAHONY
+  ahrs_mahony_update(&ins_mahony, gyro, accel, NULL);
+#else
+  ahrs_ekf_update(&ins_ekf, gyro, accel, NULL);
+#endif
+
+  msg.time_us = time_us;
+  memcpy(msg.q, ins_ahrs_quat(), sizeof(msg.q));
+  ahrs_euler(msg.q, msg.euler);
+  ins_ahrs_gyro(gyro, msg.gyro);
+  msg_bus_publish(MSG_BUS_TOPIC(ins), &msg);
+
+  ins_status.update_count++;
+  if(accel != NULL)
+  {
+    ins_status.accel_update_count++;
+  }
+}
+
+/*------姿态解算任务------*/
+
+void ins_task(void const *pvParameters)
+{
+  imu_msg_t msg;
+  fp32 gyro_sum[3] = {0.0f, 0.0f, 0.0f};
+  fp32 gyro[3];
+  fp32 accel[3];
+  uint32_t accel_time_us = 0;
+  bool_t accel_new = 0;
+  uint8_t gyro_count = 0;
+  uint8_t i;
+
+  msg_bus_subscribe(&ins_imu_sub, MSG_BUS_TOPIC(imu), ins_imu_queue, INS_QUEUE_DEPTH,
+                    msg_bus_notify_signal, osThreadGetId());
+  ins_ahrs_init();
+  ins_align();
+
+  while(1)
+  {
+    //IMU任务每批发布一次 超时说明IMU任务停止 不更新姿态
+    osSignalWait(MSG_BUS_NOTIFY_SIGNAL, 2 * IMU_BATCH_PERIOD_MS);
+    task_job_begin(TASK_INS);
+
+    while(ins_imu_pop(&msg))
+    {
+      for(i = 0; i < 3; i++)
+      {
+        gyro_sum[i] += msg.gyro[i];
+      }
+      if(msg.accel_time_us != accel_time_us)
+      {
+        accel_time_us = msg.accel_time_us;
+        memcpy(accel, msg.accel, sizeof(accel));
+        accel_new = 1;
+      }
+      if(++gyro_count < INS_GYRO_DIV)
+      {
+        continue;
+      }
+
+      for(i = 0; i < 3; i++)
+      {
+        gyro[i] = gyro_sum[i] * (1.0f / INS_GYRO_DIV);
+        gyro_sum[i] = 0.0f;
+      }
+      gyro_count = 0;
+      ins_update(gyro, accel_new ? accel : NULL, msg.time_us);
+      accel_new = 0;
+    }
+
+    task_job_end(TASK_INS);
+  }
+}
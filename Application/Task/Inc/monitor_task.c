@@ -0,0 +1,189 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       monitor_task.c/h
+  * @brief      系统监视任务，周期统计各任务CPU占用、栈历史最小剩余、
+  *             heap_4剩余与历史最小剩余、中断占用，生成紧凑的二进制记录。
+  * @note       freeRTOS任务
+  *             任务运行时间由FreeRTOS运行时间统计提供(时基为DWT周期计数/64)，
+  *             CPU占用按相邻两次采样的差值计算，计数回绕不影响结果。
+  *             中断占用来自profile.h的中断测量点(CONFIG_PROFILE_ENABLE为0时为0)，
+  *             中断时间同时也计入被打断任务的运行时间。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.0.1     Oct-19-2026     ICBK            2. 每周期统计执行时间 与任务表中的预算比较
+  @verbatim
+  ==============================================================================
+    记录格式见monitor_record_t, 小端, 紧凑排列
+    其他任务通过monitor_read获取最近一次记录
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+/*------头文件嵌入------*/
+#include <string.h>
+#include "cmsis_os.h"
+
+#include "bsp_dwt.h"
+#include "profile.h"
+
+#include "monitor_task.h"
+#include "task_registry.h"
+
+/*------变量定义------*/
+
+//需要统计的中断测量点
+PROFILE_SCOPE_DECLARE(can_rx_isr);
+PROFILE_SCOPE_DECLARE(rc_usart_isr);
+
+#if PROFILE_ENABLE
+static const profile_scope_t *const monitor_isr_scope[] =
+{
+  PROFILE_SCOPE_POINT(can_rx_isr),
+  PROFILE_SCOPE_POINT(rc_usart_isr),
+};
+#define MONITOR_ISR_SCOPE_NUM (sizeof(monitor_isr_scope) / sizeof(monitor_isr_scope[0]))
+#endif
+
+//任务状态 静态分配 避免占用监视任务的栈
+static TaskStatus_t monitor_task_status[MONITOR_MAX_TASK_NUM];
+
+//上一次采样的任务运行时间 按任务编号对应
+static struct
+{
+  UBaseType_t task_number;
+  uint32_t run_time;
+} monitor_last_run_time[MONITOR_MAX_TASK_NUM];
+static uint8_t monitor_last_num = 0;
+static uint32_t monitor_last_total_run_time = 0;
+
+static uint64_t monitor_last_cycle = 0;
+static uint64_t monitor_last_isr_cycle = 0;
+
+//发布的记录
+static monitor_record_t monitor_record;
+
+/*------函数定义------*/
+
+//上一次采样的任务运行时间 新任务返回当前值 即本周期占用按0计算
+static uint32_t monitor_last_run_time_get(const TaskStatus_t *status)
+{
+  uint8_t i;
+
+  for(i = 0; i < monitor_last_num; i++)
+  {
+    if(monitor_last_run_time[i].task_number == status->xTaskNumber)
+    {
+      return monitor_last_run_time[i].run_time;
+    }
+  }
+  return status->ulRunTimeCounter;
+}
+
+//已统计中断的累计周期数
+static uint64_t monitor_isr_cycle_get(void)
+{
+  uint64_t isr_cycle = 0;
+#if PROFILE_ENABLE
+  uint8_t i;
+
+  for(i = 0; i < MONITOR_ISR_SCOPE_NUM; i++)
+  {
+    isr_cycle += monitor_isr_scope[i]->total;
+  }
+#endif
+  return isr_cycle;
+}
+
+//采样并生成一条记录
+static void monitor_sample(monitor_record_t *record)
+{
+  UBaseType_t task_num;
+  uint32_t total_run_time;
+  uint32_t total_delta;
+  uint64_t cycle;
+  uint64_t isr_cycle;
+  uint64_t cycle_delta;
+  uint32_t now = osKernelSysTick();
+  uint8_t i;
+
+  task_num = uxTaskGetSystemState(monitor_task_status, MONITOR_MAX_TASK_NUM, &total_run_time);
+  cycle = dwt_cycle64_get();
+  isr_cycle = monitor_isr_cycle_get();
+
+  total_delta = total_run_time - monitor_last_total_run_time;
+  cycle_delta = cycle - monitor_last_cycle;
+
+  record->version = MONITOR_RECORD_VERSION;
+  record->task_num = (uint8_t)task_num;
+  record->seq++;
+  record->period_ms = (uint16_t)(now - record->uptime_ms);
+  record->uptime_ms = now;
+  record->heap_free = (uint32_t)xPortGetFreeHeapSize();
+  record->heap_min_free = (uint32_t)xPortGetMinimumEverFreeHeapSize();
+  record->isr_permille = cycle_delta ? (uint16_t)((isr_cycle - monitor_last_isr_cycle) * 1000u / cycle_delta) : 0;
+
+  for(i = 0; i < task_num; i++)
+  {
+    const TaskStatus_t *status = &monitor_task_status[i];
+    monitor_task_record_t *task = &record->task[i];
+    uint32_t run_delta = status->ulRunTimeCounter - monitor_last_run_time_get(status);
+
+    strncpy(task->name, status->pcTaskName, MONITOR_TASK_NAME_LEN);
+    task->priority = (uint8_t)status->uxCurrentPriority;
+    task->state = (uint8_t)status->eCurrentState;
+    task->cpu_permille = total_delta ? (uint16_t)((uint64_t)run_delta * 1000u / total_delta) : 0;
+    task->stack_free = (uint16_t)status->usStackHighWaterMark;
+  }
+  for(; i < MONITOR_MAX_TASK_NUM; i++)
+  {
+    memset(&record->task[i], 0, sizeof(monitor_task_record_t));
+  }
+
+  //保存本次采样
+  for(i = 0; i < task_num; i++)
+  {
+    monitor_last_run_time[i].task_number = monitor_task_status[i].xTaskNumber;
+    monitor_last_run_time[i].run_time = monitor_task_status[i].ulRunTimeCounter;
+  }
+  monitor_last_num = (uint8_t)task_num;
+  monitor_last_total_run_time = total_run_time;
+  monitor_last_cycle = cycle;
+  monitor_last_isr_cycle = isr_cycle;
+}
+
+void monitor_read(monitor_record_t *record_out)
+{
+  if(record_out == NULL)
+  {
+    return;
+  }
+  taskENTER_CRITICAL();
+  *record_out = monitor_record;
+  taskEXIT_CRITICAL();
+}
+
+/*------系统监视任务------*/
+
+void monitor_task(void const *pvParameters)
+{
+  static monitor_record_t record;
+
+  memset(&record, 0, sizeof(record));
+  monitor_sample(&record); //第一次采样只建立基准
+
+  while(1)
+  {
+    osDelay(MONITOR_PERIOD_MS);
+    task_job_begin(TASK_MONITOR);
+
+    monitor_sample(&record);
+
+    taskENTER_CRITICAL();
+    monitor_record = record;
+    taskEXIT_CRITICAL();
+
+    task_job_end(TASK_MONITOR);
+  }
+}
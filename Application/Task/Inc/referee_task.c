@@ -0,0 +1,99 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       referee_task.c/h
+  * @brief      裁判系统任务，USART6 DMA循环接收，每周期在环形缓冲区上直接解析新数据，
+  *             机器人状态、功率热量、血量有更新时发布referee话题。
+  * @note       freeRTOS任务
+  *             解析不拷贝整帧，不完整的帧留在缓冲区中到下个周期；
+  *             读取不及时被DMA覆盖时丢弃全部未读数据(usart_rx_available)，从下一个SOF重新同步。
+  *             发射任务订阅referee话题，用裁判系统的热量上限、冷却值与枪口热量限制射频。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    USART6 -> DMA2_Stream1循环写入 -> referee_unpack(按帧头CRC8、整帧CRC16校验)
+    -> 按命令码拷贝到referee_t.data -> referee话题
+    读取数据(调度器启动前订阅):
+      msg_bus_subscribe(&sub, MSG_BUS_TOPIC(referee), NULL, 0, NULL, NULL);
+      if(msg_bus_updated(&sub)) msg_bus_read(&sub, &msg, NULL);
+    接收错误统计: get_referee_point()->header_error/crc16_error/...
+    上位机测试: make -C Tools/sim 后运行 build/referee_bench
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+/*------头文件嵌入------*/
+#include "cmsis_os.h"
+
+#include "bsp_referee_usart.h"
+#include "profile.h"
+#include "task_registry.h"
+
+#include "referee_task.h"
+
+/*------变量定义------*/
+
+//1个发布者 最多1个读者同时占用(发射) 增加订阅者时同时增加读者数
+MSG_BUS_TOPIC_DEFINE(referee, referee_msg_t, 1, 1);
+
+static referee_t referee;  //解析器
+static referee_msg_t referee_msg;  //最近一次发布的数据
+static uint8_t referee_rx_buf[REFEREE_RX_BUF_LEN];  //串口DMA环形缓冲区
+
+PROFILE_SCOPE_DEFINE(referee_loop);  //裁判系统任务单次循环执行时间(不含延时)
+
+/*------函数定义------*/
+
+const referee_t *get_referee_point(void)
+{
+  return &referee;
+}
+
+//有新的状态、功率热量或血量数据时发布
+static void referee_publish(void)
+{
+  if((referee.update_flag & REFEREE_MSG_UPDATE) != 0)
+  {
+    referee_msg.time_ms = osKernelSysTick();
+    referee_msg.valid_flag |= referee.update_flag;
+    referee_msg.robot_status = referee.data.robot_status;
+    referee_msg.power_heat = referee.data.power_heat;
+    referee_msg.game_robot_HP = referee.data.game_robot_HP;
+    msg_bus_publish(MSG_BUS_TOPIC(referee), &referee_msg);
+  }
+  referee.update_flag = 0;
+}
+
+/*------裁判系统任务------*/
+
+void referee_task(void const *pvParameters)
+{
+  usart_rx_t *rx;
+  uint16_t unread;
+  uint16_t used;
+
+  referee_init(&referee);
+  referee_usart_rx_init(referee_rx_buf, REFEREE_RX_BUF_LEN);
+  rx = get_referee_usart_rx_point();
+
+  while(1)
+  {
+    task_job_begin(TASK_REFEREE);
+    PROFILE_BEGIN(referee_loop);
+
+    //直接在DMA缓冲区上解析 只移动读指针越过完整帧与丢弃的字节
+    unread = usart_rx_available(rx);
+    used = referee_unpack(&referee, rx->buf[0], rx->buf_len, rx->read_count, unread);
+    usart_rx_consume(rx, used);
+
+    referee_publish();
+
+    PROFILE_END(referee_loop);
+    task_job_end(TASK_REFEREE);
+
+    osDelay(REFEREE_PERIOD_MS);
+  }
+}
@@ -0,0 +1,439 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       shoot_task.c/h
+  * @brief      发射控制任务，两个摩擦轮M3508速度环，拨弹M2006按多圈角度步进，
+  *             每发一颗弹丸拨弹盘转过一格，角度环输出角速度目标，速度环输出电流。
+  * @note       freeRTOS任务
+  *             摩擦轮电流在云台总线0x200帧中发送；拨弹电流与云台6020共用0x1FF帧，
+  *             由云台任务通过get_shoot_trigger_current读取后发送，两个任务周期相同。
+  *             卡弹: 拨弹盘落后目标、转速很低且电流接近限幅持续一段时间后反转，
+  *             反转结束后重新转向原目标，待发射的弹丸不丢失。
+  *             热量: 每发增加SHOOT_HEAT_PER_SHOT，按冷却值连续下降，
+  *             再发一发会超过热量上限时暂停拨弹，射频降到冷却值允许的速度。
+  *             裁判系统在线时热量上限与冷却值来自机器人状态，估计值不低于裁判系统的枪口热量；
+  *             离线时使用参数shoot.heat_limit、shoot.cooling_rate。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.1.0     Oct-19-2026     ICBK            2. 订阅referee话题 热量上限、冷却值与枪口热量来自裁判系统
+  *
+  @verbatim
+  ==============================================================================
+    每个控制周期:
+      参数更新 -> 裁判系统热量 -> 反馈更新(多圈角度、摩擦轮转速) -> 模式选择(摩擦轮斜坡) -> 开火输入
+      -> 拨弹目标(热量、射频、卡弹) -> 拨弹串级PID、摩擦轮速度环 -> CAN_cmd_friction
+    遥控器左开关: 下档无力 中档摩擦轮启动 上档开火; 鼠标左键开火
+    射击模式由参数shoot.fire_mode选择: 0单发 1点射 2连发
+    摩擦轮未到达转速时不发射, 期间的开火输入被忽略
+    每个周期最多推进一格, 没有循环与队列, 执行时间与待发射弹丸数无关
+    上位机仿真: make -C Tools/sim 后运行 build/shoot_sim
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+/*------头文件嵌入------*/
+#include "cmsis_os.h"
+
+#include "remote_control.h"
+#include "CAN_receive.h"
+#include "pid.h"
+#include "profile.h"
+#include "telemetry_task.h"
+#include "task_registry.h"
+
+#include "shoot_task.h"
+/*-------宏定义-------*/
+
+#define SHOOT_2PI 6.28318531f
+#define SHOOT_ABS(x) (((x) >= 0.0f) ? (x) : -(x))
+
+/*------函数声明------*/
+
+//发射机构初始化
+static void shoot_init(shoot_control_t *shoot_init);
+//裁判系统热量上限、冷却值与枪口热量
+static void shoot_referee_update(shoot_control_t *shoot_referee_update);
+//拨弹盘多圈角度与摩擦轮转速更新
+static void shoot_feedback_update(shoot_control_t *shoot_feedback_update);
+//键鼠输入更新
+static void shoot_pc_update(shoot_control_t *shoot_pc_update);
+//遥控器模式选择 摩擦轮转速斜坡
+static void shoot_mode_choose(shoot_control_t *shoot_mode_choose);
+//开火输入 按射击模式累计待发射弹丸
+static void shoot_fire_update(shoot_control_t *shoot_fire_update);
+//拨弹目标 热量、射频与卡弹反转
+static void shoot_trigger_set(shoot_control_t *shoot_trigger_set);
+//控制量计算
+static void shoot_control_cal(shoot_control_t *shoot_control_cal);
+
+/*------变量定义------*/
+
+shoot_control_t shoot_control_data;  //发射控制数据
+
+PROFILE_SCOPE_DEFINE(shoot_loop);  //发射任务单次循环执行时间(不含延时)
+
+/*------发射控制任务------*/
+
+void shoot_task(void const *pvParameters)
+{
+  shoot_init(&shoot_control_data);
+
+  while (1)
+  {
+    task_job_begin(TASK_SHOOT);
+    PROFILE_BEGIN(shoot_loop);
+
+    param_update(&shoot_control_data.shoot_param_version, shoot_control_data.shoot_param); //参数修改在控制周期开始时整体生效
+    shoot_referee_update(&shoot_control_data); //裁判系统热量数据
+    shoot_feedback_update(&shoot_control_data); //拨弹盘与摩擦轮反馈
+    remote_control_read(&shoot_control_data.shoot_rc_data); //读取完整一帧遥控器数据
+    shoot_pc_update(&shoot_control_data); //键鼠输入
+    shoot_mode_choose(&shoot_control_data); //遥控器选择模式 摩擦轮加速
+    shoot_fire_update(&shoot_control_data); //开火输入
+    shoot_trigger_set(&shoot_control_data); //拨弹目标
+    shoot_control_cal(&shoot_control_data); //PID计算
+
+    CAN_cmd_friction(shoot_control_data.fric[0].give_current, shoot_control_data.fric[1].give_current);
+
+    PROFILE_END(shoot_loop);
+    task_job_end(TASK_SHOOT);
+
+    osDelay(SHOOT_CONTROL_TIME_MS); //控制周期
+  }
+}
+
+int16_t get_shoot_trigger_current(void)
+{
+  return shoot_control_data.trigger.give_current;
+}
+
+/*------函数定义------*/
+
+/*=-=-=-=-=-=-=-=-=-=-=发射机构初始化=-=-=-=-=-=-=-=-=-=-=*/
+static void shoot_init(shoot_control_t *shoot_init)
+{
+  const static fp32 trigger_angle_pid[3] = {SHOOT_TRIGGER_ANGLE_PID_KP, 0.0f, 0.0f};
+  const static fp32 trigger_speed_pid[3] = {SHOOT_TRIGGER_SPEED_PID_KP, SHOOT_TRIGGER_SPEED_PID_KI, 0.0f};
+  const static fp32 fric_speed_pid[3] = {SHOOT_FRIC_SPEED_PID_KP, SHOOT_FRIC_SPEED_PID_KI, 0.0f};
+  shoot_trigger_t *trigger = &shoot_init->trigger;
+  uint8_t i;
+
+  shoot_init->shoot_RC = &shoot_init->shoot_rc_data; //遥控器数据拷贝指针
+
+  /*键鼠输入初始化 使用默认按键映射 与底盘、云台任务各自处理同一帧*/
+  pc_control_init(&shoot_init->shoot_pc, NULL, 0);
+  shoot_init->shoot_pc_cmd = &shoot_init->shoot_pc.command;
+  shoot_init->shoot_param_version = 0;
+
+  /*拨弹电机 从当前位置开始累计角度*/
+  PID_init(&trigger->angle_pid, PID_POSITION, trigger_angle_pid, SHOOT_TRIGGER_ANGLE_PID_MAX_OUT, SHOOT_TRIGGER_ANGLE_PID_MAX_IOUT);
+  PID_init(&trigger->speed_pid, PID_POSITION, trigger_speed_pid, SHOOT_TRIGGER_SPEED_PID_MAX_OUT, SHOOT_TRIGGER_SPEED_PID_MAX_IOUT);
+  trigger->trigger_motor_measure = get_trigger_motor_measure_point();
+  trigger->last_ecd = trigger->trigger_motor_measure->ecd;
+  trigger->angle = 0.0f;
+  trigger->angle_set = 0.0f;
+
+  /*摩擦轮电机*/
+  for (i = 0; i < 2; i++)
+  {
+    PID_init(&shoot_init->fric[i].speed_pid, PID_POSITION, fric_speed_pid, SHOOT_FRIC_SPEED_PID_MAX_OUT, SHOOT_FRIC_SPEED_PID_MAX_IOUT);
+    shoot_init->fric[i].fric_motor_measure = get_friction_motor_measure_point(i);
+  }
+
+  shoot_init->shoot_mode = SHOOT_ZERO_FORCE;
+  shoot_init->last_shoot_mode = SHOOT_ZERO_FORCE;
+
+  /*裁判系统 收到数据前按离线处理*/
+  msg_bus_subscribe(&shoot_init->shoot_referee_sub, MSG_BUS_TOPIC(referee), NULL, 0, NULL, NULL);
+  shoot_init->referee_age_ms = SHOOT_REFEREE_TIMEOUT_MS;
+  shoot_init->referee_online = 0;
+
+  /*遥测变量注册*/
+  telemetry_register("trig_set", &trigger->angle_set, TELEMETRY_FP32, 1);
+  telemetry_register("trig_fdb", &trigger->angle, TELEMETRY_FP32, 1);
+  telemetry_register("trig_out", &trigger->give_current, TELEMETRY_INT16, 1);
+  telemetry_register("fric_spd", &shoot_init->fric[0].speed, TELEMETRY_FP32, 1);
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=裁判系统热量=-=-=-=-=-=-=-=-=-=-=*/
+static void shoot_referee_update(shoot_control_t *shoot_referee_update)
+{
+  const param_value_t *param = shoot_referee_update->shoot_param;
+  const referee_msg_t *referee = &shoot_referee_update->shoot_referee_msg;
+
+  if(msg_bus_updated(&shoot_referee_update->shoot_referee_sub))
+  {
+    msg_bus_read(&shoot_referee_update->shoot_referee_sub, &shoot_referee_update->shoot_referee_msg, NULL);
+    shoot_referee_update->referee_age_ms = 0;
+
+    //裁判系统按检测到的弹丸计算热量 比本地估计滞后 只用于修正漏算(如射出时没有经过拨弹的弹丸)
+    if((referee->valid_flag & REFEREE_UPDATE(REFEREE_CMD_POWER_HEAT)) &&
+       shoot_referee_update->heat < referee->power_heat.shooter_17mm_1_barrel_heat)
+    {
+      shoot_referee_update->heat = referee->power_heat.shooter_17mm_1_barrel_heat;
+    }
+  }
+  else if(shoot_referee_update->referee_age_ms < SHOOT_REFEREE_TIMEOUT_MS)
+  {
+    shoot_referee_update->referee_age_ms += SHOOT_CONTROL_TIME_MS;
+  }
+  shoot_referee_update->referee_online = shoot_referee_update->referee_age_ms < SHOOT_REFEREE_TIMEOUT_MS &&
+                                         (referee->valid_flag & REFEREE_UPDATE(REFEREE_CMD_ROBOT_STATUS)) &&
+                                         referee->robot_status.shooter_barrel_heat_limit != 0;
+
+  if(shoot_referee_update->referee_online)
+  {
+    shoot_referee_update->heat_limit = referee->robot_status.shooter_barrel_heat_limit;
+    shoot_referee_update->cooling_rate = referee->robot_status.shooter_barrel_cooling_value;
+  }
+  else
+  {
+    shoot_referee_update->heat_limit = param[PARAM_SHOOT_HEAT_LIMIT].i;
+    shoot_referee_update->cooling_rate = param[PARAM_SHOOT_COOLING_RATE].i;
+  }
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=反馈更新=-=-=-=-=-=-=-=-=-=-=*/
+static void shoot_feedback_update(shoot_control_t *shoot_feedback_update)
+{
+  shoot_trigger_t *trigger = &shoot_feedback_update->trigger;
+  int32_t delta_ecd;
+  int32_t predict_ecd;
+  int32_t wrap;
+
+  /*一个控制周期内转子可能转过半圈以上 编码值差按转速预测值确定整圈数*/
+  delta_ecd = (int32_t)trigger->trigger_motor_measure->ecd - (int32_t)trigger->last_ecd;
+  predict_ecd = (int32_t)trigger->trigger_motor_measure->speed_rpm * (SHOOT_TRIGGER_ECD_RANGE * SHOOT_CONTROL_TIME_MS) / 60000;
+  wrap = predict_ecd - delta_ecd;
+  wrap = (wrap >= 0) ? (wrap + SHOOT_TRIGGER_ECD_RANGE / 2) / SHOOT_TRIGGER_ECD_RANGE : -((-wrap + SHOOT_TRIGGER_ECD_RANGE / 2) / SHOOT_TRIGGER_ECD_RANGE);
+  delta_ecd += wrap * SHOOT_TRIGGER_ECD_RANGE;
+  trigger->last_ecd = trigger->trigger_motor_measure->ecd;
+
+  trigger->angle += SHOOT_TRIGGER_MOTOR_DIR * delta_ecd * SHOOT_TRIGGER_ECD_TO_RAD;
+  trigger->speed = SHOOT_TRIGGER_MOTOR_DIR * trigger->trigger_motor_measure->speed_rpm * SHOOT_TRIGGER_RPM_TO_RADPS;
+
+  //累计角度超过一圈时与目标一起平移 只有差值参与控制 浮点精度不随发射数下降
+  if (trigger->angle >= SHOOT_2PI)
+  {
+    trigger->angle -= SHOOT_2PI;
+    trigger->angle_set -= SHOOT_2PI;
+    shoot_feedback_update->jam_resume_set -= SHOOT_2PI;
+  }
+  else if (trigger->angle <= -SHOOT_2PI)
+  {
+    trigger->angle += SHOOT_2PI;
+    trigger->angle_set += SHOOT_2PI;
+    shoot_feedback_update->jam_resume_set += SHOOT_2PI;
+  }
+
+  shoot_feedback_update->fric[0].speed = shoot_feedback_update->fric[0].fric_motor_measure->speed_rpm;
+  shoot_feedback_update->fric[1].speed = shoot_feedback_update->fric[1].fric_motor_measure->speed_rpm;
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=键鼠输入更新=-=-=-=-=-=-=-=-=-=-=*/
+static void shoot_pc_update(shoot_control_t *shoot_pc_update)
+{
+  if(remote_control_is_failsafe()) //遥控器掉线 清除按键与切换状态
+  {
+    pc_control_reset(&shoot_pc_update->shoot_pc);
+  }
+  else
+  {
+    shoot_pc_update->shoot_pc_cmd = pc_control_update(&shoot_pc_update->shoot_pc, shoot_pc_update->shoot_RC,
+                                                      get_remote_control_status_point()->frame_count, osKernelSysTick());
+  }
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=遥控器选择模式=-=-=-=-=-=-=-=-=-=-=*/
+static void shoot_mode_choose(shoot_control_t *shoot_mode_choose)
+{
+  fp32 fric_target = shoot_mode_choose->shoot_param[PARAM_SHOOT_FRIC_SPEED].f;
+
+  shoot_mode_choose->last_shoot_mode = shoot_mode_choose->shoot_mode;
+
+  if(remote_control_is_failsafe() || switch_is_down(shoot_mode_choose->shoot_RC->rc.switch_channel[SHOOT_MODE_CHANNEL])) //掉线或下档 无力
+  {
+    shoot_mode_choose->shoot_mode = SHOOT_ZERO_FORCE;
+    shoot_mode_choose->fric_speed_set = 0.0f;
+    return;
+  }
+
+  //从无力启动 摩擦轮可能仍在转动 斜坡从当前转速开始
+  if(shoot_mode_choose->last_shoot_mode == SHOOT_ZERO_FORCE)
+  {
+    shoot_mode_choose->fric_speed_set = 0.5f * (SHOOT_ABS(shoot_mode_choose->fric[0].speed) + SHOOT_ABS(shoot_mode_choose->fric[1].speed));
+  }
+
+  if(shoot_mode_choose->fric_speed_set < fric_target - SHOOT_FRIC_RAMP)
+  {
+    shoot_mode_choose->fric_speed_set += SHOOT_FRIC_RAMP;
+  }
+  else if(shoot_mode_choose->fric_speed_set > fric_target + SHOOT_FRIC_RAMP)
+  {
+    shoot_mode_choose->fric_speed_set -= SHOOT_FRIC_RAMP;
+  }
+  else
+  {
+    shoot_mode_choose->fric_speed_set = fric_target;
+  }
+
+  //斜坡结束且两个摩擦轮都到达转速才允许发射
+  if(shoot_mode_choose->fric_speed_set == fric_target &&
+     SHOOT_ABS(shoot_mode_choose->fric[0].speed - fric_target) < SHOOT_FRIC_READY_RPM &&
+     SHOOT_ABS(shoot_mode_choose->fric[1].speed + fric_target) < SHOOT_FRIC_READY_RPM)
+  {
+    shoot_mode_choose->shoot_mode = SHOOT_READY;
+  }
+  else
+  {
+    shoot_mode_choose->shoot_mode = SHOOT_FRIC_UP;
+  }
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=开火输入=-=-=-=-=-=-=-=-=-=-=*/
+static void shoot_fire_update(shoot_control_t *shoot_fire_update)
+{
+  const param_value_t *param = shoot_fire_update->shoot_param;
+  uint32_t pending = shoot_fire_update->shoot_pending;
+  bool_t fire_edge;
+
+  shoot_fire_update->fire_input = !remote_control_is_failsafe() &&
+                                  (switch_is_up(shoot_fire_update->shoot_RC->rc.switch_channel[SHOOT_MODE_CHANNEL]) ||
+                                   pc_action_is_active(shoot_fire_update->shoot_pc_cmd, PC_ACTION_FIRE));
+  fire_edge = shoot_fire_update->fire_input && !shoot_fire_update->last_fire_input;
+  shoot_fire_update->last_fire_input = shoot_fire_update->fire_input;
+
+  //摩擦轮未就绪 不累计也不保留待发射弹丸
+  if(shoot_fire_update->shoot_mode != SHOOT_READY)
+  {
+    shoot_fire_update->shoot_pending = 0;
+    return;
+  }
+
+  switch(param[PARAM_SHOOT_FIRE_MODE].i)
+  {
+    case SHOOT_FIRE_SINGLE:
+    {
+      pending += fire_edge;
+      break;
+    }
+    case SHOOT_FIRE_BURST:
+    {
+      pending += fire_edge ? (uint32_t)param[PARAM_SHOOT_BURST_NUM].i : 0u;
+      break;
+    }
+    default: //连发 按住期间始终有一发待发射 松开立即停止
+    {
+      pending = shoot_fire_update->fire_input;
+      break;
+    }
+  }
+
+  shoot_fire_update->shoot_pending = (uint16_t)((pending > SHOOT_PENDING_MAX) ? SHOOT_PENDING_MAX : pending);
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=拨弹目标=-=-=-=-=-=-=-=-=-=-=*/
+static void shoot_trigger_set(shoot_control_t *shoot_trigger_set)
+{
+  const param_value_t *param = shoot_trigger_set->shoot_param;
+  shoot_trigger_t *trigger = &shoot_trigger_set->trigger;
+
+  //热量按冷却值连续下降 射频计时
+  shoot_trigger_set->heat -= shoot_trigger_set->cooling_rate * SHOOT_CONTROL_DT;
+  if(shoot_trigger_set->heat < 0.0f)
+  {
+    shoot_trigger_set->heat = 0.0f;
+  }
+  shoot_trigger_set->fire_wait_ms = (shoot_trigger_set->fire_wait_ms > SHOOT_CONTROL_TIME_MS) ? shoot_trigger_set->fire_wait_ms - SHOOT_CONTROL_TIME_MS : 0;
+
+  //无力 目标跟随当前角度 上电后不会补转
+  if(shoot_trigger_set->shoot_mode == SHOOT_ZERO_FORCE)
+  {
+    trigger->angle_set = trigger->angle;
+    shoot_trigger_set->jam_ms = 0;
+    shoot_trigger_set->reverse_ms = 0;
+    return;
+  }
+
+  //反转中 结束后重新转向原目标
+  if(shoot_trigger_set->reverse_ms != 0)
+  {
+    shoot_trigger_set->reverse_ms = (shoot_trigger_set->reverse_ms > SHOOT_CONTROL_TIME_MS) ? shoot_trigger_set->reverse_ms - SHOOT_CONTROL_TIME_MS : 0;
+    if(shoot_trigger_set->reverse_ms == 0)
+    {
+      trigger->angle_set = shoot_trigger_set->jam_resume_set;
+    }
+    return;
+  }
+
+  //卡弹检测 落后目标、几乎不转且向供弹方向的电流接近限幅
+  if(trigger->angle_set - trigger->angle > SHOOT_JAM_ERROR && SHOOT_ABS(trigger->speed) < SHOOT_JAM_SPEED &&
+     trigger->speed_pid.out >= SHOOT_JAM_CURRENT)
+  {
+    shoot_trigger_set->jam_ms += SHOOT_CONTROL_TIME_MS;
+  }
+  else
+  {
+    shoot_trigger_set->jam_ms = 0;
+  }
+  if(shoot_trigger_set->jam_ms >= SHOOT_JAM_TIME_MS)
+  {
+    shoot_trigger_set->jam_ms = 0;
+    shoot_trigger_set->jam_count++;
+    shoot_trigger_set->jam_resume_set = trigger->angle_set;
+    shoot_trigger_set->reverse_ms = SHOOT_REVERSE_TIME_MS;
+    trigger->angle_set = trigger->angle - SHOOT_REVERSE_ANGLE;
+    PID_clear(&trigger->speed_pid); //清除堵转时积累的积分 立即反转
+    return;
+  }
+
+  //推进一格: 有待发射弹丸、射频间隔已到、上一格已转过一半、发射后不超过热量上限
+  if(shoot_trigger_set->shoot_mode == SHOOT_READY && shoot_trigger_set->shoot_pending != 0 &&
+     shoot_trigger_set->fire_wait_ms == 0 && trigger->angle_set - trigger->angle < 0.5f * SHOOT_TRIGGER_STEP &&
+     shoot_trigger_set->heat + SHOOT_HEAT_PER_SHOT <= shoot_trigger_set->heat_limit)
+  {
+    trigger->angle_set += SHOOT_TRIGGER_STEP;
+    shoot_trigger_set->shoot_pending--;
+    shoot_trigger_set->shoot_count++;
+    shoot_trigger_set->heat += SHOOT_HEAT_PER_SHOT;
+    shoot_trigger_set->fire_wait_ms = (uint16_t)(1000.0f / param[PARAM_SHOOT_FIRE_RATE].f);
+  }
+}
+
+/*=-=-=-=-=-=-=-=-=-=-=控制量计算=-=-=-=-=-=-=-=-=-=-=*/
+static void shoot_control_cal(shoot_control_t *shoot_control_cal)
+{
+  shoot_trigger_t *trigger = &shoot_control_cal->trigger;
+  uint8_t i;
+
+  //无力 不进行PID计算 直接给零电流
+  if(shoot_control_cal->shoot_mode == SHOOT_ZERO_FORCE)
+  {
+    PID_clear(&trigger->angle_pid);
+    PID_clear(&trigger->speed_pid);
+    trigger->speed_set = 0.0f;
+    trigger->give_current = 0;
+    for (i = 0; i < 2; i++)
+    {
+      PID_clear(&shoot_control_cal->fric[i].speed_pid);
+      shoot_control_cal->fric[i].speed_set = 0.0f;
+      shoot_control_cal->fric[i].give_current = 0;
+    }
+    return;
+  }
+
+  //拨弹盘 角度环 -> 速度环
+  trigger->speed_set = PID_calc(&trigger->angle_pid, trigger->angle, trigger->angle_set);
+  PID_calc(&trigger->speed_pid, trigger->speed, trigger->speed_set);
+  trigger->give_current = (int16_t)(SHOOT_TRIGGER_MOTOR_DIR * trigger->speed_pid.out);
+
+  //摩擦轮 两轮反向
+  shoot_control_cal->fric[0].speed_set = shoot_control_cal->fric_speed_set;
+  shoot_control_cal->fric[1].speed_set = -shoot_control_cal->fric_speed_set;
+  for (i = 0; i < 2; i++)
+  {
+    PID_calc(&shoot_control_cal->fric[i].speed_pid, shoot_control_cal->fric[i].speed, shoot_control_cal->fric[i].speed_set);
+    shoot_control_cal->fric[i].give_current = (int16_t)shoot_control_cal->fric[i].speed_pid.out;
+  }
+}
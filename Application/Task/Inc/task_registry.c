@@ -0,0 +1,253 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       task_registry.c/h
+  * @brief      任务注册表，按TASK_TABLE静态分配每个任务的TCB与栈并创建任务，
+  *             不使用FreeRTOS堆，启动时没有内存分配，也不会产生堆碎片。
+  *             优先级按单调速率分配，周期与截止时间都相同的任务共用一个优先级，
+  *             每次执行的运行周期数与预算比较。
+  * @note       TCB与栈的符号名为task_tcb_<任务名>、task_stack_<任务名>，
+  *             编译后用Tools/task_report.py读取Keil的map文件生成每个任务的RAM占用报告。
+  *             任务间数据通过msg_bus话题传递，话题缓冲区同样静态分配。
+  *             运行周期数在任务切换钩子(含调度器启动时选中第一个任务)中按DWT周期计数累计，
+  *             只计任务自身运行的时间。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.1.0     Oct-19-2026     ICBK            2. 单调速率分配优先级 统计单次执行时间并检查预算
+  *  V1.2.0     Oct-19-2026     ICBK            3. 记录每次执行的开始与结束时间 供软件看门狗检查截止时间
+  *  V1.3.0     Oct-19-2026     ICBK            4. 增加IMU任务 周期与截止时间相同的任务共用优先级
+  *  V1.4.0     Oct-19-2026     ICBK            5. 增加姿态解算任务
+  *  V1.5.0     Oct-19-2026     ICBK            6. 增加云台任务
+  *  V1.6.0     Oct-19-2026     ICBK            7. 增加发射任务
+  *  V1.7.0     Oct-19-2026     ICBK            8. 增加裁判系统任务
+  *
+  @verbatim
+  ==============================================================================
+    新增任务:
+      1. 在任务模块头文件中声明入口函数 void xxx_task(void const *pvParameters);
+      2. 在task_registry.h的TASK_TABLE中增加一行, 并在本文件包含该头文件
+      3. 任务循环中每次执行前后调用task_job_begin/task_job_end
+      4. 运行python Tools/rta.py确认任务集可调度
+    栈长度参考monitor任务记录的栈历史最小剩余(stack_free)调整
+    执行时间预算参考task_timing[].max调整, overrun_count不为0说明预算或分析结果不可信
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+/*------头文件嵌入------*/
+#include "cmsis_os.h"
+
+#include "bsp_dwt.h"
+#include "remote_control.h"
+#include "CAN_receive.h"
+#include "imu_task.h"
+#include "ins_task.h"
+#include "chassis_task.h"
+#include "gimbal_task.h"
+#include "shoot_task.h"
+#include "referee_task.h"
+#include "telemetry_task.h"
+#include "monitor_task.h"
+#include "watchdog_task.h"
+
+#include "task_registry.h"
+
+/*------变量定义------*/
+
+//静态分配TCB与栈
+#define TASK_STORAGE(id, name, entry, stack_words, period_ms, deadline_ms, wcet_us, isr, wdg) \
+  static osStaticThreadDef_t task_tcb_##name;                                                    \
+  static uint32_t task_stack_##name[stack_words];
+TASK_TABLE(TASK_STORAGE)
+#undef TASK_STORAGE
+
+//优先级在创建时填入
+#define TASK_DEF(id, name, entry, stack_words, period_ms, deadline_ms, wcet_us, isr, wdg) \
+  {#name, (os_pthread)(entry), osPriorityNormal, 0, (stack_words), task_stack_##name, &task_tcb_##name},
+static const osThreadDef_t task_def[TASK_NUM] =
+{
+  TASK_TABLE(TASK_DEF)
+};
+#undef TASK_DEF
+
+#define TASK_INFO(id, name, entry, stack_words, period_ms, deadline_ms, wcet_us, isr, wdg) \
+  {#name, (stack_words), (period_ms), (deadline_ms), (wcet_us), (isr), (wdg),                \
+   (uint16_t)(sizeof(task_tcb_##name) + sizeof(task_stack_##name))},
+const task_info_t task_info[TASK_NUM] =
+{
+  TASK_TABLE(TASK_INFO)
+};
+#undef TASK_INFO
+
+static osThreadId task_handle[TASK_NUM];
+static osPriority task_priority[TASK_NUM];
+
+//单次执行时间统计
+task_timing_t task_timing[TASK_NUM];
+static uint32_t task_run_cycle[TASK_NUM];           //累计运行周期数 任务切换时更新
+static uint8_t task_running_id = TASK_NUM;          //正在运行的任务 不在表中为TASK_NUM
+static uint32_t task_switch_cycle = 0;              //上一次任务切换的周期计数
+
+//监视任务统计的任务数由TASK_NUM推算(monitor_task.h), 软件定时器任务未计入
+CONFIG_STATIC_ASSERT(configUSE_TIMERS == 0, monitor_system_task_num_missing_timer_task);
+
+/*------函数定义------*/
+
+//单调速率 a的优先级是否高于b 周期与截止时间都相同时优先级相同
+static bool_t task_rate_monotonic_higher(uint8_t a, uint8_t b)
+{
+  if(task_info[a].period_ms != task_info[b].period_ms)
+  {
+    return task_info[a].period_ms < task_info[b].period_ms;
+  }
+  return task_info[a].deadline_ms < task_info[b].deadline_ms;
+}
+
+//按单调速率排序 从TASK_PRIORITY_HIGHEST依次向下分配 Tools/rta.py按同样规则分析
+static void task_priority_assign(void)
+{
+  uint8_t i;
+  uint8_t j;
+  uint8_t k;
+  uint8_t rank;
+
+  for(i = 0; i < TASK_NUM; i++)
+  {
+    //更高优先级的(周期, 截止时间)组数 每组只计表中第一个任务
+    rank = 0;
+    for(j = 0; j < TASK_NUM; j++)
+    {
+      if(!task_rate_monotonic_higher(j, i))
+      {
+        continue;
+      }
+      for(k = 0; k < j; k++)
+      {
+        if(!task_rate_monotonic_higher(k, j) && !task_rate_monotonic_higher(j, k))
+        {
+          break;
+        }
+      }
+      if(k == j)
+      {
+        rank++;
+      }
+    }
+    //优先级级数不够 Tools/rta.py同样检查
+    configASSERT(rank <= TASK_PRIORITY_HIGHEST - TASK_PRIORITY_LOWEST);
+    task_priority[i] = (osPriority)(TASK_PRIORITY_HIGHEST - rank);
+  }
+}
+
+void task_registry_start(void)
+{
+  osThreadDef_t def;
+  uint8_t i;
+
+  task_priority_assign();
+
+  for(i = 0; i < TASK_NUM; i++)
+  {
+    def = task_def[i];
+    def.tpriority = task_priority[i];
+    task_handle[i] = osThreadCreate(&def, NULL);
+    //静态创建只在参数错误时失败
+    configASSERT(task_handle[i] != NULL);
+  }
+}
+
+osThreadId task_handle_get(task_id_e id)
+{
+  if(id >= TASK_NUM)
+  {
+    return NULL;
+  }
+  return task_handle[id];
+}
+
+osPriority task_priority_get(task_id_e id)
+{
+  if(id >= TASK_NUM)
+  {
+    return osPriorityError;
+  }
+  return task_priority[id];
+}
+
+//在PendSV中调用 调度器临界区内 不能调用RTOS接口
+void task_timing_switch(const void *tcb)
+{
+  uint32_t now = dwt_cycle_get();
+  uint8_t i;
+
+  if(task_running_id < TASK_NUM)
+  {
+    task_run_cycle[task_running_id] += now - task_switch_cycle;
+  }
+  task_switch_cycle = now;
+
+  task_running_id = TASK_NUM;
+  for(i = 0; i < TASK_NUM; i++)
+  {
+    if(task_def[i].controlblock == tcb)
+    {
+      task_running_id = i;
+      break;
+    }
+  }
+}
+
+//累计运行周期数 包括本次切换进来之后的时间 在临界区内调用
+static uint32_t task_run_cycle_get(task_id_e id)
+{
+  uint32_t cycle = task_run_cycle[id];
+
+  if(task_running_id == id)
+  {
+    cycle += dwt_cycle_get() - task_switch_cycle;
+  }
+  return cycle;
+}
+
+void task_job_begin(task_id_e id)
+{
+  if(id >= TASK_NUM)
+  {
+    return;
+  }
+  taskENTER_CRITICAL();
+  task_timing[id].job_start = task_run_cycle_get(id);
+  task_timing[id].begin_ms = osKernelSysTick();
+  task_timing[id].running = 1;
+  taskEXIT_CRITICAL();
+}
+
+void task_job_end(task_id_e id)
+{
+  task_timing_t *timing;
+  uint32_t cycles;
+
+  if(id >= TASK_NUM)
+  {
+    return;
+  }
+  timing = &task_timing[id];
+
+  taskENTER_CRITICAL();
+  cycles = task_run_cycle_get(id) - timing->job_start;
+  timing->end_ms = osKernelSysTick();
+  timing->running = 0;
+  taskEXIT_CRITICAL();
+
+  timing->last = cycles;
+  if(cycles > timing->max)
+  {
+    timing->max = cycles;
+  }
+  timing->job_count++;
+  if(cycles > task_info[id].wcet_us * (SystemCoreClock / 1000000u))
+  {
+    timing->overrun_count++;
+  }
+}
@@ -0,0 +1,335 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       telemetry_task.c/h
+  * @brief      遥测任务，周期采样已注册的变量(设定值、反馈值、PID输出、遥控器通道等)，
+  *             打包为带CRC16校验的COBS帧，通过USART1 DMA非阻塞发送到上位机。
+  * @note       freeRTOS任务
+  *             任务优先级低于控制任务，只读取变量不加锁，单个变量不会撕裂，
+  *             但同一包内的变量可能来自控制任务相邻的两个周期。
+  *             每周期从内存池取一个发送块组包，DMA发送未完成时排队，发送完成后释放；
+  *             全部块都在排队时丢弃本周期的采样并计数，调参请求留到下个周期处理，任何情况下都不等待。
+  *             每周期耗时由执行时间统计测量点telemetry_tick记录。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.1.0     Oct-19-2026     ICBK            2. 处理调参请求并发送应答
+  *  V1.2.0     Oct-19-2026     ICBK            3. 发送缓冲区改为内存池分配的块 DMA忙时排队发送 不再丢弃调参应答
+  *  V1.2.1     Oct-19-2026     ICBK            4. 每周期统计执行时间 与任务表中的预算比较
+  @verbatim
+  ==============================================================================
+    帧格式: COBS(负载 + CRC16) + 0x00
+    负载(小端):
+      采样包  0x01 | seq u16 | time_ms u32 | n u8 | n * (id u8 | value f32)
+      描述包  0x02 | id u8 | type u8 | decimation u8 | name (不含结尾0)
+      监视包  0x03 | monitor_record_t
+      调参应答 0x90~0x94 见tuning.h, 调参请求由本任务从同一串口接收处理
+    上位机解析: Tools/telemetry_decode.py
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+/*------头文件嵌入------*/
+#include <string.h>
+#include "cmsis_os.h"
+#include "main.h"
+
+#include "bsp_usart.h"
+#include "cobs.h"
+#include "crc.h"
+#include "mem_pool.h"
+#include "profile.h"
+#include "monitor_task.h"
+#include "tuning.h"
+#include "task_registry.h"
+
+#include "telemetry_task.h"
+
+/*-------宏定义-------*/
+#define TELEMETRY_PAYLOAD_MAX_LEN 256
+
+//监视记录长度随任务数增加 类型字节与CRC16之后仍要放得下
+CONFIG_STATIC_ASSERT(1 + sizeof(monitor_record_t) + 2 <= TELEMETRY_PAYLOAD_MAX_LEN, monitor_record_too_long_for_telemetry);
+
+/*------变量定义------*/
+extern UART_HandleTypeDef huart1;
+extern DMA_HandleTypeDef hdma_usart1_tx;
+
+//注册表
+typedef struct
+{
+  const char *name;
+  const volatile void *addr;
+  uint8_t type;
+  uint8_t decimation;
+} telemetry_channel_t;
+
+static telemetry_channel_t telemetry_channel[TELEMETRY_MAX_CHANNEL];
+static volatile uint8_t telemetry_channel_num = 0;
+
+static telemetry_status_t telemetry_status;
+
+//负载缓冲区
+static uint8_t telemetry_payload[TELEMETRY_PAYLOAD_MAX_LEN];
+
+//发送缓冲块
+MEM_POOL_DEFINE(telemetry_tx, TELEMETRY_TX_BUF_LEN, TELEMETRY_TX_BLOCK_NUM);
+
+typedef struct
+{
+  uint8_t *buf;
+  uint16_t len;
+} telemetry_tx_block_t;
+
+static telemetry_tx_block_t telemetry_tx;                                   //本周期组包的块
+static telemetry_tx_block_t telemetry_tx_sending;                           //DMA正在发送的块
+static telemetry_tx_block_t telemetry_tx_queue[TELEMETRY_TX_BLOCK_NUM];     //等待发送的块 按组包顺序
+static uint8_t telemetry_tx_queue_head = 0;
+static uint8_t telemetry_tx_queue_num = 0;
+
+PROFILE_SCOPE_DEFINE(telemetry_tick);
+
+/*------函数定义------*/
+
+int16_t telemetry_register(const char *name, const volatile void *addr, telemetry_type_e type, uint8_t decimation)
+{
+  int16_t id = -1;
+
+  if(name == NULL || addr == NULL)
+  {
+    return -1;
+  }
+
+  taskENTER_CRITICAL();
+  if(telemetry_channel_num < TELEMETRY_MAX_CHANNEL)
+  {
+    id = telemetry_channel_num;
+    telemetry_channel[id].name = name;
+    telemetry_channel[id].addr = addr;
+    telemetry_channel[id].type = (uint8_t)type;
+    telemetry_channel[id].decimation = decimation ? decimation : 1;
+    //表项写完后再增加数量 遥测任务只读取已完成的表项
+    telemetry_channel_num = (uint8_t)(id + 1);
+  }
+  taskEXIT_CRITICAL();
+
+  return id;
+}
+
+const telemetry_status_t *get_telemetry_status_point(void)
+{
+  return &telemetry_status;
+}
+
+//读取变量并转换为fp32
+static fp32 telemetry_channel_read(const telemetry_channel_t *channel)
+{
+  switch(channel->type)
+  {
+    case TELEMETRY_FP32:   return *(const volatile fp32 *)channel->addr;
+    case TELEMETRY_INT8:   return (fp32)*(const volatile int8_t *)channel->addr;
+    case TELEMETRY_UINT8:  return (fp32)*(const volatile uint8_t *)channel->addr;
+    case TELEMETRY_INT16:  return (fp32)*(const volatile int16_t *)channel->addr;
+    case TELEMETRY_UINT16: return (fp32)*(const volatile uint16_t *)channel->addr;
+    case TELEMETRY_INT32:  return (fp32)*(const volatile int32_t *)channel->addr;
+    case TELEMETRY_UINT32: return (fp32)*(const volatile uint32_t *)channel->addr;
+    default:               return 0.0f;
+  }
+}
+
+//负载加上CRC16后COBS编码追加到发送缓冲区
+static bool_t telemetry_frame_append(uint16_t payload_len)
+{
+  uint8_t *tx = telemetry_tx.buf;
+
+  if(telemetry_tx.len + COBS_ENCODE_MAX_LEN(payload_len + 2u) + 1u > TELEMETRY_TX_BUF_LEN)
+  {
+    return 0;
+  }
+
+  append_CRC16_check_sum(telemetry_payload, payload_len + 2u);
+  telemetry_tx.len += cobs_encode(telemetry_payload, payload_len + 2u, &tx[telemetry_tx.len]);
+  tx[telemetry_tx.len++] = 0x00;
+  return 1;
+}
+
+//上一块发送完成后释放 开始发送队列中最早的一块
+static void telemetry_tx_service(void)
+{
+  const telemetry_tx_block_t *next;
+
+  if(usart_tx_dma_busy(&hdma_usart1_tx))
+  {
+    return;
+  }
+  mem_pool_free(MEM_POOL(telemetry_tx), telemetry_tx_sending.buf);
+  telemetry_tx_sending.buf = NULL;
+
+  if(telemetry_tx_queue_num == 0)
+  {
+    return;
+  }
+  next = &telemetry_tx_queue[telemetry_tx_queue_head];
+  if(usart_tx_dma_start(&huart1, &hdma_usart1_tx, next->buf, next->len))
+  {
+    telemetry_status.tx_bytes += next->len;
+    telemetry_tx_sending = *next;
+    telemetry_tx_queue_head = (uint8_t)((telemetry_tx_queue_head + 1u) % TELEMETRY_TX_BLOCK_NUM);
+    telemetry_tx_queue_num--;
+  }
+}
+
+//组好的块加入发送队列 块数与队列长度相同 不会溢出
+static void telemetry_tx_submit(void)
+{
+  if(telemetry_tx.len == 0)
+  {
+    mem_pool_free(MEM_POOL(telemetry_tx), telemetry_tx.buf);
+  }
+  else
+  {
+    telemetry_tx_queue[(telemetry_tx_queue_head + telemetry_tx_queue_num) % TELEMETRY_TX_BLOCK_NUM] = telemetry_tx;
+    telemetry_tx_queue_num++;
+  }
+  telemetry_tx.buf = NULL;
+  telemetry_tx.len = 0;
+}
+
+//采样包
+static void telemetry_sample_pack(uint32_t tick, uint32_t now)
+{
+  uint16_t seq = (uint16_t)telemetry_status.packet_count;
+  uint8_t num = telemetry_channel_num;
+  uint16_t len = 8;
+  uint8_t count = 0;
+  uint8_t i;
+
+  telemetry_payload[0] = TELEMETRY_PACKET_SAMPLE;
+  memcpy(&telemetry_payload[1], &seq, 2);
+  memcpy(&telemetry_payload[3], &now, 4);
+
+  for(i = 0; i < num; i++)
+  {
+    const telemetry_channel_t *channel = &telemetry_channel[i];
+    fp32 value;
+
+    if(tick % channel->decimation != 0)
+    {
+      continue;
+    }
+    value = telemetry_channel_read(channel);
+    telemetry_payload[len] = i;
+    memcpy(&telemetry_payload[len + 1], &value, 4);
+    len += 5;
+    count++;
+  }
+
+  if(count == 0)
+  {
+    return;
+  }
+  telemetry_payload[7] = count;
+  if(telemetry_frame_append(len))
+  {
+    telemetry_status.packet_count++;
+  }
+}
+
+//描述包 轮流发送各变量的名称与类型
+static void telemetry_info_pack(uint8_t id)
+{
+  const telemetry_channel_t *channel = &telemetry_channel[id];
+  uint16_t name_len = (uint16_t)strlen(channel->name);
+
+  if(name_len > TELEMETRY_NAME_LEN)
+  {
+    name_len = TELEMETRY_NAME_LEN;
+  }
+  telemetry_payload[0] = TELEMETRY_PACKET_INFO;
+  telemetry_payload[1] = id;
+  telemetry_payload[2] = channel->type;
+  telemetry_payload[3] = channel->decimation;
+  memcpy(&telemetry_payload[4], channel->name, name_len);
+  telemetry_frame_append(4 + name_len);
+}
+
+//调参应答 与采样数据一起发送
+static bool_t telemetry_reply(const uint8_t *payload, uint16_t len)
+{
+  if(len + 2u > TELEMETRY_PAYLOAD_MAX_LEN)
+  {
+    return 0;
+  }
+  memcpy(telemetry_payload, payload, len);
+  return telemetry_frame_append(len);
+}
+
+//监视包 系统监视任务有新记录时发送
+static void telemetry_monitor_pack(void)
+{
+  static uint16_t last_seq = 0;
+  static monitor_record_t record;
+
+  monitor_read(&record);
+  if(record.seq == last_seq)
+  {
+    return;
+  }
+  last_seq = record.seq;
+
+  telemetry_payload[0] = TELEMETRY_PACKET_MONITOR;
+  memcpy(&telemetry_payload[1], &record, sizeof(record));
+  telemetry_frame_append(1 + sizeof(record));
+}
+
+/*------遥测任务------*/
+
+void telemetry_task(void const *pvParameters)
+{
+  uint8_t info_id = 0;
+  uint32_t tick;
+
+  tuning_init();
+
+  while(1)
+  {
+    task_job_begin(TASK_TELEMETRY);
+    PROFILE_BEGIN(telemetry_tick);
+
+    tick = telemetry_status.tick;
+
+    telemetry_tx_service();
+    telemetry_tx.buf = mem_pool_alloc(MEM_POOL(telemetry_tx));
+    if(telemetry_tx.buf == NULL)
+    {
+      //全部块都在排队 丢弃本周期采样 不等待
+      telemetry_status.drop_count++;
+    }
+    else
+    {
+      //组包 调参应答优先
+      telemetry_tx.len = 0;
+      tuning_poll(telemetry_reply);
+      telemetry_sample_pack(tick, osKernelSysTick());
+
+      if(tick % TELEMETRY_INFO_PERIOD == 0 && telemetry_channel_num != 0)
+      {
+        if(info_id >= telemetry_channel_num)
+        {
+          info_id = 0;
+        }
+        telemetry_info_pack(info_id++);
+      }
+      telemetry_monitor_pack();
+
+      telemetry_tx_submit();
+      telemetry_tx_service();
+    }
+    telemetry_status.tick++;
+
+    PROFILE_END(telemetry_tick);
+    task_job_end(TASK_TELEMETRY);
+
+    osDelay(TELEMETRY_PERIOD_MS);
+  }
+}
@@ -0,0 +1,223 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       watchdog_task.c/h
+  * @brief      软件看门狗任务，检查任务表中各周期任务是否在截止时间内执行，
+  *             控制任务超时时逐级处理: 安全状态(底盘、云台CAN控制电流为0) -> 停止喂狗由独立看门狗复位。
+  * @note       freeRTOS任务，单调速率分配下周期最短，优先级最高。
+  *             各任务每次执行前后调用的task_job_begin/task_job_end即为喂狗，
+  *             看门狗按task_timing[]中记录的开始与结束时间判断:
+  *               执行中: 当前时间 > 开始时间 + 截止时间                 记为overrun
+  *               未执行: 当前时间 > 上次结束时间 + 周期 + 截止时间       记为miss(任务未被唤醒或未完成)
+  *             执行周期数超出预算(task_timing[].overrun_count)只说明预算偏小，不触发处理。
+  *             看门狗任务自身停止运行(死循环、关中断、更高优先级的中断占满)时由独立看门狗复位。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    任务表中看门狗一列:
+      TASK_WDG_NONE   不检查, 用于事件触发的任务(遥控器任务由掉线检测处理)
+      TASK_WDG_REPORT 只计数, 结果见watchdog_read
+      TASK_WDG_SAFE   进入安全状态, 冻结黑匣子(原因BLACKBOX_FREEZE_WATCHDOG, info为任务编号);
+                      全部SAFE任务恢复按时执行WATCHDOG_RECOVER_MS后退出安全状态;
+                      同一次超时持续WATCHDOG_RESET_MS后停止喂狗
+    从截止时刻到检测到超时最多一个看门狗周期(加上看门狗任务自身的响应时间, 见Tools/rta.py),
+    之后同一周期内发出电流为0的控制帧
+    任务第一次执行前不检查, 启动时的初始化延时不会触发
+    上位机仿真: make -C Tools/sim bench 运行build/watchdog_sim, 注入超时并检查反应时间
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+/*------头文件嵌入------*/
+#include <string.h>
+#include "cmsis_os.h"
+
+#include "bsp_iwdg.h"
+#include "CAN_receive.h"
+#include "blackbox.h"
+
+#include "watchdog_task.h"
+
+/*------变量定义------*/
+
+static watchdog_status_t watchdog_status;
+
+/*------函数定义------*/
+
+//时间a是否晚于b 计数回绕不影响结果
+static bool_t watchdog_time_after(uint32_t a, uint32_t b)
+{
+  return (int32_t)(a - b) > 0;
+}
+
+static void watchdog_init(void)
+{
+  memset(&watchdog_status, 0, sizeof(watchdog_status));
+  watchdog_status.state = WATCHDOG_OK;
+  watchdog_status.last_late_task = TASK_NUM;
+  CAN_cmd_safe_set(0);
+}
+
+//检查一个任务 返回1表示当前超时
+static bool_t watchdog_task_check(task_id_e id, uint32_t now_ms)
+{
+  watchdog_task_status_t *status = &watchdog_status.task[id];
+  const task_info_t *info = &task_info[id];
+  uint32_t begin_ms;
+  uint32_t end_ms;
+  uint32_t job_count;
+  uint8_t running;
+  uint32_t deadline_at;
+
+  taskENTER_CRITICAL();
+  begin_ms = task_timing[id].begin_ms;
+  end_ms = task_timing[id].end_ms;
+  job_count = task_timing[id].job_count;
+  running = task_timing[id].running;
+  taskEXIT_CRITICAL();
+
+  //第一次执行前不检查
+  if(!running && job_count == 0)
+  {
+    status->late = 0;
+    return 0;
+  }
+
+  if(running)
+  {
+    deadline_at = begin_ms + info->deadline_ms;
+  }
+  else
+  {
+    deadline_at = end_ms + info->period_ms + info->deadline_ms;
+  }
+
+  if(!watchdog_time_after(now_ms, deadline_at))
+  {
+    status->late = 0;
+    return 0;
+  }
+
+  //一次超时只计一次
+  if(!status->late)
+  {
+    status->late = 1;
+    status->late_since_ms = deadline_at;
+    if(running)
+    {
+      status->overrun_count++;
+    }
+    else
+    {
+      status->miss_count++;
+    }
+    if(now_ms - deadline_at > status->reaction_max_ms)
+    {
+      status->reaction_max_ms = (uint16_t)(now_ms - deadline_at);
+    }
+    watchdog_status.last_late_task = (uint8_t)id;
+  }
+  return 1;
+}
+
+watchdog_state_e watchdog_check(uint32_t now_ms)
+{
+  bool_t safe_late = 0;
+  bool_t reset = 0;
+  uint8_t late_id = TASK_NUM;
+  uint8_t i;
+
+  for(i = 0; i < TASK_NUM; i++)
+  {
+    if(task_info[i].wdg == TASK_WDG_NONE)
+    {
+      continue;
+    }
+    if(watchdog_task_check((task_id_e)i, now_ms) && task_info[i].wdg == TASK_WDG_SAFE)
+    {
+      if(!safe_late)
+      {
+        late_id = i;
+      }
+      safe_late = 1;
+      if(now_ms - watchdog_status.task[i].late_since_ms >= WATCHDOG_RESET_MS)
+      {
+        reset = 1;
+      }
+    }
+  }
+
+  //复位前不再恢复
+  if(watchdog_status.state == WATCHDOG_RESET)
+  {
+    return WATCHDOG_RESET;
+  }
+
+  if(safe_late)
+  {
+    if(watchdog_status.state == WATCHDOG_OK)
+    {
+      CAN_cmd_safe_set(1);
+      watchdog_status.safe_count++;
+      watchdog_status.safe_enter_ms = now_ms;
+      blackbox_freeze(BLACKBOX_FREEZE_WATCHDOG, late_id);
+    }
+    watchdog_status.state = reset ? WATCHDOG_RESET : WATCHDOG_SAFE;
+    watchdog_status.healthy_since_ms = now_ms;
+  }
+  else if(watchdog_status.state == WATCHDOG_SAFE &&
+          now_ms - watchdog_status.healthy_since_ms >= WATCHDOG_RECOVER_MS)
+  {
+    CAN_cmd_safe_set(0);
+    watchdog_status.state = WATCHDOG_OK;
+  }
+
+  return (watchdog_state_e)watchdog_status.state;
+}
+
+void watchdog_read(watchdog_status_t *status_out)
+{
+  if(status_out == NULL)
+  {
+    return;
+  }
+  taskENTER_CRITICAL();
+  *status_out = watchdog_status;
+  taskEXIT_CRITICAL();
+}
+
+/*------看门狗任务------*/
+
+void watchdog_task(void const *pvParameters)
+{
+  watchdog_state_e state;
+
+  watchdog_init();
+  iwdg_init(WATCHDOG_IWDG_TIMEOUT_MS);
+  watchdog_status.reset_by_iwdg = iwdg_caused_reset();
+
+  while(1)
+  {
+    osDelay(WATCHDOG_PERIOD_MS);
+    task_job_begin(TASK_WATCHDOG);
+
+    state = watchdog_check(osKernelSysTick());
+
+    //安全状态下控制任务可能不再发送 由看门狗持续发送电流为0的控制帧 电调超时前不会保持旧指令
+    if(state != WATCHDOG_OK)
+    {
+      CAN_cmd_chassis(0, 0, 0, 0);
+      CAN_cmd_gimbal(0, 0, 0, 0);
+      CAN_cmd_friction(0, 0);
+    }
+    if(state != WATCHDOG_RESET)
+    {
+      iwdg_feed();
+    }
+
+    task_job_end(TASK_WATCHDOG);
+  }
+}
@@ -5,12 +5,22 @@
 #include "struct_typedef.h"
 #include "config_freame.h"
 #include "remote_control.h"
+#include "pc_control.h"
+#include "param.h"
 #include "pid.h"
+#include "CAN_receive.h"
+#include "msg_bus.h"
 
 
+/*底盘任务控制周期*/
+#define CHASSIS_CONTROL_TIME_MS 2  //控制周期 ms 遥控器失控标志在一个周期内生效
+
 /*遥控器死区大小设置*/
-#define CHASSIS_RC_DEADZONE 10  //死区RC通道值
-#define RC_TO_SPEED_RATIO 1000 //RC通道值转化速度比 = 最大速度/最大通道值
+#define CHASSIS_RC_DEADZONE CONFIG_CHASSIS_RC_DEADZONE  //死区RC通道值 参数默认值
+#define RC_TO_SPEED_RATIO CONFIG_RC_TO_SPEED_RATIO //RC通道值转化速度比 = 最大速度/最大通道值 参数默认值
+
+/*黑匣子记录*/
+#define CHASSIS_BLACKBOX_DECIMATION CONFIG_BLACKBOX_CHASSIS_DECIMATION //每隔多少个控制周期记录一次
 
 //底盘3508最大can发送电流值
 #define MOTOR_M3508_CAN_MAX_CURRENT CONFIG_MOTOR_M3508_CAN_MAX_CURRENT
@@ -20,11 +30,19 @@
 #define CHASSIS_Y_CHANNEL 0
 #define CHASSIS_W_CHANNEL 4
 
-/*底盘机械物理参数*/
-#define WHEEL_PERIMETER CONFIG_WHEEL_PERIMETER  //轮子周长
-#define CHASSIS_DECELE_RATIO CONFIG_CHASSIS_DECELE_RATIO //电机减速比
-#define CHASSIS_LENGTH CONFIG_CHASSIS_LENGTH //底盘长度
-#define CHASSIS_WIDTH CONFIG_CHASSIS_WIDTH  //底盘宽度
+/*底盘机械物理参数 单位换算全部为常量表达式 编译期折叠*/
+#define WHEEL_DIAMETER_M (CONFIG_WHEEL_DIAMETER_MM * 0.001f)  //轮子直径 m
+#define CHASSIS_DECELE_RATIO ((fp32)CONFIG_CHASSIS_DECELE_RATIO_NUM / (fp32)CONFIG_CHASSIS_DECELE_RATIO_DEN) //电机减速比
+#define CHASSIS_LEVER_ARM_M ((CONFIG_CHASSIS_LENGTH_MM + CONFIG_CHASSIS_WIDTH_MM) * 0.0005f) //旋转力臂 = 长/2 + 宽/2 m
+//车轮线速度(m/s) -> 电机转子转速(rpm) = 60/(pi*直径) * 减速比
+#define CHASSIS_MPS_TO_MOTOR_RPM (60.0f / (3.14159265f * WHEEL_DIAMETER_M) * CHASSIS_DECELE_RATIO)
+//轮速 = (±vx ±vy - w*力臂) * 系数
+#if CONFIG_CHASSIS_MECANUM
+#define CHASSIS_WHEEL_SPEED_SCALE 1.0f         //麦轮 辊子与轮轴成45度
+#else
+#define CHASSIS_WHEEL_SPEED_SCALE 0.70710678f  //全向轮 轮子方向与车体成45度
+#endif
+#define CHASSIS_SPIN_SPEED (CONFIG_CHASSIS_SPIN_SPEED_DPS * 0.01745329f) //小陀螺转速 rad/s
 
 /*底盘M3508电机速度环PID参数*/
 #define CHASSIS_MOTOR_SPEED_PID_KP CONFIG_CHASSIS_MOTOR_SPEED_PID_KP
@@ -56,8 +74,15 @@ typedef struct
 /*--------底盘运动数据结构--------*/
 typedef struct
 {
-  const RC_ctrl_t *chassis_RC;  //底盘使用的遥控器指针
+  const RC_ctrl_t *chassis_RC;  //底盘使用的遥控器指针 指向本周期的遥控器数据拷贝
+  RC_ctrl_t chassis_rc_data;  //每个控制周期开始时读取的完整一帧遥控器数据
+  pc_control_t chassis_pc;  //键鼠输入状态
+  const pc_command_t *chassis_pc_cmd; //键鼠控制指令
+  param_value_t chassis_param[PARAM_NUM]; //参数表拷贝 控制周期开始时更新 按param_id_e读取
+  uint32_t chassis_param_version; //参数表拷贝的版本号
   chassis_mode_e chassis_behaviour_mode;  //底盘运动行为模式
+  msg_bus_sub_t chassis_motor_sub; //底盘电机反馈订阅
+  chassis_motor_msg_t chassis_motor_msg; //本周期读取的一组电机反馈
   chassis_motor_t chassis_motor[4]; //底盘电机数据
   pid_type_def motor_speed_pid[4];  //底盘电机速度环pid
 
@@ -65,6 +90,9 @@ typedef struct
   fp32 vy_set;
   fp32 vw_set;
 
+  uint16_t blackbox_count;  //黑匣子抽取计数
+  chassis_mode_e blackbox_mode; //黑匣子上次记录的模式
+
 } chassis_move_t;
 
 extern void chassis_task(void const *pvParameters);
@@ -0,0 +1,137 @@
+#ifndef GIMBAL_TASK_H
+
+#define GIMBAL_TASK_H
+
+#include "struct_typedef.h"
+#include "config_freame.h"
+#include "remote_control.h"
+#include "pc_control.h"
+#include "param.h"
+#include "pid.h"
+#include "CAN_receive.h"
+#include "msg_bus.h"
+#include "ins_task.h"
+
+
+/*云台任务控制周期 与底盘任务同一优先级*/
+#define GIMBAL_CONTROL_TIME_MS 2                                //控制周期 ms
+#define GIMBAL_CONTROL_DT (GIMBAL_CONTROL_TIME_MS * 0.001f)     //控制周期 s
+
+/*遥控器通道值*/
+#define GIMBAL_YAW_CHANNEL 2
+#define GIMBAL_PITCH_CHANNEL 3
+#define GIMBAL_MODE_CHANNEL 0   //与底盘共用模式开关 下档无力
+#define GIMBAL_RC_DEADZONE CONFIG_GIMBAL_RC_DEADZONE  //死区RC通道值 参数默认值
+#define GIMBAL_RC_TO_RATE CONFIG_GIMBAL_RC_TO_RATE_RATIO  //RC通道值转化角速度比 rad/s 参数默认值
+
+/*姿态数据超过该时间没有更新 视为姿态解算停止 切换为编码器相对角度控制*/
+#define GIMBAL_INS_TIMEOUT_MS 20
+
+/*6020编码器与安装参数*/
+#define GIMBAL_ECD_RANGE 8192
+#define GIMBAL_ECD_TO_RAD (6.28318531f / GIMBAL_ECD_RANGE)
+#define GIMBAL_RPM_TO_RADPS 0.10471976f                         //转速 rpm -> rad/s
+#define GIMBAL_YAW_OFFSET_ECD CONFIG_GIMBAL_YAW_OFFSET_ECD      //云台朝向车体正前方时的编码值
+#define GIMBAL_PITCH_OFFSET_ECD CONFIG_GIMBAL_PITCH_OFFSET_ECD  //俯仰水平时的编码值
+#define GIMBAL_YAW_MOTOR_DIR CONFIG_GIMBAL_YAW_MOTOR_DIR        //电机正转时姿态角增大为1 减小为-1
+#define GIMBAL_PITCH_MOTOR_DIR CONFIG_GIMBAL_PITCH_MOTOR_DIR
+
+/*软限位 相对车体的角度 rad*/
+#define GIMBAL_YAW_LIMIT CONFIG_GIMBAL_YAW_LIMIT                //0:偏航无限位(导电滑环)
+#define GIMBAL_YAW_MIN_ANGLE (CONFIG_GIMBAL_YAW_MIN_DEG * 0.01745329f)
+#define GIMBAL_YAW_MAX_ANGLE (CONFIG_GIMBAL_YAW_MAX_DEG * 0.01745329f)
+#define GIMBAL_PITCH_MIN_ANGLE (CONFIG_GIMBAL_PITCH_MIN_DEG * 0.01745329f)
+#define GIMBAL_PITCH_MAX_ANGLE (CONFIG_GIMBAL_PITCH_MAX_DEG * 0.01745329f)
+
+//云台6020最大can发送电压值
+#define MOTOR_GM6020_CAN_MAX_VOLTAGE CONFIG_MOTOR_GM6020_CAN_MAX_VOLTAGE
+
+/*角度环PID参数 输入rad 输出角速度rad/s*/
+#define GIMBAL_YAW_ANGLE_PID_KP CONFIG_GIMBAL_YAW_ANGLE_PID_KP
+#define GIMBAL_YAW_ANGLE_PID_KI CONFIG_GIMBAL_YAW_ANGLE_PID_KI
+#define GIMBAL_YAW_ANGLE_PID_KD CONFIG_GIMBAL_YAW_ANGLE_PID_KD
+#define GIMBAL_PITCH_ANGLE_PID_KP CONFIG_GIMBAL_PITCH_ANGLE_PID_KP
+#define GIMBAL_PITCH_ANGLE_PID_KI CONFIG_GIMBAL_PITCH_ANGLE_PID_KI
+#define GIMBAL_PITCH_ANGLE_PID_KD CONFIG_GIMBAL_PITCH_ANGLE_PID_KD
+#define GIMBAL_ANGLE_PID_MAX_OUT (CONFIG_GIMBAL_MAX_RATE_DPS * 0.01745329f)    //最大角速度
+#define GIMBAL_ANGLE_PID_MAX_IOUT (GIMBAL_ANGLE_PID_MAX_OUT * 0.2f)
+
+/*速度环PID参数 输入rad/s 输出6020电压值*/
+#define GIMBAL_YAW_SPEED_PID_KP CONFIG_GIMBAL_YAW_SPEED_PID_KP
+#define GIMBAL_YAW_SPEED_PID_KI CONFIG_GIMBAL_YAW_SPEED_PID_KI
+#define GIMBAL_PITCH_SPEED_PID_KP CONFIG_GIMBAL_PITCH_SPEED_PID_KP
+#define GIMBAL_PITCH_SPEED_PID_KI CONFIG_GIMBAL_PITCH_SPEED_PID_KI
+#define GIMBAL_SPEED_PID_MAX_OUT MOTOR_GM6020_CAN_MAX_VOLTAGE
+#define GIMBAL_SPEED_PID_MAX_IOUT CONFIG_GIMBAL_SPEED_PID_MAX_IOUT
+
+/*--------云台行为模式--------*/
+typedef enum
+{
+  GIMBAL_ZERO_FORCE,  //无力 电压为0
+  GIMBAL_ABSOLUTE,    //姿态角控制 角度与角速度反馈来自ins话题 车体转动时云台指向不变
+  GIMBAL_RELATIVE,    //编码器相对角度控制 角度与角速度反馈来自6020 姿态解算停止时使用
+
+}gimbal_mode_e;
+
+/*--------云台电机数据结构--------*/
+typedef struct
+{
+  const motor_measure_t *gimbal_motor_measure; //接收的电机数据
+  uint16_t offset_ecd;      //中位编码值
+  int8_t motor_dir;         //电机正转对应的姿态角方向
+  fp32 min_relative_angle;  //软限位 rad
+  fp32 max_relative_angle;
+
+  fp32 relative_angle;      //编码器相对中位的角度 rad [-pi,pi) 方向与姿态角一致
+  fp32 relative_speed;      //电机转速 rad/s
+  fp32 absolute_angle;      //姿态角 rad
+  fp32 absolute_speed;      //姿态角速度 rad/s
+
+  fp32 angle_set;           //角度目标 姿态角或相对角度 随模式
+  fp32 angle_fdb;           //角度反馈 随模式
+  fp32 speed_set;           //角度环输出 角速度目标 rad/s
+  fp32 speed_fdb;           //角速度反馈 随模式
+
+  pid_type_def angle_pid;   //角度环
+  pid_type_def speed_pid;   //速度环
+  int16_t give_current;     //给定6020电压值
+} gimbal_motor_t;
+
+/*--------云台控制数据结构--------*/
+typedef struct
+{
+  const RC_ctrl_t *gimbal_RC;  //云台使用的遥控器指针 指向本周期的遥控器数据拷贝
+  RC_ctrl_t gimbal_rc_data;  //每个控制周期开始时读取的完整一帧遥控器数据
+  pc_control_t gimbal_pc;  //键鼠输入状态
+  const pc_command_t *gimbal_pc_cmd; //键鼠控制指令
+  param_value_t gimbal_param[PARAM_NUM]; //参数表拷贝 控制周期开始时更新
+  uint32_t gimbal_param_version; //参数表拷贝的版本号
+
+  gimbal_mode_e gimbal_behaviour_mode;  //云台行为模式
+  gimbal_mode_e last_behaviour_mode;  //上一周期的模式 切换时目标角度取当前反馈
+
+  msg_bus_sub_t gimbal_ins_sub; //姿态订阅
+  ins_msg_t gimbal_ins_msg; //最近一次读取的姿态
+  uint16_t ins_age_ms; //距最近一次姿态更新的时间 ms
+  bool_t ins_online; //姿态数据在GIMBAL_INS_TIMEOUT_MS内有更新
+
+  gimbal_motor_t gimbal_yaw_motor;
+  gimbal_motor_t gimbal_pitch_motor;
+
+} gimbal_control_t;
+
+/**
+  * @brief          云台任务, 间隔GIMBAL_CONTROL_TIME_MS, 偏航与俯仰角度环、速度环串级控制6020
+  * @param[in]      pvParameters: 空
+  * @retval         none
+  */
+extern void gimbal_task(void const *pvParameters);
+
+/**
+  * @brief          偏航相对车体的角度, 底盘跟随云台时使用
+  * @param[in]      none
+  * @retval         相对角度 rad [-pi,pi)
+  */
+extern fp32 get_gimbal_yaw_relative_angle(void);
+
+#endif
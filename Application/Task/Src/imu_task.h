@@ -0,0 +1,72 @@
+#ifndef IMU_TASK_H
+
+#define IMU_TASK_H
+
+#include "struct_typedef.h"
+#include "config_freame.h"
+#include "msg_bus.h"
+#include "bmi088.h"
+
+/*IMU参数*/
+#define IMU_GYRO_RANGE_DPS CONFIG_IMU_GYRO_RANGE_DPS            //陀螺仪量程
+#define IMU_ACCEL_RANGE_G CONFIG_IMU_ACCEL_RANGE_G              //加速度计量程
+#define IMU_FIFO_BATCH CONFIG_IMU_FIFO_BATCH                    //每次水位中断读出的陀螺仪帧数
+#define IMU_BATCH_PERIOD_MS (IMU_FIFO_BATCH * 1000u / BMI088_GYRO_ODR_HZ) //水位中断间隔
+#define IMU_DEADLINE_MS 1                                       //截止时间 早于同周期的控制任务
+#define IMU_TEMP_PERIOD_MS 1000                                 //温度读取周期 传感器约1.28s更新
+#define IMU_INIT_RETRY_MS 1000                                  //初始化失败后重试间隔
+
+/*imu话题 每个陀螺仪样本发布一次, 需要全部样本的订阅者使用队列订阅*/
+typedef struct
+{
+  uint32_t time_us;       //陀螺仪采样时间 bsp_imu_time_us时基
+  fp32 gyro[3];           //rad/s 传感器坐标系
+  fp32 accel[3];          //m/s^2 采样时间不晚于陀螺仪的最近一个加速度计样本
+  uint32_t accel_time_us; //加速度计采样时间
+  fp32 temp;              //℃
+} imu_msg_t;
+
+MSG_BUS_TOPIC_DECLARE(imu);
+
+/*IMU任务状态*/
+typedef struct
+{
+  bmi088_error_e init_error;  //最近一次初始化结果
+  uint32_t init_count;        //初始化次数
+  uint32_t batch_count;       //读取批数
+  uint32_t int_timeout_count; //等待水位中断超时 按轮询读取的次数
+  uint32_t dma_error_count;   //DMA传输错误或超时次数
+  uint32_t dma_abort_count;   //DMA超时后中止传输的次数
+  uint32_t publish_count;     //发布的样本数
+} imu_status_t;
+
+/**
+  * @brief          注册温度补偿回调, 在调度器启动前调用
+  * @param[in]      comp: 回调, 在IMU任务中对每个样本调用
+  * @param[in]      user: 用户数据
+  * @retval         none
+  */
+extern void imu_temp_comp_set(bmi088_temp_comp_t comp, void *user);
+
+/**
+  * @brief          IMU任务状态
+  * @param[in]      none
+  * @retval         状态指针
+  */
+extern const imu_status_t *get_imu_status_point(void);
+
+/**
+  * @brief          驱动状态(采样时钟、FIFO统计)
+  * @param[in]      none
+  * @retval         驱动状态指针
+  */
+extern const bmi088_t *get_imu_bmi088_point(void);
+
+/**
+  * @brief          IMU任务, 陀螺仪FIFO水位中断唤醒, DMA读出两个传感器的FIFO并发布imu话题
+  * @param[in]      pvParameters: 空
+  * @retval         none
+  */
+extern void imu_task(void const *pvParameters);
+
+#endif
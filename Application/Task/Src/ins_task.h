@@ -0,0 +1,55 @@
+#ifndef INS_TASK_H
+
+#define INS_TASK_H
+
+#include "struct_typedef.h"
+#include "config_freame.h"
+#include "msg_bus.h"
+#include "ahrs.h"
+
+/*姿态解算参数*/
+#define INS_UPDATE_HZ CONFIG_INS_UPDATE_HZ                      //解算频率 陀螺仪样本按此频率取平均
+#define INS_DT (1.0f / INS_UPDATE_HZ)                           //解算周期 s
+#define INS_AHRS_MAHONY 0
+#define INS_AHRS_EKF 1
+#define INS_AHRS CONFIG_INS_AHRS                                //使用的算法
+#define INS_ALIGN_MS CONFIG_INS_ALIGN_MS                        //上电静止对准时间 加速度计取平均
+#define INS_QUEUE_DEPTH 16                                      //imu话题队列深度 约8ms的样本
+#define INS_DEADLINE_MS 1                                       //与IMU任务同一优先级 IMU发布后立即解算
+
+/*ins话题 每次解算发布一次*/
+typedef struct
+{
+  uint32_t time_us;       //本次解算最后一个陀螺仪样本的采样时间
+  fp32 q[4];              //姿态四元数 w x y z 机体系到导航系
+  fp32 euler[3];          //偏航、俯仰、横滚 rad 下标AHRS_YAW/AHRS_PITCH/AHRS_ROLL
+  fp32 gyro[3];           //扣除零偏估计后的角速度 rad/s
+} ins_msg_t;
+
+MSG_BUS_TOPIC_DECLARE(ins);
+
+/*姿态解算状态*/
+typedef struct
+{
+  bool_t aligned;             //静止对准完成
+  uint32_t update_count;      //解算次数
+  uint32_t accel_update_count;//带加速度计修正的解算次数
+  uint32_t lost_count;        //imu话题队列溢出丢失的样本数
+  uint32_t gap_count;         //相邻陀螺仪样本间隔超过1.5个采样周期的次数
+} ins_status_t;
+
+/**
+  * @brief          姿态解算状态
+  * @param[in]      none
+  * @retval         状态指针
+  */
+extern const ins_status_t *get_ins_status_point(void);
+
+/**
+  * @brief          姿态解算任务, imu话题发布时唤醒, 按固定周期更新姿态并发布ins话题
+  * @param[in]      pvParameters: 空
+  * @retval         none
+  */
+extern void ins_task(void const *pvParameters);
+
+#endif
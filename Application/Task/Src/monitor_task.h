@@ -0,0 +1,57 @@
+#ifndef MONITOR_TASK_H
+
+#define MONITOR_TASK_H
+
+#include "struct_typedef.h"
+#include "config_freame.h"
+#include "task_registry.h"
+
+/*系统监视任务周期*/
+#define MONITOR_PERIOD_MS CONFIG_MONITOR_PERIOD_MS
+
+#define MONITOR_RECORD_VERSION 1  //记录格式版本 上位机解析用
+#define MONITOR_SYSTEM_TASK_NUM 2 //任务表之外的任务: 空闲任务与CubeMX默认任务(未使能软件定时器)
+#define MONITOR_SPARE_TASK_NUM 2  //余量 调试时临时创建的任务
+//最多统计的任务数 实际任务数超过时uxTaskGetSystemState返回0, 整条记录为空
+#define MONITOR_MAX_TASK_NUM (TASK_NUM + MONITOR_SYSTEM_TASK_NUM + MONITOR_SPARE_TASK_NUM)
+#define MONITOR_TASK_NAME_LEN 8   //记录中保存的任务名长度 超出截断
+
+/*--------单个任务统计 14字节--------*/
+typedef __packed struct
+{
+  char name[MONITOR_TASK_NAME_LEN]; //任务名 不足补0
+  uint8_t priority;                 //当前优先级
+  uint8_t state;                    //eTaskState
+  uint16_t cpu_permille;            //本周期CPU占用 0.1%
+  uint16_t stack_free;              //栈历史最小剩余 字(4字节)
+} monitor_task_record_t;
+
+/*--------系统统计记录--------*/
+typedef __packed struct
+{
+  uint8_t version;            //MONITOR_RECORD_VERSION
+  uint8_t task_num;           //有效任务数
+  uint16_t seq;               //记录序号
+  uint32_t uptime_ms;         //上电时间
+  uint32_t heap_free;         //heap_4当前剩余 字节
+  uint32_t heap_min_free;     //heap_4历史最小剩余 字节
+  uint16_t isr_permille;      //本周期已统计中断的CPU占用 0.1%
+  uint16_t period_ms;         //实际统计周期
+  monitor_task_record_t task[MONITOR_MAX_TASK_NUM];
+} monitor_record_t;
+
+/**
+  * @brief          读取最近一次系统统计记录
+  * @param[out]     record_out: 记录拷贝
+  * @retval         none
+  */
+extern void monitor_read(monitor_record_t *record_out);
+
+/**
+  * @brief          系统监视任务, 周期统计各任务CPU占用、栈剩余、堆剩余与中断占用
+  * @param[in]      pvParameters: 空
+  * @retval         none
+  */
+extern void monitor_task(void const *pvParameters);
+
+#endif
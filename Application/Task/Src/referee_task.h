@@ -0,0 +1,46 @@
+#ifndef REFEREE_TASK_H
+
+#define REFEREE_TASK_H
+
+#include "struct_typedef.h"
+#include "config_freame.h"
+#include "msg_bus.h"
+#include "referee.h"
+
+
+/*裁判系统任务周期 与控制任务同一优先级 115200波特率下每周期约23字节*/
+#define REFEREE_PERIOD_MS 2
+#define REFEREE_RX_BUF_LEN CONFIG_REFEREE_RX_BUF_LEN    //串口接收环形缓冲区 2的幂
+#define REFEREE_LOST_MS CONFIG_REFEREE_LOST_MS          //超过该时间没有新数据视为裁判系统离线
+
+/*发布referee话题的命令 其余命令只更新解析器中的数据*/
+#define REFEREE_MSG_UPDATE (REFEREE_UPDATE(REFEREE_CMD_ROBOT_STATUS) | REFEREE_UPDATE(REFEREE_CMD_POWER_HEAT) | \
+                            REFEREE_UPDATE(REFEREE_CMD_GAME_ROBOT_HP))
+
+/*referee话题 收到机器人状态、功率热量或血量数据的周期发布一次 各项为最近一次收到的数据*/
+typedef struct
+{
+  uint32_t time_ms;                       //发布时的系统时间
+  uint32_t valid_flag;                    //上电后已收到过的命令 REFEREE_UPDATE(cmd) 未收到的项为0
+  referee_robot_status_t robot_status;    //热量上限、冷却值、底盘功率上限
+  referee_power_heat_t power_heat;        //底盘功率、缓冲能量、枪口热量
+  referee_game_robot_HP_t game_robot_HP;
+} referee_msg_t;
+
+MSG_BUS_TOPIC_DECLARE(referee);
+
+/**
+  * @brief          裁判系统解析器, 包含全部命令的最近数据与接收错误统计
+  * @param[in]      none
+  * @retval         解析器指针
+  */
+extern const referee_t *get_referee_point(void);
+
+/**
+  * @brief          裁判系统任务, 间隔REFEREE_PERIOD_MS, 在串口DMA环形缓冲区上解析裁判系统数据并发布referee话题
+  * @param[in]      pvParameters: 空
+  * @retval         none
+  */
+extern void referee_task(void const *pvParameters);
+
+#endif
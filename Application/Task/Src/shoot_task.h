@@ -0,0 +1,162 @@
+#ifndef SHOOT_TASK_H
+
+#define SHOOT_TASK_H
+
+#include "struct_typedef.h"
+#include "config_freame.h"
+#include "remote_control.h"
+#include "pc_control.h"
+#include "param.h"
+#include "pid.h"
+#include "CAN_receive.h"
+#include "msg_bus.h"
+#include "referee_task.h"
+
+
+/*发射任务控制周期 与云台任务同一优先级 拨弹电流由云台任务在0x1FF帧中一起发送*/
+#define SHOOT_CONTROL_TIME_MS 2                                 //控制周期 ms
+#define SHOOT_CONTROL_DT (SHOOT_CONTROL_TIME_MS * 0.001f)       //控制周期 s
+
+/*遥控器开关 下档停止 中档摩擦轮启动 上档开火*/
+#define SHOOT_MODE_CHANNEL 1
+
+/*拨弹盘 角度与角速度均为拨弹盘(输出轴) 向供弹方向为正*/
+#define SHOOT_TRIGGER_ECD_RANGE 8192
+#define SHOOT_TRIGGER_GEAR_RATIO CONFIG_SHOOT_TRIGGER_GEAR_RATIO
+#define SHOOT_TRIGGER_MOTOR_DIR CONFIG_SHOOT_TRIGGER_MOTOR_DIR
+#define SHOOT_TRIGGER_ECD_TO_RAD (6.28318531f / (SHOOT_TRIGGER_ECD_RANGE * SHOOT_TRIGGER_GEAR_RATIO))
+#define SHOOT_TRIGGER_RPM_TO_RADPS (0.10471976f / SHOOT_TRIGGER_GEAR_RATIO)    //转子转速rpm -> 拨弹盘rad/s
+#define SHOOT_TRIGGER_SLOTS CONFIG_SHOOT_TRIGGER_SLOTS
+#define SHOOT_TRIGGER_STEP (6.28318531f / SHOOT_TRIGGER_SLOTS)                   //一发弹丸对应的拨弹盘角度 rad
+
+/*射击*/
+#define SHOOT_PENDING_MAX 10        //待发射弹丸数上限 按键堆积不超过该值
+#define SHOOT_HEAT_PER_SHOT CONFIG_SHOOT_HEAT_PER_SHOT
+#define SHOOT_REFEREE_TIMEOUT_MS REFEREE_LOST_MS  //裁判系统数据超时后使用参数中的热量上限与冷却值
+
+/*卡弹检测与反转*/
+#define SHOOT_JAM_ERROR (CONFIG_SHOOT_JAM_ERROR_DEG * 0.01745329f)
+#define SHOOT_JAM_SPEED (CONFIG_SHOOT_JAM_SPEED_DPS * 0.01745329f)
+#define SHOOT_JAM_CURRENT CONFIG_SHOOT_JAM_CURRENT
+#define SHOOT_JAM_TIME_MS CONFIG_SHOOT_JAM_TIME_MS
+#define SHOOT_REVERSE_ANGLE (CONFIG_SHOOT_REVERSE_DEG * 0.01745329f)
+#define SHOOT_REVERSE_TIME_MS CONFIG_SHOOT_REVERSE_TIME_MS
+
+//拨弹2006最大can发送电流值
+#define MOTOR_M2006_CAN_MAX_CURRENT CONFIG_MOTOR_M2006_CAN_MAX_CURRENT
+
+/*拨弹角度环PID参数 输入rad 输出rad/s*/
+#define SHOOT_TRIGGER_ANGLE_PID_KP CONFIG_SHOOT_TRIGGER_ANGLE_PID_KP
+#define SHOOT_TRIGGER_ANGLE_PID_MAX_OUT (CONFIG_SHOOT_TRIGGER_MAX_RATE_DPS * 0.01745329f)
+#define SHOOT_TRIGGER_ANGLE_PID_MAX_IOUT 0.0f
+
+/*拨弹速度环PID参数 输入rad/s 输出2006电流值*/
+#define SHOOT_TRIGGER_SPEED_PID_KP CONFIG_SHOOT_TRIGGER_SPEED_PID_KP
+#define SHOOT_TRIGGER_SPEED_PID_KI CONFIG_SHOOT_TRIGGER_SPEED_PID_KI
+#define SHOOT_TRIGGER_SPEED_PID_MAX_OUT MOTOR_M2006_CAN_MAX_CURRENT
+#define SHOOT_TRIGGER_SPEED_PID_MAX_IOUT CONFIG_SHOOT_TRIGGER_SPEED_PID_MAX_IOUT
+
+/*摩擦轮 0x201正转 0x202反转*/
+#define SHOOT_FRIC_RAMP (CONFIG_SHOOT_FRIC_RAMP_RPM_S * SHOOT_CONTROL_DT)     //每周期转速目标变化 rpm
+#define SHOOT_FRIC_READY_RPM CONFIG_SHOOT_FRIC_READY_RPM
+#define SHOOT_FRIC_SPEED_PID_KP CONFIG_SHOOT_FRIC_SPEED_PID_KP
+#define SHOOT_FRIC_SPEED_PID_KI CONFIG_SHOOT_FRIC_SPEED_PID_KI
+#define SHOOT_FRIC_SPEED_PID_MAX_OUT CONFIG_MOTOR_M3508_CAN_MAX_CURRENT
+#define SHOOT_FRIC_SPEED_PID_MAX_IOUT CONFIG_SHOOT_FRIC_SPEED_PID_MAX_IOUT
+
+/*--------发射机构行为模式--------*/
+typedef enum
+{
+  SHOOT_ZERO_FORCE,   //无力 摩擦轮与拨弹电流为0
+  SHOOT_FRIC_UP,      //摩擦轮加速 拨弹盘保持位置 不发射
+  SHOOT_READY,        //摩擦轮到达转速 允许发射
+
+}shoot_mode_e;
+
+/*--------射击模式 参数PARAM_SHOOT_FIRE_MODE--------*/
+typedef enum
+{
+  SHOOT_FIRE_SINGLE = 0,  //每次按下发射一发
+  SHOOT_FIRE_BURST,       //每次按下发射PARAM_SHOOT_BURST_NUM发
+  SHOOT_FIRE_AUTO,        //按住期间按射频连续发射
+
+}shoot_fire_mode_e;
+
+/*--------拨弹电机数据结构--------*/
+typedef struct
+{
+  const motor_measure_t *trigger_motor_measure; //接收的电机数据
+  uint16_t last_ecd;        //上一控制周期的编码值 计算多圈角度
+  fp32 angle;               //拨弹盘累计角度 rad 超过一圈时与目标一起减去一圈
+  fp32 speed;               //拨弹盘角速度 rad/s
+  fp32 angle_set;           //角度目标 每发增加SHOOT_TRIGGER_STEP
+  fp32 speed_set;           //角度环输出 rad/s
+
+  pid_type_def angle_pid;   //角度环
+  pid_type_def speed_pid;   //速度环
+  int16_t give_current;     //给定2006电流值
+} shoot_trigger_t;
+
+/*--------摩擦轮电机数据结构--------*/
+typedef struct
+{
+  const motor_measure_t *fric_motor_measure;
+  fp32 speed;               //转子转速 rpm
+  fp32 speed_set;           //转子转速目标 rpm
+  pid_type_def speed_pid;
+  int16_t give_current;     //给定3508电流值
+} shoot_fric_t;
+
+/*--------发射控制数据结构--------*/
+typedef struct
+{
+  const RC_ctrl_t *shoot_RC;  //发射使用的遥控器指针 指向本周期的遥控器数据拷贝
+  RC_ctrl_t shoot_rc_data;  //每个控制周期开始时读取的完整一帧遥控器数据
+  pc_control_t shoot_pc;  //键鼠输入状态
+  const pc_command_t *shoot_pc_cmd; //键鼠控制指令
+  param_value_t shoot_param[PARAM_NUM]; //参数表拷贝 控制周期开始时更新
+  uint32_t shoot_param_version; //参数表拷贝的版本号
+
+  shoot_mode_e shoot_mode;  //发射机构行为模式
+  shoot_mode_e last_shoot_mode;  //上一周期的模式
+  bool_t fire_input;  //本周期开火输入 遥控器上档或鼠标左键
+  bool_t last_fire_input;
+
+  uint16_t shoot_pending;  //待发射弹丸数
+  uint16_t fire_wait_ms;  //距允许下一发的时间 按射频
+  fp32 heat;  //枪口热量估计 每发增加 按冷却值下降 不低于裁判系统的枪口热量
+  int32_t heat_limit;  //本周期使用的热量上限 裁判系统在线时来自机器人状态 否则为参数
+  int32_t cooling_rate;  //本周期使用的每秒冷却值
+
+  msg_bus_sub_t shoot_referee_sub; //裁判系统订阅
+  referee_msg_t shoot_referee_msg; //最近一次读取的裁判系统数据
+  uint16_t referee_age_ms; //距最近一次裁判系统数据更新的时间 ms
+  bool_t referee_online; //裁判系统数据在SHOOT_REFEREE_TIMEOUT_MS内有更新 且收到过机器人状态
+  uint32_t shoot_count;  //拨弹盘已推进的发数
+
+  uint16_t jam_ms;  //卡弹条件持续时间
+  uint16_t reverse_ms;  //反转剩余时间 非0时正在反转
+  fp32 jam_resume_set;  //反转结束后恢复的角度目标
+  uint32_t jam_count;  //卡弹次数
+
+  fp32 fric_speed_set;  //摩擦轮转速目标 按加速度斜坡变化 rpm
+  shoot_trigger_t trigger;
+  shoot_fric_t fric[2];
+
+} shoot_control_t;
+
+/**
+  * @brief          发射任务, 间隔SHOOT_CONTROL_TIME_MS, 摩擦轮速度环、拨弹盘角度环与速度环, 卡弹检测与热量限制
+  * @param[in]      pvParameters: 空
+  * @retval         none
+  */
+extern void shoot_task(void const *pvParameters);
+
+/**
+  * @brief          拨弹电机控制电流, 由云台任务在0x1FF帧中发送
+  * @param[in]      none
+  * @retval         2006电流值
+  */
+extern int16_t get_shoot_trigger_current(void);
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef TASK_REGISTRY_H
+
+#define TASK_REGISTRY_H
+
+#include "struct_typedef.h"
+#include "cmsis_os.h"
+
+/*任务关联的中断源 按位或 表示任务由哪些中断的数据驱动或唤醒*/
+#define TASK_ISR_NONE         0x00u
+#define TASK_ISR_CAN1_RX      0x01u  //底盘CAN接收
+#define TASK_ISR_CAN2_RX      0x02u  //云台CAN接收
+#define TASK_ISR_RC_USART     0x04u  //遥控器USART3 DMA
+#define TASK_ISR_DEBUG_USART  0x08u  //调参/遥测USART1 DMA
+#define TASK_ISR_SYSTICK      0x10u  //系统节拍
+#define TASK_ISR_IMU_INT      0x20u  //IMU陀螺仪FIFO水位中断
+#define TASK_ISR_IMU_DMA      0x40u  //IMU SPI1 DMA接收完成
+#define TASK_ISR_REFEREE_USART 0x80u //裁判系统USART6 DMA
+
+/*软件看门狗对任务的处理 见watchdog_task.c*/
+#define TASK_WDG_NONE         0u     //不监视(由事件触发的任务)
+#define TASK_WDG_REPORT       1u     //错过截止时间只计数
+#define TASK_WDG_SAFE         2u     //错过截止时间进入安全状态(CAN控制电流为0), 持续不恢复时由独立看门狗复位
+
+/*
+  中断表 响应时间分析中中断抢占全部任务
+  X(中断, 位, 最小触发间隔us, 最坏执行时间us)
+  执行时间参考monitor记录的中断占用与profile中断测量点的max
+*/
+#define TASK_ISR_TABLE(X)                    \
+  X(CAN1_RX,     TASK_ISR_CAN1_RX,     250,   6) \
+  X(CAN2_RX,     TASK_ISR_CAN2_RX,     250,   6) \
+  X(RC_USART,    TASK_ISR_RC_USART,  14000,  10) \
+  X(DEBUG_USART, TASK_ISR_DEBUG_USART, 1000, 10) \
+  X(SYSTICK,     TASK_ISR_SYSTICK,     1000,  3) \
+  X(IMU_INT,     TASK_ISR_IMU_INT,     2000,  3) \
+  X(IMU_DMA,     TASK_ISR_IMU_DMA,     1000,  4) \
+  X(REFEREE_USART, TASK_ISR_REFEREE_USART, 800, 8)
+
+/*
+  任务表 每个任务一行, TCB与栈在task_registry.c中静态分配
+  X(编号, 任务名, 入口函数, 栈(字), 周期或最小触发间隔ms, 截止时间ms, 最坏执行时间预算us, 关联中断, 看门狗)
+  优先级不在表中指定: 启动时按单调速率分配, 周期短的优先级高, 周期相同时截止时间短的高, 再相同时共用一个优先级
+  周期只用于分配优先级与分析, 任务仍按自己的周期宏延时
+  共享数据不能假定写者优先级高于读者: 例如遥控器任务(14ms)低于2ms的控制任务,
+  读者可能在写者写到一半时抢占, 需用msg_bus话题或读者不等待写者的双缓冲(见remote_control.c)
+  修改后运行 python Tools/rta.py 做响应时间分析(Keil编译前与make -C Tools/sim时自动运行, 不可调度时失败)
+*/
+#define TASK_TABLE(X)                                                                                                                  \
+  X(WATCHDOG,  WatchdogTask,  watchdog_task,       128, WATCHDOG_PERIOD_MS,      WATCHDOG_PERIOD_MS,      20,  TASK_ISR_NONE,        TASK_WDG_NONE)   \
+  X(RC,        RCTask,        remote_control_task, 128, RC_FRAME_PERIOD_MS,      RC_FRAME_PERIOD_MS,      60,  TASK_ISR_RC_USART,    TASK_WDG_NONE)   \
+  X(IMU,       IMUTask,       imu_task,            256, IMU_BATCH_PERIOD_MS,     IMU_DEADLINE_MS,         100, TASK_ISR_IMU_INT | TASK_ISR_IMU_DMA, TASK_WDG_REPORT) \
+  X(INS,       INSTask,       ins_task,            256, IMU_BATCH_PERIOD_MS,     INS_DEADLINE_MS,         60,  TASK_ISR_NONE,        TASK_WDG_REPORT) \
+  X(CHASSIS,   ChassisTask,   chassis_task,        256, CHASSIS_CONTROL_TIME_MS, CHASSIS_CONTROL_TIME_MS, 150, TASK_ISR_CAN1_RX,     TASK_WDG_SAFE)   \
+  X(GIMBAL,    GimbalTask,    gimbal_task,         256, GIMBAL_CONTROL_TIME_MS,  GIMBAL_CONTROL_TIME_MS,  100, TASK_ISR_CAN2_RX,     TASK_WDG_SAFE)   \
+  X(SHOOT,     ShootTask,     shoot_task,          256, SHOOT_CONTROL_TIME_MS,   SHOOT_CONTROL_TIME_MS,   80,  TASK_ISR_CAN2_RX,     TASK_WDG_SAFE)   \
+  X(REFEREE,   RefereeTask,   referee_task,        256, REFEREE_PERIOD_MS,       REFEREE_PERIOD_MS,       40,  TASK_ISR_REFEREE_USART, TASK_WDG_REPORT) \
+  X(TELEMETRY, TelemetryTask, telemetry_task,      256, TELEMETRY_PERIOD_MS,     TELEMETRY_PERIOD_MS,     300, TASK_ISR_DEBUG_USART, TASK_WDG_REPORT) \
+  X(MONITOR,   MonitorTask,   monitor_task,        256, MONITOR_PERIOD_MS,       MONITOR_PERIOD_MS,       800, TASK_ISR_NONE,        TASK_WDG_REPORT)
+
+/*单调速率分配的最高优先级 依次向下分配 osPriorityRealtime保留*/
+#define TASK_PRIORITY_HIGHEST osPriorityHigh
+#define TASK_PRIORITY_LOWEST  osPriorityLow
+
+/*任务编号*/
+#define TASK_ID_ENUM(id, name, entry, stack_words, period_ms, deadline_ms, wcet_us, isr, wdg) TASK_##id,
+typedef enum
+{
+  TASK_TABLE(TASK_ID_ENUM)
+  TASK_NUM,
+} task_id_e;
+#undef TASK_ID_ENUM
+
+/*任务描述 放在flash中 调试器或上位机可直接读取*/
+typedef struct
+{
+  const char *name;
+  uint16_t stack_words;   //栈长度 字
+  uint16_t period_ms;     //周期或最小触发间隔
+  uint16_t deadline_ms;   //截止时间 从触发起算
+  uint16_t wcet_us;       //单次执行时间预算
+  uint8_t isr;            //关联中断 TASK_ISR_*
+  uint8_t wdg;            //看门狗处理 TASK_WDG_*
+  uint16_t ram_bytes;     //静态分配的TCB与栈 字节
+} task_info_t;
+
+/*单次执行时间统计 只计任务自身运行的周期数, 不含被抢占与阻塞的时间(中断时间计入被打断的任务)*/
+typedef struct
+{
+  uint32_t job_count;     //完成的执行次数
+  uint32_t last;          //最近一次 周期数
+  uint32_t max;           //历史最大 周期数
+  uint32_t overrun_count; //超出wcet_us预算的次数
+  uint32_t job_start;     //本次执行开始时的累计运行周期数
+  uint32_t begin_ms;      //最近一次执行开始的系统时间 看门狗检查用
+  uint32_t end_ms;        //最近一次执行结束的系统时间
+  uint8_t running;        //1:执行中(已begin未end)
+} task_timing_t;
+
+extern const task_info_t task_info[TASK_NUM];
+extern task_timing_t task_timing[TASK_NUM];
+
+/**
+  * @brief          按任务表创建全部任务, 使用静态分配的TCB与栈, 在MX_FREERTOS_Init中调用
+  * @param[in]      none
+  * @retval         none
+  */
+extern void task_registry_start(void);
+
+/**
+  * @brief          任务句柄
+  * @param[in]      id: 任务编号
+  * @retval         任务句柄, 未创建时为NULL
+  */
+extern osThreadId task_handle_get(task_id_e id);
+
+/**
+  * @brief          启动时按单调速率分配的优先级
+  * @param[in]      id: 任务编号
+  * @retval         优先级
+  */
+extern osPriority task_priority_get(task_id_e id);
+
+/**
+  * @brief          一次执行开始, 在任务被唤醒或周期延时结束后调用, 同时作为软件看门狗的喂狗
+  * @param[in]      id: 任务编号
+  * @retval         none
+  */
+extern void task_job_begin(task_id_e id);
+
+/**
+  * @brief          一次执行结束, 在延时或等待前调用, 执行周期数超出预算时计数
+  * @param[in]      id: 任务编号
+  * @retval         none
+  */
+extern void task_job_end(task_id_e id);
+
+/**
+  * @brief          任务切换钩子, 由FreeRTOSConfig.h中的traceTASK_SWITCHED_IN调用, 累计每个任务的运行周期数
+  * @param[in]      tcb: 切换进来的任务控制块
+  * @retval         none
+  */
+extern void task_timing_switch(const void *tcb);
+
+#endif
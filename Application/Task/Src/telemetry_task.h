@@ -0,0 +1,66 @@
+#ifndef TELEMETRY_TASK_H
+
+#define TELEMETRY_TASK_H
+
+#include "struct_typedef.h"
+#include "config_freame.h"
+
+/*遥测参数*/
+#define TELEMETRY_PERIOD_MS CONFIG_TELEMETRY_PERIOD_MS          //采样周期
+#define TELEMETRY_MAX_CHANNEL CONFIG_TELEMETRY_MAX_CHANNEL      //最多注册的变量数
+#define TELEMETRY_INFO_PERIOD 50                                //每隔多少个采样周期发送一个变量描述包
+#define TELEMETRY_NAME_LEN 16                                   //变量名最大长度
+#define TELEMETRY_TX_BUF_LEN 512                                //单次DMA发送缓冲区长度
+#define TELEMETRY_TX_BLOCK_NUM 4                                //发送缓冲块数 DMA发送中时组好的块排队等待
+
+/*包类型 包格式见telemetry_task.c*/
+#define TELEMETRY_PACKET_SAMPLE  0x01
+#define TELEMETRY_PACKET_INFO    0x02
+#define TELEMETRY_PACKET_MONITOR 0x03
+
+/*变量类型 发送时统一转换为fp32*/
+typedef enum
+{
+  TELEMETRY_FP32 = 0,
+  TELEMETRY_INT8,
+  TELEMETRY_UINT8,
+  TELEMETRY_INT16,
+  TELEMETRY_UINT16,
+  TELEMETRY_INT32,
+  TELEMETRY_UINT32,
+} telemetry_type_e;
+
+/*遥测统计*/
+typedef struct
+{
+  uint32_t tick;          //采样周期计数
+  uint32_t packet_count;  //已发送的采样包
+  uint32_t drop_count;    //发送缓冲块全部在排队而丢弃的采样周期
+  uint32_t tx_bytes;      //已发送字节数
+} telemetry_status_t;
+
+/**
+  * @brief          注册遥测变量, 可在任意任务初始化时调用
+  * @param[in]      name: 变量名, 需为常量字符串, 超过TELEMETRY_NAME_LEN截断
+  * @param[in]      addr: 变量地址, 需按类型自然对齐的全局或静态变量
+  * @param[in]      type: 变量类型
+  * @param[in]      decimation: 抽取倍数, 每decimation个采样周期采样一次, 0按1处理
+  * @retval         通道号, 注册表已满返回-1
+  */
+extern int16_t telemetry_register(const char *name, const volatile void *addr, telemetry_type_e type, uint8_t decimation);
+
+/**
+  * @brief          获取遥测统计
+  * @param[in]      none
+  * @retval         遥测统计指针
+  */
+extern const telemetry_status_t *get_telemetry_status_point(void);
+
+/**
+  * @brief          遥测任务, 周期采样已注册变量并通过串口DMA发送
+  * @param[in]      pvParameters: 空
+  * @retval         none
+  */
+extern void telemetry_task(void const *pvParameters);
+
+#endif
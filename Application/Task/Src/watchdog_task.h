@@ -0,0 +1,66 @@
+#ifndef WATCHDOG_TASK_H
+
+#define WATCHDOG_TASK_H
+
+#include "struct_typedef.h"
+#include "config_freame.h"
+#include "task_registry.h"
+
+/*看门狗任务周期 也是检查周期*/
+#define WATCHDOG_PERIOD_MS CONFIG_WATCHDOG_PERIOD_MS
+#define WATCHDOG_RECOVER_MS CONFIG_WATCHDOG_RECOVER_MS          //安全状态下控制任务按时执行多久后恢复
+#define WATCHDOG_RESET_MS CONFIG_WATCHDOG_RESET_MS              //控制任务持续超时多久后停止喂狗
+#define WATCHDOG_IWDG_TIMEOUT_MS CONFIG_WATCHDOG_IWDG_TIMEOUT_MS
+
+/*逐级处理*/
+typedef enum
+{
+  WATCHDOG_OK = 0,      //正常喂独立看门狗
+  WATCHDOG_SAFE,        //TASK_WDG_SAFE任务超时 CAN控制电流为0
+  WATCHDOG_RESET,       //超时持续WATCHDOG_RESET_MS 停止喂狗 等待独立看门狗复位
+} watchdog_state_e;
+
+/*每个任务的检查结果*/
+typedef struct
+{
+  uint32_t overrun_count;   //执行中超过截止时间的次数(一次超时只计一次)
+  uint32_t miss_count;      //上次执行结束后 未在周期加截止时间内开始并完成下一次的次数
+  uint32_t late_since_ms;   //本次超时的截止时刻 未超时为0
+  uint16_t reaction_max_ms; //截止时刻到检测到超时的最大延迟
+  uint8_t late;             //1:当前超时
+} watchdog_task_status_t;
+
+/*看门狗状态*/
+typedef struct
+{
+  uint8_t state;              //watchdog_state_e
+  uint8_t reset_by_iwdg;      //上一次复位由独立看门狗引起
+  uint8_t last_late_task;     //最近一次超时的任务 TASK_NUM表示没有
+  uint32_t safe_count;        //进入安全状态的次数
+  uint32_t safe_enter_ms;     //最近一次进入安全状态的时间
+  uint32_t healthy_since_ms;  //安全状态下全部TASK_WDG_SAFE任务恢复按时执行的时间
+  watchdog_task_status_t task[TASK_NUM];
+} watchdog_status_t;
+
+/**
+  * @brief          检查全部任务的执行时间 并按需进入或退出安全状态, 由看门狗任务每周期调用
+  * @param[in]      now_ms: 系统时间
+  * @retval         检查后的状态 watchdog_state_e, WATCHDOG_RESET时不再喂狗
+  */
+extern watchdog_state_e watchdog_check(uint32_t now_ms);
+
+/**
+  * @brief          读取看门狗状态
+  * @param[out]     status_out: 状态拷贝
+  * @retval         none
+  */
+extern void watchdog_read(watchdog_status_t *status_out);
+
+/**
+  * @brief          看门狗任务, 启动独立看门狗, 每周期检查各任务是否按时执行, 正常时喂狗
+  * @param[in]      pvParameters: 空
+  * @retval         none
+  */
+extern void watchdog_task(void const *pvParameters);
+
+#endif
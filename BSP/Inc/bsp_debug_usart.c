@@ -0,0 +1,32 @@
+#include "bsp_debug_usart.h"
+#include "main.h"
+
+extern UART_HandleTypeDef huart1;
+extern DMA_HandleTypeDef hdma_usart1_rx;
+
+//调试串口接收对象
+static usart_rx_t debug_usart_rx;
+
+void debug_usart_rx_init(uint8_t *buf, uint16_t buf_len)
+{
+    //调参请求为不定长数据流 使用循环模式 由读取者按帧分隔符切分
+    usart_rx_init(&debug_usart_rx, &huart1, &hdma_usart1_rx, USART_RX_CIRCULAR,
+                  buf, NULL, buf_len, NULL, NULL);
+}
+
+usart_rx_t *get_debug_usart_rx_point(void)
+{
+    return &debug_usart_rx;
+}
+
+//在DMA2_Stream2_IRQHandler中调用
+void debug_usart_dma_irq_handler(void)
+{
+    usart_rx_dma_irq_handler(&debug_usart_rx);
+}
+
+//串口中断
+void USART1_IRQHandler(void)
+{
+    usart_rx_irq_handler(&debug_usart_rx);
+}
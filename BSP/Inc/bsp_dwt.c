@@ -0,0 +1,95 @@
+#include "bsp_dwt.h"
+
+#if DWT_TARGET
+
+void dwt_init(void)
+{
+    //使能跟踪模块 DWT寄存器才可访问
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    //已经开启时不清零 避免64位计数与已有测量出现跳变
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0)
+    {
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+}
+
+uint32_t dwt_get_freq(void)
+{
+    return SystemCoreClock;
+}
+
+#else
+
+#include <time.h>
+
+static uint32_t dwt_host_freq = 0;
+
+#if defined(__x86_64__) || defined(__i386__)
+//用单调时钟标定rdtsc频率 约10ms
+static uint32_t dwt_host_calibrate(void)
+{
+    struct timespec t0, t1;
+    uint64_t ns;
+    uint32_t c0, c1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    c0 = dwt_cycle_get();
+    do
+    {
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        ns = (uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000000ull + (uint64_t)(t1.tv_nsec - t0.tv_nsec);
+    } while (ns < 10000000ull);
+    c1 = dwt_cycle_get();
+
+    return (uint32_t)((uint64_t)(c1 - c0) * 1000000000ull / ns);
+}
+#else
+static uint32_t dwt_host_calibrate(void)
+{
+    return 1000000000u;
+}
+#endif
+
+void dwt_init(void)
+{
+    dwt_host_freq = dwt_host_calibrate();
+}
+
+uint32_t dwt_get_freq(void)
+{
+    if (dwt_host_freq == 0)
+    {
+        dwt_init();
+    }
+    return dwt_host_freq;
+}
+
+#endif
+
+static uint32_t dwt_cycle_last = 0;
+static uint64_t dwt_cycle_high = 0;
+
+uint64_t dwt_cycle64_get(void)
+{
+    uint64_t cycle64;
+    uint32_t now;
+#if DWT_TARGET
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+#endif
+    now = dwt_cycle_get();
+
+    dwt_cycle_high += (uint32_t)(now - dwt_cycle_last);
+    dwt_cycle_last = now;
+    cycle64 = dwt_cycle_high;
+#if DWT_TARGET
+    __set_PRIMASK(primask);
+#endif
+    return cycle64;
+}
+
+fp32 dwt_cycle_to_us(uint32_t cycles)
+{
+    return (fp32)cycles * 1000000.0f / (fp32)dwt_get_freq();
+}
@@ -0,0 +1,66 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       bsp_flash.c/h
+  * @brief      内部flash扇区擦除与按字写入，用于参数存储(param.c)。
+  * @note       擦写期间CPU读取flash被暂停, 中断与任务都不运行, CAN控制帧停止发送,
+  *             电调保持最后收到的控制电流; 擦除前让电机停止由调用者负责(param.c)。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    擦除: 解锁 -> 清除错误标志 -> 独立看门狗超时加长到BSP_FLASH_ERASE_IWDG_MS
+          -> HAL_FLASHEx_Erase(128KB扇区约1~2s) -> 恢复看门狗超时 -> 上锁
+    写入: 解锁 -> 清除错误标志 -> 按字写入(3.3V供电 VOLTAGE_RANGE_3) -> 上锁
+    目标地址需已擦除, 写入是否成功由调用者回读确认(flash_store.c)
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include "bsp_flash.h"
+#include "bsp_iwdg.h"
+
+#define FLASH_ERROR_FLAG (FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR | FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR)
+
+bool_t bsp_flash_erase_sector(uint32_t sector)
+{
+    FLASH_EraseInitTypeDef erase;
+    uint32_t sector_error = 0;
+    uint16_t iwdg_timeout = iwdg_timeout_get();
+    HAL_StatusTypeDef status;
+
+    erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    erase.Sector = sector;
+    erase.NbSectors = 1;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+    HAL_FLASH_Unlock();
+    //清除之前的错误标志 否则擦除直接失败
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_ERROR_FLAG);
+    //擦除期间CPU暂停 不能喂狗
+    iwdg_timeout_set(BSP_FLASH_ERASE_IWDG_MS);
+    status = HAL_FLASHEx_Erase(&erase, &sector_error);
+    iwdg_timeout_set(iwdg_timeout);
+    HAL_FLASH_Lock();
+
+    return (status == HAL_OK && sector_error == 0xFFFFFFFFu) ? 1 : 0;
+}
+
+bool_t bsp_flash_program_word(uint32_t address, uint32_t data)
+{
+    HAL_StatusTypeDef status;
+
+    if (address & 0x3u)
+    {
+        return 0;
+    }
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_ERROR_FLAG);
+    status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, data);
+    HAL_FLASH_Lock();
+
+    return (status == HAL_OK) ? 1 : 0;
+}
@@ -0,0 +1,244 @@
+#include "bsp_imu.h"
+#include "bsp_dwt.h"
+#include "main.h"
+#include "cmsis_os.h"
+
+#define IMU_SPI             SPI1
+#define IMU_RX_STREAM       DMA2_Stream0
+#define IMU_TX_STREAM       DMA2_Stream3
+#define IMU_DMA_CHANNEL     (DMA_SxCR_CHSEL_0 | DMA_SxCR_CHSEL_1) //通道3
+#define IMU_RX_FLAGS        (DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0)
+#define IMU_TX_FLAGS        (DMA_LIFCR_CTCIF3 | DMA_LIFCR_CHTIF3 | DMA_LIFCR_CTEIF3 | DMA_LIFCR_CDMEIF3 | DMA_LIFCR_CFEIF3)
+#define IMU_IRQ_PRIORITY    5   //可调用FreeRTOS的FromISR接口
+
+#define IMU_ACCEL_CS_PORT   GPIOA
+#define IMU_ACCEL_CS_PIN    GPIO_PIN_4
+#define IMU_GYRO_CS_PORT    GPIOB
+#define IMU_GYRO_CS_PIN     GPIO_PIN_0
+#define IMU_GYRO_INT_PORT   GPIOC
+#define IMU_GYRO_INT_PIN    GPIO_PIN_5
+
+static bsp_imu_int_callback_t imu_int_callback = NULL;
+static bsp_imu_dma_callback_t imu_dma_callback = NULL;
+static volatile bool_t imu_dma_busy = 0;
+static bsp_imu_cs_e imu_dma_cs;
+//DMA发送的固定字节
+static const uint8_t imu_tx_dummy = 0xFF;
+
+static void imu_cs_set(bsp_imu_cs_e cs, GPIO_PinState state)
+{
+    if (cs == BSP_IMU_ACCEL)
+    {
+        HAL_GPIO_WritePin(IMU_ACCEL_CS_PORT, IMU_ACCEL_CS_PIN, state);
+    }
+    else
+    {
+        HAL_GPIO_WritePin(IMU_GYRO_CS_PORT, IMU_GYRO_CS_PIN, state);
+    }
+}
+
+//收发一个字节
+static uint8_t imu_spi_byte(uint8_t tx)
+{
+    while ((IMU_SPI->SR & SPI_SR_TXE) == 0)
+    {
+    }
+    *(volatile uint8_t *)&IMU_SPI->DR = tx;
+    while ((IMU_SPI->SR & SPI_SR_RXNE) == 0)
+    {
+    }
+    return *(volatile uint8_t *)&IMU_SPI->DR;
+}
+
+void bsp_imu_init(bsp_imu_int_callback_t int_callback, bsp_imu_dma_callback_t dma_callback)
+{
+    GPIO_InitTypeDef gpio;
+
+    imu_int_callback = int_callback;
+    imu_dma_callback = dma_callback;
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_GPIOC_CLK_ENABLE();
+    __HAL_RCC_SYSCFG_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
+    __HAL_RCC_SPI1_CLK_ENABLE();
+
+    //片选默认拉高
+    HAL_GPIO_WritePin(IMU_ACCEL_CS_PORT, IMU_ACCEL_CS_PIN, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(IMU_GYRO_CS_PORT, IMU_GYRO_CS_PIN, GPIO_PIN_SET);
+    gpio.Mode = GPIO_MODE_OUTPUT_PP;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_HIGH;
+    gpio.Alternate = 0;
+    gpio.Pin = IMU_ACCEL_CS_PIN;
+    HAL_GPIO_Init(IMU_ACCEL_CS_PORT, &gpio);
+    gpio.Pin = IMU_GYRO_CS_PIN;
+    HAL_GPIO_Init(IMU_GYRO_CS_PORT, &gpio);
+
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.Alternate = GPIO_AF5_SPI1;
+    gpio.Pin = GPIO_PIN_7;
+    HAL_GPIO_Init(GPIOA, &gpio);
+    gpio.Pin = GPIO_PIN_3 | GPIO_PIN_4;
+    HAL_GPIO_Init(GPIOB, &gpio);
+
+    gpio.Mode = GPIO_MODE_IT_RISING;
+    gpio.Pull = GPIO_PULLDOWN;
+    gpio.Speed = GPIO_SPEED_FREQ_LOW;
+    gpio.Alternate = 0;
+    gpio.Pin = IMU_GYRO_INT_PIN;
+    HAL_GPIO_Init(IMU_GYRO_INT_PORT, &gpio);
+
+    //主机 模式3 软件片选 8位 84MHz/16
+    IMU_SPI->CR1 = 0;
+    IMU_SPI->CR2 = 0;
+    IMU_SPI->CR1 = SPI_CR1_MSTR | SPI_CR1_CPOL | SPI_CR1_CPHA | SPI_CR1_SSM | SPI_CR1_SSI |
+                   SPI_CR1_BR_0 | SPI_CR1_BR_1;
+    IMU_SPI->CR1 |= SPI_CR1_SPE;
+
+    IMU_RX_STREAM->CR = 0;
+    IMU_TX_STREAM->CR = 0;
+    IMU_RX_STREAM->PAR = (uint32_t)&IMU_SPI->DR;
+    IMU_TX_STREAM->PAR = (uint32_t)&IMU_SPI->DR;
+
+    HAL_NVIC_SetPriority(DMA2_Stream0_IRQn, IMU_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+    HAL_NVIC_SetPriority(EXTI9_5_IRQn, IMU_IRQ_PRIORITY, 0);
+    bsp_imu_int_enable(0);
+}
+
+void bsp_imu_int_enable(bool_t enable)
+{
+    if (enable)
+    {
+        __HAL_GPIO_EXTI_CLEAR_IT(IMU_GYRO_INT_PIN);
+        HAL_NVIC_EnableIRQ(EXTI9_5_IRQn);
+    }
+    else
+    {
+        HAL_NVIC_DisableIRQ(EXTI9_5_IRQn);
+    }
+}
+
+void bsp_imu_write(bsp_imu_cs_e cs, uint8_t reg, uint8_t value)
+{
+    imu_cs_set(cs, GPIO_PIN_RESET);
+    imu_spi_byte(reg & 0x7Fu);
+    imu_spi_byte(value);
+    imu_cs_set(cs, GPIO_PIN_SET);
+}
+
+void bsp_imu_read(bsp_imu_cs_e cs, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    imu_cs_set(cs, GPIO_PIN_RESET);
+    imu_spi_byte(reg | 0x80u);
+    while (len--)
+    {
+        *buf++ = imu_spi_byte(0xFF);
+    }
+    imu_cs_set(cs, GPIO_PIN_SET);
+}
+
+bool_t bsp_imu_read_dma(bsp_imu_cs_e cs, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    if (imu_dma_busy || len == 0)
+    {
+        return 0;
+    }
+    imu_dma_busy = 1;
+    imu_dma_cs = cs;
+
+    imu_cs_set(cs, GPIO_PIN_RESET);
+    imu_spi_byte(reg | 0x80u);
+
+    //接收: 外设->存储器 地址递增; 发送: 固定字节 地址不递增
+    DMA2->LIFCR = IMU_RX_FLAGS | IMU_TX_FLAGS;
+    IMU_RX_STREAM->M0AR = (uint32_t)buf;
+    IMU_RX_STREAM->NDTR = len;
+    IMU_RX_STREAM->CR = IMU_DMA_CHANNEL | DMA_SxCR_MINC | DMA_SxCR_PL_1 | DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+    IMU_TX_STREAM->M0AR = (uint32_t)&imu_tx_dummy;
+    IMU_TX_STREAM->NDTR = len;
+    IMU_TX_STREAM->CR = IMU_DMA_CHANNEL | DMA_SxCR_DIR_0 | DMA_SxCR_PL_1;
+    IMU_RX_STREAM->CR |= DMA_SxCR_EN;
+    IMU_TX_STREAM->CR |= DMA_SxCR_EN;
+    IMU_SPI->CR2 |= SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+    return 1;
+}
+
+void bsp_imu_dma_abort(void)
+{
+    IMU_SPI->CR2 &= ~(SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+    IMU_RX_STREAM->CR &= ~(DMA_SxCR_EN | DMA_SxCR_TCIE | DMA_SxCR_TEIE);
+    IMU_TX_STREAM->CR &= ~DMA_SxCR_EN;
+    //EN读回0后流才停止 之后再清标志 DMA中断不会再到来
+    while ((IMU_RX_STREAM->CR & DMA_SxCR_EN) || (IMU_TX_STREAM->CR & DMA_SxCR_EN))
+    {
+    }
+    DMA2->LIFCR = IMU_RX_FLAGS | IMU_TX_FLAGS;
+    //读DR再读SR 清除未被DMA取走的RXNE与OVR
+    (void)*(volatile uint8_t *)&IMU_SPI->DR;
+    (void)IMU_SPI->SR;
+
+    HAL_GPIO_WritePin(IMU_ACCEL_CS_PORT, IMU_ACCEL_CS_PIN, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(IMU_GYRO_CS_PORT, IMU_GYRO_CS_PIN, GPIO_PIN_SET);
+    imu_dma_busy = 0;
+}
+
+void bsp_imu_delay_ms(uint16_t ms)
+{
+    if (osKernelRunning())
+    {
+        osDelay(ms);
+    }
+    else
+    {
+        HAL_Delay(ms);
+    }
+}
+
+uint32_t bsp_imu_time_us(void)
+{
+    return (uint32_t)(dwt_cycle64_get() / (SystemCoreClock / 1000000u));
+}
+
+//接收完成即全部字节已收发 拉高片选
+void DMA2_Stream0_IRQHandler(void)
+{
+    uint32_t flags = DMA2->LISR;
+    bool_t ok = (flags & DMA_LISR_TEIF0) ? 0 : 1;
+
+    if ((flags & (DMA_LISR_TCIF0 | DMA_LISR_TEIF0)) == 0)
+    {
+        return;
+    }
+    DMA2->LIFCR = IMU_RX_FLAGS | IMU_TX_FLAGS;
+
+    IMU_SPI->CR2 &= ~(SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+    IMU_RX_STREAM->CR &= ~DMA_SxCR_EN;
+    IMU_TX_STREAM->CR &= ~DMA_SxCR_EN;
+    while (IMU_SPI->SR & SPI_SR_BSY)
+    {
+    }
+    imu_cs_set(imu_dma_cs, GPIO_PIN_SET);
+    imu_dma_busy = 0;
+
+    if (imu_dma_callback != NULL)
+    {
+        imu_dma_callback(ok);
+    }
+}
+
+//陀螺仪INT3
+void EXTI9_5_IRQHandler(void)
+{
+    if (__HAL_GPIO_EXTI_GET_IT(IMU_GYRO_INT_PIN))
+    {
+        __HAL_GPIO_EXTI_CLEAR_IT(IMU_GYRO_INT_PIN);
+        if (imu_int_callback != NULL)
+        {
+            imu_int_callback(bsp_imu_time_us());
+        }
+    }
+}
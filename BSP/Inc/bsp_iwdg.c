@@ -0,0 +1,75 @@
+#include "bsp_iwdg.h"
+#include "main.h"
+
+#define IWDG_KEY_RELOAD    0xAAAAu
+#define IWDG_KEY_ENABLE    0xCCCCu
+#define IWDG_KEY_ACCESS    0x5555u
+#define IWDG_PRESCALER_32  0x3u     //LSI/32 约1ms每计数
+
+static uint16_t iwdg_timeout = 0;
+static bool_t iwdg_reset_flag = 0;
+
+//写预分频与重装载值 需等待上一次更新完成
+static void iwdg_reload_write(uint16_t timeout_ms)
+{
+    if (timeout_ms == 0)
+    {
+        timeout_ms = 1;
+    }
+    if (timeout_ms > IWDG_TIMEOUT_MAX_MS)
+    {
+        timeout_ms = IWDG_TIMEOUT_MAX_MS;
+    }
+
+    IWDG->KR = IWDG_KEY_ACCESS;
+    while (IWDG->SR & IWDG_SR_PVU)
+    {
+    }
+    IWDG->PR = IWDG_PRESCALER_32;
+    while (IWDG->SR & IWDG_SR_RVU)
+    {
+    }
+    IWDG->RLR = timeout_ms;
+    IWDG->KR = IWDG_KEY_RELOAD;
+
+    iwdg_timeout = timeout_ms;
+}
+
+void iwdg_init(uint16_t timeout_ms)
+{
+    //复位标志需软件清除 清除后下次复位才能区分原因
+    iwdg_reset_flag = (RCC->CSR & RCC_CSR_IWDGRSTF) ? 1 : 0;
+    RCC->CSR |= RCC_CSR_RMVF;
+
+    //调试器暂停内核时看门狗停止计数
+    DBGMCU->APB1FZ |= DBGMCU_APB1_FZ_DBG_IWDG_STOP;
+
+    IWDG->KR = IWDG_KEY_ENABLE;
+    iwdg_reload_write(timeout_ms);
+}
+
+void iwdg_feed(void)
+{
+    if (iwdg_timeout != 0)
+    {
+        IWDG->KR = IWDG_KEY_RELOAD;
+    }
+}
+
+void iwdg_timeout_set(uint16_t timeout_ms)
+{
+    if (iwdg_timeout != 0)
+    {
+        iwdg_reload_write(timeout_ms);
+    }
+}
+
+uint16_t iwdg_timeout_get(void)
+{
+    return iwdg_timeout;
+}
+
+bool_t iwdg_caused_reset(void)
+{
+    return iwdg_reset_flag;
+}
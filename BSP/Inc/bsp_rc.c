@@ -1,40 +1,40 @@
 #include "bsp_rc.h"
 #include "main.h"
+#include "profile.h"
 
 //用于UART3的初始化
 extern UART_HandleTypeDef huart3;
 extern DMA_HandleTypeDef hdma_usart3_rx;
 
-void RC_init(uint8_t *rx1_buf, uint8_t *rx2_buf, uint16_t dma_buf_num) 
-{   
-    //使能DMA串口接收
-    SET_BIT(huart3.Instance->CR3, USART_CR3_DMAR);
-    //使能空闲中断
-    __HAL_UART_ENABLE_IT(&huart3, UART_IT_IDLE);
+//遥控器串口接收对象
+static usart_rx_t rc_usart_rx;
 
-    //失效DMA
-    __HAL_DMA_DISABLE(&hdma_usart3_rx);
+//遥控器串口中断执行时间
+PROFILE_SCOPE_DEFINE(rc_usart_isr);
 
-    while (hdma_usart3_rx.Instance->CR & DMA_SxCR_EN)
-    {
-        __HAL_DMA_DISABLE(&hdma_usart3_rx);
-    }
-
-    hdma_usart3_rx.Instance->PAR = (uint32_t) & (USART3->DR);
+void RC_init(uint8_t *rx1_buf, uint8_t *rx2_buf, uint16_t dma_buf_num, usart_rx_callback_t rx_callback)
+{
+    //遥控器为定长帧 使用双缓冲模式 每次空闲中断得到完整一帧
+    usart_rx_init(&rc_usart_rx, &huart3, &hdma_usart3_rx, USART_RX_DOUBLE_BUFFER,
+                  rx1_buf, rx2_buf, dma_buf_num, rx_callback, NULL);
+}
 
-    //内存缓冲区1
-    hdma_usart3_rx.Instance->M0AR = (uint32_t)(rx1_buf);
-    
-    //内存缓冲区2
-    hdma_usart3_rx.Instance->M1AR = (uint32_t)(rx2_buf);
+//获取遥控器串口接收对象 用于查看接收统计
+const usart_rx_t *get_RC_usart_rx_point(void)
+{
+    return &rc_usart_rx;
+}
 
-    //数据长度
-    hdma_usart3_rx.Instance->NDTR = dma_buf_num;
+//在DMA1_Stream1_IRQHandler中调用
+void RC_dma_irq_handler(void)
+{
+    usart_rx_dma_irq_handler(&rc_usart_rx);
+}
 
-    //使能双缓冲区
-    SET_BIT(hdma_usart3_rx.Instance->CR, DMA_SxCR_DBM);
- 
-    //使能DMA
-    __HAL_DMA_ENABLE(&hdma_usart3_rx);
-		
+//串口中断
+void USART3_IRQHandler(void)
+{
+    PROFILE_BEGIN(rc_usart_isr);
+    usart_rx_irq_handler(&rc_usart_rx);
+    PROFILE_END(rc_usart_isr);
 }
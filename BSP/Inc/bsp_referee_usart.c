@@ -0,0 +1,32 @@
+#include "bsp_referee_usart.h"
+#include "main.h"
+
+extern UART_HandleTypeDef huart6;
+extern DMA_HandleTypeDef hdma_usart6_rx;
+
+//裁判系统串口接收对象
+static usart_rx_t referee_usart_rx;
+
+void referee_usart_rx_init(uint8_t *buf, uint16_t buf_len)
+{
+    //裁判系统为多种命令混合的不定长数据流 使用循环模式 由读取者按帧头切分
+    usart_rx_init(&referee_usart_rx, &huart6, &hdma_usart6_rx, USART_RX_CIRCULAR,
+                  buf, NULL, buf_len, NULL, NULL);
+}
+
+usart_rx_t *get_referee_usart_rx_point(void)
+{
+    return &referee_usart_rx;
+}
+
+//在DMA2_Stream1_IRQHandler中调用
+void referee_usart_dma_irq_handler(void)
+{
+    usart_rx_dma_irq_handler(&referee_usart_rx);
+}
+
+//串口中断
+void USART6_IRQHandler(void)
+{
+    usart_rx_irq_handler(&referee_usart_rx);
+}
@@ -0,0 +1,288 @@
+#include "bsp_usart.h"
+#include "bsp_lock.h"
+
+#define USART_RX_ERROR_FLAG (USART_SR_ORE | USART_SR_NE | USART_SR_FE | USART_SR_PE)
+
+//关闭DMA并等待关闭完成 关闭后NDTR才是准确值
+static void usart_rx_dma_stop(DMA_HandleTypeDef *hdma)
+{
+    __HAL_DMA_DISABLE(hdma);
+    while (hdma->Instance->CR & DMA_SxCR_EN)
+    {
+        __HAL_DMA_DISABLE(hdma);
+    }
+    //关闭数据流会置位传输完成标志 这里清除 避免误判为溢出
+    __HAL_DMA_CLEAR_FLAG(hdma, __HAL_DMA_GET_TC_FLAG_INDEX(hdma) | __HAL_DMA_GET_HT_FLAG_INDEX(hdma));
+}
+
+//循环模式 根据DMA写位置累计写入字节数 两次调用之间写入量不能超过缓冲区长度(由过半/完成中断保证)
+//串口中断与DMA中断都会调用 优先级不同时可能互相抢占, 读NDTR到写回dma_last_pos之间加锁
+static void usart_rx_circular_update(usart_rx_t *rx)
+{
+    uint16_t pos;
+    uint16_t delta;
+    uint32_t key;
+
+    key = bsp_lock(&rx->lock);
+    pos = rx->buf_len - (uint16_t)rx->hdma->Instance->NDTR;
+    if (pos >= rx->buf_len)
+    {
+        pos = 0;
+    }
+    delta = (pos >= rx->dma_last_pos) ? (pos - rx->dma_last_pos) : (pos + rx->buf_len - rx->dma_last_pos);
+
+    rx->dma_last_pos = pos;
+    rx->write_count += delta;
+    rx->rx_bytes += delta;
+    bsp_unlock(&rx->lock, key);
+}
+
+//双缓冲模式 空闲中断切换缓冲区
+static void usart_rx_double_buffer_idle(usart_rx_t *rx)
+{
+    uint8_t done_index;
+    uint16_t this_time_rx_len;
+
+    usart_rx_dma_stop(rx->hdma);
+
+    //判断是0号缓冲区 还是1号缓冲区
+    done_index = (rx->hdma->Instance->CR & DMA_SxCR_CT) ? 1 : 0;
+    //获取接收数据长度 接收数据长度=设定长度-剩余长度
+    this_time_rx_len = rx->buf_len - (uint16_t)rx->hdma->Instance->NDTR;
+    //重新设定数据长度
+    rx->hdma->Instance->NDTR = rx->buf_len;
+    //切换到另一个缓冲区
+    rx->hdma->Instance->CR ^= DMA_SxCR_CT;
+    //使能DMA
+    __HAL_DMA_ENABLE(rx->hdma);
+
+    rx->rx_bytes += this_time_rx_len;
+
+    if (rx->idle_callback != NULL && this_time_rx_len != 0)
+    {
+        rx->idle_callback(rx, rx->buf[done_index], this_time_rx_len);
+    }
+}
+
+void usart_rx_init(usart_rx_t *rx, UART_HandleTypeDef *huart, DMA_HandleTypeDef *hdma, usart_rx_mode_e mode,
+                   uint8_t *buf0, uint8_t *buf1, uint16_t buf_len, usart_rx_callback_t idle_callback, void *user)
+{
+    if (rx == NULL || huart == NULL || hdma == NULL || buf0 == NULL || buf_len == 0)
+    {
+        return;
+    }
+    if (mode == USART_RX_DOUBLE_BUFFER && buf1 == NULL)
+    {
+        return;
+    }
+    //循环模式用累计计数取模定位 要求长度为2的幂
+    if (mode == USART_RX_CIRCULAR && (buf_len & (buf_len - 1)) != 0)
+    {
+        return;
+    }
+
+    rx->huart = huart;
+    rx->hdma = hdma;
+    rx->mode = mode;
+    rx->buf[0] = buf0;
+    rx->buf[1] = buf1;
+    rx->buf_len = buf_len;
+    rx->idle_callback = idle_callback;
+    rx->user = user;
+    rx->lock = 0;
+    rx->dma_last_pos = 0;
+    rx->write_count = 0;
+    rx->read_count = 0;
+    rx->rx_bytes = 0;
+    rx->frame_count = 0;
+    rx->overflow_count = 0;
+    rx->error_count = 0;
+
+    //使能DMA串口接收
+    SET_BIT(huart->Instance->CR3, USART_CR3_DMAR);
+    //使能空闲中断
+    __HAL_UART_ENABLE_IT(huart, UART_IT_IDLE);
+
+    //失效DMA
+    usart_rx_dma_stop(hdma);
+
+    hdma->Instance->PAR = (uint32_t) & (huart->Instance->DR);
+    //内存缓冲区1
+    hdma->Instance->M0AR = (uint32_t)(buf0);
+    //数据长度
+    hdma->Instance->NDTR = buf_len;
+
+    if (mode == USART_RX_DOUBLE_BUFFER)
+    {
+        //内存缓冲区2
+        hdma->Instance->M1AR = (uint32_t)(buf1);
+        CLEAR_BIT(hdma->Instance->CR, DMA_SxCR_CT | DMA_SxCR_CIRC | DMA_SxCR_HTIE);
+        //使能双缓冲区 缓冲区写满(帧超长)时产生传输完成中断
+        SET_BIT(hdma->Instance->CR, DMA_SxCR_DBM | DMA_SxCR_TCIE);
+    }
+    else
+    {
+        CLEAR_BIT(hdma->Instance->CR, DMA_SxCR_DBM | DMA_SxCR_CT);
+        //循环模式 过半与完成中断保证写位置至少每半个缓冲区更新一次
+        SET_BIT(hdma->Instance->CR, DMA_SxCR_CIRC | DMA_SxCR_HTIE | DMA_SxCR_TCIE);
+    }
+
+    //使能DMA
+    __HAL_DMA_ENABLE(hdma);
+}
+
+void usart_rx_irq_handler(usart_rx_t *rx)
+{
+    uint32_t sr;
+
+    if (rx == NULL || rx->huart == NULL)
+    {
+        return;
+    }
+
+    sr = rx->huart->Instance->SR;
+
+    if (sr & USART_RX_ERROR_FLAG)
+    {
+        rx->error_count++;
+    }
+
+    if (sr & USART_SR_IDLE)
+    {
+        //读SR再读DR 清除空闲与错误标志
+        __HAL_UART_CLEAR_PEFLAG(rx->huart);
+        rx->frame_count++;
+
+        if (rx->mode == USART_RX_DOUBLE_BUFFER)
+        {
+            usart_rx_double_buffer_idle(rx);
+        }
+        else
+        {
+            usart_rx_circular_update(rx);
+            if (rx->idle_callback != NULL)
+            {
+                rx->idle_callback(rx, NULL, (uint16_t)(rx->write_count - rx->read_count));
+            }
+        }
+    }
+    else if (sr & USART_RX_ERROR_FLAG)
+    {
+        __HAL_UART_CLEAR_PEFLAG(rx->huart);
+    }
+}
+
+void usart_rx_dma_irq_handler(usart_rx_t *rx)
+{
+    if (rx == NULL || rx->hdma == NULL)
+    {
+        return;
+    }
+
+    if (__HAL_DMA_GET_FLAG(rx->hdma, __HAL_DMA_GET_TC_FLAG_INDEX(rx->hdma)))
+    {
+        __HAL_DMA_CLEAR_FLAG(rx->hdma, __HAL_DMA_GET_TC_FLAG_INDEX(rx->hdma));
+        if (rx->mode == USART_RX_DOUBLE_BUFFER)
+        {
+            //双缓冲区写满仍未出现空闲 帧长超过缓冲区
+            rx->overflow_count++;
+        }
+        else
+        {
+            usart_rx_circular_update(rx);
+        }
+    }
+
+    if (__HAL_DMA_GET_FLAG(rx->hdma, __HAL_DMA_GET_HT_FLAG_INDEX(rx->hdma)))
+    {
+        __HAL_DMA_CLEAR_FLAG(rx->hdma, __HAL_DMA_GET_HT_FLAG_INDEX(rx->hdma));
+        if (rx->mode == USART_RX_CIRCULAR)
+        {
+            usart_rx_circular_update(rx);
+        }
+    }
+}
+
+uint16_t usart_rx_available(usart_rx_t *rx)
+{
+    uint32_t unread;
+
+    if (rx == NULL || rx->mode != USART_RX_CIRCULAR)
+    {
+        return 0;
+    }
+
+    unread = rx->write_count - rx->read_count;
+    //未读数据被DMA覆盖 丢弃全部未读数据重新同步
+    if (unread > rx->buf_len)
+    {
+        rx->overflow_count++;
+        rx->read_count = rx->write_count;
+        return 0;
+    }
+    return (uint16_t)unread;
+}
+
+uint16_t usart_rx_peek(usart_rx_t *rx, const uint8_t **data)
+{
+    uint16_t unread = usart_rx_available(rx);
+    uint16_t start;
+    uint16_t contiguous;
+
+    if (unread == 0 || data == NULL)
+    {
+        return 0;
+    }
+
+    start = (uint16_t)(rx->read_count & (rx->buf_len - 1));
+    contiguous = rx->buf_len - start;
+    *data = &rx->buf[0][start];
+
+    return unread < contiguous ? unread : contiguous;
+}
+
+void usart_rx_consume(usart_rx_t *rx, uint16_t len)
+{
+    uint16_t unread = usart_rx_available(rx);
+
+    if (len > unread)
+    {
+        len = unread;
+    }
+    rx->read_count += len;
+}
+
+bool_t usart_tx_dma_busy(DMA_HandleTypeDef *hdma)
+{
+    //普通模式传输完成后硬件自动清除EN
+    return (hdma->Instance->CR & DMA_SxCR_EN) ? 1 : 0;
+}
+
+bool_t usart_tx_dma_start(UART_HandleTypeDef *huart, DMA_HandleTypeDef *hdma, const uint8_t *data, uint16_t len)
+{
+    if (huart == NULL || hdma == NULL || data == NULL || len == 0)
+    {
+        return 0;
+    }
+    if (usart_tx_dma_busy(hdma))
+    {
+        return 0;
+    }
+
+    //清除上一次传输的标志
+    __HAL_DMA_CLEAR_FLAG(hdma, __HAL_DMA_GET_TC_FLAG_INDEX(hdma) | __HAL_DMA_GET_HT_FLAG_INDEX(hdma) |
+                               __HAL_DMA_GET_TE_FLAG_INDEX(hdma) | __HAL_DMA_GET_FE_FLAG_INDEX(hdma) |
+                               __HAL_DMA_GET_DME_FLAG_INDEX(hdma));
+
+    //使能DMA串口发送
+    SET_BIT(huart->Instance->CR3, USART_CR3_DMAT);
+
+    hdma->Instance->PAR = (uint32_t) & (huart->Instance->DR);
+    hdma->Instance->M0AR = (uint32_t)(data);
+    hdma->Instance->NDTR = len;
+
+    //使能DMA
+    __HAL_DMA_ENABLE(hdma);
+
+    return 1;
+}
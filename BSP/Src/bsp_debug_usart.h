@@ -0,0 +1,22 @@
+#ifndef BSP_DEBUG_USART_H
+#define BSP_DEBUG_USART_H
+
+#include "struct_typedef.h"
+#include "bsp_usart.h"
+
+/*
+  调试串口(USART1 921600)
+  发送: 遥测任务使用DMA2_Stream7发送遥测帧与调参应答
+  接收: DMA2_Stream2循环模式接收调参请求, 由遥测任务读取
+*/
+
+//调试串口接收初始化 buf_len需为2的幂
+extern void debug_usart_rx_init(uint8_t *buf, uint16_t buf_len);
+
+//获取调试串口接收对象 用于读取数据与查看接收统计
+extern usart_rx_t *get_debug_usart_rx_point(void);
+
+//调试串口DMA数据流中断处理 在DMA2_Stream2_IRQHandler中调用
+extern void debug_usart_dma_irq_handler(void);
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef BSP_DWT_H
+#define BSP_DWT_H
+
+#include "struct_typedef.h"
+
+/*
+  DWT周期计数器 用于测量代码执行时间
+  目标板: Cortex-M4 DWT->CYCCNT, 168MHz下约25.5s回绕一次, 差值用无符号减法即可跨越回绕
+  上位机: x86使用rdtsc, 其他平台使用clock_gettime(单位ns), 同一套测量代码可在上位机基准测试中使用
+*/
+
+#if defined(__CC_ARM) || defined(__ARMCC_VERSION) || defined(__arm__)
+
+#include "main.h"
+
+#define DWT_TARGET 1
+
+//读取周期计数
+static __inline uint32_t dwt_cycle_get(void)
+{
+    return DWT->CYCCNT;
+}
+
+#else
+
+#define DWT_TARGET 0
+
+#if defined(__x86_64__) || defined(__i386__)
+static inline uint32_t dwt_cycle_get(void)
+{
+    uint32_t lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    (void)hi;
+    return lo;
+}
+#else
+#include <time.h>
+static inline uint32_t dwt_cycle_get(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec);
+}
+#endif
+
+#endif
+
+/**
+  * @brief          使能DWT周期计数器 在调度器启动前调用一次
+  * @param[in]      none
+  * @retval         none
+  */
+extern void dwt_init(void);
+
+/**
+  * @brief          扩展为64位的周期计数, 可在中断中调用,
+  *                 两次调用间隔需小于一次回绕时间(任务切换时会调用, 满足该条件)
+  * @param[in]      none
+  * @retval         64位周期计数
+  */
+extern uint64_t dwt_cycle64_get(void);
+
+/**
+  * @brief          计数器频率 目标板为内核时钟 上位机为标定得到的频率
+  * @param[in]      none
+  * @retval         每秒计数值
+  */
+extern uint32_t dwt_get_freq(void);
+
+/**
+  * @brief          周期数换算为微秒
+  * @param[in]      cycles: 周期数
+  * @retval         微秒
+  */
+extern fp32 dwt_cycle_to_us(uint32_t cycles);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef BSP_FLASH_H
+#define BSP_FLASH_H
+
+#include "struct_typedef.h"
+#include "main.h"
+
+/*
+  内部flash擦写 用于参数存储
+  STM32F407单bank: 擦写期间CPU读取flash被暂停, 扇区擦除(128KB)约1~2s,
+  只能在机器人停止控制时调用; 写入电压范围按3.3V供电(按字写入)
+  擦除期间CPU停止, 不发送CAN控制帧, 电调保持最后收到的控制电流,
+  调用者需在擦除前让电机停止: param.c挂起调度器并用CAN_cmd_stop_all发送零电流后才擦除;
+  保存参数只在遥控器掉线或右拨杆在下时允许(tuning.c)
+  擦除期间独立看门狗超时临时加长到BSP_FLASH_ERASE_IWDG_MS, 擦除后控制任务错过截止时间, 软件看门狗进入安全状态后恢复
+*/
+
+#define BSP_FLASH_ERASE_IWDG_MS 4000u   //128KB扇区擦除最长约2s
+
+/**
+  * @brief          擦除扇区
+  * @param[in]      sector: FLASH_SECTOR_x
+  * @retval         1:成功 0:失败
+  */
+extern bool_t bsp_flash_erase_sector(uint32_t sector);
+
+/**
+  * @brief          写入一个字, 目标地址需已擦除
+  * @param[in]      address: 4字节对齐的地址
+  * @param[in]      data: 数据
+  * @retval         1:成功 0:失败
+  */
+extern bool_t bsp_flash_program_word(uint32_t address, uint32_t data);
+
+#endif
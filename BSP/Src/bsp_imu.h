@@ -0,0 +1,98 @@
+#ifndef BSP_IMU_H
+#define BSP_IMU_H
+
+#include "struct_typedef.h"
+
+/*
+  BMI088 SPI接口 寄存器级驱动SPI1与DMA2(工程中未包含HAL SPI模块)
+  SPI1: PB3 SCK, PB4 MISO, PA7 MOSI, 模式3, 84MHz/16 = 5.25MHz(BMI088最高10MHz)
+  片选: PA4 加速度计, PB0 陀螺仪
+  中断: PC5 陀螺仪INT3 上升沿 EXTI9_5
+  DMA:  DMA2 Stream0 通道3 SPI1_RX(Stream2已用于USART1_RX), DMA2 Stream3 通道3 SPI1_TX
+  读取: 先阻塞发送地址字节, 再由DMA收发其余字节(发送固定的0xFF), 完成后在DMA中断中拉高片选
+        等待超时(DMA中断未到)时调用bsp_imu_dma_abort中止, 否则之后的DMA读取一直返回0且片选保持低电平
+  上位机仿真中由Tools/sim/sim_bmi088.c实现本接口
+*/
+
+#define BSP_IMU_SPI_HZ 5250000u
+//DMA读取len字节所需时间 含地址字节
+#define BSP_IMU_TRANSFER_US(len) ((((uint32_t)(len) + 1u) * 8u * 1000000u + BSP_IMU_SPI_HZ - 1u) / BSP_IMU_SPI_HZ)
+
+typedef enum
+{
+    BSP_IMU_ACCEL = 0,
+    BSP_IMU_GYRO,
+} bsp_imu_cs_e;
+
+/*陀螺仪数据就绪中断回调 time_us为中断时间(bsp_imu_time_us时基)*/
+typedef void (*bsp_imu_int_callback_t)(uint32_t time_us);
+/*DMA读取完成回调 ok为0表示传输错误*/
+typedef void (*bsp_imu_dma_callback_t)(bool_t ok);
+
+/**
+  * @brief          初始化SPI1、DMA与中断引脚, 中断在bsp_imu_int_enable后才会触发
+  * @param[in]      int_callback: 数据就绪中断回调, 在中断中调用
+  * @param[in]      dma_callback: DMA读取完成回调, 在中断中调用
+  * @retval         none
+  */
+extern void bsp_imu_init(bsp_imu_int_callback_t int_callback, bsp_imu_dma_callback_t dma_callback);
+
+/**
+  * @brief          使能/关闭数据就绪中断
+  * @param[in]      enable: 1:使能
+  * @retval         none
+  */
+extern void bsp_imu_int_enable(bool_t enable);
+
+/**
+  * @brief          写一个寄存器 阻塞
+  * @param[in]      cs: 片选
+  * @param[in]      reg: 寄存器地址
+  * @param[in]      value: 值
+  * @retval         none
+  */
+extern void bsp_imu_write(bsp_imu_cs_e cs, uint8_t reg, uint8_t value);
+
+/**
+  * @brief          连续读寄存器 阻塞, 只用于短读取
+  * @param[in]      cs: 片选
+  * @param[in]      reg: 起始地址
+  * @param[out]     buf: 地址字节之后收到的len个字节(加速度计第一个为空字节)
+  * @param[in]      len: 长度
+  * @retval         none
+  */
+extern void bsp_imu_read(bsp_imu_cs_e cs, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+  * @brief          连续读寄存器 DMA, 完成后调用dma_callback, 期间不能调用其他读写函数
+  * @param[in]      cs: 片选
+  * @param[in]      reg: 起始地址
+  * @param[out]     buf: 地址字节之后收到的len个字节, 完成前不能访问
+  * @param[in]      len: 长度 1~65535
+  * @retval         1:已开始 0:上一次DMA读取未完成
+  */
+extern bool_t bsp_imu_read_dma(bsp_imu_cs_e cs, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+  * @brief          中止DMA读取: 关闭两个DMA流与SPI的DMA请求, 清除标志, 拉高两个片选
+  *                 等待DMA完成超时后调用, 不调用dma_callback, buf中的数据无效
+  * @param[in]      none
+  * @retval         none
+  */
+extern void bsp_imu_dma_abort(void);
+
+/**
+  * @brief          毫秒延时, 调度器启动后让出CPU
+  * @param[in]      ms: 延时
+  * @retval         none
+  */
+extern void bsp_imu_delay_ms(uint16_t ms);
+
+/**
+  * @brief          IMU时间戳时基 DWT周期计数换算, 约71分钟回绕
+  * @param[in]      none
+  * @retval         us
+  */
+extern uint32_t bsp_imu_time_us(void);
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef BSP_IWDG_H
+#define BSP_IWDG_H
+
+#include "struct_typedef.h"
+
+/*
+  独立看门狗 LSI(约32kHz)时钟, 32分频后每计数约1ms, 超时最长4095ms
+  一旦启动无法停止, 只能复位; 调试器暂停时冻结计数
+  LSI误差较大(17~47kHz), 实际超时约为设定值的0.7~1.9倍
+  由看门狗任务喂狗(见watchdog_task.c), 扇区擦除期间CPU暂停, 由bsp_flash临时加长超时
+*/
+
+#define IWDG_TIMEOUT_MAX_MS 4095u
+
+/**
+  * @brief          启动独立看门狗, 并记录上一次复位是否由独立看门狗引起
+  * @param[in]      timeout_ms: 超时时间 1~IWDG_TIMEOUT_MAX_MS
+  * @retval         none
+  */
+extern void iwdg_init(uint16_t timeout_ms);
+
+/**
+  * @brief          喂狗, 未启动时不处理
+  * @param[in]      none
+  * @retval         none
+  */
+extern void iwdg_feed(void);
+
+/**
+  * @brief          修改超时时间并喂狗, 用于已知的长时间阻塞操作, 之后恢复原超时, 未启动时不处理
+  * @param[in]      timeout_ms: 超时时间 1~IWDG_TIMEOUT_MAX_MS
+  * @retval         none
+  */
+extern void iwdg_timeout_set(uint16_t timeout_ms);
+
+/**
+  * @brief          当前超时时间
+  * @param[in]      none
+  * @retval         ms, 未启动时为0
+  */
+extern uint16_t iwdg_timeout_get(void);
+
+/**
+  * @brief          上一次复位是否由独立看门狗引起, iwdg_init之后有效
+  * @param[in]      none
+  * @retval         1:是 0:否
+  */
+extern bool_t iwdg_caused_reset(void);
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef BSP_LOCK_H
+#define BSP_LOCK_H
+
+#include "struct_typedef.h"
+
+/*
+  短临界区锁 用于只保护几个索引与计数的场合(消息总线、内存池), 任务与中断中均可调用
+  目标板: 单核 保存PRIMASK后关中断, 可嵌套, lock参数不使用
+  上位机: 每个对象一个自旋锁, 用于多线程压力测试, 持有者被抢占时让出CPU
+  临界区内不能调用RTOS接口, 不能等待
+*/
+
+#if defined(__CC_ARM) || defined(__ARMCC_VERSION) || defined(__arm__)
+
+#include "main.h"
+
+static __inline uint32_t bsp_lock(volatile uint8_t *lock)
+{
+    uint32_t primask = __get_PRIMASK();
+    (void)lock;
+    __disable_irq();
+    __DMB();
+    return primask;
+}
+
+static __inline void bsp_unlock(volatile uint8_t *lock, uint32_t key)
+{
+    (void)lock;
+    __DMB();
+    __set_PRIMASK(key);
+}
+
+#else
+
+#include <sched.h>
+
+static inline uint32_t bsp_lock(volatile uint8_t *lock)
+{
+    while (__atomic_test_and_set(lock, __ATOMIC_ACQUIRE))
+    {
+        sched_yield();
+    }
+    return 0;
+}
+
+static inline void bsp_unlock(volatile uint8_t *lock, uint32_t key)
+{
+    (void)key;
+    __atomic_clear(lock, __ATOMIC_RELEASE);
+}
+
+#endif
+
+#endif
@@ -2,8 +2,15 @@
 #define BSP_RC_H
 
 #include "struct_typedef.h"
+#include "bsp_usart.h"
 
-//定义外部函数 RC遥控初始化。
-extern void RC_init(uint8_t *rx1_buf, uint8_t *rx2_buf, uint16_t dma_buf_num); 
+//定义外部函数 RC遥控初始化。 rx_callback在串口空闲中断中调用
+extern void RC_init(uint8_t *rx1_buf, uint8_t *rx2_buf, uint16_t dma_buf_num, usart_rx_callback_t rx_callback);
+
+//获取遥控器串口接收对象 用于查看接收统计
+extern const usart_rx_t *get_RC_usart_rx_point(void);
+
+//遥控器DMA数据流中断处理 在DMA1_Stream1_IRQHandler中调用
+extern void RC_dma_irq_handler(void);
 
 #endif
@@ -0,0 +1,21 @@
+#ifndef BSP_REFEREE_USART_H
+#define BSP_REFEREE_USART_H
+
+#include "struct_typedef.h"
+#include "bsp_usart.h"
+
+/*
+  裁判系统串口(USART6 115200)
+  接收: DMA2_Stream1循环模式接收裁判系统数据流, 由裁判系统任务在缓冲区上直接解析
+*/
+
+//裁判系统串口接收初始化 buf_len需为2的幂
+extern void referee_usart_rx_init(uint8_t *buf, uint16_t buf_len);
+
+//获取裁判系统串口接收对象 用于读取数据与查看接收统计
+extern usart_rx_t *get_referee_usart_rx_point(void);
+
+//裁判系统串口DMA数据流中断处理 在DMA2_Stream1_IRQHandler中调用
+extern void referee_usart_dma_irq_handler(void);
+
+#endif
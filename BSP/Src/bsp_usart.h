@@ -0,0 +1,131 @@
+#ifndef BSP_USART_H
+#define BSP_USART_H
+
+#include "struct_typedef.h"
+#include "main.h"
+
+/*
+  串口DMA收发驱动 用于遥控器、裁判系统、视觉、调试串口等
+  双缓冲模式: DMA在两个缓冲区间切换, 每次空闲中断得到一帧完整数据, 适合定长帧(遥控器)
+  循环模式:   DMA写入环形缓冲区, 软件维护读指针, 适合不定长数据流(裁判系统、视觉)
+
+  使用方法:
+    1. 定义 usart_rx_t 对象和缓冲区, 调用 usart_rx_init
+    2. 在 USARTx_IRQHandler 中调用 usart_rx_irq_handler
+    3. 在 DMA数据流中断中调用 usart_rx_dma_irq_handler (用于检测缓冲区溢出)
+  循环模式的写位置在串口空闲中断与DMA过半/完成中断中都会更新, 更新在bsp_lock内进行,
+  两个中断的优先级不需要相同
+*/
+
+/*接收模式*/
+typedef enum
+{
+  USART_RX_DOUBLE_BUFFER = 0, //双缓冲
+  USART_RX_CIRCULAR,          //循环缓冲 软件读指针
+} usart_rx_mode_e;
+
+struct usart_rx_s;
+
+/**
+  * @brief          空闲中断回调, 在中断中调用, 应尽量短
+  * @param[in]      rx: 接收对象
+  * @param[in]      data: 双缓冲模式为接收完成的缓冲区; 循环模式为NULL
+  * @param[in]      len: 双缓冲模式为本帧长度; 循环模式为未读字节数
+  * @retval         none
+  */
+typedef void (*usart_rx_callback_t)(struct usart_rx_s *rx, const uint8_t *data, uint16_t len);
+
+/*串口DMA接收对象*/
+typedef struct usart_rx_s
+{
+  UART_HandleTypeDef *huart;
+  DMA_HandleTypeDef *hdma;
+  usart_rx_mode_e mode;
+  uint8_t *buf[2];              //循环模式只使用buf[0]
+  uint16_t buf_len;             //每个缓冲区长度
+  usart_rx_callback_t idle_callback;
+  void *user;                   //回调使用的用户数据
+
+  volatile uint8_t lock;        //循环模式 保护dma_last_pos与write_count的更新
+  uint16_t dma_last_pos;        //循环模式 上次记录的DMA写位置
+  volatile uint32_t write_count; //循环模式 DMA累计写入字节数
+  volatile uint32_t read_count;  //循环模式 软件累计读取字节数
+
+  uint32_t rx_bytes;            //累计接收字节数
+  uint32_t frame_count;         //空闲中断次数
+  uint32_t overflow_count;      //缓冲区溢出次数(帧超过缓冲区 或 读取不及时被覆盖)
+  uint32_t error_count;         //串口错误次数(ORE/FE/NE/PE)
+} usart_rx_t;
+
+/**
+  * @brief          初始化串口DMA接收
+  * @param[out]     rx: 接收对象
+  * @param[in]      huart: 串口句柄
+  * @param[in]      hdma: 串口对应的DMA接收句柄
+  * @param[in]      mode: 接收模式
+  * @param[in]      buf0: 缓冲区0
+  * @param[in]      buf1: 缓冲区1, 循环模式传NULL
+  * @param[in]      buf_len: 每个缓冲区长度
+  * @param[in]      idle_callback: 空闲中断回调, 可为NULL
+  * @param[in]      user: 用户数据
+  * @retval         none
+  */
+extern void usart_rx_init(usart_rx_t *rx, UART_HandleTypeDef *huart, DMA_HandleTypeDef *hdma, usart_rx_mode_e mode,
+                          uint8_t *buf0, uint8_t *buf1, uint16_t buf_len, usart_rx_callback_t idle_callback, void *user);
+
+/**
+  * @brief          串口中断处理, 在USARTx_IRQHandler中调用
+  * @param[in]      rx: 接收对象
+  * @retval         none
+  */
+extern void usart_rx_irq_handler(usart_rx_t *rx);
+
+/**
+  * @brief          DMA数据流中断处理(传输过半/完成), 在DMAx_Streamy_IRQHandler中调用
+  * @param[in]      rx: 接收对象
+  * @retval         none
+  */
+extern void usart_rx_dma_irq_handler(usart_rx_t *rx);
+
+/**
+  * @brief          循环模式 未读字节数
+  * @param[in]      rx: 接收对象
+  * @retval         未读字节数
+  */
+extern uint16_t usart_rx_available(usart_rx_t *rx);
+
+/**
+  * @brief          循环模式 获取一段连续的未读数据(不拷贝), 环形缓冲区回绕时需要调用两次
+  * @param[in]      rx: 接收对象
+  * @param[out]     data: 数据起始地址
+  * @retval         连续数据长度
+  */
+extern uint16_t usart_rx_peek(usart_rx_t *rx, const uint8_t **data);
+
+/**
+  * @brief          循环模式 标记已读取字节
+  * @param[in]      rx: 接收对象
+  * @param[in]      len: 已处理的字节数
+  * @retval         none
+  */
+extern void usart_rx_consume(usart_rx_t *rx, uint16_t len);
+
+/**
+  * @brief          串口DMA发送是否正在进行
+  * @param[in]      hdma: 串口对应的DMA发送句柄(普通模式)
+  * @retval         1:发送中 0:空闲
+  */
+extern bool_t usart_tx_dma_busy(DMA_HandleTypeDef *hdma);
+
+/**
+  * @brief          启动一次串口DMA发送, 不等待发送完成; 发送中时直接返回失败,
+  *                 发送完成前不能修改data内容
+  * @param[in]      huart: 串口句柄
+  * @param[in]      hdma: 串口对应的DMA发送句柄(普通模式)
+  * @param[in]      data: 发送数据
+  * @param[in]      len: 发送长度
+  * @retval         1:已启动 0:上一次发送未完成
+  */
+extern bool_t usart_tx_dma_start(UART_HandleTypeDef *huart, DMA_HandleTypeDef *hdma, const uint8_t *data, uint16_t len);
+
+#endif
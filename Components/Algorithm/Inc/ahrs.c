@@ -0,0 +1,406 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       ahrs.c/h
+  * @brief      姿态解算，Mahony互补滤波与四元数扩展卡尔曼滤波。
+  * @note       卡尔曼滤波状态转移矩阵 F = [A B; 0 I]，A = I + dt/2*Omega(w - b)，B = -dt/2*Xi(q)，
+  *             协方差按分块计算: M = A*Pqq + B*Pbq, N = A*Pqb + B*Pbb,
+  *             Pqq' = M*A' + N*B' + Qq, Pqb' = N, Pbb' = Pbb + Qb，
+  *             四元数过程噪声 Qq = (dt/2)^2*gyro_noise^2*Xi*Xi' = q_quat*(I - q*q')。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    加速度计观测: h(q) = R(q)'*[0 0 1]' 与归一化的加速度计比较
+    磁力计观测: 磁场转到导航系后的水平方向与x轴的夹角 h(q) = atan2(ny, nx), 观测值为0,
+               观测矩阵对整个四元数求导, 磁倾角较大时横滚俯仰误差引起的偏航误差由滤波器自己分配,
+               只按偏航求导时该误差会经零偏反馈到横滚俯仰, 加速度计噪声设得较大时发散
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#include <stddef.h>
+#include <string.h>
+#include "fast_math.h"
+#include "ahrs.h"
+
+#define AHRS_N AHRS_EKF_STATE_NUM
+
+#define AHRS_EKF_QUAT_INIT  0.25f   //四元数初始方差 未对准时
+#define AHRS_MAG_MIN_RATIO  0.1f    //磁场水平分量与模长之比小于该值时不修正偏航
+
+static void ahrs_quat_normalize(fp32 q[4])
+{
+    fp32 inv = fast_inv_sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+
+    q[0] *= inv;
+    q[1] *= inv;
+    q[2] *= inv;
+    q[3] *= inv;
+}
+
+//导航系向上的单位向量在机体系中的表示 R(q)'*[0 0 1]'
+static void ahrs_up_body(const fp32 q[4], fp32 v[3])
+{
+    v[0] = 2.0f * (q[1] * q[3] - q[0] * q[2]);
+    v[1] = 2.0f * (q[2] * q[3] + q[0] * q[1]);
+    v[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+}
+
+//加速度计归一化 模长超出门限返回0
+static bool_t ahrs_accel_direction(const fp32 accel[3], fp32 gate, fp32 a[3])
+{
+    fp32 norm2 = accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2];
+    fp32 inv;
+    fp32 norm;
+
+    if (norm2 <= 0.0f)
+    {
+        return 0;
+    }
+    inv = fast_inv_sqrt(norm2);
+    norm = norm2 * inv;
+    if (norm - AHRS_GRAVITY > gate || AHRS_GRAVITY - norm > gate)
+    {
+        return 0;
+    }
+    a[0] = accel[0] * inv;
+    a[1] = accel[1] * inv;
+    a[2] = accel[2] * inv;
+    return 1;
+}
+
+//磁场转到导航系后的水平分量 R(q)*mag 的x y 水平分量太小时返回0
+static bool_t ahrs_mag_horizontal(const fp32 q[4], const fp32 mag[3], fp32 n[2])
+{
+    fp32 norm2 = mag[0] * mag[0] + mag[1] * mag[1] + mag[2] * mag[2];
+
+    n[0] = (1.0f - 2.0f * (q[2] * q[2] + q[3] * q[3])) * mag[0] + 2.0f * (q[1] * q[2] - q[0] * q[3]) * mag[1] +
+           2.0f * (q[1] * q[3] + q[0] * q[2]) * mag[2];
+    n[1] = 2.0f * (q[1] * q[2] + q[0] * q[3]) * mag[0] + (1.0f - 2.0f * (q[1] * q[1] + q[3] * q[3])) * mag[1] +
+           2.0f * (q[2] * q[3] - q[0] * q[1]) * mag[2];
+    return norm2 > 0.0f && n[0] * n[0] + n[1] * n[1] > AHRS_MAG_MIN_RATIO * AHRS_MAG_MIN_RATIO * norm2;
+}
+
+//偏航误差: 磁场水平方向与x轴(磁北)的夹角取反 即真实偏航 - 估计偏航
+static bool_t ahrs_mag_yaw_error(const fp32 q[4], const fp32 mag[3], fp32 *error)
+{
+    fp32 n[2];
+
+    if (!ahrs_mag_horizontal(q, mag, n))
+    {
+        return 0;
+    }
+    *error = -fast_atan2_precise(n[1], n[0]);
+    return 1;
+}
+
+//ZYX欧拉角转四元数
+static void ahrs_euler_to_quat(fp32 yaw, fp32 pitch, fp32 roll, fp32 q[4])
+{
+    fp32 sy, cy, sp, cp, sr, cr;
+
+    fast_sin_cos(0.5f * yaw, &sy, &cy);
+    fast_sin_cos(0.5f * pitch, &sp, &cp);
+    fast_sin_cos(0.5f * roll, &sr, &cr);
+    q[0] = cr * cp * cy + sr * sp * sy;
+    q[1] = sr * cp * cy - cr * sp * sy;
+    q[2] = cr * sp * cy + sr * cp * sy;
+    q[3] = cr * cp * sy - sr * sp * cy;
+    ahrs_quat_normalize(q);
+}
+
+void ahrs_align(fp32 q[4], const fp32 accel[3], const fp32 *mag)
+{
+    fp32 roll = fast_atan2_precise(accel[1], accel[2]);
+    fp32 pitch = fast_atan2_precise(-accel[0], fast_sqrt(accel[1] * accel[1] + accel[2] * accel[2]));
+    fp32 yaw = 0.0f;
+
+    ahrs_euler_to_quat(0.0f, pitch, roll, q);
+    if (mag != NULL && ahrs_mag_yaw_error(q, mag, &yaw))
+    {
+        ahrs_euler_to_quat(yaw, pitch, roll, q);
+    }
+}
+
+void ahrs_euler(const fp32 q[4], fp32 euler[3])
+{
+    fp32 sin_pitch = 2.0f * (q[0] * q[2] - q[1] * q[3]);
+
+    if (sin_pitch > 1.0f)
+    {
+        sin_pitch = 1.0f;
+    }
+    else if (sin_pitch < -1.0f)
+    {
+        sin_pitch = -1.0f;
+    }
+    euler[AHRS_YAW] = fast_atan2_precise(2.0f * (q[0] * q[3] + q[1] * q[2]), 1.0f - 2.0f * (q[2] * q[2] + q[3] * q[3]));
+    euler[AHRS_PITCH] = fast_atan2_precise(sin_pitch, fast_sqrt(1.0f - sin_pitch * sin_pitch));
+    euler[AHRS_ROLL] = fast_atan2_precise(2.0f * (q[0] * q[1] + q[2] * q[3]), 1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2]));
+}
+
+/*----------Mahony----------*/
+
+void ahrs_mahony_init(ahrs_mahony_t *mahony, fp32 kp, fp32 ki, fp32 dt, fp32 accel_gate)
+{
+    memset(mahony, 0, sizeof(ahrs_mahony_t));
+    mahony->q[0] = 1.0f;
+    mahony->kp = kp;
+    mahony->ki_dt = ki * dt;
+    mahony->half_dt = 0.5f * dt;
+    mahony->accel_gate = accel_gate;
+}
+
+void ahrs_mahony_update(ahrs_mahony_t *mahony, const fp32 gyro[3], const fp32 *accel, const fp32 *mag)
+{
+    fp32 *q = mahony->q;
+    fp32 e[3] = {0.0f, 0.0f, 0.0f};
+    fp32 a[3];
+    fp32 v[3];
+    fp32 w[3];
+    fp32 yaw_error;
+    fp32 q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+
+    //误差 = 测量方向 x 估计方向
+    ahrs_up_body(q, v);
+    if (accel != NULL)
+    {
+        if (ahrs_accel_direction(accel, mahony->accel_gate, a))
+        {
+            e[0] = a[1] * v[2] - a[2] * v[1];
+            e[1] = a[2] * v[0] - a[0] * v[2];
+            e[2] = a[0] * v[1] - a[1] * v[0];
+        }
+        else
+        {
+            mahony->accel_reject_count++;
+        }
+    }
+    //偏航误差绕导航系z轴修正
+    if (mag != NULL && ahrs_mag_yaw_error(q, mag, &yaw_error))
+    {
+        e[0] += yaw_error * v[0];
+        e[1] += yaw_error * v[1];
+        e[2] += yaw_error * v[2];
+    }
+
+    mahony->integral[0] += mahony->ki_dt * e[0];
+    mahony->integral[1] += mahony->ki_dt * e[1];
+    mahony->integral[2] += mahony->ki_dt * e[2];
+    w[0] = (gyro[0] + mahony->kp * e[0] + mahony->integral[0]) * mahony->half_dt;
+    w[1] = (gyro[1] + mahony->kp * e[1] + mahony->integral[1]) * mahony->half_dt;
+    w[2] = (gyro[2] + mahony->kp * e[2] + mahony->integral[2]) * mahony->half_dt;
+
+    //q += dt/2 * q x [0 w]
+    q[0] += -q1 * w[0] - q2 * w[1] - q3 * w[2];
+    q[1] += q0 * w[0] + q2 * w[2] - q3 * w[1];
+    q[2] += q0 * w[1] - q1 * w[2] + q3 * w[0];
+    q[3] += q0 * w[2] + q1 * w[1] - q2 * w[0];
+    ahrs_quat_normalize(q);
+}
+
+/*----------四元数扩展卡尔曼滤波----------*/
+
+void ahrs_ekf_init(ahrs_ekf_t *ekf, const ahrs_ekf_param_t *param, fp32 dt)
+{
+    uint8_t i;
+
+    memset(ekf, 0, sizeof(ahrs_ekf_t));
+    ekf->x[0] = 1.0f;
+    for (i = 0; i < 4u; i++)
+    {
+        ekf->P[i][i] = AHRS_EKF_QUAT_INIT;
+    }
+    for (i = 4; i < AHRS_N; i++)
+    {
+        ekf->P[i][i] = param->gyro_bias_init * param->gyro_bias_init;
+    }
+
+    ekf->half_dt = 0.5f * dt;
+    ekf->q_quat = ekf->half_dt * ekf->half_dt * param->gyro_noise * param->gyro_noise;
+    ekf->q_bias = param->gyro_bias_walk * param->gyro_bias_walk * dt;
+    ekf->r_accel = param->accel_noise * param->accel_noise;
+    ekf->r_mag = param->mag_noise * param->mag_noise;
+    ekf->accel_gate = param->accel_gate;
+}
+
+static void ahrs_ekf_predict(ahrs_ekf_t *ekf, const fp32 gyro[3])
+{
+    fp32 (*P)[AHRS_N] = ekf->P;
+    fp32 *q = ekf->x;
+    fp32 A[4][4];
+    fp32 B[4][3];
+    fp32 M[4][4];
+    fp32 N[4][3];
+    fp32 wx = (gyro[0] - ekf->x[4]) * ekf->half_dt;
+    fp32 wy = (gyro[1] - ekf->x[5]) * ekf->half_dt;
+    fp32 wz = (gyro[2] - ekf->x[6]) * ekf->half_dt;
+    fp32 h = ekf->half_dt;
+    fp32 qn[4];
+    fp32 sum;
+    uint8_t i, j, k;
+
+    //A = I + dt/2*Omega(w)
+    A[0][0] = 1.0f; A[0][1] = -wx;  A[0][2] = -wy;  A[0][3] = -wz;
+    A[1][0] = wx;   A[1][1] = 1.0f; A[1][2] = wz;   A[1][3] = -wy;
+    A[2][0] = wy;   A[2][1] = -wz;  A[2][2] = 1.0f; A[2][3] = wx;
+    A[3][0] = wz;   A[3][1] = wy;   A[3][2] = -wx;  A[3][3] = 1.0f;
+    //B = -dt/2*Xi(q)
+    B[0][0] = h * q[1];  B[0][1] = h * q[2];  B[0][2] = h * q[3];
+    B[1][0] = -h * q[0]; B[1][1] = h * q[3];  B[1][2] = -h * q[2];
+    B[2][0] = -h * q[3]; B[2][1] = -h * q[0]; B[2][2] = h * q[1];
+    B[3][0] = h * q[2];  B[3][1] = -h * q[1]; B[3][2] = -h * q[0];
+
+    //M = A*Pqq + B*Pbq  N = A*Pqb + B*Pbb
+    for (i = 0; i < 4u; i++)
+    {
+        for (j = 0; j < AHRS_N; j++)
+        {
+            sum = A[i][0] * P[0][j] + A[i][1] * P[1][j] + A[i][2] * P[2][j] + A[i][3] * P[3][j] +
+                  B[i][0] * P[4][j] + B[i][1] * P[5][j] + B[i][2] * P[6][j];
+            if (j < 4u)
+            {
+                M[i][j] = sum;
+            }
+            else
+            {
+                N[i][j - 4u] = sum;
+            }
+        }
+    }
+
+    //状态
+    for (i = 0; i < 4u; i++)
+    {
+        qn[i] = A[i][0] * q[0] + A[i][1] * q[1] + A[i][2] * q[2] + A[i][3] * q[3];
+    }
+
+    //Pqq = M*A' + N*B' + q_quat*(I - q*q') 只算上三角
+    for (i = 0; i < 4u; i++)
+    {
+        for (j = i; j < 4u; j++)
+        {
+            sum = 0.0f;
+            for (k = 0; k < 4u; k++)
+            {
+                sum += M[i][k] * A[j][k];
+            }
+            for (k = 0; k < 3u; k++)
+            {
+                sum += N[i][k] * B[j][k];
+            }
+            sum -= ekf->q_quat * q[i] * q[j];
+            if (i == j)
+            {
+                sum += ekf->q_quat;
+            }
+            P[i][j] = sum;
+            P[j][i] = sum;
+        }
+    }
+    for (i = 0; i < 4u; i++)
+    {
+        for (j = 0; j < 3u; j++)
+        {
+            P[i][j + 4u] = N[i][j];
+            P[j + 4u][i] = N[i][j];
+        }
+    }
+    P[4][4] += ekf->q_bias;
+    P[5][5] += ekf->q_bias;
+    P[6][6] += ekf->q_bias;
+
+    memcpy(q, qn, sizeof(qn));
+    ahrs_quat_normalize(q);
+}
+
+//标量观测更新 观测矩阵只有四元数部分 H = [h 0 0 0]
+static void ahrs_ekf_scalar_update(ahrs_ekf_t *ekf, const fp32 h[4], fp32 innovation, fp32 r)
+{
+    fp32 (*P)[AHRS_N] = ekf->P;
+    fp32 PHt[AHRS_N];
+    fp32 s;
+    fp32 inv_s;
+    fp32 k;
+    uint8_t i, j;
+
+    for (i = 0; i < AHRS_N; i++)
+    {
+        PHt[i] = P[i][0] * h[0] + P[i][1] * h[1] + P[i][2] * h[2] + P[i][3] * h[3];
+    }
+    s = h[0] * PHt[0] + h[1] * PHt[1] + h[2] * PHt[2] + h[3] * PHt[3] + r;
+    inv_s = 1.0f / s;
+
+    //x += K*inn  P -= K*PHt' = PHt*PHt'/s 对称 只算上三角
+    for (i = 0; i < AHRS_N; i++)
+    {
+        k = PHt[i] * inv_s;
+        ekf->x[i] += k * innovation;
+        for (j = i; j < AHRS_N; j++)
+        {
+            P[i][j] -= k * PHt[j];
+            P[j][i] = P[i][j];
+        }
+    }
+}
+
+void ahrs_ekf_update(ahrs_ekf_t *ekf, const fp32 gyro[3], const fp32 *accel, const fp32 *mag)
+{
+    fp32 a[3];
+    fp32 v[3];
+    fp32 q0[4];
+    fp32 H[3][4];
+    fp32 h[4];
+    fp32 n[2];
+    fp32 dnx[4];
+    fp32 inv;
+    fp32 innovation;
+    fp32 *q = ekf->x;
+    uint8_t i;
+
+    ahrs_ekf_predict(ekf, gyro);
+
+    if (accel != NULL)
+    {
+        if (ahrs_accel_direction(accel, ekf->accel_gate, a))
+        {
+            //在预测值处线性化 依次更新三个分量
+            memcpy(q0, q, sizeof(q0));
+            ahrs_up_body(q0, v);
+            H[0][0] = -2.0f * q0[2]; H[0][1] = 2.0f * q0[3];  H[0][2] = -2.0f * q0[0]; H[0][3] = 2.0f * q0[1];
+            H[1][0] = 2.0f * q0[1];  H[1][1] = 2.0f * q0[0];  H[1][2] = 2.0f * q0[3];  H[1][3] = 2.0f * q0[2];
+            H[2][0] = 2.0f * q0[0];  H[2][1] = -2.0f * q0[1]; H[2][2] = -2.0f * q0[2]; H[2][3] = 2.0f * q0[3];
+            for (i = 0; i < 3u; i++)
+            {
+                innovation = a[i] - v[i] - H[i][0] * (q[0] - q0[0]) - H[i][1] * (q[1] - q0[1]) -
+                             H[i][2] * (q[2] - q0[2]) - H[i][3] * (q[3] - q0[3]);
+                ahrs_ekf_scalar_update(ekf, H[i], innovation, ekf->r_accel);
+            }
+        }
+        else
+        {
+            ekf->accel_reject_count++;
+        }
+    }
+
+    //观测 h(q) = atan2(ny, nx) = 0, n = R(q)*mag, 新息 = -h(q)
+    //R(q)按 w^2+x^2-y^2-z^2 的齐次形式求导, h与四元数模长无关 H*q = 0
+    if (mag != NULL && ahrs_mag_horizontal(q, mag, n))
+    {
+        dnx[0] = q[0] * mag[0] - q[3] * mag[1] + q[2] * mag[2];
+        dnx[1] = q[1] * mag[0] + q[2] * mag[1] + q[3] * mag[2];
+        dnx[2] = -q[2] * mag[0] + q[1] * mag[1] + q[0] * mag[2];
+        dnx[3] = -q[3] * mag[0] - q[0] * mag[1] + q[1] * mag[2];
+        //dnx dny为导数的一半 dny = [-dnx[3] -dnx[2] dnx[1] dnx[0]]
+        inv = 2.0f / (n[0] * n[0] + n[1] * n[1]);
+        h[0] = (n[0] * -dnx[3] - n[1] * dnx[0]) * inv;
+        h[1] = (n[0] * -dnx[2] - n[1] * dnx[1]) * inv;
+        h[2] = (n[0] * dnx[1] - n[1] * dnx[2]) * inv;
+        h[3] = (n[0] * dnx[0] - n[1] * dnx[3]) * inv;
+        ahrs_ekf_scalar_update(ekf, h, -fast_atan2_precise(n[1], n[0]), ekf->r_mag);
+    }
+
+    ahrs_quat_normalize(q);
+}
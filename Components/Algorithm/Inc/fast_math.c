@@ -0,0 +1,450 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       fast_math.c/h
+  * @brief      快速数学函数库，提供查表法与极小极大(minimax)多项式两种实现的
+  *             sin/cos/atan2/sqrt，用于控制环、坐标旋转、编码器角度换算、姿态解算。
+  * @note       不依赖libm，无静态状态，可在中断中调用。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.0.1     Oct-19-2026     ICBK            2. sin/cos只做一次象限规约, cos由象限平移得到;
+  *                                                超范围与非有限输入不再做浮点转整数
+  *
+  @verbatim
+  ==============================================================================
+    多项式系数由Remez算法在规约区间上求得:
+      sin  : [0, PI/2] 奇次多项式 5阶/7阶
+      atan : [0, 1]    奇次多项式 7阶/11阶
+    sin/cos范围规约: x = n*PI/2 + r, r在[-PI/4, PI/4]，
+      sin(r)直接求值, cos(r) = sin(PI/2 - |r|)，再按象限n&3交换、取反;
+      cos(x) = sin(x + PI/2) 即象限加1, 不再对x加PI/2
+    查表法: sin表512点(整周)，atan表128点([0,1])，均做线性插值，cos取表索引加四分之一周期
+    |x| >= 1e7 rad(单精度分辨率已达1 rad)或inf/NaN时按x=0处理
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include "fast_math.h"
+
+#define HALF_PI         1.57079632679490f
+#define INV_TWO_PI      0.159154943091895f
+#define INV_HALF_PI     0.636619772367581f
+//PI/2拆成高低两部分, 范围规约时减小舍入误差, 高位只有8位有效位 n*HALF_PI_HI在|n|<65536时无舍入
+#define HALF_PI_HI      1.5703125f
+#define HALF_PI_LO      4.83826794896619e-4f
+//规约的输入范围, 超出时浮点转int32_t可能溢出(未定义行为)
+#define ANGLE_LIMIT     1.0e7f
+
+#define SIN_LUT_SIZE    512u
+#define SIN_LUT_MASK    (SIN_LUT_SIZE - 1u)
+#define SIN_LUT_QUARTER (SIN_LUT_SIZE / 4u)
+#define ATAN_LUT_SIZE   128u
+
+//sin(2*PI*i/512), 多一个点方便插值
+static const fp32 sin_lut[SIN_LUT_SIZE + 1] =
+{
+    0.000000000e+00f, 1.227153829e-02f, 2.454122852e-02f, 3.680722294e-02f, 4.906767433e-02f, 6.132073630e-02f,
+    7.356456360e-02f, 8.579731234e-02f, 9.801714033e-02f, 1.102222073e-01f, 1.224106752e-01f, 1.345807085e-01f,
+    1.467304745e-01f, 1.588581433e-01f, 1.709618888e-01f, 1.830398880e-01f, 1.950903220e-01f, 2.071113762e-01f,
+    2.191012402e-01f, 2.310581083e-01f, 2.429801799e-01f, 2.548656596e-01f, 2.667127575e-01f, 2.785196894e-01f,
+    2.902846773e-01f, 3.020059493e-01f, 3.136817404e-01f, 3.253102922e-01f, 3.368898534e-01f, 3.484186802e-01f,
+    3.598950365e-01f, 3.713171940e-01f, 3.826834324e-01f, 3.939920401e-01f, 4.052413140e-01f, 4.164295601e-01f,
+    4.275550934e-01f, 4.386162385e-01f, 4.496113297e-01f, 4.605387110e-01f, 4.713967368e-01f, 4.821837721e-01f,
+    4.928981922e-01f, 5.035383837e-01f, 5.141027442e-01f, 5.245896827e-01f, 5.349976199e-01f, 5.453249884e-01f,
+    5.555702330e-01f, 5.657318108e-01f, 5.758081914e-01f, 5.857978575e-01f, 5.956993045e-01f, 6.055110414e-01f,
+    6.152315906e-01f, 6.248594881e-01f, 6.343932842e-01f, 6.438315429e-01f, 6.531728430e-01f, 6.624157776e-01f,
+    6.715589548e-01f, 6.806009978e-01f, 6.895405447e-01f, 6.983762494e-01f, 7.071067812e-01f, 7.157308253e-01f,
+    7.242470830e-01f, 7.326542717e-01f, 7.409511254e-01f, 7.491363945e-01f, 7.572088465e-01f, 7.651672656e-01f,
+    7.730104534e-01f, 7.807372286e-01f, 7.883464276e-01f, 7.958369046e-01f, 8.032075315e-01f, 8.104571983e-01f,
+    8.175848132e-01f, 8.245893028e-01f, 8.314696123e-01f, 8.382247056e-01f, 8.448535652e-01f, 8.513551931e-01f,
+    8.577286100e-01f, 8.639728561e-01f, 8.700869911e-01f, 8.760700942e-01f, 8.819212643e-01f, 8.876396204e-01f,
+    8.932243012e-01f, 8.986744657e-01f, 9.039892931e-01f, 9.091679831e-01f, 9.142097557e-01f, 9.191138517e-01f,
+    9.238795325e-01f, 9.285060805e-01f, 9.329927988e-01f, 9.373390119e-01f, 9.415440652e-01f, 9.456073254e-01f,
+    9.495281806e-01f, 9.533060404e-01f, 9.569403357e-01f, 9.604305194e-01f, 9.637760658e-01f, 9.669764710e-01f,
+    9.700312532e-01f, 9.729399522e-01f, 9.757021300e-01f, 9.783173707e-01f, 9.807852804e-01f, 9.831054874e-01f,
+    9.852776424e-01f, 9.873014182e-01f, 9.891765100e-01f, 9.909026354e-01f, 9.924795346e-01f, 9.939069700e-01f,
+    9.951847267e-01f, 9.963126122e-01f, 9.972904567e-01f, 9.981181129e-01f, 9.987954562e-01f, 9.993223846e-01f,
+    9.996988187e-01f, 9.999247018e-01f, 1.000000000e+00f, 9.999247018e-01f, 9.996988187e-01f, 9.993223846e-01f,
+    9.987954562e-01f, 9.981181129e-01f, 9.972904567e-01f, 9.963126122e-01f, 9.951847267e-01f, 9.939069700e-01f,
+    9.924795346e-01f, 9.909026354e-01f, 9.891765100e-01f, 9.873014182e-01f, 9.852776424e-01f, 9.831054874e-01f,
+    9.807852804e-01f, 9.783173707e-01f, 9.757021300e-01f, 9.729399522e-01f, 9.700312532e-01f, 9.669764710e-01f,
+    9.637760658e-01f, 9.604305194e-01f, 9.569403357e-01f, 9.533060404e-01f, 9.495281806e-01f, 9.456073254e-01f,
+    9.415440652e-01f, 9.373390119e-01f, 9.329927988e-01f, 9.285060805e-01f, 9.238795325e-01f, 9.191138517e-01f,
+    9.142097557e-01f, 9.091679831e-01f, 9.039892931e-01f, 8.986744657e-01f, 8.932243012e-01f, 8.876396204e-01f,
+    8.819212643e-01f, 8.760700942e-01f, 8.700869911e-01f, 8.639728561e-01f, 8.577286100e-01f, 8.513551931e-01f,
+    8.448535652e-01f, 8.382247056e-01f, 8.314696123e-01f, 8.245893028e-01f, 8.175848132e-01f, 8.104571983e-01f,
+    8.032075315e-01f, 7.958369046e-01f, 7.883464276e-01f, 7.807372286e-01f, 7.730104534e-01f, 7.651672656e-01f,
+    7.572088465e-01f, 7.491363945e-01f, 7.409511254e-01f, 7.326542717e-01f, 7.242470830e-01f, 7.157308253e-01f,
+    7.071067812e-01f, 6.983762494e-01f, 6.895405447e-01f, 6.806009978e-01f, 6.715589548e-01f, 6.624157776e-01f,
+    6.531728430e-01f, 6.438315429e-01f, 6.343932842e-01f, 6.248594881e-01f, 6.152315906e-01f, 6.055110414e-01f,
+    5.956993045e-01f, 5.857978575e-01f, 5.758081914e-01f, 5.657318108e-01f, 5.555702330e-01f, 5.453249884e-01f,
+    5.349976199e-01f, 5.245896827e-01f, 5.141027442e-01f, 5.035383837e-01f, 4.928981922e-01f, 4.821837721e-01f,
+    4.713967368e-01f, 4.605387110e-01f, 4.496113297e-01f, 4.386162385e-01f, 4.275550934e-01f, 4.164295601e-01f,
+    4.052413140e-01f, 3.939920401e-01f, 3.826834324e-01f, 3.713171940e-01f, 3.598950365e-01f, 3.484186802e-01f,
+    3.368898534e-01f, 3.253102922e-01f, 3.136817404e-01f, 3.020059493e-01f, 2.902846773e-01f, 2.785196894e-01f,
+    2.667127575e-01f, 2.548656596e-01f, 2.429801799e-01f, 2.310581083e-01f, 2.191012402e-01f, 2.071113762e-01f,
+    1.950903220e-01f, 1.830398880e-01f, 1.709618888e-01f, 1.588581433e-01f, 1.467304745e-01f, 1.345807085e-01f,
+    1.224106752e-01f, 1.102222073e-01f, 9.801714033e-02f, 8.579731234e-02f, 7.356456360e-02f, 6.132073630e-02f,
+    4.906767433e-02f, 3.680722294e-02f, 2.454122852e-02f, 1.227153829e-02f, 1.224646799e-16f, -1.227153829e-02f,
+    -2.454122852e-02f, -3.680722294e-02f, -4.906767433e-02f, -6.132073630e-02f, -7.356456360e-02f, -8.579731234e-02f,
+    -9.801714033e-02f, -1.102222073e-01f, -1.224106752e-01f, -1.345807085e-01f, -1.467304745e-01f, -1.588581433e-01f,
+    -1.709618888e-01f, -1.830398880e-01f, -1.950903220e-01f, -2.071113762e-01f, -2.191012402e-01f, -2.310581083e-01f,
+    -2.429801799e-01f, -2.548656596e-01f, -2.667127575e-01f, -2.785196894e-01f, -2.902846773e-01f, -3.020059493e-01f,
+    -3.136817404e-01f, -3.253102922e-01f, -3.368898534e-01f, -3.484186802e-01f, -3.598950365e-01f, -3.713171940e-01f,
+    -3.826834324e-01f, -3.939920401e-01f, -4.052413140e-01f, -4.164295601e-01f, -4.275550934e-01f, -4.386162385e-01f,
+    -4.496113297e-01f, -4.605387110e-01f, -4.713967368e-01f, -4.821837721e-01f, -4.928981922e-01f, -5.035383837e-01f,
+    -5.141027442e-01f, -5.245896827e-01f, -5.349976199e-01f, -5.453249884e-01f, -5.555702330e-01f, -5.657318108e-01f,
+    -5.758081914e-01f, -5.857978575e-01f, -5.956993045e-01f, -6.055110414e-01f, -6.152315906e-01f, -6.248594881e-01f,
+    -6.343932842e-01f, -6.438315429e-01f, -6.531728430e-01f, -6.624157776e-01f, -6.715589548e-01f, -6.806009978e-01f,
+    -6.895405447e-01f, -6.983762494e-01f, -7.071067812e-01f, -7.157308253e-01f, -7.242470830e-01f, -7.326542717e-01f,
+    -7.409511254e-01f, -7.491363945e-01f, -7.572088465e-01f, -7.651672656e-01f, -7.730104534e-01f, -7.807372286e-01f,
+    -7.883464276e-01f, -7.958369046e-01f, -8.032075315e-01f, -8.104571983e-01f, -8.175848132e-01f, -8.245893028e-01f,
+    -8.314696123e-01f, -8.382247056e-01f, -8.448535652e-01f, -8.513551931e-01f, -8.577286100e-01f, -8.639728561e-01f,
+    -8.700869911e-01f, -8.760700942e-01f, -8.819212643e-01f, -8.876396204e-01f, -8.932243012e-01f, -8.986744657e-01f,
+    -9.039892931e-01f, -9.091679831e-01f, -9.142097557e-01f, -9.191138517e-01f, -9.238795325e-01f, -9.285060805e-01f,
+    -9.329927988e-01f, -9.373390119e-01f, -9.415440652e-01f, -9.456073254e-01f, -9.495281806e-01f, -9.533060404e-01f,
+    -9.569403357e-01f, -9.604305194e-01f, -9.637760658e-01f, -9.669764710e-01f, -9.700312532e-01f, -9.729399522e-01f,
+    -9.757021300e-01f, -9.783173707e-01f, -9.807852804e-01f, -9.831054874e-01f, -9.852776424e-01f, -9.873014182e-01f,
+    -9.891765100e-01f, -9.909026354e-01f, -9.924795346e-01f, -9.939069700e-01f, -9.951847267e-01f, -9.963126122e-01f,
+    -9.972904567e-01f, -9.981181129e-01f, -9.987954562e-01f, -9.993223846e-01f, -9.996988187e-01f, -9.999247018e-01f,
+    -1.000000000e+00f, -9.999247018e-01f, -9.996988187e-01f, -9.993223846e-01f, -9.987954562e-01f, -9.981181129e-01f,
+    -9.972904567e-01f, -9.963126122e-01f, -9.951847267e-01f, -9.939069700e-01f, -9.924795346e-01f, -9.909026354e-01f,
+    -9.891765100e-01f, -9.873014182e-01f, -9.852776424e-01f, -9.831054874e-01f, -9.807852804e-01f, -9.783173707e-01f,
+    -9.757021300e-01f, -9.729399522e-01f, -9.700312532e-01f, -9.669764710e-01f, -9.637760658e-01f, -9.604305194e-01f,
+    -9.569403357e-01f, -9.533060404e-01f, -9.495281806e-01f, -9.456073254e-01f, -9.415440652e-01f, -9.373390119e-01f,
+    -9.329927988e-01f, -9.285060805e-01f, -9.238795325e-01f, -9.191138517e-01f, -9.142097557e-01f, -9.091679831e-01f,
+    -9.039892931e-01f, -8.986744657e-01f, -8.932243012e-01f, -8.876396204e-01f, -8.819212643e-01f, -8.760700942e-01f,
+    -8.700869911e-01f, -8.639728561e-01f, -8.577286100e-01f, -8.513551931e-01f, -8.448535652e-01f, -8.382247056e-01f,
+    -8.314696123e-01f, -8.245893028e-01f, -8.175848132e-01f, -8.104571983e-01f, -8.032075315e-01f, -7.958369046e-01f,
+    -7.883464276e-01f, -7.807372286e-01f, -7.730104534e-01f, -7.651672656e-01f, -7.572088465e-01f, -7.491363945e-01f,
+    -7.409511254e-01f, -7.326542717e-01f, -7.242470830e-01f, -7.157308253e-01f, -7.071067812e-01f, -6.983762494e-01f,
+    -6.895405447e-01f, -6.806009978e-01f, -6.715589548e-01f, -6.624157776e-01f, -6.531728430e-01f, -6.438315429e-01f,
+    -6.343932842e-01f, -6.248594881e-01f, -6.152315906e-01f, -6.055110414e-01f, -5.956993045e-01f, -5.857978575e-01f,
+    -5.758081914e-01f, -5.657318108e-01f, -5.555702330e-01f, -5.453249884e-01f, -5.349976199e-01f, -5.245896827e-01f,
+    -5.141027442e-01f, -5.035383837e-01f, -4.928981922e-01f, -4.821837721e-01f, -4.713967368e-01f, -4.605387110e-01f,
+    -4.496113297e-01f, -4.386162385e-01f, -4.275550934e-01f, -4.164295601e-01f, -4.052413140e-01f, -3.939920401e-01f,
+    -3.826834324e-01f, -3.713171940e-01f, -3.598950365e-01f, -3.484186802e-01f, -3.368898534e-01f, -3.253102922e-01f,
+    -3.136817404e-01f, -3.020059493e-01f, -2.902846773e-01f, -2.785196894e-01f, -2.667127575e-01f, -2.548656596e-01f,
+    -2.429801799e-01f, -2.310581083e-01f, -2.191012402e-01f, -2.071113762e-01f, -1.950903220e-01f, -1.830398880e-01f,
+    -1.709618888e-01f, -1.588581433e-01f, -1.467304745e-01f, -1.345807085e-01f, -1.224106752e-01f, -1.102222073e-01f,
+    -9.801714033e-02f, -8.579731234e-02f, -7.356456360e-02f, -6.132073630e-02f, -4.906767433e-02f, -3.680722294e-02f,
+    -2.454122852e-02f, -1.227153829e-02f, -2.449293598e-16f,
+};
+
+//atan(i/128), 多一个点方便插值
+static const fp32 atan_lut[ATAN_LUT_SIZE + 1] =
+{
+    0.000000000e+00f, 7.812341060e-03f, 1.562372862e-02f, 2.343320988e-02f, 3.123983343e-02f, 3.904264996e-02f,
+    4.684071292e-02f, 5.463307924e-02f, 6.241881000e-02f, 7.019697107e-02f, 7.796663383e-02f, 8.572687577e-02f,
+    9.347678116e-02f, 1.012154417e-01f, 1.089419570e-01f, 1.166554354e-01f, 1.243549945e-01f, 1.320397616e-01f,
+    1.397088743e-01f, 1.473614811e-01f, 1.549967419e-01f, 1.626138286e-01f, 1.702119253e-01f, 1.777902290e-01f,
+    1.853479500e-01f, 1.928843123e-01f, 2.003985538e-01f, 2.078899272e-01f, 2.153576997e-01f, 2.228011538e-01f,
+    2.302195873e-01f, 2.376123139e-01f, 2.449786631e-01f, 2.523179809e-01f, 2.596296294e-01f, 2.669129876e-01f,
+    2.741674511e-01f, 2.813924326e-01f, 2.885873619e-01f, 2.957516858e-01f, 3.028848684e-01f, 3.099863912e-01f,
+    3.170557532e-01f, 3.240924705e-01f, 3.310960767e-01f, 3.380661228e-01f, 3.450021772e-01f, 3.519038254e-01f,
+    3.587706703e-01f, 3.656023317e-01f, 3.723984467e-01f, 3.791586690e-01f, 3.858826694e-01f, 3.925701350e-01f,
+    3.992207696e-01f, 4.058342931e-01f, 4.124104416e-01f, 4.189489671e-01f, 4.254496374e-01f, 4.319122355e-01f,
+    4.383365599e-01f, 4.447224240e-01f, 4.510696560e-01f, 4.573780987e-01f, 4.636476090e-01f, 4.698780580e-01f,
+    4.760693303e-01f, 4.822213242e-01f, 4.883339511e-01f, 4.944071351e-01f, 5.004408131e-01f, 5.064349345e-01f,
+    5.123894603e-01f, 5.183043636e-01f, 5.241796288e-01f, 5.300152514e-01f, 5.358112380e-01f, 5.415676054e-01f,
+    5.472843810e-01f, 5.529616020e-01f, 5.585993153e-01f, 5.641975774e-01f, 5.697564535e-01f, 5.752760180e-01f,
+    5.807563536e-01f, 5.861975514e-01f, 5.915997103e-01f, 5.969629372e-01f, 6.022873461e-01f, 6.075730584e-01f,
+    6.128202022e-01f, 6.180289123e-01f, 6.231993299e-01f, 6.283316024e-01f, 6.334258830e-01f, 6.384823304e-01f,
+    6.435011088e-01f, 6.484823876e-01f, 6.534263412e-01f, 6.583331484e-01f, 6.632029927e-01f, 6.680360619e-01f,
+    6.728325476e-01f, 6.775926455e-01f, 6.823165549e-01f, 6.870044783e-01f, 6.916566219e-01f, 6.962731944e-01f,
+    7.008544079e-01f, 7.054004769e-01f, 7.099116185e-01f, 7.143880522e-01f, 7.188299996e-01f, 7.232376846e-01f,
+    7.276113326e-01f, 7.319511711e-01f, 7.362574290e-01f, 7.405303366e-01f, 7.447701257e-01f, 7.489770292e-01f,
+    7.531512810e-01f, 7.572931159e-01f, 7.614027698e-01f, 7.654804790e-01f, 7.695264804e-01f, 7.735410116e-01f,
+    7.775243104e-01f, 7.814766149e-01f, 7.853981634e-01f,
+};
+
+/*------内部函数------*/
+
+//规约: x = n*PI/2 + r, r在[-PI/4, PI/4], 返回象限n(按4取模前)
+//|x| >= ANGLE_LIMIT或inf/NaN时按x=0处理, NaN的比较结果为假
+static __inline uint32_t reduce_quadrant(fp32 x, fp32 *r)
+{
+    fp32 t;
+    int32_t n;
+
+    if (!(x < ANGLE_LIMIT && x > -ANGLE_LIMIT))
+    {
+        *r = 0.0f;
+        return 0u;
+    }
+    t = x * INV_HALF_PI;
+    n = (int32_t)(t >= 0.0f ? t + 0.5f : t - 0.5f);
+    *r = (x - (fp32)n * HALF_PI_HI) - (fp32)n * HALF_PI_LO;
+    return (uint32_t)n;
+}
+
+static __inline fp32 abs_f(fp32 x)
+{
+    return x < 0.0f ? -x : x;
+}
+
+//sin(q*PI/2 + r): 偶象限为±sin(r), 奇象限为±cos(r) = ±sin(PI/2 - |r|), poly为[-PI/2, PI/2]上的sin多项式
+#define QUADRANT_SIN(q, r, poly) \
+    ((((q) & 2u) ? -1.0f : 1.0f) * (((q) & 1u) ? poly(HALF_PI - abs_f(r)) : poly(r)))
+
+static __inline fp32 sin_poly5(fp32 x)
+{
+    fp32 x2 = x * x;
+    return x * (0.99969679f + x2 * (-0.16567308f + x2 * 0.0075143771f));
+}
+
+static __inline fp32 sin_poly7(fp32 x)
+{
+    fp32 x2 = x * x;
+    return x * (0.99999660f + x2 * (-0.16664828f + x2 * (0.0083063254f + x2 * -0.00018363654f)));
+}
+
+//atan, 输入范围 [0, 1]
+static __inline fp32 atan_poly7(fp32 x)
+{
+    fp32 x2 = x * x;
+    return x * (0.99921381f + x2 * (-0.32117498f + x2 * (0.14626446f + x2 * -0.038986519f)));
+}
+
+static __inline fp32 atan_poly11(fp32 x)
+{
+    fp32 x2 = x * x;
+    return x * (0.99997723f + x2 * (-0.33262283f + x2 * (0.19354038f + x2 * (-0.11642649f + x2 * (0.052647360f + x2 * -0.011719138f)))));
+}
+
+//查表: x*512/(2PI) = i + frac, frac在[0, 1), 返回i(按表长取模前)
+//|x| >= ANGLE_LIMIT或inf/NaN时按x=0处理
+static __inline uint32_t lut_index(fp32 x, fp32 *frac)
+{
+    fp32 t;
+    int32_t i;
+
+    if (!(x < ANGLE_LIMIT && x > -ANGLE_LIMIT))
+    {
+        *frac = 0.0f;
+        return 0u;
+    }
+    t = x * ((fp32)SIN_LUT_SIZE * INV_TWO_PI);
+    i = (int32_t)t;
+    if (t < (fp32)i)
+    {
+        i--;
+    }
+    *frac = t - (fp32)i;
+    return (uint32_t)i;
+}
+
+static __inline fp32 sin_lut_at(uint32_t i, fp32 frac)
+{
+    i &= SIN_LUT_MASK;
+    return sin_lut[i] + (sin_lut[i + 1] - sin_lut[i]) * frac;
+}
+
+static __inline fp32 atan_lut01(fp32 x)
+{
+    fp32 t = x * (fp32)ATAN_LUT_SIZE;
+    uint32_t i = (uint32_t)t;
+    if (i >= ATAN_LUT_SIZE)
+    {
+        return atan_lut[ATAN_LUT_SIZE];
+    }
+    return atan_lut[i] + (atan_lut[i + 1] - atan_lut[i]) * (t - (fp32)i);
+}
+
+//八分圆规约: 用[0,1]上的atan拼出完整atan2
+#define ATAN2_OCTANT(y, x, atan01)              \
+    {                                           \
+        fp32 ax = (x) < 0.0f ? -(x) : (x);      \
+        fp32 ay = (y) < 0.0f ? -(y) : (y);      \
+        fp32 a;                                 \
+        if (ax == 0.0f && ay == 0.0f)           \
+        {                                       \
+            return 0.0f;                        \
+        }                                       \
+        if (ay > ax)                            \
+        {                                       \
+            a = HALF_PI - atan01(ax / ay);      \
+        }                                       \
+        else                                    \
+        {                                       \
+            a = atan01(ay / ax);                \
+        }                                       \
+        if ((x) < 0.0f)                         \
+        {                                       \
+            a = PI - a;                         \
+        }                                       \
+        return (y) < 0.0f ? -a : a;             \
+    }
+
+/*------查表法------*/
+
+/**
+  * @brief          查表法sin, 512点线性插值
+  * @param[in]      x: 弧度
+  * @retval         sin(x)
+  */
+fp32 fast_sin_lut(fp32 x)
+{
+    fp32 frac;
+    uint32_t i = lut_index(x, &frac);
+
+    return sin_lut_at(i, frac);
+}
+
+/**
+  * @brief          查表法cos, 与sin共用索引, 偏移四分之一周期
+  * @param[in]      x: 弧度
+  * @retval         cos(x)
+  */
+fp32 fast_cos_lut(fp32 x)
+{
+    fp32 frac;
+    uint32_t i = lut_index(x, &frac);
+
+    return sin_lut_at(i + SIN_LUT_QUARTER, frac);
+}
+
+/**
+  * @brief          查表法atan2
+  * @param[in]      y: y分量
+  * @param[in]      x: x分量
+  * @retval         atan2(y, x), 范围[-PI, PI]
+  */
+fp32 fast_atan2_lut(fp32 y, fp32 x)
+{
+    ATAN2_OCTANT(y, x, atan_lut01);
+}
+
+/*------低阶多项式------*/
+
+fp32 fast_sin_fast(fp32 x)
+{
+    fp32 r;
+    uint32_t q = reduce_quadrant(x, &r);
+
+    return QUADRANT_SIN(q, r, sin_poly5);
+}
+
+//cos(x) = sin(x + PI/2), 象限加1
+fp32 fast_cos_fast(fp32 x)
+{
+    fp32 r;
+    uint32_t q = reduce_quadrant(x, &r);
+
+    return QUADRANT_SIN(q + 1u, r, sin_poly5);
+}
+
+fp32 fast_atan2_fast(fp32 y, fp32 x)
+{
+    ATAN2_OCTANT(y, x, atan_poly7);
+}
+
+/*------高阶多项式------*/
+
+fp32 fast_sin_precise(fp32 x)
+{
+    fp32 r;
+    uint32_t q = reduce_quadrant(x, &r);
+
+    return QUADRANT_SIN(q, r, sin_poly7);
+}
+
+//cos(x) = sin(x + PI/2), 象限加1
+fp32 fast_cos_precise(fp32 x)
+{
+    fp32 r;
+    uint32_t q = reduce_quadrant(x, &r);
+
+    return QUADRANT_SIN(q + 1u, r, sin_poly7);
+}
+
+fp32 fast_atan2_precise(fp32 y, fp32 x)
+{
+    ATAN2_OCTANT(y, x, atan_poly11);
+}
+
+/*------开方------*/
+
+/**
+  * @brief          快速开方倒数 1/sqrt(x)
+  * @param[in]      x: 输入值, 需大于0
+  * @retval         1/sqrt(x), x<=0 时返回0
+  */
+fp32 fast_inv_sqrt(fp32 x)
+{
+    union
+    {
+        fp32 f;
+        uint32_t i;
+    } conv;
+    fp32 half_x = 0.5f * x;
+
+    if (x <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    conv.f = x;
+    conv.i = 0x5f375a86u - (conv.i >> 1); //初始估计
+    conv.f = conv.f * (1.5f - half_x * conv.f * conv.f); //牛顿迭代
+#if (FAST_MATH_TIER != FAST_MATH_TIER_FAST)
+    conv.f = conv.f * (1.5f - half_x * conv.f * conv.f);
+#endif
+    return conv.f;
+}
+
+/**
+  * @brief          快速开方, 有硬件FPU时使用VSQRT指令
+  * @param[in]      x: 输入值
+  * @retval         sqrt(x), x<=0 时返回0
+  */
+fp32 fast_sqrt(fp32 x)
+{
+    if (x <= 0.0f)
+    {
+        return 0.0f;
+    }
+#if defined(__CC_ARM) && defined(__TARGET_FPU_VFP)
+    return __sqrtf(x);
+#else
+    return x * fast_inv_sqrt(x);
+#endif
+}
+
+/**
+  * @brief          同时计算sin和cos, 共用一次范围规约, cos由象限交换得到
+  * @param[in]      x: 弧度, |x| >= 1e7或inf/NaN时按0处理
+  * @param[out]     sin_out: sin(x)
+  * @param[out]     cos_out: cos(x)
+  * @retval         none
+  */
+void fast_sin_cos(fp32 x, fp32 *sin_out, fp32 *cos_out)
+{
+#if (FAST_MATH_TIER == FAST_MATH_TIER_LUT)
+    fp32 frac;
+    uint32_t i;
+#else
+    fp32 r;
+    uint32_t q;
+#endif
+
+    if (sin_out == 0 || cos_out == 0)
+    {
+        return;
+    }
+#if (FAST_MATH_TIER == FAST_MATH_TIER_LUT)
+    i = lut_index(x, &frac);
+    *sin_out = sin_lut_at(i, frac);
+    *cos_out = sin_lut_at(i + SIN_LUT_QUARTER, frac);
+#else
+    q = reduce_quadrant(x, &r);
+#if (FAST_MATH_TIER == FAST_MATH_TIER_FAST)
+    *sin_out = QUADRANT_SIN(q, r, sin_poly5);
+    *cos_out = QUADRANT_SIN(q + 1u, r, sin_poly5);
+#else
+    *sin_out = QUADRANT_SIN(q, r, sin_poly7);
+    *cos_out = QUADRANT_SIN(q + 1u, r, sin_poly7);
+#endif
+#endif
+}
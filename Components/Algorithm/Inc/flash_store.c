@@ -0,0 +1,252 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       flash_store.c/h
+  * @brief      日志结构的flash键值存储，两个扇区轮流使用实现磨损均衡，
+  *             每条记录带CRC16，掉电时最多丢失正在写入的一条记录。
+  * @note       每次写入都回读校验, 写入失败的位置不再使用。载入时扫描整个扇区,
+  *             下次写入位置在最后一个写过的位置之后, 不会回到写过的位置。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.0.1     Oct-19-2026     ICBK            2. 载入时跳过中间的空位置 key为擦除值的记录计为损坏
+  *
+  @verbatim
+  ==============================================================================
+    记录写入顺序与掉电后读到的内容:
+      1. value        掉电: key为擦除值, value为任意值      -> 损坏 跳过
+      2. crc16|key    掉电: key与crc只写入了部分位         -> CRC错误 跳过
+    载入时每个位置:
+      key与value均为擦除值 -> 未写入(或写入失败跳过), 继续查找
+      key为擦除值          -> 损坏(0xFFFF是保留键, 不可能是完整记录)
+      CRC错误              -> 损坏
+      键不在当前的键表中   -> 固件更新后删除的参数 忽略
+    整理的写入顺序: 擦除 -> magic generation ~generation -> 全部记录 -> valid
+      valid之前掉电, 新扇区无效, 启动时仍使用旧扇区; 两个扇区都有效时使用generation较新的
+    上位机掉电测试: Tools/sim/flash_sim.c
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#include <stddef.h>
+#include "flash_store.h"
+#include "crc.h"
+
+//记录校验 覆盖key与value共6字节
+static uint16_t flash_store_record_crc(uint16_t key, uint32_t value)
+{
+    uint8_t data[6];
+
+    data[0] = (uint8_t)key;
+    data[1] = (uint8_t)(key >> 8);
+    data[2] = (uint8_t)value;
+    data[3] = (uint8_t)(value >> 8);
+    data[4] = (uint8_t)(value >> 16);
+    data[5] = (uint8_t)(value >> 24);
+    return get_CRC16_check_sum(data, sizeof(data), CRC16_INIT);
+}
+
+//扇区头部是否有效
+static bool_t flash_store_sector_valid(const flash_store_t *store, uint8_t sector, uint32_t *generation)
+{
+    const volatile uint32_t *base = store->ops->read(sector);
+
+    if (base[0] != FLASH_STORE_MAGIC || base[1] != ~base[2] || base[3] != FLASH_STORE_VALID)
+    {
+        return 0;
+    }
+    *generation = base[1];
+    return 1;
+}
+
+//按键查找值的编号
+static int32_t flash_store_find(const flash_store_t *store, uint16_t key)
+{
+    uint16_t i;
+
+    for (i = 0; i < store->num; i++)
+    {
+        if (store->key[i] == key)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+//写入一个字并回读校验
+static bool_t flash_store_program(flash_store_t *store, uint8_t sector, uint32_t offset, uint32_t data)
+{
+    if (!store->ops->program(sector, offset, data) || store->ops->read(sector)[offset / 4] != data)
+    {
+        store->error_count++;
+        return 0;
+    }
+    return 1;
+}
+
+//追加一条记录 先写value 掉电时只留下key为擦除值的半条记录
+static bool_t flash_store_append(flash_store_t *store, uint8_t sector, uint32_t offset, uint16_t key, uint32_t value)
+{
+    uint32_t head = ((uint32_t)flash_store_record_crc(key, value) << 16) | key;
+
+    return flash_store_program(store, sector, offset + 4, value) && flash_store_program(store, sector, offset, head);
+}
+
+//载入当前扇区的记录 并找到下次写入位置
+static void flash_store_load(flash_store_t *store)
+{
+    const volatile uint32_t *base = store->ops->read(store->active);
+    uint32_t end = FLASH_STORE_HEADER_SIZE;
+    uint32_t offset;
+
+    for (offset = FLASH_STORE_HEADER_SIZE; offset + FLASH_STORE_RECORD_SIZE <= store->ops->sector_size; offset += FLASH_STORE_RECORD_SIZE)
+    {
+        uint32_t head = base[offset / 4];
+        uint32_t value = base[offset / 4 + 1];
+        int32_t index;
+
+        if (head == FLASH_STORE_ERASED && value == FLASH_STORE_ERASED)
+        {
+            //未写入 写入失败跳过的位置后面还可能有记录
+            continue;
+        }
+        end = offset + FLASH_STORE_RECORD_SIZE;
+
+        //掉电时写了一半的记录 只写入了value时key为擦除值 不检查CRC
+        if (head == FLASH_STORE_ERASED || (uint16_t)(head >> 16) != flash_store_record_crc((uint16_t)head, value))
+        {
+            store->corrupt_count++;
+            continue;
+        }
+
+        //固件更新后删除的键直接忽略
+        index = flash_store_find(store, (uint16_t)head);
+        if (index >= 0)
+        {
+            store->value[index] = value;
+            store->load_count++;
+        }
+    }
+    store->write_offset = end;
+}
+
+bool_t flash_store_init(flash_store_t *store, const flash_store_ops_t *ops, const uint16_t *key, uint32_t *value, uint16_t num)
+{
+    uint32_t generation[2];
+    bool_t valid[2];
+
+    if (store == NULL || ops == NULL || key == NULL || value == NULL ||
+        (uint32_t)num * FLASH_STORE_RECORD_SIZE + FLASH_STORE_HEADER_SIZE > ops->sector_size)
+    {
+        return 0;
+    }
+
+    store->ops = ops;
+    store->key = key;
+    store->value = value;
+    store->num = num;
+    store->load_count = 0;
+    store->corrupt_count = 0;
+    store->compact_count = 0;
+    store->error_count = 0;
+
+    valid[0] = flash_store_sector_valid(store, 0, &generation[0]);
+    valid[1] = flash_store_sector_valid(store, 1, &generation[1]);
+
+    if (!valid[0] && !valid[1])
+    {
+        //首次使用 把默认值写入扇区0
+        store->active = 1;
+        store->generation = 0;
+        store->write_offset = ops->sector_size; //格式化失败时下次写入重试
+        flash_store_compact(store);
+        return 0;
+    }
+
+    //两个扇区都有效时(整理完成后旧扇区未擦除) 使用较新的 代数比较考虑回绕
+    if (valid[0] && valid[1])
+    {
+        store->active = ((int32_t)(generation[1] - generation[0]) > 0) ? 1 : 0;
+    }
+    else
+    {
+        store->active = valid[1] ? 1 : 0;
+    }
+    store->generation = generation[store->active];
+
+    flash_store_load(store);
+    return 1;
+}
+
+bool_t flash_store_write(flash_store_t *store, uint16_t index)
+{
+    if (store == NULL || store->ops == NULL || index >= store->num)
+    {
+        return 0;
+    }
+
+    //扇区写满 整理时已写入全部当前值
+    if (store->write_offset + FLASH_STORE_RECORD_SIZE > store->ops->sector_size)
+    {
+        return flash_store_compact(store);
+    }
+
+    if (!flash_store_append(store, store->active, store->write_offset, store->key[index], store->value[index]))
+    {
+        //写入失败的位置已不是擦除值 跳过
+        store->write_offset += FLASH_STORE_RECORD_SIZE;
+        return 0;
+    }
+    store->write_offset += FLASH_STORE_RECORD_SIZE;
+    return 1;
+}
+
+bool_t flash_store_compact(flash_store_t *store)
+{
+    uint8_t next;
+    uint32_t generation;
+    uint32_t offset = FLASH_STORE_HEADER_SIZE;
+    uint16_t i;
+
+    if (store == NULL || store->ops == NULL)
+    {
+        return 0;
+    }
+
+    next = store->active ^ 1u;
+    generation = store->generation + 1;
+
+    if (!store->ops->erase(next))
+    {
+        store->error_count++;
+        return 0;
+    }
+
+    if (!flash_store_program(store, next, 0, FLASH_STORE_MAGIC) ||
+        !flash_store_program(store, next, 4, generation) ||
+        !flash_store_program(store, next, 8, ~generation))
+    {
+        return 0;
+    }
+
+    for (i = 0; i < store->num; i++)
+    {
+        if (!flash_store_append(store, next, offset, store->key[i], store->value[i]))
+        {
+            return 0;
+        }
+        offset += FLASH_STORE_RECORD_SIZE;
+    }
+
+    //全部写入后才标记有效 之前掉电仍使用旧扇区
+    if (!flash_store_program(store, next, 12, FLASH_STORE_VALID))
+    {
+        return 0;
+    }
+
+    store->active = next;
+    store->generation = generation;
+    store->write_offset = offset;
+    store->compact_count++;
+    return 1;
+}
@@ -0,0 +1,87 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       mem_pool.c/h
+  * @brief      定长块内存池，分配与释放均为O(1)。
+  * @note
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#include <stddef.h>
+#include "bsp_lock.h"
+#include "mem_pool.h"
+
+void *mem_pool_alloc(mem_pool_t *pool)
+{
+    uint32_t key;
+    void *block = NULL;
+
+    key = bsp_lock(&pool->lock);
+    if (pool->free_list != NULL)
+    {
+        block = pool->free_list;
+        pool->free_list = *(void **)block;
+    }
+    else if (pool->next_unused < pool->block_num)
+    {
+        block = pool->buf + (uint32_t)pool->next_unused * pool->block_size;
+        pool->next_unused++;
+    }
+
+    if (block != NULL)
+    {
+        pool->free_num--;
+        if (pool->free_num < pool->min_free)
+        {
+            pool->min_free = pool->free_num;
+        }
+        pool->alloc_count++;
+    }
+    else
+    {
+        pool->fail_count++;
+    }
+    bsp_unlock(&pool->lock, key);
+
+    return block;
+}
+
+void mem_pool_free(mem_pool_t *pool, void *block)
+{
+    uint32_t key;
+    uint32_t offset;
+
+    if (block == NULL)
+    {
+        return;
+    }
+
+    //只接受本池中块的起始地址
+    offset = (uint32_t)((uint8_t *)block - pool->buf);
+    if ((uint8_t *)block < pool->buf || offset >= (uint32_t)pool->block_num * pool->block_size ||
+        offset % pool->block_size != 0)
+    {
+        key = bsp_lock(&pool->lock);
+        pool->error_count++;
+        bsp_unlock(&pool->lock, key);
+        return;
+    }
+
+    key = bsp_lock(&pool->lock);
+    *(void **)block = pool->free_list;
+    pool->free_list = block;
+    pool->free_num++;
+    bsp_unlock(&pool->lock, key);
+}
+
+uint16_t mem_pool_used(const mem_pool_t *pool)
+{
+    return (uint16_t)(pool->block_num - pool->free_num);
+}
@@ -0,0 +1,114 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       profile.c/h
+  * @brief      代码段执行时间统计，基于DWT周期计数器记录每个测量点的
+  *             次数、最小/最大/平均周期数与log2分桶直方图。
+  * @note       
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#include "profile.h"
+
+#if defined(__CC_ARM)
+#define profile_clz(x) __clz(x)
+#else
+#define profile_clz(x) ((uint32_t)__builtin_clz(x))
+#endif
+
+//周期数所在直方图桶 floor(log2(cycles))
+static uint32_t profile_bucket(uint32_t cycles)
+{
+  uint32_t bucket;
+
+  if(cycles == 0)
+  {
+    return 0;
+  }
+  bucket = 31u - profile_clz(cycles);
+  if(bucket >= PROFILE_HIST_BUCKET_NUM)
+  {
+    bucket = PROFILE_HIST_BUCKET_NUM - 1;
+  }
+  return bucket;
+}
+
+void profile_record(profile_scope_t *scope, uint32_t cycles)
+{
+  scope->last = cycles;
+  scope->count++;
+  scope->total += cycles;
+  if(cycles < scope->min)
+  {
+    scope->min = cycles;
+  }
+  if(cycles > scope->max)
+  {
+    scope->max = cycles;
+  }
+  scope->hist[profile_bucket(cycles)]++;
+}
+
+void profile_reset(profile_scope_t *scope)
+{
+  uint8_t i;
+
+  if(scope == 0)
+  {
+    return;
+  }
+  scope->count = 0;
+  scope->last = 0;
+  scope->min = 0xFFFFFFFFu;
+  scope->max = 0;
+  scope->total = 0;
+  for(i = 0; i < PROFILE_HIST_BUCKET_NUM; i++)
+  {
+    scope->hist[i] = 0;
+  }
+}
+
+fp32 profile_mean(const profile_scope_t *scope)
+{
+  if(scope == 0 || scope->count == 0)
+  {
+    return 0.0f;
+  }
+  return (fp32)scope->total / (fp32)scope->count;
+}
+
+uint32_t profile_percentile(const profile_scope_t *scope, fp32 percent)
+{
+  uint32_t target;
+  uint32_t sum = 0;
+  uint8_t i;
+
+  if(scope == 0 || scope->count == 0)
+  {
+    return 0;
+  }
+
+  target = (uint32_t)((fp32)scope->count * percent / 100.0f);
+  if(target == 0)
+  {
+    target = 1;
+  }
+  for(i = 0; i < PROFILE_HIST_BUCKET_NUM - 1; i++)
+  {
+    sum += scope->hist[i];
+    if(sum >= target)
+    {
+      //桶上界不超过实测最大值
+      uint32_t upper = (2u << i) - 1u;
+      return upper < scope->max ? upper : scope->max;
+    }
+  }
+  return scope->max;
+}
@@ -0,0 +1,146 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       ahrs.c/h
+  * @brief      姿态解算，陀螺仪与加速度计(可选磁力计)融合，提供Mahony互补滤波
+  *             与四元数扩展卡尔曼滤波(状态为四元数与陀螺仪零偏)两种算法。
+  * @note       固定更新周期: 周期在初始化时给定，与周期有关的系数(dt/2、过程噪声)预先算好，
+  *             更新函数没有与数据有关的循环次数，执行时间只取决于是否有加速度计/磁力计修正。
+  *             矩阵为定长数组，卡尔曼滤波按状态转移矩阵的分块结构传播协方差，
+  *             观测按分量依次做标量更新，不需要矩阵求逆。
+  *             坐标系: 导航系z轴向上，静止水平时加速度计读数为(0,0,+g)；
+  *             四元数q = [w x y z]为机体系到导航系的旋转；欧拉角为ZYX顺序(偏航、俯仰、横滚)。
+  *             导航系x轴为磁北方向，Mahony中磁力计只修正偏航，卡尔曼滤波的磁力计观测
+  *             含磁倾角与横滚俯仰的关系，横滚俯仰误差不会被当成偏航误差。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    Mahony:
+      ahrs_mahony_init(&mahony, 1.0f, 0.01f, 0.001f, 2.0f); //kp ki 周期s 加速度计门限m/s^2
+      ahrs_align(mahony.q, accel, NULL);                   //可选 静止时用加速度计对准
+      ahrs_mahony_update(&mahony, gyro, accel, NULL);      //每周期调用 rad/s m/s^2 磁力计可为NULL
+    卡尔曼:
+      ahrs_ekf_init(&ekf, &param, 0.001f);
+      ahrs_align(ekf.x, accel, mag);                       //可选
+      ahrs_ekf_update(&ekf, gyro, accel, mag);
+      ekf.x[0..3]为四元数 ekf.x[4..6]为陀螺仪零偏
+    欧拉角: ahrs_euler(q, euler); euler[AHRS_YAW]...
+    加速度计模长与g相差超过accel_gate时(加减速、碰撞)不做加速度计修正
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef AHRS_H
+#define AHRS_H
+
+#include "struct_typedef.h"
+
+#define AHRS_GRAVITY        9.80665f
+#define AHRS_EKF_STATE_NUM  7u      //四元数4 + 陀螺仪零偏3
+
+/*欧拉角下标*/
+#define AHRS_YAW            0u
+#define AHRS_PITCH          1u
+#define AHRS_ROLL           2u
+
+/*Mahony互补滤波*/
+typedef struct
+{
+    fp32 q[4];                  //姿态四元数 w x y z
+    fp32 integral[3];           //积分项 即估计的陀螺仪零偏的相反数 rad/s
+    fp32 kp;                    //比例增益 1/s
+    fp32 ki_dt;                 //积分增益 * 周期
+    fp32 half_dt;               //周期/2
+    fp32 accel_gate;            //加速度计模长与g的偏差上限 m/s^2
+
+    uint32_t accel_reject_count;//加速度计修正被跳过的次数
+} ahrs_mahony_t;
+
+/*卡尔曼滤波参数*/
+typedef struct
+{
+    fp32 gyro_noise;            //陀螺仪噪声 rad/s
+    fp32 gyro_bias_walk;        //零偏随机游走 rad/s/sqrt(s)
+    fp32 gyro_bias_init;        //零偏初始不确定度 rad/s
+    fp32 accel_noise;           //加速度计方向噪声 单位向量 含振动与线加速度
+    fp32 mag_noise;             //磁力计偏航噪声 rad
+    fp32 accel_gate;            //加速度计模长与g的偏差上限 m/s^2
+} ahrs_ekf_param_t;
+
+/*四元数扩展卡尔曼滤波*/
+typedef struct
+{
+    fp32 x[AHRS_EKF_STATE_NUM];                         //状态 q(w x y z) 零偏(x y z)
+    fp32 P[AHRS_EKF_STATE_NUM][AHRS_EKF_STATE_NUM];     //协方差
+
+    //初始化时算好的系数
+    fp32 half_dt;               //周期/2
+    fp32 q_quat;                //四元数过程噪声 (dt/2)^2 * gyro_noise^2
+    fp32 q_bias;                //零偏过程噪声 gyro_bias_walk^2 * dt
+    fp32 r_accel;               //加速度计观测噪声方差
+    fp32 r_mag;                 //磁力计观测噪声方差
+    fp32 accel_gate;
+
+    uint32_t accel_reject_count;//加速度计修正被跳过的次数
+} ahrs_ekf_t;
+
+/**
+  * @brief          用加速度计(与磁力计)求初始姿态, 静止时调用
+  * @param[out]     q: 四元数
+  * @param[in]      accel: 加速度计 m/s^2
+  * @param[in]      mag: 磁力计 任意单位, NULL时偏航为0
+  * @retval         none
+  */
+extern void ahrs_align(fp32 q[4], const fp32 accel[3], const fp32 *mag);
+
+/**
+  * @brief          四元数转欧拉角 ZYX
+  * @param[in]      q: 四元数
+  * @param[out]     euler: 偏航、俯仰、横滚 rad
+  * @retval         none
+  */
+extern void ahrs_euler(const fp32 q[4], fp32 euler[3]);
+
+/**
+  * @brief          Mahony初始化 姿态为单位四元数
+  * @param[out]     mahony: 滤波器
+  * @param[in]      kp: 比例增益 1/s
+  * @param[in]      ki: 积分增益 1/s^2
+  * @param[in]      dt: 更新周期 s
+  * @param[in]      accel_gate: 加速度计模长与g的偏差上限 m/s^2
+  * @retval         none
+  */
+extern void ahrs_mahony_init(ahrs_mahony_t *mahony, fp32 kp, fp32 ki, fp32 dt, fp32 accel_gate);
+
+/**
+  * @brief          Mahony更新一个周期
+  * @param[in,out]  mahony: 滤波器
+  * @param[in]      gyro: 陀螺仪 rad/s
+  * @param[in]      accel: 加速度计 m/s^2, NULL为不修正
+  * @param[in]      mag: 磁力计 任意单位, NULL为不修正
+  * @retval         none
+  */
+extern void ahrs_mahony_update(ahrs_mahony_t *mahony, const fp32 gyro[3], const fp32 *accel, const fp32 *mag);
+
+/**
+  * @brief          卡尔曼滤波初始化 姿态为单位四元数 零偏为0
+  * @param[out]     ekf: 滤波器
+  * @param[in]      param: 噪声参数
+  * @param[in]      dt: 更新周期 s
+  * @retval         none
+  */
+extern void ahrs_ekf_init(ahrs_ekf_t *ekf, const ahrs_ekf_param_t *param, fp32 dt);
+
+/**
+  * @brief          卡尔曼滤波更新一个周期: 预测 + 加速度计与磁力计观测更新
+  * @param[in,out]  ekf: 滤波器
+  * @param[in]      gyro: 陀螺仪 rad/s
+  * @param[in]      accel: 加速度计 m/s^2, NULL为只预测
+  * @param[in]      mag: 磁力计 任意单位, NULL为不修正偏航
+  * @retval         none
+  */
+extern void ahrs_ekf_update(ahrs_ekf_t *ekf, const fp32 gyro[3], const fp32 *accel, const fp32 *mag);
+
+#endif
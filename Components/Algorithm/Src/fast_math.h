@@ -0,0 +1,105 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       fast_math.c/h
+  * @brief      快速数学函数库，提供查表法与极小极大(minimax)多项式两种实现的
+  *             sin/cos/atan2/sqrt，用于控制环、坐标旋转、编码器角度换算、姿态解算。
+  * @note       不依赖libm，无静态状态，可在中断中调用。
+  *             通过 config_freame.h 中 CONFIG_FAST_MATH_TIER 选择默认精度档位，
+  *             也可以直接调用带档位后缀的函数。
+  *             各档位最大绝对误差(单精度实测上界，输入 |x| <= 100 rad，Tools/sim/fast_math_bench检查):
+  *               LUT     : sin/cos 2.3e-5,          atan2 5.3e-6 rad
+  *               FAST    : sin/cos 7.1e-5,          atan2 8.2e-5 rad
+  *               PRECISE : sin/cos 7.8e-7,          atan2 2.0e-6 rad
+  *             inv_sqrt/sqrt 相对误差: FAST档1次牛顿迭代 1.8e-3, 其余档位2次迭代 4.8e-6
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.0.1     Oct-19-2026     ICBK            2. 误差上界按精度扫描修正(原值为截断后的实测值)
+  *  V1.0.2     Oct-19-2026     ICBK            3. cos按象限平移计算, PRECISE档cos误差与sin相同;
+  *                                                |x| >= 1e7 rad与inf/NaN按0处理
+  *
+  @verbatim
+  ==============================================================================
+    使用方法:
+      fp32 s = fast_sin(angle);            //默认档位
+      fp32 a = fast_atan2_precise(y, x);   //指定档位
+    角度单位均为弧度, atan2 返回值范围 [-PI, PI]
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include "struct_typedef.h"
+#include "config_freame.h"
+
+#ifndef PI
+#define PI 3.14159265358979f
+#endif
+
+/*精度档位*/
+#define FAST_MATH_TIER_LUT      0   //查表+线性插值
+#define FAST_MATH_TIER_FAST     1   //低阶多项式 速度最快
+#define FAST_MATH_TIER_PRECISE  2   //高阶多项式 接近单精度极限
+
+#ifdef CONFIG_FAST_MATH_TIER
+#define FAST_MATH_TIER CONFIG_FAST_MATH_TIER
+#else
+#define FAST_MATH_TIER FAST_MATH_TIER_LUT
+#endif
+
+/*----------查表法----------*/
+extern fp32 fast_sin_lut(fp32 x);
+extern fp32 fast_cos_lut(fp32 x);
+extern fp32 fast_atan2_lut(fp32 y, fp32 x);
+
+/*----------低阶多项式----------*/
+extern fp32 fast_sin_fast(fp32 x);
+extern fp32 fast_cos_fast(fp32 x);
+extern fp32 fast_atan2_fast(fp32 y, fp32 x);
+
+/*----------高阶多项式----------*/
+extern fp32 fast_sin_precise(fp32 x);
+extern fp32 fast_cos_precise(fp32 x);
+extern fp32 fast_atan2_precise(fp32 y, fp32 x);
+
+/**
+  * @brief          快速开方倒数 1/sqrt(x)
+  * @param[in]      x: 输入值, 需大于0
+  * @retval         1/sqrt(x), x<=0 时返回0
+  */
+extern fp32 fast_inv_sqrt(fp32 x);
+
+/**
+  * @brief          快速开方, 有硬件FPU时使用VSQRT指令
+  * @param[in]      x: 输入值
+  * @retval         sqrt(x), x<=0 时返回0
+  */
+extern fp32 fast_sqrt(fp32 x);
+
+/**
+  * @brief          同时计算sin和cos, 共用一次范围规约, cos由象限交换得到
+  * @param[in]      x: 弧度, |x| >= 1e7或inf/NaN时按0处理(sin=0, cos=1)
+  * @param[out]     sin_out: sin(x)
+  * @param[out]     cos_out: cos(x)
+  * @retval         none
+  */
+extern void fast_sin_cos(fp32 x, fp32 *sin_out, fp32 *cos_out);
+
+/*----------按档位选择默认实现----------*/
+#if (FAST_MATH_TIER == FAST_MATH_TIER_LUT)
+#define fast_sin(x)       fast_sin_lut(x)
+#define fast_cos(x)       fast_cos_lut(x)
+#define fast_atan2(y, x)  fast_atan2_lut(y, x)
+#elif (FAST_MATH_TIER == FAST_MATH_TIER_FAST)
+#define fast_sin(x)       fast_sin_fast(x)
+#define fast_cos(x)       fast_cos_fast(x)
+#define fast_atan2(y, x)  fast_atan2_fast(y, x)
+#else
+#define fast_sin(x)       fast_sin_precise(x)
+#define fast_cos(x)       fast_cos_precise(x)
+#define fast_atan2(y, x)  fast_atan2_precise(y, x)
+#endif
+
+#endif
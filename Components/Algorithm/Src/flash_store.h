@@ -0,0 +1,96 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       flash_store.c/h
+  * @brief      日志结构的flash键值存储，两个扇区轮流使用实现磨损均衡，
+  *             每条记录带CRC16，掉电时最多丢失正在写入的一条记录。
+  * @note       不依赖HAL，擦写通过flash_store_ops_t回调完成，
+  *             目标板使用内部flash扇区，上位机可用RAM模拟flash。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.0.1     Oct-19-2026     ICBK            2. 载入时跳过中间的空位置 key为擦除值的记录计为损坏
+  *
+  @verbatim
+  ==============================================================================
+    扇区格式(小端, 按字写入, 擦除后为0xFFFFFFFF):
+      头部 16字节: magic | generation | ~generation | valid
+      记录  8字节: key(低16位) crc16(高16位) | value
+    写入: 在当前扇区末尾追加记录, 先写value再写key, 读取时后写入的记录覆盖先写入的
+    整理: 当前扇区写满时擦除另一个扇区, 写入头部与全部当前值,
+          最后写valid标记, 新扇区generation+1; valid未写入的扇区无效
+    启动: 选择valid且generation最大的扇区, 按顺序载入整个扇区的记录,
+          最后一个写过的位置之后为下次写入位置
+    掉电恢复:
+      追加记录时掉电 -> 该记录key为擦除值或CRC错误被跳过, 之前的记录不受影响
+      整理时掉电     -> 新扇区没有valid标记, 仍使用旧扇区
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef FLASH_STORE_H
+#define FLASH_STORE_H
+
+#include "struct_typedef.h"
+
+#define FLASH_STORE_MAGIC       0x534D5250u //"PRMS"
+#define FLASH_STORE_VALID       0x44494C56u //"VLID"
+#define FLASH_STORE_ERASED      0xFFFFFFFFu
+#define FLASH_STORE_HEADER_SIZE 16u
+#define FLASH_STORE_RECORD_SIZE 8u
+#define FLASH_STORE_KEY_INVALID 0xFFFFu     //保留 不能作为键
+
+/*flash操作 sector为0或1*/
+typedef struct
+{
+  uint32_t sector_size;                                             //每个扇区字节数
+  bool_t (*erase)(uint8_t sector);                                  //擦除扇区
+  bool_t (*program)(uint8_t sector, uint32_t offset, uint32_t data);//写入一个字 offset为字节偏移(4字节对齐)
+  const volatile uint32_t *(*read)(uint8_t sector);                 //扇区起始地址
+} flash_store_ops_t;
+
+/*存储对象*/
+typedef struct
+{
+  const flash_store_ops_t *ops;
+  const uint16_t *key;      //每个值的键
+  uint32_t *value;          //RAM中的值
+  uint16_t num;             //值的数量
+
+  uint8_t active;           //当前扇区
+  uint32_t generation;      //当前扇区代数
+  uint32_t write_offset;    //下一条记录的字节偏移
+
+  uint32_t load_count;      //启动时载入的记录数
+  uint32_t corrupt_count;   //启动时CRC错误的记录数
+  uint32_t compact_count;   //整理次数
+  uint32_t error_count;     //擦写失败次数
+} flash_store_t;
+
+/**
+  * @brief          初始化并载入存储的值, 没有存储的值保持调用前的内容(默认值)
+  * @param[out]     store: 存储对象
+  * @param[in]      ops: flash操作
+  * @param[in]      key: 每个值的键, 不能为FLASH_STORE_KEY_INVALID, 不能重复
+  * @param[in,out]  value: RAM中的值, 调用前填入默认值
+  * @param[in]      num: 值的数量, 需满足 num * 8 + 16 <= sector_size
+  * @retval         1:载入了有效扇区 0:没有有效扇区(已格式化)或参数错误
+  */
+extern bool_t flash_store_init(flash_store_t *store, const flash_store_ops_t *ops, const uint16_t *key, uint32_t *value, uint16_t num);
+
+/**
+  * @brief          追加一条记录保存value[index]当前值, 扇区写满时自动整理;
+  *                 整理需要擦除扇区, 期间CPU停止读取flash(内部flash约1~2s)
+  * @param[in,out]  store: 存储对象
+  * @param[in]      index: 值的编号
+  * @retval         1:成功 0:失败
+  */
+extern bool_t flash_store_write(flash_store_t *store, uint16_t index);
+
+/**
+  * @brief          整理: 把全部当前值写入另一个扇区并切换
+  * @param[in,out]  store: 存储对象
+  * @retval         1:成功 0:失败
+  */
+extern bool_t flash_store_compact(flash_store_t *store);
+
+#endif
@@ -0,0 +1,80 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       mem_pool.c/h
+  * @brief      定长块内存池，分配与释放均为O(1)，执行时间与池中块数、
+  *             分配历史无关，不产生碎片，记录每个池的使用统计。
+  * @note       块存储静态分配；锁只保护空闲链表与计数(见bsp_lock.h)，
+  *             任务与中断中均可分配与释放。FreeRTOS堆(heap_4)只用于初始化阶段。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    定义(文件作用域):
+      MEM_POOL_DEFINE(telemetry_tx, 512, 4);       //4个512字节的块
+    其他文件访问: MEM_POOL_DECLARE(telemetry_tx); MEM_POOL(telemetry_tx)
+    使用:
+      p = mem_pool_alloc(MEM_POOL(telemetry_tx));  //没有空闲块返回NULL 不等待
+      mem_pool_free(MEM_POOL(telemetry_tx), p);
+    块长度按8字节取整, 块地址8字节对齐
+    从未分配过的块按顺序取出, 释放的块进入空闲链表(链表指针存放在空闲块内), 不需要初始化
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef MEM_POOL_H
+#define MEM_POOL_H
+
+#include "struct_typedef.h"
+
+//块长度按8字节取整后的字数
+#define MEM_POOL_WORDS(size) (((size) + 7u) / 8u)
+
+/*内存池*/
+typedef struct
+{
+    const char *name;
+    uint16_t block_size;        //块长度 8字节对齐
+    uint16_t block_num;
+    uint8_t *buf;               //block_num个块
+    void *free_list;            //释放过的空闲块
+    uint16_t next_unused;       //从未分配过的第一个块
+    uint16_t free_num;          //当前空闲块数
+    uint16_t min_free;          //历史最少空闲块数
+    uint32_t alloc_count;       //分配成功次数
+    uint32_t fail_count;        //没有空闲块导致分配失败的次数
+    uint32_t error_count;       //释放了不属于本池的地址的次数
+    volatile uint8_t lock;      //上位机自旋锁 目标板不使用
+} mem_pool_t;
+
+#define MEM_POOL_DEFINE(pool, size, num)                                                                \
+    static uint64_t mem_pool_buf_##pool[(num) * MEM_POOL_WORDS(size)];                                  \
+    mem_pool_t mem_pool_##pool = {#pool, MEM_POOL_WORDS(size) * 8u, (num), (uint8_t *)mem_pool_buf_##pool, \
+                                  NULL, 0, (num), (num), 0, 0, 0, 0}
+#define MEM_POOL_DECLARE(pool) extern mem_pool_t mem_pool_##pool
+#define MEM_POOL(pool) (&mem_pool_##pool)
+
+/**
+  * @brief          分配一个块, 任务与中断中均可调用
+  * @param[in]      pool: 内存池
+  * @retval         块地址, 没有空闲块返回NULL
+  */
+extern void *mem_pool_alloc(mem_pool_t *pool);
+
+/**
+  * @brief          释放一个块, 任务与中断中均可调用
+  * @param[in]      pool: 内存池
+  * @param[in]      block: mem_pool_alloc返回的地址, NULL时不处理
+  * @retval         none
+  */
+extern void mem_pool_free(mem_pool_t *pool, void *block);
+
+/**
+  * @brief          已分配的块数
+  * @param[in]      pool: 内存池
+  * @retval         已分配的块数
+  */
+extern uint16_t mem_pool_used(const mem_pool_t *pool);
+
+#endif
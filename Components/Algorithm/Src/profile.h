@@ -0,0 +1,101 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       profile.c/h
+  * @brief      代码段执行时间统计，基于DWT周期计数器记录每个测量点的
+  *             次数、最小/最大/平均周期数与log2分桶直方图。
+  * @note       CONFIG_PROFILE_ENABLE为0时所有宏展开为空，不占用时间与内存。
+  *             每个测量点只能在一个上下文(某一个中断或某一个任务)中记录，
+  *             其他任务读取统计值时可能读到正在更新的数据，仅用于调试。
+  *             上位机编译时周期计数改用rdtsc/clock_gettime(见bsp_dwt.h)。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    使用方法:
+      PROFILE_SCOPE_DEFINE(chassis_loop);     //文件作用域定义测量点
+      void f(void)
+      {
+        PROFILE_BEGIN(chassis_loop);
+        ...
+        PROFILE_END(chassis_loop);
+      }
+    其他文件访问: PROFILE_SCOPE_DECLARE(chassis_loop); PROFILE_SCOPE_POINT(chassis_loop)
+    直方图第i个桶统计周期数在 [2^i, 2^(i+1)) 内的次数, 最后一个桶包含所有更大的值
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "struct_typedef.h"
+#include "config_freame.h"
+#include "bsp_dwt.h"
+
+#ifdef CONFIG_PROFILE_ENABLE
+#define PROFILE_ENABLE CONFIG_PROFILE_ENABLE
+#else
+#define PROFILE_ENABLE 0
+#endif
+
+#define PROFILE_HIST_BUCKET_NUM 24  //2^24周期 168MHz下约100ms
+
+/*测量点统计数据*/
+typedef struct
+{
+  const char *name;
+  uint32_t count;   //记录次数
+  uint32_t last;    //最近一次周期数
+  uint32_t min;
+  uint32_t max;
+  uint64_t total;   //周期数累计 用于求平均
+  uint32_t hist[PROFILE_HIST_BUCKET_NUM];
+} profile_scope_t;
+
+#if PROFILE_ENABLE
+#define PROFILE_SCOPE_DEFINE(scope)   profile_scope_t profile_scope_##scope = {#scope, 0, 0, 0xFFFFFFFFu, 0, 0, {0}}
+#define PROFILE_SCOPE_DECLARE(scope)  extern profile_scope_t profile_scope_##scope
+#define PROFILE_SCOPE_POINT(scope)    (&profile_scope_##scope)
+#define PROFILE_BEGIN(scope)          uint32_t profile_start_##scope = dwt_cycle_get()
+#define PROFILE_END(scope)            profile_record(&profile_scope_##scope, dwt_cycle_get() - profile_start_##scope)
+#else
+#define PROFILE_SCOPE_DEFINE(scope)   typedef int profile_scope_##scope##_disabled
+#define PROFILE_SCOPE_DECLARE(scope)  typedef int profile_scope_##scope##_disabled
+#define PROFILE_SCOPE_POINT(scope)    ((profile_scope_t *)0)
+#define PROFILE_BEGIN(scope)
+#define PROFILE_END(scope)
+#endif
+
+/**
+  * @brief          记录一次测量结果, 一般通过PROFILE_END调用
+  * @param[in,out]  scope: 测量点
+  * @param[in]      cycles: 周期数
+  * @retval         none
+  */
+extern void profile_record(profile_scope_t *scope, uint32_t cycles);
+
+/**
+  * @brief          清除测量点统计数据
+  * @param[out]     scope: 测量点
+  * @retval         none
+  */
+extern void profile_reset(profile_scope_t *scope);
+
+/**
+  * @brief          平均周期数
+  * @param[in]      scope: 测量点
+  * @retval         平均周期数, 没有记录时为0
+  */
+extern fp32 profile_mean(const profile_scope_t *scope);
+
+/**
+  * @brief          由直方图估计百分位数, 返回所在桶的上界(偏保守)
+  * @param[in]      scope: 测量点
+  * @param[in]      percent: 百分位 0~100
+  * @retval         周期数
+  */
+extern uint32_t profile_percentile(const profile_scope_t *scope, fp32 percent);
+
+#endif
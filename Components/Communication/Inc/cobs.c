@@ -0,0 +1,85 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       cobs.c/h
+  * @brief      COBS(Consistent Overhead Byte Stuffing)编解码，
+  *             编码后数据不含0x00，以0x00作为帧分隔符，丢字节后可在下一个0x00处重新同步。
+  * @note       
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#include "cobs.h"
+
+uint16_t cobs_encode(const uint8_t *src, uint16_t len, uint8_t *dst)
+{
+    uint16_t read_index = 0;
+    uint16_t write_index = 1;
+    uint16_t code_index = 0;
+    uint8_t code = 1;
+
+    while (read_index < len)
+    {
+        if (src[read_index] == 0)
+        {
+            dst[code_index] = code;
+            code = 1;
+            code_index = write_index++;
+        }
+        else
+        {
+            dst[write_index++] = src[read_index];
+            code++;
+            if (code == 0xFF)
+            {
+                dst[code_index] = code;
+                code = 1;
+                code_index = write_index++;
+            }
+        }
+        read_index++;
+    }
+    dst[code_index] = code;
+
+    return write_index;
+}
+
+uint16_t cobs_decode(const uint8_t *src, uint16_t len, uint8_t *dst)
+{
+    uint16_t read_index = 0;
+    uint16_t write_index = 0;
+    uint8_t code;
+    uint8_t i;
+
+    while (read_index < len)
+    {
+        code = src[read_index];
+        if (code == 0 || read_index + code > len + 1u)
+        {
+            return 0;
+        }
+        read_index++;
+
+        for (i = 1; i < code; i++)
+        {
+            if (src[read_index] == 0)
+            {
+                return 0;
+            }
+            dst[write_index++] = src[read_index++];
+        }
+        //最后一组之后没有隐含的0
+        if (code != 0xFF && read_index != len)
+        {
+            dst[write_index++] = 0;
+        }
+    }
+
+    return write_index;
+}
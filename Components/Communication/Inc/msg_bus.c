@@ -0,0 +1,255 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       msg_bus.c/h
+  * @brief      任务间发布/订阅消息总线，话题静态定义，不使用动态内存。
+  * @note
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.0.1     Oct-19-2026     ICBK            2. 锁改用bsp_lock.h 与内存池共用
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#include <string.h>
+#include "bsp_lock.h"
+#include "msg_bus.h"
+
+#define MSG_BUS_SLOT_WRITING 0x80u
+
+#if defined(__CC_ARM) || defined(__ARMCC_VERSION) || defined(__arm__)
+
+#include "cmsis_os.h"
+
+void msg_bus_notify_signal(void *user)
+{
+    osSignalSet((osThreadId)user, MSG_BUS_NOTIFY_SIGNAL);
+}
+
+#else
+
+void msg_bus_notify_signal(void *user)
+{
+    (void)user;
+}
+
+#endif
+
+//队列元素: 8字节版本号 + 消息
+static uint8_t *msg_bus_queue_item(const msg_bus_sub_t *sub, uint32_t index)
+{
+    return sub->queue + (uint32_t)(index % sub->queue_depth) * (8u + sub->topic->stride);
+}
+
+//锁内调用 拷贝到每个队列订阅者 队列满时丢弃最旧的样本
+static void msg_bus_queue_push(msg_bus_topic_t *topic, const uint8_t *msg, uint32_t version)
+{
+    msg_bus_sub_t *sub;
+    uint8_t *item;
+
+    for (sub = topic->sub_list; sub != NULL; sub = sub->next)
+    {
+        if (sub->queue == NULL)
+        {
+            continue;
+        }
+        if (sub->queue_head - sub->queue_tail >= sub->queue_depth)
+        {
+            sub->queue_tail++;
+            sub->queue_overflow++;
+        }
+        item = msg_bus_queue_item(sub, sub->queue_head);
+        *(uint32_t *)item = version;
+        memcpy(item + 8, msg, topic->size);
+        sub->queue_head++;
+    }
+}
+
+void msg_bus_subscribe(msg_bus_sub_t *sub, msg_bus_topic_t *topic, uint64_t *queue, uint16_t queue_depth,
+                       msg_bus_notify_t notify, void *user)
+{
+    uint32_t key;
+
+    if (sub == NULL || topic == NULL)
+    {
+        return;
+    }
+
+    sub->topic = topic;
+    sub->version = 0;
+    sub->pinned = MSG_BUS_SLOT_NONE;
+    sub->queue = (queue_depth != 0) ? (uint8_t *)queue : NULL;
+    sub->queue_depth = queue_depth;
+    sub->queue_head = 0;
+    sub->queue_tail = 0;
+    sub->queue_overflow = 0;
+    sub->notify = notify;
+    sub->user = user;
+
+    key = bsp_lock(&topic->lock);
+    sub->next = topic->sub_list;
+    topic->sub_list = sub;
+    bsp_unlock(&topic->lock, key);
+}
+
+void *msg_bus_publish_begin(msg_bus_topic_t *topic)
+{
+    uint32_t key;
+    uint8_t i;
+    uint8_t slot = MSG_BUS_SLOT_NONE;
+
+    key = bsp_lock(&topic->lock);
+    for (i = 0; i < topic->slot_num; i++)
+    {
+        //最新样本所在槽可能随时被读者占用 不能改写
+        if (i != topic->latest && topic->slot_state[i] == 0)
+        {
+            topic->slot_state[i] = MSG_BUS_SLOT_WRITING;
+            slot = i;
+            break;
+        }
+    }
+    if (slot == MSG_BUS_SLOT_NONE)
+    {
+        topic->drop_count++;
+    }
+    bsp_unlock(&topic->lock, key);
+
+    return (slot == MSG_BUS_SLOT_NONE) ? NULL : topic->buf + (uint32_t)slot * topic->stride;
+}
+
+uint32_t msg_bus_publish_end(msg_bus_topic_t *topic, void *msg)
+{
+    uint32_t key;
+    uint32_t version;
+    uint8_t slot = (uint8_t)(((uint8_t *)msg - topic->buf) / topic->stride);
+    msg_bus_sub_t *sub;
+
+    key = bsp_lock(&topic->lock);
+    topic->slot_state[slot] &= (uint8_t)~MSG_BUS_SLOT_WRITING;
+    topic->latest = slot;
+    version = ++topic->version;
+    msg_bus_queue_push(topic, (const uint8_t *)msg, version);
+    bsp_unlock(&topic->lock, key);
+
+    //订阅链表只在发布开始前修改 不需要加锁
+    for (sub = topic->sub_list; sub != NULL; sub = sub->next)
+    {
+        if (sub->notify != NULL)
+        {
+            sub->notify(sub->user);
+        }
+    }
+
+    return version;
+}
+
+uint32_t msg_bus_publish(msg_bus_topic_t *topic, const void *data)
+{
+    void *msg = msg_bus_publish_begin(topic);
+
+    if (msg == NULL)
+    {
+        return 0;
+    }
+    memcpy(msg, data, topic->size);
+    return msg_bus_publish_end(topic, msg);
+}
+
+const void *msg_bus_acquire(msg_bus_sub_t *sub, uint32_t *version)
+{
+    msg_bus_topic_t *topic = sub->topic;
+    uint32_t key;
+    uint8_t slot;
+
+    key = bsp_lock(&topic->lock);
+    if (sub->pinned != MSG_BUS_SLOT_NONE)
+    {
+        topic->slot_state[sub->pinned]--;
+    }
+    slot = topic->latest;
+    sub->pinned = slot;
+    if (slot != MSG_BUS_SLOT_NONE)
+    {
+        topic->slot_state[slot]++;
+        sub->version = topic->version;
+    }
+    bsp_unlock(&topic->lock, key);
+
+    if (slot == MSG_BUS_SLOT_NONE)
+    {
+        return NULL;
+    }
+    if (version != NULL)
+    {
+        *version = sub->version;
+    }
+    return topic->buf + (uint32_t)slot * topic->stride;
+}
+
+void msg_bus_release(msg_bus_sub_t *sub)
+{
+    msg_bus_topic_t *topic = sub->topic;
+    uint32_t key;
+
+    key = bsp_lock(&topic->lock);
+    if (sub->pinned != MSG_BUS_SLOT_NONE)
+    {
+        topic->slot_state[sub->pinned]--;
+        sub->pinned = MSG_BUS_SLOT_NONE;
+    }
+    bsp_unlock(&topic->lock, key);
+}
+
+bool_t msg_bus_read(msg_bus_sub_t *sub, void *data, uint32_t *version)
+{
+    const void *msg = msg_bus_acquire(sub, version);
+
+    if (msg == NULL)
+    {
+        return 0;
+    }
+    memcpy(data, msg, sub->topic->size);
+    msg_bus_release(sub);
+    return 1;
+}
+
+bool_t msg_bus_updated(const msg_bus_sub_t *sub)
+{
+    return sub->topic->version != sub->version;
+}
+
+bool_t msg_bus_queue_pop(msg_bus_sub_t *sub, void *data, uint32_t *version)
+{
+    msg_bus_topic_t *topic = sub->topic;
+    uint32_t key;
+    const uint8_t *item;
+    bool_t ok = 0;
+
+    if (sub->queue == NULL)
+    {
+        return 0;
+    }
+
+    //发布者可能在队列满时推进读位置 取出也在锁内进行
+    key = bsp_lock(&topic->lock);
+    if (sub->queue_head != sub->queue_tail)
+    {
+        item = msg_bus_queue_item(sub, sub->queue_tail);
+        sub->version = *(const uint32_t *)item;
+        memcpy(data, item + 8, topic->size);
+        sub->queue_tail++;
+        ok = 1;
+    }
+    bsp_unlock(&topic->lock, key);
+
+    if (ok && version != NULL)
+    {
+        *version = sub->version;
+    }
+    return ok;
+}
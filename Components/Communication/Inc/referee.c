@@ -0,0 +1,252 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       referee.c/h
+  * @brief      裁判系统串口协议解析，直接在串口DMA环形缓冲区上逐帧解析，
+  *             帧头CRC8、整帧CRC16校验通过后按命令码拷贝到对应结构体。
+  * @note       读指针为read_count+pos, 与缓冲区长度-1相与得到下标, 找SOF、拷贝与CRC16
+  *             都在回绕处分两段进行; 只拷贝帧头、命令码、CRC16与数据段, 不拷贝整帧。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    帧格式(小端) 偏移/长度:
+      0  SOF 0xA5       1
+      1  data_length    2
+      3  seq            1
+      4  CRC8           1   覆盖偏移0~3
+      5  cmd_id         2
+      7  data           data_length
+      7+data_length     CRC16 2   覆盖偏移0~6+data_length(帧头、命令码与数据段)
+    两级校验:
+      CRC8只覆盖帧头, 收到5字节即可检查; 通过后才相信data_length, 决定等待多少字节
+      CRC16覆盖整帧, 整帧收到后再检查, 帧头正确而数据损坏的帧在这里丢弃
+    重新同步:
+      SOF之前的字节全部丢弃(memchr查找)
+      CRC8错误、data_length超过REFEREE_DATA_MAX_LEN、CRC16错误时只丢弃SOF一个字节,
+      不按data_length跳过整帧: 损坏的帧头中长度不可信, 且帧内的0xA5可能是下一帧的开始
+      帧不完整时停止解析, 返回已处理的字节数, 剩余数据留在缓冲区中
+    上位机模糊测试与吞吐量: Tools/sim/referee_bench.c
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#include "referee.h"
+#include <stddef.h>
+#include <string.h>
+#include "crc.h"
+
+/*命令码 -> 目标结构体*/
+typedef struct
+{
+    uint16_t cmd_id;
+    uint16_t size;
+    uint16_t offset;    //在referee_data_t中的偏移
+} referee_cmd_t;
+
+static const referee_cmd_t referee_cmd_table[REFEREE_CMD_NUM] =
+{
+    {REFEREE_GAME_STATUS_CMD_ID, sizeof(referee_game_status_t), offsetof(referee_data_t, game_status)},
+    {REFEREE_GAME_ROBOT_HP_CMD_ID, sizeof(referee_game_robot_HP_t), offsetof(referee_data_t, game_robot_HP)},
+    {REFEREE_ROBOT_STATUS_CMD_ID, sizeof(referee_robot_status_t), offsetof(referee_data_t, robot_status)},
+    {REFEREE_POWER_HEAT_CMD_ID, sizeof(referee_power_heat_t), offsetof(referee_data_t, power_heat)},
+    {REFEREE_HURT_DATA_CMD_ID, sizeof(referee_hurt_data_t), offsetof(referee_data_t, hurt_data)},
+    {REFEREE_SHOOT_DATA_CMD_ID, sizeof(referee_shoot_data_t), offsetof(referee_data_t, shoot_data)},
+};
+
+/**
+  * @brief          在环形缓冲区中寻找SOF
+  * @param[in]      ring: 环形缓冲区
+  * @param[in]      mask: 缓冲区长度-1
+  * @param[in]      start: 起始读指针
+  * @param[in]      len: 搜索长度
+  * @retval         SOF相对start的位置, 没有找到时返回len
+  */
+static uint16_t referee_find_sof(const uint8_t *ring, uint16_t mask, uint32_t start, uint16_t len)
+{
+    uint16_t offset = (uint16_t)(start & mask);
+    uint16_t first = (uint16_t)(mask + 1u - offset);
+    const uint8_t *p;
+
+    if (first > len)
+    {
+        first = len;
+    }
+    p = memchr(&ring[offset], REFEREE_SOF, first);
+    if (p != NULL)
+    {
+        return (uint16_t)(p - &ring[offset]);
+    }
+    if (first == len)
+    {
+        return len;
+    }
+    //回绕后的第二段
+    p = memchr(ring, REFEREE_SOF, len - first);
+    if (p != NULL)
+    {
+        return (uint16_t)(first + (p - ring));
+    }
+    return len;
+}
+
+/**
+  * @brief          从环形缓冲区拷贝数据, 处理回绕
+  * @param[out]     dst: 目标
+  * @param[in]      ring: 环形缓冲区
+  * @param[in]      mask: 缓冲区长度-1
+  * @param[in]      start: 起始读指针
+  * @param[in]      len: 长度
+  * @retval         none
+  */
+static void referee_ring_copy(uint8_t *dst, const uint8_t *ring, uint16_t mask, uint32_t start, uint16_t len)
+{
+    uint16_t offset = (uint16_t)(start & mask);
+    uint16_t first = (uint16_t)(mask + 1u - offset);
+
+    if (first >= len)
+    {
+        memcpy(dst, &ring[offset], len);
+    }
+    else
+    {
+        memcpy(dst, &ring[offset], first);
+        memcpy(dst + first, ring, len - first);
+    }
+}
+
+/**
+  * @brief          计算环形缓冲区中一段数据的CRC16, 回绕时分两段计算
+  * @param[in]      ring: 环形缓冲区
+  * @param[in]      mask: 缓冲区长度-1
+  * @param[in]      start: 起始读指针
+  * @param[in]      len: 长度
+  * @retval         CRC16
+  */
+static uint16_t referee_ring_crc16(const uint8_t *ring, uint16_t mask, uint32_t start, uint16_t len)
+{
+    uint16_t offset = (uint16_t)(start & mask);
+    uint16_t first = (uint16_t)(mask + 1u - offset);
+    uint16_t crc16;
+
+    if (first >= len)
+    {
+        return get_CRC16_check_sum(&ring[offset], len, CRC16_INIT);
+    }
+    crc16 = get_CRC16_check_sum(&ring[offset], first, CRC16_INIT);
+    return get_CRC16_check_sum(ring, len - first, crc16);
+}
+
+/**
+  * @brief          按命令码把数据段拷贝到对应结构体
+  * @param[in,out]  ref: 解析器
+  * @param[in]      cmd_id: 命令码
+  * @param[in]      ring: 环形缓冲区
+  * @param[in]      mask: 缓冲区长度-1
+  * @param[in]      start: 数据段起始读指针
+  * @param[in]      data_len: 数据段长度
+  * @retval         none
+  */
+static void referee_dispatch(referee_t *ref, uint16_t cmd_id, const uint8_t *ring, uint16_t mask, uint32_t start, uint16_t data_len)
+{
+    uint8_t i;
+
+    for (i = 0; i < REFEREE_CMD_NUM; i++)
+    {
+        if (referee_cmd_table[i].cmd_id == cmd_id)
+        {
+            break;
+        }
+    }
+    if (i == REFEREE_CMD_NUM)
+    {
+        ref->unknown_cmd++;
+        return;
+    }
+    if (data_len < referee_cmd_table[i].size)
+    {
+        ref->size_error++;
+        return;
+    }
+
+    referee_ring_copy((uint8_t *)&ref->data + referee_cmd_table[i].offset, ring, mask, start, referee_cmd_table[i].size);
+    ref->update_flag |= REFEREE_UPDATE(i);
+    ref->update_count[i]++;
+}
+
+void referee_init(referee_t *ref)
+{
+    memset(ref, 0, sizeof(referee_t));
+}
+
+uint16_t referee_unpack(referee_t *ref, const uint8_t *ring, uint16_t ring_len, uint32_t read_count, uint16_t len)
+{
+    uint16_t mask = ring_len - 1u;
+    uint16_t pos = 0;
+    uint16_t skip;
+    uint16_t data_len;
+    uint16_t frame_len;
+    uint16_t crc16;
+    uint8_t header[REFEREE_HEADER_LEN + REFEREE_CMD_ID_LEN];
+    uint8_t tail[REFEREE_TAIL_LEN];
+
+    if (ref == NULL || ring == NULL || ring_len == 0)
+    {
+        return 0;
+    }
+
+    while (len - pos >= REFEREE_HEADER_LEN)
+    {
+        //丢弃SOF之前的字节
+        skip = referee_find_sof(ring, mask, read_count + pos, len - pos);
+        if (skip != 0)
+        {
+            ref->skip_bytes += skip;
+            pos += skip;
+            continue;
+        }
+
+        referee_ring_copy(header, ring, mask, read_count + pos, REFEREE_HEADER_LEN);
+        if (get_CRC8_check_sum(header, REFEREE_HEADER_LEN - 1u, CRC8_INIT) != header[REFEREE_HEADER_LEN - 1u])
+        {
+            ref->header_error++;
+            ref->skip_bytes++;
+            pos++;
+            continue;
+        }
+        data_len = (uint16_t)(header[1] | (header[2] << 8));
+        if (data_len > REFEREE_DATA_MAX_LEN)
+        {
+            ref->length_error++;
+            ref->skip_bytes++;
+            pos++;
+            continue;
+        }
+
+        //帧不完整 等待后续数据
+        frame_len = (uint16_t)REFEREE_FRAME_LEN(data_len);
+        if (len - pos < frame_len)
+        {
+            break;
+        }
+
+        crc16 = referee_ring_crc16(ring, mask, read_count + pos, frame_len - REFEREE_TAIL_LEN);
+        referee_ring_copy(tail, ring, mask, read_count + pos + frame_len - REFEREE_TAIL_LEN, REFEREE_TAIL_LEN);
+        if ((crc16 & 0xFF) != tail[0] || (crc16 >> 8) != tail[1])
+        {
+            ref->crc16_error++;
+            ref->skip_bytes++;
+            pos++;
+            continue;
+        }
+
+        referee_ring_copy(&header[REFEREE_HEADER_LEN], ring, mask, read_count + pos + REFEREE_HEADER_LEN, REFEREE_CMD_ID_LEN);
+        referee_dispatch(ref, (uint16_t)(header[REFEREE_HEADER_LEN] | (header[REFEREE_HEADER_LEN + 1] << 8)),
+                         ring, mask, read_count + pos + REFEREE_HEADER_LEN + REFEREE_CMD_ID_LEN, data_len);
+        ref->frame_count++;
+        pos += frame_len;
+    }
+
+    return pos;
+}
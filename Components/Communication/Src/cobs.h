@@ -0,0 +1,45 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       cobs.c/h
+  * @brief      COBS(Consistent Overhead Byte Stuffing)编解码，
+  *             编码后数据不含0x00，以0x00作为帧分隔符，丢字节后可在下一个0x00处重新同步。
+  * @note       编码开销每254字节最多1字节。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    编码输出缓冲区长度至少为 COBS_ENCODE_MAX_LEN(len)
+    发送时在编码数据后追加一个0x00作为帧尾
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef COBS_H
+#define COBS_H
+
+#include "struct_typedef.h"
+
+//编码后最大长度(不含帧尾0x00)
+#define COBS_ENCODE_MAX_LEN(len) ((len) + ((len) / 254u) + 1u)
+
+/**
+  * @brief          COBS编码
+  * @param[in]      src: 原始数据
+  * @param[in]      len: 原始数据长度
+  * @param[out]     dst: 编码输出, 不能与src重叠
+  * @retval         编码后长度(不含帧尾0x00)
+  */
+extern uint16_t cobs_encode(const uint8_t *src, uint16_t len, uint8_t *dst);
+
+/**
+  * @brief          COBS解码
+  * @param[in]      src: 编码数据(不含帧尾0x00)
+  * @param[in]      len: 编码数据长度
+  * @param[out]     dst: 解码输出, 可以与src相同(原地解码)
+  * @retval         解码后长度, 数据非法时返回0
+  */
+extern uint16_t cobs_decode(const uint8_t *src, uint16_t len, uint8_t *dst);
+
+#endif
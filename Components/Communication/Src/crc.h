@@ -0,0 +1,79 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       crc.c/h
+  * @brief      查表法CRC校验，CRC8与CRC16与裁判系统协议一致
+  *             CRC8: 多项式0x31反射, 初值0xFF, 无结果异或, "123456789"校验值0x0B
+  *             CRC16: 多项式0x1021反射, 初值0xFFFF, 无结果异或, "123456789"校验值0x6F91
+  * @note       查表法每字节一次查表，表放在flash中。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.1.0     Oct-19-2026     ICBK            1. 增加CRC8, 用于裁判系统帧头校验
+  *
+  @verbatim
+  ==============================================================================
+    帧头末尾1字节为CRC8, 数据末尾2字节为CRC16, 小端
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef CRC_H
+#define CRC_H
+
+#include "struct_typedef.h"
+
+#define CRC8_INIT 0xFF
+#define CRC16_INIT 0xFFFF
+
+/**
+  * @brief          计算CRC8
+  * @param[in]      data: 数据
+  * @param[in]      len: 数据长度
+  * @param[in]      crc8: 初值, 一般为CRC8_INIT, 分段计算时传入上一段结果
+  * @retval         CRC8
+  */
+extern uint8_t get_CRC8_check_sum(const uint8_t *data, uint32_t len, uint8_t crc8);
+
+/**
+  * @brief          校验数据末尾的CRC8
+  * @param[in]      data: 数据(含末尾1字节CRC8)
+  * @param[in]      len: 数据总长度
+  * @retval         1:校验通过 0:校验失败
+  */
+extern bool_t verify_CRC8_check_sum(const uint8_t *data, uint32_t len);
+
+/**
+  * @brief          在数据末尾填入CRC8
+  * @param[in,out]  data: 数据, 末尾1字节用于存放CRC8
+  * @param[in]      len: 数据总长度(含末尾1字节)
+  * @retval         none
+  */
+extern void append_CRC8_check_sum(uint8_t *data, uint32_t len);
+
+
+/**
+  * @brief          计算CRC16
+  * @param[in]      data: 数据
+  * @param[in]      len: 数据长度
+  * @param[in]      crc16: 初值, 一般为CRC16_INIT, 分段计算时传入上一段结果
+  * @retval         CRC16
+  */
+extern uint16_t get_CRC16_check_sum(const uint8_t *data, uint32_t len, uint16_t crc16);
+
+/**
+  * @brief          校验数据末尾的CRC16
+  * @param[in]      data: 数据(含末尾2字节CRC16)
+  * @param[in]      len: 数据总长度
+  * @retval         1:校验通过 0:校验失败
+  */
+extern bool_t verify_CRC16_check_sum(const uint8_t *data, uint32_t len);
+
+/**
+  * @brief          在数据末尾填入CRC16
+  * @param[in,out]  data: 数据, 末尾2字节用于存放CRC16
+  * @param[in]      len: 数据总长度(含末尾2字节)
+  * @retval         none
+  */
+extern void append_CRC16_check_sum(uint8_t *data, uint32_t len);
+
+#endif
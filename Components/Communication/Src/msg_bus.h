@@ -0,0 +1,198 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       msg_bus.c/h
+  * @brief      任务间发布/订阅消息总线，话题静态定义，不使用动态内存。
+  *             每个话题有若干个样本槽(1个发布者1个读者时为三缓冲)，发布者在空闲槽中
+  *             直接写入，订阅者按引用读取最新的完整样本，附带版本号；
+  *             也可为订阅者配置有界队列，按顺序拷贝接收每个样本。
+  * @note       锁只保护槽的索引与计数(目标板关中断，上位机自旋锁)，样本数据的读写在锁外进行，
+  *             关中断时间与消息长度无关；队列订阅者的拷贝在锁内进行，只用于短消息。
+  *             可在中断中发布与读取，不能在中断中使用发布通知以外的RTOS接口。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    定义话题(文件作用域):
+      MSG_BUS_TOPIC_DEFINE(chassis_motor, chassis_motor_msg_t, 1, 1);  //1个发布者 最多1个读者同时占用
+    其他文件访问:
+      MSG_BUS_TOPIC_DECLARE(chassis_motor);  MSG_BUS_TOPIC(chassis_motor)
+
+    发布:
+      msg_bus_publish(MSG_BUS_TOPIC(chassis_motor), &msg);              //拷贝发布
+      p = msg_bus_publish_begin(topic); 写入*p; msg_bus_publish_end(topic, p); //零拷贝发布
+
+    订阅(调度器启动前):
+      msg_bus_subscribe(&sub, MSG_BUS_TOPIC(chassis_motor), NULL, 0, NULL, NULL);
+    读取最新样本:
+      p = msg_bus_acquire(&sub, &version); 使用*p; msg_bus_release(&sub);  //零拷贝
+      msg_bus_read(&sub, &msg, &version);                                 //拷贝
+    队列订阅:
+      static uint64_t queue[MSG_BUS_QUEUE_WORDS(sizeof(msg_t), 8)];
+      msg_bus_subscribe(&sub, topic, queue, 8, NULL, NULL);
+      while(msg_bus_queue_pop(&sub, &msg, &version)) {...}
+    发布通知任务:
+      msg_bus_subscribe(&sub, topic, NULL, 0, msg_bus_notify_signal, osThreadGetId());
+      osSignalWait(MSG_BUS_NOTIFY_SIGNAL, osWaitForever);
+
+    槽数 = 发布者数 + 读者数 + 1: 每个正在写的发布者与每个正在读的订阅者各占用一个槽,
+    另有一个槽保存最新样本, 因此发布总能找到空闲槽, 读者总能拿到最新的完整样本。
+    "读者数"为同时持有样本(acquire到release之间, 或msg_bus_read执行中)的订阅者数量上限。
+    版本号从1开始每次发布加1, 订阅者可由版本号差判断丢失了多少个样本。
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef MSG_BUS_H
+#define MSG_BUS_H
+
+#include "struct_typedef.h"
+
+#define MSG_BUS_SLOT_NONE 0xFFu             //没有样本/未占用槽
+#define MSG_BUS_NOTIFY_SIGNAL 0x0100        //msg_bus_notify_signal设置的任务信号
+
+//消息长度按8字节取整后的字数 槽与队列元素按8字节对齐
+#define MSG_BUS_WORDS(size) (((size) + 7u) / 8u)
+//槽数 = 发布者数 + 读者数 + 1
+#define MSG_BUS_SLOT_NUM(publishers, readers) ((publishers) + (readers) + 1u)
+//队列缓冲区长度(uint64_t个数) 每个元素前8字节保存版本号
+#define MSG_BUS_QUEUE_WORDS(size, depth) ((depth) * (1u + MSG_BUS_WORDS(size)))
+
+struct msg_bus_sub_s;
+
+/**
+  * @brief          发布通知回调, 在发布者上下文(任务或中断)中调用, 应尽量短
+  * @param[in]      user: 订阅时传入的用户数据
+  * @retval         none
+  */
+typedef void (*msg_bus_notify_t)(void *user);
+
+/*话题*/
+typedef struct
+{
+    const char *name;
+    uint16_t size;                  //消息长度
+    uint16_t stride;                //槽间隔 8字节对齐
+    uint8_t slot_num;
+    uint8_t *buf;                   //slot_num个槽
+    uint8_t *slot_state;            //每个槽: 最高位为正在写入 低7位为占用的读者数
+    volatile uint8_t latest;        //最新样本所在槽
+    volatile uint32_t version;      //最新样本版本号 0为尚未发布
+    struct msg_bus_sub_s *sub_list; //订阅者链表
+    uint32_t drop_count;            //没有空闲槽导致发布失败的次数(发布者/读者数超过定义值)
+    volatile uint8_t lock;          //上位机自旋锁 目标板不使用
+} msg_bus_topic_t;
+
+/*订阅者*/
+typedef struct msg_bus_sub_s
+{
+    msg_bus_topic_t *topic;
+    struct msg_bus_sub_s *next;
+    uint32_t version;               //上次读取的版本号
+    uint8_t pinned;                 //当前占用的槽
+
+    uint8_t *queue;                 //队列缓冲区 NULL为不使用队列
+    uint16_t queue_depth;
+    uint32_t queue_head;            //累计写入个数
+    uint32_t queue_tail;            //累计读出个数
+    uint32_t queue_overflow;        //队列满时丢弃的最旧样本数
+
+    msg_bus_notify_t notify;        //发布通知 NULL为不通知
+    void *user;
+} msg_bus_sub_t;
+
+#define MSG_BUS_TOPIC_DEFINE(topic, type, publishers, readers)                                                          \
+    static uint64_t msg_bus_buf_##topic[MSG_BUS_SLOT_NUM(publishers, readers) * MSG_BUS_WORDS(sizeof(type))];           \
+    static uint8_t msg_bus_slot_##topic[MSG_BUS_SLOT_NUM(publishers, readers)];                                         \
+    msg_bus_topic_t msg_bus_topic_##topic = {#topic, sizeof(type), MSG_BUS_WORDS(sizeof(type)) * 8u,                    \
+                                             MSG_BUS_SLOT_NUM(publishers, readers), (uint8_t *)msg_bus_buf_##topic,     \
+                                             msg_bus_slot_##topic, MSG_BUS_SLOT_NONE, 0, NULL, 0, 0}
+#define MSG_BUS_TOPIC_DECLARE(topic) extern msg_bus_topic_t msg_bus_topic_##topic
+#define MSG_BUS_TOPIC(topic) (&msg_bus_topic_##topic)
+
+/**
+  * @brief          订阅话题, 在调度器启动前或发布开始前调用
+  * @param[out]     sub: 订阅者
+  * @param[in]      topic: 话题
+  * @param[in]      queue: 队列缓冲区, 长度MSG_BUS_QUEUE_WORDS(消息长度, queue_depth), NULL为只读取最新样本
+  * @param[in]      queue_depth: 队列深度
+  * @param[in]      notify: 发布通知回调, 可为NULL
+  * @param[in]      user: 回调的用户数据
+  * @retval         none
+  */
+extern void msg_bus_subscribe(msg_bus_sub_t *sub, msg_bus_topic_t *topic, uint64_t *queue, uint16_t queue_depth,
+                              msg_bus_notify_t notify, void *user);
+
+/**
+  * @brief          零拷贝发布 取得一个空闲槽, 写完后调用msg_bus_publish_end
+  * @param[in]      topic: 话题
+  * @retval         槽地址, 8字节对齐; 没有空闲槽返回NULL
+  */
+extern void *msg_bus_publish_begin(msg_bus_topic_t *topic);
+
+/**
+  * @brief          零拷贝发布 提交样本, 成为最新样本并通知订阅者
+  * @param[in]      topic: 话题
+  * @param[in]      msg: msg_bus_publish_begin返回的槽地址
+  * @retval         样本版本号
+  */
+extern uint32_t msg_bus_publish_end(msg_bus_topic_t *topic, void *msg);
+
+/**
+  * @brief          拷贝发布
+  * @param[in]      topic: 话题
+  * @param[in]      data: 消息, 长度为话题的消息长度
+  * @retval         样本版本号, 发布失败返回0
+  */
+extern uint32_t msg_bus_publish(msg_bus_topic_t *topic, const void *data);
+
+/**
+  * @brief          占用并返回最新样本, 使用完后调用msg_bus_release, 期间样本不会被改写;
+  *                 已占用样本时先释放原样本
+  * @param[in,out]  sub: 订阅者
+  * @param[out]     version: 样本版本号, 可为NULL
+  * @retval         样本地址, 尚未发布返回NULL
+  */
+extern const void *msg_bus_acquire(msg_bus_sub_t *sub, uint32_t *version);
+
+/**
+  * @brief          释放msg_bus_acquire占用的样本
+  * @param[in,out]  sub: 订阅者
+  * @retval         none
+  */
+extern void msg_bus_release(msg_bus_sub_t *sub);
+
+/**
+  * @brief          拷贝最新样本
+  * @param[in,out]  sub: 订阅者
+  * @param[out]     data: 消息
+  * @param[out]     version: 样本版本号, 可为NULL
+  * @retval         1:已拷贝 0:尚未发布
+  */
+extern bool_t msg_bus_read(msg_bus_sub_t *sub, void *data, uint32_t *version);
+
+/**
+  * @brief          上次读取后是否有新样本
+  * @param[in]      sub: 订阅者
+  * @retval         1:有新样本
+  */
+extern bool_t msg_bus_updated(const msg_bus_sub_t *sub);
+
+/**
+  * @brief          从队列取出最旧的样本
+  * @param[in,out]  sub: 队列订阅者
+  * @param[out]     data: 消息
+  * @param[out]     version: 样本版本号, 可为NULL
+  * @retval         1:已取出 0:队列为空
+  */
+extern bool_t msg_bus_queue_pop(msg_bus_sub_t *sub, void *data, uint32_t *version);
+
+/**
+  * @brief          发布通知回调 给订阅任务设置MSG_BUS_NOTIFY_SIGNAL信号, 仅目标板
+  * @param[in]      user: 订阅任务的osThreadId
+  * @retval         none
+  */
+extern void msg_bus_notify_signal(void *user);
+
+#endif
@@ -0,0 +1,177 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       referee.c/h
+  * @brief      裁判系统串口协议解析，直接在串口DMA环形缓冲区上逐帧解析，
+  *             帧头CRC8、整帧CRC16校验通过后按命令码拷贝到对应结构体。
+  * @note       解析不拷贝整帧, 只在帧校验通过后把数据段拷贝到目标结构体;
+  *             不完整的帧留在缓冲区中, 下次收到更多数据后再解析。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    帧格式(小端):
+      SOF(0xA5) | data_length(2) | seq(1) | CRC8(1) | cmd_id(2) | data(data_length) | CRC16(2)
+      CRC8校验前4字节, CRC16校验CRC16之前的全部字节
+    错误处理:
+      非SOF字节直接丢弃; 帧头CRC8错误、长度超过REFEREE_DATA_MAX_LEN、CRC16错误时
+      丢弃SOF一个字节, 从下一字节重新寻找SOF
+      数据段比结构体短时不更新(协议版本不一致), 比结构体长时只拷贝结构体长度
+    使用方法:
+      unread = usart_rx_available(rx);
+      used = referee_unpack(&referee, rx->buf[0], rx->buf_len, rx->read_count, unread);
+      usart_rx_consume(rx, used);
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef REFEREE_H
+#define REFEREE_H
+
+#include "struct_typedef.h"
+
+#define REFEREE_SOF 0xA5
+#define REFEREE_HEADER_LEN 5u           //SOF + data_length + seq + CRC8
+#define REFEREE_CMD_ID_LEN 2u
+#define REFEREE_TAIL_LEN 2u             //CRC16
+#define REFEREE_FRAME_LEN(data_len) (REFEREE_HEADER_LEN + REFEREE_CMD_ID_LEN + (data_len) + REFEREE_TAIL_LEN)
+#define REFEREE_DATA_MAX_LEN 128u       //数据段最大长度 超过视为帧头错误
+
+/*命令码 裁判系统串口协议附录*/
+#define REFEREE_GAME_STATUS_CMD_ID 0x0001    //比赛状态 1Hz
+#define REFEREE_GAME_ROBOT_HP_CMD_ID 0x0003  //机器人血量 3Hz
+#define REFEREE_ROBOT_STATUS_CMD_ID 0x0201   //机器人性能体系数据 10Hz
+#define REFEREE_POWER_HEAT_CMD_ID 0x0202     //底盘功率与枪口热量 50Hz
+#define REFEREE_HURT_DATA_CMD_ID 0x0206      //伤害状态 伤害发生后发送
+#define REFEREE_SHOOT_DATA_CMD_ID 0x0207     //实时射击数据 弹丸发射后发送
+
+/*解析的命令 顺序与update_flag的位对应*/
+typedef enum
+{
+    REFEREE_CMD_GAME_STATUS = 0,
+    REFEREE_CMD_GAME_ROBOT_HP,
+    REFEREE_CMD_ROBOT_STATUS,
+    REFEREE_CMD_POWER_HEAT,
+    REFEREE_CMD_HURT_DATA,
+    REFEREE_CMD_SHOOT_DATA,
+    REFEREE_CMD_NUM,
+} referee_cmd_e;
+
+#define REFEREE_UPDATE(cmd) (1u << (cmd))
+
+/*0x0001 比赛状态*/
+typedef __packed struct
+{
+    uint8_t game_type_progress;     //低4位比赛类型 高4位当前比赛阶段
+    uint16_t stage_remain_time;     //当前阶段剩余时间 s
+    uint64_t SyncTimeStamp;         //UNIX时间
+} referee_game_status_t;
+
+/*0x0003 机器人血量*/
+typedef __packed struct
+{
+    uint16_t red_1_robot_HP;
+    uint16_t red_2_robot_HP;
+    uint16_t red_3_robot_HP;
+    uint16_t red_4_robot_HP;
+    uint16_t red_5_robot_HP;
+    uint16_t red_7_robot_HP;
+    uint16_t red_outpost_HP;
+    uint16_t red_base_HP;
+    uint16_t blue_1_robot_HP;
+    uint16_t blue_2_robot_HP;
+    uint16_t blue_3_robot_HP;
+    uint16_t blue_4_robot_HP;
+    uint16_t blue_5_robot_HP;
+    uint16_t blue_7_robot_HP;
+    uint16_t blue_outpost_HP;
+    uint16_t blue_base_HP;
+} referee_game_robot_HP_t;
+
+/*0x0201 机器人性能体系数据*/
+typedef __packed struct
+{
+    uint8_t robot_id;
+    uint8_t robot_level;
+    uint16_t current_HP;
+    uint16_t maximum_HP;
+    uint16_t shooter_barrel_cooling_value;  //枪口每秒冷却值
+    uint16_t shooter_barrel_heat_limit;     //枪口热量上限
+    uint16_t chassis_power_limit;           //底盘功率上限 W
+    uint8_t power_management_output;        //bit0:云台 bit1:底盘 bit2:发射机构 电源输出
+} referee_robot_status_t;
+
+/*0x0202 底盘功率与枪口热量*/
+typedef __packed struct
+{
+    uint16_t chassis_voltage;               //mV
+    uint16_t chassis_current;               //mA
+    fp32 chassis_power;                     //W
+    uint16_t buffer_energy;                 //缓冲能量 J
+    uint16_t shooter_17mm_1_barrel_heat;
+    uint16_t shooter_17mm_2_barrel_heat;
+    uint16_t shooter_42mm_barrel_heat;
+} referee_power_heat_t;
+
+/*0x0206 伤害状态*/
+typedef __packed struct
+{
+    uint8_t armor_id_reason;                //低4位装甲编号 高4位扣血原因
+} referee_hurt_data_t;
+
+/*0x0207 实时射击数据*/
+typedef __packed struct
+{
+    uint8_t bullet_type;
+    uint8_t shooter_number;
+    uint8_t launching_frequency;            //射频 Hz
+    fp32 initial_speed;                     //弹丸初速度 m/s
+} referee_shoot_data_t;
+
+/*解析得到的数据*/
+typedef struct
+{
+    referee_game_status_t game_status;
+    referee_game_robot_HP_t game_robot_HP;
+    referee_robot_status_t robot_status;
+    referee_power_heat_t power_heat;
+    referee_hurt_data_t hurt_data;
+    referee_shoot_data_t shoot_data;
+} referee_data_t;
+
+/*解析器*/
+typedef struct
+{
+    referee_data_t data;            //各命令最近一次的数据
+    uint32_t update_flag;           //REFEREE_UPDATE(cmd) 解析到对应命令时置位 由使用者清除
+    uint32_t update_count[REFEREE_CMD_NUM];
+
+    uint32_t frame_count;           //校验通过的帧数
+    uint32_t skip_bytes;            //丢弃的字节数(寻找SOF 或校验失败后重新同步)
+    uint32_t header_error;          //帧头CRC8错误
+    uint32_t length_error;          //数据长度超过REFEREE_DATA_MAX_LEN
+    uint32_t crc16_error;           //整帧CRC16错误
+    uint32_t unknown_cmd;           //校验通过但不解析的命令码
+    uint32_t size_error;            //数据段比结构体短
+} referee_t;
+
+/**
+  * @brief          解析器初始化, 清零数据与统计
+  * @param[out]     ref: 解析器
+  * @retval         none
+  */
+extern void referee_init(referee_t *ref);
+
+/**
+  * @brief          解析环形缓冲区中的未读数据, 不完整的帧不消耗
+  * @param[in,out]  ref: 解析器
+  * @param[in]      ring: 环形缓冲区
+  * @param[in]      ring_len: 缓冲区长度, 2的幂, 不小于最长帧
+  * @param[in]      read_count: 读指针(累计读取字节数, 按ring_len取模得到位置)
+  * @param[in]      len: 未读字节数
+  * @retval         已处理的字节数(完整帧与丢弃的字节), 调用者据此移动读指针
+  */
+extern uint16_t referee_unpack(referee_t *ref, const uint8_t *ring, uint16_t ring_len, uint32_t read_count, uint16_t len);
+
+#endif
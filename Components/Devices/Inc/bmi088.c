@@ -0,0 +1,524 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       bmi088.c/h
+  * @brief      BMI088六轴IMU(加速度计+陀螺仪)驱动，配置两个传感器的FIFO，
+  *             每次数据就绪中断成批读出FIFO，解析为带时间戳的样本。
+  * @note       寄存器地址与取值见BMI088数据手册(BST-BMI088-DS001)。
+  *             加速度计上电与软复位后处于I2C模式，片选的一次上升沿后切换到SPI，
+  *             SPI读取时加速度计在地址字节后多返回一个空字节，陀螺仪没有。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    加速度计FIFO为带帧头格式:
+      0x84~0x87 数据帧  6字节 x y z
+      0x40      跳过帧  1字节 FIFO满后丢失的帧数
+      0x44      时间帧  3字节 传感器时间
+      0x48      配置帧  1字节
+      0x50      丢弃帧  1字节
+      0x80      FIFO已空
+    陀螺仪FIFO无帧头, 每帧6字节 x y z
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#include <stddef.h>
+#include <string.h>
+#include "bsp_imu.h"
+#include "bmi088.h"
+
+/*加速度计寄存器*/
+#define ACC_CHIP_ID         0x00u
+#define ACC_FIFO_LENGTH_0   0x24u
+#define ACC_FIFO_DATA       0x26u
+#define ACC_TEMP_MSB        0x22u
+#define ACC_CONF            0x40u
+#define ACC_RANGE           0x41u
+#define ACC_FIFO_DOWNS      0x45u
+#define ACC_FIFO_CONFIG_0   0x48u
+#define ACC_FIFO_CONFIG_1   0x49u
+#define ACC_PWR_CONF        0x7Cu
+#define ACC_PWR_CTRL        0x7Du
+#define ACC_SOFTRESET       0x7Eu
+
+#define ACC_CONF_1600HZ     0xACu   //正常滤波 1600Hz
+#define ACC_FIFO_DOWNS_VAL  0x80u   //不降采样 bit7必须为1
+#define ACC_FIFO_STREAM     0x02u   //流模式 bit1必须为1
+#define ACC_FIFO_ACC_EN     0x50u   //加速度数据进入FIFO bit4必须为1
+#define ACC_PWR_ACTIVE      0x00u
+#define ACC_PWR_ON          0x04u
+
+/*陀螺仪寄存器*/
+#define GYRO_CHIP_ID        0x00u
+#define GYRO_FIFO_STATUS    0x0Eu
+#define GYRO_RANGE          0x0Fu
+#define GYRO_BANDWIDTH      0x10u
+#define GYRO_LPM1           0x11u
+#define GYRO_SOFTRESET      0x14u
+#define GYRO_INT_CTRL       0x15u
+#define GYRO_INT3_INT4_CONF 0x16u
+#define GYRO_INT3_INT4_MAP  0x18u
+#define GYRO_FIFO_WM_EN     0x1Eu
+#define GYRO_FIFO_CONFIG_0  0x3Du
+#define GYRO_FIFO_CONFIG_1  0x3Eu
+#define GYRO_FIFO_DATA      0x3Fu
+
+#define GYRO_BW_2000HZ      0x01u   //2000Hz 带宽230Hz 回读时bit7为1
+#define GYRO_LPM_NORMAL     0x00u
+#define GYRO_INT_FIFO       0x40u   //FIFO中断
+#define GYRO_INT3_PP_HIGH   0x01u   //INT3推挽 高有效
+#define GYRO_INT3_FIFO      0x04u   //FIFO中断映射到INT3
+#define GYRO_FIFO_WM_ON     0x88u
+#define GYRO_FIFO_STREAM    0x80u
+#define GYRO_FIFO_OVERRUN   0x80u
+#define GYRO_FIFO_COUNT     0x7Fu
+
+#define SOFTRESET_CMD       0xB6u
+#define ACCEL_RESET_DELAY_MS 1u
+#define GYRO_RESET_DELAY_MS 30u
+
+#define BMI088_GRAVITY      9.80665f
+#define BMI088_DEG_TO_RAD   0.01745329252f
+
+//时钟校正: 相位按误差的1/4 采样间隔按误差/(帧数*16)
+#define GYRO_PHASE_GAIN     0.25f
+#define GYRO_PERIOD_GAIN    0.0625f
+#define GYRO_PERIOD_TOL     0.05f   //采样间隔偏离标称值的上限
+
+/*写入并回读校验的寄存器*/
+typedef struct
+{
+    uint8_t reg;
+    uint8_t value;
+    uint8_t mask;       //回读比较的位 0为不回读(只写寄存器)
+} bmi088_reg_write_t;
+
+static void bmi088_transfer_count(bmi088_t *imu, uint16_t bytes)
+{
+    imu->transfer_count++;
+    imu->transfer_bytes += bytes;
+}
+
+//加速度计读取 去掉空字节
+static void bmi088_accel_read(bmi088_t *imu, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    uint8_t tmp[8];
+
+    bsp_imu_read(BSP_IMU_ACCEL, reg, tmp, (uint16_t)(len + 1u));
+    memcpy(buf, tmp + 1, len);
+    bmi088_transfer_count(imu, (uint16_t)(len + 2u));
+}
+
+static uint8_t bmi088_accel_read_reg(bmi088_t *imu, uint8_t reg)
+{
+    uint8_t value;
+
+    bmi088_accel_read(imu, reg, &value, 1);
+    return value;
+}
+
+static uint8_t bmi088_gyro_read_reg(bmi088_t *imu, uint8_t reg)
+{
+    uint8_t value;
+
+    bsp_imu_read(BSP_IMU_GYRO, reg, &value, 1);
+    bmi088_transfer_count(imu, 2);
+    return value;
+}
+
+//依次写入 每次写后等待1ms再回读
+static bool_t bmi088_write_verify(bmi088_t *imu, bsp_imu_cs_e cs, const bmi088_reg_write_t *list, uint8_t num)
+{
+    uint8_t i;
+    uint8_t value;
+
+    for (i = 0; i < num; i++)
+    {
+        bsp_imu_write(cs, list[i].reg, list[i].value);
+        bmi088_transfer_count(imu, 2);
+        bsp_imu_delay_ms(1);
+        if (list[i].mask == 0)
+        {
+            continue;
+        }
+        value = (cs == BSP_IMU_ACCEL) ? bmi088_accel_read_reg(imu, list[i].reg) : bmi088_gyro_read_reg(imu, list[i].reg);
+        if ((value & list[i].mask) != (list[i].value & list[i].mask))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static bmi088_error_e bmi088_accel_init(bmi088_t *imu, uint8_t range)
+{
+    const bmi088_reg_write_t config[] =
+    {
+        {ACC_PWR_CTRL, ACC_PWR_ON, 0xFF},
+        {ACC_PWR_CONF, ACC_PWR_ACTIVE, 0xFF},
+        {ACC_CONF, ACC_CONF_1600HZ, 0xFF},
+        {ACC_RANGE, range, 0x03},
+        {ACC_FIFO_DOWNS, ACC_FIFO_DOWNS_VAL, 0xF0},
+        {ACC_FIFO_CONFIG_0, ACC_FIFO_STREAM, 0x03},
+        {ACC_FIFO_CONFIG_1, ACC_FIFO_ACC_EN, 0x5C},
+    };
+
+    //第一次读取切换到SPI模式 结果无效
+    bmi088_accel_read_reg(imu, ACC_CHIP_ID);
+    bsp_imu_delay_ms(1);
+    if (bmi088_accel_read_reg(imu, ACC_CHIP_ID) != BMI088_ACCEL_CHIP_ID)
+    {
+        return BMI088_ACCEL_ID_ERROR;
+    }
+
+    bsp_imu_write(BSP_IMU_ACCEL, ACC_SOFTRESET, SOFTRESET_CMD);
+    bmi088_transfer_count(imu, 2);
+    bsp_imu_delay_ms(ACCEL_RESET_DELAY_MS);
+    //软复位后回到I2C模式
+    bmi088_accel_read_reg(imu, ACC_CHIP_ID);
+    bsp_imu_delay_ms(1);
+    if (bmi088_accel_read_reg(imu, ACC_CHIP_ID) != BMI088_ACCEL_CHIP_ID)
+    {
+        return BMI088_ACCEL_ID_ERROR;
+    }
+
+    if (!bmi088_write_verify(imu, BSP_IMU_ACCEL, config, (uint8_t)(sizeof(config) / sizeof(config[0]))))
+    {
+        return BMI088_ACCEL_CONFIG_ERROR;
+    }
+    return BMI088_NO_ERROR;
+}
+
+static bmi088_error_e bmi088_gyro_init(bmi088_t *imu, uint8_t range, uint8_t fifo_batch)
+{
+    const bmi088_reg_write_t config[] =
+    {
+        {GYRO_RANGE, range, 0x07},
+        {GYRO_BANDWIDTH, GYRO_BW_2000HZ, 0x0F},
+        {GYRO_LPM1, GYRO_LPM_NORMAL, 0xFF},
+        {GYRO_FIFO_CONFIG_1, GYRO_FIFO_STREAM, 0xC0},
+        {GYRO_FIFO_CONFIG_0, fifo_batch, 0x7F},
+        {GYRO_FIFO_WM_EN, GYRO_FIFO_WM_ON, 0xFF},
+        {GYRO_INT3_INT4_CONF, GYRO_INT3_PP_HIGH, 0x03},
+        {GYRO_INT3_INT4_MAP, GYRO_INT3_FIFO, 0xFF},
+        {GYRO_INT_CTRL, GYRO_INT_FIFO, 0},
+    };
+
+    if (bmi088_gyro_read_reg(imu, GYRO_CHIP_ID) != BMI088_GYRO_CHIP_ID)
+    {
+        return BMI088_GYRO_ID_ERROR;
+    }
+
+    bsp_imu_write(BSP_IMU_GYRO, GYRO_SOFTRESET, SOFTRESET_CMD);
+    bmi088_transfer_count(imu, 2);
+    bsp_imu_delay_ms(GYRO_RESET_DELAY_MS);
+    if (bmi088_gyro_read_reg(imu, GYRO_CHIP_ID) != BMI088_GYRO_CHIP_ID)
+    {
+        return BMI088_GYRO_ID_ERROR;
+    }
+
+    if (!bmi088_write_verify(imu, BSP_IMU_GYRO, config, (uint8_t)(sizeof(config) / sizeof(config[0]))))
+    {
+        return BMI088_GYRO_CONFIG_ERROR;
+    }
+    return BMI088_NO_ERROR;
+}
+
+bmi088_error_e bmi088_init(bmi088_t *imu, uint16_t gyro_range_dps, uint8_t accel_range_g, uint8_t fifo_batch)
+{
+    uint8_t gyro_range;
+    uint8_t accel_range;
+    bmi088_error_e error;
+
+    memset(imu, 0, sizeof(bmi088_t));
+
+    //量程寄存器: 陀螺仪 0:2000 1:1000 2:500 3:250 4:125dps; 加速度计 0:3 1:6 2:12 3:24g
+    for (gyro_range = 0; gyro_range <= 4u; gyro_range++)
+    {
+        if ((2000u >> gyro_range) == gyro_range_dps)
+        {
+            break;
+        }
+    }
+    for (accel_range = 0; accel_range <= 3u; accel_range++)
+    {
+        if ((3u << accel_range) == accel_range_g)
+        {
+            break;
+        }
+    }
+    if (gyro_range > 4u || accel_range > 3u || fifo_batch == 0 || fifo_batch > BMI088_GYRO_FIFO_FRAMES / 2u)
+    {
+        return BMI088_PARAM_ERROR;
+    }
+
+    imu->gyro_scale = (fp32)gyro_range_dps / 32768.0f * BMI088_DEG_TO_RAD;
+    imu->accel_scale = (fp32)accel_range_g / 32768.0f * BMI088_GRAVITY;
+    imu->fifo_batch = fifo_batch;
+    imu->gyro_period_us = 1000000.0f / (fp32)BMI088_GYRO_ODR_HZ;
+    imu->accel_period_us = 1000000.0f / (fp32)BMI088_ACCEL_ODR_HZ;
+    imu->temp = 25.0f;
+
+    error = bmi088_accel_init(imu, accel_range);
+    if (error != BMI088_NO_ERROR)
+    {
+        return error;
+    }
+    error = bmi088_gyro_init(imu, gyro_range, fifo_batch);
+    if (error != BMI088_NO_ERROR)
+    {
+        return error;
+    }
+    bmi088_temp_update(imu);
+    return BMI088_NO_ERROR;
+}
+
+void bmi088_temp_comp_set(bmi088_t *imu, bmi088_temp_comp_t comp, void *user)
+{
+    imu->temp_comp = comp;
+    imu->temp_comp_user = user;
+}
+
+fp32 bmi088_temp_update(bmi088_t *imu)
+{
+    uint8_t buf[2];
+    int16_t raw;
+
+    //11位补码 0.125℃每LSB 0对应23℃
+    bmi088_accel_read(imu, ACC_TEMP_MSB, buf, 2);
+    raw = (int16_t)(((uint16_t)buf[0] << 3) | (buf[1] >> 5));
+    if (raw > 1023)
+    {
+        raw -= 2048;
+    }
+    imu->temp = (fp32)raw * 0.125f + 23.0f;
+    return imu->temp;
+}
+
+uint16_t bmi088_gyro_fifo_start(bmi088_t *imu)
+{
+    uint8_t status;
+    uint16_t frames;
+
+    status = bmi088_gyro_read_reg(imu, GYRO_FIFO_STATUS);
+    if (status & GYRO_FIFO_OVERRUN)
+    {
+        //已覆盖的帧无法确定时间 写FIFO_CONFIG_1清空FIFO与溢出标志 下次中断重新对齐采样时钟
+        imu->gyro_overrun_count++;
+        bsp_imu_write(BSP_IMU_GYRO, GYRO_FIFO_CONFIG_1, GYRO_FIFO_STREAM);
+        bmi088_transfer_count(imu, 2);
+        imu->gyro_time_valid = 0;
+        return 0;
+    }
+    frames = status & GYRO_FIFO_COUNT;
+    if (frames > BMI088_GYRO_FIFO_FRAMES)
+    {
+        frames = BMI088_GYRO_FIFO_FRAMES;
+    }
+    if (frames == 0)
+    {
+        return 0;
+    }
+
+    imu->gyro_len = (uint16_t)(frames * BMI088_GYRO_FRAME_LEN);
+    if (!bsp_imu_read_dma(BSP_IMU_GYRO, GYRO_FIFO_DATA, imu->gyro_buf, imu->gyro_len))
+    {
+        imu->gyro_len = 0;
+        return 0;
+    }
+    bmi088_transfer_count(imu, (uint16_t)(imu->gyro_len + 1u));
+    return frames;
+}
+
+//按水位中断时间校正采样时钟: 中断时FIFO中恰好有fifo_batch帧, 即本批第fifo_batch帧的采样时间
+static void bmi088_gyro_clock_update(bmi088_t *imu, uint32_t int_time_us)
+{
+    fp32 nominal = 1000000.0f / (fp32)BMI088_GYRO_ODR_HZ;
+    fp32 predicted = (fp32)(imu->fifo_batch - 1u) * imu->gyro_period_us + imu->gyro_next_frac_us;
+    fp32 error = (fp32)(int32_t)(int_time_us - imu->gyro_next_time_us) - predicted;
+    fp32 shift;
+
+    if (!imu->gyro_time_valid || error > 2.0f * nominal || error < -2.0f * nominal)
+    {
+        //第一次或偏差过大(漏读中断、FIFO溢出) 直接对齐
+        if (imu->gyro_time_valid)
+        {
+            imu->gyro_resync_count++;
+        }
+        imu->gyro_next_time_us = int_time_us - (uint32_t)((fp32)(imu->fifo_batch - 1u) * imu->gyro_period_us);
+        imu->gyro_next_frac_us = 0.0f;
+        imu->gyro_time_valid = 1;
+        return;
+    }
+
+    imu->gyro_period_us += error * GYRO_PERIOD_GAIN / (fp32)imu->fifo_batch;
+    if (imu->gyro_period_us > nominal * (1.0f + GYRO_PERIOD_TOL))
+    {
+        imu->gyro_period_us = nominal * (1.0f + GYRO_PERIOD_TOL);
+    }
+    else if (imu->gyro_period_us < nominal * (1.0f - GYRO_PERIOD_TOL))
+    {
+        imu->gyro_period_us = nominal * (1.0f - GYRO_PERIOD_TOL);
+    }
+
+    shift = imu->gyro_next_frac_us + error * GYRO_PHASE_GAIN;
+    imu->gyro_next_time_us += (uint32_t)(int32_t)shift;
+    imu->gyro_next_frac_us = shift - (fp32)(int32_t)shift;
+}
+
+//下一帧的时间 并推进采样时钟
+static uint32_t bmi088_gyro_clock_next(bmi088_t *imu)
+{
+    uint32_t time_us = imu->gyro_next_time_us;
+    fp32 step = imu->gyro_next_frac_us + imu->gyro_period_us;
+
+    imu->gyro_next_time_us += (uint32_t)step;
+    imu->gyro_next_frac_us = step - (fp32)(uint32_t)step;
+    return time_us;
+}
+
+static void bmi088_sample_convert(bmi088_t *imu, bmi088_sensor_e sensor, const uint8_t *data, bmi088_sample_t *sample)
+{
+    fp32 scale = (sensor == BMI088_GYRO) ? imu->gyro_scale : imu->accel_scale;
+    uint8_t i;
+
+    for (i = 0; i < 3u; i++)
+    {
+        sample->value[i] = (fp32)(int16_t)((uint16_t)data[2u * i] | ((uint16_t)data[2u * i + 1u] << 8)) * scale;
+    }
+    if (imu->temp_comp != NULL)
+    {
+        imu->temp_comp(sensor, imu->temp, sample->value, imu->temp_comp_user);
+    }
+}
+
+uint16_t bmi088_gyro_fifo_parse(bmi088_t *imu, uint32_t int_time_us, bool_t int_valid,
+                                bmi088_sample_t *out, uint16_t max)
+{
+    uint16_t frames = imu->gyro_len / BMI088_GYRO_FRAME_LEN;
+    uint16_t i;
+
+    imu->gyro_len = 0;
+    if (frames == 0)
+    {
+        return 0;
+    }
+    if (int_valid)
+    {
+        bmi088_gyro_clock_update(imu, int_time_us);
+    }
+    else if (!imu->gyro_time_valid)
+    {
+        //还没有中断时间 以读取时间近似
+        imu->gyro_next_time_us = bsp_imu_time_us() - (uint32_t)((fp32)frames * imu->gyro_period_us);
+        imu->gyro_next_frac_us = 0.0f;
+        imu->gyro_time_valid = 1;
+    }
+
+    for (i = 0; i < frames; i++)
+    {
+        uint32_t time_us = bmi088_gyro_clock_next(imu);
+
+        if (i < max)
+        {
+            out[i].time_us = time_us;
+            bmi088_sample_convert(imu, BMI088_GYRO, &imu->gyro_buf[i * BMI088_GYRO_FRAME_LEN], &out[i]);
+        }
+    }
+    imu->gyro_frame_count += frames;
+    return frames < max ? frames : max;
+}
+
+uint16_t bmi088_accel_fifo_start(bmi088_t *imu, uint32_t now_us)
+{
+    uint8_t buf[2];
+    uint16_t fifo_len;
+    uint16_t len;
+
+    bmi088_accel_read(imu, ACC_FIFO_LENGTH_0, buf, 2);
+    fifo_len = (uint16_t)(buf[0] | ((uint16_t)(buf[1] & 0x3Fu) << 8));
+    len = fifo_len < BMI088_ACCEL_READ_MAX ? fifo_len : BMI088_ACCEL_READ_MAX;
+    if (len == 0)
+    {
+        return 0;
+    }
+    //本次读不完时 留在FIFO中的帧比本次读出的更新
+    imu->accel_unread_frames = (uint16_t)((fifo_len - len) / BMI088_ACCEL_FRAME_LEN);
+
+    imu->accel_len = (uint16_t)(len + 1u);
+    imu->accel_read_time_us = now_us;
+    if (!bsp_imu_read_dma(BSP_IMU_ACCEL, ACC_FIFO_DATA, imu->accel_buf, imu->accel_len))
+    {
+        imu->accel_len = 0;
+        return 0;
+    }
+    bmi088_transfer_count(imu, (uint16_t)(imu->accel_len + 1u));
+    return len;
+}
+
+uint16_t bmi088_accel_fifo_parse(bmi088_t *imu, bmi088_sample_t *out, uint16_t max)
+{
+    const uint8_t *p = imu->accel_buf + 1;
+    const uint8_t *end = imu->accel_buf + imu->accel_len;
+    uint16_t num = 0;
+    uint16_t i;
+    uint8_t header;
+    uint8_t len;
+
+    imu->accel_len = 0;
+    while (p < end)
+    {
+        header = *p;
+        if ((header & 0xFCu) == 0x84u)
+        {
+            len = 6u;
+        }
+        else if (header == 0x80u)
+        {
+            break;
+        }
+        else if ((header & 0xFCu) == 0x40u || (header & 0xFCu) == 0x48u || (header & 0xFCu) == 0x50u)
+        {
+            len = 1u;
+        }
+        else if ((header & 0xFCu) == 0x44u)
+        {
+            len = 3u;
+        }
+        else
+        {
+            imu->parse_error_count++;
+            break;
+        }
+        //不完整的帧留在FIFO中 下次重新读出
+        if (end - p < 1 + len)
+        {
+            break;
+        }
+
+        if (len == 6u)
+        {
+            if (num < max)
+            {
+                bmi088_sample_convert(imu, BMI088_ACCEL, p + 1, &out[num]);
+                num++;
+            }
+            imu->accel_frame_count++;
+        }
+        else if ((header & 0xFCu) == 0x40u)
+        {
+            imu->accel_skip_count += p[1];
+        }
+        p += 1u + len;
+    }
+
+    //读取FIFO长度时最新一帧的采样时间在最近一个采样间隔内 取中点
+    for (i = 0; i < num; i++)
+    {
+        out[i].time_us = imu->accel_read_time_us -
+                         (uint32_t)(((fp32)(num - 1u - i + imu->accel_unread_frames) + 0.5f) * imu->accel_period_us);
+    }
+    return num;
+}
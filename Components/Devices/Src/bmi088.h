@@ -0,0 +1,180 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       bmi088.c/h
+  * @brief      BMI088六轴IMU(加速度计+陀螺仪)驱动，配置两个传感器的FIFO，
+  *             每次数据就绪中断成批读出FIFO，解析为带时间戳的样本。
+  * @note       只通过bsp_imu.h访问SPI，上位机用寄存器级的假设备(Tools/sim/sim_bmi088.c)测试。
+  *             陀螺仪FIFO水位中断驱动读取，加速度计FIFO在同一批中读出，不单独使用中断。
+  *             寄存器读写为阻塞传输，FIFO数据用DMA读取，读取完成后再调用解析函数。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    使用(见imu_task.c):
+      bmi088_init(&imu, 2000, 6, 4);               //量程2000dps 6g 每4帧一次水位中断
+      水位中断 -> 记录中断时间
+      n = bmi088_gyro_fifo_start(&imu);            //读FIFO帧数 开始DMA读取n帧
+      等待DMA完成 -> bmi088_gyro_fifo_parse(&imu, 中断时间, 1, samples, max)
+      bmi088_accel_fifo_start / bmi088_accel_fifo_parse 同上
+    时间戳: 陀螺仪按水位中断时间校正采样时钟(相位与采样间隔), 两次中断间按采样间隔推算;
+            加速度计按FIFO长度读取时间推算, 误差不超过半个采样间隔
+    FIFO溢出: 陀螺仪为流模式 满后覆盖最旧帧 读取时清空FIFO并重新对齐采样时钟 记gyro_overrun_count;
+              加速度计满后丢弃最旧帧, 读出时的跳过帧记accel_skip_count
+    温度补偿: bmi088_temp_comp_set注册回调, 每个样本换算为物理量后调用, 温度约每1.28s更新
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef BMI088_H
+#define BMI088_H
+
+#include "struct_typedef.h"
+
+#define BMI088_ACCEL_CHIP_ID      0x1Eu
+#define BMI088_GYRO_CHIP_ID       0x0Fu
+
+#define BMI088_GYRO_ODR_HZ        2000u   //陀螺仪输出频率 带宽230Hz
+#define BMI088_ACCEL_ODR_HZ       1600u   //加速度计输出频率 正常滤波模式
+#define BMI088_GYRO_FIFO_FRAMES   100u    //陀螺仪FIFO容量 帧
+#define BMI088_GYRO_FRAME_LEN     6u      //陀螺仪FIFO帧 x y z
+#define BMI088_ACCEL_FRAME_LEN    7u      //加速度计FIFO数据帧 帧头 + x y z
+#define BMI088_ACCEL_READ_MAX     224u    //加速度计每次最多读取的字节数 其余下次读取
+#define BMI088_SAMPLE_MAX         BMI088_GYRO_FIFO_FRAMES //每次解析最多输出的样本数
+
+/*初始化结果*/
+typedef enum
+{
+    BMI088_NO_ERROR = 0,
+    BMI088_ACCEL_ID_ERROR,        //加速度计ID不符 检查SPI与片选
+    BMI088_GYRO_ID_ERROR,         //陀螺仪ID不符
+    BMI088_ACCEL_CONFIG_ERROR,    //加速度计寄存器回读不符
+    BMI088_GYRO_CONFIG_ERROR,     //陀螺仪寄存器回读不符
+    BMI088_PARAM_ERROR,           //量程或水位参数不支持
+} bmi088_error_e;
+
+typedef enum
+{
+    BMI088_ACCEL = 0,
+    BMI088_GYRO,
+} bmi088_sensor_e;
+
+/*样本 加速度计m/s^2 陀螺仪rad/s 传感器坐标系*/
+typedef struct
+{
+    uint32_t time_us;             //采样时间 bsp_imu_time_us时基
+    fp32 value[3];
+} bmi088_sample_t;
+
+/**
+  * @brief          温度补偿回调, 在解析函数中对每个样本调用
+  * @param[in]      sensor: 传感器
+  * @param[in]      temp: 最近一次读取的温度 ℃
+  * @param[in,out]  value: 样本 可原地修改
+  * @param[in]      user: 注册时传入的用户数据
+  * @retval         none
+  */
+typedef void (*bmi088_temp_comp_t)(bmi088_sensor_e sensor, fp32 temp, fp32 value[3], void *user);
+
+/*驱动状态*/
+typedef struct
+{
+    fp32 gyro_scale;              //rad/s每LSB
+    fp32 accel_scale;             //m/s^2每LSB
+    uint8_t fifo_batch;           //陀螺仪水位 帧
+    fp32 temp;                    //℃
+
+    bmi088_temp_comp_t temp_comp;
+    void *temp_comp_user;
+
+    //陀螺仪采样时钟
+    bool_t gyro_time_valid;
+    uint32_t gyro_next_time_us;   //下一个读出帧的时间
+    fp32 gyro_next_frac_us;       //时间的小数部分
+    fp32 gyro_period_us;          //估计的采样间隔
+    fp32 accel_period_us;
+
+    //DMA读取缓冲区 gyro_len/accel_len为本次请求的长度
+    uint8_t gyro_buf[BMI088_GYRO_FIFO_FRAMES * BMI088_GYRO_FRAME_LEN];
+    uint16_t gyro_len;
+    uint8_t accel_buf[BMI088_ACCEL_READ_MAX + 1u]; //首字节为加速度计读取时的空字节
+    uint16_t accel_len;
+    uint32_t accel_read_time_us;  //读取FIFO长度的时间
+    uint16_t accel_unread_frames; //本次未读出的帧数
+
+    //统计
+    uint32_t gyro_frame_count;
+    uint32_t accel_frame_count;
+    uint32_t gyro_overrun_count;  //陀螺仪FIFO溢出次数
+    uint32_t accel_skip_count;    //加速度计FIFO满后丢失的帧数
+    uint32_t gyro_resync_count;   //采样时钟与中断时间偏差过大 重新对齐的次数
+    uint32_t parse_error_count;   //无法识别的加速度计帧头
+    uint32_t transfer_count;      //SPI传输次数 含DMA
+    uint32_t transfer_bytes;      //SPI传输字节数 含地址与空字节
+} bmi088_t;
+
+/**
+  * @brief          初始化: 检查ID, 软复位, 配置量程、输出频率、FIFO与陀螺仪水位中断, 回读校验;
+  *                 期间调用bsp_imu_delay_ms, 共约100ms
+  * @param[out]     imu: 驱动状态
+  * @param[in]      gyro_range_dps: 陀螺仪量程 2000/1000/500/250/125
+  * @param[in]      accel_range_g: 加速度计量程 3/6/12/24
+  * @param[in]      fifo_batch: 陀螺仪水位中断的帧数 1~BMI088_GYRO_FIFO_FRAMES/2
+  * @retval         bmi088_error_e
+  */
+extern bmi088_error_e bmi088_init(bmi088_t *imu, uint16_t gyro_range_dps, uint8_t accel_range_g, uint8_t fifo_batch);
+
+/**
+  * @brief          注册温度补偿回调
+  * @param[in,out]  imu: 驱动状态
+  * @param[in]      comp: 回调, NULL为不补偿
+  * @param[in]      user: 用户数据
+  * @retval         none
+  */
+extern void bmi088_temp_comp_set(bmi088_t *imu, bmi088_temp_comp_t comp, void *user);
+
+/**
+  * @brief          读取陀螺仪FIFO帧数并开始DMA读取
+  * @param[in,out]  imu: 驱动状态
+  * @retval         读取的帧数, 0为FIFO为空、溢出(已清空)或DMA忙
+  */
+extern uint16_t bmi088_gyro_fifo_start(bmi088_t *imu);
+
+/**
+  * @brief          解析DMA读出的陀螺仪帧
+  * @param[in,out]  imu: 驱动状态
+  * @param[in]      int_time_us: 触发本次读取的水位中断时间, 没有中断(超时轮询)时传入int_valid=0
+  * @param[in]      int_valid: 中断时间是否有效
+  * @param[out]     out: 样本
+  * @param[in]      max: out长度
+  * @retval         样本数
+  */
+extern uint16_t bmi088_gyro_fifo_parse(bmi088_t *imu, uint32_t int_time_us, bool_t int_valid,
+                                       bmi088_sample_t *out, uint16_t max);
+
+/**
+  * @brief          读取加速度计FIFO长度并开始DMA读取
+  * @param[in,out]  imu: 驱动状态
+  * @param[in]      now_us: 当前时间, 作为最新一帧的时间基准
+  * @retval         读取的字节数, 0为FIFO为空或DMA忙
+  */
+extern uint16_t bmi088_accel_fifo_start(bmi088_t *imu, uint32_t now_us);
+
+/**
+  * @brief          解析DMA读出的加速度计帧
+  * @param[in,out]  imu: 驱动状态
+  * @param[out]     out: 样本
+  * @param[in]      max: out长度
+  * @retval         样本数
+  */
+extern uint16_t bmi088_accel_fifo_parse(bmi088_t *imu, bmi088_sample_t *out, uint16_t max);
+
+/**
+  * @brief          读取温度 阻塞
+  * @param[in,out]  imu: 驱动状态
+  * @retval         温度 ℃
+  */
+extern fp32 bmi088_temp_update(bmi088_t *imu);
+
+#endif
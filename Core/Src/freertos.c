@@ -26,6 +26,8 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "bsp_dwt.h"
+#include "task_registry.h"
 
 /* USER CODE END Includes */
 
@@ -49,7 +51,8 @@
 
 /* USER CODE END Variables */
 osThreadId defaultTaskHandle;
-osThreadId ChassisTaskHandle;
+uint32_t defaultTaskBuffer[ 128 ];
+osStaticThreadDef_t defaultTaskControlBlock;
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN FunctionPrototypes */
@@ -57,10 +60,29 @@ osThreadId ChassisTaskHandle;
 /* USER CODE END FunctionPrototypes */
 
 void StartDefaultTask(void const * argument);
-extern void chassis_task(void const * argument);
 
 void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
 
+/* Hook prototypes */
+void configureTimerForRunTimeStats(void);
+unsigned long getRunTimeCounterValue(void);
+
+/* USER CODE BEGIN 1 */
+/* Functions needed when configGENERATE_RUN_TIME_STATS is on */
+//运行时间统计时基 DWT周期计数/64 168MHz下约2.6MHz 32位约27分钟回绕
+#define RUN_TIME_STATS_CYCLE_SHIFT 6
+
+void configureTimerForRunTimeStats(void)
+{
+  dwt_init();
+}
+
+unsigned long getRunTimeCounterValue(void)
+{
+  return (unsigned long)(dwt_cycle64_get() >> RUN_TIME_STATS_CYCLE_SHIFT);
+}
+/* USER CODE END 1 */
+
 /* GetIdleTaskMemory prototype (linked to static allocation support) */
 void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize );
 
@@ -105,15 +127,13 @@ void MX_FREERTOS_Init(void) {
 
   /* Create the thread(s) */
   /* definition and creation of defaultTask */
-  osThreadDef(defaultTask, StartDefaultTask, osPriorityNormal, 0, 128);
+  osThreadStaticDef(defaultTask, StartDefaultTask, osPriorityNormal, 0, 128, defaultTaskBuffer, &defaultTaskControlBlock);
   defaultTaskHandle = osThreadCreate(osThread(defaultTask), NULL);
 
-  /* definition and creation of ChassisTask */
-  osThreadDef(ChassisTask, chassis_task, osPriorityIdle, 0, 128);
-  ChassisTaskHandle = osThreadCreate(osThread(ChassisTask), NULL);
-
   /* USER CODE BEGIN RTOS_THREADS */
   /* add threads, ... */
+  /* 应用任务见task_registry.h的任务表 TCB与栈静态分配 */
+  task_registry_start();
   /* USER CODE END RTOS_THREADS */
 
 }
@@ -128,10 +148,10 @@ void MX_FREERTOS_Init(void) {
 void StartDefaultTask(void const * argument)
 {
   /* USER CODE BEGIN StartDefaultTask */
-  /* Infinite loop */
+  /* 默认任务不使用 删除自身 不再每毫秒切换一次任务 */
+  osThreadTerminate(NULL);
   for(;;)
   {
-    osDelay(1);
   }
   /* USER CODE END StartDefaultTask */
 }
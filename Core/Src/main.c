@@ -27,6 +27,10 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "remote_control.h"
+#include "bsp_dwt.h"
+#include "blackbox.h"
+#include "param.h"
 
 /* USER CODE END Includes */
 
@@ -94,7 +98,13 @@ int main(void)
   MX_CAN1_Init();
   MX_CAN2_Init();
   MX_USART3_UART_Init();
+  MX_USART1_UART_Init();
+  MX_USART6_UART_Init();
   /* USER CODE BEGIN 2 */
+  dwt_init(); //DWT周期计数器 用于执行时间统计
+  blackbox_init(); //黑匣子 热复位后保留已冻结的记录
+  param_init(); //参数从flash载入 控制任务启动前完成
+  remote_control_init(); //遥控器DMA双缓冲接收初始化
 
   /* USER CODE END 2 */
 
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""底盘控制基准测试结果比较 发现控制质量或计算耗时的退化
+
+基准测试见 Tools/sim/chassis_bench.c, 结果为JSON: {用例: {指标: 值}}
+所有指标都是越小越好, 超过 基准值*(1+相对容差)+绝对容差 即为退化, 退出码为1
+仿真是确定性的, 控制质量指标在同一编译器下应完全一致, 容差只用于吸收编译器与数学库差异;
+周期数为本机rdtsc计数, 与机器和负载有关, 使用单独的较大容差, 换机器时用 --no-cycles
+
+用法:
+    python bench_compare.py Tools/sim/bench/baseline.json Tools/sim/build/bench.json
+    python bench_compare.py baseline.json bench.json --cycles-tolerance 0.3
+    python bench_compare.py baseline.json bench.json --no-cycles
+"""
+
+import argparse
+import json
+import sys
+
+# 指标: (相对容差, 绝对容差)
+QUALITY_TOLERANCE = {
+    "rise_ms": (0.05, 2.0),
+    "overshoot_pct": (0.05, 0.5),
+    "settling_ms": (0.05, 10.0),
+    "rms_error_rpm": (0.02, 1.0),
+    "peak_current": (0.02, 100.0),
+    "peak_power_w": (0.05, 5.0),
+    "energy_j": (0.05, 1.0),
+    "drift_mm": (0.10, 5.0),
+}
+CYCLE_METRICS = ["control_cycles_median"]
+
+
+def compare_metric(base, new, rel, abs_tol):
+    """返回 (状态, 变化百分比文本)"""
+    if base is None and new is None:
+        return "ok", ""
+    if new is None:
+        return "REGRESSION", "(未达到)"
+    if base is None:
+        return "improved", "(原未达到)"
+    limit = base * (1.0 + rel) + abs_tol
+    change = "" if base == 0 else "%+.1f%%" % ((new - base) / abs(base) * 100.0)
+    if new > limit:
+        return "REGRESSION", change
+    if new < base - (base * rel + abs_tol):
+        return "improved", change
+    return "ok", change
+
+
+def fmt(value):
+    return "null" if value is None else "%g" % value
+
+
+def main():
+    parser = argparse.ArgumentParser(description="底盘控制基准测试结果比较")
+    parser.add_argument("baseline", help="基准值JSON")
+    parser.add_argument("result", help="本次结果JSON")
+    parser.add_argument("--cycles-tolerance", type=float, default=0.25, help="周期数相对容差 默认0.25")
+    parser.add_argument("--no-cycles", action="store_true", help="不比较周期数")
+    args = parser.parse_args()
+
+    with open(args.baseline, "r", encoding="utf-8") as f:
+        baseline = json.load(f)
+    with open(args.result, "r", encoding="utf-8") as f:
+        result = json.load(f)
+
+    tolerance = dict(QUALITY_TOLERANCE)
+    if not args.no_cycles:
+        for name in CYCLE_METRICS:
+            tolerance[name] = (args.cycles_tolerance, 0.0)
+
+    regressions = 0
+    print("%-8s %-22s %10s %10s %8s  %s" % ("case", "metric", "baseline", "result", "change", "status"))
+    for case, base_metrics in baseline.items():
+        new_metrics = result.get(case)
+        if new_metrics is None:
+            print("%-8s %-22s %10s %10s %8s  %s" % (case, "-", "", "", "", "MISSING"))
+            regressions += 1
+            continue
+        for name, base in base_metrics.items():
+            if name not in tolerance:
+                continue
+            if name not in new_metrics:
+                print("%-8s %-22s %10s %10s %8s  %s" % (case, name, fmt(base), "", "", "MISSING"))
+                regressions += 1
+                continue
+            new = new_metrics[name]
+            status, change = compare_metric(base, new, *tolerance[name])
+            if status == "REGRESSION":
+                regressions += 1
+            print("%-8s %-22s %10s %10s %8s  %s" % (case, name, fmt(base), fmt(new), change, status))
+
+    for case in result:
+        if case not in baseline:
+            print("%-8s 新用例 没有基准值" % case)
+
+    if regressions:
+        print("%d 项退化" % regressions)
+        return 1
+    print("没有退化")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""黑匣子内存镜像解码 输出按时间排序的CSV
+
+内存布局见 Application/Apps/Src/blackbox.h, 镜像为 0x1000C000 起 0x4000 字节:
+    Keil:    SAVE blackbox.hex 0x1000C000,0x10010000      (Intel HEX)
+    OpenOCD: dump_image blackbox.bin 0x1000C000 0x4000    (二进制)
+
+用法:
+    python blackbox_decode.py blackbox.bin -o blackbox.csv
+    python blackbox_decode.py blackbox.hex -o blackbox.csv
+
+CSV每行一条记录: time_ms,lane,index,type,value0..value3,raw
+写到一半被打断(seq不符)的记录计入 torn 并丢弃
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+MAGIC = 0x424B4C42
+VERSION = 1
+BASE_ADDR = 0x1000C000
+REGION_SIZE = 0x4000
+
+LANE_NAMES = ["system", "rc", "chassis", "user"]
+FREEZE_NAMES = ["running", "hardfault", "rc_lost", "trigger", "watchdog"]
+
+HEADER = struct.Struct("<8I")
+RECORD = struct.Struct("<IHBB8s")
+
+# 记录类型: 名称, 数据格式
+TYPES = {
+    0x01: ("freeze", "<II"),
+    0x02: ("fault_reg", "<II"),
+    0x03: ("fault_pc", "<II"),
+    0x10: ("rc_stick", "<4h"),
+    0x11: ("rc_switch", "<BBhHh"),
+    0x20: ("chassis_set", "<ff"),
+    0x21: ("chassis_current", "<4h"),
+    0x22: ("chassis_mode", "<B"),
+}
+
+
+def load_image(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if not data.startswith(b":"):
+        return data
+
+    # Intel HEX 按地址还原为从BASE_ADDR开始的镜像
+    image = bytearray(REGION_SIZE)
+    upper = 0
+    for line in data.decode("ascii").split():
+        record = bytes.fromhex(line[1:])
+        length, address, kind = record[0], (record[1] << 8) | record[2], record[3]
+        payload = record[4:4 + length]
+        if kind == 0x00:
+            offset = upper + address - BASE_ADDR
+            if 0 <= offset and offset + length <= REGION_SIZE:
+                image[offset:offset + length] = payload
+        elif kind == 0x04:
+            upper = ((payload[0] << 8) | payload[1]) << 16
+        elif kind == 0x02:
+            upper = ((payload[0] << 8) | payload[1]) << 4
+    return bytes(image)
+
+
+def decode(image):
+    magic, version, layout, check, boot_count, reason, freeze_time, freeze_boot = HEADER.unpack_from(image, 0)
+    if magic != MAGIC or version != VERSION or check != (~(magic ^ version ^ layout) & 0xFFFFFFFF):
+        raise ValueError("镜像头部无效 magic=0x%08X version=%d" % (magic, version))
+
+    lane_num = layout >> 16
+    record_num = layout & 0xFFFF
+    heads = struct.unpack_from("<%dI" % lane_num, image, HEADER.size)
+    base = HEADER.size + 4 * lane_num
+
+    info = {
+        "boot_count": boot_count,
+        "freeze_reason": FREEZE_NAMES[reason] if reason < len(FREEZE_NAMES) else str(reason),
+        "freeze_time_ms": freeze_time,
+        "freeze_boot": freeze_boot,
+        "torn": 0,
+    }
+
+    rows = []
+    for lane, head in enumerate(heads):
+        start = max(0, head - record_num)
+        for index in range(start, head):
+            offset = base + (lane * record_num + index % record_num) * RECORD.size
+            time_ms, seq, kind, length, data = RECORD.unpack_from(image, offset)
+            if seq != ((index + 1) & 0xFFFF):
+                info["torn"] += 1
+                continue
+            name, fmt = TYPES.get(kind, ("0x%02X" % kind, None))
+            values = []
+            if fmt is not None and struct.calcsize(fmt) <= length:
+                values = list(struct.unpack_from(fmt, data))
+            rows.append((time_ms, lane, index, name, values, data[:length].hex()))
+
+    rows.sort(key=lambda row: (row[0], row[1], row[2]))
+    return info, rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description="黑匣子内存镜像解码")
+    parser.add_argument("image", help="0x1000C000起的内存镜像 .bin 或 .hex")
+    parser.add_argument("-o", "--output", default="blackbox.csv", help="输出CSV")
+    args = parser.parse_args()
+
+    try:
+        info, rows = decode(load_image(args.image))
+    except (OSError, ValueError, struct.error) as error:
+        print(error, file=sys.stderr)
+        return 1
+
+    with open(args.output, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["time_ms", "lane", "index", "type", "value0", "value1", "value2", "value3", "value4", "raw"])
+        for time_ms, lane, index, name, values, raw in rows:
+            values = ["%.6g" % v if isinstance(v, float) else v for v in values]
+            values += [""] * (5 - len(values))
+            lane_name = LANE_NAMES[lane] if lane < len(LANE_NAMES) else str(lane)
+            writer.writerow([time_ms, lane_name, index, name] + values + [raw])
+
+    print("boot %d, 冻结原因 %s, 冻结时间 %d ms (boot %d), 记录 %d 条, 未写完 %d 条" %
+          (info["boot_count"], info["freeze_reason"], info["freeze_time_ms"], info["freeze_boot"],
+           len(rows), info["torn"]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,250 @@
+#!/usr/bin/env python3
+"""调参工具 通过调试串口读取、修改、保存参数
+
+协议见 Application/Apps/Src/tuning.h, 帧格式与遥测相同:
+    COBS(负载 + CRC16) + 0x00, 串口上同时有遥测帧, 只处理调参应答
+
+用法:
+    python param_tool.py COM5 list                                   # 列出全部参数
+    python param_tool.py COM5 get chassis.spd_kp
+    python param_tool.py COM5 set chassis.spd_kp=12000 chassis.spd_ki=5   # 暂存后一次提交
+    python param_tool.py COM5 set chassis.spd_kp=12000 --save         # 提交并写入flash
+    python param_tool.py COM5 save                                   # 把已生效的修改写入flash
+
+写入flash只在遥控器关闭或左开关在下档(底盘无力)时允许
+没有安装pyserial时, Linux下直接用termios打开串口或伪终端(Tools/sim/tuning_sim.c用伪终端测试本工具)
+"""
+
+import argparse
+import os
+import select
+import struct
+import sys
+import time
+
+from telemetry_decode import cobs_decode, crc16
+
+CMD_LIST = 0x10
+CMD_GET = 0x11
+CMD_SET = 0x12
+CMD_COMMIT = 0x13
+CMD_DISCARD = 0x14
+REPLY_FLAG = 0x80
+
+TYPE_FORMAT = ["<f", "<i", "<I"]
+TYPE_NAMES = ["fp32", "int32", "uint32"]
+
+STATUS_TEXT = ["ok", "invalid id", "out of range", "bad request", "save denied (chassis not disabled)", "flash write failed"]
+
+
+class TuningError(Exception):
+    pass
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_index = 0
+    code = 1
+    for byte in data:
+        if byte == 0:
+            out[code_index] = code
+            code_index = len(out)
+            out.append(0)
+            code = 1
+        else:
+            out.append(byte)
+            code += 1
+            if code == 0xFF:
+                out[code_index] = code
+                code_index = len(out)
+                out.append(0)
+                code = 1
+    out[code_index] = code
+    return bytes(out)
+
+
+def frame_encode(payload):
+    crc = crc16(payload)
+    return cobs_encode(payload + struct.pack("<H", crc)) + b"\x00"
+
+
+class PosixPort:
+    """没有pyserial时使用的串口 只实现Client用到的read/write/close"""
+
+    def __init__(self, path, baud, timeout):
+        import termios
+        import tty
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        self.timeout = timeout
+        tty.setraw(self.fd)
+        speed = getattr(termios, "B%d" % baud, None)
+        if speed is not None:
+            attr = termios.tcgetattr(self.fd)
+            attr[4] = attr[5] = speed
+            termios.tcsetattr(self.fd, termios.TCSANOW, attr)
+
+    def read(self, size):
+        ready, _, _ = select.select([self.fd], [], [], self.timeout)
+        return os.read(self.fd, size) if ready else b""
+
+    def write(self, data):
+        while data:
+            data = data[os.write(self.fd, data):]
+
+    def close(self):
+        os.close(self.fd)
+
+
+def open_port(path, baud):
+    try:
+        import serial
+    except ImportError:
+        if os.name != "posix":
+            raise
+        return PosixPort(path, baud, 0.05)
+    return serial.Serial(path, baud, timeout=0.05)
+
+
+class Client:
+    def __init__(self, port, timeout=0.2, retry=5):
+        self.port = port
+        self.timeout = timeout
+        self.retry = retry
+        self.seq = 0
+        self.buffer = bytearray()
+
+    def _read_frame(self, deadline):
+        while time.monotonic() < deadline:
+            index = self.buffer.find(0)
+            if index < 0:
+                self.buffer += self.port.read(256)
+                continue
+            frame = bytes(self.buffer[:index])
+            del self.buffer[:index + 1]
+            data = cobs_decode(frame) if frame else None
+            if data is None or len(data) < 3 or crc16(data[:-2]) != struct.unpack_from("<H", data, len(data) - 2)[0]:
+                continue
+            return data[:-2]
+        return None
+
+    def request(self, cmd, args=b""):
+        """发送请求 超时后用相同seq重发 返回(status, 应答内容)"""
+        self.seq = (self.seq + 1) & 0xFF
+        frame = frame_encode(bytes([cmd, self.seq]) + args)
+        for _ in range(self.retry):
+            self.port.write(frame)
+            deadline = time.monotonic() + self.timeout
+            while True:
+                reply = self._read_frame(deadline)
+                if reply is None:
+                    break
+                if reply[0] == (cmd | REPLY_FLAG) and reply[1] == self.seq:
+                    return reply[2], reply[3:]
+        raise TuningError("no reply for command 0x%02X" % cmd)
+
+    def list(self):
+        params = []
+        index = 0
+        num = 1
+        while index < num:
+            status, body = self.request(CMD_LIST, struct.pack("<H", index))
+            if status != 0:
+                raise TuningError("list %d: %s" % (index, STATUS_TEXT[status]))
+            _, num, kind = struct.unpack_from("<HHB", body)
+            value, low, high = (struct.unpack(TYPE_FORMAT[kind], body[i:i + 4])[0] for i in (5, 9, 13))
+            params.append({"id": index, "name": body[17:].decode("ascii"), "type": kind,
+                           "value": value, "min": low, "max": high})
+            index += 1
+        return params
+
+    def get(self, param_id):
+        status, body = self.request(CMD_GET, struct.pack("<H", param_id))
+        if status != 0:
+            raise TuningError("get %d: %s" % (param_id, STATUS_TEXT[status]))
+        kind = body[2]
+        value = struct.unpack(TYPE_FORMAT[kind], body[3:7])[0]
+        staged = struct.unpack(TYPE_FORMAT[kind], body[8:12])[0] if body[7] else None
+        return value, staged
+
+    def set(self, param, value):
+        raw = struct.pack(TYPE_FORMAT[param["type"]], value)
+        status, _ = self.request(CMD_SET, struct.pack("<H", param["id"]) + raw)
+        if status != 0:
+            raise TuningError("set %s: %s" % (param["name"], STATUS_TEXT[status]))
+
+    def commit(self, save=False):
+        status, body = self.request(CMD_COMMIT, bytes([1 if save else 0]))
+        if status != 0:
+            raise TuningError("commit: %s" % STATUS_TEXT[status])
+        return struct.unpack_from("<IH", body)
+
+    def discard(self):
+        self.request(CMD_DISCARD)
+
+
+def parse_value(param, text):
+    return float(text) if param["type"] == 0 else int(text, 0)
+
+
+def format_value(param, value):
+    return "%.6g" % value if param["type"] == 0 else str(value)
+
+
+def run(client, args):
+    params = client.list()
+    by_name = {p["name"]: p for p in params}
+
+    def find(name):
+        if name not in by_name:
+            raise TuningError("unknown parameter %s" % name)
+        return by_name[name]
+
+    if args.command == "list":
+        for p in params:
+            print("%-24s %-6s %12s  [%s, %s]" % (p["name"], TYPE_NAMES[p["type"]], format_value(p, p["value"]),
+                                                 format_value(p, p["min"]), format_value(p, p["max"])))
+    elif args.command == "get":
+        for name in args.items:
+            p = find(name)
+            value, staged = client.get(p["id"])
+            print("%s = %s%s" % (name, format_value(p, value),
+                                 "" if staged is None else " (staged %s)" % format_value(p, staged)))
+    elif args.command == "set":
+        try:
+            for item in args.items:
+                name, _, text = item.partition("=")
+                p = find(name)
+                client.set(p, parse_value(p, text))
+        except (TuningError, ValueError):
+            client.discard()
+            raise
+        version, count = client.commit(args.save)
+        print("committed %d parameter(s), version %d%s" % (count, version, ", saved" if args.save else ""))
+    elif args.command == "save":
+        version, _ = client.commit(True)
+        print("saved, version %d" % version)
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="get/set firmware parameters over the debug UART")
+    parser.add_argument("port", help="serial port")
+    parser.add_argument("command", choices=["list", "get", "set", "save"])
+    parser.add_argument("items", nargs="*", help="parameter names, or name=value for set")
+    parser.add_argument("--save", action="store_true", help="also write committed values to flash")
+    parser.add_argument("--baud", type=int, default=921600)
+    parser.add_argument("--timeout", type=float, default=0.2, help="reply timeout per try (s)")
+    args = parser.parse_args()
+
+    port = open_port(args.port, args.baud)
+    try:
+        return run(Client(port, args.timeout), args)
+    except (TuningError, ValueError) as error:
+        print(error, file=sys.stderr)
+        return 1
+    finally:
+        port.close()
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""任务集响应时间分析 读取Application/Task/Src/task_registry.h中的任务表与中断表
+
+按固件相同的规则分配优先级(单调速率: 周期短的高, 周期相同截止时间短的高, 再相同共用一个优先级),
+对每个任务迭代求最坏响应时间:
+    R = C + 2*cs + sum_hep( ceil(R / Tj) * (Cj + 2*cs) ) + sum_isr( ceil(R / Tk) * Ck )
+C为任务表中的执行时间预算, cs为一次任务切换的时间, hep为优先级更高与同优先级的其他任务
+(同优先级任务按时间片轮转, 按最坏情况全部先执行), 中断抢占全部任务。
+任一任务 R > 截止时间、总利用率超过1 或优先级级数不够(TASK_PRIORITY_HIGHEST到TASK_PRIORITY_LOWEST)
+时返回1, Keil编译前与 make -C Tools/sim 时运行。
+
+周期、截止时间写成宏时(如CHASSIS_CONTROL_TIME_MS), 在固件头文件与config_freame.h中查找定义。
+执行时间预算是否可信由固件运行时检查: task_timing[].overrun_count不为0说明预算偏小。
+
+用法:
+    python rta.py                  # 分析默认任务表
+    python rta.py --switch-us 2    # 任务切换时间 默认1us
+    python rta.py --json           # 输出JSON
+"""
+
+import argparse
+import json
+import math
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DEFAULT_HEADER = os.path.join(ROOT, "Application", "Task", "Src", "task_registry.h")
+# 查找宏定义的目录 不含HAL库与仿真替代头文件
+DEFINE_DIRS = ["Application", "BSP", "Components", "Core"]
+DEFINE_FILES = ["config_freame.h"]
+
+DEFINE_LINE = re.compile(r"^\s*#define\s+(\w+)\s+((?:[^/\n]|/(?![/*]))+?)\s*(?://.*|/\*.*)?$")
+ROW = re.compile(r"X\(([^()]*)\)")
+INT_SUFFIX = re.compile(r"\b(0x[0-9a-fA-F]+|\d+)[uUlL]+\b")
+
+TASK_FIELDS = ["id", "name", "entry", "stack_words", "period_ms", "deadline_ms", "wcet_us", "isr", "wdg"]
+ISR_FIELDS = ["name", "bit", "interval_us", "wcet_us"]
+# cmsis_os.h中osPriority的取值
+OS_PRIORITY = {"osPriorityIdle": -3, "osPriorityLow": -2, "osPriorityBelowNormal": -1, "osPriorityNormal": 0,
+               "osPriorityAboveNormal": 1, "osPriorityHigh": 2, "osPriorityRealtime": 3}
+
+
+def read_lines(path):
+    """读取文件并合并续行"""
+    with open(path, encoding="utf-8", errors="replace") as f:
+        text = f.read()
+    return text.replace("\\\r\n", " ").replace("\\\n", " ").splitlines()
+
+
+def collect_defines(paths):
+    """宏名 -> 定义文本 同名宏取第一个"""
+    defines = {}
+    for path in paths:
+        for line in read_lines(path):
+            m = DEFINE_LINE.match(line)
+            if m and "(" not in m.group(1):
+                defines.setdefault(m.group(1), m.group(2).strip())
+    return defines
+
+
+def header_files():
+    for name in DEFINE_FILES:
+        yield os.path.join(ROOT, name)
+    for d in DEFINE_DIRS:
+        for dirpath, _, files in os.walk(os.path.join(ROOT, d)):
+            for name in sorted(files):
+                if name.endswith(".h"):
+                    yield os.path.join(dirpath, name)
+
+
+def evaluate(expr, defines, depth=0):
+    """展开宏并求整数值 只允许数字与四则运算、位运算"""
+    if depth > 16:
+        raise ValueError("macro recursion: %s" % expr)
+
+    def expand(m):
+        name = m.group(0)
+        if name in defines:
+            return "(%d)" % evaluate(defines[name], defines, depth + 1)
+        raise ValueError("undefined macro: %s" % name)
+
+    expr = INT_SUFFIX.sub(r"\1", expr)
+    expr = re.sub(r"\b(?!0x)[A-Za-z_]\w*\b", expand, expr)
+    if not re.fullmatch(r"[\s0-9a-fA-FxX()+\-*/%|&<>~]*", expr):
+        raise ValueError("unsupported expression: %s" % expr)
+    return int(eval(expr.replace("/", "//")))
+
+
+def parse_table(lines, macro, fields):
+    """取出 #define macro(X) 的每一行X(...)"""
+    for line in lines:
+        if re.match(r"^\s*#define\s+%s\(X\)" % macro, line):
+            rows = []
+            for m in ROW.finditer(line):
+                values = [v.strip() for v in m.group(1).split(",")]
+                if len(values) != len(fields):
+                    raise ValueError("%s row has %d fields, expected %d: %s"
+                                     % (macro, len(values), len(fields), m.group(0)))
+                rows.append(dict(zip(fields, values)))
+            return rows
+    raise ValueError("%s not found" % macro)
+
+
+def load(header):
+    lines = read_lines(header)
+    defines = collect_defines([header] + [p for p in header_files() if os.path.abspath(p) != header])
+
+    isrs = []
+    for row in parse_table(lines, "TASK_ISR_TABLE", ISR_FIELDS):
+        isrs.append({"name": row["name"],
+                     "interval_us": evaluate(row["interval_us"], defines),
+                     "wcet_us": evaluate(row["wcet_us"], defines)})
+    tasks = []
+    for index, row in enumerate(parse_table(lines, "TASK_TABLE", TASK_FIELDS)):
+        tasks.append({"index": index,
+                      "name": row["name"],
+                      "period_us": evaluate(row["period_ms"], defines) * 1000,
+                      "deadline_us": evaluate(row["deadline_ms"], defines) * 1000,
+                      "wcet_us": evaluate(row["wcet_us"], defines)})
+    try:
+        levels = OS_PRIORITY[defines["TASK_PRIORITY_HIGHEST"]] - OS_PRIORITY[defines["TASK_PRIORITY_LOWEST"]] + 1
+    except KeyError as e:
+        raise ValueError("unknown task priority range: %s" % e)
+    return tasks, isrs, levels
+
+
+def response_time(task, interfering, isrs, switch_us):
+    """最坏响应时间 超过截止时间即停止迭代 返回None"""
+    cost = task["wcet_us"] + 2 * switch_us
+    r = cost
+    while True:
+        nxt = cost
+        nxt += sum(math.ceil(r / t["period_us"]) * (t["wcet_us"] + 2 * switch_us) for t in interfering)
+        nxt += sum(math.ceil(r / i["interval_us"]) * i["wcet_us"] for i in isrs)
+        if nxt > task["deadline_us"]:
+            return None
+        if nxt == r:
+            return r
+        r = nxt
+
+
+def analyse(tasks, isrs, switch_us):
+    order = sorted(tasks, key=lambda t: (t["period_us"], t["deadline_us"], t["index"]))
+    classes = sorted(set((t["period_us"], t["deadline_us"]) for t in tasks))
+    for task in order:
+        task["rank"] = classes.index((task["period_us"], task["deadline_us"]))
+    for task in order:
+        interfering = [t for t in order if t is not task and t["rank"] <= task["rank"]]
+        task["response_us"] = response_time(task, interfering, isrs, switch_us)
+        task["ok"] = task["response_us"] is not None and task["deadline_us"] <= task["period_us"]
+    utilization = sum((t["wcet_us"] + 2 * switch_us) / t["period_us"] for t in tasks)
+    utilization += sum(i["wcet_us"] / i["interval_us"] for i in isrs)
+    return order, utilization
+
+
+def main():
+    parser = argparse.ArgumentParser(description="任务集响应时间分析")
+    parser.add_argument("--header", default=DEFAULT_HEADER, help="任务表头文件")
+    parser.add_argument("--switch-us", type=float, default=1.0, help="一次任务切换的时间 us")
+    parser.add_argument("--json", action="store_true", help="输出JSON")
+    args = parser.parse_args()
+
+    try:
+        tasks, isrs, levels = load(os.path.abspath(args.header))
+    except (OSError, ValueError) as e:
+        print("rta: %s" % e, file=sys.stderr)
+        return 1
+    order, utilization = analyse(tasks, isrs, args.switch_us)
+    used_levels = max(t["rank"] for t in order) + 1
+    schedulable = all(t["ok"] for t in order) and utilization <= 1.0 and used_levels <= levels
+
+    if args.json:
+        json.dump({"tasks": order, "isrs": isrs, "utilization": utilization, "switch_us": args.switch_us,
+                   "priority_levels": used_levels, "schedulable": schedulable}, sys.stdout, indent=2)
+        print()
+        return 0 if schedulable else 1
+
+    print("%-16s %4s %9s %9s %7s %6s %9s" % ("task", "rank", "period", "deadline", "wcet", "util", "response"))
+    for t in order:
+        response = "%9.0f" % t["response_us"] if t["response_us"] is not None else "     miss"
+        print("%-16s %4d %9d %9d %7d %5.1f%% %s" % (t["name"], t["rank"], t["period_us"], t["deadline_us"],
+                                                   t["wcet_us"], 100.0 * t["wcet_us"] / t["period_us"], response))
+    for i in isrs:
+        print("%-16s %4s %9d %9s %7d %5.1f%%" % ("isr " + i["name"], "", i["interval_us"], "", i["wcet_us"],
+                                                100.0 * i["wcet_us"] / i["interval_us"]))
+    n = len(order)
+    print("utilization %.1f%% (rate-monotonic bound for %d tasks %.1f%%), %d of %d priority levels, times in us"
+          % (100.0 * utilization, n, 100.0 * n * (2 ** (1.0 / n) - 1), used_levels, levels))
+    if not schedulable:
+        for t in order:
+            if not t["ok"]:
+                print("rta: %s misses its deadline" % t["name"], file=sys.stderr)
+        if utilization > 1.0:
+            print("rta: utilization above 100%", file=sys.stderr)
+        if used_levels > levels:
+            print("rta: %d priority levels needed, only %d available" % (used_levels, levels), file=sys.stderr)
+        return 1
+    print("schedulable")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,484 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       ahrs_bench.c
+  * @brief      姿态解算上位机精度测试与执行时间基准，用合成运动(已知角速度与线加速度)
+  *             生成陀螺仪、加速度计、磁力计数据，以1kHz运行ahrs.c中的Mahony与卡尔曼滤波，
+  *             检查欧拉角误差与卡尔曼滤波估计的陀螺仪零偏，并统计每次更新的周期数。
+  * @note       真实姿态由欧拉角解析给出，陀螺仪取每个周期中点的角速度(由欧拉角导数换算)。
+  *             传感器数据含零偏、白噪声，加速度计含线加速度，随机数固定种子，结果可复现。
+  *             周期数只用于比较, 目标板执行时间以profile统计为准。
+  *             检查失败时返回1, make bench时运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: ahrs_bench
+    每个场景输出: 横滚/俯仰/偏航误差的均方根与最大值(deg, 跳过开始的收敛时间)、
+                  加速度计修正被跳过的次数、卡尔曼滤波零偏估计误差(deg/s)
+    运动: 横滚+-29deg、俯仰+-23deg正弦摆动, 偏航连续转动, 三轴正弦线加速度,
+          中间有一段超过门限的冲击
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#define _DEFAULT_SOURCE
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bsp_dwt.h"
+#include "ahrs.h"
+
+#define BENCH_RATE_HZ       1000u
+#define BENCH_DT            (1.0f / BENCH_RATE_HZ)
+#define BENCH_TIME_S        60u
+#define BENCH_SETTLE_S      10u         //收敛时间 之前不统计误差
+#define BENCH_CYCLE_COUNT   100000u
+#define BENCH_DATA_NUM      1000u       //周期数测试循环使用的数据长度
+#define BENCH_RAD2DEG       57.29577951308232
+
+#define BENCH_MAG_DIP       1.0         //磁倾角 rad 北半球磁场指向下方
+#define BENCH_SHOCK_START_S 30.0        //冲击时间段
+#define BENCH_SHOCK_END_S   30.5
+#define BENCH_SHOCK_ACCEL   30.0        //冲击线加速度 m/s^2
+
+/*传感器误差*/
+static const double bench_gyro_bias[3] = {0.010, -0.008, 0.012};   //rad/s
+#define BENCH_GYRO_NOISE    0.003       //rad/s 每个样本
+#define BENCH_ACCEL_NOISE   0.02        //m/s^2
+#define BENCH_MAG_NOISE     0.01        //与磁场模长之比
+
+typedef enum
+{
+    BENCH_MAHONY = 0,
+    BENCH_EKF,
+} bench_filter_e;
+
+/*场景*/
+typedef struct
+{
+    const char *name;
+    bench_filter_e filter;
+    bool_t use_mag;
+    //检查门限 deg deg/s 没有磁力计时偏航只靠陀螺仪积分 不检查
+    double tilt_rms;
+    double tilt_max;
+    double yaw_rms;         //小于0不检查偏航
+    double yaw_max;
+    double bias_max;        //小于0不检查零偏
+} bench_case_t;
+
+static const bench_case_t bench_case[] =
+{
+    {"mahony",          BENCH_MAHONY, 0, 1.5, 4.0, -1.0, -1.0, -1.0},
+    {"mahony + mag",    BENCH_MAHONY, 1, 1.5, 4.0, 1.5, 4.0, -1.0},
+    {"ekf",             BENCH_EKF,    0, 1.0, 3.0, -1.0, -1.0, -1.0},
+    {"ekf + mag",       BENCH_EKF,    1, 1.0, 3.0, 0.75, 2.5, 0.05},
+};
+
+#define BENCH_CASE_NUM (sizeof(bench_case) / sizeof(bench_case[0]))
+
+static const ahrs_ekf_param_t bench_ekf_param =
+{
+    .gyro_noise = 0.01f,
+    .gyro_bias_walk = 1e-4f,
+    .gyro_bias_init = 0.05f,
+    .accel_noise = 0.1f,
+    .mag_noise = 0.05f,
+    .accel_gate = 2.0f,
+};
+
+#define BENCH_MAHONY_KP     0.5f
+#define BENCH_MAHONY_KI     0.05f
+#define BENCH_ACCEL_GATE    2.0f
+
+static uint32_t bench_error;
+
+/*----------合成运动----------*/
+
+static uint64_t bench_rand_state;
+
+static double bench_uniform(void)
+{
+    //xorshift64*
+    bench_rand_state ^= bench_rand_state >> 12;
+    bench_rand_state ^= bench_rand_state << 25;
+    bench_rand_state ^= bench_rand_state >> 27;
+    return ((bench_rand_state * 0x2545F4914F6CDD1Dull) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double bench_gauss(void)
+{
+    double u = bench_uniform();
+    double v = bench_uniform();
+
+    if (u < 1e-300)
+    {
+        u = 1e-300;
+    }
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+static double bench_wrap(double a)
+{
+    while (a > M_PI)
+    {
+        a -= 2.0 * M_PI;
+    }
+    while (a < -M_PI)
+    {
+        a += 2.0 * M_PI;
+    }
+    return a;
+}
+
+//真实姿态 欧拉角与其导数 rad rad/s
+static void bench_motion(double t, double euler[3], double rate[3])
+{
+    double w_roll = 2.0 * M_PI * 0.25;
+    double w_pitch = 2.0 * M_PI * 0.17;
+    double w_yaw = 2.0 * M_PI * 0.05;
+
+    euler[AHRS_ROLL] = 0.5 * sin(w_roll * t);
+    euler[AHRS_PITCH] = 0.4 * sin(w_pitch * t + 1.0);
+    euler[AHRS_YAW] = bench_wrap(0.5 * t + 2.0 * sin(w_yaw * t));
+    rate[AHRS_ROLL] = 0.5 * w_roll * cos(w_roll * t);
+    rate[AHRS_PITCH] = 0.4 * w_pitch * cos(w_pitch * t + 1.0);
+    rate[AHRS_YAW] = 0.5 + 2.0 * w_yaw * cos(w_yaw * t);
+}
+
+//机体系角速度 rad/s
+static void bench_rate(double t, double w[3])
+{
+    double e[3];
+    double d[3];
+    double sr, cr, sp, cp;
+
+    bench_motion(t, e, d);
+    sr = sin(e[AHRS_ROLL]);
+    cr = cos(e[AHRS_ROLL]);
+    sp = sin(e[AHRS_PITCH]);
+    cp = cos(e[AHRS_PITCH]);
+    w[0] = d[AHRS_ROLL] - d[AHRS_YAW] * sp;
+    w[1] = d[AHRS_PITCH] * cr + d[AHRS_YAW] * cp * sr;
+    w[2] = -d[AHRS_PITCH] * sr + d[AHRS_YAW] * cp * cr;
+}
+
+//ZYX欧拉角转四元数
+static void bench_quat(double t, double q[4])
+{
+    double e[3];
+    double d[3];
+    double sy, cy, sp, cp, sr, cr;
+
+    bench_motion(t, e, d);
+    sy = sin(0.5 * e[AHRS_YAW]);
+    cy = cos(0.5 * e[AHRS_YAW]);
+    sp = sin(0.5 * e[AHRS_PITCH]);
+    cp = cos(0.5 * e[AHRS_PITCH]);
+    sr = sin(0.5 * e[AHRS_ROLL]);
+    cr = cos(0.5 * e[AHRS_ROLL]);
+    q[0] = cr * cp * cy + sr * sp * sy;
+    q[1] = sr * cp * cy - cr * sp * sy;
+    q[2] = cr * sp * cy + sr * cp * sy;
+    q[3] = cr * cp * sy - sr * sp * cy;
+}
+
+//导航系线加速度 m/s^2
+static void bench_linear_accel(double t, double a[3])
+{
+    a[0] = 1.0 * sin(2.0 * M_PI * 0.3 * t);
+    a[1] = 0.8 * cos(2.0 * M_PI * 0.4 * t);
+    a[2] = 0.3 * sin(2.0 * M_PI * 0.7 * t);
+    if (t >= BENCH_SHOCK_START_S && t < BENCH_SHOCK_END_S)
+    {
+        a[0] += BENCH_SHOCK_ACCEL;
+    }
+}
+
+//导航系向量转到机体系 R(q)'*v
+static void bench_nav_to_body(const double q[4], const double v[3], double b[3])
+{
+    double w = q[0], x = q[1], y = q[2], z = q[3];
+
+    b[0] = (1 - 2 * (y * y + z * z)) * v[0] + 2 * (x * y + w * z) * v[1] + 2 * (x * z - w * y) * v[2];
+    b[1] = 2 * (x * y - w * z) * v[0] + (1 - 2 * (x * x + z * z)) * v[1] + 2 * (y * z + w * x) * v[2];
+    b[2] = 2 * (x * z + w * y) * v[0] + 2 * (y * z - w * x) * v[1] + (1 - 2 * (x * x + y * y)) * v[2];
+}
+
+static void bench_euler(const double q[4], double euler[3])
+{
+    double w = q[0], x = q[1], y = q[2], z = q[3];
+    double s = 2 * (w * y - x * z);
+
+    s = s > 1.0 ? 1.0 : (s < -1.0 ? -1.0 : s);
+    euler[AHRS_YAW] = atan2(2 * (w * z + x * y), 1 - 2 * (y * y + z * z));
+    euler[AHRS_PITCH] = asin(s);
+    euler[AHRS_ROLL] = atan2(2 * (w * x + y * z), 1 - 2 * (x * x + y * y));
+}
+
+//一个周期的传感器数据 t为周期开始时间 q_true为周期结束时的真实姿态
+static void bench_sensor(double t, double q_true[4], fp32 gyro[3], fp32 accel[3], fp32 mag[3])
+{
+    double mag_n[3] = {cos(BENCH_MAG_DIP), 0.0, -sin(BENCH_MAG_DIP)};
+    double w[3];
+    double f_nav[3];
+    double f[3];
+    double m[3];
+    uint32_t i;
+
+    bench_rate(t + 0.5 * BENCH_DT, w);
+    for (i = 0; i < 3; i++)
+    {
+        gyro[i] = (fp32)(w[i] + bench_gyro_bias[i] + BENCH_GYRO_NOISE * bench_gauss());
+    }
+
+    //周期结束时的比力与磁场
+    bench_quat(t + BENCH_DT, q_true);
+    bench_linear_accel(t + BENCH_DT, f_nav);
+    f_nav[2] += AHRS_GRAVITY;
+    bench_nav_to_body(q_true, f_nav, f);
+    bench_nav_to_body(q_true, mag_n, m);
+    for (i = 0; i < 3; i++)
+    {
+        accel[i] = (fp32)(f[i] + BENCH_ACCEL_NOISE * bench_gauss());
+        mag[i] = (fp32)(m[i] + BENCH_MAG_NOISE * bench_gauss());
+    }
+}
+
+/*----------精度----------*/
+
+typedef struct
+{
+    double sum2[3];
+    double max[3];
+    uint32_t count;
+} bench_stat_t;
+
+static void bench_stat_add(bench_stat_t *stat, const double error[3])
+{
+    uint32_t i;
+
+    for (i = 0; i < 3; i++)
+    {
+        stat->sum2[i] += error[i] * error[i];
+        if (fabs(error[i]) > stat->max[i])
+        {
+            stat->max[i] = fabs(error[i]);
+        }
+    }
+    stat->count++;
+}
+
+static double bench_stat_rms(const bench_stat_t *stat, uint32_t i)
+{
+    return sqrt(stat->sum2[i] / stat->count);
+}
+
+static void bench_check(const char *name, const char *what, double value, double limit)
+{
+    if (limit >= 0.0 && value > limit)
+    {
+        fprintf(stderr, "error: %s %s %.3f above %.3f\n", name, what, value, limit);
+        bench_error++;
+    }
+}
+
+static void bench_accuracy(const bench_case_t *c)
+{
+    static ahrs_mahony_t mahony;
+    static ahrs_ekf_t ekf;
+    double q_true[4];
+    double truth[3];
+    double error[3];
+    double bias_error = 0.0;
+    fp32 gyro[3];
+    fp32 accel[3];
+    fp32 mag[3];
+    fp32 euler[3];
+    fp32 *q;
+    const fp32 *m;
+    uint32_t reject;
+    uint32_t steps = BENCH_TIME_S * BENCH_RATE_HZ;
+    uint32_t i;
+    uint32_t k;
+    bench_stat_t stat;
+
+    memset(&stat, 0, sizeof(stat));
+    bench_rand_state = 0x9E3779B97F4A7C15ull;
+
+    ahrs_mahony_init(&mahony, BENCH_MAHONY_KP, BENCH_MAHONY_KI, BENCH_DT, BENCH_ACCEL_GATE);
+    ahrs_ekf_init(&ekf, &bench_ekf_param, BENCH_DT);
+    q = c->filter == BENCH_MAHONY ? mahony.q : ekf.x;
+    m = c->use_mag ? mag : NULL;
+
+    for (i = 0; i < steps; i++)
+    {
+        bench_sensor((double)i * BENCH_DT, q_true, gyro, accel, mag);
+        if (i == 0)
+        {
+            ahrs_align(q, accel, m);
+        }
+        if (c->filter == BENCH_MAHONY)
+        {
+            ahrs_mahony_update(&mahony, gyro, accel, m);
+        }
+        else
+        {
+            ahrs_ekf_update(&ekf, gyro, accel, m);
+        }
+
+        if (i < BENCH_SETTLE_S * BENCH_RATE_HZ)
+        {
+            continue;
+        }
+        ahrs_euler(q, euler);
+        bench_euler(q_true, truth);
+        for (k = 0; k < 3; k++)
+        {
+            error[k] = bench_wrap(euler[k] - truth[k]) * BENCH_RAD2DEG;
+        }
+        bench_stat_add(&stat, error);
+    }
+
+    reject = c->filter == BENCH_MAHONY ? mahony.accel_reject_count : ekf.accel_reject_count;
+    printf("%-14s roll rms %.3f max %.3f  pitch rms %.3f max %.3f  yaw rms %.3f max %.3f deg  accel rejected %u",
+           c->name, bench_stat_rms(&stat, AHRS_ROLL), stat.max[AHRS_ROLL], bench_stat_rms(&stat, AHRS_PITCH),
+           stat.max[AHRS_PITCH], bench_stat_rms(&stat, AHRS_YAW), stat.max[AHRS_YAW], reject);
+    if (c->filter == BENCH_EKF)
+    {
+        for (k = 0; k < 3; k++)
+        {
+            error[k] = fabs(ekf.x[4 + k] - bench_gyro_bias[k]) * BENCH_RAD2DEG;
+            bias_error = error[k] > bias_error ? error[k] : bias_error;
+        }
+        printf("  bias error %.4f deg/s", bias_error);
+        bench_check(c->name, "bias error", bias_error, c->bias_max);
+    }
+    printf("\n");
+
+    bench_check(c->name, "roll rms", bench_stat_rms(&stat, AHRS_ROLL), c->tilt_rms);
+    bench_check(c->name, "roll max", stat.max[AHRS_ROLL], c->tilt_max);
+    bench_check(c->name, "pitch rms", bench_stat_rms(&stat, AHRS_PITCH), c->tilt_rms);
+    bench_check(c->name, "pitch max", stat.max[AHRS_PITCH], c->tilt_max);
+    bench_check(c->name, "yaw rms", bench_stat_rms(&stat, AHRS_YAW), c->yaw_rms);
+    bench_check(c->name, "yaw max", stat.max[AHRS_YAW], c->yaw_max);
+    //冲击期间加速度计修正应被跳过
+    if (reject == 0)
+    {
+        fprintf(stderr, "error: %s accel gate never rejected the shock\n", c->name);
+        bench_error++;
+    }
+}
+
+/*----------周期数----------*/
+
+static int bench_compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void bench_print_dist(const char *name, uint32_t *value, uint32_t count)
+{
+    qsort(value, count, sizeof(value[0]), bench_compare_u32);
+    printf("  %-24s median %6u  p99 %6u  max %8u cycles\n", name, value[count / 2], value[count * 99 / 100],
+           value[count - 1]);
+}
+
+static void bench_cycles(void)
+{
+    static uint32_t cycles[BENCH_CYCLE_COUNT];
+    static fp32 gyro[BENCH_DATA_NUM][3];
+    static fp32 accel[BENCH_DATA_NUM][3];
+    static fp32 mag[BENCH_DATA_NUM][3];
+    static ahrs_mahony_t mahony;
+    static ahrs_ekf_t ekf;
+    const uint32_t n = BENCH_DATA_NUM;
+    double q_true[4];
+    uint32_t start;
+    uint32_t i;
+    uint32_t k;
+
+    //预先生成数据 只计滤波器本身
+    bench_rand_state = 0x243F6A8885A308D3ull;
+    for (i = 0; i < n; i++)
+    {
+        bench_sensor((double)i * BENCH_DT, q_true, gyro[i], accel[i], mag[i]);
+    }
+
+    printf("cycles per update:\n");
+    ahrs_mahony_init(&mahony, BENCH_MAHONY_KP, BENCH_MAHONY_KI, BENCH_DT, BENCH_ACCEL_GATE);
+    for (i = 0; i < BENCH_CYCLE_COUNT; i++)
+    {
+        k = i % n;
+        start = dwt_cycle_get();
+        ahrs_mahony_update(&mahony, gyro[k], accel[k], NULL);
+        cycles[i] = dwt_cycle_get() - start;
+    }
+    bench_print_dist("mahony", cycles, BENCH_CYCLE_COUNT);
+
+    ahrs_mahony_init(&mahony, BENCH_MAHONY_KP, BENCH_MAHONY_KI, BENCH_DT, BENCH_ACCEL_GATE);
+    for (i = 0; i < BENCH_CYCLE_COUNT; i++)
+    {
+        k = i % n;
+        start = dwt_cycle_get();
+        ahrs_mahony_update(&mahony, gyro[k], accel[k], mag[k]);
+        cycles[i] = dwt_cycle_get() - start;
+    }
+    bench_print_dist("mahony + mag", cycles, BENCH_CYCLE_COUNT);
+
+    ahrs_ekf_init(&ekf, &bench_ekf_param, BENCH_DT);
+    for (i = 0; i < BENCH_CYCLE_COUNT; i++)
+    {
+        k = i % n;
+        start = dwt_cycle_get();
+        ahrs_ekf_update(&ekf, gyro[k], NULL, NULL);
+        cycles[i] = dwt_cycle_get() - start;
+    }
+    bench_print_dist("ekf predict only", cycles, BENCH_CYCLE_COUNT);
+
+    ahrs_ekf_init(&ekf, &bench_ekf_param, BENCH_DT);
+    for (i = 0; i < BENCH_CYCLE_COUNT; i++)
+    {
+        k = i % n;
+        start = dwt_cycle_get();
+        ahrs_ekf_update(&ekf, gyro[k], accel[k], NULL);
+        cycles[i] = dwt_cycle_get() - start;
+    }
+    bench_print_dist("ekf", cycles, BENCH_CYCLE_COUNT);
+
+    ahrs_ekf_init(&ekf, &bench_ekf_param, BENCH_DT);
+    for (i = 0; i < BENCH_CYCLE_COUNT; i++)
+    {
+        k = i % n;
+        start = dwt_cycle_get();
+        ahrs_ekf_update(&ekf, gyro[k], accel[k], mag[k]);
+        cycles[i] = dwt_cycle_get() - start;
+    }
+    bench_print_dist("ekf + mag", cycles, BENCH_CYCLE_COUNT);
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    printf("%u Hz, %u s, errors after %u s\n", BENCH_RATE_HZ, BENCH_TIME_S, BENCH_SETTLE_S);
+    for (i = 0; i < BENCH_CASE_NUM; i++)
+    {
+        bench_accuracy(&bench_case[i]);
+    }
+    bench_cycles();
+
+    if (bench_error != 0)
+    {
+        fprintf(stderr, "ahrs_bench: %u errors\n", bench_error);
+        return 1;
+    }
+    printf("ahrs_bench: ok\n");
+    return 0;
+}
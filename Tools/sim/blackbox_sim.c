@@ -0,0 +1,537 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       blackbox_sim.c
+  * @brief      黑匣子上位机测试，3个写者线程并发写各自的通道，同时有两个线程竞争冻结，
+  *             导出内存镜像后用Tools/blackbox_decode.py解码，检查解码结果。
+  * @note       链接时把.noinit段放在0x1000C000(与分散加载文件相同), 按调试器导出的方式
+  *             读取BLACKBOX_BASE_ADDR起的内存。需要python3, 检查失败时返回1, make bench时运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: blackbox_sim [blackbox_decode.py路径]
+    镜像与CSV写在程序旁: build/blackbox_sim.bin build/blackbox_sim.csv
+    torn:       单线程写入, 在写者的两个__DMB处暂停导出, 被覆盖的槽正在写, 解码计入未写完并丢弃
+    concurrent: rc、chassis、user三个通道各一个写者线程, 每个写入超过2^16条(seq回绕)后,
+                一个线程手动冻结、一个线程模拟HardFault冻结, 只有先到的生效;
+                冻结时正在写的记录可以写完, 之后每个通道最多多出一条
+    reset:      冻结后热复位保留数据与冻结原因, 清空后重新记录, 未冻结时热复位丢弃数据
+    每条记录的数据为 写入序号 与 序号的散列, 解码后检查序号等于记录编号、散列相符
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#define _DEFAULT_SOURCE //popen pthread_barrier
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include "main.h"
+#include "blackbox.h"
+#include "sim_cpu.h"
+
+#define SIM_WRITER_NUM      3u
+#define SIM_WRITE_MIN       70000u      //冻结前每个写者至少写入的记录数 超过2^16 seq回绕
+#define SIM_WRITE_AFTER     1000u       //冻结后每个写者继续调用的次数
+#define SIM_ROUND_NUM       16u
+#define SIM_TORN_WRITE      300u        //torn: 在第300条(编号300)写入中暂停
+#define SIM_FAULT_CFSR      0x00008200u //BFARVALID PRECISERR
+#define SIM_FAULT_HFSR      0x40000000u //FORCED
+#define SIM_FAULT_PC        0x08001234u
+#define SIM_FAULT_LR        0x08005679u
+#define SIM_TRIGGER_INFO    7u
+#define SIM_USER_TYPE       0x30u
+#define SIM_ROW_MAX         (BLACKBOX_LANE_NUM * BLACKBOX_LANE_RECORD_NUM)
+#define SIM_IMAGE_SIZE      (sizeof(blackbox_header_t) + SIM_ROW_MAX * sizeof(blackbox_record_t))
+
+//调试器看到的头部
+#define SIM_HEADER ((const volatile blackbox_header_t *)(uintptr_t)BLACKBOX_BASE_ADDR)
+
+/*解码后的一条记录*/
+typedef struct
+{
+    uint32_t lane;
+    uint32_t index;
+    char type[24];
+    uint32_t value[2];
+    uint32_t data[2];
+} sim_row_t;
+
+/*解码结果*/
+typedef struct
+{
+    uint32_t boot;
+    char reason[32];
+    uint32_t freeze_boot;
+    uint32_t rows;
+    uint32_t torn;
+} sim_decode_t;
+
+static const char *const sim_lane_name[BLACKBOX_LANE_NUM] = {"system", "rc", "chassis", "user"};
+static const blackbox_lane_e sim_writer_lane[SIM_WRITER_NUM] = {BLACKBOX_LANE_RC, BLACKBOX_LANE_CHASSIS, BLACKBOX_LANE_USER};
+static const uint8_t sim_writer_type[SIM_WRITER_NUM] = {BLACKBOX_TYPE_RC_STICK, BLACKBOX_TYPE_CHASSIS_CURRENT, SIM_USER_TYPE};
+
+static const char *sim_decoder;
+static char sim_bin_path[256];
+static char sim_csv_path[256];
+static sim_row_t sim_row[SIM_ROW_MAX];
+static uint32_t sim_error;
+static const char *sim_current;
+
+//并发写入
+static pthread_barrier_t sim_start;
+static volatile uint32_t sim_stop;
+static uint32_t sim_written[BLACKBOX_LANE_NUM];
+//HardFault时任务栈上的栈帧 r0 r1 r2 r3 r12 lr pc xpsr
+static uint32_t sim_fault_frame[8];
+
+//torn: 第几次__DMB处暂停导出
+static uint32_t sim_halt_dmb;
+static uint32_t sim_dmb_count;
+
+static void sim_check(bool_t ok, const char *what, uint32_t value, uint32_t expect)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "error: %s: %s %u, expect %u\n", sim_current, what, (unsigned)value, (unsigned)expect);
+        sim_error++;
+    }
+}
+
+//记录数据 写入序号与序号的散列
+static void sim_record_data(uint32_t lane, uint32_t count, uint32_t data[2])
+{
+    data[0] = count;
+    data[1] = (count ^ (lane << 24)) * 2654435761u;
+}
+
+/*--------导出与解码--------*/
+
+//与调试器相同 导出BLACKBOX_BASE_ADDR起BLACKBOX_REGION_SIZE字节, 黑匣子之后的部分为0
+static void sim_dump(void)
+{
+    static uint8_t image[BLACKBOX_REGION_SIZE];
+    FILE *file = fopen(sim_bin_path, "wb");
+
+    memset(image, 0, sizeof(image));
+    memcpy(image, (const void *)(uintptr_t)BLACKBOX_BASE_ADDR, SIM_IMAGE_SIZE);
+    if (file == NULL || fwrite(image, 1, sizeof(image), file) != sizeof(image))
+    {
+        fprintf(stderr, "error: write %s\n", sim_bin_path);
+        exit(1);
+    }
+    fclose(file);
+}
+
+//按逗号分割 保留空字段
+static uint32_t sim_split(char *line, char *field[], uint32_t max)
+{
+    uint32_t num = 0;
+
+    while (num < max)
+    {
+        field[num++] = line;
+        line = strchr(line, ',');
+        if (line == NULL)
+        {
+            break;
+        }
+        *line++ = '\0';
+    }
+    return num;
+}
+
+static bool_t sim_parse_row(char *line, sim_row_t *row)
+{
+    char *field[10];
+    uint8_t raw[8];
+    uint32_t i;
+
+    line[strcspn(line, "\r\n")] = '\0';
+    if (sim_split(line, field, 10) != 10 || strlen(field[9]) != 16u)
+    {
+        return 0;
+    }
+    memset(row, 0, sizeof(sim_row_t));
+    row->lane = BLACKBOX_LANE_NUM;
+    for (i = 0; i < BLACKBOX_LANE_NUM; i++)
+    {
+        if (strcmp(field[1], sim_lane_name[i]) == 0)
+        {
+            row->lane = i;
+        }
+    }
+    row->index = (uint32_t)strtoul(field[2], NULL, 10);
+    snprintf(row->type, sizeof(row->type), "%s", field[3]);
+    row->value[0] = (uint32_t)strtoul(field[4], NULL, 10);
+    row->value[1] = (uint32_t)strtoul(field[5], NULL, 10);
+    for (i = 0; i < sizeof(raw); i++)
+    {
+        char hex[3] = {field[9][2u * i], field[9][2u * i + 1u], '\0'};
+        raw[i] = (uint8_t)strtoul(hex, NULL, 16);
+    }
+    memcpy(row->data, raw, sizeof(raw));
+    return row->lane < BLACKBOX_LANE_NUM;
+}
+
+//用blackbox_decode.py解码导出的镜像
+static void sim_decode_image(sim_decode_t *decode)
+{
+    char command[1024];
+    char line[256];
+    FILE *pipe;
+    FILE *csv;
+    uint32_t rows = 0;
+
+    memset(decode, 0, sizeof(sim_decode_t));
+    snprintf(command, sizeof(command), "python3 %s %s -o %s", sim_decoder, sim_bin_path, sim_csv_path);
+    pipe = popen(command, "r");
+    if (pipe == NULL || fgets(line, sizeof(line), pipe) == NULL ||
+        sscanf(line, "boot %u, 冻结原因 %31[^,], 冻结时间 %*u ms (boot %u), 记录 %u 条, 未写完 %u 条", &decode->boot, decode->reason,
+               &decode->freeze_boot, &decode->rows, &decode->torn) != 5)
+    {
+        fprintf(stderr, "error: %s: %s failed\n", sim_current, command);
+        exit(1);
+    }
+    pclose(pipe);
+
+    csv = fopen(sim_csv_path, "r");
+    if (csv == NULL || fgets(line, sizeof(line), csv) == NULL)
+    {
+        fprintf(stderr, "error: read %s\n", sim_csv_path);
+        exit(1);
+    }
+    while (fgets(line, sizeof(line), csv) != NULL && rows < SIM_ROW_MAX)
+    {
+        if (!sim_parse_row(line, &sim_row[rows]))
+        {
+            fprintf(stderr, "error: %s: bad csv row %u\n", sim_current, (unsigned)rows);
+            sim_error++;
+        }
+        rows++;
+    }
+    fclose(csv);
+    sim_check(rows == decode->rows, "csv rows", rows, decode->rows);
+}
+
+//导出并解码
+static void sim_decode(sim_decode_t *decode)
+{
+    sim_dump();
+    sim_decode_image(decode);
+}
+
+//检查数据通道: 记录编号连续(跳过skip) 最后一条为head-1 数据与编号相符
+static void sim_check_lane(const sim_decode_t *decode, uint32_t lane, uint32_t head, uint32_t skip)
+{
+    uint32_t expect = (head > BLACKBOX_LANE_RECORD_NUM) ? head - BLACKBOX_LANE_RECORD_NUM : 0;
+    uint32_t data[2];
+    uint32_t i;
+
+    for (i = 0; i < decode->rows; i++)
+    {
+        const sim_row_t *row = &sim_row[i];
+
+        if (row->lane != lane)
+        {
+            continue;
+        }
+        if (expect == skip)
+        {
+            expect++;
+        }
+        sim_record_data(lane, row->index, data);
+        sim_check(row->index == expect, sim_lane_name[lane], row->index, expect);
+        sim_check(row->data[0] == data[0] && row->data[1] == data[1], "record data", row->data[0], row->index);
+        expect = row->index + 1u;
+    }
+    if (expect == skip)
+    {
+        expect++;
+    }
+    sim_check(expect == head, "lane end", expect, head);
+}
+
+/*--------torn--------*/
+
+//在第sim_halt_dmb次__DMB处暂停 导出镜像
+static void sim_halt_hook(uint32_t depth)
+{
+    if (depth == 0 && ++sim_dmb_count == sim_halt_dmb)
+    {
+        sim_dump();
+    }
+}
+
+static void sim_torn(void)
+{
+    //每次写入两个__DMB: 清seq后、写完数据后
+    static const char *const position[2] = {"seq cleared", "data written"};
+    sim_decode_t decode;
+    uint32_t data[2];
+    uint32_t k;
+    uint32_t i;
+
+    sim_current = "torn";
+    for (k = 0; k < 2u; k++)
+    {
+        blackbox_clear();
+        sim_dmb_count = 0;
+        sim_halt_dmb = 2u * SIM_TORN_WRITE + 1u + k;
+        sim_cpu_set_dmb_hook(sim_halt_hook);
+        for (i = 0; i <= SIM_TORN_WRITE; i++)
+        {
+            sim_record_data(BLACKBOX_LANE_RC, i, data);
+            blackbox_write(BLACKBOX_LANE_RC, BLACKBOX_TYPE_RC_STICK, data, sizeof(data));
+        }
+        sim_cpu_set_dmb_hook(NULL);
+
+        //解码暂停时导出的镜像 头部还是SIM_TORN_WRITE 正在覆盖编号SIM_TORN_WRITE-128的槽
+        sim_decode_image(&decode);
+        sim_check(decode.torn == 1u, "torn", decode.torn, 1);
+        sim_check(decode.rows == BLACKBOX_LANE_RECORD_NUM - 1u, "rows", decode.rows, BLACKBOX_LANE_RECORD_NUM - 1u);
+        sim_check_lane(&decode, BLACKBOX_LANE_RC, SIM_TORN_WRITE, SIM_TORN_WRITE - BLACKBOX_LANE_RECORD_NUM);
+        printf("torn: halted after %-12s %u records, %u torn\n", position[k], (unsigned)decode.rows, (unsigned)decode.torn);
+    }
+}
+
+/*--------concurrent--------*/
+
+static void *sim_writer(void *arg)
+{
+    uint32_t k = (uint32_t)(uintptr_t)arg;
+    blackbox_lane_e lane = sim_writer_lane[k];
+    uint32_t data[2];
+    uint32_t count = 0;
+
+    pthread_barrier_wait(&sim_start);
+    while (!__atomic_load_n(&sim_stop, __ATOMIC_ACQUIRE))
+    {
+        sim_record_data(lane, count, data);
+        blackbox_write(lane, sim_writer_type[k], data, sizeof(data));
+        count++;
+        __atomic_store_n(&sim_written[lane], count, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+//等待所有写者写入min条
+static void sim_wait_written(uint32_t min)
+{
+    uint32_t k;
+
+    for (k = 0; k < SIM_WRITER_NUM; k++)
+    {
+        while (__atomic_load_n(&sim_written[sim_writer_lane[k]], __ATOMIC_ACQUIRE) < min)
+        {
+            sched_yield();
+        }
+    }
+}
+
+static void *sim_trigger(void *arg)
+{
+    (void)arg;
+    pthread_barrier_wait(&sim_start);
+    sim_wait_written(SIM_WRITE_MIN);
+    blackbox_freeze(BLACKBOX_FREEZE_TRIGGER, SIM_TRIGGER_INFO);
+    return NULL;
+}
+
+//任务中HardFault EXC_RETURN=0xFFFFFFFD 栈帧在PSP
+static void *sim_fault(void *arg)
+{
+    (void)arg;
+    sim_fault_frame[5] = SIM_FAULT_LR;
+    sim_fault_frame[6] = SIM_FAULT_PC;
+    sim_cpu_set_psp((uint32_t)(uintptr_t)sim_fault_frame);
+    pthread_barrier_wait(&sim_start);
+    sim_wait_written(SIM_WRITE_MIN);
+    blackbox_freeze_fault(0xFFFFFFFDu);
+    return NULL;
+}
+
+//检查系统通道: 最后一条为唯一的冻结记录 错误寄存器与出错地址正确
+static void sim_check_system(const sim_decode_t *decode, uint32_t reason)
+{
+    uint32_t freeze = 0;
+    uint32_t i;
+
+    for (i = 0; i < decode->rows; i++)
+    {
+        const sim_row_t *row = &sim_row[i];
+
+        if (row->lane != BLACKBOX_LANE_SYSTEM)
+        {
+            continue;
+        }
+        sim_check(freeze == 0, "record after freeze", row->index, 0);
+        if (strcmp(row->type, "freeze") == 0)
+        {
+            freeze++;
+            sim_check(row->value[0] == reason, "freeze reason", row->value[0], reason);
+            sim_check(row->value[1] == ((reason == BLACKBOX_FREEZE_HARDFAULT) ? SIM_FAULT_PC : SIM_TRIGGER_INFO), "freeze info",
+                      row->value[1], SIM_TRIGGER_INFO);
+        }
+        else if (strcmp(row->type, "fault_reg") == 0)
+        {
+            sim_check(row->value[0] == SIM_FAULT_CFSR && row->value[1] == SIM_FAULT_HFSR, "CFSR", row->value[0], SIM_FAULT_CFSR);
+        }
+        else if (strcmp(row->type, "fault_pc") == 0)
+        {
+            sim_check(row->value[0] == SIM_FAULT_PC && row->value[1] == SIM_FAULT_LR, "pc", row->value[0], SIM_FAULT_PC);
+        }
+        else
+        {
+            sim_check(0, "system record type", row->index, 0);
+        }
+    }
+    sim_check(freeze == 1u, "freeze records", freeze, 1);
+}
+
+static void sim_concurrent(void)
+{
+    pthread_t thread[SIM_WRITER_NUM + 2u];
+    uint32_t head_freeze[BLACKBOX_LANE_NUM];
+    uint32_t win[BLACKBOX_FREEZE_WATCHDOG + 1u];
+    uint32_t late = 0;
+    sim_decode_t decode;
+    uint32_t round;
+    uint32_t k;
+
+    sim_current = "concurrent";
+    memset(win, 0, sizeof(win));
+    sim_scb.CFSR = SIM_FAULT_CFSR;
+    sim_scb.HFSR = SIM_FAULT_HFSR;
+    for (round = 0; round < SIM_ROUND_NUM; round++)
+    {
+        blackbox_clear();
+        memset(sim_written, 0, sizeof(sim_written));
+        sim_stop = 0;
+        pthread_barrier_init(&sim_start, NULL, SIM_WRITER_NUM + 2u);
+        for (k = 0; k < SIM_WRITER_NUM; k++)
+        {
+            pthread_create(&thread[k], NULL, sim_writer, (void *)(uintptr_t)k);
+        }
+        pthread_create(&thread[SIM_WRITER_NUM], NULL, sim_trigger, NULL);
+        pthread_create(&thread[SIM_WRITER_NUM + 1u], NULL, sim_fault, NULL);
+
+        //冻结后写入被忽略 正在写的一条可以写完
+        while (blackbox_is_frozen() == BLACKBOX_RUNNING)
+        {
+            sched_yield();
+        }
+        for (k = 0; k < BLACKBOX_LANE_NUM; k++)
+        {
+            head_freeze[k] = SIM_HEADER->lane_head[k];
+        }
+        for (k = 0; k < SIM_WRITER_NUM; k++)
+        {
+            uint32_t lane = sim_writer_lane[k];
+            uint32_t min = __atomic_load_n(&sim_written[lane], __ATOMIC_ACQUIRE) + SIM_WRITE_AFTER;
+            while (__atomic_load_n(&sim_written[lane], __ATOMIC_ACQUIRE) < min)
+            {
+                sched_yield();
+            }
+        }
+        __atomic_store_n(&sim_stop, 1u, __ATOMIC_RELEASE);
+        for (k = 0; k < SIM_WRITER_NUM + 2u; k++)
+        {
+            pthread_join(thread[k], NULL);
+        }
+        pthread_barrier_destroy(&sim_start);
+
+        sim_decode(&decode);
+        sim_check(decode.torn == 0, "torn", decode.torn, 0);
+        for (k = 0; k < SIM_WRITER_NUM; k++)
+        {
+            uint32_t lane = sim_writer_lane[k];
+            uint32_t head = SIM_HEADER->lane_head[lane];
+
+            sim_check(head >= SIM_WRITE_MIN, "records before freeze", head, SIM_WRITE_MIN);
+            sim_check(head - head_freeze[lane] <= 1u, "records after freeze", head - head_freeze[lane], 1);
+            late += head - head_freeze[lane];
+            sim_check_lane(&decode, lane, head, UINT32_MAX);
+        }
+        k = blackbox_is_frozen();
+        sim_check(k == BLACKBOX_FREEZE_TRIGGER || k == BLACKBOX_FREEZE_HARDFAULT, "freeze_reason", k, BLACKBOX_FREEZE_TRIGGER);
+        win[k <= BLACKBOX_FREEZE_WATCHDOG ? k : 0]++;
+        sim_check_system(&decode, k);
+    }
+    printf("concurrent: %u rounds, %u writers x %u+ records, freeze by trigger %u hardfault %u, %u records finished after freeze\n",
+           (unsigned)SIM_ROUND_NUM, (unsigned)SIM_WRITER_NUM, (unsigned)SIM_WRITE_MIN, (unsigned)win[BLACKBOX_FREEZE_TRIGGER],
+           (unsigned)win[BLACKBOX_FREEZE_HARDFAULT], (unsigned)late);
+}
+
+/*--------reset--------*/
+
+static void sim_reset(void)
+{
+    sim_decode_t decode;
+    uint32_t data[2];
+    uint32_t reason = blackbox_is_frozen();
+    uint32_t rows;
+    uint32_t head;
+
+    sim_current = "reset";
+    sim_decode(&decode);
+    rows = decode.rows;
+    head = SIM_HEADER->lane_head[BLACKBOX_LANE_RC];
+
+    //冻结后热复位 保持冻结 写入被忽略
+    blackbox_init();
+    sim_record_data(BLACKBOX_LANE_RC, head, data);
+    blackbox_write(BLACKBOX_LANE_RC, BLACKBOX_TYPE_RC_STICK, data, sizeof(data));
+    sim_decode(&decode);
+    sim_check(blackbox_is_frozen() == reason, "frozen after reset", blackbox_is_frozen(), reason);
+    sim_check(decode.boot == 1u && decode.freeze_boot == 0, "boot_count", decode.boot, 1);
+    sim_check(decode.rows == rows, "rows kept", decode.rows, rows);
+    sim_check(SIM_HEADER->lane_head[BLACKBOX_LANE_RC] == head, "write while frozen", SIM_HEADER->lane_head[BLACKBOX_LANE_RC], head);
+
+    //清空后重新记录 保留复位次数
+    blackbox_clear();
+    sim_record_data(BLACKBOX_LANE_RC, 0, data);
+    blackbox_write(BLACKBOX_LANE_RC, BLACKBOX_TYPE_RC_STICK, data, sizeof(data));
+    sim_decode(&decode);
+    sim_check(blackbox_is_frozen() == BLACKBOX_RUNNING, "frozen after clear", blackbox_is_frozen(), BLACKBOX_RUNNING);
+    sim_check(decode.boot == 1u && decode.rows == 1u, "rows after clear", decode.rows, 1);
+    sim_check_lane(&decode, BLACKBOX_LANE_RC, 1, UINT32_MAX);
+
+    //未冻结时热复位 丢弃数据
+    blackbox_init();
+    sim_decode(&decode);
+    sim_check(decode.boot == 2u && decode.rows == 0, "rows after running reset", decode.rows, 0);
+    printf("reset: frozen image kept %u records, boot %u\n", (unsigned)rows, (unsigned)decode.boot);
+}
+
+int main(int argc, char *argv[])
+{
+    sim_decode_t decode;
+
+    sim_decoder = (argc > 1) ? argv[1] : "../blackbox_decode.py";
+    snprintf(sim_bin_path, sizeof(sim_bin_path), "%s.bin", argv[0]);
+    snprintf(sim_csv_path, sizeof(sim_csv_path), "%s.csv", argv[0]);
+
+    //上电 .noinit内容无效 清空
+    sim_current = "power on";
+    blackbox_init();
+    sim_decode(&decode);
+    sim_check(decode.boot == 0 && decode.rows == 0, "rows after power on", decode.rows, 0);
+
+    sim_torn();
+    sim_concurrent();
+    sim_reset();
+
+    if (sim_error != 0)
+    {
+        fprintf(stderr, "blackbox_sim: %u errors\n", (unsigned)sim_error);
+        return 1;
+    }
+    printf("blackbox_sim: ok\n");
+    return 0;
+}
@@ -0,0 +1,566 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       bmi088_sim.c
+  * @brief      BMI088驱动上位机测试，用寄存器级假设备(sim_bmi088.c)运行bmi088.c，
+  *             检查初始化配置、ID错误、FIFO成批读取的样本数与数值、采样时钟误差下的时间戳、
+  *             任务延迟导致的FIFO溢出与丢帧、DMA读取不完成时超时中止后下一批恢复读取、
+  *             温度换算与温度补偿回调，
+  *             并与每个样本读一次数据寄存器的方式比较SPI传输次数。
+  * @note       读取流程与imu_task.c相同: 等待水位中断 -> 陀螺仪FIFO -> 加速度计FIFO，
+  *             假设备中DMA读取同步完成，不模拟SPI传输时间。
+  *             检查失败时返回1, make bench时运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: bmi088_sim
+    每个场景输出: 陀螺仪/加速度计样本数、每批帧数范围、时间戳最大误差(us)、溢出与丢帧统计
+    dma_hang: 一次陀螺仪与一次加速度计DMA读取不完成, 输出样本数、中止次数与忙时被拒绝的读取次数
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "sim_bmi088.h"
+#include "bmi088.h"
+#include "imu_task.h"
+
+#define SIM_STEP_US       10u       //等待中断时的时间步长 即中断到读取的最大延迟
+#define SIM_SETTLE_MS     200u      //采样时钟收敛时间 之前不检查时间戳误差
+#define SIM_GYRO_TOL_US   5u        //陀螺仪时间戳误差上限
+#define SIM_NEVER         0xFFFFFFFFu
+#define SIM_HANG_BATCHES  20u       //dma_hang场景的批数
+#define SIM_HANG_GYRO     5u        //该批的陀螺仪DMA读取不完成
+#define SIM_HANG_ACCEL    10u       //该批的加速度计DMA读取不完成
+
+/*场景*/
+typedef struct
+{
+    const char *name;
+    int32_t odr_ppm;        //传感器采样时钟误差
+    uint32_t stall_ms;      //此时刻起读取任务暂停 SIM_NEVER为不暂停
+    uint32_t stall_len_ms;
+    uint32_t duration_ms;
+    bool_t expect_overrun;  //陀螺仪FIFO溢出
+    bool_t expect_skip;     //加速度计FIFO丢帧
+} sim_case_t;
+
+static const sim_case_t sim_case[] =
+{
+    {"nominal",     0,      SIM_NEVER, 0,   1000, 0, 0},
+    {"odr_fast_2%", -20000, SIM_NEVER, 0,   1000, 0, 0},
+    {"odr_slow_2%", 20000,  SIM_NEVER, 0,   1000, 0, 0},
+    {"stall_30ms",  3000,   500,       30,  1000, 0, 0},
+    {"stall_80ms",  3000,   500,       80,  1000, 1, 0},
+    {"stall_150ms", -3000,  500,       150, 1000, 1, 1},
+};
+
+#define SIM_CASE_NUM (sizeof(sim_case) / sizeof(sim_case[0]))
+
+static const fp32 sim_gyro_in[3] = {0.5f, -1.0f, 2.0f};
+static const fp32 sim_accel_in[3] = {0.1f, -0.2f, 9.8f};
+
+static bmi088_t sim_imu;
+static bmi088_sample_t sim_gyro_out[BMI088_SAMPLE_MAX];
+static bmi088_sample_t sim_accel_out[BMI088_SAMPLE_MAX];
+
+static bool_t sim_int_flag;
+static uint32_t sim_int_time_us;
+static uint32_t sim_dma_count;
+static uint32_t sim_error;
+static const char *sim_current;
+
+static void sim_int_callback(uint32_t time_us)
+{
+    sim_int_flag = 1;
+    sim_int_time_us = time_us;
+}
+
+static void sim_dma_callback(bool_t ok)
+{
+    if (ok)
+    {
+        sim_dma_count++;
+    }
+}
+
+static void sim_check(bool_t ok, const char *what, double value)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "error: %s: %s (%g)\n", sim_current, what, value);
+        sim_error++;
+    }
+}
+
+static bool_t sim_near(fp32 a, fp32 b, fp32 tol)
+{
+    return fabsf(a - b) <= tol;
+}
+
+static bmi088_error_e sim_init(void)
+{
+    bsp_imu_init(sim_int_callback, sim_dma_callback);
+    sim_int_flag = 0;
+    return bmi088_init(&sim_imu, IMU_GYRO_RANGE_DPS, IMU_ACCEL_RANGE_G, IMU_FIFO_BATCH);
+}
+
+//等待水位中断 超时返回0(与imu_task相同 超时后轮询读取)
+static bool_t sim_wait_int(void)
+{
+    uint32_t wait_us;
+
+    for (wait_us = 0; !sim_int_flag && wait_us < 2u * IMU_BATCH_PERIOD_MS * 1000u; wait_us += SIM_STEP_US)
+    {
+        sim_bmi088_advance(SIM_STEP_US);
+    }
+    if (!sim_int_flag)
+    {
+        return 0;
+    }
+    sim_int_flag = 0;
+    return 1;
+}
+
+//FIFO中第一帧的序号
+static uint32_t sim_fifo_first_seq(bsp_imu_cs_e cs)
+{
+    const sim_bmi088_stats_t *stats = sim_bmi088_stats_get();
+    uint8_t buf[3];
+
+    if (cs == BSP_IMU_GYRO)
+    {
+        bsp_imu_read(BSP_IMU_GYRO, 0x0E, buf, 1);
+        return stats->gyro_push_count - (buf[0] & 0x7Fu);
+    }
+    bsp_imu_read(BSP_IMU_ACCEL, 0x24, buf, 3);
+    return stats->accel_push_count - (uint32_t)(buf[1] | (buf[2] << 8)) / 7u;
+}
+
+/*--------初始化--------*/
+
+static void sim_test_init(void)
+{
+    sim_current = "init";
+    sim_bmi088_reset();
+    sim_check(sim_init() == BMI088_NO_ERROR, "init failed", 0);
+    sim_check(sim_bmi088_reg_get(BSP_IMU_ACCEL, 0x40) == 0xAC, "ACC_CONF", sim_bmi088_reg_get(BSP_IMU_ACCEL, 0x40));
+    sim_check(sim_bmi088_reg_get(BSP_IMU_ACCEL, 0x7D) == 0x04, "ACC_PWR_CTRL", sim_bmi088_reg_get(BSP_IMU_ACCEL, 0x7D));
+    sim_check(sim_bmi088_reg_get(BSP_IMU_ACCEL, 0x7C) == 0x00, "ACC_PWR_CONF", sim_bmi088_reg_get(BSP_IMU_ACCEL, 0x7C));
+    sim_check(sim_bmi088_reg_get(BSP_IMU_ACCEL, 0x49) == 0x50, "ACC_FIFO_CONFIG_1", sim_bmi088_reg_get(BSP_IMU_ACCEL, 0x49));
+    sim_check(sim_bmi088_reg_get(BSP_IMU_GYRO, 0x10) == 0x81, "GYRO_BANDWIDTH", sim_bmi088_reg_get(BSP_IMU_GYRO, 0x10));
+    sim_check(sim_bmi088_reg_get(BSP_IMU_GYRO, 0x3D) == IMU_FIFO_BATCH, "GYRO_FIFO_CONFIG_0", sim_bmi088_reg_get(BSP_IMU_GYRO, 0x3D));
+    sim_check(sim_bmi088_reg_get(BSP_IMU_GYRO, 0x3E) == 0x80, "GYRO_FIFO_CONFIG_1", sim_bmi088_reg_get(BSP_IMU_GYRO, 0x3E));
+    sim_check(sim_bmi088_reg_get(BSP_IMU_GYRO, 0x1E) == 0x88, "GYRO_FIFO_WM_EN", sim_bmi088_reg_get(BSP_IMU_GYRO, 0x1E));
+    sim_check(sim_bmi088_reg_get(BSP_IMU_GYRO, 0x15) == 0x40, "GYRO_INT_CTRL", sim_bmi088_reg_get(BSP_IMU_GYRO, 0x15));
+    sim_check(sim_bmi088_reg_get(BSP_IMU_GYRO, 0x18) == 0x04, "GYRO_INT3_INT4_MAP", sim_bmi088_reg_get(BSP_IMU_GYRO, 0x18));
+
+    sim_bmi088_reset();
+    sim_bmi088_chip_id_set(0x00, 0x0F);
+    sim_check(sim_init() == BMI088_ACCEL_ID_ERROR, "wrong accel id not detected", 0);
+    sim_bmi088_reset();
+    sim_bmi088_chip_id_set(0x1E, 0x00);
+    sim_check(sim_init() == BMI088_GYRO_ID_ERROR, "wrong gyro id not detected", 0);
+    sim_bmi088_reset();
+    sim_check(bmi088_init(&sim_imu, 300, 6, 4) == BMI088_PARAM_ERROR, "invalid range accepted", 0);
+    printf("%-14s ok\n", "init");
+}
+
+/*--------FIFO读取与时间戳--------*/
+
+static void sim_run_case(const sim_case_t *c)
+{
+    const sim_bmi088_stats_t *stats = sim_bmi088_stats_get();
+    uint32_t gyro_seq = 0;
+    uint32_t accel_seq = 0;
+    uint32_t gyro_num = 0;
+    uint32_t accel_num = 0;
+    uint32_t gyro_last = 0;
+    uint32_t accel_last = 0;
+    uint32_t overrun = 0;
+    uint32_t timeout = 0;
+    uint16_t batch_min = 0xFFFF;
+    uint16_t batch_max = 0;
+    double gyro_err = 0.0;
+    double accel_err = 0.0;
+    fp32 gyro_lsb;
+    fp32 accel_lsb;
+    bool_t stalled = 0;
+    bool_t first = 1;
+    bool_t int_valid;
+    uint16_t n;
+    uint16_t i;
+    int32_t err;
+
+    sim_current = c->name;
+    sim_bmi088_reset();
+    sim_bmi088_odr_error_set(c->odr_ppm);
+    sim_bmi088_input_set(sim_gyro_in, sim_accel_in);
+    sim_check(sim_init() == BMI088_NO_ERROR, "init failed", 0);
+    bsp_imu_int_enable(1);
+    //初始化期间FIFO已写入的帧 第一批超时读取
+    gyro_seq = sim_fifo_first_seq(BSP_IMU_GYRO);
+    accel_seq = sim_fifo_first_seq(BSP_IMU_ACCEL);
+    gyro_lsb = sim_imu.gyro_scale;
+    accel_lsb = sim_imu.accel_scale;
+
+    while (bsp_imu_time_us() < c->duration_ms * 1000u)
+    {
+        if (!stalled && c->stall_ms != SIM_NEVER && bsp_imu_time_us() >= c->stall_ms * 1000u)
+        {
+            stalled = 1;
+            sim_bmi088_advance(c->stall_len_ms * 1000u);
+        }
+        int_valid = sim_wait_int();
+        if (!int_valid && !first)
+        {
+            timeout++;
+        }
+
+        n = bmi088_gyro_fifo_start(&sim_imu);
+        if (sim_imu.gyro_overrun_count != overrun)
+        {
+            //溢出后FIFO已清空
+            overrun = sim_imu.gyro_overrun_count;
+            gyro_seq = stats->gyro_push_count;
+        }
+        if (n != 0)
+        {
+            n = bmi088_gyro_fifo_parse(&sim_imu, sim_int_time_us, int_valid, sim_gyro_out, BMI088_SAMPLE_MAX);
+            //第一批与暂停后第一批不计
+            if (!first && (!stalled || bsp_imu_time_us() > (c->stall_ms + c->stall_len_ms) * 1000u + 2u * IMU_BATCH_PERIOD_MS * 1000u))
+            {
+                batch_min = n < batch_min ? n : batch_min;
+                batch_max = n > batch_max ? n : batch_max;
+            }
+        }
+        for (i = 0; i < n; i++)
+        {
+            sim_check(gyro_num == 0 || (int32_t)(sim_gyro_out[i].time_us - gyro_last) > 0,
+                      "gyro time not increasing", (int32_t)(sim_gyro_out[i].time_us - gyro_last));
+            sim_check(sim_near(sim_gyro_out[i].value[0], sim_gyro_in[0], gyro_lsb) &&
+                      sim_near(sim_gyro_out[i].value[1], sim_gyro_in[1], gyro_lsb) &&
+                      sim_near(sim_gyro_out[i].value[2], sim_gyro_in[2], gyro_lsb), "gyro value", sim_gyro_out[i].value[0]);
+            err = (int32_t)(sim_gyro_out[i].time_us - sim_bmi088_sample_time_get(BSP_IMU_GYRO, gyro_seq));
+            if (bsp_imu_time_us() > SIM_SETTLE_MS * 1000u && fabs((double)err) > gyro_err)
+            {
+                gyro_err = fabs((double)err);
+            }
+            gyro_last = sim_gyro_out[i].time_us;
+            gyro_seq++;
+            gyro_num++;
+        }
+
+        n = 0;
+        if (bmi088_accel_fifo_start(&sim_imu, bsp_imu_time_us()) != 0)
+        {
+            n = bmi088_accel_fifo_parse(&sim_imu, sim_accel_out, BMI088_SAMPLE_MAX);
+        }
+        for (i = 0; i < n; i++)
+        {
+            sim_check(accel_num == 0 || (int32_t)(sim_accel_out[i].time_us - accel_last) > 0,
+                      "accel time not increasing", (int32_t)(sim_accel_out[i].time_us - accel_last));
+            sim_check(sim_near(sim_accel_out[i].value[0], sim_accel_in[0], accel_lsb) &&
+                      sim_near(sim_accel_out[i].value[1], sim_accel_in[1], accel_lsb) &&
+                      sim_near(sim_accel_out[i].value[2], sim_accel_in[2], accel_lsb), "accel value", sim_accel_out[i].value[2]);
+            err = (int32_t)(sim_accel_out[i].time_us - sim_bmi088_sample_time_get(BSP_IMU_ACCEL, accel_seq));
+            if (!c->expect_skip && bsp_imu_time_us() > SIM_SETTLE_MS * 1000u && fabs((double)err) > accel_err)
+            {
+                accel_err = fabs((double)err);
+            }
+            accel_last = sim_accel_out[i].time_us;
+            accel_seq++;
+            accel_num++;
+        }
+        first = 0;
+    }
+
+    printf("%-14s gyro %5u accel %5u batch %2u~%2u err gyro %4.0f accel %4.0f overrun %u skip %u resync %u timeout %u\n",
+           c->name, gyro_num, accel_num, batch_min, batch_max, gyro_err, accel_err, sim_imu.gyro_overrun_count,
+           sim_imu.accel_skip_count, sim_imu.gyro_resync_count, timeout);
+
+    sim_check(sim_dma_count > 0, "no dma completion", 0);
+    sim_check(sim_imu.parse_error_count == 0, "accel parse error", sim_imu.parse_error_count);
+    sim_check(timeout == 0, "watermark interrupt timeout", timeout);
+    sim_check(batch_min == IMU_FIFO_BATCH && batch_max == IMU_FIFO_BATCH, "gyro batch size", batch_max);
+    sim_check(gyro_err <= SIM_GYRO_TOL_US, "gyro timestamp error", gyro_err);
+    sim_check(c->expect_skip || accel_err <= 1000000.0 / BMI088_ACCEL_ODR_HZ, "accel timestamp error", accel_err);
+    sim_check((sim_imu.gyro_overrun_count != 0) == c->expect_overrun, "gyro overrun", sim_imu.gyro_overrun_count);
+    sim_check((sim_imu.accel_skip_count != 0) == c->expect_skip, "accel skip", sim_imu.accel_skip_count);
+    sim_check(c->expect_skip || sim_imu.accel_skip_count == stats->accel_drop_count, "accel skip count",
+              sim_imu.accel_skip_count);
+    //没有丢失的样本 FIFO中最多剩下不到一批
+    sim_check(stats->gyro_push_count - gyro_seq < IMU_FIFO_BATCH, "gyro samples left", stats->gyro_push_count - gyro_seq);
+    if (!c->expect_skip)
+    {
+        sim_check(stats->accel_push_count - accel_seq < IMU_FIFO_BATCH, "accel samples left",
+                  stats->accel_push_count - accel_seq);
+    }
+}
+
+/*--------DMA不完成 超时后中止--------*/
+
+//与imu_task的imu_dma_wait相同: 假设备中DMA同步完成, 完成回调未到即为超时, 中止传输
+static bool_t sim_dma_wait(uint32_t dma_count)
+{
+    if (sim_dma_count != dma_count)
+    {
+        return 1;
+    }
+    bsp_imu_dma_abort();
+    return 0;
+}
+
+static void sim_test_dma_hang(void)
+{
+    const sim_bmi088_stats_t *stats = sim_bmi088_stats_get();
+    uint32_t gyro_seq;
+    uint32_t gyro_num = 0;
+    uint32_t accel_num = 0;
+    uint32_t gyro_last = 0;
+    uint32_t dma_count;
+    uint32_t batch;
+    uint8_t buf[BMI088_GYRO_FRAME_LEN];
+    bool_t int_valid;
+    uint16_t gyro;
+    uint16_t accel;
+    uint16_t i;
+
+    sim_current = "dma_hang";
+    sim_bmi088_reset();
+    sim_bmi088_input_set(sim_gyro_in, sim_accel_in);
+    sim_check(sim_init() == BMI088_NO_ERROR, "init failed", 0);
+    bsp_imu_int_enable(1);
+    gyro_seq = sim_fifo_first_seq(BSP_IMU_GYRO);
+
+    for (batch = 0; batch < SIM_HANG_BATCHES; batch++)
+    {
+        int_valid = sim_wait_int();
+
+        if (batch == SIM_HANG_GYRO)
+        {
+            sim_bmi088_dma_hang_set(1);
+        }
+        dma_count = sim_dma_count;
+        gyro = 0;
+        if (bmi088_gyro_fifo_start(&sim_imu) != 0)
+        {
+            //不中止时之后的DMA读取都被拒绝
+            if (batch == SIM_HANG_GYRO)
+            {
+                sim_check(!bsp_imu_read_dma(BSP_IMU_GYRO, 0x3F, buf, sizeof(buf)), "dma read accepted while busy", 0);
+            }
+            if (sim_dma_wait(dma_count))
+            {
+                gyro = bmi088_gyro_fifo_parse(&sim_imu, sim_int_time_us, int_valid, sim_gyro_out, BMI088_SAMPLE_MAX);
+            }
+        }
+        for (i = 0; i < gyro; i++)
+        {
+            sim_check(gyro_num == 0 || (int32_t)(sim_gyro_out[i].time_us - gyro_last) > 0,
+                      "gyro time not increasing", (int32_t)(sim_gyro_out[i].time_us - gyro_last));
+            sim_check(sim_near(sim_gyro_out[i].value[0], sim_gyro_in[0], sim_imu.gyro_scale), "gyro value",
+                      sim_gyro_out[i].value[0]);
+            gyro_last = sim_gyro_out[i].time_us;
+            gyro_num++;
+        }
+
+        if (batch == SIM_HANG_ACCEL)
+        {
+            sim_bmi088_dma_hang_set(1);
+        }
+        dma_count = sim_dma_count;
+        accel = 0;
+        if (bmi088_accel_fifo_start(&sim_imu, bsp_imu_time_us()) != 0 && sim_dma_wait(dma_count))
+        {
+            accel = bmi088_accel_fifo_parse(&sim_imu, sim_accel_out, BMI088_SAMPLE_MAX);
+        }
+        for (i = 0; i < accel; i++)
+        {
+            sim_check(sim_near(sim_accel_out[i].value[2], sim_accel_in[2], sim_imu.accel_scale), "accel value",
+                      sim_accel_out[i].value[2]);
+        }
+        accel_num += accel;
+
+        //不完成的那一批没有数据 下一批重新读取
+        sim_check((gyro == 0) == (batch == SIM_HANG_GYRO), "gyro read after dma abort", gyro);
+        sim_check((accel == 0) == (batch == SIM_HANG_ACCEL), "accel read after dma abort", accel);
+    }
+
+    printf("%-14s gyro %5u accel %5u hang %u abort %u busy %u\n", "dma_hang", gyro_num, accel_num,
+           stats->dma_hang_count, stats->dma_abort_count, stats->dma_busy_count);
+    sim_check(stats->dma_hang_count == 2 && stats->dma_abort_count == 2, "dma abort count", stats->dma_abort_count);
+    sim_check(stats->dma_busy_count == 1, "dma busy count", stats->dma_busy_count);
+    sim_check(sim_imu.parse_error_count == 0, "accel parse error", sim_imu.parse_error_count);
+    //中止那一批的帧留在FIFO中 下一批一起读出 没有丢失
+    sim_check(stats->gyro_push_count - (gyro_seq + gyro_num) < IMU_FIFO_BATCH, "gyro samples left",
+              stats->gyro_push_count - (gyro_seq + gyro_num));
+}
+
+/*--------温度与补偿--------*/
+
+static void sim_temp_comp(bmi088_sensor_e sensor, fp32 temp, fp32 value[3], void *user)
+{
+    const fp32 *drift = (const fp32 *)user;     //rad/s每℃
+    uint8_t i;
+
+    if (sensor != BMI088_GYRO)
+    {
+        return;
+    }
+    for (i = 0; i < 3u; i++)
+    {
+        value[i] -= drift[i] * (temp - 25.0f);
+    }
+}
+
+static void sim_test_temp(void)
+{
+    static const fp32 temp[] = {-10.5f, 0.0f, 23.0f, 41.625f, 80.0f};
+    static fp32 drift[3] = {0.001f, -0.002f, 0.0005f};
+    uint16_t i;
+    uint16_t n;
+    fp32 t;
+
+    sim_current = "temp";
+    sim_bmi088_reset();
+    sim_bmi088_input_set(sim_gyro_in, sim_accel_in);
+    sim_check(sim_init() == BMI088_NO_ERROR, "init failed", 0);
+    for (i = 0; i < sizeof(temp) / sizeof(temp[0]); i++)
+    {
+        sim_bmi088_temp_set(temp[i]);
+        t = bmi088_temp_update(&sim_imu);
+        sim_check(sim_near(t, temp[i], 0.0625f), "temperature", t);
+    }
+
+    //40℃下按温漂扣除
+    sim_bmi088_temp_set(40.0f);
+    bmi088_temp_update(&sim_imu);
+    bmi088_temp_comp_set(&sim_imu, sim_temp_comp, drift);
+    bsp_imu_int_enable(1);
+    sim_bmi088_advance(IMU_BATCH_PERIOD_MS * 1000u + SIM_STEP_US);
+    n = 0;
+    if (bmi088_gyro_fifo_start(&sim_imu) != 0)
+    {
+        n = bmi088_gyro_fifo_parse(&sim_imu, sim_int_time_us, sim_int_flag, sim_gyro_out, BMI088_SAMPLE_MAX);
+    }
+    sim_check(n != 0, "no gyro sample", 0);
+    for (i = 0; i < n; i++)
+    {
+        sim_check(sim_near(sim_gyro_out[i].value[0], sim_gyro_in[0] - drift[0] * 15.0f, sim_imu.gyro_scale) &&
+                  sim_near(sim_gyro_out[i].value[1], sim_gyro_in[1] - drift[1] * 15.0f, sim_imu.gyro_scale) &&
+                  sim_near(sim_gyro_out[i].value[2], sim_gyro_in[2] - drift[2] * 15.0f, sim_imu.gyro_scale),
+                  "temperature compensation", sim_gyro_out[i].value[0]);
+    }
+    printf("%-14s ok\n", "temp");
+}
+
+/*--------SPI传输次数 FIFO成批读取与逐个样本读取--------*/
+
+static void sim_test_transfer(void)
+{
+    const sim_bmi088_stats_t *stats = sim_bmi088_stats_get();
+    uint8_t buf[8];
+    uint32_t transaction;
+    uint32_t bytes;
+    uint32_t samples;
+    uint32_t gyro;
+    uint32_t accel;
+    uint32_t start_us;
+    double batch_tps;
+    double batch_bps;
+    double batch_ips;
+    double poll_tps;
+    double poll_bps;
+    double poll_ips;
+
+    sim_current = "transfer";
+
+    //成批读取 1s
+    sim_bmi088_reset();
+    sim_bmi088_input_set(sim_gyro_in, sim_accel_in);
+    sim_check(sim_init() == BMI088_NO_ERROR, "init failed", 0);
+    bsp_imu_int_enable(1);
+    transaction = stats->transaction_count;
+    bytes = stats->byte_count;
+    samples = 0;
+    gyro = stats->int_count;
+    start_us = bsp_imu_time_us();
+    while (bsp_imu_time_us() - start_us < 1000000u)
+    {
+        bool_t int_valid = sim_wait_int();
+
+        if (bmi088_gyro_fifo_start(&sim_imu) != 0)
+        {
+            samples += bmi088_gyro_fifo_parse(&sim_imu, sim_int_time_us, int_valid, sim_gyro_out, BMI088_SAMPLE_MAX);
+        }
+        if (bmi088_accel_fifo_start(&sim_imu, bsp_imu_time_us()) != 0)
+        {
+            samples += bmi088_accel_fifo_parse(&sim_imu, sim_accel_out, BMI088_SAMPLE_MAX);
+        }
+    }
+    batch_tps = (double)(stats->transaction_count - transaction) / samples;
+    batch_bps = (double)(stats->byte_count - bytes) / samples;
+    batch_ips = (double)(stats->int_count - gyro) * 1000000.0 / (bsp_imu_time_us() - start_us);
+
+    //逐个样本读取数据寄存器: 每个样本一次中断与一次传输
+    sim_bmi088_reset();
+    sim_check(sim_init() == BMI088_NO_ERROR, "init failed", 0);
+    transaction = stats->transaction_count;
+    bytes = stats->byte_count;
+    gyro = stats->gyro_sample_count;
+    accel = stats->accel_sample_count;
+    samples = 0;
+    start_us = bsp_imu_time_us();
+    while (bsp_imu_time_us() - start_us < 1000000u)
+    {
+        sim_bmi088_advance(SIM_STEP_US);
+        if (stats->gyro_sample_count != gyro)
+        {
+            gyro = stats->gyro_sample_count;
+            bsp_imu_read(BSP_IMU_GYRO, 0x02, buf, 6);
+            samples++;
+        }
+        if (stats->accel_sample_count != accel)
+        {
+            accel = stats->accel_sample_count;
+            bsp_imu_read(BSP_IMU_ACCEL, 0x12, buf, 7);
+            samples++;
+        }
+    }
+    poll_tps = (double)(stats->transaction_count - transaction) / samples;
+    poll_bps = (double)(stats->byte_count - bytes) / samples;
+    poll_ips = (double)samples * 1000000.0 / (bsp_imu_time_us() - start_us);
+
+    printf("%-14s per sample: fifo batch %.2f transfers %.1f bytes, %.0f int/s; register read %.2f transfers %.1f bytes, %.0f int/s\n",
+           "transfer", batch_tps, batch_bps, batch_ips, poll_tps, poll_bps, poll_ips);
+    sim_check(batch_tps < poll_tps, "fifo batching needs more transfers", batch_tps);
+    sim_check(batch_ips < poll_ips, "fifo batching needs more interrupts", batch_ips);
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    sim_test_init();
+    for (i = 0; i < SIM_CASE_NUM; i++)
+    {
+        sim_run_case(&sim_case[i]);
+    }
+    sim_test_dma_hang();
+    sim_test_temp();
+    sim_test_transfer();
+
+    if (sim_error != 0)
+    {
+        fprintf(stderr, "bmi088_sim: %u check(s) failed\n", sim_error);
+        return 1;
+    }
+    printf("bmi088_sim: all checks passed\n");
+    return 0;
+}
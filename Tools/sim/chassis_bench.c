@@ -0,0 +1,450 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       chassis_bench.c
+  * @brief      底盘控制基准测试，按固定场景运行闭环仿真，统计控制质量
+  *             (上升时间、超调、调节时间、跟踪误差、峰值电流)与控制量计算的
+  *             执行周期数，以JSON输出，与提交的基准值比较发现性能退化。
+  * @note       每个用例在独立子进程中运行(仿真状态为全局变量, flash映射固定地址)。
+  *             周期数来自profile.h测量点, 上位机为rdtsc计数, 随机器与CPU状态变化,
+  *             每个用例重复BENCH_REPEAT次取最小的中位数; 控制质量指标各次必须相同,
+  *             不同时报错(仿真失去确定性)。精确周期数以目标板monitor任务为准。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: chassis_bench [用例名 ...]      不带参数时运行全部用例, JSON输出到stdout
+    比较: python Tools/bench_compare.py Tools/sim/bench/baseline.json build/bench.json
+    用例:
+      step     前进半杆阶跃
+      ramp     1s内线性推到满杆
+      spin     小陀螺起转 重心偏移(30,10)mm 统计漂移
+      stop     满速急停
+      dropout  半杆起步加速过程中0号电机反馈中断100ms
+    指标(窗口内, 四个轮子取最差值; 速度为电机模型真实转子转速, 不是固件收到的反馈):
+      rise_ms        设定值变化后 10%->90% 时间
+      overshoot_pct  超调 相对阶跃幅度
+      settling_ms    进入并保持在2%误差带内的时间 从设定值变化开始
+      rms_error_rpm  设定值与真实转速的均方根误差(四轮)
+      peak_current   最大|CAN电流值|
+      peak_power_w / energy_j  母线峰值功率与能量
+      drift_mm       窗口内重心位移(只在小陀螺用例中给出)
+      control_cycles_median/p99  窗口内chassis_control_cal执行周期数 中位数不受偶发中断、调度影响
+    阶跃指标只在阶跃类用例中给出, 未达到时为null
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#define _DEFAULT_SOURCE //fork waitpid
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "config_freame.h"
+#include "CAN_receive.h"
+#include "chassis_task.h"
+#include "profile.h"
+#include "sim_chassis.h"
+
+#define BENCH_WHEEL_NUM     4u
+#define BENCH_MAX_WINDOW_MS 4000u
+#define BENCH_SETTLE_BAND   0.02f   //调节时间误差带 相对阶跃幅度
+#define BENCH_MIN_STEP_RPM  100.0f  //小于该幅度的轮子不统计阶跃指标
+#define BENCH_RAD_TO_RPM    9.5492966f
+#define BENCH_REPEAT        5u
+#define BENCH_TEXT_LEN      512u
+
+/*用例*/
+typedef struct
+{
+    const char *name;
+    const char *const *scenario;
+    uint8_t scenario_len;
+    uint32_t window_start;      //统计窗口 ms 阶跃用例的设定值在窗口开始后变化
+    uint32_t window_end;
+    bool_t step;                //1:统计阶跃指标
+    bool_t drift;               //1:统计重心位移
+    fp32 cg_x_mm, cg_y_mm;      //重心偏移
+} bench_case_t;
+
+/*窗口内记录*/
+typedef struct
+{
+    const bench_case_t *bench;
+    uint32_t count;
+    fp32 set[BENCH_MAX_WINDOW_MS][BENCH_WHEEL_NUM];     //rpm
+    fp32 speed[BENCH_MAX_WINDOW_MS][BENCH_WHEEL_NUM];   //rpm
+    int16_t peak_current;
+    fp32 peak_power;
+    fp32 energy_start;
+    fp32 x_start, y_start;
+    uint32_t control_count;     //上次读取时测量点的记录次数
+    uint32_t cycle_count;
+    uint32_t cycle[BENCH_MAX_WINDOW_MS];
+} bench_record_t;
+
+/*子进程结果 放在共享内存中*/
+typedef struct
+{
+    char quality[BENCH_TEXT_LEN];   //控制质量指标JSON片段
+    fp32 cycles_median;             //没有样本时为-1
+    fp32 cycles_p99;
+} bench_result_t;
+
+PROFILE_SCOPE_DECLARE(chassis_control);
+
+extern chassis_move_t chassis_move_data;
+
+static const char *const bench_step_scenario[] = {"100 sw0=up", "500 ch1=330"};
+static const char *const bench_ramp_scenario[] = {"100 sw0=up", "500 ch1=660 ramp=1000"};
+static const char *const bench_spin_scenario[] = {"100 sw0=mid"};
+static const char *const bench_stop_scenario[] = {"100 sw0=up", "100 ch1=660", "2000 ch1=0"};
+static const char *const bench_dropout_scenario[] = {"100 sw0=up", "500 ch1=330", "530 fb0=0", "630 fb0=1"};
+
+#define BENCH_SCENARIO(s) s, (uint8_t)(sizeof(s) / sizeof(s[0]))
+
+static const bench_case_t bench_case[] =
+{
+    {"step",    BENCH_SCENARIO(bench_step_scenario),    500,  1500, 1, 0, 0.0f,  0.0f},
+    {"ramp",    BENCH_SCENARIO(bench_ramp_scenario),    500,  2500, 0, 0, 0.0f,  0.0f},
+    {"spin",    BENCH_SCENARIO(bench_spin_scenario),    100,  3100, 1, 1, 30.0f, 10.0f},
+    {"stop",    BENCH_SCENARIO(bench_stop_scenario),    2000, 3000, 1, 0, 0.0f,  0.0f},
+    {"dropout", BENCH_SCENARIO(bench_dropout_scenario), 500,  1500, 0, 0, 0.0f,  0.0f},
+};
+#define BENCH_CASE_NUM (sizeof(bench_case) / sizeof(bench_case[0]))
+
+static bench_record_t bench_record;
+
+static void bench_tick(uint32_t now_ms, void *user)
+{
+    bench_record_t *record = (bench_record_t *)user;
+    const chassis_body_t *body = sim_chassis_body();
+    const profile_scope_t *control = PROFILE_SCOPE_POINT(chassis_control);
+    uint8_t i;
+
+    if (now_ms == record->bench->window_start)
+    {
+        record->energy_start = body->energy;
+        record->x_start = body->x;
+        record->y_start = body->y;
+        record->control_count = (control != NULL) ? control->count : 0;
+    }
+    if (now_ms < record->bench->window_start || record->count >= BENCH_MAX_WINDOW_MS)
+    {
+        return;
+    }
+
+    for (i = 0; i < BENCH_WHEEL_NUM; i++)
+    {
+        int16_t current = chassis_move_data.chassis_motor[i].give_current;
+
+        record->set[record->count][i] = chassis_move_data.chassis_motor[i].speed_set;
+        record->speed[record->count][i] = sim_chassis_motor(i)->speed * BENCH_RAD_TO_RPM;
+        if (current < 0)
+        {
+            current = (int16_t)-current;
+        }
+        if (current > record->peak_current)
+        {
+            record->peak_current = current;
+        }
+    }
+    if (body->power > record->peak_power)
+    {
+        record->peak_power = body->power;
+    }
+    record->count++;
+
+    //控制周期2ms 只在测量点有新记录时取样
+    if (control != NULL && control->count != record->control_count)
+    {
+        record->control_count = control->count;
+        record->cycle[record->cycle_count++] = control->last;
+    }
+}
+
+static int bench_compare_cycle(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+//追加一个指标 负值表示未达到 输出null
+static void bench_append_metric(char *text, const char *name, fp32 value, const char *format)
+{
+    size_t len = strlen(text);
+
+    if (len != 0)
+    {
+        len += (size_t)snprintf(text + len, BENCH_TEXT_LEN - len, ", ");
+    }
+    len += (size_t)snprintf(text + len, BENCH_TEXT_LEN - len, "\"%s\": ", name);
+    if (value < 0.0f)
+    {
+        snprintf(text + len, BENCH_TEXT_LEN - len, "null");
+    }
+    else
+    {
+        snprintf(text + len, BENCH_TEXT_LEN - len, format, value);
+    }
+}
+
+//单个轮子的阶跃指标 返回0表示该轮阶跃幅度太小
+static bool_t bench_step_wheel(const bench_record_t *record, uint8_t wheel, fp32 *rise, fp32 *overshoot, fp32 *settling)
+{
+    uint32_t n = record->count;
+    fp32 set0 = record->set[0][wheel];
+    fp32 target = record->set[n - 1][wheel];
+    fp32 delta = target - set0;
+    fp32 initial = record->speed[0][wheel];
+    fp32 sign = (delta > 0.0f) ? 1.0f : -1.0f;
+    fp32 band = fabsf(delta) * BENCH_SETTLE_BAND;
+    fp32 peak = 0.0f;
+    int32_t t_step = -1, t10 = -1, t90 = -1, t_out = -1;
+    uint32_t t;
+
+    if (fabsf(delta) < BENCH_MIN_STEP_RPM)
+    {
+        return 0;
+    }
+    delta = target - initial;
+
+    for (t = 0; t < n; t++)
+    {
+        fp32 progress = (record->speed[t][wheel] - initial) / delta;
+
+        if (t_step < 0 && fabsf(record->set[t][wheel] - set0) > 1.0f)
+        {
+            t_step = (int32_t)t;
+        }
+        if (t_step < 0)
+        {
+            continue;
+        }
+        if (t10 < 0 && progress >= 0.1f)
+        {
+            t10 = (int32_t)t;
+        }
+        if (t90 < 0 && progress >= 0.9f)
+        {
+            t90 = (int32_t)t;
+        }
+        if ((record->speed[t][wheel] - target) * sign > peak)
+        {
+            peak = (record->speed[t][wheel] - target) * sign;
+        }
+        if (fabsf(record->speed[t][wheel] - target) > band)
+        {
+            t_out = (int32_t)t;
+        }
+    }
+
+    *rise = (t10 >= 0 && t90 >= 0) ? (fp32)(t90 - t10) : -1.0f;
+    *overshoot = peak / fabsf(delta) * 100.0f;
+    //最后一个点仍在误差带外 未调节完成
+    *settling = (t_out == (int32_t)n - 1) ? -1.0f : (fp32)(t_out + 1 - t_step);
+    return 1;
+}
+
+static void bench_report(bench_record_t *record, bench_result_t *result)
+{
+    const bench_case_t *bench = record->bench;
+    const chassis_body_t *body = sim_chassis_body();
+    fp64 error_sum = 0.0;
+    fp32 rise = 0.0f, overshoot = 0.0f, settling = 0.0f;
+    bool_t step_valid = 0;
+    uint32_t t;
+    uint8_t i;
+
+    for (t = 0; t < record->count; t++)
+    {
+        for (i = 0; i < BENCH_WHEEL_NUM; i++)
+        {
+            fp32 error = record->set[t][i] - record->speed[t][i];
+            error_sum += (fp64)error * error;
+        }
+    }
+
+    //四个轮子取最差值 任一轮未达到即为null
+    if (bench->step)
+    {
+        for (i = 0; i < BENCH_WHEEL_NUM; i++)
+        {
+            fp32 wheel_rise, wheel_overshoot, wheel_settling;
+
+            if (!bench_step_wheel(record, i, &wheel_rise, &wheel_overshoot, &wheel_settling))
+            {
+                continue;
+            }
+            rise = (wheel_rise < 0.0f || rise < 0.0f) ? -1.0f : fmaxf(rise, wheel_rise);
+            settling = (wheel_settling < 0.0f || settling < 0.0f) ? -1.0f : fmaxf(settling, wheel_settling);
+            overshoot = fmaxf(overshoot, wheel_overshoot);
+            step_valid = 1;
+        }
+    }
+
+    result->quality[0] = '\0';
+    if (step_valid)
+    {
+        bench_append_metric(result->quality, "rise_ms", rise, "%.0f");
+        bench_append_metric(result->quality, "overshoot_pct", overshoot, "%.2f");
+        bench_append_metric(result->quality, "settling_ms", settling, "%.0f");
+    }
+    bench_append_metric(result->quality, "rms_error_rpm", record->count ? (fp32)sqrt(error_sum / (record->count * BENCH_WHEEL_NUM)) : 0.0f, "%.1f");
+    bench_append_metric(result->quality, "peak_current", (fp32)record->peak_current, "%.0f");
+    bench_append_metric(result->quality, "peak_power_w", record->peak_power, "%.1f");
+    bench_append_metric(result->quality, "energy_j", body->energy - record->energy_start, "%.1f");
+    if (bench->drift)
+    {
+        bench_append_metric(result->quality, "drift_mm", hypotf(body->x - record->x_start, body->y - record->y_start) * 1000.0f, "%.1f");
+    }
+    //CONFIG_PROFILE_ENABLE为0时没有样本
+    qsort(record->cycle, record->cycle_count, sizeof(record->cycle[0]), bench_compare_cycle);
+    result->cycles_median = record->cycle_count ? (fp32)record->cycle[record->cycle_count / 2] : -1.0f;
+    result->cycles_p99 = record->cycle_count ? (fp32)record->cycle[record->cycle_count * 99 / 100] : -1.0f;
+}
+
+//子进程中运行一个用例
+static int bench_run(const bench_case_t *bench, bench_result_t *result)
+{
+    chassis_body_param_t param;
+    uint8_t i;
+
+    chassis_body_default_param(&param, CONFIG_CHASSIS_MECANUM ? CHASSIS_BODY_MECANUM : CHASSIS_BODY_OMNI);
+    param.cg_x = bench->cg_x_mm * 0.001f;
+    param.cg_y = bench->cg_y_mm * 0.001f;
+    if (!sim_chassis_init(&param))
+    {
+        return 1;
+    }
+    for (i = 0; i < bench->scenario_len; i++)
+    {
+        if (!sim_scenario_parse_line(sim_chassis_scenario(), bench->scenario[i]))
+        {
+            fprintf(stderr, "%s: invalid scenario line: %s\n", bench->name, bench->scenario[i]);
+            return 1;
+        }
+    }
+
+    memset(&bench_record, 0, sizeof(bench_record));
+    bench_record.bench = bench;
+    sim_chassis_set_tick_hook(bench_tick, &bench_record);
+    sim_chassis_run(bench->window_end + 1);
+
+    bench_report(&bench_record, result);
+    return 0;
+}
+
+//运行一个用例BENCH_REPEAT次 输出JSON
+static bool_t bench_case_run(const bench_case_t *bench, bench_result_t *result)
+{
+    bench_result_t best;
+    char cycles[BENCH_TEXT_LEN] = "";
+    uint8_t repeat;
+
+    for (repeat = 0; repeat < BENCH_REPEAT; repeat++)
+    {
+        pid_t pid;
+        int status;
+
+        memset(result, 0, sizeof(*result));
+        pid = fork();
+        if (pid < 0)
+        {
+            perror("fork");
+            return 0;
+        }
+        if (pid == 0)
+        {
+            _exit(bench_run(bench, result));
+        }
+        if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            fprintf(stderr, "case %s failed\n", bench->name);
+            return 0;
+        }
+
+        if (repeat == 0)
+        {
+            best = *result;
+            continue;
+        }
+        if (strcmp(result->quality, best.quality) != 0)
+        {
+            fprintf(stderr, "case %s is not deterministic:\n  %s\n  %s\n", bench->name, best.quality, result->quality);
+            return 0;
+        }
+        if (result->cycles_median >= 0.0f && result->cycles_median < best.cycles_median)
+        {
+            best.cycles_median = result->cycles_median;
+            best.cycles_p99 = result->cycles_p99;
+        }
+    }
+
+    bench_append_metric(cycles, "control_cycles_median", best.cycles_median, "%.0f");
+    bench_append_metric(cycles, "control_cycles_p99", best.cycles_p99, "%.0f");
+    printf("  \"%s\": {%s, %s}", bench->name, best.quality, cycles);
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    uint8_t selected[BENCH_CASE_NUM];
+    bench_result_t *result;
+    uint8_t printed = 0;
+    uint8_t i;
+    int arg;
+
+    memset(selected, argc > 1 ? 0 : 1, sizeof(selected));
+    for (arg = 1; arg < argc; arg++)
+    {
+        for (i = 0; i < BENCH_CASE_NUM; i++)
+        {
+            if (strcmp(argv[arg], bench_case[i].name) == 0)
+            {
+                selected[i] = 1;
+                break;
+            }
+        }
+        if (i == BENCH_CASE_NUM)
+        {
+            fprintf(stderr, "unknown case: %s\n", argv[arg]);
+            return 2;
+        }
+    }
+
+    //子进程写入 父进程读取
+    result = mmap(NULL, sizeof(*result), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (result == MAP_FAILED)
+    {
+        perror("mmap");
+        return 1;
+    }
+
+    printf("{\n");
+    for (i = 0; i < BENCH_CASE_NUM; i++)
+    {
+        if (!selected[i])
+        {
+            continue;
+        }
+        if (printed++)
+        {
+            printf(",\n");
+        }
+        fflush(stdout);
+        if (!bench_case_run(&bench_case[i], result))
+        {
+            return 1;
+        }
+    }
+    printf("\n}\n");
+    return 0;
+}
@@ -0,0 +1,171 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       chassis_body.c/h
+  * @brief      底盘平面刚体模型，四个轮子由电机模型驱动，轮地接触按滑移速度
+  *             计算摩擦力，支持45度全向轮(X型)与麦克纳姆轮(O型)，
+  *             输出车体速度、位姿、轮子滑移与母线功率。
+  * @note       只在上位机仿真中使用。轮距、轮径、减速比来自config_freame.h。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <math.h>
+#include <stddef.h>
+#include "config_freame.h"
+#include "chassis_body.h"
+
+#define CHASSIS_BODY_GRAVITY 9.81f
+#define CHASSIS_BODY_SQRT1_2 0.70710678f
+
+void chassis_body_default_param(chassis_body_param_t *param, chassis_body_type_e type)
+{
+    param->type = type;
+    param->mass = 15.0f;
+    param->length = CONFIG_CHASSIS_LENGTH_MM * 0.001f;
+    param->width = CONFIG_CHASSIS_WIDTH_MM * 0.001f;
+    //按均匀平板估算
+    param->yaw_inertia = param->mass * (param->length * param->length + param->width * param->width) / 12.0f;
+    param->wheel_radius = CONFIG_WHEEL_DIAMETER_MM * 0.0005f;
+    param->wheel_inertia = 8.7e-4f;
+    param->friction = 0.8f;
+    param->slip_speed = 0.05f;
+    param->roller_damping = 2.0f;
+    param->cg_x = 0.0f;
+    param->cg_y = 0.0f;
+}
+
+void chassis_body_init(chassis_body_t *body, const chassis_body_param_t *param, motor_sim_t *motor[CHASSIS_BODY_WHEEL_NUM])
+{
+    //轮子位置符号 0右前 1左前 2左后 3右后
+    static const int8_t pos_sign[CHASSIS_BODY_WHEEL_NUM][2] = {{1, -1}, {1, 1}, {-1, 1}, {-1, -1}};
+    fp32 half_length = param->length * 0.5f;
+    fp32 half_width = param->width * 0.5f;
+    uint8_t i;
+
+    body->param = *param;
+
+    for (i = 0; i < CHASSIS_BODY_WHEEL_NUM; i++)
+    {
+        chassis_body_wheel_t *wheel = &body->wheel[i];
+        fp32 sx = (fp32)pos_sign[i][0];
+        fp32 sy = (fp32)pos_sign[i][1];
+
+        wheel->px = sx * half_length - param->cg_x;
+        wheel->py = sy * half_width - param->cg_y;
+        //静态正压力按重心偏移线性分配 四轮之和为mg
+        wheel->max_force = param->friction * param->mass * CHASSIS_BODY_GRAVITY * 0.25f *
+                           (1.0f + sx * param->cg_x / half_length + sy * param->cg_y / half_width);
+        if (wheel->max_force < 0.0f)
+        {
+            wheel->max_force = 0.0f;
+        }
+
+        if (param->type == CHASSIS_BODY_MECANUM)
+        {
+            //轮轴沿y朝外 d = 轴 x z; 辊子使约束方向沿对角线
+            wheel->dx = sy;
+            wheel->dy = 0.0f;
+            wheel->ex = CHASSIS_BODY_SQRT1_2;
+            wheel->ey = -sx * sy * CHASSIS_BODY_SQRT1_2;
+        }
+        else
+        {
+            //轮轴沿对角线朝外 d = 轴 x z; 辊子沿轮轴滚动 约束方向即驱动方向
+            wheel->dx = sy * CHASSIS_BODY_SQRT1_2;
+            wheel->dy = -sx * CHASSIS_BODY_SQRT1_2;
+            wheel->ex = wheel->dx;
+            wheel->ey = wheel->dy;
+        }
+        wheel->d_dot_e = wheel->dx * wheel->ex + wheel->dy * wheel->ey;
+        wheel->slip = 0.0f;
+        wheel->force = 0.0f;
+
+        body->motor[i] = motor[i];
+        if (motor[i] != NULL)
+        {
+            //轮子惯量折算到转子侧
+            motor[i]->load_inertia = param->wheel_inertia / (motor[i]->param->gear_ratio * motor[i]->param->gear_ratio);
+            motor[i]->load_torque = 0.0f;
+        }
+    }
+
+    body->vx = 0.0f;
+    body->vy = 0.0f;
+    body->wz = 0.0f;
+    body->x = 0.0f;
+    body->y = 0.0f;
+    body->yaw = 0.0f;
+    body->power = 0.0f;
+    body->energy = 0.0f;
+}
+
+void chassis_body_step(chassis_body_t *body, fp32 dt)
+{
+    const chassis_body_param_t *param = &body->param;
+    fp32 inv_slip_speed = 1.0f / param->slip_speed;
+    fp32 fx = 0.0f, fy = 0.0f, tz = 0.0f;
+    fp32 power = 0.0f;
+    fp32 cos_yaw, sin_yaw;
+    uint8_t i;
+
+    for (i = 0; i < CHASSIS_BODY_WHEEL_NUM; i++)
+    {
+        chassis_body_wheel_t *wheel = &body->wheel[i];
+        motor_sim_t *motor = body->motor[i];
+        //轮心速度 = 车体速度 + wz x p
+        fp32 hub_vx = body->vx - body->wz * wheel->py;
+        fp32 hub_vy = body->vy + body->wz * wheel->px;
+        fp32 surface_speed = 0.0f;
+        fp32 free_speed;
+        fp32 force_free;
+        fp32 wheel_fx, wheel_fy;
+
+        if (motor != NULL)
+        {
+            surface_speed = motor_sim_output_speed(motor) * param->wheel_radius;
+            power += motor->electrical_power;
+        }
+
+        //约束方向 按滑移速度计算摩擦力 tanh在滑移很小时近似线性 大滑移时饱和到mu*N
+        wheel->slip = hub_vx * wheel->ex + hub_vy * wheel->ey - surface_speed * wheel->d_dot_e;
+        wheel->force = -wheel->max_force * tanhf(wheel->slip * inv_slip_speed);
+
+        //自由滚动方向(垂直于约束方向) 只有辊子阻力
+        free_speed = -hub_vx * wheel->ey + hub_vy * wheel->ex;
+        force_free = -param->roller_damping * free_speed;
+
+        wheel_fx = wheel->force * wheel->ex - force_free * wheel->ey;
+        wheel_fy = wheel->force * wheel->ey + force_free * wheel->ex;
+        fx += wheel_fx;
+        fy += wheel_fy;
+        tz += wheel->px * wheel_fy - wheel->py * wheel_fx;
+
+        //地面对轮子的反作用 折算到转子侧 与电机驱动方向相反为正
+        if (motor != NULL)
+        {
+            motor->load_torque = wheel->force * wheel->d_dot_e * param->wheel_radius / motor->param->gear_ratio;
+        }
+    }
+
+    //车体系(旋转坐标系)下的牛顿方程
+    body->vx += (fx / param->mass + body->wz * body->vy) * dt;
+    body->vy += (fy / param->mass - body->wz * body->vx) * dt;
+    body->wz += tz / param->yaw_inertia * dt;
+
+    cos_yaw = cosf(body->yaw);
+    sin_yaw = sinf(body->yaw);
+    body->x += (body->vx * cos_yaw - body->vy * sin_yaw) * dt;
+    body->y += (body->vx * sin_yaw + body->vy * cos_yaw) * dt;
+    body->yaw += body->wz * dt;
+
+    body->power = power;
+    body->energy += power * dt;
+}
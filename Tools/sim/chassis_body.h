@@ -0,0 +1,113 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       chassis_body.c/h
+  * @brief      底盘平面刚体模型，四个轮子由电机模型驱动，轮地接触按滑移速度
+  *             计算摩擦力，支持45度全向轮(X型)与麦克纳姆轮(O型)，
+  *             输出车体速度、位姿、轮子滑移与母线功率。
+  * @note       只在上位机仿真中使用。轮距、轮径、减速比来自config_freame.h。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    坐标: 车体系原点在重心 x向前 y向左 wz逆时针为正; 世界系在仿真开始时与车体系重合
+    轮子编号与位置(与chassis_task.c一致):
+                  前
+               1-------0
+               2-------3
+                  后
+    每个轮子: 位置p, 电机正转时轮心被推动的方向d, 约束方向e(辊子不能自由滚动的方向)
+      全向轮: 轮轴沿对角线朝外, d = 轴 x z, 辊子沿轮轴滚动, e = d
+      麦轮:   轮轴沿y朝外, d = 轴 x z, 辊子与轮轴成45度, e与对角线平行
+    接触力(约束方向): 滑移 s = 轮心速度·e - 轮面速度·(d·e)
+                      F = -mu*N*tanh(s / slip_speed)
+    自由滚动方向只有辊子阻力 F = -roller_damping * 轮心速度·f
+    轮子反作用转矩 = F*(d·e)*R, 折算到转子侧作为电机负载转矩
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef CHASSIS_BODY_H
+#define CHASSIS_BODY_H
+
+#include "struct_typedef.h"
+#include "motor_sim.h"
+
+#define CHASSIS_BODY_WHEEL_NUM 4u
+
+/*轮子类型*/
+typedef enum
+{
+    CHASSIS_BODY_OMNI = 0,    //45度全向轮 X型
+    CHASSIS_BODY_MECANUM,     //麦克纳姆轮 O型
+} chassis_body_type_e;
+
+/*底盘参数*/
+typedef struct
+{
+    chassis_body_type_e type;
+    fp32 mass;                //整车质量 kg
+    fp32 yaw_inertia;         //绕竖直轴转动惯量 kg·m²
+    fp32 length;              //前后轮距 m
+    fp32 width;               //左右轮距 m
+    fp32 wheel_radius;        //轮半径 m
+    fp32 wheel_inertia;       //单个轮子转动惯量 kg·m²
+    fp32 friction;            //轮地摩擦系数
+    fp32 slip_speed;          //摩擦力达到约76%最大值时的滑移速度 m/s
+    fp32 roller_damping;      //辊子自由滚动方向阻尼 N·s/m
+    fp32 cg_x, cg_y;          //重心相对几何中心的偏移 m 决定各轮正压力 小陀螺漂移的主要来源
+} chassis_body_param_t;
+
+/*单个轮子*/
+typedef struct
+{
+    fp32 px, py;              //相对重心的位置 m
+    fp32 dx, dy;              //驱动方向
+    fp32 ex, ey;              //约束方向
+    fp32 d_dot_e;
+    fp32 max_force;           //最大摩擦力 mu*N N
+    fp32 slip;                //约束方向滑移速度 m/s
+    fp32 force;               //约束方向接触力 N
+} chassis_body_wheel_t;
+
+/*底盘状态*/
+typedef struct
+{
+    chassis_body_param_t param;
+    motor_sim_t *motor[CHASSIS_BODY_WHEEL_NUM];
+    chassis_body_wheel_t wheel[CHASSIS_BODY_WHEEL_NUM];
+
+    fp32 vx, vy, wz;          //车体系速度 m/s, rad/s
+    fp32 x, y, yaw;           //世界系位姿 m, rad(累计, 不取模)
+    fp32 power;               //四个电机母线功率之和 W
+    fp32 energy;              //累计母线能量 J
+} chassis_body_t;
+
+/**
+  * @brief          按config_freame.h的机械参数填写默认底盘参数
+  * @param[out]     param: 底盘参数
+  * @param[in]      type: 轮子类型
+  * @retval         none
+  */
+extern void chassis_body_default_param(chassis_body_param_t *param, chassis_body_type_e type);
+
+/**
+  * @brief          底盘初始化 静止在原点 设置电机负载惯量为轮子惯量
+  * @param[out]     body: 底盘状态
+  * @param[in]      param: 底盘参数
+  * @param[in]      motor: 四个电机 顺序与轮子编号一致
+  * @retval         none
+  */
+extern void chassis_body_init(chassis_body_t *body, const chassis_body_param_t *param, motor_sim_t *motor[CHASSIS_BODY_WHEEL_NUM]);
+
+/**
+  * @brief          推进一步: 由当前状态计算接触力, 设置电机负载转矩, 积分车体运动,
+  *                 在电机推进同一步之前调用(sim_can步进钩子)
+  * @param[in,out]  body: 底盘状态
+  * @param[in]      dt: 步长 s
+  * @retval         none
+  */
+extern void chassis_body_step(chassis_body_t *body, fp32 dt);
+
+#endif
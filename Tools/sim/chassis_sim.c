@@ -0,0 +1,202 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       chassis_sim.c
+  * @brief      底盘闭环仿真，未修改的chassis_task、CAN_receive、pid、param
+  *             与电机模型通过仿真CAN总线闭环运行，电机驱动底盘刚体模型，
+  *             按场景输入摇杆，输出CSV。
+  * @note       轮子类型按CONFIG_CHASSIS_MECANUM，与固件解算一致。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.0.1     Oct-19-2026     ICBK            1. 底盘刚体模型 场景文件 命令行选项
+  *  V1.0.2     Oct-19-2026     ICBK            1. 装配移到sim_chassis 与基准测试共用
+  *
+  @verbatim
+  ==============================================================================
+    用法: chassis_sim [-s 场景文件] [-t 时长ms] [-o CSV文件] [-p CSV输出周期ms] [-g 重心x,y mm]
+      -s 默认使用内置场景: 0.2s开关拨上 0.5s前进半杆 2s松杆 3s旋转半杆 4s松杆
+      -t 默认为场景的end时间, 没有end时为5000ms
+      -o 默认输出到stdout; -p 默认10ms, 为0时不输出CSV, 只统计运行速度
+      -g 重心相对几何中心的偏移, 默认0,0
+    CSV列: t_ms, set0~3(rpm), fdb0~3(rpm), cur0~3(CAN电流值),
+           vx,vy(m/s 车体系), wz(rad/s), x,y(m 世界系), yaw(rad), power(W)
+    结束时在stderr输出最终位姿、峰值功率与能量, 小陀螺场景的位移即为漂移
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "config_freame.h"
+#include "CAN_receive.h"
+#include "chassis_task.h"
+#include "sim_can.h"
+#include "sim_chassis.h"
+
+#define SIM_DEFAULT_DURATION 5000u
+
+extern chassis_move_t chassis_move_data;
+
+//内置场景
+static const char *const sim_default_scenario[] =
+{
+    "200  sw0=up",
+    "500  ch1=330",
+    "2000 ch1=0",
+    "3000 ch4=330",
+    "4000 ch4=0",
+};
+
+static FILE *sim_csv;
+static uint32_t sim_csv_period;
+static fp32 sim_peak_power;
+
+static void sim_tick(uint32_t now_ms, void *user)
+{
+    const chassis_body_t *body = sim_chassis_body();
+    uint8_t i;
+
+    (void)user;
+
+    if (body->power > sim_peak_power)
+    {
+        sim_peak_power = body->power;
+    }
+
+    if (sim_csv_period != 0 && now_ms % sim_csv_period == 0)
+    {
+        fprintf(sim_csv, "%u", (unsigned)now_ms);
+        for (i = 0; i < 4; i++)
+        {
+            fprintf(sim_csv, ",%.1f", chassis_move_data.chassis_motor[i].speed_set);
+        }
+        for (i = 0; i < 4; i++)
+        {
+            fprintf(sim_csv, ",%.1f", chassis_move_data.chassis_motor[i].current_speed_fedback);
+        }
+        for (i = 0; i < 4; i++)
+        {
+            fprintf(sim_csv, ",%d", chassis_move_data.chassis_motor[i].give_current);
+        }
+        fprintf(sim_csv, ",%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.1f\n", body->vx, body->vy, body->wz,
+                body->x, body->y, body->yaw, body->power);
+    }
+}
+
+static void sim_usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-s scenario] [-t duration_ms] [-o out.csv] [-p csv_period_ms] [-g cg_x_mm,cg_y_mm]\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *scenario_path = NULL;
+    const char *csv_path = NULL;
+    chassis_body_param_t body_param;
+    const chassis_body_t *body;
+    uint32_t duration = 0;
+    fp32 cg_x_mm = 0.0f, cg_y_mm = 0.0f;
+    clock_t start;
+    fp64 wall;
+    int arg;
+    uint8_t i;
+
+    sim_csv_period = 10u;
+    for (arg = 1; arg < argc; arg++)
+    {
+        if (arg + 1 >= argc || argv[arg][0] != '-' || argv[arg][2] != '\0')
+        {
+            sim_usage(argv[0]);
+            return 2;
+        }
+        switch (argv[arg][1])
+        {
+            case 's':
+                scenario_path = argv[++arg];
+                break;
+            case 't':
+                duration = (uint32_t)strtoul(argv[++arg], NULL, 0);
+                break;
+            case 'o':
+                csv_path = argv[++arg];
+                break;
+            case 'p':
+                sim_csv_period = (uint32_t)strtoul(argv[++arg], NULL, 0);
+                break;
+            case 'g':
+                if (sscanf(argv[++arg], "%f,%f", &cg_x_mm, &cg_y_mm) != 2)
+                {
+                    sim_usage(argv[0]);
+                    return 2;
+                }
+                break;
+            default:
+                sim_usage(argv[0]);
+                return 2;
+        }
+    }
+
+    chassis_body_default_param(&body_param, CONFIG_CHASSIS_MECANUM ? CHASSIS_BODY_MECANUM : CHASSIS_BODY_OMNI);
+    body_param.cg_x = cg_x_mm * 0.001f;
+    body_param.cg_y = cg_y_mm * 0.001f;
+    if (!sim_chassis_init(&body_param))
+    {
+        return 1;
+    }
+
+    if (scenario_path != NULL)
+    {
+        if (!sim_scenario_load(sim_chassis_scenario(), scenario_path))
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        for (i = 0; i < sizeof(sim_default_scenario) / sizeof(sim_default_scenario[0]); i++)
+        {
+            sim_scenario_parse_line(sim_chassis_scenario(), sim_default_scenario[i]);
+        }
+    }
+    if (duration == 0)
+    {
+        duration = (sim_chassis_scenario()->end_ms != 0) ? sim_chassis_scenario()->end_ms : SIM_DEFAULT_DURATION;
+    }
+
+    sim_csv = stdout;
+    if (csv_path != NULL && sim_csv_period != 0)
+    {
+        sim_csv = fopen(csv_path, "w");
+        if (sim_csv == NULL)
+        {
+            fprintf(stderr, "%s: cannot open\n", csv_path);
+            return 1;
+        }
+    }
+    if (sim_csv_period != 0)
+    {
+        fprintf(sim_csv, "t_ms,set0,set1,set2,set3,fdb0,fdb1,fdb2,fdb3,cur0,cur1,cur2,cur3,vx,vy,wz,x,y,yaw,power\n");
+    }
+    sim_chassis_set_tick_hook(sim_tick, NULL);
+
+    start = clock();
+    sim_chassis_run(duration);
+    wall = (fp64)(clock() - start) / CLOCKS_PER_SEC;
+
+    if (sim_csv != stdout)
+    {
+        fclose(sim_csv);
+    }
+
+    body = sim_chassis_body();
+    fprintf(stderr, "simulated %.3f s in %.3f s wall, %.0fx real time, can1 tx %u rx %u overflow %u\n",
+            duration * 1.0e-3, wall, wall > 0.0 ? duration * 1.0e-3 / wall : 0.0,
+            (unsigned)sim_can_get_stat(SIM_CAN1)->tx_count, (unsigned)sim_can_get_stat(SIM_CAN1)->rx_count,
+            (unsigned)sim_can_get_stat(SIM_CAN1)->rx_overflow);
+    fprintf(stderr, "%s chassis: x %.3f m, y %.3f m, yaw %.1f deg, peak power %.1f W, energy %.1f J\n",
+            CONFIG_CHASSIS_MECANUM ? "mecanum" : "omni", body->x, body->y, body->yaw * 57.29578f,
+            sim_peak_power, body->energy);
+    return 0;
+}
@@ -0,0 +1,489 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       fast_math_bench.c
+  * @brief      快速数学函数上位机精度扫描与执行时间基准，与libm(双精度)比较
+  *             fast_math.c中三个档位的sin/cos/atan2与inv_sqrt/sqrt/sin_cos的最大误差，
+  *             门限为fast_math.h中给出的各档位最大误差，并与libm单精度函数比较每次调用的周期数。
+  * @note       sin/cos扫描 |x| <= 100 rad，atan2扫描三种半径的整圆与整数网格，
+  *             inv_sqrt/sqrt的相对误差随指数以4为周期重复，扫描[1,4)中全部单精度数。
+  *             周期数只用于比较, 目标板执行时间以profile统计为准。
+  *             sin_cos的sin与cos分别统计误差; |x| >= 1e7与inf/NaN输入检查按x=0处理。
+  *             检查失败时返回1, make bench时运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: fast_math_bench
+    每个函数输出: 最大误差、出现位置与门限
+    inv_sqrt/sqrt/sin_cos只编译CONFIG_FAST_MATH_TIER选择的档位, 门限按该档位
+    周期数: 1000个预先生成的输入为一批, 输出每次调用的周期数(每批平均)的中位数与p99
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#define _DEFAULT_SOURCE
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bsp_dwt.h"
+#include "fast_math.h"
+
+#define BENCH_SIN_RANGE     100.0f
+#define BENCH_SIN_POINTS    4000000u
+#define BENCH_ATAN2_POINTS  1000000u
+#define BENCH_ATAN2_GRID    100
+#define BENCH_SQRT_SAMPLES  100000u
+#define BENCH_BATCH_SIZE    1000u
+#define BENCH_BATCH_NUM     2000u
+
+/*fast_math.h中的最大误差*/
+#define BENCH_LUT_SIN_MAX       2.3e-5
+#define BENCH_LUT_ATAN2_MAX     5.3e-6
+#define BENCH_FAST_SIN_MAX      7.1e-5
+#define BENCH_FAST_ATAN2_MAX    8.2e-5
+#define BENCH_PRECISE_SIN_MAX   7.8e-7
+#define BENCH_PRECISE_ATAN2_MAX 2.0e-6
+
+#if (FAST_MATH_TIER == FAST_MATH_TIER_FAST)
+#define BENCH_SQRT_REL_MAX      1.8e-3
+#define BENCH_SIN_COS_SIN_MAX   BENCH_FAST_SIN_MAX
+#define BENCH_SIN_COS_COS_MAX   BENCH_FAST_SIN_MAX
+#elif (FAST_MATH_TIER == FAST_MATH_TIER_LUT)
+#define BENCH_SQRT_REL_MAX      4.8e-6
+#define BENCH_SIN_COS_SIN_MAX   BENCH_LUT_SIN_MAX
+#define BENCH_SIN_COS_COS_MAX   BENCH_LUT_SIN_MAX
+#else
+#define BENCH_SQRT_REL_MAX      4.8e-6
+#define BENCH_SIN_COS_SIN_MAX   BENCH_PRECISE_SIN_MAX
+#define BENCH_SIN_COS_COS_MAX   BENCH_PRECISE_SIN_MAX
+#endif
+
+//超出规约范围(|x| >= 1e7)与inf/NaN 按x=0处理
+static const fp32 bench_out_of_range[] = {1.0e7f, -1.0e7f, 3.0e9f, -3.0e9f, 1.0e30f, INFINITY, -INFINITY, NAN};
+
+typedef fp32 (*bench_f1_t)(fp32 x);
+typedef fp32 (*bench_f2_t)(fp32 y, fp32 x);
+
+/*单参数函数*/
+typedef struct
+{
+    const char *name;
+    bench_f1_t f;
+    double (*ref)(double x);
+    double limit;
+} bench_f1_case_t;
+
+/*atan2*/
+typedef struct
+{
+    const char *name;
+    bench_f2_t f;
+    double limit;
+} bench_f2_case_t;
+
+static const bench_f1_case_t bench_sin_case[] =
+{
+    {"sin lut",         fast_sin_lut,       sin, BENCH_LUT_SIN_MAX},
+    {"cos lut",         fast_cos_lut,       cos, BENCH_LUT_SIN_MAX},
+    {"sin fast",        fast_sin_fast,      sin, BENCH_FAST_SIN_MAX},
+    {"cos fast",        fast_cos_fast,      cos, BENCH_FAST_SIN_MAX},
+    {"sin precise",     fast_sin_precise,   sin, BENCH_PRECISE_SIN_MAX},
+    {"cos precise",     fast_cos_precise,   cos, BENCH_PRECISE_SIN_MAX},
+};
+
+static const bench_f2_case_t bench_atan2_case[] =
+{
+    {"atan2 lut",       fast_atan2_lut,     BENCH_LUT_ATAN2_MAX},
+    {"atan2 fast",      fast_atan2_fast,    BENCH_FAST_ATAN2_MAX},
+    {"atan2 precise",   fast_atan2_precise, BENCH_PRECISE_ATAN2_MAX},
+};
+
+#define BENCH_ARRAY_NUM(a) (sizeof(a) / sizeof((a)[0]))
+
+static uint32_t bench_error;
+static uint32_t bench_seed = 0x9E3779B9u;
+static volatile fp32 bench_sink;
+
+static uint32_t bench_rand(void)
+{
+    bench_seed ^= bench_seed << 13;
+    bench_seed ^= bench_seed >> 17;
+    bench_seed ^= bench_seed << 5;
+    return bench_seed;
+}
+
+static double bench_uniform(void)
+{
+    return (double)bench_rand() / 4294967296.0;
+}
+
+static void bench_check(const char *name, double value, double at, double limit)
+{
+    printf("  %-16s max error %.2e at %-12.6g limit %.1e\n", name, value, at, limit);
+    if (value > limit)
+    {
+        fprintf(stderr, "error: %s max error %.3e above %.1e\n", name, value, limit);
+        bench_error++;
+    }
+}
+
+//与参考值的误差 atan2在-PI与PI处为同一角度
+static double bench_angle_error(double a, double ref)
+{
+    double e = fabs(a - ref);
+
+    return (e > M_PI) ? fabs(e - 2.0 * M_PI) : e;
+}
+
+/*----------精度扫描----------*/
+
+static void bench_sweep_sin(const bench_f1_case_t *c)
+{
+    double max_error = 0.0;
+    double max_at = 0.0;
+    double e;
+    fp32 x;
+    uint32_t i;
+    int32_t k;
+
+    for (i = 0; i <= BENCH_SIN_POINTS; i++)
+    {
+        x = -BENCH_SIN_RANGE + 2.0f * BENCH_SIN_RANGE * (fp32)i / (fp32)BENCH_SIN_POINTS;
+        e = fabs((double)c->f(x) - c->ref((double)x));
+        if (e > max_error)
+        {
+            max_error = e;
+            max_at = x;
+        }
+    }
+    //象限边界与查表节点附近 前后各一个最小单位
+    for (k = -127; k <= 127; k++)
+    {
+        fp32 edge = (fp32)(k * M_PI / 4.0);
+        fp32 near[3];
+        uint32_t j;
+
+        near[0] = nextafterf(edge, -INFINITY);
+        near[1] = edge;
+        near[2] = nextafterf(edge, INFINITY);
+        for (j = 0; j < 3u; j++)
+        {
+            if (fabsf(near[j]) > BENCH_SIN_RANGE)
+            {
+                continue;
+            }
+            e = fabs((double)c->f(near[j]) - c->ref((double)near[j]));
+            if (e > max_error)
+            {
+                max_error = e;
+                max_at = near[j];
+            }
+        }
+    }
+    bench_check(c->name, max_error, max_at, c->limit);
+}
+
+static void bench_atan2_point(const bench_f2_case_t *c, fp32 y, fp32 x, double *max_error, double *max_at)
+{
+    double e = bench_angle_error((double)c->f(y, x), atan2((double)y, (double)x));
+
+    if (e > *max_error)
+    {
+        *max_error = e;
+        *max_at = atan2((double)y, (double)x);
+    }
+}
+
+static void bench_sweep_atan2(const bench_f2_case_t *c)
+{
+    static const fp32 radius[] = {1e-3f, 1.0f, 1e3f};
+    double max_error = 0.0;
+    double max_at = 0.0;
+    double angle;
+    uint32_t r;
+    uint32_t i;
+    int32_t y;
+    int32_t x;
+
+    //整圆 输出位置为角度
+    for (r = 0; r < BENCH_ARRAY_NUM(radius); r++)
+    {
+        for (i = 0; i < BENCH_ATAN2_POINTS; i++)
+        {
+            angle = -M_PI + 2.0 * M_PI * (double)i / (double)BENCH_ATAN2_POINTS;
+            bench_atan2_point(c, radius[r] * (fp32)sin(angle), radius[r] * (fp32)cos(angle), &max_error, &max_at);
+        }
+    }
+    //整数网格 包含坐标轴与对角线
+    for (y = -BENCH_ATAN2_GRID; y <= BENCH_ATAN2_GRID; y++)
+    {
+        for (x = -BENCH_ATAN2_GRID; x <= BENCH_ATAN2_GRID; x++)
+        {
+            if (x != 0 || y != 0)
+            {
+                bench_atan2_point(c, (fp32)y, (fp32)x, &max_error, &max_at);
+            }
+        }
+    }
+    bench_check(c->name, max_error, max_at, c->limit);
+}
+
+//相对误差
+static void bench_sqrt_point(fp32 x, double *inv_error, double *inv_at, double *sqrt_error, double *sqrt_at)
+{
+    double ref = sqrt((double)x);
+    double e;
+
+    e = fabs((double)fast_inv_sqrt(x) * ref - 1.0);
+    if (e > *inv_error)
+    {
+        *inv_error = e;
+        *inv_at = x;
+    }
+    e = fabs((double)fast_sqrt(x) / ref - 1.0);
+    if (e > *sqrt_error)
+    {
+        *sqrt_error = e;
+        *sqrt_at = x;
+    }
+}
+
+static void bench_sweep_sqrt(void)
+{
+    double inv_error = 0.0;
+    double inv_at = 0.0;
+    double sqrt_error = 0.0;
+    double sqrt_at = 0.0;
+    fp32 x;
+    uint32_t i;
+
+    //[1,4)中全部单精度数 覆盖初始估计的一个完整周期
+    for (x = 1.0f; x < 4.0f; x = nextafterf(x, INFINITY))
+    {
+        bench_sqrt_point(x, &inv_error, &inv_at, &sqrt_error, &sqrt_at);
+    }
+    //对数均匀 1e-6 ~ 1e6
+    for (i = 0; i < BENCH_SQRT_SAMPLES; i++)
+    {
+        bench_sqrt_point((fp32)pow(10.0, -6.0 + 12.0 * bench_uniform()), &inv_error, &inv_at, &sqrt_error, &sqrt_at);
+    }
+    bench_check("inv_sqrt", inv_error, inv_at, BENCH_SQRT_REL_MAX);
+    bench_check("sqrt", sqrt_error, sqrt_at, BENCH_SQRT_REL_MAX);
+
+    //x<=0返回0
+    if (fast_inv_sqrt(0.0f) != 0.0f || fast_inv_sqrt(-1.0f) != 0.0f || fast_sqrt(0.0f) != 0.0f || fast_sqrt(-1.0f) != 0.0f)
+    {
+        fprintf(stderr, "error: inv_sqrt/sqrt of x <= 0 not 0\n");
+        bench_error++;
+    }
+}
+
+//sin与cos分别统计 门限按档位的sin/cos误差
+static void bench_sweep_sin_cos(void)
+{
+    double sin_error = 0.0;
+    double sin_at = 0.0;
+    double cos_error = 0.0;
+    double cos_at = 0.0;
+    double e;
+    fp32 s;
+    fp32 c;
+    fp32 x;
+    uint32_t i;
+
+    for (i = 0; i <= BENCH_SIN_POINTS; i++)
+    {
+        x = -BENCH_SIN_RANGE + 2.0f * BENCH_SIN_RANGE * (fp32)i / (fp32)BENCH_SIN_POINTS;
+        fast_sin_cos(x, &s, &c);
+        e = fabs((double)s - sin((double)x));
+        if (e > sin_error)
+        {
+            sin_error = e;
+            sin_at = x;
+        }
+        e = fabs((double)c - cos((double)x));
+        if (e > cos_error)
+        {
+            cos_error = e;
+            cos_at = x;
+        }
+    }
+    bench_check("sin_cos sin", sin_error, sin_at, BENCH_SIN_COS_SIN_MAX);
+    bench_check("sin_cos cos", cos_error, cos_at, BENCH_SIN_COS_COS_MAX);
+}
+
+//sin(0)与cos(0)在该档位误差内
+static bool_t bench_is_zero_angle(fp32 s, fp32 c, double limit)
+{
+    return fabs((double)s) <= limit && fabs((double)c - 1.0) <= limit;
+}
+
+//超范围与inf/NaN输入: 所有档位按x=0处理, 不能出现浮点转整数溢出
+static void bench_out_of_range_check(void)
+{
+    fp32 s;
+    fp32 c;
+    uint32_t i;
+
+    for (i = 0; i < BENCH_ARRAY_NUM(bench_out_of_range); i++)
+    {
+        fp32 x = bench_out_of_range[i];
+
+        fast_sin_cos(x, &s, &c);
+        if (!bench_is_zero_angle(s, c, BENCH_SIN_COS_COS_MAX)
+            || !bench_is_zero_angle(fast_sin_lut(x), fast_cos_lut(x), BENCH_LUT_SIN_MAX)
+            || !bench_is_zero_angle(fast_sin_fast(x), fast_cos_fast(x), BENCH_FAST_SIN_MAX)
+            || !bench_is_zero_angle(fast_sin_precise(x), fast_cos_precise(x), BENCH_PRECISE_SIN_MAX))
+        {
+            fprintf(stderr, "error: sin/cos of %g not 0/1\n", (double)x);
+            bench_error++;
+        }
+    }
+    printf("  %-16s %u inputs (|x| >= 1e7, inf, NaN) -> sin 0, cos 1\n", "out of range", (unsigned)BENCH_ARRAY_NUM(bench_out_of_range));
+}
+
+/*----------周期数----------*/
+
+static int bench_compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void bench_print_dist(const char *name, double *value, uint32_t count)
+{
+    qsort(value, count, sizeof(value[0]), bench_compare_double);
+    printf("  %-16s median %6.1f  p99 %6.1f cycles/call\n", name, value[count / 2], value[count * 99 / 100]);
+}
+
+static void bench_cycles_f1(const char *name, bench_f1_t f, const fp32 *in)
+{
+    static double cycles[BENCH_BATCH_NUM];
+    uint32_t start;
+    uint32_t b;
+    uint32_t i;
+
+    for (b = 0; b < BENCH_BATCH_NUM; b++)
+    {
+        start = dwt_cycle_get();
+        for (i = 0; i < BENCH_BATCH_SIZE; i++)
+        {
+            bench_sink = f(in[i]);
+        }
+        cycles[b] = (double)(dwt_cycle_get() - start) / BENCH_BATCH_SIZE;
+    }
+    bench_print_dist(name, cycles, BENCH_BATCH_NUM);
+}
+
+static void bench_cycles_f2(const char *name, bench_f2_t f, const fp32 *in_y, const fp32 *in_x)
+{
+    static double cycles[BENCH_BATCH_NUM];
+    uint32_t start;
+    uint32_t b;
+    uint32_t i;
+
+    for (b = 0; b < BENCH_BATCH_NUM; b++)
+    {
+        start = dwt_cycle_get();
+        for (i = 0; i < BENCH_BATCH_SIZE; i++)
+        {
+            bench_sink = f(in_y[i], in_x[i]);
+        }
+        cycles[b] = (double)(dwt_cycle_get() - start) / BENCH_BATCH_SIZE;
+    }
+    bench_print_dist(name, cycles, BENCH_BATCH_NUM);
+}
+
+//libm单精度函数 与被测函数一样经函数指针调用
+static fp32 bench_libm_sin(fp32 x)
+{
+    return sinf(x);
+}
+
+static fp32 bench_libm_cos(fp32 x)
+{
+    return cosf(x);
+}
+
+static fp32 bench_libm_atan2(fp32 y, fp32 x)
+{
+    return atan2f(y, x);
+}
+
+static fp32 bench_libm_inv_sqrt(fp32 x)
+{
+    return 1.0f / sqrtf(x);
+}
+
+static fp32 bench_libm_sqrt(fp32 x)
+{
+    return sqrtf(x);
+}
+
+static void bench_cycles(void)
+{
+    static fp32 angle[BENCH_BATCH_SIZE];
+    static fp32 pos[BENCH_BATCH_SIZE];
+    static fp32 y[BENCH_BATCH_SIZE];
+    static fp32 x[BENCH_BATCH_SIZE];
+    uint32_t i;
+
+    //控制中常见的输入范围: 角度[-2PI, 2PI], 坐标[-1000, 1000], 模长平方(0, 1e4]
+    for (i = 0; i < BENCH_BATCH_SIZE; i++)
+    {
+        angle[i] = (fp32)((bench_uniform() * 4.0 - 2.0) * M_PI);
+        y[i] = (fp32)(bench_uniform() * 2000.0 - 1000.0);
+        x[i] = (fp32)(bench_uniform() * 2000.0 - 1000.0);
+        pos[i] = (fp32)(bench_uniform() * 1e4 + 1e-3);
+    }
+
+    printf("cycles per call:\n");
+    bench_cycles_f1("sinf (libm)", bench_libm_sin, angle);
+    bench_cycles_f1("sin lut", fast_sin_lut, angle);
+    bench_cycles_f1("sin fast", fast_sin_fast, angle);
+    bench_cycles_f1("sin precise", fast_sin_precise, angle);
+    bench_cycles_f1("cosf (libm)", bench_libm_cos, angle);
+    bench_cycles_f1("cos lut", fast_cos_lut, angle);
+    bench_cycles_f1("cos fast", fast_cos_fast, angle);
+    bench_cycles_f1("cos precise", fast_cos_precise, angle);
+    bench_cycles_f2("atan2f (libm)", bench_libm_atan2, y, x);
+    bench_cycles_f2("atan2 lut", fast_atan2_lut, y, x);
+    bench_cycles_f2("atan2 fast", fast_atan2_fast, y, x);
+    bench_cycles_f2("atan2 precise", fast_atan2_precise, y, x);
+    bench_cycles_f1("1/sqrtf (libm)", bench_libm_inv_sqrt, pos);
+    bench_cycles_f1("inv_sqrt", fast_inv_sqrt, pos);
+    bench_cycles_f1("sqrtf (libm)", bench_libm_sqrt, pos);
+    bench_cycles_f1("sqrt", fast_sqrt, pos);
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    printf("max abs error, |x| <= %.0f rad (inv_sqrt/sqrt: relative), tier %d\n", (double)BENCH_SIN_RANGE, FAST_MATH_TIER);
+    for (i = 0; i < BENCH_ARRAY_NUM(bench_sin_case); i++)
+    {
+        bench_sweep_sin(&bench_sin_case[i]);
+    }
+    for (i = 0; i < BENCH_ARRAY_NUM(bench_atan2_case); i++)
+    {
+        bench_sweep_atan2(&bench_atan2_case[i]);
+    }
+    bench_sweep_sin_cos();
+    bench_out_of_range_check();
+    bench_sweep_sqrt();
+    bench_cycles();
+
+    if (bench_error != 0)
+    {
+        fprintf(stderr, "fast_math_bench: %u errors\n", (unsigned)bench_error);
+        return 1;
+    }
+    printf("fast_math_bench: ok\n");
+    return 0;
+}
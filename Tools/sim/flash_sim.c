@@ -0,0 +1,474 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       flash_sim.c
+  * @brief      flash键值存储掉电测试，在sim_flash上运行flash_store.c，
+  *             在写入与整理的每一次擦写处掉电后重新载入，检查值与下次写入位置；
+  *             并检查参数保存擦除扇区前电机电流置0。
+  * @note       flash_store使用1KB的逻辑扇区(126条记录), 整理频繁。
+  *             检查失败时返回1, make bench时运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: flash_sim
+    torn:    只写入了value、key为擦除值的记录载入为损坏(包括CRC恰好相符的value),
+             下次写入位置在它之后; 写入失败跳过的空位置之后的记录仍然载入
+    cut:     写入SIM_WRITE_NUM次(含多次整理), 在每一次擦写处掉电, 该次操作
+             不改变/改变随机一部分位/完成, 重新上电载入后:
+               每个值等于最后一次写入成功的值, 掉电时正在写的值也可以是新值
+               损坏的记录最多1条, 继续写入不出错, 再次载入与RAM中的值一致
+    compact: 扇区写满后整理, 在整理的每一次擦写处掉电, valid标记写入前使用旧扇区
+    param:   调度器运行时参数保存触发整理, 擦除前底盘、云台、摩擦轮电流为0,
+             调度器启动前(param_init格式化)不发送控制帧
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <stdio.h>
+#include <string.h>
+#include "main.h"
+#include "cmsis_os.h"
+#include "bsp_flash.h"
+#include "flash_store.h"
+#include "crc.h"
+#include "param.h"
+#include "CAN_receive.h"
+#include "sim_flash.h"
+#include "sim_can.h"
+#include "sim_os.h"
+
+#define SIM_SECTOR_SIZE     1024u   //逻辑扇区 (1024-16)/8 = 126条记录
+#define SIM_VALUE_NUM       8u
+#define SIM_WRITE_NUM       400u    //每次测试的写入次数 约3次整理
+#define SIM_TEAR_NUM        3u
+#define SIM_BUS_VOLTAGE     24.0f
+
+static const uint16_t sim_key[SIM_VALUE_NUM] = {0x1001, 0x1002, 0x2001, 0x2002, 0x3001, 0x3002, 0x4001, 0x4002};
+static const uint32_t sim_sector[2] = {FLASH_SECTOR_10, FLASH_SECTOR_11};
+static const uint32_t sim_addr[2] = {PARAM_FLASH_SECTOR0_ADDR, PARAM_FLASH_SECTOR1_ADDR};
+static const char *const sim_tear_name[SIM_TEAR_NUM] = {"none", "random", "all"};
+
+static uint32_t sim_error;
+static const char *sim_current;
+static uint32_t sim_seed;
+
+static void sim_check(bool_t ok, const char *what, uint32_t value, uint32_t expect)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "error: %s: %s %u, expect %u\n", sim_current, what, (unsigned)value, (unsigned)expect);
+        sim_error++;
+    }
+}
+
+static uint32_t sim_rand(void)
+{
+    sim_seed ^= sim_seed << 13;
+    sim_seed ^= sim_seed >> 17;
+    sim_seed ^= sim_seed << 5;
+    return sim_seed;
+}
+
+/*--------flash操作 与param.c相同 逻辑扇区较小--------*/
+
+static bool_t sim_erase(uint8_t sector)
+{
+    return bsp_flash_erase_sector(sim_sector[sector]);
+}
+
+static bool_t sim_program(uint8_t sector, uint32_t offset, uint32_t data)
+{
+    return bsp_flash_program_word(sim_addr[sector] + offset, data);
+}
+
+static const volatile uint32_t *sim_read(uint8_t sector)
+{
+    return (const volatile uint32_t *)(uintptr_t)sim_addr[sector];
+}
+
+static const flash_store_ops_t sim_ops = {SIM_SECTOR_SIZE, sim_erase, sim_program, sim_read};
+
+//默认值
+static void sim_default(uint32_t value[SIM_VALUE_NUM])
+{
+    uint32_t i;
+
+    for (i = 0; i < SIM_VALUE_NUM; i++)
+    {
+        value[i] = 0xD0000000u | i;
+    }
+}
+
+//重新上电载入
+static void sim_reload(flash_store_t *store, uint32_t value[SIM_VALUE_NUM])
+{
+    sim_flash_power_on();
+    memset(store, 0, sizeof(flash_store_t));
+    sim_default(value);
+    flash_store_init(store, &sim_ops, sim_key, value, SIM_VALUE_NUM);
+}
+
+//擦除后格式化 写入默认值
+static void sim_format(flash_store_t *store, uint32_t value[SIM_VALUE_NUM])
+{
+    sim_flash_init();
+    sim_reload(store, value);
+}
+
+//写入一个随机值 返回写入的编号
+static uint32_t sim_write_random(flash_store_t *store, uint32_t value[SIM_VALUE_NUM])
+{
+    uint32_t index = sim_rand() % SIM_VALUE_NUM;
+
+    value[index] = sim_rand();
+    flash_store_write(store, (uint16_t)index);
+    return index;
+}
+
+/*--------torn--------*/
+
+//找到一个value 使key为擦除值的记录CRC恰好相符
+static uint32_t sim_crc_collision(void)
+{
+    uint8_t data[6] = {0xFF, 0xFF, 0, 0, 0, 0};
+    uint32_t value;
+
+    for (value = 0; value != 0xFFFFFFFFu; value++)
+    {
+        data[2] = (uint8_t)value;
+        data[3] = (uint8_t)(value >> 8);
+        data[4] = (uint8_t)(value >> 16);
+        data[5] = (uint8_t)(value >> 24);
+        if (get_CRC16_check_sum(data, sizeof(data), CRC16_INIT) == 0xFFFFu)
+        {
+            return value;
+        }
+    }
+    return 0;
+}
+
+static void sim_torn_value(const char *name, uint32_t torn_value)
+{
+    flash_store_t store;
+    uint32_t value[SIM_VALUE_NUM];
+    uint32_t expect[SIM_VALUE_NUM];
+    uint32_t offset;
+    uint32_t i;
+
+    sim_current = name;
+    sim_seed = 0x1234u;
+    sim_format(&store, value);
+    for (i = 0; i < 20u; i++)
+    {
+        sim_write_random(&store, value);
+    }
+    memcpy(expect, value, sizeof(expect));
+
+    //掉电时只写入了value
+    offset = store.write_offset;
+    bsp_flash_program_word(sim_addr[store.active] + offset + 4u, torn_value);
+
+    sim_reload(&store, value);
+    sim_check(store.corrupt_count == 1u, "corrupt_count", store.corrupt_count, 1);
+    sim_check(store.write_offset == offset + FLASH_STORE_RECORD_SIZE, "write_offset", store.write_offset, offset + FLASH_STORE_RECORD_SIZE);
+    sim_check(memcmp(value, expect, sizeof(expect)) == 0, "values", 0, 0);
+
+    //下一条写在损坏记录之后
+    value[3] = 0x33333333u;
+    sim_check(flash_store_write(&store, 3), "write after torn", 0, 1);
+    memcpy(expect, value, sizeof(expect));
+    sim_reload(&store, value);
+    sim_check(store.error_count == 0 && store.corrupt_count == 1u, "corrupt_count after write", store.corrupt_count, 1);
+    sim_check(memcmp(value, expect, sizeof(expect)) == 0, "values after write", value[3], expect[3]);
+    printf("torn: %-22s value 0x%08x, write_offset %u -> %u\n", name, (unsigned)torn_value, (unsigned)offset, (unsigned)store.write_offset);
+}
+
+//写入失败跳过的空位置 之后的记录仍然载入 下次写入位置不回退
+static void sim_torn_hole(void)
+{
+    flash_store_t store;
+    uint32_t value[SIM_VALUE_NUM];
+    uint32_t expect[SIM_VALUE_NUM];
+    uint32_t hole;
+    uint32_t i;
+
+    sim_current = "hole";
+    sim_seed = 0x5678u;
+    sim_format(&store, value);
+    for (i = 0; i < 10u; i++)
+    {
+        sim_write_random(&store, value);
+    }
+
+    //写入失败时flash_store_write跳过该位置 写入出错时该位置可能没有改变
+    hole = store.write_offset;
+    sim_flash_cut(1, SIM_FLASH_TEAR_NONE, 1);
+    value[5] = 0x55555555u;
+    flash_store_write(&store, 5);
+    sim_flash_power_on();
+    value[5] = 0x55555556u;
+    flash_store_write(&store, 5);
+    value[6] = 0x66666666u;
+    flash_store_write(&store, 6);
+    memcpy(expect, value, sizeof(expect));
+    i = store.write_offset;
+
+    sim_reload(&store, value);
+    sim_check(store.write_offset == i, "write_offset", store.write_offset, i);
+    sim_check(store.corrupt_count == 0, "corrupt_count", store.corrupt_count, 0);
+    sim_check(memcmp(value, expect, sizeof(expect)) == 0, "values", value[5], expect[5]);
+    printf("torn: %-22s hole at %u, write_offset %u\n", "skipped slot", (unsigned)hole, (unsigned)store.write_offset);
+}
+
+/*--------cut--------*/
+
+typedef struct
+{
+    uint32_t runs;
+    uint32_t in_compact;
+    uint32_t corrupt;
+    uint32_t old_sector;
+    uint32_t new_sector;
+} sim_cut_stat_t;
+
+/**
+  * @brief          在第cut次擦写处掉电 检查重新载入与继续写入
+  * @param[in]      seed: 写入序列的随机种子
+  * @param[in]      prefill: 设置掉电点前的写入次数(不掉电)
+  * @param[in]      cut: 设置掉电点后第几次擦写掉电
+  * @param[in]      tear: 掉电时该次操作完成多少
+  * @param[in,out]  stat: 统计
+  */
+static void sim_cut_run(uint32_t seed, uint32_t prefill, uint32_t cut, sim_flash_tear_e tear, sim_cut_stat_t *stat)
+{
+    flash_store_t store;
+    uint32_t value[SIM_VALUE_NUM];
+    uint32_t committed[SIM_VALUE_NUM];
+    uint32_t index = SIM_VALUE_NUM;
+    uint32_t inflight = 0;
+    uint32_t generation;
+    bool_t compacting = 0;
+    uint32_t i;
+
+    sim_seed = seed;
+    sim_format(&store, value);
+    for (i = 0; i < prefill; i++)
+    {
+        sim_write_random(&store, value);
+    }
+    generation = store.generation;
+    memcpy(committed, value, sizeof(committed));
+
+    sim_flash_cut(cut, tear, seed + cut);
+    for (i = 0; i < SIM_WRITE_NUM && !sim_flash_is_off(); i++)
+    {
+        compacting = (store.write_offset + FLASH_STORE_RECORD_SIZE > SIM_SECTOR_SIZE);
+        generation = store.generation;
+        index = sim_write_random(&store, value);
+        if (!sim_flash_is_off())
+        {
+            committed[index] = value[index];
+        }
+    }
+    if (!sim_flash_is_off())
+    {
+        return;
+    }
+    inflight = value[index];
+    stat->runs++;
+    stat->in_compact += compacting;
+
+    //重新上电 每个值为最后一次写入成功的值 正在写的可以是新值
+    sim_reload(&store, value);
+    for (i = 0; i < SIM_VALUE_NUM; i++)
+    {
+        if (value[i] != committed[i] && !(i == index && value[i] == inflight))
+        {
+            fprintf(stderr, "error: %s: seed %u cut %u tear %s: value %u = 0x%08x, expect 0x%08x\n", sim_current, (unsigned)seed,
+                    (unsigned)cut, sim_tear_name[tear], (unsigned)i, (unsigned)value[i], (unsigned)committed[i]);
+            sim_error++;
+        }
+    }
+    sim_check(store.corrupt_count <= 1u, "corrupt_count", store.corrupt_count, 1);
+    sim_check(store.generation == generation || store.generation == generation + 1u, "generation", store.generation, generation);
+    stat->corrupt += store.corrupt_count;
+    if (compacting)
+    {
+        if (store.generation == generation)
+        {
+            stat->old_sector++;
+        }
+        else
+        {
+            stat->new_sector++;
+        }
+    }
+
+    //继续写入 下次写入位置不能落在写过的位置
+    for (i = 0; i < SIM_WRITE_NUM; i++)
+    {
+        sim_write_random(&store, value);
+    }
+    sim_check(store.error_count == 0, "error_count after reload", store.error_count, 0);
+    memcpy(committed, value, sizeof(committed));
+    sim_reload(&store, value);
+    sim_check(memcmp(value, committed, sizeof(committed)) == 0, "values after second reload", 0, 0);
+}
+
+//无掉电运行一次 得到设置掉电点后的擦写次数
+static uint32_t sim_cut_op_num(uint32_t seed, uint32_t prefill, uint32_t write_num)
+{
+    flash_store_t store;
+    uint32_t value[SIM_VALUE_NUM];
+    uint32_t op;
+    uint32_t i;
+
+    sim_seed = seed;
+    sim_format(&store, value);
+    for (i = 0; i < prefill; i++)
+    {
+        sim_write_random(&store, value);
+    }
+    op = sim_flash_op_count();
+    for (i = 0; i < write_num; i++)
+    {
+        sim_write_random(&store, value);
+    }
+    return sim_flash_op_count() - op;
+}
+
+static void sim_cut(void)
+{
+    sim_cut_stat_t stat;
+    uint32_t op_num = sim_cut_op_num(0xC0FFEEu, 0, SIM_WRITE_NUM);
+    uint32_t op;
+    uint32_t tear;
+
+    sim_current = "cut";
+    memset(&stat, 0, sizeof(stat));
+    for (tear = 0; tear < SIM_TEAR_NUM; tear++)
+    {
+        for (op = 1; op <= op_num; op++)
+        {
+            sim_cut_run(0xC0FFEEu, 0, op, (sim_flash_tear_e)tear, &stat);
+        }
+    }
+    sim_check(stat.runs == op_num * SIM_TEAR_NUM, "runs", stat.runs, op_num * SIM_TEAR_NUM);
+    printf("cut: %u writes, %u cut points x %u tears, %u in compaction, %u corrupt records after reload\n", (unsigned)SIM_WRITE_NUM,
+           (unsigned)op_num, (unsigned)SIM_TEAR_NUM, (unsigned)stat.in_compact, (unsigned)stat.corrupt);
+}
+
+/*--------compact--------*/
+
+static void sim_compact(void)
+{
+    //格式化后每个扇区可追加126-8条 触发整理的写入不追加
+    //两次整理后两个扇区都写过 再写满当前扇区 下一次写入触发整理
+    const uint32_t prefill = 3u * ((SIM_SECTOR_SIZE - FLASH_STORE_HEADER_SIZE) / FLASH_STORE_RECORD_SIZE - SIM_VALUE_NUM) + 2u;
+    sim_cut_stat_t stat;
+    uint32_t op_num = sim_cut_op_num(0xBEEFu, prefill, 1);
+    uint32_t op;
+    uint32_t tear;
+
+    sim_current = "compact";
+    memset(&stat, 0, sizeof(stat));
+    sim_check(op_num == 1u + 3u + 2u * SIM_VALUE_NUM + 1u, "compaction ops", op_num, 1u + 3u + 2u * SIM_VALUE_NUM + 1u);
+    for (tear = 0; tear < SIM_TEAR_NUM; tear++)
+    {
+        for (op = 1; op <= op_num; op++)
+        {
+            sim_cut_run(0xBEEFu, prefill, op, (sim_flash_tear_e)tear, &stat);
+        }
+    }
+    sim_check(stat.in_compact == op_num * SIM_TEAR_NUM, "cuts in compaction", stat.in_compact, op_num * SIM_TEAR_NUM);
+    //只有valid标记完整写入后才切换扇区
+    sim_check(stat.new_sector <= 2u, "new sector before valid", stat.new_sector, 2);
+    printf("compact: %u cut points x %u tears, old sector %u, new sector %u\n", (unsigned)op_num, (unsigned)SIM_TEAR_NUM,
+           (unsigned)stat.old_sector, (unsigned)stat.new_sector);
+}
+
+/*--------param--------*/
+
+static sim_can_node_t *sim_chassis_node;
+static sim_can_node_t *sim_yaw_node;
+static sim_can_node_t *sim_fric_node;
+static uint32_t sim_param_saves;
+
+//参数保存直到整理 整理擦除扇区前电机电流应为0
+static void sim_param_task(void const *argument)
+{
+    const flash_store_t *store = get_param_store_point();
+    uint32_t compact_count = store->compact_count;
+    param_value_t burst;
+
+    (void)argument;
+    CAN_cmd_chassis(1000, 1000, 1000, 1000);
+    CAN_cmd_gimbal(2000, 2000, 0, 0);
+    CAN_cmd_friction(3000, 3000);
+    sim_check(sim_chassis_node->motor.command == 1000 && sim_yaw_node->motor.command == 2000 &&
+              sim_fric_node->motor.command == 3000, "command before save", sim_chassis_node->motor.command, 1000);
+
+    for (sim_param_saves = 0; sim_param_saves < 2u * PARAM_FLASH_SECTOR_SIZE / FLASH_STORE_RECORD_SIZE &&
+                              store->compact_count == compact_count; sim_param_saves++)
+    {
+        burst.i = 2 + (int32_t)(sim_param_saves & 1u);
+        param_set(PARAM_SHOOT_BURST_NUM, burst);
+        param_save();
+    }
+    for (;;)
+    {
+        osDelay(1);
+    }
+}
+
+static void sim_param(void)
+{
+    uint32_t tx[2];
+
+    sim_current = "param";
+    sim_os_init();
+    sim_can_init();
+    sim_chassis_node = sim_can_add_motor(SIM_CAN1, CAN_3508_M1_ID, MOTOR_SIM_M3508, SIM_BUS_VOLTAGE);
+    sim_yaw_node = sim_can_add_motor(SIM_CAN2, CAN_YAW_MOTOR_ID, MOTOR_SIM_GM6020, SIM_BUS_VOLTAGE);
+    sim_fric_node = sim_can_add_motor(SIM_CAN2, CAN_FRIC_M1_ID, MOTOR_SIM_M3508, SIM_BUS_VOLTAGE);
+    sim_flash_init();
+
+    //调度器启动前格式化 不发送控制帧
+    param_init();
+    sim_check(get_param_store_point()->compact_count == 1u, "format", get_param_store_point()->compact_count, 1);
+    sim_check(sim_can_get_stat(SIM_CAN1)->tx_count == 0 && sim_can_get_stat(SIM_CAN2)->tx_count == 0, "tx before scheduler",
+              sim_can_get_stat(SIM_CAN1)->tx_count, 0);
+
+    sim_os_run(sim_param_task, 1);
+    tx[0] = sim_can_get_stat(SIM_CAN1)->tx_count;
+    tx[1] = sim_can_get_stat(SIM_CAN2)->tx_count;
+    sim_check(get_param_store_point()->compact_count == 2u, "compaction", get_param_store_point()->compact_count, 2);
+    //控制帧1+2条 擦除前零电流帧1+2条
+    sim_check(tx[0] == 2u && tx[1] == 4u, "tx frames", tx[0] + tx[1], 6);
+    sim_check(sim_chassis_node->motor.command == 0, "chassis command", (uint32_t)sim_chassis_node->motor.command, 0);
+    sim_check(sim_yaw_node->motor.command == 0, "yaw command", (uint32_t)sim_yaw_node->motor.command, 0);
+    sim_check(sim_fric_node->motor.command == 0, "friction command", (uint32_t)sim_fric_node->motor.command, 0);
+    printf("param: compaction after %u saves, commands before erase %d %d %d\n", (unsigned)sim_param_saves,
+           sim_chassis_node->motor.command, sim_yaw_node->motor.command, sim_fric_node->motor.command);
+}
+
+int main(void)
+{
+    sim_torn_value("value only", 0x12345678u);
+    sim_torn_value("value only, crc match", sim_crc_collision());
+    sim_torn_hole();
+    sim_cut();
+    sim_compact();
+    sim_param();
+
+    if (sim_error != 0)
+    {
+        fprintf(stderr, "flash_sim: %u errors\n", (unsigned)sim_error);
+        return 1;
+    }
+    printf("flash_sim: ok\n");
+    return 0;
+}
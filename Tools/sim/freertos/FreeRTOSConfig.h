@@ -0,0 +1,26 @@
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*
+  上位机编译heap_4.c用的最小配置 只用于mem_pool_bench与FreeRTOS堆比较
+  堆加大到64KB以便制造碎片, 其余选项只为通过FreeRTOS.h的检查
+*/
+
+#include <assert.h>
+
+#define configUSE_PREEMPTION                1
+#define configSUPPORT_STATIC_ALLOCATION     1
+#define configSUPPORT_DYNAMIC_ALLOCATION    1
+#define configUSE_IDLE_HOOK                 0
+#define configUSE_TICK_HOOK                 0
+#define configMAX_PRIORITIES                7
+#define configMINIMAL_STACK_SIZE            128
+#define configTOTAL_HEAP_SIZE               ((size_t)65536)
+#define configMAX_TASK_NAME_LEN             16
+#define configUSE_16_BIT_TICKS              0
+#define configUSE_MUTEXES                   1
+#define configUSE_MALLOC_FAILED_HOOK        0
+
+#define configASSERT(x) assert(x)
+
+#endif
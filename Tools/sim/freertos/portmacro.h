@@ -0,0 +1,36 @@
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+/*
+  上位机编译heap_4.c用的最小移植层 只定义类型与对齐
+  vTaskSuspendAll/xTaskResumeAll由mem_pool_bench.c实现(互斥锁)
+*/
+
+#include <stdint.h>
+
+#define portSTACK_TYPE          uint32_t
+#define portBASE_TYPE           long
+#define portPOINTER_SIZE_TYPE   uintptr_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY           (TickType_t)0xffffffffUL
+#define portBYTE_ALIGNMENT      8
+#define portSTACK_GROWTH        (-1)
+#define portTICK_PERIOD_MS      ((TickType_t)1)
+
+#define portYIELD()
+#define portENTER_CRITICAL()
+#define portEXIT_CRITICAL()
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portSET_INTERRUPT_MASK_FROM_ISR()       0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)    (void)(x)
+
+#define portTASK_FUNCTION_PROTO(vFunction, pvParameters) void vFunction(void *pvParameters)
+#define portTASK_FUNCTION(vFunction, pvParameters) void vFunction(void *pvParameters)
+
+#endif
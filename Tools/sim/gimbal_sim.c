@@ -0,0 +1,481 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       gimbal_sim.c
+  * @brief      云台任务上位机闭环仿真，CAN2上两个GM6020模型(偏航0x205、俯仰0x206)，
+  *             运行未修改的gimbal_task，检查阶跃响应、小陀螺时的指向保持、俯仰软限位、
+  *             姿态数据中断时切换编码器控制与遥控器下档无力。
+  * @note       ins话题由仿真直接发布: 姿态角为车体转角加电机相对角度，陀螺仪由欧拉角导数换算，
+  *             不经过姿态解算。偏航负载含车体角加速度的惯性力矩，俯仰负载含枪管重力矩与机械限位。
+  *             调参: 修改config_freame.h中的云台PID参数后重新编译，-o输出每毫秒的CSV。
+  *             检查失败时返回1, make bench时运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: gimbal_sim [-o out.csv]
+    过程(ms):
+      200   遥控器中档 姿态角控制
+      600   偏航目标阶跃SIM_YAW_STEP_DEG     1600  俯仰目标阶跃SIM_PITCH_STEP_DEG
+      2600  车体以小陀螺转速旋转 4600停止
+      5200  俯仰摇杆推满 到达下限位 5700反向推满 到达上限位 6700松开
+      7200  停止发布ins话题 8200恢复
+      8800  遥控器下档
+    阶跃输出: 上升时间(10%~90%)、超调、进入±SIM_SETTLE_BAND_DEG的调节时间
+    CSV列: t_ms, mode, yaw_set, yaw_fdb, yaw_rel(rad), yaw_out, pitch_set, pitch_fdb, pitch_rel(rad),
+           pitch_out, chassis_wz(rad/s)
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "config_freame.h"
+#include "CAN_receive.h"
+#include "param.h"
+#include "gimbal_task.h"
+#include "ins_task.h"
+#include "referee_task.h"
+#include "sim_os.h"
+#include "sim_can.h"
+#include "sim_rc.h"
+#include "sim_flash.h"
+#include "sim_scenario.h"
+
+#define SIM_PI                      3.14159265f
+#define SIM_DEG                     0.01745329f
+#define SIM_BUS_VOLTAGE             24.0f
+#define SIM_DURATION_MS             9200u
+
+/*负载*/
+#define SIM_YAW_LOAD_INERTIA        0.03f       //偏航以上部分 kg·m²
+#define SIM_PITCH_LOAD_INERTIA      0.012f      //俯仰轴 kg·m²
+#define SIM_PITCH_GRAVITY_TORQUE    0.3f        //枪管水平时的重力矩 使俯仰角增大(向下) N·m
+#define SIM_PITCH_STOP_ANGLE        (35.0f * SIM_DEG)   //机械限位
+#define SIM_PITCH_STOP_STIFFNESS    50.0f       //N·m/rad
+#define SIM_PITCH_STOP_DAMPING      0.5f        //N·m·s/rad
+
+/*过程*/
+#define SIM_ENABLE_MS               200u
+#define SIM_YAW_STEP_MS             600u
+#define SIM_YAW_STEP_DEG            30.0f
+#define SIM_PITCH_STEP_MS           1600u
+#define SIM_PITCH_STEP_DEG          10.0f
+#define SIM_STEP_WINDOW_MS          800u
+#define SIM_SETTLE_BAND_DEG         0.5f
+#define SIM_SPIN_START_MS           2600u
+#define SIM_SPIN_STOP_MS            4600u
+#define SIM_SPIN_RAMP_MS            300u
+#define SIM_SPIN_SPEED              (CONFIG_CHASSIS_SPIN_SPEED_DPS * SIM_DEG)
+#define SIM_LIMIT_START_MS          5200u
+#define SIM_LIMIT_END_MS            6700u
+#define SIM_INS_LOST_MS             7200u
+#define SIM_INS_RECOVER_MS          8200u
+#define SIM_DISABLE_MS              8800u
+
+/*检查门限*/
+#define SIM_STEP_RISE_MAX_MS        150u
+#define SIM_STEP_OVERSHOOT_MAX      0.10f
+#define SIM_STEP_SETTLE_MAX_MS      400u
+#define SIM_SPIN_ERROR_MAX_DEG      3.0f        //转速变化时
+#define SIM_SPIN_ERROR_RMS_DEG      0.5f        //匀速旋转时
+#define SIM_LIMIT_MARGIN_DEG        1.0f
+#define SIM_SWITCH_JUMP_MAX_DEG     1.0f        //切换控制模式后500ms内的角度变化
+
+//仿真姿态 由电机角度与车体转角直接给出
+MSG_BUS_TOPIC_DEFINE(ins, ins_msg_t, 1, 2);
+//发射任务订阅 不发布(裁判系统离线)
+MSG_BUS_TOPIC_DEFINE(referee, referee_msg_t, 1, 1);
+
+extern gimbal_control_t gimbal_control_data;
+
+static const char *const sim_scenario_text[] =
+{
+    "0    sw0=down",
+    "200  sw0=mid",
+    "5200 ch3=660",
+    "5700 ch3=-660",
+    "6700 ch3=0",
+    "8800 sw0=down",
+};
+
+/*阶跃响应统计*/
+typedef struct
+{
+    const char *name;
+    uint32_t start_ms;
+    fp32 step;                  //rad
+    fp32 start;                 //阶跃时的反馈
+    uint32_t t10_ms;
+    uint32_t t90_ms;
+    uint32_t settle_ms;         //最后一次在误差带外的时间
+    fp32 peak;                  //归一化的最大值
+} sim_step_t;
+
+static sim_scenario_t sim_scenario_data;
+static sim_can_node_t *sim_yaw_node;
+static sim_can_node_t *sim_pitch_node;
+static FILE *sim_csv;
+
+static fp32 sim_time;           //物理模型时间 s
+static fp32 sim_chassis_yaw;    //车体转角 rad
+static fp32 sim_chassis_wz;     //车体角速度 rad/s
+
+static sim_step_t sim_yaw_step = {"yaw", SIM_YAW_STEP_MS, SIM_YAW_STEP_DEG * SIM_DEG, 0.0f, 0, 0, 0, 0.0f};
+static sim_step_t sim_pitch_step = {"pitch", SIM_PITCH_STEP_MS, SIM_PITCH_STEP_DEG * SIM_DEG, 0.0f, 0, 0, 0, 0.0f};
+
+static fp32 sim_spin_error_max;
+static fp64 sim_spin_error_sum2;
+static uint32_t sim_spin_error_count;
+static fp32 sim_pitch_rel_min;
+static fp32 sim_pitch_rel_max;
+static uint32_t sim_relative_ms;    //切换为编码器控制的时间
+static uint32_t sim_absolute_ms;    //恢复姿态角控制的时间
+static fp32 sim_switch_yaw;         //切换时的偏航相对角度
+static fp32 sim_switch_pitch;
+static fp32 sim_switch_jump_max;
+static uint32_t sim_zero_ms;        //下档后控制帧电压为0的时间
+static uint32_t sim_error;
+
+static fp32 sim_wrap(fp32 angle)
+{
+    while (angle >= SIM_PI)
+    {
+        angle -= 2.0f * SIM_PI;
+    }
+    while (angle < -SIM_PI)
+    {
+        angle += 2.0f * SIM_PI;
+    }
+    return angle;
+}
+
+//电机转子角度 -> 相对中位的角度 方向与姿态角一致
+static fp32 sim_relative_angle(const sim_can_node_t *node, uint16_t offset_ecd, int8_t dir)
+{
+    return dir * sim_wrap(node->motor.angle - offset_ecd * (2.0f * SIM_PI / GIMBAL_ECD_RANGE));
+}
+
+//车体角速度 匀加速到小陀螺转速 匀减速停止
+static fp32 sim_chassis_speed(fp32 t)
+{
+    const fp32 start = SIM_SPIN_START_MS * 0.001f;
+    const fp32 stop = SIM_SPIN_STOP_MS * 0.001f;
+    const fp32 ramp = SIM_SPIN_RAMP_MS * 0.001f;
+
+    if (t < start || t >= stop + ramp)
+    {
+        return 0.0f;
+    }
+    if (t < start + ramp)
+    {
+        return SIM_SPIN_SPEED * (t - start) / ramp;
+    }
+    if (t >= stop)
+    {
+        return SIM_SPIN_SPEED * (1.0f - (t - stop) / ramp);
+    }
+    return SIM_SPIN_SPEED;
+}
+
+static void sim_step(fp32 dt, void *user)
+{
+    motor_sim_t *yaw = &sim_yaw_node->motor;
+    motor_sim_t *pitch = &sim_pitch_node->motor;
+    fp32 wz = sim_chassis_speed(sim_time + dt);
+    fp32 pitch_angle = sim_relative_angle(sim_pitch_node, GIMBAL_PITCH_OFFSET_ECD, GIMBAL_PITCH_MOTOR_DIR);
+    fp32 pitch_speed = GIMBAL_PITCH_MOTOR_DIR * pitch->speed;
+    fp32 torque;
+
+    (void)user;
+
+    //定子随车体转动 转子侧受车体角加速度的惯性力矩
+    yaw->load_torque = GIMBAL_YAW_MOTOR_DIR * (yaw->param->rotor_inertia + yaw->load_inertia) * (wz - sim_chassis_wz) / dt;
+    sim_chassis_yaw = sim_wrap(sim_chassis_yaw + 0.5f * (wz + sim_chassis_wz) * dt);
+    sim_chassis_wz = wz;
+    sim_time += dt;
+
+    //重力矩与机械限位 按姿态角方向计算后换算到电机方向
+    torque = SIM_PITCH_GRAVITY_TORQUE * cosf(pitch_angle);
+    if (pitch_angle > SIM_PITCH_STOP_ANGLE)
+    {
+        torque -= SIM_PITCH_STOP_STIFFNESS * (pitch_angle - SIM_PITCH_STOP_ANGLE) + SIM_PITCH_STOP_DAMPING * pitch_speed;
+    }
+    else if (pitch_angle < -SIM_PITCH_STOP_ANGLE)
+    {
+        torque -= SIM_PITCH_STOP_STIFFNESS * (pitch_angle + SIM_PITCH_STOP_ANGLE) + SIM_PITCH_STOP_DAMPING * pitch_speed;
+    }
+    pitch->load_torque = -GIMBAL_PITCH_MOTOR_DIR * torque;
+}
+
+//由偏航、俯仰(横滚为0)生成ins话题
+static void sim_ins_publish(uint32_t now_ms)
+{
+    ins_msg_t msg;
+    fp32 yaw = sim_wrap(sim_chassis_yaw + sim_relative_angle(sim_yaw_node, GIMBAL_YAW_OFFSET_ECD, GIMBAL_YAW_MOTOR_DIR));
+    fp32 pitch = sim_relative_angle(sim_pitch_node, GIMBAL_PITCH_OFFSET_ECD, GIMBAL_PITCH_MOTOR_DIR);
+    fp32 yaw_rate = sim_chassis_wz + GIMBAL_YAW_MOTOR_DIR * sim_yaw_node->motor.speed;
+    fp32 pitch_rate = GIMBAL_PITCH_MOTOR_DIR * sim_pitch_node->motor.speed;
+    fp32 cy = cosf(0.5f * yaw), sy = sinf(0.5f * yaw);
+    fp32 cp = cosf(0.5f * pitch), sp = sinf(0.5f * pitch);
+
+    msg.time_us = now_ms * 1000u;
+    msg.q[0] = cy * cp;
+    msg.q[1] = -sy * sp;
+    msg.q[2] = cy * sp;
+    msg.q[3] = sy * cp;
+    msg.euler[AHRS_YAW] = yaw;
+    msg.euler[AHRS_PITCH] = pitch;
+    msg.euler[AHRS_ROLL] = 0.0f;
+    //机体系角速度 = 俯仰角速度沿y轴 + 偏航角速度沿导航系z轴
+    msg.gyro[0] = -sinf(pitch) * yaw_rate;
+    msg.gyro[1] = pitch_rate;
+    msg.gyro[2] = cosf(pitch) * yaw_rate;
+    msg_bus_publish(MSG_BUS_TOPIC(ins), &msg);
+}
+
+static void sim_step_record(sim_step_t *step, gimbal_motor_t *motor, uint32_t now_ms)
+{
+    fp32 y;
+
+    if (now_ms == step->start_ms)
+    {
+        step->start = motor->absolute_angle;
+        //目标阶跃 与摇杆增量一样写入目标角度
+        motor->angle_set = sim_wrap(motor->angle_set + step->step);
+        step->peak = 0.0f;
+        return;
+    }
+    if (now_ms < step->start_ms || now_ms > step->start_ms + SIM_STEP_WINDOW_MS)
+    {
+        return;
+    }
+
+    y = sim_wrap(motor->absolute_angle - step->start) / step->step;
+    if (step->t10_ms == 0 && y >= 0.1f)
+    {
+        step->t10_ms = now_ms;
+    }
+    if (step->t90_ms == 0 && y >= 0.9f)
+    {
+        step->t90_ms = now_ms;
+    }
+    if (y > step->peak)
+    {
+        step->peak = y;
+    }
+    if (fabsf(y - 1.0f) * step->step > SIM_SETTLE_BAND_DEG * SIM_DEG)
+    {
+        step->settle_ms = now_ms;
+    }
+}
+
+static void sim_tick(uint32_t now_ms, void *user)
+{
+    gimbal_motor_t *yaw = &gimbal_control_data.gimbal_yaw_motor;
+    gimbal_motor_t *pitch = &gimbal_control_data.gimbal_pitch_motor;
+    gimbal_mode_e mode = gimbal_control_data.gimbal_behaviour_mode;
+
+    (void)user;
+
+    sim_can_tick_1ms();
+    sim_rc_tick_1ms(now_ms);
+    sim_scenario_tick_1ms(&sim_scenario_data, now_ms);
+    if (now_ms < SIM_INS_LOST_MS || now_ms >= SIM_INS_RECOVER_MS)
+    {
+        sim_ins_publish(now_ms);
+    }
+
+    sim_step_record(&sim_yaw_step, yaw, now_ms);
+    sim_step_record(&sim_pitch_step, pitch, now_ms);
+
+    //小陀螺 偏航指向误差
+    if (now_ms > SIM_SPIN_START_MS && now_ms < SIM_SPIN_STOP_MS + SIM_STEP_WINDOW_MS)
+    {
+        fp32 error = fabsf(sim_wrap(yaw->angle_set - yaw->absolute_angle)) / SIM_DEG;
+
+        if (error > sim_spin_error_max)
+        {
+            sim_spin_error_max = error;
+        }
+        if (now_ms > SIM_SPIN_START_MS + SIM_SPIN_RAMP_MS + 200u && now_ms < SIM_SPIN_STOP_MS)
+        {
+            sim_spin_error_sum2 += (fp64)error * error;
+            sim_spin_error_count++;
+        }
+    }
+
+    //俯仰软限位
+    if (now_ms >= SIM_LIMIT_START_MS && now_ms < SIM_LIMIT_END_MS)
+    {
+        if (pitch->relative_angle < sim_pitch_rel_min)
+        {
+            sim_pitch_rel_min = pitch->relative_angle;
+        }
+        if (pitch->relative_angle > sim_pitch_rel_max)
+        {
+            sim_pitch_rel_max = pitch->relative_angle;
+        }
+    }
+
+    //姿态数据中断与恢复 模式切换时刻与之后的角度变化
+    if (now_ms >= SIM_INS_LOST_MS && now_ms < SIM_DISABLE_MS)
+    {
+        if (sim_relative_ms == 0 && mode == GIMBAL_RELATIVE)
+        {
+            sim_relative_ms = now_ms;
+            sim_switch_yaw = yaw->relative_angle;
+            sim_switch_pitch = pitch->relative_angle;
+        }
+        if (sim_absolute_ms == 0 && now_ms >= SIM_INS_RECOVER_MS && mode == GIMBAL_ABSOLUTE)
+        {
+            sim_absolute_ms = now_ms;
+            sim_switch_yaw = yaw->relative_angle;
+            sim_switch_pitch = pitch->relative_angle;
+        }
+        if ((sim_relative_ms != 0 && now_ms < sim_relative_ms + 500u) || (sim_absolute_ms != 0 && now_ms < sim_absolute_ms + 500u))
+        {
+            fp32 jump = fmaxf(fabsf(yaw->relative_angle - sim_switch_yaw), fabsf(pitch->relative_angle - sim_switch_pitch)) / SIM_DEG;
+
+            if (jump > sim_switch_jump_max)
+            {
+                sim_switch_jump_max = jump;
+            }
+        }
+    }
+
+    //下档 电调收到的指令为0
+    if (now_ms >= SIM_DISABLE_MS && sim_zero_ms == 0 && sim_yaw_node->motor.command == 0 && sim_pitch_node->motor.command == 0)
+    {
+        sim_zero_ms = now_ms;
+    }
+
+    if (sim_csv != NULL)
+    {
+        fprintf(sim_csv, "%u,%d,%.5f,%.5f,%.5f,%d,%.5f,%.5f,%.5f,%d,%.4f\n", (unsigned)now_ms, (int)mode,
+                yaw->angle_set, yaw->angle_fdb, yaw->relative_angle, yaw->give_current,
+                pitch->angle_set, pitch->angle_fdb, pitch->relative_angle, pitch->give_current, sim_chassis_wz);
+    }
+}
+
+static void sim_check(bool_t ok, const char *what, fp64 value, fp64 limit)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "error: %s %.3f, limit %.3f\n", what, value, limit);
+        sim_error++;
+    }
+}
+
+static void sim_step_report(const sim_step_t *step)
+{
+    uint32_t rise = (step->t90_ms > step->t10_ms) ? step->t90_ms - step->t10_ms : SIM_STEP_WINDOW_MS;
+    uint32_t settle = step->settle_ms - step->start_ms + 1u;
+    fp32 overshoot = (step->peak > 1.0f) ? step->peak - 1.0f : 0.0f;
+    char what[48];
+
+    printf("%-6s step %4.1f deg: rise %3u ms  overshoot %5.1f %%  settle(+-%.1f deg) %3u ms\n",
+           step->name, step->step / SIM_DEG, (unsigned)rise, overshoot * 100.0f, SIM_SETTLE_BAND_DEG, (unsigned)settle);
+
+    snprintf(what, sizeof(what), "%s step rise ms", step->name);
+    sim_check(step->t90_ms != 0 && rise <= SIM_STEP_RISE_MAX_MS, what, rise, SIM_STEP_RISE_MAX_MS);
+    snprintf(what, sizeof(what), "%s step overshoot", step->name);
+    sim_check(overshoot <= SIM_STEP_OVERSHOOT_MAX, what, overshoot, SIM_STEP_OVERSHOOT_MAX);
+    snprintf(what, sizeof(what), "%s step settle ms", step->name);
+    sim_check(settle <= SIM_STEP_SETTLE_MAX_MS, what, settle, SIM_STEP_SETTLE_MAX_MS);
+}
+
+int main(int argc, char *argv[])
+{
+    fp32 spin_rms;
+    uint8_t i;
+
+    if (argc == 3 && strcmp(argv[1], "-o") == 0)
+    {
+        sim_csv = fopen(argv[2], "w");
+        if (sim_csv == NULL)
+        {
+            fprintf(stderr, "%s: cannot open\n", argv[2]);
+            return 1;
+        }
+        fprintf(sim_csv, "t_ms,mode,yaw_set,yaw_fdb,yaw_rel,yaw_out,pitch_set,pitch_fdb,pitch_rel,pitch_out,chassis_wz\n");
+    }
+    else if (argc != 1)
+    {
+        fprintf(stderr, "usage: %s [-o out.csv]\n", argv[0]);
+        return 2;
+    }
+
+    sim_os_init();
+    sim_can_init();
+    sim_rc_init();
+    if (!sim_flash_init())
+    {
+        return 1;
+    }
+    param_init();
+
+    //电机从中位开始 ecd与中位编码值相同
+    sim_yaw_node = sim_can_add_motor(SIM_CAN2, CAN_YAW_MOTOR_ID, MOTOR_SIM_GM6020, SIM_BUS_VOLTAGE);
+    sim_pitch_node = sim_can_add_motor(SIM_CAN2, CAN_PIT_MOTOR_ID, MOTOR_SIM_GM6020, SIM_BUS_VOLTAGE);
+    sim_yaw_node->motor.load_inertia = SIM_YAW_LOAD_INERTIA;
+    sim_yaw_node->motor.angle = GIMBAL_YAW_OFFSET_ECD * (2.0f * SIM_PI / GIMBAL_ECD_RANGE);
+    sim_pitch_node->motor.load_inertia = SIM_PITCH_LOAD_INERTIA;
+    sim_pitch_node->motor.angle = GIMBAL_PITCH_OFFSET_ECD * (2.0f * SIM_PI / GIMBAL_ECD_RANGE);
+    sim_can_set_step_hook(sim_step, NULL);
+
+    sim_scenario_init(&sim_scenario_data);
+    for (i = 0; i < sizeof(sim_scenario_text) / sizeof(sim_scenario_text[0]); i++)
+    {
+        sim_scenario_parse_line(&sim_scenario_data, sim_scenario_text[i]);
+    }
+    sim_pitch_rel_min = SIM_PI;
+    sim_pitch_rel_max = -SIM_PI;
+    sim_os_set_tick_hook(sim_tick, NULL);
+
+    sim_os_run(gimbal_task, SIM_DURATION_MS);
+
+    if (sim_csv != NULL)
+    {
+        fclose(sim_csv);
+    }
+
+    sim_step_report(&sim_yaw_step);
+    sim_step_report(&sim_pitch_step);
+
+    spin_rms = (sim_spin_error_count != 0) ? (fp32)sqrt(sim_spin_error_sum2 / sim_spin_error_count) : 0.0f;
+    printf("spin   %3.0f deg/s: yaw error rms %.3f max %.3f deg\n", SIM_SPIN_SPEED / SIM_DEG, spin_rms, sim_spin_error_max);
+    sim_check(spin_rms <= SIM_SPIN_ERROR_RMS_DEG, "spin yaw error rms deg", spin_rms, SIM_SPIN_ERROR_RMS_DEG);
+    sim_check(sim_spin_error_max <= SIM_SPIN_ERROR_MAX_DEG, "spin yaw error max deg", sim_spin_error_max, SIM_SPIN_ERROR_MAX_DEG);
+
+    printf("limit  pitch relative %.2f ~ %.2f deg (soft limit %d ~ %d)\n",
+           sim_pitch_rel_min / SIM_DEG, sim_pitch_rel_max / SIM_DEG, CONFIG_GIMBAL_PITCH_MIN_DEG, CONFIG_GIMBAL_PITCH_MAX_DEG);
+    sim_check(fabsf(sim_pitch_rel_max / SIM_DEG - CONFIG_GIMBAL_PITCH_MAX_DEG) <= SIM_LIMIT_MARGIN_DEG,
+              "pitch max relative deg", sim_pitch_rel_max / SIM_DEG, CONFIG_GIMBAL_PITCH_MAX_DEG);
+    sim_check(fabsf(sim_pitch_rel_min / SIM_DEG - CONFIG_GIMBAL_PITCH_MIN_DEG) <= SIM_LIMIT_MARGIN_DEG,
+              "pitch min relative deg", sim_pitch_rel_min / SIM_DEG, CONFIG_GIMBAL_PITCH_MIN_DEG);
+
+    printf("ins    lost -> relative %u ms, recover -> absolute %u ms, angle change after switch %.3f deg\n",
+           (unsigned)(sim_relative_ms - SIM_INS_LOST_MS), (unsigned)(sim_absolute_ms - SIM_INS_RECOVER_MS), sim_switch_jump_max);
+    sim_check(sim_relative_ms != 0 && sim_relative_ms - SIM_INS_LOST_MS <= GIMBAL_INS_TIMEOUT_MS + 2u * GIMBAL_CONTROL_TIME_MS,
+              "ins lost switch ms", sim_relative_ms - SIM_INS_LOST_MS, GIMBAL_INS_TIMEOUT_MS + 2u * GIMBAL_CONTROL_TIME_MS);
+    sim_check(sim_absolute_ms != 0 && sim_absolute_ms - SIM_INS_RECOVER_MS <= 2u * GIMBAL_CONTROL_TIME_MS,
+              "ins recover switch ms", sim_absolute_ms - SIM_INS_RECOVER_MS, 2u * GIMBAL_CONTROL_TIME_MS);
+    sim_check(sim_switch_jump_max <= SIM_SWITCH_JUMP_MAX_DEG, "mode switch angle change deg", sim_switch_jump_max, SIM_SWITCH_JUMP_MAX_DEG);
+
+    //开关变化在下一帧遥控器数据生效 再经一个控制周期发出
+    printf("zero   output %u ms after switch down\n", (unsigned)(sim_zero_ms - SIM_DISABLE_MS));
+    sim_check(sim_zero_ms != 0 && sim_zero_ms - SIM_DISABLE_MS <= RC_FRAME_PERIOD_MS + 2u * GIMBAL_CONTROL_TIME_MS,
+              "zero force ms", sim_zero_ms - SIM_DISABLE_MS, RC_FRAME_PERIOD_MS + 2u * GIMBAL_CONTROL_TIME_MS);
+
+    if (sim_error != 0)
+    {
+        fprintf(stderr, "gimbal_sim: %u errors\n", (unsigned)sim_error);
+        return 1;
+    }
+    printf("gimbal_sim: ok\n");
+    return 0;
+}
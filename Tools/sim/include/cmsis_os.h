@@ -0,0 +1,84 @@
+#ifndef CMSIS_OS_H
+#define CMSIS_OS_H
+
+/*
+  上位机仿真用 替代CMSIS-RTOS接口
+  单线程运行 任务函数在sim_os_run中直接调用, osDelay推进仿真时间(见sim_os.c)
+*/
+
+#include <stddef.h>
+#include "struct_typedef.h"
+
+typedef enum
+{
+    osOK = 0,
+} osStatus;
+
+/*只用于编译任务注册表接口 仿真中不创建任务*/
+typedef enum
+{
+    osPriorityIdle = -3,
+    osPriorityLow = -2,
+    osPriorityBelowNormal = -1,
+    osPriorityNormal = 0,
+    osPriorityAboveNormal = +1,
+    osPriorityHigh = +2,
+    osPriorityRealtime = +3,
+    osPriorityError = 0x84,
+} osPriority;
+
+typedef void *osThreadId;
+
+extern osStatus osDelay(uint32_t millisec);
+extern uint32_t osKernelSysTick(void);
+//在sim_os_run中返回1
+extern int32_t osKernelRunning(void);
+
+/*任务通知 遥控器任务用, 由运行remote_control.c的测试程序实现(rc_sim.c)*/
+typedef long BaseType_t;
+#define pdFALSE                 0
+#define pdTRUE                  1
+#define portMAX_DELAY           0xFFFFFFFFu
+#define portYIELD_FROM_ISR(x)   ((void)(x))
+
+extern osThreadId osThreadGetId(void);
+extern uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, uint32_t xTicksToWait);
+extern void vTaskNotifyGiveFromISR(osThreadId xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken);
+
+/*任务状态与堆统计 系统监视任务用, 由测试程序实现(monitor_sim.c) 结构同FreeRTOS*/
+typedef unsigned long UBaseType_t;
+
+typedef enum
+{
+    eRunning = 0,
+    eReady,
+    eBlocked,
+    eSuspended,
+    eDeleted,
+    eInvalid
+} eTaskState;
+
+typedef struct
+{
+    osThreadId xHandle;
+    const char *pcTaskName;
+    UBaseType_t xTaskNumber;
+    eTaskState eCurrentState;
+    UBaseType_t uxCurrentPriority;
+    UBaseType_t uxBasePriority;
+    uint32_t ulRunTimeCounter;
+    uint32_t *pxStackBase;
+    uint16_t usStackHighWaterMark;
+} TaskStatus_t;
+
+extern UBaseType_t uxTaskGetSystemState(TaskStatus_t *pxTaskStatusArray, UBaseType_t uxArraySize, uint32_t *pulTotalRunTime);
+extern size_t xPortGetFreeHeapSize(void);
+extern size_t xPortGetMinimumEverFreeHeapSize(void);
+
+/*单线程 临界区与挂起调度器为空*/
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+#define vTaskSuspendAll()
+#define xTaskResumeAll()        ((void)pdFALSE)
+
+#endif
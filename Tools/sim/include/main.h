@@ -0,0 +1,171 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+/*
+  上位机仿真用 替代Core/Inc/main.h
+  只提供固件源码用到的HAL类型、常量与函数声明, CAN由sim_can.c模拟, flash由sim_flash.c模拟,
+  串口与DMA数据流寄存器由sim_usart.c模拟
+*/
+
+#include <stddef.h>
+#include "struct_typedef.h"
+
+typedef enum
+{
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+/*CAN*/
+#define CAN_ID_STD    0x00000000U
+#define CAN_ID_EXT    0x00000004U
+#define CAN_RTR_DATA  0x00000000U
+#define CAN_RX_FIFO0  0x00000000U
+#define CAN_RX_FIFO1  0x00000001U
+#define CAN_TX_MAILBOX0 0x00000001U
+#define CAN_TX_MAILBOX1 0x00000002U
+#define CAN_TX_MAILBOX2 0x00000004U
+
+typedef struct
+{
+    uint32_t StdId;
+    uint32_t ExtId;
+    uint32_t IDE;
+    uint32_t RTR;
+    uint32_t DLC;
+    uint32_t TransmitGlobalTime;
+} CAN_TxHeaderTypeDef;
+
+typedef struct
+{
+    uint32_t StdId;
+    uint32_t ExtId;
+    uint32_t IDE;
+    uint32_t RTR;
+    uint32_t DLC;
+    uint32_t Timestamp;
+    uint32_t FilterMatchIndex;
+} CAN_RxHeaderTypeDef;
+
+typedef struct
+{
+    uint8_t bus; //仿真总线编号 0:CAN1 1:CAN2
+} CAN_HandleTypeDef;
+
+extern HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, CAN_TxHeaderTypeDef *pHeader, uint8_t aData[], uint32_t *pTxMailbox);
+extern HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *hcan, uint32_t RxFifo, CAN_RxHeaderTypeDef *pHeader, uint8_t aData[]);
+extern HAL_StatusTypeDef HAL_CAN_AbortTxRequest(CAN_HandleTypeDef *hcan, uint32_t TxMailboxes);
+extern void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan);
+
+/*寄存器位操作*/
+#define SET_BIT(REG, BIT)     ((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT)   ((REG) &= ~(BIT))
+
+/*USART 寄存器与位定义同STM32F4参考手册*/
+typedef struct
+{
+    volatile uint32_t SR;
+    volatile uint32_t DR;
+    volatile uint32_t BRR;
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t CR3;
+    volatile uint32_t GTPR;
+} USART_TypeDef;
+
+#define USART_SR_PE       0x0001U
+#define USART_SR_FE       0x0002U
+#define USART_SR_NE       0x0004U
+#define USART_SR_ORE      0x0008U
+#define USART_SR_IDLE     0x0010U
+#define USART_SR_RXNE     0x0020U
+#define USART_CR1_IDLEIE  0x0010U
+#define USART_CR3_DMAR    0x0040U
+#define USART_CR3_DMAT    0x0080U
+#define UART_IT_IDLE      USART_CR1_IDLEIE
+
+typedef struct
+{
+    USART_TypeDef *Instance;
+} UART_HandleTypeDef;
+
+/*DMA数据流 地址寄存器为32位, 缓冲区需用sim_usart_alloc分配在低4GB*/
+typedef struct
+{
+    volatile uint32_t CR;
+    volatile uint32_t NDTR;
+    volatile uint32_t PAR;
+    volatile uint32_t M0AR;
+    volatile uint32_t M1AR;
+    volatile uint32_t FCR;
+} DMA_Stream_TypeDef;
+
+#define DMA_SxCR_EN       0x00000001U
+#define DMA_SxCR_HTIE     0x00000008U
+#define DMA_SxCR_TCIE     0x00000010U
+#define DMA_SxCR_CIRC     0x00000100U
+#define DMA_SxCR_DBM      0x00040000U
+#define DMA_SxCR_CT       0x00080000U
+
+/*中断标志 目标板在DMA控制器的LISR/HISR中, 仿真放在句柄中, 位定义同数据流0*/
+#define SIM_DMA_FLAG_FE   0x01U
+#define SIM_DMA_FLAG_DME  0x04U
+#define SIM_DMA_FLAG_TE   0x08U
+#define SIM_DMA_FLAG_HT   0x10U
+#define SIM_DMA_FLAG_TC   0x20U
+
+typedef struct
+{
+    DMA_Stream_TypeDef *Instance;
+    volatile uint32_t flag;     //仿真的中断标志
+    uint32_t reload;            //使能时的NDTR 循环与双缓冲模式传输完成后重新装载
+} DMA_HandleTypeDef;
+
+#define __HAL_DMA_GET_TC_FLAG_INDEX(h)  SIM_DMA_FLAG_TC
+#define __HAL_DMA_GET_HT_FLAG_INDEX(h)  SIM_DMA_FLAG_HT
+#define __HAL_DMA_GET_TE_FLAG_INDEX(h)  SIM_DMA_FLAG_TE
+#define __HAL_DMA_GET_FE_FLAG_INDEX(h)  SIM_DMA_FLAG_FE
+#define __HAL_DMA_GET_DME_FLAG_INDEX(h) SIM_DMA_FLAG_DME
+#define __HAL_DMA_GET_FLAG(h, f)        (((h)->flag & (f)) != 0)
+#define __HAL_DMA_CLEAR_FLAG(h, f)      ((h)->flag &= ~(uint32_t)(f))
+#define __HAL_DMA_ENABLE(h)             sim_dma_enable(h)
+#define __HAL_DMA_DISABLE(h)            sim_dma_disable(h)
+#define __HAL_UART_ENABLE_IT(h, it)     SET_BIT((h)->Instance->CR1, (it))
+#define __HAL_UART_CLEAR_PEFLAG(h)      sim_uart_clear_flag(h)
+
+//使能数据流 记录NDTR作为重新装载值
+extern void sim_dma_enable(DMA_HandleTypeDef *hdma);
+//关闭数据流 与目标板相同, 传输中关闭会置位传输完成标志
+extern void sim_dma_disable(DMA_HandleTypeDef *hdma);
+//读SR再读DR 清除PE FE NE ORE IDLE
+extern void sim_uart_clear_flag(UART_HandleTypeDef *huart);
+
+/*系统时钟与内存屏障 由sim_cpu.c实现, __DMB处可插入钩子模拟抢占*/
+extern uint32_t HAL_GetTick(void);
+extern void sim_cpu_dmb(void);
+#define __DMB() sim_cpu_dmb()
+
+/*中断屏蔽与内核寄存器 由sim_cpu.c实现
+  关中断用全局锁模拟: 同一时刻只有一个线程处于关中断状态, 不关中断的线程不受影响*/
+extern uint32_t __get_PRIMASK(void);
+extern void __set_PRIMASK(uint32_t primask);
+extern void __disable_irq(void);
+extern void __enable_irq(void);
+extern uint32_t __get_PSP(void);
+
+typedef struct
+{
+    volatile uint32_t CFSR;
+    volatile uint32_t HFSR;
+} SCB_Type;
+
+extern SCB_Type sim_scb;
+#define SCB (&sim_scb)
+
+/*FLASH 扇区编号*/
+#define FLASH_SECTOR_10 10U
+#define FLASH_SECTOR_11 11U
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef STRUCT_TYPEDEF_H
+#define STRUCT_TYPEDEF_H
+
+/*
+  上位机仿真用 替代Components/struct_typedef.h
+  整数类型使用<stdint.h>, 避免与系统头文件中int64_t等定义冲突
+  ARMCC关键字在这里替换为gcc写法
+*/
+
+#include <stdint.h>
+
+#define __packed __attribute__((packed))
+#define __inline inline
+
+typedef unsigned char bool_t;
+typedef float fp32;
+typedef double fp64;
+
+#endif
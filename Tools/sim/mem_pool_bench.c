@@ -0,0 +1,306 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       mem_pool_bench.c
+  * @brief      内存池上位机压力测试与延迟基准，多个pthread线程同时分配/释放同一个池，
+  *             检查同一块不会被重复分配、统计计数一致、非法释放被拒绝，
+  *             并与FreeRTOS heap_4(pvPortMalloc/vPortFree)比较分配+释放的周期数。
+  * @note       heap_4.c直接编译固件中的源码, 移植层见freertos/,
+  *             vTaskSuspendAll/xTaskResumeAll用互斥锁代替。
+  *             周期数只用于比较, 目标板执行时间以profile统计为准。
+  *             检查失败时返回1, make bench时运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: mem_pool_bench [每个线程的分配次数]
+    压力测试: 4个线程共用一个16块的池, 每个线程最多同时持有6块(池会被取空),
+              块内写入线程号与序号, 释放前检查没有被其他线程改写
+    延迟: 单线程下分配+释放一次的周期数中位数/p99/最大值,
+          heap_4分别在空堆与碎片化(空闲链表上有几百个不连续的空闲块)时测量
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#define _DEFAULT_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bsp_dwt.h"
+#include "mem_pool.h"
+
+#define BENCH_THREAD_NUM    4u
+#define BENCH_HOLD_NUM      6u
+#define BENCH_BLOCK_SIZE    60u
+#define BENCH_BLOCK_NUM     16u
+#define BENCH_DEFAULT_COUNT 200000u
+#define BENCH_CYCLE_COUNT   100000u
+#define BENCH_FRAGMENT_NUM  600u
+
+MEM_POOL_DEFINE(stress, BENCH_BLOCK_SIZE, BENCH_BLOCK_NUM);
+MEM_POOL_DEFINE(latency, BENCH_BLOCK_SIZE, 8);
+
+static uint32_t bench_count = BENCH_DEFAULT_COUNT;
+static uint32_t bench_error;
+static pthread_mutex_t bench_error_lock = PTHREAD_MUTEX_INITIALIZER;
+
+//heap_4挂起调度器的替代 保证多线程下堆操作互斥
+static pthread_mutex_t bench_scheduler_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void vTaskSuspendAll(void)
+{
+    pthread_mutex_lock(&bench_scheduler_lock);
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+    pthread_mutex_unlock(&bench_scheduler_lock);
+    return pdFALSE;
+}
+
+static void bench_fail(const char *what, uint32_t a, uint32_t b)
+{
+    pthread_mutex_lock(&bench_error_lock);
+    if (bench_error < 10)
+    {
+        fprintf(stderr, "error: %s (%u, %u)\n", what, a, b);
+    }
+    bench_error++;
+    pthread_mutex_unlock(&bench_error_lock);
+}
+
+/*块内容 整块写满线程号与序号 被其他线程同时持有时会被改写*/
+#define BENCH_BLOCK_WORDS (BENCH_BLOCK_SIZE / 4u)
+
+static void bench_block_fill(uint32_t *block, uint32_t owner, uint32_t seq)
+{
+    uint32_t i;
+    for (i = 0; i < BENCH_BLOCK_WORDS; i++)
+    {
+        block[i] = owner << 24 ^ seq ^ i;
+    }
+}
+
+static bool_t bench_block_valid(const uint32_t *block, uint32_t owner, uint32_t seq)
+{
+    uint32_t i;
+    for (i = 0; i < BENCH_BLOCK_WORDS; i++)
+    {
+        if (block[i] != (owner << 24 ^ seq ^ i))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+typedef struct
+{
+    uint32_t id;
+    uint32_t alloc_count;
+    uint32_t fail_count;
+} bench_thread_t;
+
+static void *bench_stress_thread(void *arg)
+{
+    bench_thread_t *thread = arg;
+    uint32_t *hold[BENCH_HOLD_NUM] = {NULL};
+    uint32_t hold_seq[BENCH_HOLD_NUM];
+    uint32_t seq;
+    uint32_t i;
+
+    for (seq = 1; seq <= bench_count; seq++)
+    {
+        i = seq % BENCH_HOLD_NUM;
+        if (hold[i] != NULL)
+        {
+            if (!bench_block_valid(hold[i], thread->id, hold_seq[i]))
+            {
+                bench_fail("block shared by two owners", thread->id, hold_seq[i]);
+            }
+            mem_pool_free(MEM_POOL(stress), hold[i]);
+            hold[i] = NULL;
+        }
+        //每隔几次多持有一段时间 让池被取空
+        if (seq % 7 == 0)
+        {
+            sched_yield();
+        }
+        hold[i] = mem_pool_alloc(MEM_POOL(stress));
+        if (hold[i] == NULL)
+        {
+            thread->fail_count++;
+            continue;
+        }
+        if ((uintptr_t)hold[i] % 8u != 0)
+        {
+            bench_fail("block alignment", thread->id, (uint32_t)(uintptr_t)hold[i]);
+        }
+        thread->alloc_count++;
+        hold_seq[i] = seq;
+        bench_block_fill(hold[i], thread->id, seq);
+    }
+    for (i = 0; i < BENCH_HOLD_NUM; i++)
+    {
+        mem_pool_free(MEM_POOL(stress), hold[i]);
+    }
+    return NULL;
+}
+
+static void bench_stress(void)
+{
+    static bench_thread_t thread[BENCH_THREAD_NUM];
+    pthread_t handle[BENCH_THREAD_NUM];
+    mem_pool_t *pool = MEM_POOL(stress);
+    uint32_t alloc_count = 0;
+    uint32_t fail_count = 0;
+    uint8_t bad[8];
+    uint32_t i;
+
+    for (i = 0; i < BENCH_THREAD_NUM; i++)
+    {
+        thread[i].id = i;
+        pthread_create(&handle[i], NULL, bench_stress_thread, &thread[i]);
+    }
+    for (i = 0; i < BENCH_THREAD_NUM; i++)
+    {
+        pthread_join(handle[i], NULL);
+        alloc_count += thread[i].alloc_count;
+        fail_count += thread[i].fail_count;
+    }
+
+    if (pool->free_num != pool->block_num || mem_pool_used(pool) != 0)
+    {
+        bench_fail("blocks not returned", pool->free_num, pool->block_num);
+    }
+    if (pool->alloc_count != alloc_count || pool->fail_count != fail_count)
+    {
+        bench_fail("alloc statistics", pool->alloc_count, alloc_count);
+    }
+    if (pool->error_count != 0)
+    {
+        bench_fail("free error", pool->error_count, 0);
+    }
+
+    //不属于本池的地址、块中间的地址都不能进入空闲链表
+    mem_pool_free(pool, bad);
+    mem_pool_free(pool, pool->buf + 4);
+    mem_pool_free(pool, pool->buf + (uint32_t)pool->block_num * pool->block_size);
+    if (pool->error_count != 3 || pool->free_num != pool->block_num)
+    {
+        bench_fail("invalid free accepted", pool->error_count, pool->free_num);
+    }
+
+    printf("stress: %u threads x %u allocations, %u blocks of %u bytes\n", BENCH_THREAD_NUM, bench_count,
+           pool->block_num, pool->block_size);
+    printf("  %u allocated, %u failed on empty pool, min free %u\n", alloc_count, fail_count, pool->min_free);
+}
+
+static int bench_compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void bench_print_dist(const char *name, uint32_t *value, uint32_t count)
+{
+    qsort(value, count, sizeof(value[0]), bench_compare_u32);
+    printf("  %-24s median %6u  p99 %6u  max %8u cycles\n", name, value[count / 2], value[count * 99 / 100],
+           value[count - 1]);
+}
+
+//分配+释放一次的周期数
+static void bench_heap_cycles(const char *name, uint32_t *cycles)
+{
+    uint32_t start;
+    uint32_t i;
+    void *p;
+
+    for (i = 0; i < BENCH_CYCLE_COUNT; i++)
+    {
+        start = dwt_cycle_get();
+        p = pvPortMalloc(BENCH_BLOCK_SIZE);
+        vPortFree(p);
+        cycles[i] = dwt_cycle_get() - start;
+        if (p == NULL)
+        {
+            bench_fail("heap_4 out of memory", i, (uint32_t)xPortGetFreeHeapSize());
+            return;
+        }
+    }
+    bench_print_dist(name, cycles, BENCH_CYCLE_COUNT);
+}
+
+static void bench_cycles(void)
+{
+    static uint32_t cycles[BENCH_CYCLE_COUNT];
+    static void *fragment[BENCH_FRAGMENT_NUM];
+    size_t heap_free;
+    uint32_t start;
+    uint32_t i;
+    void *p;
+
+    printf("cycles (single thread, %u bytes, alloc + free):\n", BENCH_BLOCK_SIZE);
+    for (i = 0; i < BENCH_CYCLE_COUNT; i++)
+    {
+        start = dwt_cycle_get();
+        p = mem_pool_alloc(MEM_POOL(latency));
+        mem_pool_free(MEM_POOL(latency), p);
+        cycles[i] = dwt_cycle_get() - start;
+    }
+    bench_print_dist("mem_pool", cycles, BENCH_CYCLE_COUNT);
+
+    bench_heap_cycles("heap_4 (empty)", cycles);
+    heap_free = xPortGetFreeHeapSize();
+
+    //大小不一的块间隔释放 空闲链表上留下几百个放不下请求的小空洞
+    for (i = 0; i < BENCH_FRAGMENT_NUM; i++)
+    {
+        fragment[i] = pvPortMalloc(i % 2 ? 16u + i % 24u : 48u);
+    }
+    for (i = 0; i < BENCH_FRAGMENT_NUM; i += 2)
+    {
+        vPortFree(fragment[i]);
+    }
+    bench_heap_cycles("heap_4 (fragmented)", cycles);
+    for (i = 1; i < BENCH_FRAGMENT_NUM; i += 2)
+    {
+        vPortFree(fragment[i]);
+    }
+    //全部释放后相邻空闲块合并 空闲长度恢复
+    if (xPortGetFreeHeapSize() != heap_free)
+    {
+        bench_fail("heap_4 leak", (uint32_t)xPortGetFreeHeapSize(), 0);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+    {
+        bench_count = (uint32_t)strtoul(argv[1], NULL, 0);
+        if (bench_count == 0)
+        {
+            fprintf(stderr, "usage: mem_pool_bench [count]\n");
+            return 2;
+        }
+    }
+
+    bench_stress();
+    bench_cycles();
+
+    if (bench_error != 0)
+    {
+        fprintf(stderr, "mem_pool_bench: %u errors\n", bench_error);
+        return 1;
+    }
+    printf("mem_pool_bench: ok\n");
+    return 0;
+}
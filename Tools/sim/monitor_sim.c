@@ -0,0 +1,348 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       monitor_sim.c
+  * @brief      系统监视任务上位机测试，用假的uxTaskGetSystemState与DWT计数运行monitor_task.c，
+  *             检查每个任务CPU占用的差值计算(计数回绕、任务顺序变化、任务创建与删除)、
+  *             中断占用、任务名截断与记录中未用的任务槽清零。
+  * @note       假任务为任务表中的全部任务加空闲任务与CubeMX默认任务，任务名取自任务表。
+  *             检查失败时返回1, make bench时运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: monitor_sim
+    每个监视周期一步, 周期开始时改变假任务的运行时间, 下一毫秒用monitor_read检查记录:
+    wrap      总运行时间与每个任务的运行时间跨过2^32
+    reorder   uxTaskGetSystemState返回的顺序反转 按任务编号对应上一次采样
+    create    删除一个任务、创建一个任务, 新任务本周期占用为0
+    created   新任务按差值计算
+    full      任务数等于MONITOR_MAX_TASK_NUM 全部记录
+    stopped   运行时间计数停止(差值为0) 占用为0 不除以0
+    期望占用 = 运行时间差值 * 1000 / 总运行时间差值, 中断占用 = 中断周期数差值 * 1000 / DWT周期数差值
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <stdio.h>
+#include <string.h>
+#include "cmsis_os.h"
+#include "bsp_dwt.h"
+#include "profile.h"
+#include "monitor_task.h"
+#include "task_registry.h"
+#include "sim_os.h"
+
+#define SIM_TASK_MAX        (MONITOR_MAX_TASK_NUM + 2u)
+#define SIM_TOTAL_DELTA     1312500u    //一个监视周期的总运行时间 168MHz/64 * 500ms
+#define SIM_CYCLE_DELTA     84000000u   //一个监视周期的DWT周期数 168MHz * 500ms
+#define SIM_CAN_ISR_PERMILLE 25u
+#define SIM_RC_ISR_PERMILLE  5u
+#define SIM_HEAP_FREE       9000u
+#define SIM_HEAP_MIN_FREE   7000u
+
+/*测试步骤 每个监视周期一步*/
+typedef enum
+{
+    SIM_STEP_BASELINE = 0,
+    SIM_STEP_WRAP,
+    SIM_STEP_REORDER,
+    SIM_STEP_CREATE,
+    SIM_STEP_CREATED,
+    SIM_STEP_FULL,
+    SIM_STEP_STOPPED,
+    SIM_STEP_NUM,
+} sim_step_e;
+
+static const char *const sim_step_name[SIM_STEP_NUM] = {"baseline", "wrap", "reorder", "create", "created", "full", "stopped"};
+
+/*假任务*/
+typedef struct
+{
+    char name[16];
+    UBaseType_t number;
+    UBaseType_t priority;
+    eTaskState state;
+    uint16_t stack_free;
+    uint32_t run_time;
+    bool_t alive;
+    bool_t sampled;             //上一次采样时存在
+    uint16_t expect_permille;
+} sim_task_t;
+
+//任务表中的任务名
+#define SIM_TASK_NAME(id, name, entry, stack_words, period_ms, deadline_ms, wcet_us, isr, wdg) #name,
+static const char *const sim_table_name[TASK_NUM] = {TASK_TABLE(SIM_TASK_NAME)};
+#undef SIM_TASK_NAME
+
+PROFILE_SCOPE_DEFINE(can_rx_isr);
+PROFILE_SCOPE_DEFINE(rc_usart_isr);
+
+static sim_task_t sim_task[SIM_TASK_MAX];
+static uint32_t sim_task_num;
+static uint32_t sim_order[SIM_TASK_MAX];    //最近一次uxTaskGetSystemState返回的顺序
+static uint32_t sim_order_num;
+static bool_t sim_reverse;
+static uint32_t sim_total_run_time;
+static uint64_t sim_cycle;
+static uint32_t sim_error;
+static const char *sim_current;
+
+static void sim_check(bool_t ok, const char *what, uint32_t value, uint32_t expect)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "error: %s: %s %u, expect %u\n", sim_current, what, (unsigned)value, (unsigned)expect);
+        sim_error++;
+    }
+}
+
+/*--------仿真的FreeRTOS与固件依赖--------*/
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *pxTaskStatusArray, UBaseType_t uxArraySize, uint32_t *pulTotalRunTime)
+{
+    uint32_t alive = 0;
+    uint32_t i;
+    uint32_t k;
+
+    for (i = 0; i < sim_task_num; i++)
+    {
+        if (sim_task[i].alive)
+        {
+            sim_order[alive++] = i;
+        }
+    }
+    //与FreeRTOS相同 数组不够时不填写 返回0
+    if (alive > uxArraySize)
+    {
+        sim_order_num = 0;
+        return 0;
+    }
+    if (sim_reverse)
+    {
+        for (i = 0; i < alive / 2u; i++)
+        {
+            k = sim_order[i];
+            sim_order[i] = sim_order[alive - 1u - i];
+            sim_order[alive - 1u - i] = k;
+        }
+    }
+    for (i = 0; i < alive; i++)
+    {
+        const sim_task_t *task = &sim_task[sim_order[i]];
+        TaskStatus_t *status = &pxTaskStatusArray[i];
+
+        memset(status, 0, sizeof(TaskStatus_t));
+        status->pcTaskName = task->name;
+        status->xTaskNumber = task->number;
+        status->eCurrentState = task->state;
+        status->uxCurrentPriority = task->priority;
+        status->uxBasePriority = task->priority;
+        status->ulRunTimeCounter = task->run_time;
+        status->usStackHighWaterMark = task->stack_free;
+    }
+    sim_order_num = alive;
+    *pulTotalRunTime = sim_total_run_time;
+    return alive;
+}
+
+size_t xPortGetFreeHeapSize(void)
+{
+    return SIM_HEAP_FREE;
+}
+
+size_t xPortGetMinimumEverFreeHeapSize(void)
+{
+    return SIM_HEAP_MIN_FREE;
+}
+
+uint64_t dwt_cycle64_get(void)
+{
+    return sim_cycle;
+}
+
+void task_job_begin(task_id_e id)
+{
+    (void)id;
+}
+
+void task_job_end(task_id_e id)
+{
+    (void)id;
+}
+
+/*--------假任务--------*/
+
+static void sim_task_add(const char *name, UBaseType_t number)
+{
+    sim_task_t *task = &sim_task[sim_task_num++];
+
+    memset(task, 0, sizeof(sim_task_t));
+    strncpy(task->name, name, sizeof(task->name) - 1u);
+    task->number = number;
+    task->priority = number % 7u;
+    task->state = (eTaskState)(number % 4u);
+    task->stack_free = (uint16_t)(20u + number * 3u);
+    //运行时间从接近回绕处开始 第一步跨过2^32
+    task->run_time = 0xFFFFFFFFu - number * 1000u;
+    task->alive = 1;
+}
+
+static uint32_t sim_task_alive_num(void)
+{
+    uint32_t alive = 0;
+    uint32_t i;
+
+    for (i = 0; i < sim_task_num; i++)
+    {
+        alive += sim_task[i].alive;
+    }
+    return alive;
+}
+
+static void sim_task_init(void)
+{
+    uint32_t i;
+
+    sim_task_num = 0;
+    sim_task_add("IDLE", 0);
+    sim_task_add("defaultTask", 1);
+    for (i = 0; i < TASK_NUM; i++)
+    {
+        sim_task_add(sim_table_name[i], 2u + i);
+    }
+    sim_total_run_time = 0xFFFFFFFFu - SIM_TOTAL_DELTA / 2u;
+    sim_cycle = 0x00000000FFFFFFF0ull;
+    sim_reverse = 0;
+}
+
+//监视周期开始 改变任务与运行时间
+static void sim_step(uint32_t step)
+{
+    uint32_t total_delta = (step == SIM_STEP_STOPPED) ? 0 : SIM_TOTAL_DELTA;
+    char name[16];
+    uint32_t delta;
+    uint32_t i;
+
+    for (i = 0; i < sim_task_num; i++)
+    {
+        sim_task[i].sampled = sim_task[i].alive;
+    }
+    if (step == SIM_STEP_CREATE)
+    {
+        sim_task[3].alive = 0;
+        sim_task_add("Spare0", 100);
+    }
+    if (step == SIM_STEP_FULL)
+    {
+        while (sim_task_alive_num() < MONITOR_MAX_TASK_NUM)
+        {
+            snprintf(name, sizeof(name), "Spare%u", (unsigned)sim_task_num);
+            sim_task_add(name, 100u + sim_task_num);
+        }
+    }
+    sim_reverse = (step == SIM_STEP_REORDER);
+
+    for (i = 0; i < sim_task_num; i++)
+    {
+        sim_task_t *task = &sim_task[i];
+
+        if (!task->alive)
+        {
+            continue;
+        }
+        delta = total_delta / 100u * ((i + step) % 7u);
+        task->run_time += delta;
+        task->expect_permille = (task->sampled && total_delta != 0) ? (uint16_t)((uint64_t)delta * 1000u / total_delta) : 0;
+    }
+    sim_total_run_time += total_delta;
+    sim_cycle += SIM_CYCLE_DELTA;
+    profile_scope_can_rx_isr.total += (uint64_t)SIM_CYCLE_DELTA * SIM_CAN_ISR_PERMILLE / 1000u;
+    profile_scope_rc_usart_isr.total += (uint64_t)SIM_CYCLE_DELTA * SIM_RC_ISR_PERMILLE / 1000u;
+}
+
+//检查本步的记录
+static void sim_verify(uint32_t step)
+{
+    static monitor_record_t record;
+    static const monitor_task_record_t zero;
+    uint32_t alive = sim_task_alive_num();
+    uint32_t i;
+
+    sim_current = sim_step_name[step];
+    monitor_read(&record);
+
+    sim_check(record.version == MONITOR_RECORD_VERSION, "version", record.version, MONITOR_RECORD_VERSION);
+    sim_check(record.seq == step + 1u, "seq", record.seq, step + 1u);
+    sim_check(record.uptime_ms == step * MONITOR_PERIOD_MS, "uptime_ms", record.uptime_ms, step * MONITOR_PERIOD_MS);
+    sim_check(record.period_ms == MONITOR_PERIOD_MS, "period_ms", record.period_ms, MONITOR_PERIOD_MS);
+    sim_check(record.heap_free == SIM_HEAP_FREE && record.heap_min_free == SIM_HEAP_MIN_FREE, "heap_free", record.heap_free,
+              SIM_HEAP_FREE);
+    sim_check(record.isr_permille == SIM_CAN_ISR_PERMILLE + SIM_RC_ISR_PERMILLE, "isr_permille", record.isr_permille,
+              SIM_CAN_ISR_PERMILLE + SIM_RC_ISR_PERMILLE);
+    sim_check(record.task_num == alive && sim_order_num == alive, "task_num", record.task_num, alive);
+
+    for (i = 0; i < record.task_num && i < sim_order_num; i++)
+    {
+        const sim_task_t *task = &sim_task[sim_order[i]];
+        const monitor_task_record_t *rec = &record.task[i];
+        char name[MONITOR_TASK_NAME_LEN];
+
+        //与strncpy相同 超长截断不带结束符 不足补0
+        memset(name, 0, sizeof(name));
+        memcpy(name, task->name, strlen(task->name) < sizeof(name) ? strlen(task->name) : sizeof(name));
+        sim_check(memcmp(rec->name, name, sizeof(name)) == 0, "task name", (uint32_t)task->number, (uint32_t)task->number);
+        sim_check(rec->priority == task->priority, "priority", rec->priority, (uint32_t)task->priority);
+        sim_check(rec->state == (uint8_t)task->state, "state", rec->state, (uint32_t)task->state);
+        sim_check(rec->stack_free == task->stack_free, "stack_free", rec->stack_free, task->stack_free);
+        if (rec->cpu_permille != task->expect_permille)
+        {
+            fprintf(stderr, "error: %s: task %s cpu_permille %u, expect %u\n", sim_current, task->name, (unsigned)rec->cpu_permille,
+                    (unsigned)task->expect_permille);
+            sim_error++;
+        }
+    }
+    for (; i < MONITOR_MAX_TASK_NUM; i++)
+    {
+        sim_check(memcmp(&record.task[i], &zero, sizeof(zero)) == 0, "unused slot not zero", i, 0);
+    }
+
+    printf("%-9s %2u tasks, isr %u permille\n", sim_current, (unsigned)record.task_num, (unsigned)record.isr_permille);
+}
+
+//周期开始时改变假任务, 下一毫秒检查记录
+static void sim_tick(uint32_t now_ms, void *user)
+{
+    (void)user;
+    if (now_ms % MONITOR_PERIOD_MS == 0 && now_ms / MONITOR_PERIOD_MS < SIM_STEP_NUM)
+    {
+        sim_step(now_ms / MONITOR_PERIOD_MS);
+    }
+    //基准采样不发布
+    else if (now_ms % MONITOR_PERIOD_MS == 1u && now_ms / MONITOR_PERIOD_MS != SIM_STEP_BASELINE &&
+             now_ms / MONITOR_PERIOD_MS < SIM_STEP_NUM)
+    {
+        sim_verify(now_ms / MONITOR_PERIOD_MS);
+    }
+}
+
+int main(void)
+{
+    printf("%u task slots: %u in task table + %u system + %u spare\n", (unsigned)MONITOR_MAX_TASK_NUM, (unsigned)TASK_NUM,
+           (unsigned)MONITOR_SYSTEM_TASK_NUM, (unsigned)MONITOR_SPARE_TASK_NUM);
+    sim_os_init();
+    sim_task_init();
+    sim_os_set_tick_hook(sim_tick, NULL);
+    //第一次采样在0ms 只建立基准
+    sim_os_run(monitor_task, (SIM_STEP_NUM - 1u) * MONITOR_PERIOD_MS + 2u);
+
+    if (sim_error != 0)
+    {
+        fprintf(stderr, "monitor_sim: %u errors\n", (unsigned)sim_error);
+        return 1;
+    }
+    printf("monitor_sim: ok\n");
+    return 0;
+}
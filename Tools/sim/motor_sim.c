@@ -0,0 +1,322 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       motor_sim.c/h
+  * @brief      DJI电机与电调的上位机模型(M3508+C620, GM6020, M2006+C610)，
+  *             包括电调电流环、反电动势、母线电压限制、库仑/粘滞摩擦、转动惯量、
+  *             温升与编码器量化，反馈帧格式与CAN_receive.c中get_motor_measure一致。
+  * @note       只在上位机仿真中使用，不参与固件编译。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <stddef.h>
+#include <math.h>
+#include "motor_sim.h"
+
+#define MOTOR_SIM_TWO_PI     6.28318530717959f
+#define MOTOR_SIM_RAD_TO_RPM 9.54929658551372f
+//低于该转速视为静止 用于库仑摩擦的静摩擦判定
+#define MOTOR_SIM_STICK_SPEED 1.0e-3f
+//一阶滤波衰减到该值以下直接置零 避免非规格化浮点数使运算变慢
+#define MOTOR_SIM_TINY        1.0e-9f
+
+/*
+  默认参数 按手册额定值拟合:
+    M3508: 输出轴转矩常数0.3N·m/A 空载482rpm(24V) 减速比3591/187
+    GM6020: 转矩常数0.741N·m/A 空载320rpm(24V) 反馈电流±16384对应±3A
+    M2006: 输出轴转矩常数0.18N·m/A 空载500rpm(24V) 减速比36
+*/
+static const motor_sim_param_t motor_sim_param[MOTOR_SIM_TYPE_NUM] =
+{
+    [MOTOR_SIM_M3508] =
+    {
+        .voltage_cmd = 0,
+        .cmd_scale = 20.0f / 16384.0f,
+        .cmd_max = 16384,
+        .fdb_current_scale = 16384.0f / 20.0f,
+        .kt = 0.3f * 187.0f / 3591.0f,
+        .ke = 24.0f / (482.0f * 3591.0f / 187.0f / MOTOR_SIM_RAD_TO_RPM),
+        .resistance = 0.194f,
+        .current_tau = 0.5e-3f,
+        .rotor_inertia = 1.5e-5f,
+        .gear_ratio = 3591.0f / 187.0f,
+        .coulomb_friction = 2.0e-3f,
+        .viscous_friction = 2.0e-6f,
+        .speed_filter_tau = 2.0e-3f,
+        .thermal_resistance = 2.0f,
+        .thermal_capacity = 60.0f,
+    },
+    [MOTOR_SIM_GM6020] =
+    {
+        .voltage_cmd = 1,
+        .cmd_scale = 1.0f / 30000.0f,
+        .cmd_max = 30000,
+        .fdb_current_scale = 16384.0f / 3.0f,
+        .kt = 0.741f,
+        .ke = 24.0f / (320.0f / MOTOR_SIM_RAD_TO_RPM),
+        .resistance = 1.8f,
+        .current_tau = 1.0e-3f,
+        .rotor_inertia = 3.0e-4f,
+        .gear_ratio = 1.0f,
+        .coulomb_friction = 3.0e-2f,
+        .viscous_friction = 1.0e-3f,
+        .speed_filter_tau = 2.0e-3f,
+        .thermal_resistance = 1.5f,
+        .thermal_capacity = 150.0f,
+    },
+    [MOTOR_SIM_M2006] =
+    {
+        .voltage_cmd = 0,
+        .cmd_scale = 10.0f / 10000.0f,
+        .cmd_max = 10000,
+        .fdb_current_scale = 10000.0f / 10.0f,
+        .kt = 0.18f / 36.0f,
+        .ke = 24.0f / (500.0f * 36.0f / MOTOR_SIM_RAD_TO_RPM),
+        .resistance = 0.4f,
+        .current_tau = 0.3e-3f,
+        .rotor_inertia = 2.0e-6f,
+        .gear_ratio = 36.0f,
+        .coulomb_friction = 4.0e-4f,
+        .viscous_friction = 5.0e-7f,
+        .speed_filter_tau = 2.0e-3f,
+        .thermal_resistance = 4.0f,
+        .thermal_capacity = 20.0f,
+    },
+};
+
+static fp32 motor_sim_clamp(fp32 value, fp32 min, fp32 max)
+{
+    if (value > max)
+    {
+        return max;
+    }
+    else if (value < min)
+    {
+        return min;
+    }
+    return value;
+}
+
+static int16_t motor_sim_to_int16(fp32 value)
+{
+    value = motor_sim_clamp(value, -32768.0f, 32767.0f);
+    return (int16_t)lrintf(value);
+}
+
+//步长相关系数 步长固定时每个电机只计算一次
+static void motor_sim_update_coef(motor_sim_t *motor, fp32 dt, fp32 inertia)
+{
+    const motor_sim_param_t *param = motor->param;
+
+    motor->coef_dt = dt;
+    motor->coef_inertia = inertia;
+    motor->coef_current = dt / (param->current_tau + dt);
+    motor->coef_speed_filter = dt / (param->speed_filter_tau + dt);
+    motor->coef_inv_damped_inertia = 1.0f / (inertia + param->viscous_friction * dt);
+    motor->coef_thermal = dt / param->thermal_capacity;
+}
+
+//电调电流环 返回本步结束时的转矩电流
+static fp32 motor_sim_current_update(motor_sim_t *motor)
+{
+    const motor_sim_param_t *param = motor->param;
+    fp32 back_emf = param->ke * motor->speed;
+    fp32 command = 0.0f;
+    fp32 target;
+
+    //指令超时 电调关闭输出
+    if (motor->command_age < MOTOR_SIM_CMD_TIMEOUT_MS * 1.0e-3f)
+    {
+        command = (fp32)motor->command;
+    }
+
+    if (param->voltage_cmd)
+    {
+        fp32 voltage = command * param->cmd_scale * motor->bus_voltage;
+        target = (voltage - back_emf) / param->resistance;
+    }
+    else
+    {
+        //电流指令 受母线电压余量限制
+        target = motor_sim_clamp(command * param->cmd_scale,
+                                 (-motor->bus_voltage - back_emf) / param->resistance,
+                                 (motor->bus_voltage - back_emf) / param->resistance);
+    }
+
+    target = motor->current + (target - motor->current) * motor->coef_current;
+    return (fabsf(target) < MOTOR_SIM_TINY) ? 0.0f : target;
+}
+
+const motor_sim_param_t *motor_sim_get_param(motor_sim_type_e type)
+{
+    if (type >= MOTOR_SIM_TYPE_NUM)
+    {
+        return NULL;
+    }
+    return &motor_sim_param[type];
+}
+
+void motor_sim_init(motor_sim_t *motor, motor_sim_type_e type, fp32 bus_voltage)
+{
+    if (motor == NULL || type >= MOTOR_SIM_TYPE_NUM)
+    {
+        return;
+    }
+
+    motor->param = &motor_sim_param[type];
+    motor->bus_voltage = bus_voltage;
+    motor->load_inertia = 0.0f;
+    motor->load_torque = 0.0f;
+    motor->command = 0;
+    motor->command_age = MOTOR_SIM_CMD_TIMEOUT_MS * 1.0e-3f;
+    motor->current = 0.0f;
+    motor->speed = 0.0f;
+    motor->angle = 0.0f;
+    motor->speed_filtered = 0.0f;
+    motor->temperature = MOTOR_SIM_AMBIENT_TEMP;
+    motor->electrical_power = 0.0f;
+    motor->coef_dt = 0.0f;
+}
+
+void motor_sim_set_command(motor_sim_t *motor, int16_t command)
+{
+    int16_t max;
+
+    if (motor == NULL || motor->param == NULL)
+    {
+        return;
+    }
+
+    max = motor->param->cmd_max;
+    if (command > max)
+    {
+        command = max;
+    }
+    else if (command < -max)
+    {
+        command = -max;
+    }
+    motor->command = command;
+    motor->command_age = 0.0f;
+}
+
+void motor_sim_step(motor_sim_t *motor, fp32 dt)
+{
+    const motor_sim_param_t *param;
+    fp32 inertia;
+    fp32 drive_torque;
+    fp32 speed;
+    fp32 copper_loss;
+
+    if (motor == NULL || motor->param == NULL || dt <= 0.0f)
+    {
+        return;
+    }
+    param = motor->param;
+
+    inertia = param->rotor_inertia + motor->load_inertia;
+    if (dt != motor->coef_dt || inertia != motor->coef_inertia)
+    {
+        motor_sim_update_coef(motor, dt, inertia);
+    }
+
+    motor->current = motor_sim_current_update(motor);
+    motor->command_age += dt;
+
+    drive_torque = param->kt * motor->current - motor->load_torque;
+    speed = motor->speed;
+
+    if (fabsf(speed) < MOTOR_SIM_STICK_SPEED && fabsf(drive_torque) <= param->coulomb_friction)
+    {
+        //静摩擦 保持静止
+        speed = 0.0f;
+    }
+    else
+    {
+        fp32 friction_dir = (fabsf(speed) < MOTOR_SIM_STICK_SPEED) ? (drive_torque > 0.0f ? 1.0f : -1.0f)
+                                                                   : (speed > 0.0f ? 1.0f : -1.0f);
+        fp32 new_speed;
+
+        //粘滞摩擦隐式积分 无条件稳定
+        new_speed = (speed * inertia + (drive_torque - param->coulomb_friction * friction_dir) * dt) *
+                    motor->coef_inv_damped_inertia;
+        //库仑摩擦不能使转速反向
+        if (speed != 0.0f && new_speed * speed < 0.0f && fabsf(drive_torque) <= param->coulomb_friction)
+        {
+            new_speed = 0.0f;
+        }
+        speed = new_speed;
+    }
+
+    motor->angle += 0.5f * (motor->speed + speed) * dt;
+    motor->speed = speed;
+    motor->speed_filtered += (speed - motor->speed_filtered) * motor->coef_speed_filter;
+    if (fabsf(motor->speed_filtered) < MOTOR_SIM_TINY)
+    {
+        motor->speed_filtered = 0.0f;
+    }
+
+    //母线功率 = 铜损 + 机械功率
+    copper_loss = motor->current * motor->current * param->resistance;
+    motor->electrical_power = copper_loss + param->ke * speed * motor->current;
+    motor->temperature += (copper_loss - (motor->temperature - MOTOR_SIM_AMBIENT_TEMP) / param->thermal_resistance) *
+                          motor->coef_thermal;
+}
+
+void motor_sim_feedback(const motor_sim_t *motor, uint8_t data[8])
+{
+    fp32 turns;
+    uint16_t ecd;
+    int16_t speed_rpm;
+    int16_t given_current;
+    fp32 temperature;
+
+    if (motor == NULL || motor->param == NULL || data == NULL)
+    {
+        return;
+    }
+
+    //编码器量化 取转子角度的小数圈
+    turns = motor->angle / MOTOR_SIM_TWO_PI;
+    turns -= floorf(turns);
+    ecd = (uint16_t)((uint32_t)(turns * (fp32)MOTOR_SIM_ECD_RANGE) & (MOTOR_SIM_ECD_RANGE - 1u));
+
+    speed_rpm = motor_sim_to_int16(motor->speed_filtered * MOTOR_SIM_RAD_TO_RPM);
+    given_current = motor_sim_to_int16(motor->current * motor->param->fdb_current_scale);
+    temperature = motor_sim_clamp(motor->temperature, 0.0f, 255.0f);
+
+    data[0] = (uint8_t)(ecd >> 8);
+    data[1] = (uint8_t)ecd;
+    data[2] = (uint8_t)((uint16_t)speed_rpm >> 8);
+    data[3] = (uint8_t)speed_rpm;
+    data[4] = (uint8_t)((uint16_t)given_current >> 8);
+    data[5] = (uint8_t)given_current;
+    data[6] = (uint8_t)temperature;
+    data[7] = 0;
+}
+
+fp32 motor_sim_output_torque(const motor_sim_t *motor)
+{
+    if (motor == NULL || motor->param == NULL)
+    {
+        return 0.0f;
+    }
+    return motor->param->kt * motor->current * motor->param->gear_ratio;
+}
+
+fp32 motor_sim_output_speed(const motor_sim_t *motor)
+{
+    if (motor == NULL || motor->param == NULL)
+    {
+        return 0.0f;
+    }
+    return motor->speed / motor->param->gear_ratio;
+}
@@ -0,0 +1,153 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       motor_sim.c/h
+  * @brief      DJI电机与电调的上位机模型(M3508+C620, GM6020, M2006+C610)，
+  *             包括电调电流环、反电动势、母线电压限制、库仑/粘滞摩擦、转动惯量、
+  *             温升与编码器量化，反馈帧格式与CAN_receive.c中get_motor_measure一致。
+  * @note       只在上位机仿真中使用，不参与固件编译。纯浮点计算，无随机量，
+  *             相同输入得到相同输出。电机参数为手册值与经验值的近似，需用实测数据标定。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    模型(全部折算到转子侧):
+      电调: C620/C610 为电流指令, 一阶电流环 tau_i, 受母线电压限制
+                i_max = (Vbus - ke*w) / R, i_min = (-Vbus - ke*w) / R
+            GM6020 为电压指令, 电流 = (u - ke*w) / R 经电气时间常数滤波
+      转子: J*dw/dt = kt*i - b*w - Tc*sign(w) - T_load
+            静止且驱动转矩小于库仑摩擦时保持静止
+      反馈: ecd = 转子角度 8192线, speed_rpm = 滤波后的转子转速,
+            given_current = 实际转矩电流(电调单位), temperate = 绕组温度
+    kt与ke分开给出: 电调不是理想的相电压驱动, 按手册堵转转矩与空载转速分别拟合
+    使用方法:
+      motor_sim_init(&motor, MOTOR_SIM_M3508, 24.0f);
+      motor.load_inertia = ...;              //负载折算到转子侧
+      每收到一帧控制指令: motor_sim_set_command(&motor, cmd);
+      每个仿真步:         motor.load_torque = ...; motor_sim_step(&motor, dt);
+      每1ms:              motor_sim_feedback(&motor, data); //8字节反馈帧
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef MOTOR_SIM_H
+#define MOTOR_SIM_H
+
+#include "struct_typedef.h"
+
+#define MOTOR_SIM_CMD_TIMEOUT_MS 100u  //超过该时间没有收到指令 电调输出置零
+#define MOTOR_SIM_AMBIENT_TEMP   30.0f //环境温度 ℃
+#define MOTOR_SIM_ECD_RANGE      8192u //编码器线数
+
+/*电机型号*/
+typedef enum
+{
+    MOTOR_SIM_M3508 = 0, //M3508 + C620 电流指令 ±16384 -> ±20A
+    MOTOR_SIM_GM6020,    //GM6020      电压指令 ±30000 -> ±Vbus
+    MOTOR_SIM_M2006,     //M2006 + C610 电流指令 ±10000 -> ±10A
+    MOTOR_SIM_TYPE_NUM,
+} motor_sim_type_e;
+
+/*电机参数 转子侧*/
+typedef struct
+{
+    uint8_t voltage_cmd;        //1:指令为电压 0:指令为电流
+    fp32 cmd_scale;             //电流指令: 指令值 -> A; 电压指令: 指令值 -> 占空比
+    int16_t cmd_max;            //指令限幅
+    fp32 fdb_current_scale;     //实际电流(A) -> 反馈given_current
+    fp32 kt;                    //转矩常数 N·m/A
+    fp32 ke;                    //反电动势常数 V·s/rad
+    fp32 resistance;            //绕组电阻 Ω
+    fp32 current_tau;           //电流环(电流指令)或电气(电压指令)时间常数 s
+    fp32 rotor_inertia;         //转子与减速箱转动惯量 kg·m²
+    fp32 gear_ratio;            //减速比 转子转速/输出轴转速
+    fp32 coulomb_friction;      //库仑摩擦 N·m
+    fp32 viscous_friction;      //粘滞摩擦 N·m·s/rad
+    fp32 speed_filter_tau;      //电调转速反馈滤波时间常数 s
+    fp32 thermal_resistance;    //绕组到环境热阻 K/W
+    fp32 thermal_capacity;      //绕组热容 J/K
+} motor_sim_param_t;
+
+/*电机状态*/
+typedef struct
+{
+    const motor_sim_param_t *param;
+    fp32 bus_voltage;           //母线电压 V
+    fp32 load_inertia;          //外部负载转动惯量 折算到转子侧 kg·m²
+    fp32 load_torque;           //外部负载转矩 折算到转子侧 N·m 由上层模型每步设置
+
+    int16_t command;            //最近一次指令
+    fp32 command_age;           //距最近一次指令的时间 s
+
+    fp32 current;               //转矩电流 A
+    fp32 speed;                 //转子角速度 rad/s
+    fp32 angle;                 //转子累计角度 rad
+    fp32 speed_filtered;        //电调反馈用的滤波转速 rad/s
+    fp32 temperature;           //绕组温度 ℃
+    fp32 electrical_power;      //母线输入功率 W
+
+    /*步长相关系数 步长或负载惯量变化时重新计算*/
+    fp32 coef_dt;
+    fp32 coef_inertia;
+    fp32 coef_current;          //电流环一阶滤波系数
+    fp32 coef_speed_filter;     //转速反馈滤波系数
+    fp32 coef_inv_damped_inertia; //1 / (J + b*dt)
+    fp32 coef_thermal;          //dt / 热容
+} motor_sim_t;
+
+/**
+  * @brief          获取电机型号的默认参数
+  * @param[in]      type: 电机型号
+  * @retval         参数指针, 型号错误返回NULL
+  */
+extern const motor_sim_param_t *motor_sim_get_param(motor_sim_type_e type);
+
+/**
+  * @brief          电机初始化 静止 零电流 环境温度
+  * @param[out]     motor: 电机状态
+  * @param[in]      type: 电机型号
+  * @param[in]      bus_voltage: 母线电压 V
+  * @retval         none
+  */
+extern void motor_sim_init(motor_sim_t *motor, motor_sim_type_e type, fp32 bus_voltage);
+
+/**
+  * @brief          收到一帧控制指令
+  * @param[in,out]  motor: 电机状态
+  * @param[in]      command: 指令值(电调单位)
+  * @retval         none
+  */
+extern void motor_sim_set_command(motor_sim_t *motor, int16_t command);
+
+/**
+  * @brief          推进一个仿真步, 步长建议不大于0.1ms
+  * @param[in,out]  motor: 电机状态
+  * @param[in]      dt: 步长 s
+  * @retval         none
+  */
+extern void motor_sim_step(motor_sim_t *motor, fp32 dt);
+
+/**
+  * @brief          生成电调反馈帧数据
+  * @param[in]      motor: 电机状态
+  * @param[out]     data: 8字节 ecd(大端) speed_rpm(大端) given_current(大端) temperate 保留
+  * @retval         none
+  */
+extern void motor_sim_feedback(const motor_sim_t *motor, uint8_t data[8]);
+
+/**
+  * @brief          输出轴转矩(电磁转矩乘减速比, 不含摩擦)
+  * @param[in]      motor: 电机状态
+  * @retval         N·m
+  */
+extern fp32 motor_sim_output_torque(const motor_sim_t *motor);
+
+/**
+  * @brief          输出轴角速度
+  * @param[in]      motor: 电机状态
+  * @retval         rad/s
+  */
+extern fp32 motor_sim_output_speed(const motor_sim_t *motor);
+
+#endif
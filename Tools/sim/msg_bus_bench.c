@@ -0,0 +1,453 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       msg_bus_bench.c
+  * @brief      消息总线上位机压力测试与延迟基准，多个pthread线程同时发布/读取同一话题，
+  *             检查样本完整(无撕裂)、版本号单调、没有发布失败，并统计各接口的
+  *             执行周期数与发布->通知->订阅线程读到样本的延迟。
+  * @note       上位机锁为自旋锁, 目标板为关中断, 周期数只用于比较改动前后,
+  *             目标板执行时间以monitor任务与profile统计为准。
+  *             检查失败时返回1, make bench时先运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: msg_bus_bench [每个发布者的发布次数]
+    压力测试: 2个零拷贝发布者, 1个零拷贝读者(占用后停留一段时间), 1个拷贝读者,
+              1个队列订阅者; 话题按2个发布者2个读者定义(5个槽)
+    延迟: 单线程下各接口的周期数中位数/p99;
+          发布者每100us发布一次, 订阅者由通知唤醒, 统计发布到读到样本的时间
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#define _DEFAULT_SOURCE //nanosleep
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bsp_dwt.h"
+#include "msg_bus.h"
+
+#define BENCH_PAYLOAD_NUM   24u
+#define BENCH_PUBLISHER_NUM 2u
+#define BENCH_QUEUE_DEPTH   64u
+#define BENCH_DEFAULT_COUNT 200000u
+#define BENCH_CYCLE_COUNT   100000u
+#define BENCH_PING_COUNT    5000u
+#define BENCH_PING_PERIOD_NS 100000l
+
+/*测试消息 载荷由发布者编号与序号生成 校验字检查是否撕裂*/
+typedef struct
+{
+    uint32_t publisher;
+    uint32_t seq;
+    uint64_t stamp_ns;
+    uint32_t payload[BENCH_PAYLOAD_NUM];
+    uint32_t check;
+} bench_msg_t;
+
+MSG_BUS_TOPIC_DEFINE(stress, bench_msg_t, BENCH_PUBLISHER_NUM, 2);
+MSG_BUS_TOPIC_DEFINE(ping, bench_msg_t, 1, 1);
+
+static uint32_t bench_count = BENCH_DEFAULT_COUNT;
+static volatile int bench_publishing;
+static uint32_t bench_error;
+static pthread_mutex_t bench_error_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_fail(const char *what, uint32_t a, uint32_t b)
+{
+    pthread_mutex_lock(&bench_error_lock);
+    if (bench_error < 10)
+    {
+        fprintf(stderr, "error: %s (%u, %u)\n", what, a, b);
+    }
+    bench_error++;
+    pthread_mutex_unlock(&bench_error_lock);
+}
+
+//逐字写入 中途被读取时校验字不匹配
+static void bench_msg_fill(bench_msg_t *msg, uint32_t publisher, uint32_t seq)
+{
+    uint32_t check = publisher ^ seq;
+    uint32_t i;
+
+    msg->publisher = publisher;
+    msg->seq = seq;
+    msg->stamp_ns = bench_now_ns();
+    for (i = 0; i < BENCH_PAYLOAD_NUM; i++)
+    {
+        msg->payload[i] = seq * 2654435761u + publisher * 40503u + i;
+        check ^= msg->payload[i];
+    }
+    msg->check = check;
+}
+
+static bool_t bench_msg_valid(const bench_msg_t *msg)
+{
+    uint32_t check = msg->publisher ^ msg->seq;
+    uint32_t i;
+
+    if (msg->publisher >= BENCH_PUBLISHER_NUM)
+    {
+        return 0;
+    }
+    for (i = 0; i < BENCH_PAYLOAD_NUM; i++)
+    {
+        if (msg->payload[i] != msg->seq * 2654435761u + msg->publisher * 40503u + i)
+        {
+            return 0;
+        }
+        check ^= msg->payload[i];
+    }
+    return check == msg->check;
+}
+
+/*读者状态 版本号单调, 同一发布者的序号单调*/
+typedef struct
+{
+    const char *name;
+    uint32_t version;
+    uint32_t seq[BENCH_PUBLISHER_NUM];
+    uint32_t sample_count;
+} bench_reader_t;
+
+typedef struct
+{
+    bench_reader_t reader;
+    msg_bus_sub_t sub;
+} bench_sub_t;
+
+static void bench_reader_check(bench_reader_t *reader, const bench_msg_t *msg, uint32_t version, bool_t strict)
+{
+    if (!bench_msg_valid(msg))
+    {
+        bench_fail("torn sample", version, msg->seq);
+        return;
+    }
+    if (version < reader->version || (strict && version == reader->version))
+    {
+        bench_fail("version order", reader->version, version);
+    }
+    if (msg->seq < reader->seq[msg->publisher])
+    {
+        bench_fail("sequence order", reader->seq[msg->publisher], msg->seq);
+    }
+    reader->version = version;
+    reader->seq[msg->publisher] = msg->seq;
+    reader->sample_count++;
+}
+
+static void *bench_publisher_thread(void *arg)
+{
+    uint32_t publisher = (uint32_t)(uintptr_t)arg;
+    uint32_t seq;
+    bench_msg_t *msg;
+
+    for (seq = 1; seq <= bench_count; seq++)
+    {
+        msg = msg_bus_publish_begin(MSG_BUS_TOPIC(stress));
+        if (msg == NULL)
+        {
+            bench_fail("no free slot", publisher, seq);
+            continue;
+        }
+        bench_msg_fill(msg, publisher, seq);
+        msg_bus_publish_end(MSG_BUS_TOPIC(stress), msg);
+    }
+    return NULL;
+}
+
+//零拷贝读者 占用样本后再读一遍 期间样本不能被改写
+static void *bench_acquire_thread(void *arg)
+{
+    bench_reader_t *reader = &((bench_sub_t *)arg)->reader;
+    msg_bus_sub_t *sub = &((bench_sub_t *)arg)->sub;
+    const bench_msg_t *msg;
+    uint32_t version;
+
+    while (bench_publishing)
+    {
+        msg = msg_bus_acquire(sub, &version);
+        if (msg != NULL)
+        {
+            bench_reader_check(reader, msg, version, 0);
+            sched_yield();
+            if (!bench_msg_valid(msg))
+            {
+                bench_fail("pinned sample overwritten", version, msg->seq);
+            }
+            msg_bus_release(sub);
+        }
+    }
+    return NULL;
+}
+
+static void *bench_read_thread(void *arg)
+{
+    bench_reader_t *reader = &((bench_sub_t *)arg)->reader;
+    msg_bus_sub_t *sub = &((bench_sub_t *)arg)->sub;
+    bench_msg_t msg;
+    uint32_t version;
+
+    while (bench_publishing)
+    {
+        if (msg_bus_read(sub, &msg, &version))
+        {
+            bench_reader_check(reader, &msg, version, 0);
+        }
+    }
+    return NULL;
+}
+
+static void *bench_queue_thread(void *arg)
+{
+    bench_reader_t *reader = &((bench_sub_t *)arg)->reader;
+    msg_bus_sub_t *sub = &((bench_sub_t *)arg)->sub;
+    bench_msg_t msg;
+    uint32_t version;
+
+    while (bench_publishing || sub->queue_head != sub->queue_tail)
+    {
+        while (msg_bus_queue_pop(sub, &msg, &version))
+        {
+            bench_reader_check(reader, &msg, version, 1);
+        }
+        sched_yield();
+    }
+    return NULL;
+}
+
+static int bench_stress(void)
+{
+    static uint64_t queue[MSG_BUS_QUEUE_WORDS(sizeof(bench_msg_t), BENCH_QUEUE_DEPTH)];
+    static bench_sub_t sub[3] = {{{"acquire"}}, {{"read"}}, {{"queue"}}};
+    void *(*reader_thread[3])(void *) = {bench_acquire_thread, bench_read_thread, bench_queue_thread};
+    pthread_t publisher[BENCH_PUBLISHER_NUM];
+    pthread_t reader[3];
+    uint64_t start_ns;
+    uint32_t i;
+
+    msg_bus_subscribe(&sub[0].sub, MSG_BUS_TOPIC(stress), NULL, 0, NULL, NULL);
+    msg_bus_subscribe(&sub[1].sub, MSG_BUS_TOPIC(stress), NULL, 0, NULL, NULL);
+    msg_bus_subscribe(&sub[2].sub, MSG_BUS_TOPIC(stress), queue, BENCH_QUEUE_DEPTH, NULL, NULL);
+
+    start_ns = bench_now_ns();
+    bench_publishing = 1;
+    for (i = 0; i < 3; i++)
+    {
+        pthread_create(&reader[i], NULL, reader_thread[i], &sub[i]);
+    }
+    for (i = 0; i < BENCH_PUBLISHER_NUM; i++)
+    {
+        pthread_create(&publisher[i], NULL, bench_publisher_thread, (void *)(uintptr_t)i);
+    }
+    for (i = 0; i < BENCH_PUBLISHER_NUM; i++)
+    {
+        pthread_join(publisher[i], NULL);
+    }
+    bench_publishing = 0;
+    for (i = 0; i < 3; i++)
+    {
+        pthread_join(reader[i], NULL);
+    }
+
+    if (MSG_BUS_TOPIC(stress)->version != bench_count * BENCH_PUBLISHER_NUM)
+    {
+        bench_fail("published count", MSG_BUS_TOPIC(stress)->version, bench_count * BENCH_PUBLISHER_NUM);
+    }
+    if (MSG_BUS_TOPIC(stress)->drop_count != 0)
+    {
+        bench_fail("drop count", MSG_BUS_TOPIC(stress)->drop_count, 0);
+    }
+    for (i = 0; i < MSG_BUS_TOPIC(stress)->slot_num; i++)
+    {
+        if (MSG_BUS_TOPIC(stress)->slot_state[i] != 0)
+        {
+            bench_fail("slot still in use", i, MSG_BUS_TOPIC(stress)->slot_state[i]);
+        }
+    }
+    //队列收到的加上因队列满丢弃的 等于发布总数
+    if (sub[2].reader.sample_count + sub[2].sub.queue_overflow != bench_count * BENCH_PUBLISHER_NUM)
+    {
+        bench_fail("queue count", sub[2].reader.sample_count, sub[2].sub.queue_overflow);
+    }
+
+    printf("stress: %u publishers x %u samples in %.1f ms, %u slots\n", BENCH_PUBLISHER_NUM, bench_count,
+           (bench_now_ns() - start_ns) / 1e6, MSG_BUS_TOPIC(stress)->slot_num);
+    for (i = 0; i < 3; i++)
+    {
+        printf("  %-8s %u samples", sub[i].reader.name, sub[i].reader.sample_count);
+        if (i == 2)
+        {
+            printf(", %u dropped by full queue", sub[2].sub.queue_overflow);
+        }
+        printf("\n");
+    }
+    return 0;
+}
+
+static int bench_compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void bench_print_dist(const char *name, uint32_t *value, uint32_t count, const char *unit)
+{
+    qsort(value, count, sizeof(value[0]), bench_compare_u32);
+    printf("  %-22s median %6u  p99 %6u  max %8u %s\n", name, value[count / 2], value[count * 99 / 100],
+           value[count - 1], unit);
+}
+
+//单线程 无竞争时各接口的周期数
+static void bench_cycles(void)
+{
+    static uint32_t cycles[BENCH_CYCLE_COUNT];
+    static msg_bus_sub_t sub;
+    bench_msg_t msg;
+    uint32_t start;
+    uint32_t i;
+
+    msg_bus_subscribe(&sub, MSG_BUS_TOPIC(ping), NULL, 0, NULL, NULL);
+    bench_msg_fill(&msg, 0, 1);
+
+    printf("cycles (single thread, %u bytes):\n", (unsigned)sizeof(bench_msg_t));
+    for (i = 0; i < BENCH_CYCLE_COUNT; i++)
+    {
+        start = dwt_cycle_get();
+        msg_bus_publish(MSG_BUS_TOPIC(ping), &msg);
+        cycles[i] = dwt_cycle_get() - start;
+    }
+    bench_print_dist("publish (copy)", cycles, BENCH_CYCLE_COUNT, "cycles");
+
+    for (i = 0; i < BENCH_CYCLE_COUNT; i++)
+    {
+        bench_msg_t *slot;
+        start = dwt_cycle_get();
+        slot = msg_bus_publish_begin(MSG_BUS_TOPIC(ping));
+        slot->seq = i;
+        msg_bus_publish_end(MSG_BUS_TOPIC(ping), slot);
+        cycles[i] = dwt_cycle_get() - start;
+    }
+    bench_print_dist("publish (zero-copy)", cycles, BENCH_CYCLE_COUNT, "cycles");
+
+    for (i = 0; i < BENCH_CYCLE_COUNT; i++)
+    {
+        start = dwt_cycle_get();
+        msg_bus_acquire(&sub, NULL);
+        msg_bus_release(&sub);
+        cycles[i] = dwt_cycle_get() - start;
+    }
+    bench_print_dist("acquire + release", cycles, BENCH_CYCLE_COUNT, "cycles");
+
+    for (i = 0; i < BENCH_CYCLE_COUNT; i++)
+    {
+        start = dwt_cycle_get();
+        msg_bus_read(&sub, &msg, NULL);
+        cycles[i] = dwt_cycle_get() - start;
+    }
+    bench_print_dist("read (copy)", cycles, BENCH_CYCLE_COUNT, "cycles");
+}
+
+static sem_t bench_ping_sem;
+static volatile int bench_ping_done;
+
+//发布通知 目标板为osSignalSet
+static void bench_ping_notify(void *user)
+{
+    sem_post((sem_t *)user);
+}
+
+static void *bench_ping_thread(void *arg)
+{
+    msg_bus_sub_t *sub = arg;
+    static uint32_t latency[BENCH_PING_COUNT];
+    const bench_msg_t *msg;
+    uint32_t count = 0;
+
+    //订阅者来不及处理时多次发布只读到最新的一个 样本数可能少于发布数
+    while (!bench_ping_done && count < BENCH_PING_COUNT)
+    {
+        sem_wait(&bench_ping_sem);
+        if (!msg_bus_updated(sub))
+        {
+            continue;
+        }
+        msg = msg_bus_acquire(sub, NULL);
+        latency[count++] = (uint32_t)(bench_now_ns() - msg->stamp_ns);
+        msg_bus_release(sub);
+    }
+    if (count == 0)
+    {
+        bench_fail("no notified sample", 0, 0);
+        return NULL;
+    }
+    bench_print_dist("publish -> subscriber", latency, count, "ns");
+    return NULL;
+}
+
+//发布->通知->订阅线程读到样本
+static void bench_latency(void)
+{
+    static msg_bus_sub_t sub;
+    struct timespec period = {0, BENCH_PING_PERIOD_NS};
+    pthread_t thread;
+    bench_msg_t msg;
+    uint32_t seq;
+
+    sem_init(&bench_ping_sem, 0, 0);
+    //先订阅再发布 通知链表在发布开始后不再修改
+    msg_bus_subscribe(&sub, MSG_BUS_TOPIC(ping), NULL, 0, bench_ping_notify, &bench_ping_sem);
+    sub.version = MSG_BUS_TOPIC(ping)->version;
+
+    printf("latency (notify wakeup, %ld us period):\n", BENCH_PING_PERIOD_NS / 1000);
+    pthread_create(&thread, NULL, bench_ping_thread, &sub);
+    for (seq = 1; seq <= BENCH_PING_COUNT; seq++)
+    {
+        nanosleep(&period, NULL);
+        bench_msg_fill(&msg, 0, seq);
+        msg_bus_publish(MSG_BUS_TOPIC(ping), &msg);
+    }
+    bench_ping_done = 1;
+    sem_post(&bench_ping_sem);
+    pthread_join(thread, NULL);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+    {
+        bench_count = (uint32_t)strtoul(argv[1], NULL, 0);
+        if (bench_count == 0)
+        {
+            fprintf(stderr, "usage: msg_bus_bench [count]\n");
+            return 2;
+        }
+    }
+
+    bench_stress();
+    bench_cycles();
+    bench_latency();
+
+    if (bench_error != 0)
+    {
+        fprintf(stderr, "msg_bus_bench: %u errors\n", bench_error);
+        return 1;
+    }
+    printf("msg_bus_bench: ok\n");
+    return 0;
+}
@@ -0,0 +1,794 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       rc_sim.c
+  * @brief      遥控器上位机测试，串口寄存器级假设备(sim_usart.c)驱动bsp_rc.c与remote_control.c，
+  *             统计串口空闲中断与任务中解析一帧的周期数(解析移出中断前后对比)，
+  *             检查高优先级读者在写者发布过程中抢占时读到完整一帧且不等待写者，
+  *             非法帧的丢弃与计数、掉线后失控保护的判定时间与恢复，
+  *             以及多线程并发读写时不出现半新半旧的帧。
+  * @note       sbus_rx_buf为remote_control.c中的静态数组，DMA地址寄存器为32位，
+  *             程序以-no-pie链接使静态数据位于低4GB。检查失败时返回1, make bench时运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: rc_sim
+    isr         每14ms一帧 统计USART3_IRQHandler与遥控器任务解析一帧的周期数,
+                中断中不发布数据(只通知任务), 每帧解析结果与发送的一致
+                改动前解析在中断中完成, 改动前的中断周期数按 中断 + 解析 估算
+    preempt     单调速率下2ms控制任务优先级高于14ms遥控器任务:
+                在写者每个__DMB处调用remote_control_read(见sim_cpu.h),
+                读到的必须是上一帧或本帧, 且读者不重试; 读者等待写者时计为死循环
+    reject      开关值非法、摇杆超出范围一个单位、间隔过短的帧计入error_count,
+                短帧与长帧计入length_error_count, 均不发布; 波轮越界按中值接收
+    failsafe    每1ms按控制任务的方式判断失控并读取: 丢6帧(98ms)不触发失控,
+                掉线后第RC_LOST_TIME_MS+1 ms进入失控, 读到的摇杆与键鼠为0,
+                恢复后第RC_RECOVER_FRAME_NUM帧解除, 丢帧数按帧周期推算
+    concurrent  遥控器任务、3个读者线程与中断线程同时运行,
+                读到的每一帧各字段属于同一帧, 帧号不倒退
+
+    帧内容由帧号k生成, 鼠标x为k, 其余字段由k推算, 读者据此检查一帧是否完整
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <pthread.h>
+#include <sched.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "main.h"
+#include "cmsis_os.h"
+#include "bsp_dwt.h"
+#include "bsp_rc.h"
+#include "remote_control.h"
+#include "blackbox.h"
+#include "task_registry.h"
+#include "sim_cpu.h"
+#include "sim_os.h"
+#include "sim_usart.h"
+
+#define SIM_ISR_FRAMES          5000u
+#define SIM_PREEMPT_FRAMES      2000u
+#define SIM_CONCURRENT_FRAMES   20000u  //帧号放在鼠标x中 三个场景的总帧数不超过32767
+#define SIM_READER_NUM          3u
+#define SIM_READER_SPIN_MAX     1000u   //读者在一次抢占中执行__DMB的上限 超过视为等待写者
+#define SIM_REJECT_CYCLES       50u
+#define SIM_FAILSAFE_SLOTS      64u
+
+/*帧校验与失控保护 每个帧周期一个时隙*/
+typedef enum
+{
+    SIM_SLOT_VALID = 0,     //正常帧
+    SIM_SLOT_BAD_SWITCH,    //开关值为0
+    SIM_SLOT_BAD_CHANNEL,   //摇杆通道超出范围一个单位
+    SIM_SLOT_WHEEL,         //波轮通道越界 按中值接收
+    SIM_SLOT_SHORT,         //10字节
+    SIM_SLOT_LONG,          //25字节
+    SIM_SLOT_EARLY,         //正常帧 2ms后再来一帧(间隔过短)
+    SIM_SLOT_GAP,           //不发送
+} sim_slot_e;
+
+/*读者线程统计*/
+typedef struct
+{
+    pthread_t thread;
+    uint32_t reads;
+    uint32_t torn;
+    uint32_t backward;
+    uint32_t last_k;
+} sim_reader_t;
+
+//目标板上在stm32f4xx_it.h中声明
+extern void USART3_IRQHandler(void);
+
+//bsp_rc.c使用的CubeMX句柄
+UART_HandleTypeDef huart3;
+DMA_HandleTypeDef hdma_usart3_rx;
+static DMA_HandleTypeDef hdma_usart3_tx;
+
+static sim_usart_t sim_port;
+static uint32_t sim_error;
+static const char *sim_current;
+
+//遥控器任务
+static volatile bool_t sim_threaded;
+static volatile bool_t sim_stop;
+static volatile bool_t sim_task_started;
+static volatile bool_t sim_in_task;
+static uint32_t sim_notify;
+static pthread_mutex_t sim_notify_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sim_notify_cond = PTHREAD_COND_INITIALIZER;
+
+//中断中发送的帧
+static uint32_t sim_frame_k;
+static uint32_t sim_frame_end;
+
+//周期数
+static uint32_t sim_isr_cycles[SIM_ISR_FRAMES];
+static uint32_t sim_decode_cycles[SIM_ISR_FRAMES];
+static uint32_t sim_isr_count;
+static uint32_t sim_decode_count;
+static uint32_t sim_decode_start;
+static uint32_t sim_isr_published;
+
+//抢占
+static uint32_t sim_preempt_count;
+static uint32_t sim_preempt_retry;
+static uint32_t sim_preempt_bad;
+static uint32_t sim_reader_spin;
+static jmp_buf sim_livelock;
+
+//帧校验与失控保护
+static const uint8_t *sim_slot;
+static uint32_t sim_slot_num;
+static uint32_t sim_slot_pos;
+static uint32_t sim_bad_num;
+static uint32_t sim_early_ms;
+static RC_ctrl_t sim_accepted;          //最近一次应被接收的帧
+static uint32_t sim_accepted_ms;
+static uint32_t sim_stale;              //读到的不是最近一次接收的帧
+static bool_t sim_failsafe;
+static uint32_t sim_failsafe_after_ms;  //最近一次有效帧到判定失控的时间
+static uint32_t sim_recover_frames;
+static uint32_t sim_recover_result;     //失控后解除前收到的有效帧数
+static uint32_t sim_freeze_count;
+
+static void sim_check(bool_t ok, const char *what, uint32_t value, uint32_t expect)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "error: %s: %s %u, expect %u\n", sim_current, what, (unsigned)value, (unsigned)expect);
+        sim_error++;
+    }
+}
+
+/*--------仿真的RTOS接口与固件依赖--------*/
+
+osThreadId osThreadGetId(void)
+{
+    sim_task_started = 1;
+    return (osThreadId)&sim_notify;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, uint32_t xTicksToWait)
+{
+    uint32_t value;
+
+    (void)xTicksToWait;
+    if (sim_threaded)
+    {
+        pthread_mutex_lock(&sim_notify_mutex);
+        while (sim_notify == 0 && !sim_stop)
+        {
+            pthread_cond_wait(&sim_notify_cond, &sim_notify_mutex);
+        }
+        if (sim_stop)
+        {
+            pthread_mutex_unlock(&sim_notify_mutex);
+            pthread_exit(NULL);
+        }
+        value = sim_notify;
+        sim_notify = xClearCountOnExit ? 0 : value - 1u;
+        pthread_mutex_unlock(&sim_notify_mutex);
+        return value;
+    }
+
+    //单线程 等待期间仿真时间推进 钩子中产生中断
+    while (sim_notify == 0)
+    {
+        osDelay(1);
+    }
+    value = sim_notify;
+    sim_notify = xClearCountOnExit ? 0 : value - 1u;
+    return value;
+}
+
+void vTaskNotifyGiveFromISR(osThreadId xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void)xTaskToNotify;
+    pthread_mutex_lock(&sim_notify_mutex);
+    sim_notify++;
+    pthread_cond_signal(&sim_notify_cond);
+    pthread_mutex_unlock(&sim_notify_mutex);
+    *pxHigherPriorityTaskWoken = pdTRUE;
+}
+
+void task_job_begin(task_id_e id)
+{
+    if (id == TASK_RC)
+    {
+        sim_in_task = 1;
+        sim_decode_start = dwt_cycle_get();
+    }
+}
+
+void task_job_end(task_id_e id)
+{
+    uint32_t cycles = dwt_cycle_get() - sim_decode_start;
+
+    if (id == TASK_RC)
+    {
+        sim_in_task = 0;
+        if (sim_decode_count < SIM_ISR_FRAMES)
+        {
+            sim_decode_cycles[sim_decode_count++] = cycles;
+        }
+    }
+}
+
+void blackbox_write(blackbox_lane_e lane, uint8_t type, const void *data, uint8_t len)
+{
+    (void)lane;
+    (void)type;
+    (void)data;
+    (void)len;
+}
+
+void blackbox_freeze(blackbox_freeze_e reason, uint32_t info)
+{
+    (void)reason;
+    (void)info;
+    sim_freeze_count++;
+}
+
+static void sim_usart_irq(void *arg)
+{
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t frames = get_remote_control_status_point()->frame_count;
+
+    (void)arg;
+    start = dwt_cycle_get();
+    USART3_IRQHandler();
+    cycles = dwt_cycle_get() - start;
+    if (sim_isr_count < SIM_ISR_FRAMES)
+    {
+        sim_isr_cycles[sim_isr_count++] = cycles;
+    }
+    if (get_remote_control_status_point()->frame_count != frames)
+    {
+        sim_isr_published++;
+    }
+}
+
+static void sim_dma_irq(void *arg)
+{
+    (void)arg;
+    RC_dma_irq_handler();
+}
+
+/*--------帧内容--------*/
+
+//由帧号生成一帧解析后的数据 通道与开关均在合法范围内
+static void sim_rc_expect(uint32_t k, RC_ctrl_t *rc)
+{
+    uint32_t i;
+
+    for (i = 0; i < 4u; i++)
+    {
+        rc->rc.remote_channel[i] = (int16_t)((k * 37u + i * 101u) % 1321u) - RC_CH_VALUE_RANGE;
+    }
+    rc->rc.remote_channel[4] = (int16_t)((k * 13u) % 1321u) - RC_CH_VALUE_RANGE;
+    rc->rc.switch_channel[0] = (char)(1u + k % 3u);
+    rc->rc.switch_channel[1] = (char)(1u + (k / 3u) % 3u);
+    rc->mouse.x = (int16_t)(k & 0x7FFFu);
+    rc->mouse.y = (int16_t)(-(int32_t)(k & 0x7FFFu));
+    rc->mouse.z = (int16_t)(k * 7u);
+    rc->mouse.press_left = (uint8_t)(k & 1u);
+    rc->mouse.press_right = (uint8_t)((k >> 1) & 1u);
+    rc->keyboard.value = (uint16_t)(k * 3u);
+}
+
+//sbus_to_rc的逆过程
+static void sim_rc_encode(const RC_ctrl_t *rc, uint8_t *buf)
+{
+    uint16_t ch[5];
+    uint32_t i;
+
+    for (i = 0; i < 5u; i++)
+    {
+        ch[i] = (uint16_t)(rc->rc.remote_channel[i] + RC_CH_VALUE_OFFSET);
+    }
+    buf[0] = (uint8_t)ch[0];
+    buf[1] = (uint8_t)((ch[0] >> 8) | (ch[1] << 3));
+    buf[2] = (uint8_t)((ch[1] >> 5) | (ch[2] << 6));
+    buf[3] = (uint8_t)(ch[2] >> 2);
+    buf[4] = (uint8_t)((ch[2] >> 10) | (ch[3] << 1));
+    buf[5] = (uint8_t)((ch[3] >> 7) | ((uint8_t)rc->rc.switch_channel[0] << 4) | ((uint8_t)rc->rc.switch_channel[1] << 6));
+    buf[6] = (uint8_t)rc->mouse.x;
+    buf[7] = (uint8_t)((uint16_t)rc->mouse.x >> 8);
+    buf[8] = (uint8_t)rc->mouse.y;
+    buf[9] = (uint8_t)((uint16_t)rc->mouse.y >> 8);
+    buf[10] = (uint8_t)rc->mouse.z;
+    buf[11] = (uint8_t)((uint16_t)rc->mouse.z >> 8);
+    buf[12] = rc->mouse.press_left;
+    buf[13] = rc->mouse.press_right;
+    buf[14] = (uint8_t)rc->keyboard.value;
+    buf[15] = (uint8_t)(rc->keyboard.value >> 8);
+    buf[16] = (uint8_t)ch[4];
+    buf[17] = (uint8_t)(ch[4] >> 8);
+}
+
+//线路上发送len字节 前18字节为编码后的一帧 帧后空闲
+static void sim_rc_send_ctrl(const RC_ctrl_t *rc, uint32_t len)
+{
+    uint8_t buf[SBUS_RX_BUF_NUM] = {0};
+
+    sim_rc_encode(rc, buf);
+    sim_usart_receive(&sim_port, buf, len);
+    sim_usart_idle(&sim_port);
+}
+
+//线路上发送第k帧
+static void sim_rc_send(uint32_t k)
+{
+    RC_ctrl_t rc;
+
+    sim_rc_expect(k, &rc);
+    sim_rc_send_ctrl(&rc, RC_FRAME_LENGTH);
+}
+
+//读到的一帧是否完整 返回帧号 失控清零的帧返回0
+static bool_t sim_rc_match(const RC_ctrl_t *rc, uint32_t *k)
+{
+    RC_ctrl_t expect;
+
+    *k = (uint16_t)rc->mouse.x;
+    if (*k == 0)
+    {
+        return rc->keyboard.value == 0 && rc->rc.remote_channel[0] == 0;
+    }
+    sim_rc_expect(*k, &expect);
+    return memcmp(rc, &expect, sizeof(RC_ctrl_t)) == 0;
+}
+
+//每个帧周期发送一帧
+static void sim_rc_tick(uint32_t now_ms, void *user)
+{
+    (void)user;
+    if (now_ms % RC_FRAME_PERIOD_MS == 0 && sim_frame_k < sim_frame_end)
+    {
+        sim_rc_send(++sim_frame_k);
+    }
+}
+
+/*--------中断周期数--------*/
+
+static int sim_compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void sim_print_dist(const char *name, uint32_t *value, uint32_t count)
+{
+    qsort(value, count, sizeof(value[0]), sim_compare_u32);
+    printf("  %-28s median %6u  p99 %6u  max %8u cycles\n", name, (unsigned)value[count / 2], (unsigned)value[count * 99 / 100],
+           (unsigned)value[count - 1]);
+}
+
+static void sim_isr(void)
+{
+    static uint32_t before[SIM_ISR_FRAMES];
+    const RC_status_t *status = get_remote_control_status_point();
+    uint32_t frames = status->frame_count;
+    uint32_t count;
+    uint32_t i;
+    RC_ctrl_t rc;
+    uint32_t k = 0;
+
+    sim_current = "isr";
+    sim_isr_count = 0;
+    sim_decode_count = 0;
+    sim_isr_published = 0;
+    sim_frame_end = sim_frame_k + SIM_ISR_FRAMES;
+    sim_os_set_tick_hook(sim_rc_tick, NULL);
+    sim_os_run(remote_control_task, SIM_ISR_FRAMES * RC_FRAME_PERIOD_MS + 1u);
+
+    remote_control_read(&rc);
+    sim_check(status->frame_count - frames == SIM_ISR_FRAMES, "frames", status->frame_count - frames, SIM_ISR_FRAMES);
+    sim_check(sim_isr_published == 0, "frames published in isr", sim_isr_published, 0);
+    sim_check(sim_rc_match(&rc, &k) && k == sim_frame_k, "last frame", k, sim_frame_k);
+    sim_check(sim_isr_count == SIM_ISR_FRAMES && sim_decode_count == SIM_ISR_FRAMES, "samples", sim_isr_count, SIM_ISR_FRAMES);
+
+    count = sim_isr_count < sim_decode_count ? sim_isr_count : sim_decode_count;
+    for (i = 0; i < count; i++)
+    {
+        before[i] = sim_isr_cycles[i] + sim_decode_cycles[i];
+    }
+    printf("isr: %u frames\n", (unsigned)count);
+    if (count == 0)
+    {
+        return;
+    }
+    sim_print_dist("usart3 isr (before)", before, count);
+    sim_print_dist("usart3 isr (after)", sim_isr_cycles, count);
+    sim_print_dist("rc task decode", sim_decode_cycles, count);
+}
+
+/*--------高优先级读者抢占写者--------*/
+
+static void sim_preempt_hook(uint32_t depth)
+{
+    RC_ctrl_t rc;
+    uint32_t k = 0;
+
+    if (depth != 0)
+    {
+        //读者中的__DMB 读者每次拷贝执行两次
+        if (++sim_reader_spin > SIM_READER_SPIN_MAX)
+        {
+            longjmp(sim_livelock, 1);
+        }
+        return;
+    }
+    if (!sim_in_task)
+    {
+        return;
+    }
+
+    sim_reader_spin = 0;
+    remote_control_read(&rc);
+    sim_preempt_count++;
+    if (sim_reader_spin > 2u)
+    {
+        sim_preempt_retry++;
+    }
+    //写者正在发布第sim_frame_k帧 读到的是上一帧或本帧
+    if (!sim_rc_match(&rc, &k) || (k != sim_frame_k && k + 1u != sim_frame_k))
+    {
+        sim_preempt_bad++;
+    }
+}
+
+static bool_t sim_preempt(void)
+{
+    sim_current = "preempt";
+    sim_preempt_count = 0;
+    sim_preempt_retry = 0;
+    sim_preempt_bad = 0;
+    sim_frame_end = sim_frame_k + SIM_PREEMPT_FRAMES;
+    sim_os_set_tick_hook(sim_rc_tick, NULL);
+
+    if (setjmp(sim_livelock) != 0)
+    {
+        sim_cpu_set_dmb_hook(NULL);
+        sim_in_task = 0;
+        fprintf(stderr, "error: preempt: reader spun %u barriers waiting for the preempted writer (frame %u)\n",
+                (unsigned)sim_reader_spin, (unsigned)sim_frame_k);
+        sim_error++;
+        return 0;
+    }
+    sim_cpu_set_dmb_hook(sim_preempt_hook);
+    sim_os_run(remote_control_task, SIM_PREEMPT_FRAMES * RC_FRAME_PERIOD_MS + 1u);
+    sim_cpu_set_dmb_hook(NULL);
+
+    printf("preempt: %u preemptions, %u retries, %u bad frames\n", (unsigned)sim_preempt_count, (unsigned)sim_preempt_retry,
+           (unsigned)sim_preempt_bad);
+    sim_check(sim_preempt_count >= SIM_PREEMPT_FRAMES, "preemptions", sim_preempt_count, SIM_PREEMPT_FRAMES);
+    sim_check(sim_preempt_retry == 0, "retries", sim_preempt_retry, 0);
+    sim_check(sim_preempt_bad == 0, "bad frames", sim_preempt_bad, 0);
+    return 1;
+}
+
+/*--------帧校验与失控保护--------*/
+
+//每个帧周期一个时隙
+static void sim_slot_tick(uint32_t now_ms, void *user)
+{
+    RC_ctrl_t rc;
+    RC_ctrl_t expect;
+    bool_t failsafe;
+
+    (void)user;
+
+    //与控制任务相同 每个周期开始时判断失控再读取
+    failsafe = remote_control_is_failsafe();
+    remote_control_read(&rc);
+    if (failsafe != sim_failsafe)
+    {
+        if (failsafe)
+        {
+            sim_failsafe_after_ms = now_ms - sim_accepted_ms;
+            sim_recover_frames = 0;
+        }
+        else
+        {
+            sim_recover_result = sim_recover_frames;
+        }
+        sim_failsafe = failsafe;
+    }
+    //校验失败的帧不发布; 失控时摇杆与键鼠清零 开关保留
+    expect = sim_accepted;
+    if (failsafe)
+    {
+        memset(expect.rc.remote_channel, 0, sizeof(expect.rc.remote_channel));
+        memset(&expect.mouse, 0, sizeof(expect.mouse));
+        expect.keyboard.value = 0;
+    }
+    if (memcmp(&rc, &expect, sizeof(RC_ctrl_t)) != 0)
+    {
+        sim_stale++;
+    }
+
+    if (sim_early_ms != 0 && now_ms == sim_early_ms)
+    {
+        sim_early_ms = 0;
+        sim_rc_expect(sim_frame_k + 1u, &rc);
+        sim_rc_send_ctrl(&rc, RC_FRAME_LENGTH);
+    }
+    if (now_ms % RC_FRAME_PERIOD_MS != 0 || sim_slot_pos >= sim_slot_num)
+    {
+        return;
+    }
+
+    //非法帧用下一帧的内容 帧号不增加
+    sim_rc_expect(sim_frame_k + 1u, &rc);
+    switch (sim_slot[sim_slot_pos++])
+    {
+    case SIM_SLOT_VALID:
+    case SIM_SLOT_EARLY:
+        sim_frame_k++;
+        sim_accepted = rc;
+        sim_accepted_ms = now_ms;
+        sim_recover_frames++;
+        sim_rc_send_ctrl(&rc, RC_FRAME_LENGTH);
+        //间隔过短的干扰帧
+        if (sim_slot[sim_slot_pos - 1u] == SIM_SLOT_EARLY)
+        {
+            sim_early_ms = now_ms + RC_FRAME_MIN_INTERVAL_MS / 2u;
+        }
+        break;
+    case SIM_SLOT_WHEEL:
+        sim_frame_k++;
+        rc.rc.remote_channel[4] = RC_CH_VALUE_RANGE + 40;
+        sim_rc_send_ctrl(&rc, RC_FRAME_LENGTH);
+        rc.rc.remote_channel[4] = 0;
+        sim_accepted = rc;
+        sim_accepted_ms = now_ms;
+        sim_recover_frames++;
+        break;
+    case SIM_SLOT_BAD_SWITCH:
+        rc.rc.switch_channel[sim_bad_num++ & 1u] = 0;
+        sim_rc_send_ctrl(&rc, RC_FRAME_LENGTH);
+        break;
+    case SIM_SLOT_BAD_CHANNEL:
+        //超出范围一个单位 正负交替
+        rc.rc.remote_channel[sim_bad_num % 4u] = (sim_bad_num & 4u) ? RC_CH_VALUE_RANGE + 1 : -RC_CH_VALUE_RANGE - 1;
+        sim_bad_num++;
+        sim_rc_send_ctrl(&rc, RC_FRAME_LENGTH);
+        break;
+    case SIM_SLOT_SHORT:
+        sim_rc_send_ctrl(&rc, RC_FRAME_LENGTH - 8u);
+        break;
+    case SIM_SLOT_LONG:
+        sim_rc_send_ctrl(&rc, RC_FRAME_LENGTH + 7u);
+        break;
+    default:
+        break;
+    }
+}
+
+//运行时隙序列 每个时隙一个帧周期
+static void sim_slot_run(const uint8_t *slot, uint32_t num)
+{
+    uint32_t start = sim_os_now();
+
+    sim_slot = slot;
+    sim_slot_num = num;
+    sim_slot_pos = 0;
+    sim_stale = 0;
+    sim_early_ms = 0;
+    sim_failsafe = remote_control_is_failsafe();
+    sim_os_set_tick_hook(sim_slot_tick, NULL);
+    //运行到下一个时隙前1ms 检查最后一帧, 下一次运行的第一个时隙与本次最后一个时隙相隔一个帧周期
+    sim_os_run(remote_control_task, RC_FRAME_PERIOD_MS - start % RC_FRAME_PERIOD_MS + num * RC_FRAME_PERIOD_MS - 1u);
+}
+
+static void sim_reject(void)
+{
+    static const uint8_t cycle[] = {SIM_SLOT_VALID, SIM_SLOT_BAD_SWITCH, SIM_SLOT_VALID, SIM_SLOT_BAD_CHANNEL,
+                                    SIM_SLOT_VALID, SIM_SLOT_SHORT, SIM_SLOT_VALID, SIM_SLOT_LONG,
+                                    SIM_SLOT_EARLY, SIM_SLOT_WHEEL};
+    static uint8_t slot[SIM_REJECT_CYCLES * sizeof(cycle)];
+    const RC_status_t *status = get_remote_control_status_point();
+    RC_status_t before = *status;
+    uint32_t i;
+
+    sim_current = "reject";
+    //前面的场景最后一帧为正常帧
+    sim_rc_expect(sim_frame_k, &sim_accepted);
+    for (i = 0; i < sizeof(slot); i++)
+    {
+        slot[i] = cycle[i % sizeof(cycle)];
+    }
+    sim_slot_run(slot, sizeof(slot));
+
+    //每轮: 开关、摇杆、间隔过短各一帧校验失败, 短帧长帧两次长度错误, 6帧有效(含波轮越界按中值接收)
+    printf("reject: %u frames, %u rejected, %u length errors, %u stale reads\n", (unsigned)(status->frame_count - before.frame_count),
+           (unsigned)(status->error_count - before.error_count), (unsigned)(status->length_error_count - before.length_error_count),
+           (unsigned)sim_stale);
+    sim_check(status->frame_count - before.frame_count == SIM_REJECT_CYCLES * 6u, "frames", status->frame_count - before.frame_count,
+              SIM_REJECT_CYCLES * 6u);
+    sim_check(status->error_count - before.error_count == SIM_REJECT_CYCLES * 3u, "error_count", status->error_count - before.error_count,
+              SIM_REJECT_CYCLES * 3u);
+    sim_check(status->length_error_count - before.length_error_count == SIM_REJECT_CYCLES * 2u, "length_error_count",
+              status->length_error_count - before.length_error_count, SIM_REJECT_CYCLES * 2u);
+    sim_check(sim_stale == 0, "stale or rejected frame read", sim_stale, 0);
+    sim_check(status->lost_count == before.lost_count && !sim_failsafe, "lost_count", status->lost_count - before.lost_count, 0);
+}
+
+static void sim_failsafe_timeout(void)
+{
+    static uint8_t slot[SIM_FAILSAFE_SLOTS];
+    const RC_status_t *status = get_remote_control_status_point();
+    RC_status_t before = *status;
+    uint32_t freeze = sim_freeze_count;
+    uint32_t short_gap = (RC_LOST_TIME_MS - 1u) / RC_FRAME_PERIOD_MS - 1u;    //不触发失控的最长连续丢帧
+    uint32_t long_gap = RC_LOST_TIME_MS / RC_FRAME_PERIOD_MS + 2u;
+    uint32_t num = 0;
+    uint32_t i;
+
+    sim_current = "failsafe";
+    //正常 -> 短时丢帧 -> 正常 -> 掉线 -> 恢复
+    memset(slot, SIM_SLOT_VALID, sizeof(slot));
+    num += 10u;
+    for (i = 0; i < short_gap; i++)
+    {
+        slot[num++] = SIM_SLOT_GAP;
+    }
+    num += 10u;
+    for (i = 0; i < long_gap; i++)
+    {
+        slot[num++] = SIM_SLOT_GAP;
+    }
+    num += 10u;
+    sim_recover_result = 0;
+    sim_failsafe_after_ms = 0;
+    sim_slot_run(slot, num);
+
+    printf("failsafe: after %u ms gap, %u missed, %u frames to recover\n", (unsigned)sim_failsafe_after_ms,
+           (unsigned)(status->missed_count - before.missed_count), (unsigned)sim_recover_result);
+    sim_check(status->lost_count - before.lost_count == 1u, "lost_count", status->lost_count - before.lost_count, 1);
+    sim_check(sim_failsafe_after_ms == RC_LOST_TIME_MS + 1u, "failsafe after ms", sim_failsafe_after_ms, RC_LOST_TIME_MS + 1u);
+    sim_check(sim_recover_result == RC_RECOVER_FRAME_NUM, "frames to recover", sim_recover_result, RC_RECOVER_FRAME_NUM);
+    sim_check(!sim_failsafe, "failsafe at end", sim_failsafe, 0);
+    sim_check(status->missed_count - before.missed_count == short_gap + long_gap, "missed_count", status->missed_count - before.missed_count,
+              short_gap + long_gap);
+    sim_check(sim_stale == 0, "stale or not cleared frame read", sim_stale, 0);
+#if RC_LOST_FREEZE_BLACKBOX
+    sim_check(sim_freeze_count - freeze == 1u, "blackbox freeze", sim_freeze_count - freeze, 1);
+#else
+    (void)freeze;
+#endif
+}
+
+/*--------多线程并发--------*/
+
+static void *sim_writer_thread(void *arg)
+{
+    (void)arg;
+    remote_control_task(NULL);
+    return NULL;
+}
+
+static void *sim_reader_thread(void *arg)
+{
+    sim_reader_t *reader = (sim_reader_t *)arg;
+    RC_ctrl_t rc;
+    uint32_t k;
+
+    while (!sim_stop)
+    {
+        remote_control_read(&rc);
+        reader->reads++;
+        if (!sim_rc_match(&rc, &k))
+        {
+            reader->torn++;
+        }
+        else if (k != 0)
+        {
+            if (k < reader->last_k)
+            {
+                reader->backward++;
+            }
+            reader->last_k = k;
+        }
+    }
+    return NULL;
+}
+
+static void sim_concurrent(void)
+{
+    static sim_reader_t reader[SIM_READER_NUM];
+    const RC_status_t *status = get_remote_control_status_point();
+    pthread_t writer;
+    uint32_t frames = status->frame_count;
+    uint32_t first = sim_frame_k;
+    uint32_t reads = 0;
+    uint32_t torn = 0;
+    uint32_t backward = 0;
+    uint32_t i;
+
+    sim_current = "concurrent";
+    sim_os_set_tick_hook(NULL, NULL);
+    sim_threaded = 1;
+    sim_stop = 0;
+    sim_task_started = 0;
+    sim_notify = 0;
+
+    pthread_create(&writer, NULL, sim_writer_thread, NULL);
+    for (i = 0; i < SIM_READER_NUM; i++)
+    {
+        memset(&reader[i], 0, sizeof(sim_reader_t));
+        pthread_create(&reader[i].thread, NULL, sim_reader_thread, &reader[i]);
+    }
+    while (!sim_task_started)
+    {
+        sched_yield();
+    }
+
+    //中断线程 上一帧解析完成后再发送下一帧(目标板上帧间隔14ms远大于解析时间)
+    for (i = 1; i <= SIM_CONCURRENT_FRAMES; i++)
+    {
+        osDelay(RC_FRAME_PERIOD_MS);
+        sim_frame_k = first + i;
+        sim_rc_send(sim_frame_k);
+        while (status->frame_count - frames < i)
+        {
+            sched_yield();
+        }
+    }
+
+    pthread_mutex_lock(&sim_notify_mutex);
+    sim_stop = 1;
+    pthread_cond_signal(&sim_notify_cond);
+    pthread_mutex_unlock(&sim_notify_mutex);
+    pthread_join(writer, NULL);
+    for (i = 0; i < SIM_READER_NUM; i++)
+    {
+        pthread_join(reader[i].thread, NULL);
+        reads += reader[i].reads;
+        torn += reader[i].torn;
+        backward += reader[i].backward;
+    }
+    sim_threaded = 0;
+
+    printf("concurrent: %u frames, %u reads by %u readers, %u torn, %u backward\n", (unsigned)(status->frame_count - frames),
+           (unsigned)reads, (unsigned)SIM_READER_NUM, (unsigned)torn, (unsigned)backward);
+    sim_check(status->frame_count - frames == SIM_CONCURRENT_FRAMES, "frames", status->frame_count - frames, SIM_CONCURRENT_FRAMES);
+    sim_check(reads != 0, "reads", reads, 1);
+    sim_check(torn == 0, "torn frames", torn, 0);
+    sim_check(backward == 0, "backward frames", backward, 0);
+}
+
+int main(void)
+{
+    sim_os_init();
+    sim_usart_init(&sim_port, &huart3, &hdma_usart3_rx, &hdma_usart3_tx, sim_usart_irq, sim_dma_irq, NULL);
+    remote_control_init();
+
+    sim_isr();
+    //读者死循环时遥控器任务停在发布中途 后续测试无意义
+    if (sim_preempt())
+    {
+        sim_reject();
+        sim_failsafe_timeout();
+        sim_concurrent();
+    }
+
+    if (sim_error != 0)
+    {
+        fprintf(stderr, "rc_sim: %u errors\n", (unsigned)sim_error);
+        return 1;
+    }
+    printf("rc_sim: ok\n");
+    return 0;
+}
@@ -0,0 +1,571 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       referee_bench.c
+  * @brief      裁判系统协议解析上位机模糊测试与吞吐量基准，运行未修改的referee.c与crc.c，
+  *             数据按随机长度分段写入与固件相同长度的环形缓冲区(模拟DMA循环接收)后解析，
+  *             检查每一帧完整的数据都被解析、损坏的数据不被接受、错误计数与注入的错误一致。
+  * @note       吞吐量为本机数值，只用于比较改动前后；目标板115200波特率约0.0115MB/s。
+  *             检查失败时返回1, make bench时运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: referee_bench [模糊测试帧数]
+    测试:
+      crc        CRC8/CRC16 "123456789"校验值
+      wrap       单帧放在环形缓冲区每个起始位置(读指针接近uint32溢出)
+      valid      正确的数据流 随机分段写入 逐字节写入 检查每个命令的帧数与最后一帧数据
+      corrupt    帧间插入垃圾与假SOF 单比特翻转 截断 长度超限 检查只接受完整的帧
+      random     随机字节(SOF比例较高) 不接受任何帧 不会停止消耗
+      throughput 典型数据流(功率热量为主)的解析速度 与CRC16单独计算的速度 MB/s
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#define _POSIX_C_SOURCE 199309L //clock_gettime
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "config_freame.h"
+#include "crc.h"
+#include "referee.h"
+
+#define BENCH_RING_LEN          CONFIG_REFEREE_RX_BUF_LEN
+#define BENCH_DEFAULT_FRAMES    20000u
+#define BENCH_CHUNK_MAX         64u         //每次写入的最大字节数 约DMA一次空闲中断的数据量
+#define BENCH_RANDOM_BYTES      (1u << 20)
+#define BENCH_THROUGHPUT_BYTES  (16u << 20)
+#define BENCH_UNKNOWN_CMD_ID    0x0301      //不解析的命令(机器人交互数据)
+#define BENCH_FRAME_MAX_LEN     REFEREE_FRAME_LEN(REFEREE_DATA_MAX_LEN)
+
+/*注入的错误*/
+typedef enum
+{
+    BENCH_FAULT_NONE = 0,
+    BENCH_FAULT_GARBAGE,        //帧前插入不含SOF的字节
+    BENCH_FAULT_FAKE_SOF,       //帧前插入SOF与随机字节
+    BENCH_FAULT_HEADER_FLIP,    //帧头(含CRC8)翻转一位
+    BENCH_FAULT_BODY_FLIP,      //命令码、数据或CRC16翻转一位
+    BENCH_FAULT_TRUNCATE,       //只发送帧的前一部分
+    BENCH_FAULT_LENGTH,         //帧头长度超过REFEREE_DATA_MAX_LEN(CRC8正确)
+    BENCH_FAULT_NUM,
+} bench_fault_e;
+
+/*期望结果*/
+typedef struct
+{
+    uint32_t frames;                        //完整的帧
+    uint32_t update_count[REFEREE_CMD_NUM];
+    uint32_t unknown_cmd;
+    uint32_t size_error;
+    uint32_t fault[BENCH_FAULT_NUM];
+    uint8_t last[REFEREE_CMD_NUM][REFEREE_DATA_MAX_LEN];   //每个命令最后一帧完整数据
+} bench_expect_t;
+
+/*模拟DMA循环接收*/
+typedef struct
+{
+    uint8_t buf[BENCH_RING_LEN];
+    uint32_t write_count;
+    uint32_t read_count;
+} bench_ring_t;
+
+static const uint16_t bench_cmd_id[REFEREE_CMD_NUM] =
+{
+    REFEREE_GAME_STATUS_CMD_ID, REFEREE_GAME_ROBOT_HP_CMD_ID, REFEREE_ROBOT_STATUS_CMD_ID,
+    REFEREE_POWER_HEAT_CMD_ID, REFEREE_HURT_DATA_CMD_ID, REFEREE_SHOOT_DATA_CMD_ID,
+};
+static const uint16_t bench_cmd_size[REFEREE_CMD_NUM] =
+{
+    sizeof(referee_game_status_t), sizeof(referee_game_robot_HP_t), sizeof(referee_robot_status_t),
+    sizeof(referee_power_heat_t), sizeof(referee_hurt_data_t), sizeof(referee_shoot_data_t),
+};
+
+static uint32_t bench_seed = 0x12345678u;
+static uint32_t bench_error;
+
+static uint32_t bench_rand(void)
+{
+    //xorshift32 固定种子 结果可复现
+    bench_seed ^= bench_seed << 13;
+    bench_seed ^= bench_seed >> 17;
+    bench_seed ^= bench_seed << 5;
+    return bench_seed;
+}
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_check(int ok, const char *what, uint32_t value, uint32_t expect)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "error: %s %u, expect %u\n", what, (unsigned)value, (unsigned)expect);
+        bench_error++;
+    }
+}
+
+static const uint8_t *bench_cmd_data(const referee_t *ref, uint8_t cmd)
+{
+    const referee_data_t *d = &ref->data;
+    const void *p[REFEREE_CMD_NUM] =
+    {
+        &d->game_status, &d->game_robot_HP, &d->robot_status, &d->power_heat, &d->hurt_data, &d->shoot_data,
+    };
+    return p[cmd];
+}
+
+//组一帧 返回帧长
+static uint16_t bench_build_frame(uint8_t *frame, uint16_t cmd_id, const uint8_t *data, uint16_t data_len, uint8_t seq)
+{
+    uint16_t frame_len = (uint16_t)REFEREE_FRAME_LEN(data_len);
+
+    frame[0] = REFEREE_SOF;
+    frame[1] = (uint8_t)(data_len & 0xFF);
+    frame[2] = (uint8_t)(data_len >> 8);
+    frame[3] = seq;
+    append_CRC8_check_sum(frame, REFEREE_HEADER_LEN);
+    frame[5] = (uint8_t)(cmd_id & 0xFF);
+    frame[6] = (uint8_t)(cmd_id >> 8);
+    memcpy(&frame[REFEREE_HEADER_LEN + REFEREE_CMD_ID_LEN], data, data_len);
+    append_CRC16_check_sum(frame, frame_len);
+    return frame_len;
+}
+
+//随机选择命令与数据长度 index为REFEREE_CMD_NUM时为不解析的命令
+static uint16_t bench_random_frame(uint8_t *frame, uint8_t *index, uint16_t *data_len, uint8_t seq)
+{
+    uint8_t data[REFEREE_DATA_MAX_LEN];
+    uint32_t r = bench_rand() % 100u;
+    uint16_t cmd_id;
+    uint16_t len;
+    uint16_t i;
+
+    if (r < 5u)
+    {
+        *index = REFEREE_CMD_NUM;
+        cmd_id = BENCH_UNKNOWN_CMD_ID;
+        len = (uint16_t)(bench_rand() % (REFEREE_DATA_MAX_LEN + 1u));
+    }
+    else
+    {
+        *index = (uint8_t)(bench_rand() % REFEREE_CMD_NUM);
+        cmd_id = bench_cmd_id[*index];
+        len = bench_cmd_size[*index];
+        if (r < 10u)
+        {
+            len = (uint16_t)(bench_rand() % len);   //比结构体短 不更新
+        }
+        else if (r < 15u)
+        {
+            len += (uint16_t)(bench_rand() % (REFEREE_DATA_MAX_LEN - len + 1u)); //新版本协议增加的字段
+        }
+    }
+    for (i = 0; i < len; i++)
+    {
+        data[i] = (uint8_t)bench_rand();
+    }
+    *data_len = len;
+    return bench_build_frame(frame, cmd_id, data, len, seq);
+}
+
+//记录一帧完整数据的期望结果
+static void bench_expect_frame(bench_expect_t *expect, const uint8_t *frame, uint8_t index, uint16_t data_len)
+{
+    expect->frames++;
+    if (index == REFEREE_CMD_NUM)
+    {
+        expect->unknown_cmd++;
+    }
+    else if (data_len < bench_cmd_size[index])
+    {
+        expect->size_error++;
+    }
+    else
+    {
+        expect->update_count[index]++;
+        memcpy(expect->last[index], &frame[REFEREE_HEADER_LEN + REFEREE_CMD_ID_LEN], bench_cmd_size[index]);
+    }
+}
+
+//按随机长度分段写入环形缓冲区并解析 chunk_max为1时逐字节
+static void bench_feed(referee_t *ref, bench_ring_t *ring, const uint8_t *data, uint32_t len, uint32_t chunk_max)
+{
+    uint32_t n;
+    uint32_t i;
+    uint16_t unread;
+    uint16_t used;
+
+    while (len != 0 || ring->write_count != ring->read_count)
+    {
+        //写入 不覆盖未读数据
+        n = (chunk_max == 1u) ? 1u : 1u + bench_rand() % chunk_max;
+        if (n > len)
+        {
+            n = len;
+        }
+        if (n > BENCH_RING_LEN - (ring->write_count - ring->read_count))
+        {
+            n = BENCH_RING_LEN - (ring->write_count - ring->read_count);
+        }
+        for (i = 0; i < n; i++)
+        {
+            ring->buf[(ring->write_count + i) & (BENCH_RING_LEN - 1u)] = data[i];
+        }
+        ring->write_count += n;
+        data += n;
+        len -= n;
+
+        unread = (uint16_t)(ring->write_count - ring->read_count);
+        used = referee_unpack(ref, ring->buf, BENCH_RING_LEN, ring->read_count, unread);
+        if (used > unread)
+        {
+            bench_check(0, "consumed more than unread", used, unread);
+            return;
+        }
+        ring->read_count += used;
+
+        //数据已全部写入 剩余不足一帧的字节等待后续数据
+        if (len == 0 && used == 0)
+        {
+            break;
+        }
+        //缓冲区满且没有消耗 解析器停止
+        if (n == 0 && used == 0)
+        {
+            bench_check(0, "parser stalled with full ring", unread, BENCH_RING_LEN);
+            return;
+        }
+    }
+}
+
+static void bench_compare(const char *name, const referee_t *ref, const bench_expect_t *expect)
+{
+    char what[64];
+    uint8_t i;
+
+    bench_check(ref->frame_count == expect->frames, name, ref->frame_count, expect->frames);
+    bench_check(ref->unknown_cmd == expect->unknown_cmd, "unknown cmd", ref->unknown_cmd, expect->unknown_cmd);
+    bench_check(ref->size_error == expect->size_error, "size error", ref->size_error, expect->size_error);
+    for (i = 0; i < REFEREE_CMD_NUM; i++)
+    {
+        snprintf(what, sizeof(what), "%s cmd 0x%04X count", name, bench_cmd_id[i]);
+        bench_check(ref->update_count[i] == expect->update_count[i], what, ref->update_count[i], expect->update_count[i]);
+        if (expect->update_count[i] != 0)
+        {
+            snprintf(what, sizeof(what), "%s cmd 0x%04X last data", name, bench_cmd_id[i]);
+            bench_check(memcmp(bench_cmd_data(ref, i), expect->last[i], bench_cmd_size[i]) == 0, what, 0, 0);
+        }
+    }
+}
+
+static void bench_test_crc(void)
+{
+    const uint8_t check[] = "123456789";
+    uint8_t data[16];
+
+    bench_check(get_CRC8_check_sum(check, 9, CRC8_INIT) == 0x0B, "crc8 check value", get_CRC8_check_sum(check, 9, CRC8_INIT), 0x0B);
+    bench_check(get_CRC16_check_sum(check, 9, CRC16_INIT) == 0x6F91, "crc16 check value", get_CRC16_check_sum(check, 9, CRC16_INIT), 0x6F91);
+    //分段计算与一次计算相同
+    bench_check(get_CRC8_check_sum(check + 4, 5, get_CRC8_check_sum(check, 4, CRC8_INIT)) == 0x0B, "crc8 chained", 0, 0x0B);
+    memcpy(data, check, 9);
+    append_CRC8_check_sum(data, 10);
+    bench_check(verify_CRC8_check_sum(data, 10), "crc8 verify", data[9], 0x0B);
+    data[3] ^= 0x10;
+    bench_check(!verify_CRC8_check_sum(data, 10), "crc8 detects flip", data[9], 0x0B);
+    printf("crc        CRC8 0x%02X CRC16 0x%04X\n", get_CRC8_check_sum(check, 9, CRC8_INIT), get_CRC16_check_sum(check, 9, CRC16_INIT));
+}
+
+//单帧放在每个起始位置 读指针接近uint32溢出
+static void bench_test_wrap(void)
+{
+    static referee_t ref;
+    uint8_t ring[BENCH_RING_LEN];
+    uint8_t frame[BENCH_FRAME_MAX_LEN];
+    uint8_t data[sizeof(referee_game_robot_HP_t)];
+    uint32_t read_count;
+    uint16_t frame_len;
+    uint16_t used;
+    uint32_t ok = 0;
+    uint32_t offset;
+    uint16_t i;
+
+    for (offset = 0; offset < BENCH_RING_LEN; offset++)
+    {
+        for (i = 0; i < sizeof(data); i++)
+        {
+            data[i] = (uint8_t)bench_rand();
+        }
+        frame_len = bench_build_frame(frame, REFEREE_GAME_ROBOT_HP_CMD_ID, data, sizeof(data), (uint8_t)offset);
+        read_count = 0xFFFFFF00u + offset;
+        for (i = 0; i < frame_len; i++)
+        {
+            ring[(read_count + i) & (BENCH_RING_LEN - 1u)] = frame[i];
+        }
+        referee_init(&ref);
+        used = referee_unpack(&ref, ring, BENCH_RING_LEN, read_count, frame_len);
+        if (used == frame_len && ref.frame_count == 1 && memcmp(&ref.data.game_robot_HP, data, sizeof(data)) == 0)
+        {
+            ok++;
+        }
+    }
+    printf("wrap       %u/%u start offsets\n", (unsigned)ok, BENCH_RING_LEN);
+    bench_check(ok == BENCH_RING_LEN, "wrap offsets", ok, BENCH_RING_LEN);
+}
+
+//正确的数据流
+static void bench_test_valid(uint32_t frames)
+{
+    static referee_t ref;
+    static bench_expect_t expect;
+    static bench_ring_t ring;
+    uint8_t *stream = malloc((size_t)frames * BENCH_FRAME_MAX_LEN);
+    uint32_t len = 0;
+    uint32_t i;
+    uint8_t index;
+    uint16_t data_len;
+    uint8_t pass;
+
+    memset(&expect, 0, sizeof(expect));
+    for (i = 0; i < frames; i++)
+    {
+        uint16_t frame_len = bench_random_frame(&stream[len], &index, &data_len, (uint8_t)i);
+        bench_expect_frame(&expect, &stream[len], index, data_len);
+        len += frame_len;
+    }
+
+    //随机分段与逐字节写入 结果相同
+    for (pass = 0; pass < 2; pass++)
+    {
+        referee_init(&ref);
+        memset(&ring, 0, sizeof(ring));
+        ring.read_count = ring.write_count = 0xFFFFF000u;
+        bench_feed(&ref, &ring, stream, len, pass == 0 ? BENCH_CHUNK_MAX : 1u);
+        printf("valid      %s %u frames %u bytes, unknown %u, short %u, skipped %u, errors %u/%u/%u\n",
+               pass == 0 ? "chunks" : "bytes ", (unsigned)ref.frame_count, (unsigned)len, (unsigned)ref.unknown_cmd,
+               (unsigned)ref.size_error, (unsigned)ref.skip_bytes, (unsigned)ref.header_error,
+               (unsigned)ref.length_error, (unsigned)ref.crc16_error);
+        bench_compare("valid frames", &ref, &expect);
+        bench_check(ref.skip_bytes == 0, "valid skipped bytes", ref.skip_bytes, 0);
+        bench_check(ref.header_error == 0 && ref.length_error == 0 && ref.crc16_error == 0, "valid errors",
+                    ref.header_error + ref.length_error + ref.crc16_error, 0);
+        bench_check(ring.read_count == ring.write_count, "valid unread bytes", ring.write_count - ring.read_count, 0);
+    }
+    free(stream);
+}
+
+//注入错误的数据流 只有完整的帧被接受
+static void bench_test_corrupt(uint32_t frames)
+{
+    static referee_t ref;
+    static bench_expect_t expect;
+    static bench_ring_t ring;
+    static const char *const fault_name[BENCH_FAULT_NUM] =
+    {
+        "none", "garbage", "fake_sof", "header_flip", "body_flip", "truncate", "length",
+    };
+    uint8_t *stream = malloc((size_t)frames * (BENCH_FRAME_MAX_LEN + 32u));
+    uint8_t frame[BENCH_FRAME_MAX_LEN];
+    uint32_t len = 0;
+    uint32_t i;
+    uint32_t n;
+    uint32_t bit;
+    uint8_t index;
+    uint16_t data_len;
+    uint16_t frame_len;
+    bench_fault_e fault;
+
+    memset(&expect, 0, sizeof(expect));
+    for (i = 0; i < frames; i++)
+    {
+        frame_len = bench_random_frame(frame, &index, &data_len, (uint8_t)i);
+        fault = (bench_rand() % 3u == 0) ? (bench_fault_e)(1u + bench_rand() % (BENCH_FAULT_NUM - 1u)) : BENCH_FAULT_NONE;
+        expect.fault[fault]++;
+
+        switch (fault)
+        {
+        case BENCH_FAULT_GARBAGE:
+            for (n = 1u + bench_rand() % 32u; n != 0; n--)
+            {
+                uint8_t b = (uint8_t)bench_rand();
+                stream[len++] = (b == REFEREE_SOF) ? 0x00 : b;
+            }
+            break;
+        case BENCH_FAULT_FAKE_SOF:
+            stream[len++] = REFEREE_SOF;
+            for (n = bench_rand() % 8u; n != 0; n--)
+            {
+                stream[len++] = (uint8_t)bench_rand();
+            }
+            break;
+        case BENCH_FAULT_HEADER_FLIP:
+            bit = bench_rand() % (REFEREE_HEADER_LEN * 8u);
+            frame[bit / 8u] ^= (uint8_t)(1u << (bit % 8u));
+            break;
+        case BENCH_FAULT_BODY_FLIP:
+            bit = REFEREE_HEADER_LEN * 8u + bench_rand() % ((frame_len - REFEREE_HEADER_LEN) * 8u);
+            frame[bit / 8u] ^= (uint8_t)(1u << (bit % 8u));
+            break;
+        case BENCH_FAULT_TRUNCATE:
+            frame_len = (uint16_t)(1u + bench_rand() % (frame_len - 1u));
+            break;
+        case BENCH_FAULT_LENGTH:
+            n = REFEREE_DATA_MAX_LEN + 1u + bench_rand() % 1000u;
+            frame[1] = (uint8_t)(n & 0xFF);
+            frame[2] = (uint8_t)(n >> 8);
+            append_CRC8_check_sum(frame, REFEREE_HEADER_LEN);
+            break;
+        default:
+            break;
+        }
+
+        memcpy(&stream[len], frame, frame_len);
+        //帧前插入的字节不影响这一帧
+        if (fault == BENCH_FAULT_NONE || fault == BENCH_FAULT_GARBAGE || fault == BENCH_FAULT_FAKE_SOF)
+        {
+            bench_expect_frame(&expect, &stream[len], index, data_len);
+        }
+        len += frame_len;
+    }
+
+    referee_init(&ref);
+    memset(&ring, 0, sizeof(ring));
+    bench_feed(&ref, &ring, stream, len, BENCH_CHUNK_MAX);
+
+    printf("corrupt    %u/%u frames intact, faults", (unsigned)ref.frame_count, (unsigned)frames);
+    for (i = 1; i < BENCH_FAULT_NUM; i++)
+    {
+        printf(" %s %u", fault_name[i], (unsigned)expect.fault[i]);
+    }
+    printf("\n           skipped %u bytes, header crc %u, length %u, crc16 %u\n", (unsigned)ref.skip_bytes,
+           (unsigned)ref.header_error, (unsigned)ref.length_error, (unsigned)ref.crc16_error);
+    bench_compare("intact frames", &ref, &expect);
+    //每种错误都被对应的计数发现
+    bench_check(ref.header_error >= expect.fault[BENCH_FAULT_HEADER_FLIP], "header crc errors", ref.header_error, expect.fault[BENCH_FAULT_HEADER_FLIP]);
+    bench_check(ref.length_error >= expect.fault[BENCH_FAULT_LENGTH], "length errors", ref.length_error, expect.fault[BENCH_FAULT_LENGTH]);
+    bench_check(ref.crc16_error >= expect.fault[BENCH_FAULT_BODY_FLIP], "crc16 errors", ref.crc16_error, expect.fault[BENCH_FAULT_BODY_FLIP]);
+    bench_check(ring.write_count - ring.read_count < BENCH_FRAME_MAX_LEN, "corrupt unread bytes", ring.write_count - ring.read_count, BENCH_FRAME_MAX_LEN);
+    free(stream);
+}
+
+//随机字节 不接受任何帧
+static void bench_test_random(void)
+{
+    static referee_t ref;
+    static bench_ring_t ring;
+    uint8_t *stream = malloc(BENCH_RANDOM_BYTES);
+    uint32_t i;
+
+    for (i = 0; i < BENCH_RANDOM_BYTES; i++)
+    {
+        stream[i] = (bench_rand() % 8u == 0) ? REFEREE_SOF : (uint8_t)bench_rand();
+    }
+    referee_init(&ref);
+    bench_feed(&ref, &ring, stream, BENCH_RANDOM_BYTES, BENCH_CHUNK_MAX);
+
+    printf("random     %u bytes, %u frames accepted, skipped %u, header crc %u, length %u, crc16 %u\n",
+           BENCH_RANDOM_BYTES, (unsigned)ref.frame_count, (unsigned)ref.skip_bytes, (unsigned)ref.header_error,
+           (unsigned)ref.length_error, (unsigned)ref.crc16_error);
+    bench_check(ref.frame_count == 0, "random frames accepted", ref.frame_count, 0);
+    bench_check(ring.write_count - ring.read_count < BENCH_FRAME_MAX_LEN, "random unread bytes", ring.write_count - ring.read_count, BENCH_FRAME_MAX_LEN);
+    free(stream);
+}
+
+//典型数据流: 功率热量50Hz 机器人状态10Hz 血量3Hz 比赛状态1Hz 射击数据约10Hz
+static void bench_test_throughput(void)
+{
+    static referee_t ref;
+    static bench_ring_t ring;
+    uint8_t *stream = malloc(BENCH_THROUGHPUT_BYTES + BENCH_FRAME_MAX_LEN);
+    uint8_t data[REFEREE_DATA_MAX_LEN];
+    uint32_t len = 0;
+    uint32_t frames = 0;
+    uint32_t r;
+    uint32_t i;
+    uint8_t index;
+    uint16_t crc16 = CRC16_INIT;
+    uint64_t start;
+    fp64 parse_s;
+    fp64 crc_s;
+
+    while (len < BENCH_THROUGHPUT_BYTES)
+    {
+        r = bench_rand() % 74u;
+        index = (r < 50u) ? REFEREE_CMD_POWER_HEAT : (r < 60u) ? REFEREE_CMD_ROBOT_STATUS : (r < 70u) ? REFEREE_CMD_SHOOT_DATA :
+                (r < 73u) ? REFEREE_CMD_GAME_ROBOT_HP : REFEREE_CMD_GAME_STATUS;
+        for (i = 0; i < bench_cmd_size[index]; i++)
+        {
+            data[i] = (uint8_t)bench_rand();
+        }
+        len += bench_build_frame(&stream[len], bench_cmd_id[index], data, bench_cmd_size[index], (uint8_t)frames);
+        frames++;
+    }
+
+    //DMA每次写入半个缓冲区 写入后立即解析
+    referee_init(&ref);
+    start = bench_now_ns();
+    for (i = 0; i < len; )
+    {
+        uint32_t n = len - i < BENCH_RING_LEN / 2u ? len - i : BENCH_RING_LEN / 2u;
+        uint32_t k;
+        for (k = 0; k < n; k++)
+        {
+            ring.buf[(ring.write_count + k) & (BENCH_RING_LEN - 1u)] = stream[i + k];
+        }
+        ring.write_count += n;
+        i += n;
+        ring.read_count += referee_unpack(&ref, ring.buf, BENCH_RING_LEN, ring.read_count, (uint16_t)(ring.write_count - ring.read_count));
+    }
+    parse_s = (bench_now_ns() - start) * 1e-9;
+
+    start = bench_now_ns();
+    for (i = 0; i < len; i += 4096u)
+    {
+        crc16 = get_CRC16_check_sum(&stream[i], len - i < 4096u ? len - i : 4096u, crc16);
+    }
+    crc_s = (bench_now_ns() - start) * 1e-9;
+
+    printf("throughput %u frames %.1f MB: parse %.1f MB/s (incl. ring copy), CRC16 alone %.1f MB/s, %.0fx link rate (crc %04X)\n",
+           (unsigned)frames, len / 1048576.0, len / 1048576.0 / parse_s, len / 1048576.0 / crc_s,
+           len / parse_s / 11520.0, crc16);
+    bench_check(ref.frame_count == frames, "throughput frames", ref.frame_count, frames);
+    free(stream);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t frames = BENCH_DEFAULT_FRAMES;
+
+    if (argc == 2)
+    {
+        frames = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    else if (argc != 1)
+    {
+        fprintf(stderr, "usage: %s [frames]\n", argv[0]);
+        return 2;
+    }
+
+    bench_test_crc();
+    bench_test_wrap();
+    bench_test_valid(frames);
+    bench_test_corrupt(frames);
+    bench_test_random();
+    bench_test_throughput();
+
+    if (bench_error != 0)
+    {
+        fprintf(stderr, "referee_bench: %u errors\n", (unsigned)bench_error);
+        return 1;
+    }
+    printf("referee_bench: ok\n");
+    return 0;
+}
@@ -0,0 +1,476 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       shoot_sim.c
+  * @brief      发射任务上位机闭环仿真，CAN2上拨弹M2006(0x207)与两个摩擦轮M3508(0x201、0x202)模型，
+  *             运行未修改的shoot_task，检查摩擦轮启动、单发/点射/连发的发数、卡弹检测与反转恢复、
+  *             热量限制下的射频、裁判系统在线时按裁判系统的热量上限与冷却值限制、遥控器下档无力。
+  * @note       云台任务不运行: 仿真每2ms按云台任务的方式发送0x1FF帧，拨弹电流取get_shoot_trigger_current。
+  *             拨弹盘每转过一格的中点记为实际发射一发，摩擦轮转速下降一次；
+  *             卡弹为拨弹盘前方的刚性挡块，拨弹盘反转离开挡块后消失。
+  *             实际热量按实际发射数与冷却值计算，与裁判系统的计算方式相同(连续冷却)。
+  *             裁判系统任务不运行: 仿真每20ms直接发布referee话题(机器人状态与枪口热量)，
+  *             帧解析由referee_bench测试。
+  *             检查失败时返回1, make bench时运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *  V1.1.0     Oct-19-2026     ICBK            2. 裁判系统热量上限与枪口热量
+  *
+  @verbatim
+  ==============================================================================
+    用法: shoot_sim [-o out.csv]
+    过程(ms):
+      200   左开关中档 摩擦轮启动
+      1500  单发 上档两次                   2300  点射 上档一次 鼠标左键一次
+      3400  连发 上档1s                     5000  连发 5300拨弹盘前方出现卡弹 6500停止
+      7000  连发5s 热量到达上限后射频下降
+      12500 裁判系统上线 热量上限与冷却值改为裁判系统的值, 实际热量增加(本地没有计入的弹丸)
+      13000 连发5s 按裁判系统的上限与冷却值限制   18000 裁判系统离线   18500 左开关下档
+    CSV列: t_ms, mode, trig_set, trig_angle(rad), trig_out, fric1_rpm, fric2_rpm, heat, shots, jam
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "config_freame.h"
+#include "CAN_receive.h"
+#include "param.h"
+#include "shoot_task.h"
+#include "sim_os.h"
+#include "sim_can.h"
+#include "sim_rc.h"
+#include "sim_flash.h"
+#include "sim_scenario.h"
+
+#define SIM_PI                      3.14159265f
+#define SIM_DEG                     0.01745329f
+#define SIM_BUS_VOLTAGE             24.0f
+#define SIM_DURATION_MS             19000u
+
+/*负载 折算到转子侧前的数值*/
+#define SIM_TRIGGER_INERTIA         5.0e-4f     //拨弹盘与弹丸 kg·m²
+#define SIM_TRIGGER_FEED_TORQUE     0.1f        //推弹阻力 N·m
+#define SIM_FRIC_LOAD_INERTIA       1.0e-5f     //摩擦轮 折算到转子侧 kg·m²
+#define SIM_FRIC_SHOT_DROP          0.97f       //每发弹丸后摩擦轮转速比例
+#define SIM_JAM_STIFFNESS           50.0f       //卡弹挡块 N·m/rad
+#define SIM_JAM_DAMPING             0.2f        //N·m·s/rad
+#define SIM_JAM_CLEAR_DEG           10.0f       //拨弹盘退回挡块后该角度 卡弹消失
+
+/*过程*/
+#define SIM_FRIC_START_MS           200u
+#define SIM_MODE_BURST_MS           2300u
+#define SIM_MODE_AUTO_MS            3400u
+#define SIM_SINGLE_START_MS         1500u
+#define SIM_AUTO_START_MS           3500u
+#define SIM_AUTO_STOP_MS            4500u
+#define SIM_JAM_START_MS            5000u
+#define SIM_JAM_ARM_MS              5300u
+#define SIM_JAM_STOP_MS             6500u
+#define SIM_HEAT_START_MS           7000u
+#define SIM_HEAT_WINDOW_MS          10000u      //热量受限后统计射频的起点
+#define SIM_HEAT_STOP_MS            12000u
+#define SIM_REFEREE_START_MS        12500u
+#define SIM_REFEREE_WINDOW_MS       16000u      //裁判系统热量受限后统计射频的起点
+#define SIM_REFEREE_CHECK_MS        17000u
+#define SIM_REFEREE_STOP_MS         18000u
+#define SIM_DISABLE_MS              18500u
+
+/*裁判系统 与参数默认值不同*/
+#define SIM_REFEREE_PERIOD_MS       20u
+#define SIM_REFEREE_HEAT_LIMIT      100
+#define SIM_REFEREE_COOLING_RATE    60
+#define SIM_REFEREE_HEAT_JUMP       50.0f       //上线时实际热量增加
+
+/*检查门限*/
+#define SIM_FRIC_READY_MAX_MS       1200u
+#define SIM_SINGLE_SHOTS            2u
+#define SIM_BURST_SHOTS             (2u * CONFIG_SHOOT_BURST_NUM)
+#define SIM_JAM_DETECT_MAX_MS       (CONFIG_SHOOT_JAM_TIME_MS + 100u)  //拨弹盘停止到开始反转
+#define SIM_HEAT_RATE_TOLERANCE     1u          //热量受限后2s内发数与冷却值允许发数的差
+
+//仿真开关与鼠标 射击模式由参数切换
+static const char *const sim_scenario_text[] =
+{
+    "0     sw0=mid sw1=down",
+    "200   sw1=mid",
+    "1500  sw1=up",
+    "1700  sw1=mid",
+    "1900  sw1=up",
+    "2100  sw1=mid",
+    "2500  sw1=up",
+    "2700  sw1=mid",
+    "2900  ml=1",
+    "3100  ml=0",
+    "3500  sw1=up",
+    "4500  sw1=mid",
+    "5000  sw1=up",
+    "6500  sw1=mid",
+    "7000  sw1=up",
+    "12000 sw1=mid",
+    "13000 sw1=up",
+    "18000 sw1=mid",
+    "18500 sw1=down",
+};
+
+extern shoot_control_t shoot_control_data;
+
+//裁判系统任务不链接 话题由仿真定义与发布
+MSG_BUS_TOPIC_DEFINE(referee, referee_msg_t, 1, 1);
+
+static sim_scenario_t sim_scenario_data;
+static sim_can_node_t *sim_trigger_node;
+static sim_can_node_t *sim_fric_node[2];
+static FILE *sim_csv;
+
+static int32_t sim_shot_slot;       //实际发射的最后一格
+static uint32_t sim_shots;          //实际发射数
+static fp32 sim_heat;               //按实际发射计算的热量
+static fp32 sim_heat_max;          //参数热量上限阶段的最大值
+static fp32 sim_cooling_rate = CONFIG_SHOOT_COOLING_RATE;
+
+static bool_t sim_referee_on;       //发布referee话题
+static fp32 sim_referee_heat_max;   //裁判系统热量受限阶段的最大值
+static uint32_t sim_referee_window_shots;
+static int32_t sim_referee_heat_limit;  //发射任务使用的热量上限 在线时与离线后
+static int32_t sim_offline_heat_limit;
+static bool_t sim_offline;
+
+static bool_t sim_jam_armed;        //卡弹挡块存在
+static fp32 sim_jam_angle;          //挡块位置 拨弹盘角度 rad
+static bool_t sim_jam_hit;          //拨弹盘已顶到挡块
+static uint32_t sim_jam_stall_ms;   //拨弹盘顶到挡块的时间
+static uint32_t sim_jam_reverse_ms; //开始反转的时间
+static uint32_t sim_jam_clear_ms;   //卡弹消失的时间
+static uint32_t sim_jam_shots;      //卡弹时的实际发射数
+
+static uint32_t sim_fric_ready_ms;
+static uint32_t sim_single_shots;
+static uint32_t sim_burst_shots;
+static uint32_t sim_auto_shots;
+static uint32_t sim_heat_window_shots;
+static uint32_t sim_zero_ms;
+static uint32_t sim_error;
+
+//拨弹盘角度 rad 向供弹方向为正
+static fp32 sim_trigger_angle(void)
+{
+    return SHOOT_TRIGGER_MOTOR_DIR * sim_trigger_node->motor.angle / SHOOT_TRIGGER_GEAR_RATIO;
+}
+
+static void sim_step(fp32 dt, void *user)
+{
+    motor_sim_t *trigger = &sim_trigger_node->motor;
+    fp32 angle = sim_trigger_angle();
+    fp32 speed = SHOOT_TRIGGER_MOTOR_DIR * trigger->speed / SHOOT_TRIGGER_GEAR_RATIO;
+    fp32 torque = 0.0f;
+    int32_t slot;
+
+    (void)user;
+
+    //推弹阻力 与转动方向相反
+    if (speed > 1.0e-3f)
+    {
+        torque = SIM_TRIGGER_FEED_TORQUE;
+    }
+    else if (speed < -1.0e-3f)
+    {
+        torque = -SIM_TRIGGER_FEED_TORQUE;
+    }
+
+    //卡弹挡块 拨弹盘退回后消失
+    if (sim_jam_armed)
+    {
+        if (angle > sim_jam_angle)
+        {
+            torque += SIM_JAM_STIFFNESS * (angle - sim_jam_angle) + SIM_JAM_DAMPING * speed;
+            sim_jam_hit = 1;
+        }
+        else if (sim_jam_hit && angle < sim_jam_angle - SIM_JAM_CLEAR_DEG * SIM_DEG)
+        {
+            sim_jam_armed = 0;
+            sim_jam_clear_ms = sim_os_now();
+        }
+    }
+    trigger->load_torque = SHOOT_TRIGGER_MOTOR_DIR * torque / SHOOT_TRIGGER_GEAR_RATIO;
+
+    //拨弹盘向前越过一格的中点 发射一发
+    slot = (int32_t)floorf(angle / SHOOT_TRIGGER_STEP + 0.5f);
+    if (slot > sim_shot_slot)
+    {
+        sim_shot_slot = slot;
+        sim_shots++;
+        sim_heat += CONFIG_SHOOT_HEAT_PER_SHOT;
+        sim_fric_node[0]->motor.speed *= SIM_FRIC_SHOT_DROP;
+        sim_fric_node[1]->motor.speed *= SIM_FRIC_SHOT_DROP;
+    }
+    sim_heat -= sim_cooling_rate * dt;
+    if (sim_heat < 0.0f)
+    {
+        sim_heat = 0.0f;
+    }
+    if (sim_os_now() < SIM_HEAT_STOP_MS && sim_heat > sim_heat_max)
+    {
+        sim_heat_max = sim_heat;
+    }
+    if (sim_os_now() >= SIM_REFEREE_WINDOW_MS && sim_os_now() < SIM_REFEREE_STOP_MS && sim_heat > sim_referee_heat_max)
+    {
+        sim_referee_heat_max = sim_heat;
+    }
+}
+
+//代替裁判系统任务发布 枪口热量取实际热量
+static void sim_referee_publish(uint32_t now_ms)
+{
+    referee_msg_t msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.time_ms = now_ms;
+    msg.valid_flag = REFEREE_UPDATE(REFEREE_CMD_ROBOT_STATUS) | REFEREE_UPDATE(REFEREE_CMD_POWER_HEAT);
+    msg.robot_status.shooter_barrel_heat_limit = SIM_REFEREE_HEAT_LIMIT;
+    msg.robot_status.shooter_barrel_cooling_value = SIM_REFEREE_COOLING_RATE;
+    msg.power_heat.shooter_17mm_1_barrel_heat = (uint16_t)sim_heat;
+    msg_bus_publish(MSG_BUS_TOPIC(referee), &msg);
+}
+
+static void sim_tick(uint32_t now_ms, void *user)
+{
+    shoot_control_t *shoot = &shoot_control_data;
+    param_value_t value;
+
+    (void)user;
+
+    sim_can_tick_1ms();
+    sim_rc_tick_1ms(now_ms);
+    sim_scenario_tick_1ms(&sim_scenario_data, now_ms);
+
+    //代替云台任务发送0x1FF帧
+    if (now_ms % 2u == 0)
+    {
+        CAN_cmd_gimbal(0, 0, get_shoot_trigger_current(), 0);
+    }
+
+    //射击模式
+    if (now_ms == SIM_FRIC_START_MS || now_ms == SIM_MODE_BURST_MS || now_ms == SIM_MODE_AUTO_MS)
+    {
+        value.i = (now_ms == SIM_FRIC_START_MS) ? SHOOT_FIRE_SINGLE : (now_ms == SIM_MODE_BURST_MS) ? SHOOT_FIRE_BURST : SHOOT_FIRE_AUTO;
+        param_set(PARAM_SHOOT_FIRE_MODE, value);
+    }
+
+    if (sim_fric_ready_ms == 0 && shoot->shoot_mode == SHOOT_READY)
+    {
+        sim_fric_ready_ms = now_ms;
+    }
+
+    //各阶段的实际发数 阶段结束前的最后时刻记录
+    if (now_ms == SIM_MODE_BURST_MS)
+    {
+        sim_single_shots = sim_shots;
+    }
+    else if (now_ms == SIM_MODE_AUTO_MS)
+    {
+        sim_burst_shots = sim_shots - sim_single_shots;
+    }
+    else if (now_ms == SIM_JAM_START_MS)
+    {
+        sim_auto_shots = sim_shots - sim_single_shots - sim_burst_shots;
+    }
+    else if (now_ms == SIM_HEAT_WINDOW_MS)
+    {
+        sim_heat_window_shots = sim_shots;
+    }
+    else if (now_ms == SIM_HEAT_STOP_MS)
+    {
+        sim_heat_window_shots = sim_shots - sim_heat_window_shots;
+    }
+
+    //裁判系统上线 实际热量跳变 本地估计只能从枪口热量得知
+    if (now_ms == SIM_REFEREE_START_MS)
+    {
+        sim_referee_on = 1;
+        sim_cooling_rate = SIM_REFEREE_COOLING_RATE;
+        sim_heat += SIM_REFEREE_HEAT_JUMP;
+    }
+    else if (now_ms == SIM_REFEREE_STOP_MS)
+    {
+        sim_referee_on = 0;
+    }
+    if (sim_referee_on && now_ms % SIM_REFEREE_PERIOD_MS == 0)
+    {
+        sim_referee_publish(now_ms);
+    }
+    if (now_ms == SIM_REFEREE_WINDOW_MS)
+    {
+        sim_referee_window_shots = sim_shots;
+    }
+    else if (now_ms == SIM_REFEREE_CHECK_MS)
+    {
+        sim_referee_heat_limit = shoot->heat_limit;
+    }
+    else if (now_ms == SIM_REFEREE_STOP_MS)
+    {
+        sim_referee_window_shots = sim_shots - sim_referee_window_shots;
+    }
+    else if (now_ms == SIM_DISABLE_MS - 1u)
+    {
+        sim_offline_heat_limit = shoot->heat_limit;
+        sim_offline = !shoot->referee_online;
+    }
+
+    //卡弹 挡块放在拨弹盘前方半格处 拨弹盘停止与开始反转的时间
+    if (now_ms == SIM_JAM_ARM_MS)
+    {
+        sim_jam_armed = 1;
+        sim_jam_angle = sim_trigger_angle() + 0.5f * SHOOT_TRIGGER_STEP;
+        sim_jam_shots = sim_shots;
+    }
+    if (sim_jam_armed && sim_jam_stall_ms == 0 && sim_trigger_angle() > sim_jam_angle - 1.0f * SIM_DEG)
+    {
+        sim_jam_stall_ms = now_ms;
+    }
+    if (sim_jam_stall_ms != 0 && sim_jam_reverse_ms == 0 && shoot->reverse_ms != 0)
+    {
+        sim_jam_reverse_ms = now_ms;
+    }
+
+    //下档 电调收到的指令为0
+    if (now_ms >= SIM_DISABLE_MS && sim_zero_ms == 0 && sim_trigger_node->motor.command == 0 &&
+        sim_fric_node[0]->motor.command == 0 && sim_fric_node[1]->motor.command == 0)
+    {
+        sim_zero_ms = now_ms;
+    }
+
+    if (sim_csv != NULL)
+    {
+        fprintf(sim_csv, "%u,%d,%.4f,%.4f,%d,%.0f,%.0f,%.1f,%u,%d\n", (unsigned)now_ms, (int)shoot->shoot_mode,
+                shoot->trigger.angle_set, sim_trigger_angle(), shoot->trigger.give_current,
+                shoot->fric[0].speed, shoot->fric[1].speed, sim_heat, (unsigned)sim_shots, (int)sim_jam_armed);
+    }
+}
+
+static void sim_check(bool_t ok, const char *what, fp64 value, fp64 limit)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "error: %s %.3f, limit %.3f\n", what, value, limit);
+        sim_error++;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const shoot_control_t *shoot = &shoot_control_data;
+    uint32_t auto_expect;
+    uint32_t heat_expect;
+    uint8_t i;
+
+    if (argc == 3 && strcmp(argv[1], "-o") == 0)
+    {
+        sim_csv = fopen(argv[2], "w");
+        if (sim_csv == NULL)
+        {
+            fprintf(stderr, "%s: cannot open\n", argv[2]);
+            return 1;
+        }
+        fprintf(sim_csv, "t_ms,mode,trig_set,trig_angle,trig_out,fric1_rpm,fric2_rpm,heat,shots,jam\n");
+    }
+    else if (argc != 1)
+    {
+        fprintf(stderr, "usage: %s [-o out.csv]\n", argv[0]);
+        return 2;
+    }
+
+    sim_os_init();
+    sim_can_init();
+    sim_rc_init();
+    if (!sim_flash_init())
+    {
+        return 1;
+    }
+    param_init();
+
+    sim_trigger_node = sim_can_add_motor(SIM_CAN2, CAN_TRIGGER_MOTOR_ID, MOTOR_SIM_M2006, SIM_BUS_VOLTAGE);
+    sim_trigger_node->motor.load_inertia = SIM_TRIGGER_INERTIA / (SHOOT_TRIGGER_GEAR_RATIO * SHOOT_TRIGGER_GEAR_RATIO);
+    sim_fric_node[0] = sim_can_add_motor(SIM_CAN2, CAN_FRIC_M1_ID, MOTOR_SIM_M3508, SIM_BUS_VOLTAGE);
+    sim_fric_node[1] = sim_can_add_motor(SIM_CAN2, CAN_FRIC_M2_ID, MOTOR_SIM_M3508, SIM_BUS_VOLTAGE);
+    sim_fric_node[0]->motor.load_inertia = SIM_FRIC_LOAD_INERTIA;
+    sim_fric_node[1]->motor.load_inertia = SIM_FRIC_LOAD_INERTIA;
+    sim_can_set_step_hook(sim_step, NULL);
+
+    sim_scenario_init(&sim_scenario_data);
+    for (i = 0; i < sizeof(sim_scenario_text) / sizeof(sim_scenario_text[0]); i++)
+    {
+        sim_scenario_parse_line(&sim_scenario_data, sim_scenario_text[i]);
+    }
+    sim_os_set_tick_hook(sim_tick, NULL);
+
+    sim_os_run(shoot_task, SIM_DURATION_MS);
+
+    if (sim_csv != NULL)
+    {
+        fclose(sim_csv);
+    }
+
+    printf("fric   ready %u ms after start (%.0f rpm)\n", (unsigned)(sim_fric_ready_ms - SIM_FRIC_START_MS), CONFIG_SHOOT_FRIC_SPEED_RPM);
+    sim_check(sim_fric_ready_ms != 0 && sim_fric_ready_ms - SIM_FRIC_START_MS <= SIM_FRIC_READY_MAX_MS,
+              "fric ready ms", sim_fric_ready_ms - SIM_FRIC_START_MS, SIM_FRIC_READY_MAX_MS);
+
+    //连发1s 第一发立即发射
+    auto_expect = (uint32_t)((SIM_AUTO_STOP_MS - SIM_AUTO_START_MS) * 0.001f * CONFIG_SHOOT_FIRE_RATE_HZ);
+    printf("fire   single %u/%u  burst %u/%u  auto %u in %u ms (rate %.0f Hz)\n",
+           (unsigned)sim_single_shots, SIM_SINGLE_SHOTS, (unsigned)sim_burst_shots, (unsigned)SIM_BURST_SHOTS,
+           (unsigned)sim_auto_shots, SIM_AUTO_STOP_MS - SIM_AUTO_START_MS, CONFIG_SHOOT_FIRE_RATE_HZ);
+    sim_check(sim_single_shots == SIM_SINGLE_SHOTS, "single shots", sim_single_shots, SIM_SINGLE_SHOTS);
+    sim_check(sim_burst_shots == SIM_BURST_SHOTS, "burst shots", sim_burst_shots, SIM_BURST_SHOTS);
+    sim_check(sim_auto_shots >= auto_expect && sim_auto_shots <= auto_expect + 1u, "auto shots", sim_auto_shots, auto_expect);
+
+    printf("jam    stall -> reverse %u ms, cleared %u ms after stall, %u jam, %u shots after jam\n",
+           (unsigned)(sim_jam_reverse_ms - sim_jam_stall_ms), (unsigned)(sim_jam_clear_ms - sim_jam_stall_ms),
+           (unsigned)shoot->jam_count, (unsigned)(sim_shots - sim_jam_shots));
+    sim_check(sim_jam_stall_ms != 0 && sim_jam_reverse_ms != 0 && sim_jam_reverse_ms - sim_jam_stall_ms <= SIM_JAM_DETECT_MAX_MS,
+              "jam detect ms", sim_jam_reverse_ms - sim_jam_stall_ms, SIM_JAM_DETECT_MAX_MS);
+    sim_check(sim_jam_clear_ms != 0, "jam cleared", sim_jam_clear_ms, 1);
+    sim_check(shoot->jam_count == 1, "jam count", shoot->jam_count, 1);
+    //卡弹前后连发 停止时拨弹盘恢复为连续发射
+    sim_check(sim_shots - sim_jam_shots >= (uint32_t)((SIM_JAM_STOP_MS - SIM_JAM_ARM_MS) * 0.001f * CONFIG_SHOOT_FIRE_RATE_HZ) / 2u,
+              "shots after jam", sim_shots - sim_jam_shots, (SIM_JAM_STOP_MS - SIM_JAM_ARM_MS) * 0.001f * CONFIG_SHOOT_FIRE_RATE_HZ / 2u);
+
+    //热量受限后 每发间隔为冷却一发热量的时间
+    heat_expect = (uint32_t)((SIM_HEAT_STOP_MS - SIM_HEAT_WINDOW_MS) * 0.001f * CONFIG_SHOOT_COOLING_RATE / CONFIG_SHOOT_HEAT_PER_SHOT);
+    printf("heat   max %.1f / %d, %u shots in %u ms at limit (cooling allows %u)\n", sim_heat_max, CONFIG_SHOOT_HEAT_LIMIT,
+           (unsigned)sim_heat_window_shots, SIM_HEAT_STOP_MS - SIM_HEAT_WINDOW_MS, (unsigned)heat_expect);
+    sim_check(sim_heat_max <= CONFIG_SHOOT_HEAT_LIMIT, "heat max", sim_heat_max, CONFIG_SHOOT_HEAT_LIMIT);
+    sim_check(sim_heat_window_shots + SIM_HEAT_RATE_TOLERANCE >= heat_expect && sim_heat_window_shots <= heat_expect + SIM_HEAT_RATE_TOLERANCE,
+              "shots at heat limit", sim_heat_window_shots, heat_expect);
+
+    //裁判系统在线 上线时的热量跳变由枪口热量修正 射频按裁判系统的冷却值
+    heat_expect = (uint32_t)((SIM_REFEREE_STOP_MS - SIM_REFEREE_WINDOW_MS) * 0.001f * SIM_REFEREE_COOLING_RATE / CONFIG_SHOOT_HEAT_PER_SHOT);
+    printf("referee heat max %.1f / %d, %u shots in %u ms at limit (cooling allows %u), limit online %d offline %d\n",
+           sim_referee_heat_max, SIM_REFEREE_HEAT_LIMIT, (unsigned)sim_referee_window_shots, SIM_REFEREE_STOP_MS - SIM_REFEREE_WINDOW_MS,
+           (unsigned)heat_expect, (int)sim_referee_heat_limit, (int)sim_offline_heat_limit);
+    sim_check(sim_referee_heat_max <= SIM_REFEREE_HEAT_LIMIT, "referee heat max", sim_referee_heat_max, SIM_REFEREE_HEAT_LIMIT);
+    sim_check(sim_referee_window_shots + SIM_HEAT_RATE_TOLERANCE >= heat_expect && sim_referee_window_shots <= heat_expect + SIM_HEAT_RATE_TOLERANCE,
+              "shots at referee heat limit", sim_referee_window_shots, heat_expect);
+    sim_check(sim_referee_heat_limit == SIM_REFEREE_HEAT_LIMIT, "referee heat limit", sim_referee_heat_limit, SIM_REFEREE_HEAT_LIMIT);
+    //离线后恢复参数
+    sim_check(sim_offline && sim_offline_heat_limit == CONFIG_SHOOT_HEAT_LIMIT, "offline heat limit", sim_offline_heat_limit, CONFIG_SHOOT_HEAT_LIMIT);
+
+    //所有拨弹指令都已发射 没有多发或漏发
+    printf("total  commanded %u, fired %u\n", (unsigned)shoot->shoot_count, (unsigned)sim_shots);
+    sim_check(shoot->shoot_count == sim_shots, "fired shots", sim_shots, shoot->shoot_count);
+
+    //开关变化在下一帧遥控器数据生效 再经一个控制周期发出
+    printf("zero   output %u ms after switch down\n", (unsigned)(sim_zero_ms - SIM_DISABLE_MS));
+    sim_check(sim_zero_ms != 0 && sim_zero_ms - SIM_DISABLE_MS <= RC_FRAME_PERIOD_MS + 2u * SHOOT_CONTROL_TIME_MS,
+              "zero force ms", sim_zero_ms - SIM_DISABLE_MS, RC_FRAME_PERIOD_MS + 2u * SHOOT_CONTROL_TIME_MS);
+
+    if (sim_error != 0)
+    {
+        fprintf(stderr, "shoot_sim: %u errors\n", (unsigned)sim_error);
+        return 1;
+    }
+    printf("shoot_sim: ok\n");
+    return 0;
+}
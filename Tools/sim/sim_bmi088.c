@@ -0,0 +1,566 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_bmi088.c/h
+  * @brief      上位机仿真BMI088，寄存器级假设备，实现bsp_imu.h接口，
+  *             用于在PC上测试bmi088.c的初始化、FIFO读取、解析与时间戳。
+  * @note       只模拟驱动用到的寄存器与行为:
+  *             加速度计I2C/SPI模式切换与读取空字节、软复位、配置寄存器回读、数据寄存器、温度、
+  *             带帧头的加速度计FIFO(满后丢帧并插入跳过帧)、陀螺仪FIFO(流模式覆盖与溢出标志)、
+  *             陀螺仪FIFO水位中断。FIFO中读了一部分的帧留在FIFO中，下次重新读出。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+#include "sim_bmi088.h"
+
+#define SIM_GYRO_ODR_HZ       2000.0
+#define SIM_ACCEL_ODR_HZ      1600.0
+#define SIM_GYRO_FIFO_FRAMES  100u
+#define SIM_GYRO_FRAME_LEN    6u
+#define SIM_ACCEL_FIFO_LEN    1024u
+#define SIM_ACCEL_FRAME_LEN   7u
+
+#define SIM_GRAVITY           9.80665
+#define SIM_DEG_TO_RAD        0.017453292519943295
+
+/*加速度计寄存器*/
+#define ACC_CHIP_ID           0x00u
+#define ACC_X_LSB             0x12u
+#define ACC_TEMP_MSB          0x22u
+#define ACC_TEMP_LSB          0x23u
+#define ACC_FIFO_LENGTH_0     0x24u
+#define ACC_FIFO_LENGTH_1     0x25u
+#define ACC_FIFO_DATA         0x26u
+#define ACC_CONF              0x40u
+#define ACC_RANGE             0x41u
+#define ACC_FIFO_DOWNS        0x45u
+#define ACC_FIFO_CONFIG_0     0x48u
+#define ACC_FIFO_CONFIG_1     0x49u
+#define ACC_PWR_CONF          0x7Cu
+#define ACC_PWR_CTRL          0x7Du
+#define ACC_SOFTRESET         0x7Eu
+
+/*陀螺仪寄存器*/
+#define GYRO_CHIP_ID          0x00u
+#define GYRO_RATE_X_LSB       0x02u
+#define GYRO_FIFO_STATUS      0x0Eu
+#define GYRO_RANGE            0x0Fu
+#define GYRO_BANDWIDTH        0x10u
+#define GYRO_SOFTRESET        0x14u
+#define GYRO_INT_CTRL         0x15u
+#define GYRO_INT3_INT4_CONF   0x16u
+#define GYRO_INT3_INT4_MAP    0x18u
+#define GYRO_FIFO_WM_EN       0x1Eu
+#define GYRO_FIFO_CONFIG_0    0x3Du
+#define GYRO_FIFO_CONFIG_1    0x3Eu
+#define GYRO_FIFO_DATA        0x3Fu
+
+#define SOFTRESET_CMD         0xB6u
+
+typedef struct
+{
+    uint8_t reg[128];
+    uint8_t fifo[SIM_ACCEL_FIFO_LEN];
+    uint16_t fifo_len;            //字节
+    double next_time_us;          //下一个样本的时间
+} sim_bmi088_sensor_t;
+
+static sim_bmi088_sensor_t sim_accel;
+static sim_bmi088_sensor_t sim_gyro;
+static bool_t sim_accel_spi = 0;            //加速度计已切换到SPI模式
+static uint8_t sim_accel_skip = 0;          //加速度计FIFO满后丢失 尚未写入跳过帧的帧数
+static bool_t sim_gyro_overrun = 0;
+
+static uint8_t sim_accel_id = 0x1Eu;
+static uint8_t sim_gyro_id = 0x0Fu;
+static double sim_time_us = 0.0;
+static double sim_odr_scale = 1.0;          //采样间隔倍数
+static fp32 sim_gyro_input[3];
+static fp32 sim_accel_input[3];
+static fp32 sim_temp = 25.0f;
+
+static uint32_t sim_gyro_time[SIM_BMI088_TIME_RING];
+static uint32_t sim_accel_time[SIM_BMI088_TIME_RING];
+static sim_bmi088_stats_t sim_stats;
+
+static bsp_imu_int_callback_t sim_int_callback = NULL;
+static bsp_imu_dma_callback_t sim_dma_callback = NULL;
+static bool_t sim_int_enable = 0;
+static uint32_t sim_dma_hang = 0;
+static bool_t sim_dma_busy = 0;
+
+static void sim_accel_reset(void)
+{
+    memset(&sim_accel.reg, 0, sizeof(sim_accel.reg));
+    sim_accel.reg[ACC_CHIP_ID] = sim_accel_id;
+    sim_accel.reg[ACC_CONF] = 0xA8u;
+    sim_accel.reg[ACC_RANGE] = 0x01u;
+    sim_accel.reg[ACC_FIFO_DOWNS] = 0x80u;
+    sim_accel.reg[ACC_FIFO_CONFIG_0] = 0x02u;
+    sim_accel.reg[ACC_FIFO_CONFIG_1] = 0x10u;
+    sim_accel.reg[ACC_PWR_CONF] = 0x03u;
+    sim_accel.reg[ACC_PWR_CTRL] = 0x00u;
+    sim_accel.fifo_len = 0;
+    sim_accel_skip = 0;
+    sim_accel_spi = 0;
+    sim_bmi088_temp_set(sim_temp);
+}
+
+static void sim_gyro_reset(void)
+{
+    memset(&sim_gyro.reg, 0, sizeof(sim_gyro.reg));
+    sim_gyro.reg[GYRO_CHIP_ID] = sim_gyro_id;
+    sim_gyro.reg[GYRO_BANDWIDTH] = 0x80u;
+    sim_gyro.reg[GYRO_INT3_INT4_CONF] = 0x0Fu;
+    sim_gyro.reg[GYRO_FIFO_WM_EN] = 0x08u;
+    sim_gyro.fifo_len = 0;
+    sim_gyro_overrun = 0;
+}
+
+void sim_bmi088_reset(void)
+{
+    sim_time_us = 0.0;
+    sim_odr_scale = 1.0;
+    memset(sim_gyro_input, 0, sizeof(sim_gyro_input));
+    memset(sim_accel_input, 0, sizeof(sim_accel_input));
+    sim_temp = 25.0f;
+    sim_accel_id = 0x1Eu;
+    sim_gyro_id = 0x0Fu;
+    memset(&sim_stats, 0, sizeof(sim_stats));
+    sim_accel_reset();
+    sim_gyro_reset();
+    sim_accel.next_time_us = 1000000.0 / SIM_ACCEL_ODR_HZ;
+    sim_gyro.next_time_us = 1000000.0 / SIM_GYRO_ODR_HZ;
+    sim_int_enable = 0;
+    sim_dma_hang = 0;
+    sim_dma_busy = 0;
+}
+
+void sim_bmi088_odr_error_set(int32_t ppm)
+{
+    sim_odr_scale = 1.0 + (double)ppm * 1e-6;
+}
+
+void sim_bmi088_input_set(const fp32 gyro[3], const fp32 accel[3])
+{
+    memcpy(sim_gyro_input, gyro, sizeof(sim_gyro_input));
+    memcpy(sim_accel_input, accel, sizeof(sim_accel_input));
+}
+
+void sim_bmi088_temp_set(fp32 temp)
+{
+    //11位补码 0.125℃每LSB 0对应23℃
+    long raw = lround((temp - 23.0f) / 0.125f);
+
+    if (raw > 1023)
+    {
+        raw = 1023;
+    }
+    else if (raw < -1024)
+    {
+        raw = -1024;
+    }
+    sim_temp = temp;
+    sim_accel.reg[ACC_TEMP_MSB] = (uint8_t)(((uint16_t)raw & 0x7FFu) >> 3);
+    sim_accel.reg[ACC_TEMP_LSB] = (uint8_t)(((uint16_t)raw & 0x07u) << 5);
+}
+
+void sim_bmi088_chip_id_set(uint8_t accel_id, uint8_t gyro_id)
+{
+    sim_accel_id = accel_id;
+    sim_gyro_id = gyro_id;
+    sim_accel.reg[ACC_CHIP_ID] = accel_id;
+    sim_gyro.reg[GYRO_CHIP_ID] = gyro_id;
+}
+
+void sim_bmi088_dma_hang_set(uint32_t count)
+{
+    sim_dma_hang = count;
+}
+
+//物理量转为小端int16 饱和
+static void sim_encode(const fp32 value[3], double lsb, uint8_t *data)
+{
+    uint8_t i;
+    long raw;
+
+    for (i = 0; i < 3u; i++)
+    {
+        raw = lround(value[i] / lsb);
+        if (raw > 32767)
+        {
+            raw = 32767;
+        }
+        else if (raw < -32768)
+        {
+            raw = -32768;
+        }
+        data[2u * i] = (uint8_t)((uint16_t)raw & 0xFFu);
+        data[2u * i + 1u] = (uint8_t)((uint16_t)raw >> 8);
+    }
+}
+
+static void sim_gyro_sample(uint32_t time_us)
+{
+    double lsb = (double)(2000u >> (sim_gyro.reg[GYRO_RANGE] & 0x07u)) / 32768.0 * SIM_DEG_TO_RAD;
+    uint8_t wm = sim_gyro.reg[GYRO_FIFO_CONFIG_0] & 0x7Fu;
+    uint8_t *frame;
+
+    sim_encode(sim_gyro_input, lsb, &sim_gyro.reg[GYRO_RATE_X_LSB]);
+    sim_stats.gyro_sample_count++;
+    if ((sim_gyro.reg[GYRO_FIFO_CONFIG_1] & 0xC0u) == 0)
+    {
+        return;
+    }
+
+    //流模式满后覆盖最旧帧
+    if (sim_gyro.fifo_len >= SIM_GYRO_FIFO_FRAMES * SIM_GYRO_FRAME_LEN)
+    {
+        memmove(sim_gyro.fifo, sim_gyro.fifo + SIM_GYRO_FRAME_LEN, sim_gyro.fifo_len - SIM_GYRO_FRAME_LEN);
+        sim_gyro.fifo_len -= SIM_GYRO_FRAME_LEN;
+        sim_gyro_overrun = 1;
+        sim_stats.gyro_overwrite_count++;
+    }
+    frame = sim_gyro.fifo + sim_gyro.fifo_len;
+    memcpy(frame, &sim_gyro.reg[GYRO_RATE_X_LSB], SIM_GYRO_FRAME_LEN);
+    sim_gyro.fifo_len += SIM_GYRO_FRAME_LEN;
+    sim_gyro_time[sim_stats.gyro_push_count % SIM_BMI088_TIME_RING] = time_us;
+    sim_stats.gyro_push_count++;
+
+    //达到水位时产生一次中断
+    if (wm != 0 && sim_gyro.fifo_len == wm * SIM_GYRO_FRAME_LEN &&
+        sim_gyro.reg[GYRO_FIFO_WM_EN] == 0x88u && (sim_gyro.reg[GYRO_INT_CTRL] & 0x40u) &&
+        (sim_gyro.reg[GYRO_INT3_INT4_MAP] & 0x04u))
+    {
+        sim_stats.int_count++;
+        if (sim_int_enable && sim_int_callback != NULL)
+        {
+            sim_int_callback(time_us);
+        }
+    }
+}
+
+static void sim_accel_sample(uint32_t time_us)
+{
+    double lsb = (double)(3u << (sim_accel.reg[ACC_RANGE] & 0x03u)) / 32768.0 * SIM_GRAVITY;
+    uint16_t need = SIM_ACCEL_FRAME_LEN;
+
+    if (sim_accel.reg[ACC_PWR_CTRL] != 0x04u || sim_accel.reg[ACC_PWR_CONF] != 0x00u)
+    {
+        return;
+    }
+    sim_encode(sim_accel_input, lsb, &sim_accel.reg[ACC_X_LSB]);
+    sim_stats.accel_sample_count++;
+    if ((sim_accel.reg[ACC_FIFO_CONFIG_1] & 0x40u) == 0)
+    {
+        return;
+    }
+
+    //满后丢弃新帧 有空间时先写入跳过帧
+    if (sim_accel_skip != 0)
+    {
+        need += 2u;
+    }
+    if (sim_accel.fifo_len + need > SIM_ACCEL_FIFO_LEN)
+    {
+        if (sim_accel_skip < 0xFFu)
+        {
+            sim_accel_skip++;
+        }
+        sim_stats.accel_drop_count++;
+        return;
+    }
+    if (sim_accel_skip != 0)
+    {
+        sim_accel.fifo[sim_accel.fifo_len++] = 0x40u;
+        sim_accel.fifo[sim_accel.fifo_len++] = sim_accel_skip;
+        sim_accel_skip = 0;
+    }
+    sim_accel.fifo[sim_accel.fifo_len++] = 0x84u;
+    memcpy(sim_accel.fifo + sim_accel.fifo_len, &sim_accel.reg[ACC_X_LSB], 6u);
+    sim_accel.fifo_len += 6u;
+    sim_accel_time[sim_stats.accel_push_count % SIM_BMI088_TIME_RING] = time_us;
+    sim_stats.accel_push_count++;
+}
+
+void sim_bmi088_advance(uint32_t us)
+{
+    double target = sim_time_us + (double)us;
+    double next;
+
+    while (1)
+    {
+        next = sim_gyro.next_time_us < sim_accel.next_time_us ? sim_gyro.next_time_us : sim_accel.next_time_us;
+        if (next > target)
+        {
+            break;
+        }
+        sim_time_us = next;
+        if (sim_gyro.next_time_us <= next)
+        {
+            sim_gyro.next_time_us += 1000000.0 / SIM_GYRO_ODR_HZ * sim_odr_scale;
+            sim_gyro_sample((uint32_t)llround(next));
+        }
+        else
+        {
+            sim_accel.next_time_us += 1000000.0 / SIM_ACCEL_ODR_HZ * sim_odr_scale;
+            sim_accel_sample((uint32_t)llround(next));
+        }
+    }
+    sim_time_us = target;
+}
+
+uint8_t sim_bmi088_reg_get(bsp_imu_cs_e cs, uint8_t reg)
+{
+    return (cs == BSP_IMU_ACCEL) ? sim_accel.reg[reg & 0x7Fu] : sim_gyro.reg[reg & 0x7Fu];
+}
+
+uint32_t sim_bmi088_sample_time_get(bsp_imu_cs_e cs, uint32_t seq)
+{
+    return (cs == BSP_IMU_ACCEL) ? sim_accel_time[seq % SIM_BMI088_TIME_RING] : sim_gyro_time[seq % SIM_BMI088_TIME_RING];
+}
+
+const sim_bmi088_stats_t *sim_bmi088_stats_get(void)
+{
+    return &sim_stats;
+}
+
+/*------bsp_imu.h------*/
+
+static void sim_write(bsp_imu_cs_e cs, uint8_t reg, uint8_t value)
+{
+    reg &= 0x7Fu;
+    if (cs == BSP_IMU_ACCEL)
+    {
+        if (reg == ACC_SOFTRESET)
+        {
+            if (value == SOFTRESET_CMD)
+            {
+                sim_accel_reset();
+            }
+        }
+        else if (reg >= ACC_CONF)
+        {
+            sim_accel.reg[reg] = value;
+        }
+        return;
+    }
+
+    if (reg == GYRO_SOFTRESET)
+    {
+        if (value == SOFTRESET_CMD)
+        {
+            sim_gyro_reset();
+        }
+    }
+    else if (reg == GYRO_BANDWIDTH)
+    {
+        sim_gyro.reg[reg] = (uint8_t)(value | 0x80u);
+    }
+    else if (reg == GYRO_FIFO_CONFIG_1)
+    {
+        //写FIFO配置清空FIFO与溢出标志
+        sim_gyro.reg[reg] = value;
+        sim_gyro.fifo_len = 0;
+        sim_gyro_overrun = 0;
+    }
+    else if (reg == GYRO_FIFO_CONFIG_0)
+    {
+        sim_gyro.reg[reg] = value & 0x7Fu;
+    }
+    else if (reg >= GYRO_RANGE)
+    {
+        sim_gyro.reg[reg] = value;
+    }
+}
+
+static uint8_t sim_accel_reg_read(uint8_t reg)
+{
+    if (reg == ACC_FIFO_LENGTH_0)
+    {
+        return (uint8_t)(sim_accel.fifo_len & 0xFFu);
+    }
+    if (reg == ACC_FIFO_LENGTH_1)
+    {
+        return (uint8_t)(sim_accel.fifo_len >> 8);
+    }
+    return sim_accel.reg[reg & 0x7Fu];
+}
+
+static uint8_t sim_gyro_reg_read(uint8_t reg)
+{
+    if (reg == GYRO_FIFO_STATUS)
+    {
+        return (uint8_t)((sim_gyro_overrun ? 0x80u : 0u) | (sim_gyro.fifo_len / SIM_GYRO_FRAME_LEN));
+    }
+    return sim_gyro.reg[reg & 0x7Fu];
+}
+
+//FIFO连续读取 读出完整帧后从FIFO中移除, 读了一部分的帧保留
+static void sim_fifo_read(sim_bmi088_sensor_t *sensor, bool_t accel, uint8_t *buf, uint16_t len)
+{
+    uint16_t done = 0;
+    uint16_t frame;
+    uint16_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        if (i < sensor->fifo_len)
+        {
+            buf[i] = sensor->fifo[i];
+        }
+        else
+        {
+            //FIFO已空: 加速度计返回0x80帧头 陀螺仪返回-32768
+            buf[i] = accel ? 0x80u : ((i % 2u) ? 0x80u : 0x00u);
+        }
+    }
+
+    while (done < sensor->fifo_len)
+    {
+        if (!accel)
+        {
+            frame = SIM_GYRO_FRAME_LEN;
+        }
+        else if (sensor->fifo[done] == 0x84u)
+        {
+            frame = SIM_ACCEL_FRAME_LEN;
+        }
+        else
+        {
+            frame = 2u;
+        }
+        if (done + frame > len)
+        {
+            break;
+        }
+        done += frame;
+    }
+    memmove(sensor->fifo, sensor->fifo + done, sensor->fifo_len - done);
+    sensor->fifo_len -= done;
+}
+
+static void sim_read(bsp_imu_cs_e cs, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+
+    reg &= 0x7Fu;
+    if (cs == BSP_IMU_ACCEL)
+    {
+        if (!sim_accel_spi)
+        {
+            //I2C模式下不响应 片选上升沿后切换到SPI
+            memset(buf, 0, len);
+            sim_accel_spi = 1;
+            return;
+        }
+        if (len == 0)
+        {
+            return;
+        }
+        buf[0] = 0xFFu;
+        if (reg == ACC_FIFO_DATA)
+        {
+            sim_fifo_read(&sim_accel, 1, buf + 1, (uint16_t)(len - 1u));
+            return;
+        }
+        for (i = 1; i < len; i++)
+        {
+            buf[i] = sim_accel_reg_read((uint8_t)(reg + i - 1u));
+        }
+        return;
+    }
+
+    if (reg == GYRO_FIFO_DATA)
+    {
+        sim_fifo_read(&sim_gyro, 0, buf, len);
+        return;
+    }
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = sim_gyro_reg_read((uint8_t)(reg + i));
+    }
+}
+
+void bsp_imu_init(bsp_imu_int_callback_t int_callback, bsp_imu_dma_callback_t dma_callback)
+{
+    sim_int_callback = int_callback;
+    sim_dma_callback = dma_callback;
+}
+
+void bsp_imu_int_enable(bool_t enable)
+{
+    sim_int_enable = enable;
+}
+
+void bsp_imu_write(bsp_imu_cs_e cs, uint8_t reg, uint8_t value)
+{
+    sim_stats.transaction_count++;
+    sim_stats.byte_count += 2u;
+    //I2C模式下的写入无效
+    if (cs == BSP_IMU_ACCEL && !sim_accel_spi)
+    {
+        sim_accel_spi = 1;
+        return;
+    }
+    sim_write(cs, reg, value);
+}
+
+void bsp_imu_read(bsp_imu_cs_e cs, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    sim_stats.transaction_count++;
+    sim_stats.byte_count += 1u + len;
+    sim_read(cs, reg, buf, len);
+}
+
+bool_t bsp_imu_read_dma(bsp_imu_cs_e cs, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    if (sim_dma_busy)
+    {
+        sim_stats.dma_busy_count++;
+        return 0;
+    }
+    if (sim_dma_hang != 0)
+    {
+        //已拉低片选并发出地址 DMA一直不完成
+        sim_dma_hang--;
+        sim_dma_busy = 1;
+        sim_stats.dma_hang_count++;
+        sim_stats.transaction_count++;
+        sim_stats.byte_count += 1u;
+        return 1;
+    }
+    bsp_imu_read(cs, reg, buf, len);
+    if (sim_dma_callback != NULL)
+    {
+        sim_dma_callback(1);
+    }
+    return 1;
+}
+
+void bsp_imu_dma_abort(void)
+{
+    sim_dma_busy = 0;
+    sim_stats.dma_abort_count++;
+}
+
+void bsp_imu_delay_ms(uint16_t ms)
+{
+    sim_bmi088_advance((uint32_t)ms * 1000u);
+}
+
+uint32_t bsp_imu_time_us(void)
+{
+    return (uint32_t)llround(sim_time_us);
+}
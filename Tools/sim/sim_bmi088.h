@@ -0,0 +1,109 @@
+#ifndef SIM_BMI088_H
+#define SIM_BMI088_H
+
+#include "struct_typedef.h"
+#include "bsp_imu.h"
+
+/*
+  上位机仿真BMI088 寄存器级假设备 实现bsp_imu.h接口
+  寄存器地址与行为按数据手册: 加速度计上电与软复位后为I2C模式, 片选一次上升沿后切换到SPI, 读取多一个空字节;
+  两个传感器的FIFO按各自的输出频率写入, 陀螺仪FIFO水位中断回调bsp_imu_init注册的函数;
+  DMA读取在bsp_imu_read_dma中同步完成, 返回前调用DMA完成回调;
+  sim_bmi088_dma_hang_set后的DMA读取不完成, 与目标板相同 在bsp_imu_dma_abort前之后的DMA读取都返回0
+  时间只由sim_bmi088_advance与bsp_imu_delay_ms推进
+*/
+
+#define SIM_BMI088_TIME_RING 1024u  //记录最近写入FIFO的帧的采样时间
+
+/*统计*/
+typedef struct
+{
+    uint32_t transaction_count;   //片选次数
+    uint32_t byte_count;          //SPI字节数 含地址
+    uint32_t int_count;           //陀螺仪水位中断次数
+    uint32_t gyro_sample_count;   //陀螺仪采样次数 数据寄存器更新
+    uint32_t accel_sample_count;  //加速度计采样次数
+    uint32_t gyro_push_count;     //写入陀螺仪FIFO的帧数
+    uint32_t accel_push_count;    //写入加速度计FIFO的帧数
+    uint32_t gyro_overwrite_count;//陀螺仪FIFO满后被覆盖的帧数
+    uint32_t accel_drop_count;    //加速度计FIFO满后丢弃的帧数
+    uint32_t dma_hang_count;      //未完成的DMA读取次数
+    uint32_t dma_busy_count;      //因上一次DMA读取未完成而拒绝的DMA读取次数
+    uint32_t dma_abort_count;     //bsp_imu_dma_abort次数
+} sim_bmi088_stats_t;
+
+/**
+  * @brief          上电复位 时间清零 输入量清零 清空统计
+  * @param[in]      none
+  * @retval         none
+  */
+extern void sim_bmi088_reset(void);
+
+/**
+  * @brief          两个传感器的采样时钟误差(相对标称输出频率, 正为偏慢)
+  * @param[in]      ppm: 百万分之一
+  * @retval         none
+  */
+extern void sim_bmi088_odr_error_set(int32_t ppm);
+
+/**
+  * @brief          设置输入量
+  * @param[in]      gyro: 角速度 rad/s
+  * @param[in]      accel: 加速度 m/s^2
+  * @retval         none
+  */
+extern void sim_bmi088_input_set(const fp32 gyro[3], const fp32 accel[3]);
+
+/**
+  * @brief          设置温度
+  * @param[in]      temp: ℃
+  * @retval         none
+  */
+extern void sim_bmi088_temp_set(fp32 temp);
+
+/**
+  * @brief          设置芯片ID 模拟焊接或接线错误
+  * @param[in]      accel_id: 加速度计ID
+  * @param[in]      gyro_id: 陀螺仪ID
+  * @retval         none
+  */
+extern void sim_bmi088_chip_id_set(uint8_t accel_id, uint8_t gyro_id);
+
+/**
+  * @brief          之后的count次DMA读取不完成: 不传输、不调用DMA完成回调, 直到bsp_imu_dma_abort
+  * @param[in]      count: 次数
+  * @retval         none
+  */
+extern void sim_bmi088_dma_hang_set(uint32_t count);
+
+/**
+  * @brief          推进时间 期间产生的样本写入FIFO, 达到水位时调用中断回调
+  * @param[in]      us: 微秒
+  * @retval         none
+  */
+extern void sim_bmi088_advance(uint32_t us);
+
+/**
+  * @brief          寄存器当前值 不经过SPI 不影响FIFO
+  * @param[in]      cs: 传感器
+  * @param[in]      reg: 寄存器地址
+  * @retval         值
+  */
+extern uint8_t sim_bmi088_reg_get(bsp_imu_cs_e cs, uint8_t reg);
+
+/**
+  * @brief          写入FIFO的第seq帧(从0起, 复位后写入FIFO的顺序)的真实采样时间
+  * @param[in]      cs: 传感器
+  * @param[in]      seq: 帧序号 只保留最近SIM_BMI088_TIME_RING帧
+  * @retval         us
+  */
+extern uint32_t sim_bmi088_sample_time_get(bsp_imu_cs_e cs, uint32_t seq);
+
+/**
+  * @brief          统计
+  * @param[in]      none
+  * @retval         统计指针
+  */
+extern const sim_bmi088_stats_t *sim_bmi088_stats_get(void);
+
+#endif
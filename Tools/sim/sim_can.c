@@ -0,0 +1,263 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_can.c/h
+  * @brief      上位机仿真CAN总线，提供hcan1/hcan2与HAL_CAN收发函数，
+  *             控制帧按电调ID分发给电机模型，电机模型每1ms产生一帧反馈。
+  * @note       
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <stddef.h>
+#include <string.h>
+#include "sim_can.h"
+
+/*接收FIFO中的一帧*/
+typedef struct
+{
+    uint16_t std_id;
+    uint8_t data[8];
+} sim_can_frame_t;
+
+typedef struct
+{
+    sim_can_frame_t frame[SIM_CAN_RX_FIFO_LEN];
+    uint8_t head;
+    uint8_t count;
+} sim_can_fifo_t;
+
+CAN_HandleTypeDef hcan1 = {SIM_CAN1};
+CAN_HandleTypeDef hcan2 = {SIM_CAN2};
+
+static CAN_HandleTypeDef *const sim_can_handle[SIM_CAN_BUS_NUM] = {&hcan1, &hcan2};
+
+static sim_can_node_t sim_can_node[SIM_CAN_MAX_NODE];
+static uint8_t sim_can_node_num;
+static sim_can_fifo_t sim_can_fifo[SIM_CAN_BUS_NUM];
+static sim_can_stat_t sim_can_stat[SIM_CAN_BUS_NUM];
+
+static sim_can_step_hook_t sim_can_step_hook;
+static void *sim_can_step_user;
+
+//反馈帧进入接收FIFO 并触发接收中断回调
+static void sim_can_deliver(uint8_t bus, uint16_t std_id, const uint8_t data[8])
+{
+    sim_can_fifo_t *fifo = &sim_can_fifo[bus];
+    sim_can_frame_t *frame;
+
+    if (fifo->count >= SIM_CAN_RX_FIFO_LEN)
+    {
+        sim_can_stat[bus].rx_overflow++;
+        return;
+    }
+
+    frame = &fifo->frame[(fifo->head + fifo->count) % SIM_CAN_RX_FIFO_LEN];
+    frame->std_id = std_id;
+    memcpy(frame->data, data, 8);
+    fifo->count++;
+
+    //FIFO非空期间中断持续挂起 回调每次取走一帧
+    while (fifo->count != 0)
+    {
+        uint8_t count = fifo->count;
+
+        HAL_CAN_RxFifo0MsgPendingCallback(sim_can_handle[bus]);
+        if (fifo->count == count)
+        {
+            //回调没有读取 丢弃 避免死循环
+            fifo->head = (uint8_t)((fifo->head + 1u) % SIM_CAN_RX_FIFO_LEN);
+            fifo->count--;
+        }
+    }
+}
+
+void sim_can_init(void)
+{
+    memset(sim_can_node, 0, sizeof(sim_can_node));
+    memset(sim_can_fifo, 0, sizeof(sim_can_fifo));
+    memset(sim_can_stat, 0, sizeof(sim_can_stat));
+    sim_can_node_num = 0;
+    sim_can_step_hook = NULL;
+    sim_can_step_user = NULL;
+}
+
+sim_can_node_t *sim_can_add_motor(uint8_t bus, uint16_t feedback_id, motor_sim_type_e type, fp32 bus_voltage)
+{
+    sim_can_node_t *node;
+    uint16_t id;
+
+    if (bus >= SIM_CAN_BUS_NUM || sim_can_node_num >= SIM_CAN_MAX_NODE || motor_sim_get_param(type) == NULL)
+    {
+        return NULL;
+    }
+
+    node = &sim_can_node[sim_can_node_num];
+    if (type == MOTOR_SIM_GM6020)
+    {
+        id = (uint16_t)(feedback_id - 0x204u);
+        if (id < 1u || id > 7u)
+        {
+            return NULL;
+        }
+        node->command_id = (id <= 4u) ? 0x1FFu : 0x2FFu;
+    }
+    else
+    {
+        id = (uint16_t)(feedback_id - 0x200u);
+        if (id < 1u || id > 8u)
+        {
+            return NULL;
+        }
+        node->command_id = (id <= 4u) ? 0x200u : 0x1FFu;
+    }
+
+    node->bus = bus;
+    node->feedback_id = feedback_id;
+    node->command_slot = (uint8_t)((id - 1u) & 0x03u);
+    node->online = 1;
+    motor_sim_init(&node->motor, type, bus_voltage);
+    sim_can_node_num++;
+
+    return node;
+}
+
+void sim_can_set_step_hook(sim_can_step_hook_t hook, void *user)
+{
+    sim_can_step_hook = hook;
+    sim_can_step_user = user;
+}
+
+void sim_can_tick_1ms(void)
+{
+    const fp32 dt = 1.0e-3f / (fp32)SIM_CAN_SUBSTEP;
+    uint8_t data[8];
+    uint8_t i;
+    uint8_t step;
+
+    for (step = 0; step < SIM_CAN_SUBSTEP; step++)
+    {
+        if (sim_can_step_hook != NULL)
+        {
+            sim_can_step_hook(dt, sim_can_step_user);
+        }
+        for (i = 0; i < sim_can_node_num; i++)
+        {
+            motor_sim_step(&sim_can_node[i].motor, dt);
+        }
+    }
+
+    for (i = 0; i < sim_can_node_num; i++)
+    {
+        if (!sim_can_node[i].online)
+        {
+            continue;
+        }
+        motor_sim_feedback(&sim_can_node[i].motor, data);
+        sim_can_deliver(sim_can_node[i].bus, sim_can_node[i].feedback_id, data);
+    }
+}
+
+const sim_can_stat_t *sim_can_get_stat(uint8_t bus)
+{
+    if (bus >= SIM_CAN_BUS_NUM)
+    {
+        return NULL;
+    }
+    return &sim_can_stat[bus];
+}
+
+//控制帧发送后立即生效 邮箱中没有等待的帧
+HAL_StatusTypeDef HAL_CAN_AbortTxRequest(CAN_HandleTypeDef *hcan, uint32_t TxMailboxes)
+{
+    (void)TxMailboxes;
+    if (hcan == NULL || hcan->bus >= SIM_CAN_BUS_NUM)
+    {
+        return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, CAN_TxHeaderTypeDef *pHeader, uint8_t aData[], uint32_t *pTxMailbox)
+{
+    uint8_t handled = 0;
+    uint8_t i;
+
+    if (hcan == NULL || pHeader == NULL || aData == NULL || hcan->bus >= SIM_CAN_BUS_NUM)
+    {
+        return HAL_ERROR;
+    }
+
+    sim_can_stat[hcan->bus].tx_count++;
+    if (pTxMailbox != NULL)
+    {
+        *pTxMailbox = 0;
+    }
+
+    //控制帧立即生效 忽略总线传输延时
+    for (i = 0; i < sim_can_node_num; i++)
+    {
+        sim_can_node_t *node = &sim_can_node[i];
+
+        if (node->bus == hcan->bus && node->command_id == pHeader->StdId && pHeader->DLC == 8u)
+        {
+            uint8_t index = (uint8_t)(node->command_slot * 2u);
+
+            motor_sim_set_command(&node->motor, (int16_t)((aData[index] << 8) | aData[index + 1u]));
+            handled = 1;
+        }
+    }
+    if (!handled)
+    {
+        sim_can_stat[hcan->bus].unknown_tx++;
+    }
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *hcan, uint32_t RxFifo, CAN_RxHeaderTypeDef *pHeader, uint8_t aData[])
+{
+    sim_can_fifo_t *fifo;
+    sim_can_frame_t *frame;
+
+    if (hcan == NULL || pHeader == NULL || aData == NULL || hcan->bus >= SIM_CAN_BUS_NUM || RxFifo != CAN_RX_FIFO0)
+    {
+        return HAL_ERROR;
+    }
+
+    fifo = &sim_can_fifo[hcan->bus];
+    if (fifo->count == 0)
+    {
+        return HAL_ERROR;
+    }
+
+    frame = &fifo->frame[fifo->head];
+    memset(pHeader, 0, sizeof(*pHeader));
+    pHeader->StdId = frame->std_id;
+    pHeader->IDE = CAN_ID_STD;
+    pHeader->RTR = CAN_RTR_DATA;
+    pHeader->DLC = 8;
+    memcpy(aData, frame->data, 8);
+
+    fifo->head = (uint8_t)((fifo->head + 1u) % SIM_CAN_RX_FIFO_LEN);
+    fifo->count--;
+    sim_can_stat[hcan->bus].rx_count++;
+
+    return HAL_OK;
+}
+
+sim_can_node_t *sim_can_get_node(uint8_t index)
+{
+    if (index >= sim_can_node_num)
+    {
+        return NULL;
+    }
+    return &sim_can_node[index];
+}
@@ -0,0 +1,118 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_can.c/h
+  * @brief      上位机仿真CAN总线，提供hcan1/hcan2与HAL_CAN收发函数，
+  *             控制帧(0x200/0x1FF/0x2FF)按电调ID分发给电机模型，
+  *             电机模型每1ms产生一帧反馈，经HAL_CAN_RxFifo0MsgPendingCallback
+  *             交给未修改的CAN_receive.c解析。
+  * @note       
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    电调ID与帧ID(与DJI电调协议一致):
+      C620/C610 ID 1~8: 反馈0x200+ID, 控制0x200(ID1~4)或0x1FF(ID5~8)
+      GM6020    ID 1~7: 反馈0x204+ID, 控制0x1FF(ID1~4)或0x2FF(ID5~7)
+      控制帧第(ID-1)%4个16位数据(大端)为该电调的指令
+    每个仿真毫秒(sim_can_tick_1ms):
+      1. 分SIM_CAN_SUBSTEP步推进电机, 每步前调用步进钩子(上层模型设置负载)
+      2. 各电机发送反馈帧, 每帧触发一次接收中断回调
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef SIM_CAN_H
+#define SIM_CAN_H
+
+#include "struct_typedef.h"
+#include "main.h"
+#include "motor_sim.h"
+
+#define SIM_CAN_BUS_NUM     2u
+#define SIM_CAN_MAX_NODE    16u
+#define SIM_CAN_RX_FIFO_LEN 3u    //bxCAN硬件接收FIFO深度
+#define SIM_CAN_SUBSTEP     4u    //每毫秒电机模型步数
+
+#define SIM_CAN1 0u
+#define SIM_CAN2 1u
+
+/*总线上的一个电调*/
+typedef struct
+{
+    uint8_t bus;
+    uint16_t feedback_id;     //反馈帧ID
+    uint16_t command_id;      //控制帧ID
+    uint8_t command_slot;     //控制帧中的位置 0~3
+    bool_t online;            //0:不发送反馈帧 模拟掉线或断线
+    motor_sim_t motor;
+} sim_can_node_t;
+
+/*总线统计*/
+typedef struct
+{
+    uint32_t tx_count;        //控制器发送帧数
+    uint32_t rx_count;        //控制器接收帧数
+    uint32_t rx_overflow;     //接收FIFO溢出丢帧数
+    uint32_t unknown_tx;      //没有电调响应的控制帧数
+} sim_can_stat_t;
+
+/**
+  * @brief          每个电机步进前调用 用于设置负载转矩等
+  * @param[in]      dt: 步长 s
+  * @param[in]      user: 用户数据
+  * @retval         none
+  */
+typedef void (*sim_can_step_hook_t)(fp32 dt, void *user);
+
+extern CAN_HandleTypeDef hcan1;
+extern CAN_HandleTypeDef hcan2;
+
+/**
+  * @brief          清除总线上的电调与统计
+  * @param[in]      none
+  * @retval         none
+  */
+extern void sim_can_init(void);
+
+/**
+  * @brief          在总线上添加一个电调与电机
+  * @param[in]      bus: SIM_CAN1 或 SIM_CAN2
+  * @param[in]      feedback_id: 反馈帧ID 如CAN_3508_M1_ID
+  * @param[in]      type: 电机型号
+  * @param[in]      bus_voltage: 母线电压 V
+  * @retval         电调节点, ID不合法或已满返回NULL
+  */
+extern sim_can_node_t *sim_can_add_motor(uint8_t bus, uint16_t feedback_id, motor_sim_type_e type, fp32 bus_voltage);
+
+/**
+  * @brief          设置电机步进钩子
+  * @param[in]      hook: 钩子函数, NULL为不调用
+  * @param[in]      user: 用户数据
+  * @retval         none
+  */
+extern void sim_can_set_step_hook(sim_can_step_hook_t hook, void *user);
+
+/**
+  * @brief          推进1ms 并发送全部在线电调的反馈帧
+  * @param[in]      none
+  * @retval         none
+  */
+extern void sim_can_tick_1ms(void);
+
+/**
+  * @brief          总线统计
+  * @param[in]      bus: SIM_CAN1 或 SIM_CAN2
+  * @retval         统计数据
+  */
+extern const sim_can_stat_t *sim_can_get_stat(uint8_t bus);
+
+/**
+  * @brief          按添加顺序获取节点 用于场景模拟掉线
+  * @param[in]      index: 添加顺序 从0开始
+  * @retval         节点 不存在时为NULL
+  */
+extern sim_can_node_t *sim_can_get_node(uint8_t index);
+
+#endif
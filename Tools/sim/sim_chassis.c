@@ -0,0 +1,112 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_chassis.c/h
+  * @brief      底盘仿真装配，初始化仿真OS、CAN、遥控器、flash与参数，
+  *             添加四个底盘电机与底盘刚体模型，按场景运行未修改的chassis_task。
+  * @note       仿真器与基准测试共用，每个进程只能运行一次(sim_flash映射固定地址)。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <stddef.h>
+#include "CAN_receive.h"
+#include "chassis_task.h"
+#include "param.h"
+#include "sim_os.h"
+#include "sim_can.h"
+#include "sim_rc.h"
+#include "sim_flash.h"
+#include "sim_chassis.h"
+
+static sim_scenario_t sim_chassis_scenario_data;
+static chassis_body_t sim_chassis_body_data;
+static motor_sim_t *sim_chassis_motor_point[CHASSIS_BODY_WHEEL_NUM];
+static sim_chassis_tick_hook_t sim_chassis_tick_hook;
+static void *sim_chassis_tick_user;
+
+static void sim_chassis_body_step(fp32 dt, void *user)
+{
+    (void)user;
+    chassis_body_step(&sim_chassis_body_data, dt);
+}
+
+static void sim_chassis_tick(uint32_t now_ms, void *user)
+{
+    (void)user;
+
+    sim_can_tick_1ms();
+    sim_rc_tick_1ms(now_ms);
+    sim_scenario_tick_1ms(&sim_chassis_scenario_data, now_ms);
+
+    if (sim_chassis_tick_hook != NULL)
+    {
+        sim_chassis_tick_hook(now_ms, sim_chassis_tick_user);
+    }
+}
+
+bool_t sim_chassis_init(const chassis_body_param_t *param)
+{
+    static const uint16_t chassis_id[CHASSIS_BODY_WHEEL_NUM] = {CAN_3508_M1_ID, CAN_3508_M2_ID, CAN_3508_M3_ID, CAN_3508_M4_ID};
+    uint8_t i;
+
+    sim_os_init();
+    sim_can_init();
+    sim_rc_init();
+    if (!sim_flash_init())
+    {
+        return 0;
+    }
+    param_init();
+
+    for (i = 0; i < CHASSIS_BODY_WHEEL_NUM; i++)
+    {
+        sim_chassis_motor_point[i] = &sim_can_add_motor(SIM_CAN1, chassis_id[i], MOTOR_SIM_M3508, SIM_CHASSIS_BUS_VOLTAGE)->motor;
+    }
+    chassis_body_init(&sim_chassis_body_data, param, sim_chassis_motor_point);
+    sim_can_set_step_hook(sim_chassis_body_step, NULL);
+
+    sim_scenario_init(&sim_chassis_scenario_data);
+    sim_chassis_tick_hook = NULL;
+    sim_chassis_tick_user = NULL;
+    sim_os_set_tick_hook(sim_chassis_tick, NULL);
+
+    return 1;
+}
+
+sim_scenario_t *sim_chassis_scenario(void)
+{
+    return &sim_chassis_scenario_data;
+}
+
+const chassis_body_t *sim_chassis_body(void)
+{
+    return &sim_chassis_body_data;
+}
+
+const motor_sim_t *sim_chassis_motor(uint8_t index)
+{
+    if (index >= CHASSIS_BODY_WHEEL_NUM)
+    {
+        return NULL;
+    }
+    return sim_chassis_motor_point[index];
+}
+
+void sim_chassis_set_tick_hook(sim_chassis_tick_hook_t hook, void *user)
+{
+    sim_chassis_tick_hook = hook;
+    sim_chassis_tick_user = user;
+}
+
+void sim_chassis_run(uint32_t duration_ms)
+{
+    sim_os_run(chassis_task, duration_ms);
+}
@@ -0,0 +1,84 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_chassis.c/h
+  * @brief      底盘仿真装配，初始化仿真OS、CAN、遥控器、flash与参数，
+  *             添加四个底盘电机与底盘刚体模型，按场景运行未修改的chassis_task。
+  * @note       仿真器与基准测试共用，每个进程只能运行一次(sim_flash映射固定地址)。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    使用方法:
+      chassis_body_default_param(&param, type);
+      sim_chassis_init(&param);
+      sim_scenario_parse_line(sim_chassis_scenario(), "...");   //或sim_scenario_load
+      sim_chassis_set_tick_hook(hook, user);                    //每毫秒记录数据
+      sim_chassis_run(duration_ms);
+    每个仿真毫秒的顺序: 电机与底盘推进1ms(发送反馈帧) -> 遥控器 -> 场景 -> 钩子
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef SIM_CHASSIS_H
+#define SIM_CHASSIS_H
+
+#include "struct_typedef.h"
+#include "chassis_body.h"
+#include "sim_scenario.h"
+
+#define SIM_CHASSIS_BUS_VOLTAGE 24.0f  //V
+
+/**
+  * @brief          每个仿真毫秒调用的钩子
+  * @param[in]      now_ms: 当前仿真时间 ms
+  * @param[in]      user: 用户数据
+  * @retval         none
+  */
+typedef void (*sim_chassis_tick_hook_t)(uint32_t now_ms, void *user);
+
+/**
+  * @brief          初始化全部仿真模块与固件参数 添加底盘电机与底盘模型 清空场景
+  * @param[in]      param: 底盘参数
+  * @retval         1:成功 0:flash映射失败
+  */
+extern bool_t sim_chassis_init(const chassis_body_param_t *param);
+
+/**
+  * @brief          场景 运行前添加动作
+  * @param[in]      none
+  * @retval         场景指针
+  */
+extern sim_scenario_t *sim_chassis_scenario(void);
+
+/**
+  * @brief          底盘刚体模型
+  * @param[in]      none
+  * @retval         底盘状态指针
+  */
+extern const chassis_body_t *sim_chassis_body(void);
+
+/**
+  * @brief          底盘电机模型
+  * @param[in]      index: 电机编号 0~3 与chassis_task一致
+  * @retval         电机模型指针
+  */
+extern const motor_sim_t *sim_chassis_motor(uint8_t index);
+
+/**
+  * @brief          设置每毫秒钩子
+  * @param[in]      hook: 钩子 NULL取消
+  * @param[in]      user: 用户数据
+  * @retval         none
+  */
+extern void sim_chassis_set_tick_hook(sim_chassis_tick_hook_t hook, void *user);
+
+/**
+  * @brief          运行chassis_task 到达时长后返回
+  * @param[in]      duration_ms: 仿真时长 ms
+  * @retval         none
+  */
+extern void sim_chassis_run(uint32_t duration_ms);
+
+#endif
@@ -0,0 +1,99 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_cpu.c/h
+  * @brief      上位机仿真内核相关函数，实现main.h中的HAL_GetTick、__DMB、中断屏蔽与__get_PSP。
+  * @note       钩子中再执行__DMB时以depth=1调用钩子, 更深的嵌套不再调用。
+  *             PRIMASK每个线程独立, 关中断时持有全局锁, 多个线程不会同时处于关中断状态。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    抢占模拟: 目标板上高优先级任务可在写者任意两条指令之间运行,
+    共享数据的发布顺序由__DMB保证, 在__DMB处插入读者即覆盖写者发布过程中的每个中间状态
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <stddef.h>
+#include <pthread.h>
+#include "main.h"
+#include "cmsis_os.h"
+#include "sim_cpu.h"
+
+static sim_cpu_dmb_hook_t sim_dmb_hook;
+static __thread uint32_t sim_dmb_depth;
+static pthread_mutex_t sim_irq_lock = PTHREAD_MUTEX_INITIALIZER;
+static __thread uint32_t sim_primask;
+static __thread uint32_t sim_psp;
+
+SCB_Type sim_scb;
+
+void sim_cpu_set_dmb_hook(sim_cpu_dmb_hook_t hook)
+{
+    sim_dmb_hook = hook;
+    sim_dmb_depth = 0;
+}
+
+void sim_cpu_dmb(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (sim_dmb_hook != NULL && sim_dmb_depth < 2u)
+    {
+        sim_dmb_depth++;
+        sim_dmb_hook(sim_dmb_depth - 1u);
+        sim_dmb_depth--;
+    }
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return osKernelSysTick();
+}
+
+uint32_t __get_PRIMASK(void)
+{
+    return sim_primask;
+}
+
+void __disable_irq(void)
+{
+    if (!sim_primask)
+    {
+        pthread_mutex_lock(&sim_irq_lock);
+        sim_primask = 1;
+    }
+}
+
+void __enable_irq(void)
+{
+    if (sim_primask)
+    {
+        sim_primask = 0;
+        pthread_mutex_unlock(&sim_irq_lock);
+    }
+}
+
+void __set_PRIMASK(uint32_t primask)
+{
+    if (primask & 1u)
+    {
+        __disable_irq();
+    }
+    else
+    {
+        __enable_irq();
+    }
+}
+
+void sim_cpu_set_psp(uint32_t psp)
+{
+    sim_psp = psp;
+}
+
+uint32_t __get_PSP(void)
+{
+    return sim_psp;
+}
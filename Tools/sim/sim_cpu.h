@@ -0,0 +1,30 @@
+#ifndef SIM_CPU_H
+#define SIM_CPU_H
+
+#include "struct_typedef.h"
+
+/*
+  上位机仿真内核相关函数 实现main.h中的HAL_GetTick、__DMB、中断屏蔽与__get_PSP
+  HAL_GetTick返回仿真时间(sim_os.c), __DMB为完整内存屏障,
+  设置钩子后每次__DMB调用钩子, 单线程测试在钩子中调用读者函数, 模拟高优先级任务在该处抢占写者;
+  读者中的__DMB同样调用钩子, depth为1, 可用于统计读者重试次数、发现读者等待写者的死循环
+*/
+
+/*内存屏障钩子 depth: 0为被抢占的代码, 1为钩子中调用的代码*/
+typedef void (*sim_cpu_dmb_hook_t)(uint32_t depth);
+
+/**
+  * @brief          设置内存屏障钩子 同时清除本线程的嵌套深度(钩子中longjmp退出后调用)
+  * @param[in]      hook: 钩子函数, NULL清除
+  * @retval         none
+  */
+extern void sim_cpu_set_dmb_hook(sim_cpu_dmb_hook_t hook);
+
+/**
+  * @brief          设置本线程__get_PSP的返回值 模拟任务栈上的异常栈帧
+  * @param[in]      psp: 栈帧地址, 需在低4GB(用-no-pie编译的静态变量)
+  * @retval         none
+  */
+extern void sim_cpu_set_psp(uint32_t psp);
+
+#endif
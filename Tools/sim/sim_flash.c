@@ -0,0 +1,175 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_flash.c
+  * @brief      上位机仿真flash，实现bsp_flash.h接口，
+  *             参数扇区映射到与目标板相同的地址，param.c不需修改即可运行。
+  * @note       使用mmap固定地址映射，只支持Linux。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    擦除: 扇区全部写0xFF
+    写入: 与NOR flash一致只能把1写成0(按位与), 目标不是擦除值时返回失败
+    每次sim_flash_init重新映射并擦除, 仿真从默认参数开始
+    掉电: 第n次擦写只完成一部分(sim_flash_tear_e)并返回失败, 之后的擦写都失败,
+          sim_flash_power_on后内容保留, 模拟重新上电
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#define _DEFAULT_SOURCE //mmap MAP_FIXED_NOREPLACE
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "bsp_flash.h"
+#include "param.h"
+#include "sim_flash.h"
+
+#define SIM_FLASH_BASE ((uintptr_t)PARAM_FLASH_SECTOR0_ADDR)
+#define SIM_FLASH_SIZE (2u * PARAM_FLASH_SECTOR_SIZE)
+
+static uint8_t *sim_flash_mem;
+static uint32_t sim_flash_op;       //累计擦写次数
+static uint32_t sim_flash_cut_op;   //在第几次擦写时掉电 0不掉电
+static sim_flash_tear_e sim_flash_tear;
+static uint32_t sim_flash_seed;
+static bool_t sim_flash_off;
+
+static uint32_t sim_flash_rand(void)
+{
+    sim_flash_seed ^= sim_flash_seed << 13;
+    sim_flash_seed ^= sim_flash_seed >> 17;
+    sim_flash_seed ^= sim_flash_seed << 5;
+    return sim_flash_seed;
+}
+
+//计数本次擦写 返回1表示本次掉电
+static bool_t sim_flash_power_cut(void)
+{
+    sim_flash_op++;
+    if (sim_flash_cut_op != 0 && sim_flash_op == sim_flash_cut_op)
+    {
+        sim_flash_off = 1;
+        return 1;
+    }
+    return 0;
+}
+
+//扇区号 -> 映射区中的偏移
+static int32_t sim_flash_sector_offset(uint32_t sector)
+{
+    if (sector == FLASH_SECTOR_10)
+    {
+        return 0;
+    }
+    else if (sector == FLASH_SECTOR_11)
+    {
+        return (int32_t)PARAM_FLASH_SECTOR_SIZE;
+    }
+    return -1;
+}
+
+bool_t sim_flash_init(void)
+{
+    if (sim_flash_mem == NULL)
+    {
+        void *mem = mmap((void *)SIM_FLASH_BASE, SIM_FLASH_SIZE, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+        if (mem == MAP_FAILED || mem != (void *)SIM_FLASH_BASE)
+        {
+            fprintf(stderr, "sim_flash: cannot map 0x%08lx\n", (unsigned long)SIM_FLASH_BASE);
+            return 0;
+        }
+        sim_flash_mem = (uint8_t *)mem;
+    }
+
+    memset(sim_flash_mem, 0xFF, SIM_FLASH_SIZE);
+    sim_flash_power_on();
+    return 1;
+}
+
+void sim_flash_cut(uint32_t op, sim_flash_tear_e tear, uint32_t seed)
+{
+    sim_flash_cut_op = (op != 0) ? sim_flash_op + op : 0;
+    sim_flash_tear = tear;
+    sim_flash_seed = (seed != 0) ? seed : 1u;
+}
+
+void sim_flash_power_on(void)
+{
+    sim_flash_cut_op = 0;
+    sim_flash_off = 0;
+}
+
+bool_t sim_flash_is_off(void)
+{
+    return sim_flash_off;
+}
+
+uint32_t sim_flash_op_count(void)
+{
+    return sim_flash_op;
+}
+
+bool_t bsp_flash_erase_sector(uint32_t sector)
+{
+    int32_t offset = sim_flash_sector_offset(sector);
+
+    if (sim_flash_mem == NULL || offset < 0 || sim_flash_off)
+    {
+        return 0;
+    }
+    if (sim_flash_power_cut())
+    {
+        uint32_t len = 0;
+
+        if (sim_flash_tear == SIM_FLASH_TEAR_ALL)
+        {
+            len = PARAM_FLASH_SECTOR_SIZE;
+        }
+        else if (sim_flash_tear == SIM_FLASH_TEAR_RANDOM)
+        {
+            len = sim_flash_rand() % PARAM_FLASH_SECTOR_SIZE;
+        }
+        memset(sim_flash_mem + offset, 0xFF, len);
+        return 0;
+    }
+    memset(sim_flash_mem + offset, 0xFF, PARAM_FLASH_SECTOR_SIZE);
+    return 1;
+}
+
+bool_t bsp_flash_program_word(uint32_t address, uint32_t data)
+{
+    uint32_t *word;
+
+    if (sim_flash_mem == NULL || (address & 0x03u) != 0 || address < SIM_FLASH_BASE ||
+        address + 4u > SIM_FLASH_BASE + SIM_FLASH_SIZE || sim_flash_off)
+    {
+        return 0;
+    }
+
+    word = (uint32_t *)(uintptr_t)address;
+    if (sim_flash_power_cut())
+    {
+        //应写为0的位中只有一部分写入
+        uint32_t mask = 0;
+
+        if (sim_flash_tear == SIM_FLASH_TEAR_ALL)
+        {
+            mask = 0xFFFFFFFFu;
+        }
+        else if (sim_flash_tear == SIM_FLASH_TEAR_RANDOM)
+        {
+            mask = sim_flash_rand();
+        }
+        *word &= ~(~data & mask);
+        return 0;
+    }
+    *word &= data;
+    return (*word == data) ? 1 : 0;
+}
@@ -0,0 +1,56 @@
+#ifndef SIM_FLASH_H
+#define SIM_FLASH_H
+
+#include "struct_typedef.h"
+
+/*
+  上位机仿真flash 参数扇区映射到目标板地址 实现bsp_flash.h接口
+  可在第n次擦写时掉电: 该次操作只完成一部分, 之后的擦写全部失败, 直到sim_flash_power_on
+*/
+
+/*掉电时正在进行的操作完成了多少*/
+typedef enum
+{
+    SIM_FLASH_TEAR_NONE = 0,    //没有改变任何位
+    SIM_FLASH_TEAR_RANDOM,      //写入: 随机一部分应写0的位变为0; 擦除: 扇区前随机长度变为0xFF
+    SIM_FLASH_TEAR_ALL,         //操作完成后掉电
+} sim_flash_tear_e;
+
+/**
+  * @brief          映射并擦除参数扇区 在param_init之前调用
+  * @param[in]      none
+  * @retval         1:成功 0:地址被占用
+  */
+extern bool_t sim_flash_init(void);
+
+/**
+  * @brief          设置掉电点
+  * @param[in]      op: 从现在起第op次擦写时掉电, 1为下一次, 0取消
+  * @param[in]      tear: 掉电时该次操作完成了多少
+  * @param[in]      seed: SIM_FLASH_TEAR_RANDOM的随机种子, 不能为0
+  * @retval         none
+  */
+extern void sim_flash_cut(uint32_t op, sim_flash_tear_e tear, uint32_t seed);
+
+/**
+  * @brief          重新上电 保留flash内容, 取消掉电点
+  * @param[in]      none
+  * @retval         none
+  */
+extern void sim_flash_power_on(void);
+
+/**
+  * @brief          是否已掉电
+  * @param[in]      none
+  * @retval         1:已掉电
+  */
+extern bool_t sim_flash_is_off(void);
+
+/**
+  * @brief          累计擦写次数(包括掉电后失败的)
+  * @param[in]      none
+  * @retval         擦写次数
+  */
+extern uint32_t sim_flash_op_count(void);
+
+#endif
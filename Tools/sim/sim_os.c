@@ -0,0 +1,94 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_os.c/h
+  * @brief      上位机仿真时钟，替代osDelay/osKernelSysTick，
+  *             任务函数单线程运行，osDelay推进仿真时间并按1ms步进被控对象。
+  * @note       
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmsis_os.h"
+#include "sim_os.h"
+
+static uint32_t sim_now_ms;
+static uint32_t sim_end_ms;
+static uint8_t sim_running;
+static jmp_buf sim_exit;
+
+static sim_os_tick_hook_t sim_tick_hook;
+static void *sim_tick_user;
+
+void sim_os_init(void)
+{
+    sim_now_ms = 0;
+    sim_end_ms = 0;
+    sim_running = 0;
+    sim_tick_hook = NULL;
+    sim_tick_user = NULL;
+}
+
+void sim_os_set_tick_hook(sim_os_tick_hook_t hook, void *user)
+{
+    sim_tick_hook = hook;
+    sim_tick_user = user;
+}
+
+void sim_os_run(void (*task)(void const *argument), uint32_t duration_ms)
+{
+    if (task == NULL || duration_ms == 0)
+    {
+        return;
+    }
+
+    sim_end_ms = sim_now_ms + duration_ms;
+    sim_running = 1;
+    if (setjmp(sim_exit) == 0)
+    {
+        task(NULL);
+    }
+    sim_running = 0;
+}
+
+uint32_t sim_os_now(void)
+{
+    return sim_now_ms;
+}
+
+osStatus osDelay(uint32_t millisec)
+{
+    while (millisec--)
+    {
+        sim_now_ms++;
+        if (sim_tick_hook != NULL)
+        {
+            sim_tick_hook(sim_now_ms, sim_tick_user);
+        }
+        //仿真时间到 返回sim_os_run
+        if (sim_running && sim_now_ms >= sim_end_ms)
+        {
+            longjmp(sim_exit, 1);
+        }
+    }
+    return osOK;
+}
+
+uint32_t osKernelSysTick(void)
+{
+    return sim_now_ms;
+}
+
+int32_t osKernelRunning(void)
+{
+    return sim_running;
+}
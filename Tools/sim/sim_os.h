@@ -0,0 +1,63 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_os.c/h
+  * @brief      上位机仿真时钟，替代osDelay/osKernelSysTick，
+  *             任务函数单线程运行，osDelay推进仿真时间并按1ms步进被控对象。
+  * @note       仿真时间与实际时间无关，运行速度只取决于计算量。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    任务函数为无限循环, sim_os_run用setjmp保存现场, 仿真时间到达后
+    osDelay中longjmp返回, 任务的栈变量随之丢弃; 任务的静态变量保留,
+    再次运行前由任务自己的初始化函数重新初始化
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef SIM_OS_H
+#define SIM_OS_H
+
+#include "struct_typedef.h"
+
+/**
+  * @brief          每个仿真毫秒调用一次 在被控对象推进1ms之后
+  * @param[in]      now_ms: 当前仿真时间 ms
+  * @param[in]      user: 用户数据
+  * @retval         none
+  */
+typedef void (*sim_os_tick_hook_t)(uint32_t now_ms, void *user);
+
+/**
+  * @brief          仿真时间清零 清除钩子
+  * @param[in]      none
+  * @retval         none
+  */
+extern void sim_os_init(void);
+
+/**
+  * @brief          设置毫秒钩子 用于推进被控对象与场景输入
+  * @param[in]      hook: 钩子函数
+  * @param[in]      user: 用户数据
+  * @retval         none
+  */
+extern void sim_os_set_tick_hook(sim_os_tick_hook_t hook, void *user);
+
+/**
+  * @brief          运行任务函数直到仿真时间增加duration_ms
+  * @param[in]      task: 任务函数 与osThreadDef使用的函数相同
+  * @param[in]      duration_ms: 运行时长 ms
+  * @retval         none
+  */
+extern void sim_os_run(void (*task)(void const *argument), uint32_t duration_ms);
+
+/**
+  * @brief          当前仿真时间
+  * @param[in]      none
+  * @retval         ms
+  */
+extern uint32_t sim_os_now(void);
+
+#endif
@@ -0,0 +1,96 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_rc.c/h
+  * @brief      上位机仿真遥控器，实现remote_control.h中控制任务使用的接口。
+  * @note       
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <stddef.h>
+#include <string.h>
+#include "sim_rc.h"
+
+static RC_ctrl_t sim_rc_input;
+static RC_ctrl_t sim_rc_frame;
+static RC_status_t sim_rc_status;
+static bool_t sim_rc_connected;
+
+void sim_rc_init(void)
+{
+    memset(&sim_rc_input, 0, sizeof(sim_rc_input));
+    sim_rc_input.rc.switch_channel[0] = RC_SW_DOWN;
+    sim_rc_input.rc.switch_channel[1] = RC_SW_DOWN;
+    sim_rc_frame = sim_rc_input;
+
+    memset(&sim_rc_status, 0, sizeof(sim_rc_status));
+    sim_rc_status.failsafe = 1;
+    sim_rc_connected = 1;
+}
+
+RC_ctrl_t *sim_rc_input_point(void)
+{
+    return &sim_rc_input;
+}
+
+void sim_rc_set_connected(bool_t connected)
+{
+    sim_rc_connected = connected;
+}
+
+void sim_rc_tick_1ms(uint32_t now_ms)
+{
+    if (sim_rc_connected && (now_ms % RC_FRAME_PERIOD_MS) == 0)
+    {
+        sim_rc_frame = sim_rc_input;
+        sim_rc_status.frame_interval = now_ms - sim_rc_status.last_rx_time;
+        sim_rc_status.last_rx_time = now_ms;
+        sim_rc_status.frame_count++;
+        if (sim_rc_status.valid_streak < RC_RECOVER_FRAME_NUM)
+        {
+            sim_rc_status.valid_streak++;
+        }
+        if (sim_rc_status.failsafe && sim_rc_status.valid_streak >= RC_RECOVER_FRAME_NUM)
+        {
+            sim_rc_status.failsafe = 0;
+        }
+    }
+
+    if (!sim_rc_status.failsafe && now_ms - sim_rc_status.last_rx_time > RC_LOST_TIME_MS)
+    {
+        sim_rc_status.failsafe = 1;
+        sim_rc_status.valid_streak = 0;
+        sim_rc_status.lost_count++;
+    }
+}
+
+const RC_ctrl_t *get_remote_control_point(void)
+{
+    return &sim_rc_frame;
+}
+
+const RC_status_t *get_remote_control_status_point(void)
+{
+    return &sim_rc_status;
+}
+
+bool_t remote_control_is_failsafe(void)
+{
+    return sim_rc_status.failsafe;
+}
+
+void remote_control_read(RC_ctrl_t *rc_out)
+{
+    if (rc_out != NULL)
+    {
+        *rc_out = sim_rc_frame;
+    }
+}
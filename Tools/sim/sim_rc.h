@@ -0,0 +1,54 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_rc.c/h
+  * @brief      上位机仿真遥控器，实现remote_control.h中控制任务使用的接口，
+  *             场景修改输入后按DBUS帧周期发布，掉线与恢复按RC_LOST_TIME_MS、
+  *             RC_RECOVER_FRAME_NUM判定，与固件行为一致。
+  * @note       
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    场景通过sim_rc_input_point修改下一帧的输入, sim_rc_set_connected模拟接收机断线,
+    sim_rc_tick_1ms在每个仿真毫秒调用
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef SIM_RC_H
+#define SIM_RC_H
+
+#include "struct_typedef.h"
+#include "remote_control.h"
+
+/**
+  * @brief          输入清零 开关拨到下档 接收机连接 未收到帧前处于失控保护
+  * @param[in]      none
+  * @retval         none
+  */
+extern void sim_rc_init(void);
+
+/**
+  * @brief          下一帧的输入 场景直接修改
+  * @param[in]      none
+  * @retval         输入数据指针
+  */
+extern RC_ctrl_t *sim_rc_input_point(void);
+
+/**
+  * @brief          接收机连接状态
+  * @param[in]      connected: 0:断线 不再产生帧
+  * @retval         none
+  */
+extern void sim_rc_set_connected(bool_t connected);
+
+/**
+  * @brief          每个仿真毫秒调用 按帧周期发布输入并更新失控保护
+  * @param[in]      now_ms: 当前仿真时间 ms
+  * @retval         none
+  */
+extern void sim_rc_tick_1ms(uint32_t now_ms);
+
+#endif
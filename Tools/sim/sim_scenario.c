@@ -0,0 +1,408 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_scenario.c/h
+  * @brief      仿真场景，按时间给出摇杆、开关、键鼠与接收机连接状态，
+  *             摇杆可在给定时间内线性变化，可从文本文件加载或在代码中添加。
+  * @note       每个仿真毫秒调用sim_scenario_tick_1ms，修改sim_rc的输入。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#define _DEFAULT_SOURCE //strtok_r
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim_rc.h"
+#include "sim_can.h"
+#include "sim_scenario.h"
+
+#define SIM_SCENARIO_LINE_LEN   256
+#define SIM_SCENARIO_MAX_TOKEN  16
+
+//按键名 顺序与keyboard.value位序(pc_key_e)一致
+static const char *const sim_scenario_key_name[16] =
+{
+    "W", "S", "A", "D", "SHIFT", "CTRL", "Q", "E", "R", "F", "G", "Z", "X", "C", "V", "B",
+};
+
+//RC_ctrl_t为紧凑结构 不取成员地址
+static int16_t sim_scenario_axis_get(const RC_ctrl_t *rc, uint8_t index)
+{
+    if (index < 5)
+    {
+        return rc->rc.remote_channel[index];
+    }
+    return (index == 5) ? rc->mouse.x : rc->mouse.y;
+}
+
+static void sim_scenario_axis_set(RC_ctrl_t *rc, uint8_t index, int32_t value)
+{
+    if (index < 5)
+    {
+        rc->rc.remote_channel[index] = (int16_t)value;
+    }
+    else if (index == 5)
+    {
+        rc->mouse.x = (int16_t)value;
+    }
+    else
+    {
+        rc->mouse.y = (int16_t)value;
+    }
+}
+
+//解析十进制整数 整个字符串必须是数字
+static bool_t sim_scenario_parse_int(const char *text, int32_t *value)
+{
+    char *end;
+    long result = strtol(text, &end, 10);
+
+    if (end == text || *end != '\0')
+    {
+        return 0;
+    }
+    *value = (int32_t)result;
+    return 1;
+}
+
+//key=W|SHIFT
+static bool_t sim_scenario_parse_key(const char *text, int32_t *value)
+{
+    char name[SIM_SCENARIO_LINE_LEN];
+    char *save = NULL;
+    char *token;
+    uint8_t i;
+
+    *value = 0;
+    if (strcmp(text, "none") == 0)
+    {
+        return 1;
+    }
+
+    strncpy(name, text, sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    for (token = strtok_r(name, "|", &save); token != NULL; token = strtok_r(NULL, "|", &save))
+    {
+        for (i = 0; i < 16; i++)
+        {
+            if (strcmp(token, sim_scenario_key_name[i]) == 0)
+            {
+                *value |= 1 << i;
+                break;
+            }
+        }
+        if (i == 16)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static bool_t sim_scenario_parse_switch(const char *text, int32_t *value)
+{
+    if (strcmp(text, "up") == 0)
+    {
+        *value = RC_SW_UP;
+    }
+    else if (strcmp(text, "mid") == 0)
+    {
+        *value = RC_SW_MID;
+    }
+    else if (strcmp(text, "down") == 0)
+    {
+        *value = RC_SW_DOWN;
+    }
+    else
+    {
+        return 0;
+    }
+    return 1;
+}
+
+//解析一个动作 name=value 或 end
+static bool_t sim_scenario_parse_token(char *token, sim_scenario_event_t *event)
+{
+    char *value = strchr(token, '=');
+
+    if (value == NULL)
+    {
+        if (strcmp(token, "end") == 0)
+        {
+            event->type = SIM_SCENARIO_END;
+            return 1;
+        }
+        return 0;
+    }
+    *value++ = '\0';
+
+    if (token[0] == 'c' && token[1] == 'h' && token[2] >= '0' && token[2] <= '4' && token[3] == '\0')
+    {
+        event->type = SIM_SCENARIO_AXIS;
+        event->index = (uint8_t)(token[2] - '0');
+        return sim_scenario_parse_int(value, &event->value);
+    }
+    if (strcmp(token, "mx") == 0 || strcmp(token, "my") == 0)
+    {
+        event->type = SIM_SCENARIO_AXIS;
+        event->index = (token[1] == 'x') ? 5 : 6;
+        return sim_scenario_parse_int(value, &event->value);
+    }
+    if (token[0] == 's' && token[1] == 'w' && (token[2] == '0' || token[2] == '1') && token[3] == '\0')
+    {
+        event->type = SIM_SCENARIO_SWITCH;
+        event->index = (uint8_t)(token[2] - '0');
+        return sim_scenario_parse_switch(value, &event->value);
+    }
+    if (strcmp(token, "key") == 0)
+    {
+        event->type = SIM_SCENARIO_KEY;
+        return sim_scenario_parse_key(value, &event->value);
+    }
+    if (strcmp(token, "ml") == 0 || strcmp(token, "mr") == 0)
+    {
+        event->type = SIM_SCENARIO_MOUSE_BUTTON;
+        event->index = (token[1] == 'l') ? 0 : 1;
+        return sim_scenario_parse_int(value, &event->value);
+    }
+    if (strcmp(token, "rc") == 0)
+    {
+        event->type = SIM_SCENARIO_RC_LINK;
+        return sim_scenario_parse_int(value, &event->value);
+    }
+    if (token[0] == 'f' && token[1] == 'b' && token[2] >= '0' && token[2] <= '9' && token[3] == '\0')
+    {
+        event->type = SIM_SCENARIO_FEEDBACK;
+        event->index = (uint8_t)(token[2] - '0');
+        return sim_scenario_parse_int(value, &event->value);
+    }
+    return 0;
+}
+
+void sim_scenario_init(sim_scenario_t *scenario)
+{
+    memset(scenario, 0, sizeof(*scenario));
+}
+
+bool_t sim_scenario_add(sim_scenario_t *scenario, const sim_scenario_event_t *event)
+{
+    uint16_t i;
+
+    if (scenario->count >= SIM_SCENARIO_MAX_EVENT)
+    {
+        return 0;
+    }
+
+    //插入排序 相同时间保持添加顺序
+    i = scenario->count;
+    while (i > 0 && scenario->event[i - 1].time_ms > event->time_ms)
+    {
+        scenario->event[i] = scenario->event[i - 1];
+        i--;
+    }
+    scenario->event[i] = *event;
+    scenario->count++;
+
+    if (event->type == SIM_SCENARIO_END && (scenario->end_ms == 0 || event->time_ms < scenario->end_ms))
+    {
+        scenario->end_ms = event->time_ms;
+    }
+    return 1;
+}
+
+bool_t sim_scenario_parse_line(sim_scenario_t *scenario, const char *line)
+{
+    char text[SIM_SCENARIO_LINE_LEN];
+    char *token[SIM_SCENARIO_MAX_TOKEN];
+    sim_scenario_event_t event[SIM_SCENARIO_MAX_TOKEN];
+    char *save = NULL;
+    char *comment;
+    int32_t time_ms;
+    uint32_t ramp_ms = 0;
+    uint8_t token_num = 0;
+    uint8_t event_num = 0;
+    uint8_t i;
+
+    strncpy(text, line, sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+    comment = strchr(text, '#');
+    if (comment != NULL)
+    {
+        *comment = '\0';
+    }
+
+    for (token[token_num] = strtok_r(text, " \t\r\n,", &save); token[token_num] != NULL;
+         token[token_num] = strtok_r(NULL, " \t\r\n,", &save))
+    {
+        if (++token_num >= SIM_SCENARIO_MAX_TOKEN)
+        {
+            return 0;
+        }
+    }
+    if (token_num == 0)
+    {
+        return 1;
+    }
+    if (!sim_scenario_parse_int(token[0], &time_ms) || time_ms < 0 || token_num < 2)
+    {
+        return 0;
+    }
+
+    //先解析全部动作 ramp作用于同一行所有摇杆动作 与书写位置无关
+    for (i = 1; i < token_num; i++)
+    {
+        if (strncmp(token[i], "ramp=", 5) == 0)
+        {
+            int32_t ramp;
+            if (!sim_scenario_parse_int(token[i] + 5, &ramp) || ramp < 0)
+            {
+                return 0;
+            }
+            ramp_ms = (uint32_t)ramp;
+            continue;
+        }
+        memset(&event[event_num], 0, sizeof(event[event_num]));
+        event[event_num].time_ms = (uint32_t)time_ms;
+        if (!sim_scenario_parse_token(token[i], &event[event_num]))
+        {
+            return 0;
+        }
+        event_num++;
+    }
+
+    for (i = 0; i < event_num; i++)
+    {
+        if (event[i].type == SIM_SCENARIO_AXIS)
+        {
+            event[i].ramp_ms = ramp_ms;
+        }
+        if (!sim_scenario_add(scenario, &event[i]))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+bool_t sim_scenario_load(sim_scenario_t *scenario, const char *path)
+{
+    char line[SIM_SCENARIO_LINE_LEN];
+    uint32_t line_num = 0;
+    FILE *file = fopen(path, "r");
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "%s: cannot open\n", path);
+        return 0;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        line_num++;
+        if (!sim_scenario_parse_line(scenario, line))
+        {
+            fprintf(stderr, "%s:%u: invalid scenario line: %s", path, (unsigned)line_num, line);
+            fclose(file);
+            return 0;
+        }
+    }
+
+    fclose(file);
+    return 1;
+}
+
+void sim_scenario_tick_1ms(sim_scenario_t *scenario, uint32_t now_ms)
+{
+    RC_ctrl_t *rc = sim_rc_input_point();
+    uint8_t i;
+
+    while (scenario->next < scenario->count && scenario->event[scenario->next].time_ms <= now_ms)
+    {
+        const sim_scenario_event_t *event = &scenario->event[scenario->next++];
+
+        switch (event->type)
+        {
+            case SIM_SCENARIO_AXIS:
+            {
+                sim_scenario_ramp_t *ramp = &scenario->ramp[event->index];
+
+                ramp->start_ms = event->time_ms;
+                ramp->ramp_ms = event->ramp_ms;
+                ramp->start_value = sim_scenario_axis_get(rc, event->index);
+                ramp->target_value = event->value;
+                if (event->ramp_ms == 0)
+                {
+                    sim_scenario_axis_set(rc, event->index, event->value);
+                }
+                break;
+            }
+
+            case SIM_SCENARIO_SWITCH:
+                rc->rc.switch_channel[event->index] = (char)event->value;
+                break;
+
+            case SIM_SCENARIO_KEY:
+                rc->keyboard.value = (uint16_t)event->value;
+                break;
+
+            case SIM_SCENARIO_MOUSE_BUTTON:
+                if (event->index == 0)
+                {
+                    rc->mouse.press_left = (uint8_t)(event->value != 0);
+                }
+                else
+                {
+                    rc->mouse.press_right = (uint8_t)(event->value != 0);
+                }
+                break;
+
+            case SIM_SCENARIO_RC_LINK:
+                sim_rc_set_connected(event->value != 0);
+                break;
+
+            case SIM_SCENARIO_FEEDBACK:
+            {
+                sim_can_node_t *node = sim_can_get_node(event->index);
+                if (node != NULL)
+                {
+                    node->online = (bool_t)(event->value != 0);
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    //摇杆线性变化
+    for (i = 0; i < SIM_SCENARIO_AXIS_NUM; i++)
+    {
+        sim_scenario_ramp_t *ramp = &scenario->ramp[i];
+        uint32_t elapsed;
+
+        if (ramp->ramp_ms == 0)
+        {
+            continue;
+        }
+        elapsed = now_ms - ramp->start_ms;
+        if (elapsed >= ramp->ramp_ms)
+        {
+            sim_scenario_axis_set(rc, i, ramp->target_value);
+            ramp->ramp_ms = 0;
+        }
+        else
+        {
+            sim_scenario_axis_set(rc, i, ramp->start_value +
+                (int32_t)((int64_t)(ramp->target_value - ramp->start_value) * (int64_t)elapsed / (int64_t)ramp->ramp_ms));
+        }
+    }
+}
@@ -0,0 +1,121 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_scenario.c/h
+  * @brief      仿真场景，按时间给出摇杆、开关、键鼠与接收机连接状态，
+  *             摇杆可在给定时间内线性变化，可从文本文件加载或在代码中添加。
+  * @note       每个仿真毫秒调用sim_scenario_tick_1ms，修改sim_rc的输入。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    场景文件每行: 时间ms 动作 [动作 ...], #之后为注释, 时间可以不按顺序
+      ch0~ch4=值        摇杆通道 -660~660
+      mx=值 my=值       鼠标移动
+      ramp=ms           同一行的摇杆与鼠标移动在该时间内从当前值线性变化到目标值
+      sw0/sw1=up|mid|down
+      key=W|SHIFT       按住的按键, key=none全部松开, 按键名同pc_key_e
+      ml=0/1 mr=0/1     鼠标左右键
+      rc=0/1            接收机连接/断线
+      fb0~fb9=0/1       第N个仿真电机(sim_can添加顺序)发送/停止发送反馈帧, 模拟反馈丢失
+      end               场景结束时间
+    例:
+      0     sw0=down
+      200   sw0=up
+      500   ch1=330 ramp=200    #0.5s起200ms内推到半杆
+      2000  ch1=0
+      3000  end
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+#ifndef SIM_SCENARIO_H
+#define SIM_SCENARIO_H
+
+#include "struct_typedef.h"
+
+#define SIM_SCENARIO_MAX_EVENT 256u
+#define SIM_SCENARIO_AXIS_NUM  7u     //ch0~ch4 mx my
+
+/*动作类型*/
+typedef enum
+{
+    SIM_SCENARIO_AXIS = 0,      //摇杆通道或鼠标移动 index: 0~4通道 5:mx 6:my
+    SIM_SCENARIO_SWITCH,        //开关 index: 0~1 value: RC_SW_*
+    SIM_SCENARIO_KEY,           //键盘 value: keyboard.value
+    SIM_SCENARIO_MOUSE_BUTTON,  //鼠标键 index: 0左 1右
+    SIM_SCENARIO_RC_LINK,       //接收机连接 value: 0断线 1连接
+    SIM_SCENARIO_FEEDBACK,      //电机反馈 index: sim_can节点序号 value: 0停止 1恢复
+    SIM_SCENARIO_END,           //场景结束
+} sim_scenario_type_e;
+
+/*场景动作*/
+typedef struct
+{
+    uint32_t time_ms;
+    uint8_t type;               //sim_scenario_type_e
+    uint8_t index;
+    int32_t value;
+    uint32_t ramp_ms;           //只对SIM_SCENARIO_AXIS有效 0:立即变化
+} sim_scenario_event_t;
+
+/*摇杆线性变化*/
+typedef struct
+{
+    uint32_t start_ms;
+    uint32_t ramp_ms;           //0:没有进行中的变化
+    int32_t start_value;
+    int32_t target_value;
+} sim_scenario_ramp_t;
+
+/*场景*/
+typedef struct
+{
+    sim_scenario_event_t event[SIM_SCENARIO_MAX_EVENT]; //按时间排序
+    uint16_t count;
+    uint16_t next;              //下一个执行的动作
+    uint32_t end_ms;            //0:没有end动作
+    sim_scenario_ramp_t ramp[SIM_SCENARIO_AXIS_NUM];
+} sim_scenario_t;
+
+/**
+  * @brief          清空场景
+  * @param[out]     scenario: 场景
+  * @retval         none
+  */
+extern void sim_scenario_init(sim_scenario_t *scenario);
+
+/**
+  * @brief          添加一个动作 相同时间的动作按添加顺序执行
+  * @param[in,out]  scenario: 场景
+  * @param[in]      event: 动作
+  * @retval         1:成功 0:动作数超过SIM_SCENARIO_MAX_EVENT
+  */
+extern bool_t sim_scenario_add(sim_scenario_t *scenario, const sim_scenario_event_t *event);
+
+/**
+  * @brief          解析一行场景文本并添加动作
+  * @param[in,out]  scenario: 场景
+  * @param[in]      line: 一行文本 格式见文件说明
+  * @retval         1:成功(含空行与注释) 0:格式错误
+  */
+extern bool_t sim_scenario_parse_line(sim_scenario_t *scenario, const char *line);
+
+/**
+  * @brief          从文件加载场景 追加到已有动作之后 出错时在stderr给出行号
+  * @param[in,out]  scenario: 场景
+  * @param[in]      path: 文件路径
+  * @retval         1:成功 0:打开失败或格式错误
+  */
+extern bool_t sim_scenario_load(sim_scenario_t *scenario, const char *path);
+
+/**
+  * @brief          每个仿真毫秒调用 执行到期的动作 更新摇杆线性变化 写入sim_rc输入
+  * @param[in,out]  scenario: 场景
+  * @param[in]      now_ms: 当前仿真时间 ms
+  * @retval         none
+  */
+extern void sim_scenario_tick_1ms(sim_scenario_t *scenario, uint32_t now_ms);
+
+#endif
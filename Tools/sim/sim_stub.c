@@ -0,0 +1,67 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_stub.c
+  * @brief      上位机仿真中不需要的固件模块的空实现(遥测、黑匣子、任务执行时间统计)，
+  *             只保留接口，使控制任务源码不需修改即可链接。
+  * @note       
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include "telemetry_task.h"
+#include "blackbox.h"
+#include "task_registry.h"
+
+static int16_t sim_telemetry_channel_num;
+static uint32_t sim_blackbox_frozen;
+
+int16_t telemetry_register(const char *name, const volatile void *addr, telemetry_type_e type, uint8_t decimation)
+{
+    (void)name;
+    (void)addr;
+    (void)type;
+    (void)decimation;
+
+    if (sim_telemetry_channel_num >= TELEMETRY_MAX_CHANNEL)
+    {
+        return -1;
+    }
+    return sim_telemetry_channel_num++;
+}
+
+void blackbox_write(blackbox_lane_e lane, uint8_t type, const void *data, uint8_t len)
+{
+    (void)lane;
+    (void)type;
+    (void)data;
+    (void)len;
+}
+
+void blackbox_freeze(blackbox_freeze_e reason, uint32_t info)
+{
+    (void)info;
+    sim_blackbox_frozen = (uint32_t)reason + 1u;
+}
+
+uint32_t blackbox_is_frozen(void)
+{
+    return sim_blackbox_frozen;
+}
+
+void task_job_begin(task_id_e id)
+{
+    (void)id;
+}
+
+void task_job_end(task_id_e id)
+{
+    (void)id;
+}
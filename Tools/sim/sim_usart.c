@@ -0,0 +1,215 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       sim_usart.c/h
+  * @brief      上位机仿真串口与DMA数据流寄存器，实现main.h中的DMA使能、关闭与串口清除标志，
+  *             bsp_usart.c不需修改即可运行。
+  * @note       DMA地址寄存器为32位，缓冲区用MAP_32BIT映射在低4GB，只支持Linux x86-64。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    数据流行为按STM32F4参考手册:
+      双缓冲(DBM): NDTR为0时置TC, 翻转CT, 重新装载NDTR, 继续接收
+      循环(CIRC):  NDTR为0时置TC, 重新装载NDTR
+      普通:        NDTR为0时置TC, 关闭数据流
+      传输过半置HT; 传输中关闭数据流置TC
+    DMA关闭时收到的字节留在DR中, 前一个未读时置ORE
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#define _DEFAULT_SOURCE //MAP_32BIT
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "sim_usart.h"
+
+#define SIM_USART_IRQ_MAX 8u    //一次连续处理的中断数上限 超过视为标志未清除
+
+//接收DMA是否有挂起的中断
+static bool_t sim_dma_pending(const DMA_HandleTypeDef *hdma)
+{
+    uint32_t cr = hdma->Instance->CR;
+
+    return ((hdma->flag & SIM_DMA_FLAG_TC) && (cr & DMA_SxCR_TCIE)) ||
+           ((hdma->flag & SIM_DMA_FLAG_HT) && (cr & DMA_SxCR_HTIE));
+}
+
+//串口是否有挂起的中断 DMA接收时错误中断未使能 错误标志只在空闲中断中读到
+static bool_t sim_uart_pending(const UART_HandleTypeDef *huart)
+{
+    return (huart->Instance->SR & USART_SR_IDLE) && (huart->Instance->CR1 & USART_CR1_IDLEIE);
+}
+
+//执行挂起的中断
+static void sim_usart_dispatch(sim_usart_t *port)
+{
+    uint32_t i;
+
+    for (i = 0; i < SIM_USART_IRQ_MAX; i++)
+    {
+        if (sim_uart_pending(port->huart) && port->usart_irq != NULL)
+        {
+            port->usart_irq_count++;
+            port->usart_irq(port->arg);
+        }
+        else if (sim_dma_pending(port->hdma_rx) && port->dma_irq != NULL)
+        {
+            port->dma_irq_count++;
+            port->dma_irq(port->arg);
+        }
+        else
+        {
+            return;
+        }
+    }
+    //标志没有清除 清除后继续 避免测试卡住
+    port->stuck_count++;
+    port->uart.SR &= ~USART_SR_IDLE;
+    port->hdma_rx->flag = 0;
+}
+
+void sim_dma_enable(DMA_HandleTypeDef *hdma)
+{
+    hdma->reload = hdma->Instance->NDTR;
+    hdma->Instance->CR |= DMA_SxCR_EN;
+}
+
+void sim_dma_disable(DMA_HandleTypeDef *hdma)
+{
+    if (hdma->Instance->CR & DMA_SxCR_EN)
+    {
+        hdma->Instance->CR &= ~DMA_SxCR_EN;
+        hdma->flag |= SIM_DMA_FLAG_TC;
+    }
+}
+
+void sim_uart_clear_flag(UART_HandleTypeDef *huart)
+{
+    huart->Instance->SR &= ~(USART_SR_PE | USART_SR_FE | USART_SR_NE | USART_SR_ORE | USART_SR_IDLE | USART_SR_RXNE);
+}
+
+void sim_usart_init(sim_usart_t *port, UART_HandleTypeDef *huart, DMA_HandleTypeDef *hdma_rx, DMA_HandleTypeDef *hdma_tx,
+                    sim_usart_irq_t usart_irq, sim_usart_irq_t dma_irq, void *arg)
+{
+    memset(port, 0, sizeof(sim_usart_t));
+    memset(huart, 0, sizeof(UART_HandleTypeDef));
+    memset(hdma_rx, 0, sizeof(DMA_HandleTypeDef));
+    memset(hdma_tx, 0, sizeof(DMA_HandleTypeDef));
+    port->huart = huart;
+    port->hdma_rx = hdma_rx;
+    port->hdma_tx = hdma_tx;
+    huart->Instance = &port->uart;
+    hdma_rx->Instance = &port->dma_rx;
+    hdma_tx->Instance = &port->dma_tx;
+    port->usart_irq = usart_irq;
+    port->dma_irq = dma_irq;
+    port->arg = arg;
+}
+
+//DMA搬运一个字节
+static void sim_dma_rx_byte(sim_usart_t *port, uint8_t byte)
+{
+    DMA_HandleTypeDef *hdma = port->hdma_rx;
+    DMA_Stream_TypeDef *stream = hdma->Instance;
+    uint32_t mem;
+    uint32_t index;
+
+    mem = ((stream->CR & DMA_SxCR_DBM) && (stream->CR & DMA_SxCR_CT)) ? stream->M1AR : stream->M0AR;
+    index = hdma->reload - stream->NDTR;
+    ((uint8_t *)(uintptr_t)mem)[index] = byte;
+    stream->NDTR--;
+
+    if (stream->NDTR == hdma->reload / 2u)
+    {
+        hdma->flag |= SIM_DMA_FLAG_HT;
+    }
+    if (stream->NDTR == 0)
+    {
+        hdma->flag |= SIM_DMA_FLAG_TC;
+        if (stream->CR & DMA_SxCR_DBM)
+        {
+            stream->CR ^= DMA_SxCR_CT;
+            stream->NDTR = hdma->reload;
+        }
+        else if (stream->CR & DMA_SxCR_CIRC)
+        {
+            stream->NDTR = hdma->reload;
+        }
+        else
+        {
+            stream->CR &= ~DMA_SxCR_EN;
+        }
+    }
+}
+
+void sim_usart_receive(sim_usart_t *port, const uint8_t *data, uint32_t len)
+{
+    uint32_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        if ((port->uart.CR3 & USART_CR3_DMAR) && (port->dma_rx.CR & DMA_SxCR_EN) && port->dma_rx.NDTR != 0)
+        {
+            sim_dma_rx_byte(port, data[i]);
+        }
+        else
+        {
+            if (port->uart.SR & USART_SR_RXNE)
+            {
+                port->uart.SR |= USART_SR_ORE;
+            }
+            port->uart.SR |= USART_SR_RXNE;
+            port->uart.DR = data[i];
+            port->lost_bytes++;
+        }
+        sim_usart_dispatch(port);
+    }
+}
+
+void sim_usart_idle(sim_usart_t *port)
+{
+    port->uart.SR |= USART_SR_IDLE;
+    sim_usart_dispatch(port);
+}
+
+void sim_usart_error(sim_usart_t *port, uint32_t sr_flag)
+{
+    port->uart.SR |= sr_flag;
+}
+
+uint16_t sim_usart_transmit(sim_usart_t *port, uint8_t *out, uint16_t max)
+{
+    DMA_Stream_TypeDef *stream = &port->dma_tx;
+    uint16_t len;
+
+    if (!(port->uart.CR3 & USART_CR3_DMAT) || !(stream->CR & DMA_SxCR_EN))
+    {
+        return 0;
+    }
+    len = (uint16_t)stream->NDTR;
+    if (len > max)
+    {
+        len = max;
+    }
+    memcpy(out, (const uint8_t *)(uintptr_t)stream->M0AR, len);
+    stream->NDTR = 0;
+    stream->CR &= ~DMA_SxCR_EN;
+    port->hdma_tx->flag |= SIM_DMA_FLAG_TC;
+    return len;
+}
+
+uint8_t *sim_usart_alloc(uint32_t len)
+{
+    void *mem = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+
+    if (mem == MAP_FAILED || (uintptr_t)mem + len > 0xFFFFFFFFu)
+    {
+        return NULL;
+    }
+    return (uint8_t *)mem;
+}
@@ -0,0 +1,93 @@
+#ifndef SIM_USART_H
+#define SIM_USART_H
+
+#include "struct_typedef.h"
+#include "main.h"
+
+/*
+  上位机仿真串口与DMA数据流 寄存器级假设备, 驱动bsp_usart.c
+  接收: 每个字节由DMA写入CT选中的缓冲区, NDTR减1; 传输过半置HT, NDTR为0置TC,
+        双缓冲模式翻转CT 循环模式重新装载NDTR 普通模式关闭数据流
+  空闲: 置位SR.IDLE
+  每个字节与空闲之后按挂起的标志调用注册的中断函数, 直到没有挂起的中断(串口与DMA同优先级)
+  中断函数返回后标志仍未清除时计为stuck(目标板上会一直进入中断)
+*/
+
+/*中断函数 目标板上的USARTx_IRQHandler与DMAx_Streamy_IRQHandler*/
+typedef void (*sim_usart_irq_t)(void *arg);
+
+/*一个串口与收发两个DMA数据流 句柄由使用者定义(与CubeMX生成的huartX、hdma_usartX_rx相同)*/
+typedef struct
+{
+    UART_HandleTypeDef *huart;
+    DMA_HandleTypeDef *hdma_rx;
+    DMA_HandleTypeDef *hdma_tx;
+    USART_TypeDef uart;
+    DMA_Stream_TypeDef dma_rx;
+    DMA_Stream_TypeDef dma_tx;
+
+    sim_usart_irq_t usart_irq;
+    sim_usart_irq_t dma_irq;
+    void *arg;
+
+    uint32_t usart_irq_count;
+    uint32_t dma_irq_count;
+    uint32_t lost_bytes;        //DMA未使能时收到的字节
+    uint32_t stuck_count;       //中断返回后标志未清除
+} sim_usart_t;
+
+/**
+  * @brief          寄存器与句柄清零 句柄连接到寄存器 注册中断函数
+  * @param[out]     port: 串口
+  * @param[out]     huart: 串口句柄
+  * @param[out]     hdma_rx: 接收DMA句柄
+  * @param[out]     hdma_tx: 发送DMA句柄
+  * @param[in]      usart_irq: 串口中断
+  * @param[in]      dma_irq: 接收DMA数据流中断
+  * @param[in]      arg: 中断函数参数
+  * @retval         none
+  */
+extern void sim_usart_init(sim_usart_t *port, UART_HandleTypeDef *huart, DMA_HandleTypeDef *hdma_rx, DMA_HandleTypeDef *hdma_tx,
+                           sim_usart_irq_t usart_irq, sim_usart_irq_t dma_irq, void *arg);
+
+/**
+  * @brief          线路上收到数据 逐字节经DMA写入内存
+  * @param[in,out]  port: 串口
+  * @param[in]      data: 数据
+  * @param[in]      len: 长度
+  * @retval         none
+  */
+extern void sim_usart_receive(sim_usart_t *port, const uint8_t *data, uint32_t len);
+
+/**
+  * @brief          线路空闲 置位IDLE
+  * @param[in,out]  port: 串口
+  * @retval         none
+  */
+extern void sim_usart_idle(sim_usart_t *port);
+
+/**
+  * @brief          线路错误 置位SR中的错误标志 在下一次串口中断中读到
+  * @param[in,out]  port: 串口
+  * @param[in]      sr_flag: USART_SR_ORE/NE/FE/PE
+  * @retval         none
+  */
+extern void sim_usart_error(sim_usart_t *port, uint32_t sr_flag);
+
+/**
+  * @brief          发送DMA运行到传输完成
+  * @param[in,out]  port: 串口
+  * @param[out]     out: 发送的数据
+  * @param[in]      max: out长度
+  * @retval         发送的字节数 发送DMA未使能时为0
+  */
+extern uint16_t sim_usart_transmit(sim_usart_t *port, uint8_t *out, uint16_t max);
+
+/**
+  * @brief          分配DMA缓冲区 位于低4GB, 地址可写入32位的M0AR/M1AR
+  * @param[in]      len: 长度
+  * @retval         缓冲区, 失败为NULL
+  */
+extern uint8_t *sim_usart_alloc(uint32_t len);
+
+#endif
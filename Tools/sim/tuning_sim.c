@@ -0,0 +1,547 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       tuning_sim.c
+  * @brief      调参协议上位机测试，用伪终端代替调试串口，在sim_usart上运行
+  *             bsp_debug_usart.c与tuning.c，在sim_flash上运行param.c，
+  *             由Tools/param_tool.py通过伪终端读取、修改、保存参数。
+  * @note       伪终端的另一端由本程序一直打开，每次运行工具前清空，
+  *             工具的seq每次从1开始，上一次剩下的应答不会被误认。
+  *             随机数固定种子，结果可复现。检查失败时返回1, make bench时运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: tuning_sim [param_tool.py路径]
+    list:    列出全部参数, 每个参数一行
+    save:    set两个参数 --save, 提交并写入flash
+    range:   超出范围的set返回错误, 工具发送DISCARD, 值不变且没有暂存值
+    denied:  遥控器在线且左开关不在下档时save被拒绝, 拨到下档后允许
+    retry:   丢弃第一次SET的应答, 工具超时后用相同seq重发, 重复的SET结果相同
+    noise:   每个应答前发送乱码、遥测帧、CRC错误与seq过期的应答,
+             每个请求前发送超长帧与CRC错误帧, 请求全部正确处理
+    reboot:  sim_flash重新上电后param_init, 已保存的值载入, 只提交未保存的值恢复默认
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#define _DEFAULT_SOURCE     //popen cfmakeraw
+#define _XOPEN_SOURCE 600   //posix_openpt
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/wait.h>
+//termios.h中的同名宏与main.h中的寄存器名冲突
+#undef CR1
+#undef CR2
+#undef CR3
+#include "main.h"
+#include "bsp_debug_usart.h"
+#include "tuning.h"
+#include "param.h"
+#include "cobs.h"
+#include "crc.h"
+#include "telemetry_task.h"
+#include "sim_usart.h"
+#include "sim_flash.h"
+#include "sim_os.h"
+#include "sim_rc.h"
+
+#define SIM_CHUNK_LEN       (TUNING_RX_BUF_LEN / 2u)   //每次送入的字节数 读取前最多写入半个缓冲区
+#define SIM_OUTPUT_LEN      4096u
+#define SIM_FRAME_LEN       (TUNING_REPLY_MAX_LEN + TUNING_REPLY_MAX_LEN / 254u + 4u)
+#define SIM_OVERLONG_LEN    (TUNING_FRAME_MAX_LEN + 8u)
+
+//与CubeMX生成的句柄同名 bsp_debug_usart.c使用
+UART_HandleTypeDef huart1;
+DMA_HandleTypeDef hdma_usart1_rx;
+DMA_HandleTypeDef hdma_usart1_tx;
+
+//bsp_debug_usart.c中的串口中断
+extern void USART1_IRQHandler(void);
+
+static sim_usart_t sim_port;
+static int sim_master = -1;
+static int sim_slave = -1;
+static char sim_slave_name[64];
+static const char *sim_tool_path;
+static char sim_output[SIM_OUTPUT_LEN];
+
+static uint8_t sim_drop_cmd;        //丢弃该命令的下一次应答 0:不丢弃
+static bool_t sim_noise;            //在请求与应答之间插入干扰
+static bool_t sim_rx_boundary = 1;  //上一个送入的字节是帧分隔符
+static uint32_t sim_drop_count;
+static uint32_t sim_noise_count;
+
+static uint32_t sim_seed = 0x13579BDFu;
+static uint32_t sim_error;
+static const char *sim_current;
+
+static uint32_t sim_rand(void)
+{
+    sim_seed ^= sim_seed << 13;
+    sim_seed ^= sim_seed >> 17;
+    sim_seed ^= sim_seed << 5;
+    return sim_seed;
+}
+
+static void sim_check(bool_t ok, const char *what, uint32_t value, uint32_t expect)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "error: %s: %s %u, expect %u\n", sim_current, what, (unsigned)value, (unsigned)expect);
+        sim_error++;
+    }
+}
+
+static void sim_check_output(const char *text)
+{
+    if (strstr(sim_output, text) == NULL)
+    {
+        fprintf(stderr, "error: %s: output has no \"%s\":\n%s", sim_current, text, sim_output);
+        sim_error++;
+    }
+}
+
+static void sim_usart_irq(void *arg)
+{
+    (void)arg;
+    USART1_IRQHandler();
+}
+
+static void sim_dma_irq(void *arg)
+{
+    (void)arg;
+    debug_usart_dma_irq_handler();
+}
+
+/*--------伪终端--------*/
+
+static bool_t sim_pty_open(void)
+{
+    struct termios attr;
+    const char *name;
+
+    sim_master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (sim_master < 0 || grantpt(sim_master) != 0 || unlockpt(sim_master) != 0 || (name = ptsname(sim_master)) == NULL)
+    {
+        return 0;
+    }
+    snprintf(sim_slave_name, sizeof(sim_slave_name), "%s", name);
+
+    //本程序一直打开另一端 工具退出后读取主端不会出错
+    sim_slave = open(sim_slave_name, O_RDWR | O_NOCTTY);
+    if (sim_slave < 0 || tcgetattr(sim_slave, &attr) != 0)
+    {
+        return 0;
+    }
+    cfmakeraw(&attr);
+    return tcsetattr(sim_slave, TCSANOW, &attr) == 0;
+}
+
+static void sim_pty_write(const uint8_t *data, uint32_t len)
+{
+    ssize_t n;
+
+    while (len != 0)
+    {
+        n = write(sim_master, data, len);
+        if (n <= 0)
+        {
+            sim_check(0, "pty write", (uint32_t)len, 0);
+            return;
+        }
+        data += n;
+        len -= (uint32_t)n;
+    }
+}
+
+/*--------应答(固件发送)--------*/
+
+//负载加CRC16后COBS编码 raw长度为负载长度+2, CRC已由调用者填入
+static void sim_send_raw(const uint8_t *raw, uint16_t len)
+{
+    uint8_t frame[SIM_FRAME_LEN];
+    uint16_t n;
+
+    n = cobs_encode(raw, len, frame);
+    frame[n++] = 0x00;
+    sim_pty_write(frame, n);
+}
+
+static void sim_send(const uint8_t *payload, uint16_t len)
+{
+    uint8_t raw[TUNING_REPLY_MAX_LEN + 2];
+
+    memcpy(raw, payload, len);
+    append_CRC16_check_sum(raw, len + 2u);
+    sim_send_raw(raw, len + 2u);
+}
+
+//应答前的干扰 每一种工具都应该忽略
+static void sim_noise_reply(const uint8_t *payload, uint16_t len)
+{
+    uint8_t raw[TUNING_REPLY_MAX_LEN + 2];
+    uint8_t garbage[24];
+    uint32_t i;
+
+    //乱码 以分隔符结束
+    for (i = 0; i < sizeof(garbage) - 1u; i++)
+    {
+        garbage[i] = (uint8_t)(sim_rand() | 1u);
+    }
+    garbage[sizeof(garbage) - 1u] = 0x00;
+    sim_pty_write(garbage, sizeof(garbage));
+
+    //遥测采样帧 CRC正确
+    raw[0] = TELEMETRY_PACKET_SAMPLE;
+    for (i = 1; i < 12u; i++)
+    {
+        raw[i] = (uint8_t)sim_rand();
+    }
+    sim_send(raw, 12);
+
+    //应答的状态改为错误 CRC不变
+    memcpy(raw, payload, len);
+    append_CRC16_check_sum(raw, len + 2u);
+    raw[2] = (raw[2] == TUNING_ERROR_FORMAT) ? TUNING_ERROR_ID : TUNING_ERROR_FORMAT;
+    sim_send_raw(raw, len + 2u);
+
+    //seq过期的错误应答 CRC正确
+    memcpy(raw, payload, len);
+    raw[1] = (uint8_t)(raw[1] - 1u);
+    raw[2] = TUNING_ERROR_FORMAT;
+    sim_send(raw, len);
+
+    sim_noise_count += 4u;
+}
+
+static bool_t sim_reply(const uint8_t *payload, uint16_t len)
+{
+    if (sim_drop_cmd != 0 && payload[0] == (sim_drop_cmd | TUNING_REPLY_FLAG))
+    {
+        //发送缓冲区忙 应答被丢弃
+        sim_drop_cmd = 0;
+        sim_drop_count++;
+        return 0;
+    }
+    if (sim_noise)
+    {
+        sim_noise_reply(payload, len);
+    }
+    sim_send(payload, len);
+    return 1;
+}
+
+/*--------请求(固件接收)--------*/
+
+static void sim_receive(const uint8_t *data, uint16_t len)
+{
+    sim_usart_receive(&sim_port, data, len);
+    sim_usart_idle(&sim_port);
+    tuning_poll(sim_reply);
+}
+
+//请求前的干扰 超长帧计为frame_error, CRC错误帧计为crc_error
+static void sim_noise_request(void)
+{
+    uint8_t overlong[SIM_OVERLONG_LEN];
+    uint8_t raw[8] = {TUNING_CMD_GET, 0x55, 0x00, 0x00};
+    uint8_t frame[16];
+    uint16_t n;
+
+    memset(overlong, 0x55, sizeof(overlong) - 1u);
+    overlong[sizeof(overlong) - 1u] = 0x00;
+    sim_receive(overlong, sizeof(overlong));
+
+    append_CRC16_check_sum(raw, 6);
+    raw[5] ^= 0x01u;
+    n = cobs_encode(raw, 6, frame);
+    frame[n++] = 0x00;
+    sim_receive(frame, n);
+}
+
+static void sim_rx_chunk(const uint8_t *data, uint16_t len)
+{
+    if (sim_noise && sim_rx_boundary)
+    {
+        sim_noise_request();
+    }
+    sim_receive(data, len);
+    sim_rx_boundary = (data[len - 1u] == 0x00);
+}
+
+/*--------运行工具--------*/
+
+//运行param_tool.py 期间把伪终端上的数据送入调试串口 返回工具的退出码
+static int sim_tool(const char *args)
+{
+    char command[256];
+    uint8_t chunk[SIM_CHUNK_LEN];
+    struct pollfd fds[2];
+    uint32_t out_len = 0;
+    FILE *pipe;
+    ssize_t n;
+    int status;
+
+    tcflush(sim_slave, TCIOFLUSH);
+    sim_rx_boundary = 1;
+    snprintf(command, sizeof(command), "python3 %s %s %s 2>&1", sim_tool_path, sim_slave_name, args);
+    pipe = popen(command, "r");
+    if (pipe == NULL)
+    {
+        sim_check(0, "popen", 0, 1);
+        return -1;
+    }
+
+    fds[0].fd = sim_master;
+    fds[0].events = POLLIN;
+    fds[1].fd = fileno(pipe);
+    fds[1].events = POLLIN;
+    for (;;)
+    {
+        if (poll(fds, 2, 10) < 0)
+        {
+            break;
+        }
+        if (fds[0].revents & POLLIN)
+        {
+            n = read(sim_master, chunk, sizeof(chunk));
+            if (n > 0)
+            {
+                sim_rx_chunk(chunk, (uint16_t)n);
+            }
+        }
+        if (fds[1].revents & (POLLIN | POLLHUP))
+        {
+            n = read(fds[1].fd, sim_output + out_len, sizeof(sim_output) - 1u - out_len);
+            if (n <= 0)
+            {
+                break;
+            }
+            out_len += (uint32_t)n;
+        }
+    }
+    sim_output[out_len] = '\0';
+
+    status = pclose(pipe);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/*--------场景--------*/
+
+static void sim_list(void)
+{
+    uint32_t lines = 0;
+    uint16_t id;
+    const char *p;
+    int status;
+
+    sim_current = "list";
+    status = sim_tool("list");
+    sim_check(status == 0, "exit status", (uint32_t)status, 0);
+    for (p = sim_output; (p = strchr(p, '\n')) != NULL; p++)
+    {
+        lines++;
+    }
+    sim_check(lines == PARAM_NUM, "lines", lines, PARAM_NUM);
+    for (id = 0; id < PARAM_NUM; id++)
+    {
+        sim_check_output(param_get_def(id)->name);
+    }
+    printf("list: %u parameters\n", (unsigned)lines);
+}
+
+static void sim_save(void)
+{
+    const param_value_t *value = get_param_value_point();
+    uint32_t write_offset = get_param_store_point()->write_offset;
+    uint32_t version = param_get_version();
+    int status;
+
+    sim_current = "save";
+    status = sim_tool("set shoot.burst_num=7 chassis.spd_kp=12.5 --save");
+    sim_check(status == 0, "exit status", (uint32_t)status, 0);
+    sim_check_output("committed 2 parameter(s)");
+    sim_check_output(", saved");
+    sim_check(value[PARAM_SHOOT_BURST_NUM].i == 7, "burst_num", (uint32_t)value[PARAM_SHOOT_BURST_NUM].i, 7);
+    sim_check(value[PARAM_CHASSIS_SPEED_KP].f == 12.5f, "spd_kp x10", (uint32_t)(value[PARAM_CHASSIS_SPEED_KP].f * 10.0f), 125);
+    sim_check(param_get_version() == version + 1u, "version", param_get_version(), version + 1u);
+    sim_check(get_param_store_point()->write_offset > write_offset, "write offset", get_param_store_point()->write_offset, write_offset);
+    printf("save: version %u, write offset %u\n", (unsigned)param_get_version(), (unsigned)get_param_store_point()->write_offset);
+}
+
+static void sim_range(void)
+{
+    param_value_t staged;
+    uint32_t version = param_get_version();
+    uint16_t id;
+    int status;
+
+    sim_current = "range";
+    status = sim_tool("set shoot.fire_mode=1 shoot.burst_num=11");
+    sim_check(status == 1, "exit status", (uint32_t)status, 1);
+    sim_check_output("set shoot.burst_num: out of range");
+    sim_check(get_param_value_point()[PARAM_SHOOT_BURST_NUM].i == 7, "burst_num", (uint32_t)get_param_value_point()[PARAM_SHOOT_BURST_NUM].i, 7);
+    sim_check(param_get_version() == version, "version", param_get_version(), version);
+    //前一个SET已暂存 工具发送DISCARD后丢弃
+    for (id = 0; id < PARAM_NUM; id++)
+    {
+        sim_check(!param_get_staged(id, &staged), "staged", id, PARAM_NUM);
+    }
+    printf("range: rejected, staged values discarded\n");
+}
+
+//遥控器按帧周期发送到sim_rc_time
+static uint32_t sim_rc_time;
+
+static void sim_rc_run(uint32_t frames)
+{
+    uint32_t end = sim_rc_time + frames * RC_FRAME_PERIOD_MS;
+
+    while (sim_rc_time < end)
+    {
+        sim_rc_tick_1ms(++sim_rc_time);
+    }
+}
+
+static void sim_denied(void)
+{
+    uint32_t version = param_get_version();
+    int status;
+
+    sim_current = "denied";
+    sim_rc_input_point()->rc.switch_channel[0] = RC_SW_UP;
+    sim_rc_run(RC_RECOVER_FRAME_NUM);
+    sim_check(!remote_control_is_failsafe(), "failsafe", remote_control_is_failsafe(), 0);
+    status = sim_tool("save");
+    sim_check(status == 1, "exit status", (uint32_t)status, 1);
+    sim_check_output("save denied");
+    sim_check(param_get_version() == version, "version", param_get_version(), version);
+
+    sim_rc_input_point()->rc.switch_channel[0] = RC_SW_DOWN;
+    sim_rc_run(1);
+    status = sim_tool("save");
+    sim_check(status == 0, "exit status switch down", (uint32_t)status, 0);
+    sim_check_output("saved, version");
+    printf("denied: save rejected with switch up, accepted with switch down\n");
+}
+
+static void sim_retry(void)
+{
+    uint32_t requests = get_tuning_status_point()->request_count;
+    int status;
+
+    sim_current = "retry";
+    sim_drop_cmd = TUNING_CMD_SET;
+    sim_drop_count = 0;
+    status = sim_tool("set chassis.rc_deadzone=20");
+    sim_check(status == 0, "exit status", (uint32_t)status, 0);
+    sim_check(sim_drop_count == 1u, "dropped", sim_drop_count, 1);
+    //重复的SET暂存同一个值 提交个数仍为1
+    sim_check_output("committed 1 parameter(s)");
+    sim_check(get_param_value_point()[PARAM_CHASSIS_RC_DEADZONE].i == 20, "rc_deadzone",
+              (uint32_t)get_param_value_point()[PARAM_CHASSIS_RC_DEADZONE].i, 20);
+    //LIST + SET两次 + COMMIT
+    requests = get_tuning_status_point()->request_count - requests;
+    sim_check(requests == PARAM_NUM + 3u, "requests", requests, PARAM_NUM + 3u);
+    printf("retry: %u reply dropped, %u requests\n", (unsigned)sim_drop_count, (unsigned)requests);
+}
+
+static void sim_noise_run(void)
+{
+    const tuning_status_t *tuning = get_tuning_status_point();
+    uint32_t requests = tuning->request_count;
+    uint32_t crc_error = tuning->crc_error;
+    uint32_t frame_error = tuning->frame_error;
+    int status;
+
+    sim_current = "noise";
+    sim_noise = 1;
+    sim_noise_count = 0;
+    status = sim_tool("get shoot.burst_num chassis.spd_kp");
+    sim_noise = 0;
+    sim_check(status == 0, "exit status", (uint32_t)status, 0);
+    sim_check_output("shoot.burst_num = 7\n");
+    sim_check_output("chassis.spd_kp = 12.5\n");
+
+    //LIST + GET两次, 每个请求前一个超长帧与一个CRC错误帧
+    requests = tuning->request_count - requests;
+    crc_error = tuning->crc_error - crc_error;
+    frame_error = tuning->frame_error - frame_error;
+    sim_check(requests == PARAM_NUM + 2u, "requests", requests, PARAM_NUM + 2u);
+    sim_check(crc_error == requests, "crc error", crc_error, requests);
+    sim_check(frame_error == requests, "frame error", frame_error, requests);
+    sim_check(sim_noise_count == 4u * requests, "noise frames to tool", sim_noise_count, 4u * requests);
+    printf("noise: %u requests, %u crc error, %u frame error, %u frames ignored by tool\n",
+           (unsigned)requests, (unsigned)crc_error, (unsigned)frame_error, (unsigned)sim_noise_count);
+}
+
+static void sim_reboot(void)
+{
+    const param_value_t *value = get_param_value_point();
+    char text[64];
+    int status;
+
+    sim_current = "reboot";
+    sim_flash_power_on();
+    param_init();
+    tuning_init();
+
+    sim_check(get_param_store_point()->corrupt_count == 0, "corrupt", get_param_store_point()->corrupt_count, 0);
+    sim_check(value[PARAM_SHOOT_BURST_NUM].i == 7, "burst_num", (uint32_t)value[PARAM_SHOOT_BURST_NUM].i, 7);
+    sim_check(value[PARAM_CHASSIS_SPEED_KP].f == 12.5f, "spd_kp x10", (uint32_t)(value[PARAM_CHASSIS_SPEED_KP].f * 10.0f), 125);
+    //只提交没有保存
+    sim_check(value[PARAM_CHASSIS_RC_DEADZONE].i == param_get_def(PARAM_CHASSIS_RC_DEADZONE)->def.i, "rc_deadzone",
+              (uint32_t)value[PARAM_CHASSIS_RC_DEADZONE].i, (uint32_t)param_get_def(PARAM_CHASSIS_RC_DEADZONE)->def.i);
+
+    status = sim_tool("get shoot.burst_num chassis.rc_deadzone");
+    sim_check(status == 0, "exit status", (uint32_t)status, 0);
+    sim_check_output("shoot.burst_num = 7\n");
+    snprintf(text, sizeof(text), "chassis.rc_deadzone = %d\n", (int)param_get_def(PARAM_CHASSIS_RC_DEADZONE)->def.i);
+    sim_check_output(text);
+    printf("reboot: %u records loaded\n", (unsigned)get_param_store_point()->load_count);
+}
+
+int main(int argc, char *argv[])
+{
+    sim_tool_path = (argc > 1) ? argv[1] : "../param_tool.py";
+    if (!sim_pty_open())
+    {
+        fprintf(stderr, "tuning_sim: cannot open pty\n");
+        return 1;
+    }
+
+    //遥控器关闭 允许写入flash
+    sim_os_init();
+    sim_rc_init();
+    sim_flash_init();
+    param_init();
+    sim_usart_init(&sim_port, &huart1, &hdma_usart1_rx, &hdma_usart1_tx, sim_usart_irq, sim_dma_irq, NULL);
+    tuning_init();
+
+    sim_list();
+    sim_save();
+    sim_range();
+    sim_denied();
+    sim_retry();
+    sim_noise_run();
+    sim_reboot();
+
+    close(sim_slave);
+    close(sim_master);
+    if (sim_error != 0)
+    {
+        fprintf(stderr, "tuning_sim: %u errors\n", (unsigned)sim_error);
+        return 1;
+    }
+    printf("tuning_sim: ok\n");
+    return 0;
+}
@@ -0,0 +1,388 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       usart_sim.c
+  * @brief      串口DMA驱动上位机测试，用寄存器级假设备(sim_usart.c)运行bsp_usart.c，
+  *             检查双缓冲模式的CT切换与每帧数据、帧超长时的溢出计数，
+  *             循环模式的过半/完成/空闲中断更新写位置、多次回绕后数据不丢不重、
+  *             读取不及时的溢出与重新同步、线路错误计数与DMA发送。
+  * @note       假设备在关闭数据流时置位TC(与目标板相同)，驱动没有清除时会被计为溢出。
+  *             随机数固定种子，结果可复现。检查失败时返回1, make bench时运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: usart_sim
+    double_buffer  遥控器用法: 两个32字节缓冲区, 1~31字节的帧, 每帧后空闲
+    overflow       帧超过缓冲区: 写满时DMA自动切换缓冲区并产生TC, 计一次溢出
+    circular       裁判系统用法: 256字节环形缓冲区, 随机长度分段, 随机空闲, 多次回绕
+    burst          不空闲的连续数据只靠过半/完成中断更新写位置
+    lapped         读取不及时被DMA覆盖 计一次溢出后重新同步
+    error          ORE/FE在空闲中断中计数
+    tx             DMA发送 发送中再次启动返回失败
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <stdio.h>
+#include <string.h>
+#include "sim_usart.h"
+#include "bsp_usart.h"
+
+#define SIM_DB_BUF_LEN      32u
+#define SIM_DB_FRAMES       2000u
+#define SIM_CIRC_BUF_LEN    256u
+#define SIM_CIRC_BYTES      200000u
+#define SIM_CHUNK_MAX       (SIM_CIRC_BUF_LEN / 2u)    //读取前最多写入半个缓冲区 见sim_circular
+
+/*双缓冲回调记录*/
+typedef struct
+{
+    uint32_t count;
+    const uint8_t *data;
+    uint16_t len;
+} sim_frame_log_t;
+
+static sim_usart_t sim_port;
+static UART_HandleTypeDef sim_huart;
+static DMA_HandleTypeDef sim_hdma_rx;
+static DMA_HandleTypeDef sim_hdma_tx;
+static usart_rx_t sim_rx;
+static sim_frame_log_t sim_log;
+static uint32_t sim_seed = 0x2468ACE1u;
+static uint32_t sim_error;
+static const char *sim_current;
+
+static uint32_t sim_rand(void)
+{
+    sim_seed ^= sim_seed << 13;
+    sim_seed ^= sim_seed >> 17;
+    sim_seed ^= sim_seed << 5;
+    return sim_seed;
+}
+
+static void sim_check(bool_t ok, const char *what, uint32_t value, uint32_t expect)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "error: %s: %s %u, expect %u\n", sim_current, what, (unsigned)value, (unsigned)expect);
+        sim_error++;
+    }
+}
+
+static void sim_usart_irq(void *arg)
+{
+    usart_rx_irq_handler((usart_rx_t *)arg);
+}
+
+static void sim_dma_irq(void *arg)
+{
+    usart_rx_dma_irq_handler((usart_rx_t *)arg);
+}
+
+static void sim_frame_callback(usart_rx_t *rx, const uint8_t *data, uint16_t len)
+{
+    (void)rx;
+    sim_log.count++;
+    sim_log.data = data;
+    sim_log.len = len;
+}
+
+static void sim_fill(uint8_t *data, uint32_t len)
+{
+    uint32_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        data[i] = (uint8_t)sim_rand();
+    }
+}
+
+/*--------双缓冲--------*/
+
+static void sim_double_buffer_init(uint8_t *buf)
+{
+    memset(&sim_log, 0, sizeof(sim_log));
+    sim_usart_init(&sim_port, &sim_huart, &sim_hdma_rx, &sim_hdma_tx, sim_usart_irq, sim_dma_irq, &sim_rx);
+    usart_rx_init(&sim_rx, &sim_huart, &sim_hdma_rx, USART_RX_DOUBLE_BUFFER,
+                  buf, buf + SIM_DB_BUF_LEN, SIM_DB_BUF_LEN, sim_frame_callback, NULL);
+}
+
+static void sim_double_buffer(uint8_t *buf)
+{
+    uint8_t frame[SIM_DB_BUF_LEN];
+    uint32_t bytes = 0;
+    uint32_t ok = 0;
+    uint32_t i;
+    uint16_t len;
+
+    sim_current = "double_buffer";
+    sim_double_buffer_init(buf);
+    sim_check((sim_port.dma_rx.CR & (DMA_SxCR_EN | DMA_SxCR_DBM | DMA_SxCR_TCIE)) == (DMA_SxCR_EN | DMA_SxCR_DBM | DMA_SxCR_TCIE),
+              "dma config", sim_port.dma_rx.CR, DMA_SxCR_EN | DMA_SxCR_DBM | DMA_SxCR_TCIE);
+
+    for (i = 0; i < SIM_DB_FRAMES; i++)
+    {
+        //遥控器帧长为主 其余长度随机 不超过缓冲区长度-1
+        len = (i % 4u == 0) ? (uint16_t)(1u + sim_rand() % (SIM_DB_BUF_LEN - 1u)) : 18u;
+        sim_fill(frame, len);
+        sim_log.count = 0;
+        sim_usart_receive(&sim_port, frame, len);
+        sim_usart_idle(&sim_port);
+        bytes += len;
+
+        //每帧一次回调 缓冲区交替 数据完整
+        if (sim_log.count == 1 && sim_log.len == len && sim_log.data == buf + (i & 1u) * SIM_DB_BUF_LEN &&
+            memcmp(sim_log.data, frame, len) == 0)
+        {
+            ok++;
+        }
+        sim_check((sim_port.dma_rx.CR & DMA_SxCR_CT) == ((i & 1u) ? 0 : DMA_SxCR_CT), "CT after frame", i, 0);
+    }
+
+    //线路空闲但没有数据 不回调
+    sim_log.count = 0;
+    sim_usart_idle(&sim_port);
+    sim_check(sim_log.count == 0, "callback on empty idle", sim_log.count, 0);
+
+    printf("double_buffer  %u/%u frames intact, %u bytes, %u irq, overflow %u, error %u\n",
+           (unsigned)ok, SIM_DB_FRAMES, (unsigned)sim_rx.rx_bytes, (unsigned)sim_port.usart_irq_count,
+           (unsigned)sim_rx.overflow_count, (unsigned)sim_rx.error_count);
+    sim_check(ok == SIM_DB_FRAMES, "intact frames", ok, SIM_DB_FRAMES);
+    sim_check(sim_rx.frame_count == SIM_DB_FRAMES + 1u, "idle count", sim_rx.frame_count, SIM_DB_FRAMES + 1u);
+    sim_check(sim_rx.rx_bytes == bytes, "rx bytes", sim_rx.rx_bytes, bytes);
+    //关闭数据流置位的TC被驱动清除 不会误判为溢出
+    sim_check(sim_rx.overflow_count == 0, "overflow", sim_rx.overflow_count, 0);
+    sim_check(sim_port.dma_irq_count == 0, "dma irq", sim_port.dma_irq_count, 0);
+    sim_check(sim_port.stuck_count == 0 && sim_port.lost_bytes == 0, "stuck irq or lost bytes",
+              sim_port.stuck_count + sim_port.lost_bytes, 0);
+}
+
+static void sim_overflow(uint8_t *buf)
+{
+    uint8_t frame[SIM_DB_BUF_LEN + 8u];
+    uint16_t tail_len;
+
+    sim_current = "overflow";
+    sim_double_buffer_init(buf);
+
+    //40字节: 写满buf0后DMA切换到buf1 产生TC 剩余8字节在buf1
+    sim_fill(frame, sizeof(frame));
+    sim_usart_receive(&sim_port, frame, sizeof(frame));
+    sim_check(sim_rx.overflow_count == 1, "overflow after full buffer", sim_rx.overflow_count, 1);
+    sim_usart_idle(&sim_port);
+    tail_len = sim_log.len;
+    sim_check(sim_log.count == 1 && sim_log.len == 8u, "tail length", sim_log.len, 8u);
+    sim_check(sim_log.data == buf + SIM_DB_BUF_LEN && memcmp(sim_log.data, frame + SIM_DB_BUF_LEN, 8u) == 0,
+              "tail data in buffer 1", 0, 0);
+
+    //之后的帧正常
+    sim_fill(frame, 18u);
+    sim_usart_receive(&sim_port, frame, 18u);
+    sim_usart_idle(&sim_port);
+    sim_check(sim_log.count == 2 && sim_log.len == 18u && sim_log.data == buf && memcmp(buf, frame, 18u) == 0,
+              "frame after overflow", sim_log.len, 18u);
+    printf("overflow       40 byte frame: overflow %u, tail %u bytes, next frame ok\n",
+           (unsigned)sim_rx.overflow_count, (unsigned)tail_len);
+    sim_check(sim_rx.overflow_count == 1, "overflow", sim_rx.overflow_count, 1);
+}
+
+/*--------循环--------*/
+
+static void sim_circular_init(uint8_t *buf)
+{
+    sim_usart_init(&sim_port, &sim_huart, &sim_hdma_rx, &sim_hdma_tx, sim_usart_irq, sim_dma_irq, &sim_rx);
+    usart_rx_init(&sim_rx, &sim_huart, &sim_hdma_rx, USART_RX_CIRCULAR,
+                  buf, NULL, SIM_CIRC_BUF_LEN, NULL, NULL);
+}
+
+//读出全部未读数据 环形缓冲区回绕时分两段
+static uint32_t sim_drain(uint8_t *out)
+{
+    const uint8_t *data;
+    uint32_t total = 0;
+    uint16_t len;
+
+    while ((len = usart_rx_peek(&sim_rx, &data)) != 0)
+    {
+        memcpy(out + total, data, len);
+        usart_rx_consume(&sim_rx, len);
+        total += len;
+    }
+    return total;
+}
+
+static void sim_circular(uint8_t *buf)
+{
+    static uint8_t in[SIM_CIRC_BYTES];
+    static uint8_t out[SIM_CIRC_BYTES];
+    uint32_t sent = 0;
+    uint32_t read = 0;
+    uint32_t len;
+    uint32_t idle = 0;
+
+    sim_current = "circular";
+    sim_circular_init(buf);
+    sim_check((sim_port.dma_rx.CR & (DMA_SxCR_CIRC | DMA_SxCR_HTIE | DMA_SxCR_TCIE | DMA_SxCR_DBM)) ==
+              (DMA_SxCR_CIRC | DMA_SxCR_HTIE | DMA_SxCR_TCIE), "dma config", sim_port.dma_rx.CR, 0);
+
+    sim_fill(in, SIM_CIRC_BYTES);
+    while (sent < SIM_CIRC_BYTES)
+    {
+        //读取前最多写入半个缓冲区: 未计入写位置的字节不超过半个缓冲区(过半/完成中断) 加上已计入未读的 不超过缓冲区
+        len = 1u + sim_rand() % SIM_CHUNK_MAX;
+        if (len > SIM_CIRC_BYTES - sent)
+        {
+            len = SIM_CIRC_BYTES - sent;
+        }
+        sim_usart_receive(&sim_port, &in[sent], len);
+        sent += len;
+        if (sim_rand() & 1u)
+        {
+            sim_usart_idle(&sim_port);
+            idle++;
+        }
+        read += sim_drain(&out[read]);
+    }
+    sim_usart_idle(&sim_port);
+    read += sim_drain(&out[read]);
+
+    printf("circular       %u bytes, %u wraps, %u idle + %u HT/TC irq, read %u, overflow %u\n",
+           (unsigned)sent, (unsigned)(sent / SIM_CIRC_BUF_LEN), (unsigned)idle + 1u, (unsigned)sim_port.dma_irq_count,
+           (unsigned)read, (unsigned)sim_rx.overflow_count);
+    sim_check(read == sent, "bytes read", read, sent);
+    sim_check(memcmp(in, out, sent) == 0, "data", 0, 0);
+    sim_check(sim_rx.write_count == sent && sim_rx.rx_bytes == sent, "write count", sim_rx.write_count, sent);
+    sim_check(sim_rx.overflow_count == 0, "overflow", sim_rx.overflow_count, 0);
+    sim_check(sim_port.stuck_count == 0 && sim_port.lost_bytes == 0, "stuck irq or lost bytes",
+              sim_port.stuck_count + sim_port.lost_bytes, 0);
+}
+
+static void sim_burst(uint8_t *buf)
+{
+    uint8_t in[1000];
+    uint32_t expect;
+
+    sim_current = "burst";
+    sim_circular_init(buf);
+
+    //没有空闲 写位置在每半个缓冲区更新一次
+    sim_fill(in, sizeof(in));
+    sim_usart_receive(&sim_port, in, sizeof(in));
+    expect = sizeof(in) / (SIM_CIRC_BUF_LEN / 2u) * (SIM_CIRC_BUF_LEN / 2u);
+    sim_check(sim_rx.write_count == expect, "write count before idle", sim_rx.write_count, expect);
+    sim_check(sim_port.dma_irq_count == sizeof(in) / (SIM_CIRC_BUF_LEN / 2u), "HT/TC irq", sim_port.dma_irq_count,
+              sizeof(in) / (SIM_CIRC_BUF_LEN / 2u));
+    sim_usart_idle(&sim_port);
+    printf("burst          1000 bytes without idle: write count %u after HT/TC, %u after idle\n",
+           (unsigned)expect, (unsigned)sim_rx.write_count);
+    sim_check(sim_rx.write_count == sizeof(in), "write count after idle", sim_rx.write_count, sizeof(in));
+}
+
+static void sim_lapped(uint8_t *buf)
+{
+    uint8_t in[3u * SIM_CIRC_BUF_LEN];
+    uint8_t out[SIM_CIRC_BUF_LEN];
+    uint32_t read;
+    uint32_t i;
+
+    sim_current = "lapped";
+    sim_circular_init(buf);
+
+    //不读取 DMA写入3圈 未读数据已被覆盖
+    sim_fill(in, sizeof(in));
+    for (i = 0; i < sizeof(in); i += 64u)
+    {
+        sim_usart_receive(&sim_port, &in[i], 64u);
+        sim_usart_idle(&sim_port);
+    }
+    sim_check(usart_rx_available(&sim_rx) == 0, "available after lap", usart_rx_available(&sim_rx), 0);
+    sim_check(sim_rx.overflow_count == 1, "overflow", sim_rx.overflow_count, 1);
+
+    //重新同步后的数据正常
+    sim_fill(in, 100u);
+    sim_usart_receive(&sim_port, in, 100u);
+    sim_usart_idle(&sim_port);
+    read = sim_drain(out);
+    printf("lapped         768 unread bytes: overflow %u, resync and read %u bytes\n",
+           (unsigned)sim_rx.overflow_count, (unsigned)read);
+    sim_check(read == 100u && memcmp(in, out, 100u) == 0, "data after resync", read, 100u);
+    sim_check(sim_rx.overflow_count == 1, "overflow", sim_rx.overflow_count, 1);
+}
+
+static void sim_line_error(uint8_t *buf)
+{
+    uint8_t frame[18];
+
+    sim_current = "error";
+    sim_double_buffer_init(buf);
+
+    sim_fill(frame, sizeof(frame));
+    sim_usart_error(&sim_port, USART_SR_ORE);
+    sim_usart_receive(&sim_port, frame, sizeof(frame));
+    sim_usart_idle(&sim_port);
+    sim_usart_error(&sim_port, USART_SR_FE | USART_SR_NE);
+    sim_usart_receive(&sim_port, frame, sizeof(frame));
+    sim_usart_idle(&sim_port);
+    sim_usart_receive(&sim_port, frame, sizeof(frame));
+    sim_usart_idle(&sim_port);
+
+    printf("error          ORE, FE+NE, clean: error %u, frames %u\n", (unsigned)sim_rx.error_count, (unsigned)sim_log.count);
+    sim_check(sim_rx.error_count == 2, "error count", sim_rx.error_count, 2);
+    sim_check(sim_log.count == 3, "frames", sim_log.count, 3);
+    sim_check((sim_port.uart.SR & (USART_SR_ORE | USART_SR_FE | USART_SR_NE | USART_SR_IDLE)) == 0, "SR cleared",
+              sim_port.uart.SR, 0);
+}
+
+static void sim_tx(uint8_t *buf)
+{
+    uint8_t out[64];
+    uint16_t len;
+
+    sim_current = "tx";
+    sim_usart_init(&sim_port, &sim_huart, &sim_hdma_rx, &sim_hdma_tx, NULL, NULL, NULL);
+    sim_fill(buf, 40u);
+
+    sim_check(usart_tx_dma_start(&sim_huart, &sim_hdma_tx, buf, 40u) == 1, "start", 0, 1);
+    sim_check(usart_tx_dma_busy(&sim_hdma_tx) == 1, "busy", 0, 1);
+    sim_check(usart_tx_dma_start(&sim_huart, &sim_hdma_tx, buf, 10u) == 0, "start while busy", 1, 0);
+    len = sim_usart_transmit(&sim_port, out, sizeof(out));
+    sim_check(len == 40u && memcmp(out, buf, 40u) == 0, "sent data", len, 40u);
+    sim_check(usart_tx_dma_busy(&sim_hdma_tx) == 0, "busy after complete", 1, 0);
+
+    //上一次的TC标志在启动时清除
+    sim_check(usart_tx_dma_start(&sim_huart, &sim_hdma_tx, buf + 40u - 10u, 10u) == 1, "restart", 0, 1);
+    sim_check(!(sim_hdma_tx.flag & SIM_DMA_FLAG_TC), "TC cleared on start", sim_hdma_tx.flag, 0);
+    len = sim_usart_transmit(&sim_port, out, sizeof(out));
+    printf("tx             40 + 10 bytes, start while busy rejected\n");
+    sim_check(len == 10u && memcmp(out, buf + 30u, 10u) == 0, "sent data", len, 10u);
+}
+
+int main(void)
+{
+    uint8_t *buf = sim_usart_alloc(4096u);
+
+    if (buf == NULL)
+    {
+        fprintf(stderr, "usart_sim: cannot allocate DMA buffer below 4GB\n");
+        return 1;
+    }
+
+    sim_double_buffer(buf);
+    sim_overflow(buf);
+    sim_circular(buf);
+    sim_burst(buf);
+    sim_lapped(buf);
+    sim_line_error(buf);
+    sim_tx(buf);
+
+    if (sim_error != 0)
+    {
+        fprintf(stderr, "usart_sim: %u errors\n", (unsigned)sim_error);
+        return 1;
+    }
+    printf("usart_sim: ok\n");
+    return 0;
+}
@@ -0,0 +1,387 @@
+/**
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  * @file       watchdog_sim.c
+  * @brief      软件看门狗上位机仿真，运行固件的watchdog_task，按任务表模拟各周期任务的执行，
+  *             注入超时、任务不再被唤醒、永久卡死等故障，检查进入安全状态、发出电流为0的控制帧、
+  *             恢复与独立看门狗复位的时刻。
+  * @note       任务的开始与结束时间直接写入task_timing[](目标板由task_job_begin/task_job_end写入)，
+  *             每次执行在被唤醒的那一毫秒内完成，注入的故障使某一次执行延长或下一次唤醒推迟。
+  *             独立看门狗用喂狗时间模拟, 超时即视为复位。
+  *             检查失败时返回1, make bench时运行。
+  * @history
+  *  Version    Date            Author          Modification
+  *  V1.0.0     Oct-19-2026     ICBK            1. 完成
+  *
+  @verbatim
+  ==============================================================================
+    用法: watchdog_sim
+    每个场景输出: 截止时刻、检测到超时、控制电流为0、恢复、复位的时间(ms)
+    反应时间要求:
+      检测 - 截止时刻          1 ~ WATCHDOG_PERIOD_MS
+      电流为0 - 截止时刻       不超过 WATCHDOG_PERIOD_MS + 1(本仿真在下一毫秒读取电调指令)
+      恢复 - 故障结束          WATCHDOG_RECOVER_MS ~ WATCHDOG_RECOVER_MS + 周期 + WATCHDOG_PERIOD_MS + 1
+      复位 - 截止时刻          WATCHDOG_RESET_MS + IWDG超时 ~ 再加 WATCHDOG_PERIOD_MS + 1
+  ==============================================================================
+  @endverbatim
+  ****************************(C) COPYRIGHT 2023 ICBK****************************
+  */
+
+#include <stdio.h>
+#include <string.h>
+#include "cmsis_os.h"
+#include "sim_os.h"
+#include "sim_can.h"
+#include "bsp_iwdg.h"
+#include "blackbox.h"
+#include "remote_control.h"
+#include "imu_task.h"
+#include "ins_task.h"
+#include "chassis_task.h"
+#include "gimbal_task.h"
+#include "shoot_task.h"
+#include "referee_task.h"
+#include "telemetry_task.h"
+#include "monitor_task.h"
+#include "watchdog_task.h"
+
+#define SIM_NEVER         0xFFFFFFFFu
+#define SIM_MOTOR_NUM     5u        //底盘4个 云台1个
+#define SIM_COMMAND       1000      //控制任务每次执行发出的指令
+
+/*任务表 与固件相同 TCB与栈大小不使用*/
+#define TASK_INFO(id, name, entry, stack_words, period_ms, deadline_ms, wcet_us, isr, wdg) \
+    {#name, (stack_words), (period_ms), (deadline_ms), (wcet_us), (isr), (wdg), 0},
+const task_info_t task_info[TASK_NUM] =
+{
+    TASK_TABLE(TASK_INFO)
+};
+#undef TASK_INFO
+
+task_timing_t task_timing[TASK_NUM];
+
+/*注入的故障*/
+typedef enum
+{
+    SIM_FAULT_NONE = 0,
+    SIM_FAULT_OVERRUN,      //一次执行持续stall_ms
+    SIM_FAULT_NO_RELEASE,   //一次执行结束后 下一次唤醒推迟stall_ms
+} sim_fault_e;
+
+typedef struct
+{
+    const char *name;
+    task_id_e task;         //注入故障的任务
+    sim_fault_e fault;
+    uint32_t fault_ms;      //此时刻之后的第一次执行注入故障
+    uint32_t stall_ms;      //SIM_NEVER为永久
+    uint32_t duration_ms;
+    bool_t expect_safe;
+    bool_t expect_reset;
+} sim_case_t;
+
+/*周期任务模型*/
+typedef struct
+{
+    uint32_t release_ms;    //下一次唤醒
+    uint32_t finish_ms;     //本次执行结束
+    bool_t running;
+} sim_task_t;
+
+/*一个场景的结果*/
+typedef struct
+{
+    uint32_t deadline_ms;   //故障执行的截止时刻 SIM_NEVER为没有超时
+    uint32_t stall_end_ms;  //故障结束 任务恢复执行
+    uint32_t detect_ms;     //第一次进入安全状态
+    uint32_t zero_ms;       //第一次全部电调指令为0
+    uint32_t recover_ms;    //退出安全状态后电调重新收到非0指令
+    uint32_t reset_ms;      //独立看门狗超时
+} sim_result_t;
+
+static const sim_case_t sim_case[] =
+{
+    {"normal",               TASK_CHASSIS,   SIM_FAULT_NONE,       0,   0,         500, 0, 0},
+    {"chassis_wcet_overrun", TASK_CHASSIS,   SIM_FAULT_OVERRUN,    100, CHASSIS_CONTROL_TIME_MS, 500, 0, 0},
+    {"chassis_overrun",      TASK_CHASSIS,   SIM_FAULT_OVERRUN,    100, 30,        500, 1, 0},
+    {"chassis_not_released", TASK_CHASSIS,   SIM_FAULT_NO_RELEASE, 100, 30,        500, 1, 0},
+    {"chassis_stuck",        TASK_CHASSIS,   SIM_FAULT_OVERRUN,    100, SIM_NEVER, 500, 1, 1},
+    {"telemetry_overrun",    TASK_TELEMETRY, SIM_FAULT_OVERRUN,    100, 50,        500, 0, 0},
+};
+#define SIM_CASE_NUM (sizeof(sim_case) / sizeof(sim_case[0]))
+
+static const sim_case_t *sim_current;
+static sim_task_t sim_task[TASK_NUM];
+static sim_result_t sim_result;
+static bool_t sim_fault_done;
+static motor_sim_t *sim_motor[SIM_MOTOR_NUM];
+static uint32_t sim_error;
+
+/*--------独立看门狗 上位机实现--------*/
+
+static uint16_t sim_iwdg_timeout_ms;
+static uint32_t sim_iwdg_feed_ms;
+
+void iwdg_init(uint16_t timeout_ms)
+{
+    sim_iwdg_timeout_ms = timeout_ms;
+    sim_iwdg_feed_ms = osKernelSysTick();
+}
+
+void iwdg_feed(void)
+{
+    sim_iwdg_feed_ms = osKernelSysTick();
+}
+
+void iwdg_timeout_set(uint16_t timeout_ms)
+{
+    sim_iwdg_timeout_ms = timeout_ms;
+    iwdg_feed();
+}
+
+uint16_t iwdg_timeout_get(void)
+{
+    return sim_iwdg_timeout_ms;
+}
+
+bool_t iwdg_caused_reset(void)
+{
+    return 0;
+}
+
+/*--------任务模型--------*/
+
+static void sim_check(bool_t ok, const char *what, uint32_t value)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "error: %s: %s (%u)\n", sim_current->name, what, value);
+        sim_error++;
+    }
+}
+
+static void sim_job_end(task_id_e id, uint32_t now_ms)
+{
+    //控制任务每次执行结束前发送控制帧 云台任务尚未加入 由底盘模型一起发送
+    if (id == TASK_CHASSIS)
+    {
+        CAN_cmd_chassis(SIM_COMMAND, SIM_COMMAND, SIM_COMMAND, SIM_COMMAND);
+        CAN_cmd_gimbal(SIM_COMMAND, 0, 0, 0);
+    }
+    task_timing[id].end_ms = now_ms;
+    task_timing[id].running = 0;
+    task_timing[id].job_count++;
+    sim_task[id].running = 0;
+    sim_task[id].release_ms = now_ms + task_info[id].period_ms;
+
+    if (id == sim_current->task && sim_current->fault == SIM_FAULT_NO_RELEASE && !sim_fault_done &&
+        now_ms >= sim_current->fault_ms)
+    {
+        sim_fault_done = 1;
+        sim_task[id].release_ms += sim_current->stall_ms;
+        sim_result.deadline_ms = now_ms + task_info[id].period_ms + task_info[id].deadline_ms;
+        sim_result.stall_end_ms = sim_task[id].release_ms;
+    }
+}
+
+static void sim_job_begin(task_id_e id, uint32_t now_ms)
+{
+    sim_task_t *task = &sim_task[id];
+
+    task_timing[id].begin_ms = now_ms;
+    task_timing[id].running = 1;
+    task->running = 1;
+    task->finish_ms = now_ms;
+
+    if (id == sim_current->task && sim_current->fault == SIM_FAULT_OVERRUN && !sim_fault_done &&
+        now_ms >= sim_current->fault_ms)
+    {
+        sim_fault_done = 1;
+        task->finish_ms = sim_current->stall_ms == SIM_NEVER ? SIM_NEVER : now_ms + sim_current->stall_ms;
+        sim_result.stall_end_ms = task->finish_ms;
+        if (sim_current->stall_ms > task_info[id].deadline_ms)
+        {
+            sim_result.deadline_ms = now_ms + task_info[id].deadline_ms;
+        }
+    }
+}
+
+//电调指令是否全部为0
+static bool_t sim_motor_all_zero(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < SIM_MOTOR_NUM; i++)
+    {
+        if (sim_motor[i]->command != 0)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+//每毫秒在看门狗任务运行前调用: 记录上一毫秒的结果 推进各任务
+static void sim_tick(uint32_t now_ms, void *user)
+{
+    uint8_t i;
+    (void)user;
+
+    if (sim_result.reset_ms != SIM_NEVER)
+    {
+        return;
+    }
+
+    //上一毫秒看门狗任务的处理结果
+    if (sim_result.detect_ms == SIM_NEVER && CAN_cmd_safe_get())
+    {
+        sim_result.detect_ms = now_ms - 1u;
+    }
+    if (sim_result.detect_ms != SIM_NEVER && sim_result.zero_ms == SIM_NEVER && sim_motor_all_zero())
+    {
+        sim_result.zero_ms = now_ms - 1u;
+    }
+    if (sim_result.zero_ms != SIM_NEVER && sim_result.recover_ms == SIM_NEVER && !sim_motor_all_zero())
+    {
+        sim_result.recover_ms = now_ms - 1u;
+    }
+    if (sim_iwdg_timeout_ms != 0 && now_ms - sim_iwdg_feed_ms > sim_iwdg_timeout_ms)
+    {
+        sim_result.reset_ms = now_ms;
+        return;
+    }
+
+    for (i = 0; i < TASK_NUM; i++)
+    {
+        if (task_info[i].wdg == TASK_WDG_NONE)
+        {
+            continue;
+        }
+        if (!sim_task[i].running && now_ms >= sim_task[i].release_ms)
+        {
+            sim_job_begin((task_id_e)i, now_ms);
+        }
+        if (sim_task[i].running && now_ms >= sim_task[i].finish_ms)
+        {
+            sim_job_end((task_id_e)i, now_ms);
+        }
+    }
+}
+
+static void sim_print_time(const char *name, uint32_t value)
+{
+    if (value == SIM_NEVER)
+    {
+        printf(" %s    -", name);
+    }
+    else
+    {
+        printf(" %s %4u", name, value);
+    }
+}
+
+static void sim_run_case(const sim_case_t *c)
+{
+    watchdog_status_t status;
+    const task_info_t *info = &task_info[c->task];
+    uint8_t i;
+
+    sim_current = c;
+    sim_fault_done = 0;
+    memset(sim_task, 0, sizeof(sim_task));
+    memset(task_timing, 0, sizeof(task_timing));
+    sim_iwdg_timeout_ms = 0;
+    sim_result.deadline_ms = SIM_NEVER;
+    sim_result.stall_end_ms = SIM_NEVER;
+    sim_result.detect_ms = SIM_NEVER;
+    sim_result.zero_ms = SIM_NEVER;
+    sim_result.recover_ms = SIM_NEVER;
+    sim_result.reset_ms = SIM_NEVER;
+
+    //任务在启动延时后开始 第一次执行前不检查
+    for (i = 0; i < TASK_NUM; i++)
+    {
+        sim_task[i].release_ms = 20u + i;
+    }
+
+    sim_os_init();
+    sim_can_init();
+    for (i = 0; i < 4u; i++)
+    {
+        sim_motor[i] = &sim_can_add_motor(SIM_CAN1, (uint16_t)(CAN_3508_M1_ID + i), MOTOR_SIM_M3508, 24.0f)->motor;
+    }
+    sim_motor[4] = &sim_can_add_motor(SIM_CAN2, CAN_YAW_MOTOR_ID, MOTOR_SIM_GM6020, 24.0f)->motor;
+    sim_os_set_tick_hook(sim_tick, NULL);
+    sim_os_run(watchdog_task, c->duration_ms);
+    watchdog_read(&status);
+
+    printf("%-22s", c->name);
+    sim_print_time("deadline", sim_result.deadline_ms);
+    sim_print_time("detect", sim_result.detect_ms);
+    sim_print_time("zero", sim_result.zero_ms);
+    sim_print_time("recover", sim_result.recover_ms);
+    sim_print_time("reset", sim_result.reset_ms);
+    printf("  overrun %u miss %u\n", status.task[c->task].overrun_count, status.task[c->task].miss_count);
+
+    if (!c->expect_safe)
+    {
+        sim_check(sim_result.detect_ms == SIM_NEVER, "unexpected safe state", sim_result.detect_ms);
+        sim_check(sim_result.reset_ms == SIM_NEVER, "unexpected reset", sim_result.reset_ms);
+        sim_check(!sim_motor_all_zero(), "commands are zero", 0);
+        if (c->fault != SIM_FAULT_NONE && sim_result.deadline_ms != SIM_NEVER)
+        {
+            //只计数的任务
+            sim_check(status.task[c->task].overrun_count + status.task[c->task].miss_count == 1,
+                      "report task miss not counted once",
+                      status.task[c->task].overrun_count + status.task[c->task].miss_count);
+        }
+        return;
+    }
+
+    sim_check(sim_result.deadline_ms != SIM_NEVER, "fault did not pass deadline", 0);
+    sim_check(sim_result.detect_ms != SIM_NEVER &&
+              sim_result.detect_ms - sim_result.deadline_ms >= 1u &&
+              sim_result.detect_ms - sim_result.deadline_ms <= WATCHDOG_PERIOD_MS,
+              "detection time", sim_result.detect_ms - sim_result.deadline_ms);
+    sim_check(sim_result.zero_ms != SIM_NEVER &&
+              sim_result.zero_ms - sim_result.deadline_ms <= WATCHDOG_PERIOD_MS + 1u,
+              "zero current time", sim_result.zero_ms - sim_result.deadline_ms);
+    sim_check(status.safe_count == 1, "safe state entered once", status.safe_count);
+    sim_check(blackbox_is_frozen() != 0, "blackbox not frozen", 0);
+
+    if (c->expect_reset)
+    {
+        uint32_t min = WATCHDOG_RESET_MS + WATCHDOG_IWDG_TIMEOUT_MS;
+        uint32_t delay = sim_result.reset_ms - sim_result.deadline_ms;
+
+        sim_check(sim_result.reset_ms != SIM_NEVER && delay >= min && delay <= min + WATCHDOG_PERIOD_MS + 1u,
+                  "reset time", delay);
+        return;
+    }
+
+    sim_check(sim_result.reset_ms == SIM_NEVER, "unexpected reset", sim_result.reset_ms);
+    sim_check(sim_result.recover_ms != SIM_NEVER &&
+              sim_result.recover_ms - sim_result.stall_end_ms >= WATCHDOG_RECOVER_MS &&
+              sim_result.recover_ms - sim_result.stall_end_ms <=
+                  WATCHDOG_RECOVER_MS + info->period_ms + WATCHDOG_PERIOD_MS + 1u,
+              "recover time", sim_result.recover_ms - sim_result.stall_end_ms);
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    printf("watchdog period %u ms, recover %u ms, reset %u ms, iwdg %u ms, times in ms\n",
+           WATCHDOG_PERIOD_MS, WATCHDOG_RECOVER_MS, WATCHDOG_RESET_MS, WATCHDOG_IWDG_TIMEOUT_MS);
+    for (i = 0; i < SIM_CASE_NUM; i++)
+    {
+        sim_run_case(&sim_case[i]);
+    }
+
+    if (sim_error)
+    {
+        fprintf(stderr, "watchdog_sim: %u errors\n", sim_error);
+        return 1;
+    }
+    printf("watchdog_sim: ok\n");
+    return 0;
+}
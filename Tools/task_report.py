@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""任务RAM占用报告 读取Keil链接生成的map文件
+
+任务的TCB与栈在 Application/Task/Inc/task_registry.c 中静态分配, 符号名为
+task_tcb_<任务名>、task_stack_<任务名>; CubeMX生成的默认任务与空闲任务也静态分配。
+map文件的Image Symbol Table给出每个符号链接后的实际长度, 据此统计每个任务占用的RAM,
+以及FreeRTOS堆(ucHeap)、启动文件中的主栈/堆与RW+ZI总量。
+
+用法:
+    python task_report.py MDK-ARM/ICBK_EC_Freame/ICBK_EC_Freame.map
+    python task_report.py ICBK_EC_Freame.map --json      # 输出JSON 便于比较
+"""
+
+import argparse
+import json
+import re
+import sys
+
+# 符号名 -> (任务名, 类别)
+TASK_SYMBOL = [
+    (re.compile(r"^task_tcb_(\w+)$"), "tcb"),
+    (re.compile(r"^task_stack_(\w+)$"), "stack"),
+]
+# CubeMX与FreeRTOS移植层的静态任务
+FIXED_SYMBOL = {
+    "defaultTaskControlBlock": ("defaultTask", "tcb"),
+    "defaultTaskBuffer": ("defaultTask", "stack"),
+    "xIdleTaskTCBBuffer": ("IDLE", "tcb"),
+    "xIdleStack": ("IDLE", "stack"),
+    "xTimerTaskTCBBuffer": ("TmrSvc", "tcb"),
+    "xTimerStack": ("TmrSvc", "stack"),
+}
+# 其他RAM: 符号名 -> 说明
+OTHER_SYMBOL = {
+    "ucHeap": "FreeRTOS heap",
+    "Stack_Mem": "main stack (MSP)",
+    "Heap_Mem": "C heap",
+}
+
+SYMBOL_LINE = re.compile(r"^\s+(\w+)\s+0x[0-9a-fA-F]+\s+Data\s+(\d+)\s+(\S+)")
+TOTAL_RW_LINE = re.compile(r"Total RW\s+Size \(RW Data \+ ZI Data\)\s+(\d+)")
+
+
+def parse_map(path):
+    """返回 (符号名 -> 长度, RW+ZI总量)"""
+    symbols = {}
+    total_rw = None
+    in_table = False
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            if line.startswith("Image Symbol Table"):
+                in_table = True
+                continue
+            m = TOTAL_RW_LINE.search(line)
+            if m:
+                total_rw = int(m.group(1))
+                continue
+            if not in_table:
+                continue
+            m = SYMBOL_LINE.match(line)
+            if m:
+                symbols[m.group(1)] = int(m.group(2))
+    return symbols, total_rw
+
+
+def collect(symbols):
+    """返回 (任务列表, 其他RAM列表)"""
+    tasks = {}
+    for name, size in symbols.items():
+        owner = FIXED_SYMBOL.get(name)
+        if owner is None:
+            for pattern, kind in TASK_SYMBOL:
+                m = pattern.match(name)
+                if m:
+                    owner = (m.group(1), kind)
+                    break
+        if owner is None:
+            continue
+        task = tasks.setdefault(owner[0], {"name": owner[0], "tcb": 0, "stack": 0})
+        task[owner[1]] += size
+
+    task_list = sorted(tasks.values(), key=lambda t: t["tcb"] + t["stack"], reverse=True)
+    for task in task_list:
+        task["total"] = task["tcb"] + task["stack"]
+    other = [{"name": desc, "symbol": name, "size": symbols[name]}
+             for name, desc in OTHER_SYMBOL.items() if name in symbols]
+    return task_list, other
+
+
+def main():
+    parser = argparse.ArgumentParser(description="任务RAM占用报告")
+    parser.add_argument("map", help="Keil map文件")
+    parser.add_argument("--json", action="store_true", help="输出JSON")
+    args = parser.parse_args()
+
+    symbols, total_rw = parse_map(args.map)
+    tasks, other = collect(symbols)
+    if not symbols:
+        print("map文件中没有Image Symbol Table: 链接选项需勾选Symbols", file=sys.stderr)
+        return 1
+
+    task_total = sum(t["total"] for t in tasks)
+    if args.json:
+        json.dump({"tasks": tasks, "other": other, "task_total": task_total, "total_rw": total_rw},
+                  sys.stdout, indent=2)
+        print()
+        return 0
+
+    print("%-16s %8s %8s %8s" % ("task", "tcb", "stack", "total"))
+    for t in tasks:
+        print("%-16s %8d %8d %8d" % (t["name"], t["tcb"], t["stack"], t["total"]))
+    print("%-16s %8s %8s %8d" % ("tasks", "", "", task_total))
+    print()
+    for o in other:
+        print("%-16s %8d  %s" % (o["symbol"], o["size"], o["name"]))
+    if total_rw is not None:
+        print("%-16s %8d  RW + ZI" % ("total", total_rw))
+    if not any(t["name"] not in ("IDLE", "defaultTask", "TmrSvc") for t in tasks):
+        print("\n没有task_registry静态分配的任务: 任务可能仍在FreeRTOS堆中动态创建", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
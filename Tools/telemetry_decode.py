@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""遥测数据解码 输出CSV
+
+帧格式见 Application/Task/Inc/telemetry_task.c:
+    COBS(负载 + CRC16) + 0x00
+
+用法:
+    python telemetry_decode.py capture.bin -o out.csv           # 解析录制的原始串口数据
+    python telemetry_decode.py COM5 --serial -o out.csv          # 实时读取串口 Ctrl+C 结束后写出
+    可选 --monitor monitor.csv 输出系统监视记录(每个任务一行)
+
+采样CSV每行一个采样包: time_ms,seq,<变量名...>, 未采样的变量留空
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+PACKET_SAMPLE = 0x01
+PACKET_INFO = 0x02
+PACKET_MONITOR = 0x03
+
+TYPE_NAMES = ["fp32", "int8", "uint8", "int16", "uint16", "int32", "uint32"]
+
+MONITOR_HEAD = struct.Struct("<BBHIIIHH")
+MONITOR_TASK = struct.Struct("<8sBBHH")
+
+
+def crc16(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0x8408 if crc & 1 else crc >> 1
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data) + 1:
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Decoder:
+    def __init__(self):
+        self.names = {}
+        self.rows = []
+        self.monitor_rows = []
+        self.crc_error = 0
+        self.cobs_error = 0
+        self.last_seq = None
+        self.lost = 0
+        self._buf = bytearray()
+
+    def feed(self, chunk):
+        self._buf += chunk
+        while True:
+            end = self._buf.find(b"\x00")
+            if end < 0:
+                return
+            frame = bytes(self._buf[:end])
+            del self._buf[:end + 1]
+            if frame:
+                self._frame(frame)
+
+    def _frame(self, frame):
+        payload = cobs_decode(frame)
+        if payload is None or len(payload) < 3:
+            self.cobs_error += 1
+            return
+        body, check = payload[:-2], struct.unpack("<H", payload[-2:])[0]
+        if crc16(body) != check:
+            self.crc_error += 1
+            return
+        kind = body[0]
+        if kind == PACKET_SAMPLE:
+            self._sample(body)
+        elif kind == PACKET_INFO:
+            channel, vtype, decimation = body[1], body[2], body[3]
+            self.names[channel] = body[4:].decode("ascii", "replace")
+        elif kind == PACKET_MONITOR:
+            self._monitor(body[1:])
+
+    def _sample(self, body):
+        seq, time_ms, count = struct.unpack_from("<HIB", body, 1)
+        if self.last_seq is not None:
+            self.lost += (seq - self.last_seq - 1) & 0xFFFF
+        self.last_seq = seq
+        values = {}
+        for k in range(count):
+            channel, value = struct.unpack_from("<Bf", body, 8 + 5 * k)
+            values[channel] = value
+        self.rows.append((time_ms, seq, values))
+
+    def _monitor(self, data):
+        version, task_num, seq, uptime, heap_free, heap_min, isr, period = MONITOR_HEAD.unpack_from(data, 0)
+        # 记录中的任务槽数由固件的任务表决定(MONITOR_MAX_TASK_NUM) 按包长计算
+        max_task_num = (len(data) - MONITOR_HEAD.size) // MONITOR_TASK.size
+        for k in range(min(task_num, max_task_num)):
+            name, prio, state, cpu, stack = MONITOR_TASK.unpack_from(data, MONITOR_HEAD.size + MONITOR_TASK.size * k)
+            self.monitor_rows.append([uptime, seq, name.rstrip(b"\x00").decode("ascii", "replace"), prio, state,
+                                      cpu / 10.0, stack, heap_free, heap_min, isr / 10.0, period])
+
+    def write_csv(self, path):
+        channels = sorted({c for _, _, values in self.rows for c in values})
+        with open(path, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(["time_ms", "seq"] + [self.names.get(c, "ch%d" % c) for c in channels])
+            for time_ms, seq, values in self.rows:
+                writer.writerow([time_ms, seq] + [values.get(c, "") for c in channels])
+
+    def write_monitor_csv(self, path):
+        with open(path, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(["uptime_ms", "seq", "task", "priority", "state", "cpu_percent", "stack_free_words",
+                             "heap_free", "heap_min_free", "isr_percent", "period_ms"])
+            writer.writerows(self.monitor_rows)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="decode telemetry stream to CSV")
+    parser.add_argument("source", help="capture file, or serial port with --serial")
+    parser.add_argument("-o", "--output", default="telemetry.csv")
+    parser.add_argument("--monitor", help="write system monitor records to this CSV")
+    parser.add_argument("--serial", action="store_true", help="read from serial port")
+    parser.add_argument("--baud", type=int, default=921600)
+    args = parser.parse_args()
+
+    decoder = Decoder()
+    if args.serial:
+        import serial
+        port = serial.Serial(args.source, args.baud, timeout=0.1)
+        try:
+            while True:
+                decoder.feed(port.read(4096))
+        except KeyboardInterrupt:
+            pass
+    else:
+        with open(args.source, "rb") as f:
+            decoder.feed(f.read())
+
+    decoder.write_csv(args.output)
+    if args.monitor:
+        decoder.write_monitor_csv(args.monitor)
+    print("samples %d, lost %d, crc error %d, cobs error %d" %
+          (len(decoder.rows), decoder.lost, decoder.crc_error, decoder.cobs_error), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
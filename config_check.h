@@ -0,0 +1,116 @@
+#ifndef CONFIG_CHECK_H
+
+#define CONFIG_CHECK_H
+/*
+	配置检查 由config_freame.h包含
+	编译期检查配置的取值范围与相互关系, 不满足时数组长度为-1, 编译报错并指出检查项名称
+	ARMCC5(C99)没有_Static_assert, 用typedef负长度数组实现; 只使用整数常量表达式
+*/
+
+#define CONFIG_STATIC_ASSERT(expr, name) typedef char config_check_##name[(expr) ? 1 : -1]
+
+/* 底盘机械参数 单位mm */
+CONFIG_STATIC_ASSERT(CONFIG_WHEEL_DIAMETER_MM >= 50 && CONFIG_WHEEL_DIAMETER_MM <= 300, wheel_diameter_mm_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_CHASSIS_LENGTH_MM >= 100 && CONFIG_CHASSIS_LENGTH_MM <= 1000, chassis_length_mm_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_CHASSIS_WIDTH_MM >= 100 && CONFIG_CHASSIS_WIDTH_MM <= 1000, chassis_width_mm_out_of_range);
+//减速比在1~100之间
+CONFIG_STATIC_ASSERT(CONFIG_CHASSIS_DECELE_RATIO_DEN > 0, decele_ratio_den_zero);
+CONFIG_STATIC_ASSERT(CONFIG_CHASSIS_DECELE_RATIO_NUM >= CONFIG_CHASSIS_DECELE_RATIO_DEN &&
+                     CONFIG_CHASSIS_DECELE_RATIO_NUM <= 100 * CONFIG_CHASSIS_DECELE_RATIO_DEN, decele_ratio_out_of_range);
+//最大平移速度对应的电机转速不超过M3508空载转速(约9000rpm)
+//rpm = v(mm/s) * 60 / (pi * d(mm)) * 减速比, pi取3142/1000
+CONFIG_STATIC_ASSERT(CONFIG_CHASSIS_MAX_SPEED_MMPS > 0 &&
+                     CONFIG_CHASSIS_MAX_SPEED_MMPS * 60LL * 1000LL * CONFIG_CHASSIS_DECELE_RATIO_NUM <=
+                     9000LL * 3142LL * CONFIG_WHEEL_DIAMETER_MM * CONFIG_CHASSIS_DECELE_RATIO_DEN, chassis_max_speed_exceeds_motor_rpm);
+CONFIG_STATIC_ASSERT(CONFIG_CHASSIS_MECANUM == 0 || CONFIG_CHASSIS_MECANUM == 1, chassis_mecanum_not_bool);
+//小陀螺轮缘线速度 = 转速 * (长+宽)/2 同样不能超过电机转速上限
+CONFIG_STATIC_ASSERT(CONFIG_CHASSIS_SPIN_SPEED_DPS >= 0 &&
+                     CONFIG_CHASSIS_SPIN_SPEED_DPS * (CONFIG_CHASSIS_LENGTH_MM + CONFIG_CHASSIS_WIDTH_MM) * 60LL * 1000LL * CONFIG_CHASSIS_DECELE_RATIO_NUM <=
+                     9000LL * 360000LL * CONFIG_WHEEL_DIAMETER_MM * CONFIG_CHASSIS_DECELE_RATIO_DEN, chassis_spin_speed_exceeds_motor_rpm);
+
+/* 电流与PID限幅 单位CAN电流值 */
+CONFIG_STATIC_ASSERT(CONFIG_MOTOR_M3508_CAN_MAX_CURRENT > 0 && CONFIG_MOTOR_M3508_CAN_MAX_CURRENT <= 16384, m3508_can_current_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_CHASSIS_MOTOR_SPEED_PID_MAX_OUT > 0 &&
+                     CONFIG_CHASSIS_MOTOR_SPEED_PID_MAX_OUT <= CONFIG_MOTOR_M3508_CAN_MAX_CURRENT, chassis_pid_max_out_exceeds_can_current);
+CONFIG_STATIC_ASSERT(CONFIG_CHASSIS_MOTOR_SPEED_PID_MAX_IOUT >= 0 &&
+                     CONFIG_CHASSIS_MOTOR_SPEED_PID_MAX_IOUT <= CONFIG_CHASSIS_MOTOR_SPEED_PID_MAX_OUT, chassis_pid_max_iout_exceeds_max_out);
+
+/* 云台 编码值0~8191 软限位在±180°内且下限小于上限 */
+CONFIG_STATIC_ASSERT(CONFIG_MOTOR_GM6020_CAN_MAX_VOLTAGE > 0 && CONFIG_MOTOR_GM6020_CAN_MAX_VOLTAGE <= 30000, gm6020_can_voltage_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_GIMBAL_YAW_OFFSET_ECD >= 0 && CONFIG_GIMBAL_YAW_OFFSET_ECD <= 8191, gimbal_yaw_offset_ecd_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_GIMBAL_PITCH_OFFSET_ECD >= 0 && CONFIG_GIMBAL_PITCH_OFFSET_ECD <= 8191, gimbal_pitch_offset_ecd_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_GIMBAL_YAW_MOTOR_DIR == 1 || CONFIG_GIMBAL_YAW_MOTOR_DIR == -1, gimbal_yaw_motor_dir_invalid);
+CONFIG_STATIC_ASSERT(CONFIG_GIMBAL_PITCH_MOTOR_DIR == 1 || CONFIG_GIMBAL_PITCH_MOTOR_DIR == -1, gimbal_pitch_motor_dir_invalid);
+CONFIG_STATIC_ASSERT(CONFIG_GIMBAL_YAW_LIMIT == 0 || CONFIG_GIMBAL_YAW_LIMIT == 1, gimbal_yaw_limit_not_bool);
+CONFIG_STATIC_ASSERT(CONFIG_GIMBAL_YAW_MIN_DEG > -180 && CONFIG_GIMBAL_YAW_MIN_DEG < CONFIG_GIMBAL_YAW_MAX_DEG &&
+                     CONFIG_GIMBAL_YAW_MAX_DEG < 180, gimbal_yaw_limit_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_GIMBAL_PITCH_MIN_DEG > -90 && CONFIG_GIMBAL_PITCH_MIN_DEG < CONFIG_GIMBAL_PITCH_MAX_DEG &&
+                     CONFIG_GIMBAL_PITCH_MAX_DEG < 90, gimbal_pitch_limit_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_GIMBAL_RC_MAX_RATE_DPS > 0 && CONFIG_GIMBAL_RC_MAX_RATE_DPS <= CONFIG_GIMBAL_MAX_RATE_DPS, gimbal_rc_rate_exceeds_max_rate);
+CONFIG_STATIC_ASSERT(CONFIG_GIMBAL_SPEED_PID_MAX_IOUT >= 0 &&
+                     CONFIG_GIMBAL_SPEED_PID_MAX_IOUT <= CONFIG_MOTOR_GM6020_CAN_MAX_VOLTAGE, gimbal_pid_max_iout_exceeds_max_out);
+
+/* 发射机构 卡弹检测电流需低于限幅才能触发 反转角度小于一格 */
+CONFIG_STATIC_ASSERT(CONFIG_MOTOR_M2006_CAN_MAX_CURRENT > 0 && CONFIG_MOTOR_M2006_CAN_MAX_CURRENT <= 10000, m2006_can_current_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_SHOOT_TRIGGER_SLOTS >= 2 && CONFIG_SHOOT_TRIGGER_SLOTS <= 36, shoot_trigger_slots_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_SHOOT_TRIGGER_GEAR_RATIO >= 1, shoot_trigger_gear_ratio_invalid);
+CONFIG_STATIC_ASSERT(CONFIG_SHOOT_TRIGGER_MOTOR_DIR == 1 || CONFIG_SHOOT_TRIGGER_MOTOR_DIR == -1, shoot_trigger_motor_dir_invalid);
+CONFIG_STATIC_ASSERT(CONFIG_SHOOT_FIRE_MODE >= 0 && CONFIG_SHOOT_FIRE_MODE <= 2, shoot_fire_mode_invalid);
+CONFIG_STATIC_ASSERT(CONFIG_SHOOT_BURST_NUM >= 1 && CONFIG_SHOOT_BURST_NUM <= 10, shoot_burst_num_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_SHOOT_HEAT_PER_SHOT > 0 && CONFIG_SHOOT_HEAT_LIMIT >= CONFIG_SHOOT_HEAT_PER_SHOT, shoot_heat_limit_below_one_shot);
+CONFIG_STATIC_ASSERT(CONFIG_SHOOT_COOLING_RATE > 0, shoot_cooling_rate_invalid);
+CONFIG_STATIC_ASSERT(CONFIG_SHOOT_JAM_CURRENT > 0 && CONFIG_SHOOT_JAM_CURRENT < CONFIG_MOTOR_M2006_CAN_MAX_CURRENT, shoot_jam_current_exceeds_max_out);
+CONFIG_STATIC_ASSERT(CONFIG_SHOOT_REVERSE_DEG > 0 && CONFIG_SHOOT_REVERSE_DEG * CONFIG_SHOOT_TRIGGER_SLOTS < 360, shoot_reverse_exceeds_one_slot);
+CONFIG_STATIC_ASSERT(CONFIG_SHOOT_JAM_ERROR_DEG > 0 && CONFIG_SHOOT_JAM_ERROR_DEG * CONFIG_SHOOT_TRIGGER_SLOTS < 360, shoot_jam_error_exceeds_one_slot);
+CONFIG_STATIC_ASSERT(CONFIG_SHOOT_TRIGGER_SPEED_PID_MAX_IOUT >= 0 &&
+                     CONFIG_SHOOT_TRIGGER_SPEED_PID_MAX_IOUT <= CONFIG_MOTOR_M2006_CAN_MAX_CURRENT, shoot_trigger_pid_max_iout_exceeds_max_out);
+CONFIG_STATIC_ASSERT(CONFIG_SHOOT_FRIC_READY_RPM > 0, shoot_fric_ready_rpm_invalid);
+CONFIG_STATIC_ASSERT(CONFIG_SHOOT_FRIC_SPEED_PID_MAX_IOUT >= 0 &&
+                     CONFIG_SHOOT_FRIC_SPEED_PID_MAX_IOUT <= CONFIG_MOTOR_M3508_CAN_MAX_CURRENT, shoot_fric_pid_max_iout_exceeds_max_out);
+
+/* 遥控器 通道最大幅度660 */
+CONFIG_STATIC_ASSERT(CONFIG_CHASSIS_RC_DEADZONE >= 0 && CONFIG_CHASSIS_RC_DEADZONE <= 100, chassis_rc_deadzone_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_GIMBAL_RC_DEADZONE >= 0 && CONFIG_GIMBAL_RC_DEADZONE <= 100, gimbal_rc_deadzone_out_of_range);
+
+/* 算法库与调试 */
+CONFIG_STATIC_ASSERT(CONFIG_FAST_MATH_TIER >= 0 && CONFIG_FAST_MATH_TIER <= 2, fast_math_tier_invalid);
+CONFIG_STATIC_ASSERT(CONFIG_PROFILE_ENABLE == 0 || CONFIG_PROFILE_ENABLE == 1, profile_enable_not_bool);
+CONFIG_STATIC_ASSERT(CONFIG_MONITOR_PERIOD_MS >= 10, monitor_period_too_short);
+CONFIG_STATIC_ASSERT(CONFIG_TELEMETRY_PERIOD_MS >= 1, telemetry_period_zero);
+//遥测通道号为uint8
+CONFIG_STATIC_ASSERT(CONFIG_TELEMETRY_MAX_CHANNEL >= 1 && CONFIG_TELEMETRY_MAX_CHANNEL <= 255, telemetry_max_channel_out_of_range);
+//循环接收要求2的幂
+CONFIG_STATIC_ASSERT(CONFIG_TUNING_RX_BUF_LEN >= 64 && (CONFIG_TUNING_RX_BUF_LEN & (CONFIG_TUNING_RX_BUF_LEN - 1)) == 0, tuning_rx_buf_len_not_power_of_two);
+CONFIG_STATIC_ASSERT(CONFIG_BLACKBOX_CHASSIS_DECIMATION >= 1, blackbox_chassis_decimation_zero);
+CONFIG_STATIC_ASSERT(CONFIG_BLACKBOX_FREEZE_ON_RC_LOST == 0 || CONFIG_BLACKBOX_FREEZE_ON_RC_LOST == 1, blackbox_freeze_on_rc_lost_not_bool);
+
+/* 看门狗 独立看门狗超时(LSI误差下最短约0.7倍)需大于看门狗任务周期的数倍 计数最大4095 */
+CONFIG_STATIC_ASSERT(CONFIG_WATCHDOG_PERIOD_MS >= 1 && CONFIG_WATCHDOG_PERIOD_MS <= 10, watchdog_period_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_WATCHDOG_IWDG_TIMEOUT_MS >= 10 * CONFIG_WATCHDOG_PERIOD_MS &&
+                     CONFIG_WATCHDOG_IWDG_TIMEOUT_MS <= 4095, watchdog_iwdg_timeout_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_WATCHDOG_RECOVER_MS >= CONFIG_WATCHDOG_PERIOD_MS, watchdog_recover_too_short);
+CONFIG_STATIC_ASSERT(CONFIG_WATCHDOG_RESET_MS >= CONFIG_WATCHDOG_PERIOD_MS, watchdog_reset_too_short);
+
+/* IMU 陀螺仪FIFO共100帧 水位不超过一半, 留出任务被延迟时的余量 */
+CONFIG_STATIC_ASSERT(CONFIG_IMU_GYRO_RANGE_DPS == 125 || CONFIG_IMU_GYRO_RANGE_DPS == 250 ||
+                     CONFIG_IMU_GYRO_RANGE_DPS == 500 || CONFIG_IMU_GYRO_RANGE_DPS == 1000 ||
+                     CONFIG_IMU_GYRO_RANGE_DPS == 2000, imu_gyro_range_invalid);
+CONFIG_STATIC_ASSERT(CONFIG_IMU_ACCEL_RANGE_G == 3 || CONFIG_IMU_ACCEL_RANGE_G == 6 ||
+                     CONFIG_IMU_ACCEL_RANGE_G == 12 || CONFIG_IMU_ACCEL_RANGE_G == 24, imu_accel_range_invalid);
+CONFIG_STATIC_ASSERT(CONFIG_IMU_FIFO_BATCH >= 2 && CONFIG_IMU_FIFO_BATCH <= 50 && CONFIG_IMU_FIFO_BATCH % 2 == 0,
+                     imu_fifo_batch_out_of_range);
+
+/* 姿态解算 */
+CONFIG_STATIC_ASSERT(CONFIG_INS_AHRS == 0 || CONFIG_INS_AHRS == 1, ins_ahrs_invalid);
+CONFIG_STATIC_ASSERT(CONFIG_INS_UPDATE_HZ >= 100 && CONFIG_INS_UPDATE_HZ <= 2000, ins_update_hz_out_of_range);
+CONFIG_STATIC_ASSERT(CONFIG_INS_ALIGN_MS >= 100, ins_align_too_short);
+
+/* 键鼠 */
+CONFIG_STATIC_ASSERT(CONFIG_PC_KEY_DEBOUNCE_MS < CONFIG_PC_KEY_LONG_PRESS_MS, pc_key_debounce_exceeds_long_press);
+
+/* 裁判系统 115200波特率约11.5字节/ms 功率热量数据50Hz */
+//循环接收要求2的幂 最长帧9+128字节
+CONFIG_STATIC_ASSERT(CONFIG_REFEREE_RX_BUF_LEN >= 256 && (CONFIG_REFEREE_RX_BUF_LEN & (CONFIG_REFEREE_RX_BUF_LEN - 1)) == 0, referee_rx_buf_len_not_power_of_two);
+CONFIG_STATIC_ASSERT(CONFIG_REFEREE_LOST_MS >= 50, referee_lost_ms_too_short);
+
+#endif
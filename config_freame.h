@@ -4,24 +4,169 @@
 /*
 	统一配置文件config.h
 	通过 #define CONFIG_XXX_XXX_···· ···· 来进行参数的统一
+	物理量在名称中注明单位, 尽量使用整数(mm、ms、CAN电流值), 便于编译期检查;
+	取值范围与相互关系在config_check.h中检查, 不合理的配置编译失败
 */
 
 /* 底盘参数 */
-//底盘3508最大can发送电流值
-#define CONFIG_MOTOR_M3508_CAN_MAX_CURRENT 16000.0f
+//底盘3508最大can发送电流值 C620电调范围±16384
+#define CONFIG_MOTOR_M3508_CAN_MAX_CURRENT 16000
 
 /* 底盘机械物理参数 */
-#define CONFIG_WHEEL_PERIMETER 10 //轮子周长
-#define CONFIG_CHASSIS_DECELE_RATIO 10 //电机减速比
-#define CONFIG_CHASSIS_LENGTH 10 //底盘长度
-#define CONFIG_CHASSIS_WIDTH 10  //底盘宽度
+#define CONFIG_WHEEL_DIAMETER_MM 152          //轮子直径 mm
+#define CONFIG_CHASSIS_DECELE_RATIO_NUM 3591  //电机减速比 分子 M3508为3591/187
+#define CONFIG_CHASSIS_DECELE_RATIO_DEN 187   //电机减速比 分母
+#define CONFIG_CHASSIS_LENGTH_MM 400          //底盘长度(前后轮轴距) mm
+#define CONFIG_CHASSIS_WIDTH_MM 400           //底盘宽度(左右轮距) mm
+#define CONFIG_CHASSIS_MAX_SPEED_MMPS 3000    //摇杆满量程对应的平移速度 mm/s
+#define CONFIG_CHASSIS_MECANUM 0              //轮子类型 0:45度全向轮(X型) 1:麦克纳姆轮(O型)
+#define CONFIG_CHASSIS_SPIN_SPEED_DPS 360     //小陀螺转速 °/s
 
 /*底盘M3508电机速度环PID参数*/
-#define CONFIG_CHASSIS_MOTOR_SPEED_PID_KP 15000.0f
-#define CONFIG_CHASSIS_MOTOR_SPEED_PID_KI 10.0f
+//速度环输入为转子转速rpm 输出为CAN电流值 增益按上位机仿真(Tools/sim)整定
+#define CONFIG_CHASSIS_MOTOR_SPEED_PID_KP 20.0f
+#define CONFIG_CHASSIS_MOTOR_SPEED_PID_KI 1.0f
 #define CONFIG_CHASSIS_MOTOR_SPEED_PID_KD 0.0f
 #define CONFIG_CHASSIS_MOTOR_SPEED_PID_MAX_OUT CONFIG_MOTOR_M3508_CAN_MAX_CURRENT //将3508最大CAN发送电流值作为最大输出
-#define CONFIG_CHASSIS_MOTOR_SPEED_PID_MAX_IOUT 2000.0f
+#define CONFIG_CHASSIS_MOTOR_SPEED_PID_MAX_IOUT 2000
+//RC通道值转化速度比(m/s每通道值 660为通道最大幅度)与遥控器死区(通道值)
+#define CONFIG_RC_TO_SPEED_RATIO (CONFIG_CHASSIS_MAX_SPEED_MMPS * 0.001f / 660.0f)
+#define CONFIG_CHASSIS_RC_DEADZONE 10
 
+/* 云台参数 */
+//云台6020最大can发送电压值 GM6020范围±30000
+#define CONFIG_MOTOR_GM6020_CAN_MAX_VOLTAGE 30000
+//安装参数 中位编码值(0~8191)与电机方向(电机正转时姿态角增大为1 减小为-1)
+#define CONFIG_GIMBAL_YAW_OFFSET_ECD 4096     //云台朝向车体正前方时的偏航编码值
+#define CONFIG_GIMBAL_PITCH_OFFSET_ECD 4096   //枪管水平时的俯仰编码值
+#define CONFIG_GIMBAL_YAW_MOTOR_DIR 1
+#define CONFIG_GIMBAL_PITCH_MOTOR_DIR 1
+//软限位 相对车体的角度 °  俯仰角向下为正
+#define CONFIG_GIMBAL_YAW_LIMIT 0             //0:偏航无限位(导电滑环) 1:限制在MIN~MAX
+#define CONFIG_GIMBAL_YAW_MIN_DEG (-90)
+#define CONFIG_GIMBAL_YAW_MAX_DEG 90
+#define CONFIG_GIMBAL_PITCH_MIN_DEG (-30)     //最大仰角
+#define CONFIG_GIMBAL_PITCH_MAX_DEG 20        //最大俯角
+//摇杆满量程对应的云台角速度与遥控器死区(通道值) 鼠标按摇杆满量程换算
+#define CONFIG_GIMBAL_RC_MAX_RATE_DPS 180
+#define CONFIG_GIMBAL_RC_TO_RATE_RATIO (CONFIG_GIMBAL_RC_MAX_RATE_DPS * 0.01745329f / 660.0f) //rad/s每通道值
+#define CONFIG_GIMBAL_RC_DEADZONE 10
+/*云台角度环PID参数 输入rad 输出角速度rad/s*/
+#define CONFIG_GIMBAL_YAW_ANGLE_PID_KP 20.0f
+#define CONFIG_GIMBAL_YAW_ANGLE_PID_KI 0.0f
+#define CONFIG_GIMBAL_YAW_ANGLE_PID_KD 0.0f
+#define CONFIG_GIMBAL_PITCH_ANGLE_PID_KP 20.0f
+#define CONFIG_GIMBAL_PITCH_ANGLE_PID_KI 0.0f
+#define CONFIG_GIMBAL_PITCH_ANGLE_PID_KD 0.0f
+#define CONFIG_GIMBAL_MAX_RATE_DPS 600        //角度环最大输出 °/s
+/*云台速度环PID参数 输入rad/s 输出6020电压值*/
+#define CONFIG_GIMBAL_YAW_SPEED_PID_KP 4000.0f
+#define CONFIG_GIMBAL_YAW_SPEED_PID_KI 50.0f
+#define CONFIG_GIMBAL_PITCH_SPEED_PID_KP 4000.0f
+#define CONFIG_GIMBAL_PITCH_SPEED_PID_KI 50.0f
+#define CONFIG_GIMBAL_SPEED_PID_MAX_IOUT 10000
+
+/* 发射机构参数 */
+//拨弹2006最大can发送电流值 C610范围±10000
+#define CONFIG_MOTOR_M2006_CAN_MAX_CURRENT 10000
+//拨弹盘 每圈弹丸格数 电机减速比 电机方向(电机正转时拨弹盘向供弹方向转动为1 反之为-1)
+#define CONFIG_SHOOT_TRIGGER_SLOTS 8
+#define CONFIG_SHOOT_TRIGGER_GEAR_RATIO 36
+#define CONFIG_SHOOT_TRIGGER_MOTOR_DIR 1
+//射击模式 0:单发 1:点射 2:连发  点射发数  射频上限 Hz
+#define CONFIG_SHOOT_FIRE_MODE 0
+#define CONFIG_SHOOT_BURST_NUM 3
+#define CONFIG_SHOOT_FIRE_RATE_HZ 10.0f
+//枪口热量 每发热量 热量上限 每秒冷却值 裁判系统数据不可用时使用
+#define CONFIG_SHOOT_HEAT_PER_SHOT 10
+#define CONFIG_SHOOT_HEAT_LIMIT 200
+#define CONFIG_SHOOT_COOLING_RATE 10
+//卡弹检测 拨弹盘落后目标超过ERROR_DEG 转速低于SPEED_DPS 且电流超过CURRENT 持续TIME_MS判定卡弹
+#define CONFIG_SHOOT_JAM_ERROR_DEG 10
+#define CONFIG_SHOOT_JAM_SPEED_DPS 60
+#define CONFIG_SHOOT_JAM_CURRENT 6000
+#define CONFIG_SHOOT_JAM_TIME_MS 150
+//卡弹后反转角度与时间 反转结束后重新转向原目标
+#define CONFIG_SHOOT_REVERSE_DEG 30
+#define CONFIG_SHOOT_REVERSE_TIME_MS 150
+/*拨弹角度环PID参数 输入rad 输出拨弹盘角速度rad/s*/
+#define CONFIG_SHOOT_TRIGGER_ANGLE_PID_KP 40.0f
+#define CONFIG_SHOOT_TRIGGER_MAX_RATE_DPS 1440  //角度环最大输出 °/s
+/*拨弹速度环PID参数 输入拨弹盘角速度rad/s 输出2006电流值*/
+#define CONFIG_SHOOT_TRIGGER_SPEED_PID_KP 800.0f
+#define CONFIG_SHOOT_TRIGGER_SPEED_PID_KI 20.0f
+#define CONFIG_SHOOT_TRIGGER_SPEED_PID_MAX_IOUT 5000
+//摩擦轮 3508转子转速目标 rpm 加速度 rpm/s 与目标相差READY_RPM以内才允许发射
+#define CONFIG_SHOOT_FRIC_SPEED_RPM 6000.0f
+#define CONFIG_SHOOT_FRIC_RAMP_RPM_S 8000.0f
+#define CONFIG_SHOOT_FRIC_READY_RPM 300
+/*摩擦轮速度环PID参数 输入rpm 输出3508电流值*/
+#define CONFIG_SHOOT_FRIC_SPEED_PID_KP 10.0f
+#define CONFIG_SHOOT_FRIC_SPEED_PID_KI 0.5f
+#define CONFIG_SHOOT_FRIC_SPEED_PID_MAX_IOUT 5000
+
+/* 算法库参数 */
+//快速数学库默认精度档位 0:查表法 1:低阶多项式 2:高阶多项式 (见fast_math.h)
+#define CONFIG_FAST_MATH_TIER 0
+
+/* 调试参数 */
+//执行时间统计 1:开启 0:关闭(测量宏展开为空)
+#define CONFIG_PROFILE_ENABLE 1
+//系统监视任务统计周期 ms
+#define CONFIG_MONITOR_PERIOD_MS 500
+//遥测采样周期 ms 与注册变量上限
+#define CONFIG_TELEMETRY_PERIOD_MS 2
+#define CONFIG_TELEMETRY_MAX_CHANNEL 32
+//调参串口接收缓冲区长度 需为2的幂
+#define CONFIG_TUNING_RX_BUF_LEN 256
+//黑匣子 底盘记录抽取倍数(按控制周期) 遥控器掉线时是否冻结
+#define CONFIG_BLACKBOX_CHASSIS_DECIMATION 5
+#define CONFIG_BLACKBOX_FREEZE_ON_RC_LOST 1
+
+/* 看门狗参数 */
+//看门狗任务周期 ms 最高优先级运行
+#define CONFIG_WATCHDOG_PERIOD_MS 1
+//错过截止时间后 安全状态至少保持的时间 ms 期间任务需一直按时执行
+#define CONFIG_WATCHDOG_RECOVER_MS 100
+//底盘等控制任务持续错过截止时间多久后停止喂狗 由独立看门狗复位 ms
+#define CONFIG_WATCHDOG_RESET_MS 200
+//独立看门狗超时 ms 看门狗任务本身停止运行时复位
+#define CONFIG_WATCHDOG_IWDG_TIMEOUT_MS 50
+
+/* IMU参数 */
+//BMI088量程 陀螺仪125/250/500/1000/2000 dps 加速度计3/6/12/24 g
+#define CONFIG_IMU_GYRO_RANGE_DPS 2000
+#define CONFIG_IMU_ACCEL_RANGE_G 6
+//每次陀螺仪FIFO水位中断读出的帧数(2kHz) 决定IMU任务周期 需为偶数使周期为整数ms
+#define CONFIG_IMU_FIFO_BATCH 4
+
+/* 姿态解算参数 */
+#define CONFIG_INS_AHRS 1                       //0:Mahony 1:四元数卡尔曼滤波
+#define CONFIG_INS_UPDATE_HZ 1000               //解算频率 Hz 需整除陀螺仪输出频率2000Hz
+#define CONFIG_INS_ALIGN_MS 500                 //上电静止对准时间 ms
+#define CONFIG_INS_ACCEL_GATE 2.0f              //加速度计模长与g相差超过该值时不修正 m/s^2
+#define CONFIG_INS_MAHONY_KP 0.5f               //Mahony比例增益 1/s
+#define CONFIG_INS_MAHONY_KI 0.05f              //Mahony积分增益 1/s^2
+#define CONFIG_INS_EKF_GYRO_NOISE 0.01f         //陀螺仪噪声 rad/s
+#define CONFIG_INS_EKF_GYRO_BIAS_WALK 1e-4f     //零偏随机游走 rad/s/sqrt(s)
+#define CONFIG_INS_EKF_GYRO_BIAS_INIT 0.05f     //零偏初始不确定度 rad/s
+#define CONFIG_INS_EKF_ACCEL_NOISE 0.1f         //加速度计方向噪声 含振动与线加速度
+
+/* 键鼠控制参数 */
+#define CONFIG_PC_KEY_DEBOUNCE_MS 10        //按键消抖时间 ms DBUS帧周期14ms 即需要连续两帧一致
+#define CONFIG_PC_KEY_LONG_PRESS_MS 500     //长按判定时间 ms
+#define CONFIG_PC_NORMAL_SPEED_SCALE 0.6f   //普通平移速度 相对摇杆满量程
+#define CONFIG_PC_BOOST_SPEED_SCALE 1.0f    //SHIFT加速平移速度
+#define CONFIG_PC_SLOW_SPEED_SCALE 0.3f     //CTRL减速平移速度
+#define CONFIG_PC_MOUSE_X_SENS 0.02f        //鼠标x -> 偏航 相对摇杆满量程
+#define CONFIG_PC_MOUSE_Y_SENS 0.02f        //鼠标y -> 俯仰 相对摇杆满量程
+
+/* 裁判系统参数 */
+//裁判系统串口接收缓冲区长度 需为2的幂 至少能放下最长帧(137字节)
+#define CONFIG_REFEREE_RX_BUF_LEN 512
+//超过该时间没有收到裁判系统数据视为离线 发射机构改用参数中的热量上限与冷却值 ms
+#define CONFIG_REFEREE_LOST_MS 200
+
+#include "config_check.h"
 
 #endif